@@ -0,0 +1,1323 @@
+/*
+  RenderDaemon - a demo program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscoutmap/MapService.h>
+
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+#include <osmscoutmapcairo/MapPainterCairo.h>
+#endif
+#if defined(HAVE_LIB_OSMSCOUTMAPSVG)
+#include <osmscoutmapsvg/MapPainterSVG.h>
+#endif
+
+/*
+  Headless render daemon. The database and the style are loaded once, then
+  worker processes are forked. The workers share the memory mapped database
+  files, the compiled style and - if requested by --preloadMin/--preloadMax -
+  the database object caches warmed up before forking (copy-on-write).
+  The master process accepts requests on a local Unix socket, keeps a LRU
+  cache of rendered images, coalesces identical requests and dispatches them
+  to the workers, interactive requests before prefetch requests.
+
+  Protocol (one request per line, multiple requests per connection):
+
+    RENDER <interactive|prefetch> <lat> <lon> <zoom level> <width> <height>
+    STATS
+
+  Answer:
+
+    OK <png|svg|text> <size in bytes>\n<data>
+    ERROR <message>\n
+
+  Example (to be executed in the build directory):
+
+    Demos/RenderDaemon --workers 4 ../maps/nordrhein-westfalen ../stylesheets/standard.oss /tmp/osmscout.sock
+    echo "RENDER interactive 51.51241 7.46525 15 800 480" | socat - UNIX-CONNECT:/tmp/osmscout.sock
+*/
+
+static volatile std::sig_atomic_t stopRequested=0;
+
+static void HandleStopSignal(int /*signal*/)
+{
+  stopRequested=1;
+}
+
+struct Arguments
+{
+  bool                   help=false;
+  bool                   debug=false;
+  std::string            map;
+  std::string            style;
+  std::string            socket;
+  size_t                 workers=std::max(1u,std::thread::hardware_concurrency());
+  size_t                 prefetchWorkers=0; //!< Maximum number of workers rendering prefetch requests, 0 means all but one
+  size_t                 cacheSize=1000;    //!< Number of rendered images kept in the master
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+  std::string            format="png";
+#else
+  std::string            format="svg";
+#endif
+  double                 dpi=96.0;
+  std::string            fontName;
+  double                 fontSize=3.0;
+  std::list<std::string> iconPaths;
+  bool                   preload=false;
+  osmscout::GeoCoord     preloadMin;
+  osmscout::GeoCoord     preloadMax;
+  size_t                 preloadLevel=15;
+};
+
+enum class Priority
+{
+  interactive,
+  prefetch
+};
+
+struct RenderRequest
+{
+  Priority           priority=Priority::interactive;
+  osmscout::GeoCoord center;
+  size_t             level=0;
+  size_t             width=0;
+  size_t             height=0;
+
+  /**
+   * Normalized request as sent to the workers, also used as key for coalescing and caching
+   */
+  std::string GetKey() const
+  {
+    std::ostringstream stream;
+
+    stream.imbue(std::locale::classic());
+    stream << "RENDER " << std::fixed << std::setprecision(7) << center.GetLat() << " " << center.GetLon();
+    stream << " " << level << " " << width << " " << height;
+
+    return stream.str();
+  }
+};
+
+static bool ParseRenderRequest(std::istringstream& stream,
+                               bool withPriority,
+                               RenderRequest& request,
+                               std::string& error)
+{
+  std::string priority;
+  double      lat;
+  double      lon;
+
+  if (withPriority) {
+    stream >> priority;
+
+    if (priority=="interactive") {
+      request.priority=Priority::interactive;
+    }
+    else if (priority=="prefetch") {
+      request.priority=Priority::prefetch;
+    }
+    else {
+      error="Unknown priority '"+priority+"'";
+      return false;
+    }
+  }
+
+  if (!(stream >> lat >> lon >> request.level >> request.width >> request.height)) {
+    error="Expected: RENDER <interactive|prefetch> <lat> <lon> <zoom level> <width> <height>";
+    return false;
+  }
+
+  if (lat<-90.0 || lat>90.0 || lon<-180.0 || lon>180.0) {
+    error="Coordinate out of range";
+    return false;
+  }
+
+  if (request.level>20 ||
+      request.width==0 || request.width>4096 ||
+      request.height==0 || request.height>4096) {
+    error="Zoom level or image size out of range";
+    return false;
+  }
+
+  request.center=osmscout::GeoCoord(lat,lon);
+
+  return true;
+}
+
+static std::string ErrorResponse(const std::string& message)
+{
+  return "ERROR "+message+"\n";
+}
+
+static std::string OkResponse(const std::string& format,
+                              const std::string& data)
+{
+  return "OK "+format+" "+std::to_string(data.size())+"\n"+data;
+}
+
+static bool WriteAll(int fd,
+                     const std::string& data)
+{
+  size_t written=0;
+
+  while (written<data.size()) {
+    ssize_t result=send(fd,
+                        data.data()+written,
+                        data.size()-written,
+                        MSG_NOSIGNAL);
+
+    if (result<0) {
+      if (errno==EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    written+=static_cast<size_t>(result);
+  }
+
+  return true;
+}
+
+/**
+ * Blocking read of a line, data read beyond the line stays in the buffer
+ */
+static bool ReadLine(int fd,
+                     std::string& buffer,
+                     std::string& line)
+{
+  size_t pos;
+
+  while ((pos=buffer.find('\n'))==std::string::npos) {
+    char    chunk[4096];
+    ssize_t result=read(fd,chunk,sizeof(chunk));
+
+    if (result<0 && errno==EINTR) {
+      continue;
+    }
+
+    if (result<=0) {
+      return false;
+    }
+
+    buffer.append(chunk,static_cast<size_t>(result));
+  }
+
+  line=buffer.substr(0,pos);
+  buffer.erase(0,pos+1);
+
+  return true;
+}
+
+static bool ReadExact(int fd,
+                      std::string& buffer,
+                      size_t size,
+                      std::string& data)
+{
+  while (buffer.size()<size) {
+    char    chunk[65536];
+    ssize_t result=read(fd,chunk,std::min(sizeof(chunk),size-buffer.size()));
+
+    if (result<0 && errno==EINTR) {
+      continue;
+    }
+
+    if (result<=0) {
+      return false;
+    }
+
+    buffer.append(chunk,static_cast<size_t>(result));
+  }
+
+  data=buffer.substr(0,size);
+  buffer.erase(0,size);
+
+  return true;
+}
+
+/**
+ * Renders requests in a forked process. The MapService (which starts threads) must
+ * only be created after forking.
+ */
+class RenderWorker
+{
+private:
+  const Arguments&              args;
+  osmscout::DatabaseRef         database;
+  osmscout::StyleConfigRef      styleConfig;
+  osmscout::MapServiceRef       mapService;
+  osmscout::MapParameter        drawParameter;
+  osmscout::AreaSearchParameter searchParameter;
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+  std::unique_ptr<osmscout::MapPainterCairo> cairoPainter;
+#endif
+#if defined(HAVE_LIB_OSMSCOUTMAPSVG)
+  std::unique_ptr<osmscout::MapPainterSVG>   svgPainter;
+#endif
+
+private:
+  bool Draw(const osmscout::Projection& projection,
+            const osmscout::MapData& data,
+            std::string& image);
+
+public:
+  RenderWorker(const Arguments& args,
+               const osmscout::DatabaseRef& database,
+               const osmscout::StyleConfigRef& styleConfig);
+
+  bool Render(const RenderRequest& request,
+              std::string& image);
+
+  int Run(int fd);
+};
+
+RenderWorker::RenderWorker(const Arguments& args,
+                           const osmscout::DatabaseRef& database,
+                           const osmscout::StyleConfigRef& styleConfig)
+: args(args),
+  database(database),
+  styleConfig(styleConfig),
+  mapService(std::make_shared<osmscout::MapService>(database))
+{
+  if (!args.fontName.empty()) {
+    drawParameter.SetFontName(args.fontName);
+  }
+
+  drawParameter.SetFontSize(args.fontSize);
+  drawParameter.SetRenderSeaLand(true);
+  drawParameter.SetRenderUnknowns(false);
+  drawParameter.SetRenderBackground(true);
+  drawParameter.SetIconPaths(args.iconPaths);
+  drawParameter.SetDebugPerformance(args.debug);
+
+  drawParameter.SetLabelLineMinCharCount(15);
+  drawParameter.SetLabelLineMaxCharCount(30);
+  drawParameter.SetLabelLineFitToArea(true);
+
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+  if (args.format=="png") {
+    cairoPainter=std::make_unique<osmscout::MapPainterCairo>(styleConfig);
+  }
+#endif
+#if defined(HAVE_LIB_OSMSCOUTMAPSVG)
+  if (args.format=="svg") {
+    svgPainter=std::make_unique<osmscout::MapPainterSVG>(styleConfig);
+  }
+#endif
+}
+
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+static cairo_status_t AppendPngData(void* closure,
+                                    const unsigned char* data,
+                                    unsigned int length)
+{
+  static_cast<std::string*>(closure)->append(reinterpret_cast<const char*>(data),length);
+
+  return CAIRO_STATUS_SUCCESS;
+}
+#endif
+
+bool RenderWorker::Draw([[maybe_unused]] const osmscout::Projection& projection,
+                        [[maybe_unused]] const osmscout::MapData& data,
+                        [[maybe_unused]] std::string& image)
+{
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+  if (cairoPainter) {
+    cairo_surface_t* surface=cairo_image_surface_create(CAIRO_FORMAT_RGB24,
+                                                        static_cast<int>(projection.GetWidth()),
+                                                        static_cast<int>(projection.GetHeight()));
+
+    if (surface==nullptr) {
+      return false;
+    }
+
+    cairo_t* cairo=cairo_create(surface);
+    bool     success=false;
+
+    if (cairo!=nullptr) {
+      success=cairoPainter->DrawMap(projection,
+                                    drawParameter,
+                                    data,
+                                    cairo) &&
+              cairo_surface_write_to_png_stream(surface,AppendPngData,&image)==CAIRO_STATUS_SUCCESS;
+
+      cairo_destroy(cairo);
+    }
+
+    cairo_surface_destroy(surface);
+
+    return success;
+  }
+#endif
+#if defined(HAVE_LIB_OSMSCOUTMAPSVG)
+  if (svgPainter) {
+    std::ostringstream stream;
+
+    if (!svgPainter->DrawMap(projection,
+                             drawParameter,
+                             data,
+                             stream)) {
+      return false;
+    }
+
+    image=stream.str();
+
+    return true;
+  }
+#endif
+
+  return false;
+}
+
+bool RenderWorker::Render(const RenderRequest& request,
+                          std::string& image)
+{
+  osmscout::MercatorProjection projection;
+  osmscout::MapData            data;
+  std::list<osmscout::TileRef> tiles;
+
+  if (!projection.Set(request.center,
+                      osmscout::Magnification(osmscout::MagnificationLevel(static_cast<uint32_t>(request.level))),
+                      args.dpi,
+                      request.width,
+                      request.height)) {
+    return false;
+  }
+
+  mapService->LookupTiles(projection,tiles);
+
+  if (!mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles)) {
+    return false;
+  }
+
+  mapService->AddTileDataToMapData(tiles,data);
+  mapService->GetGroundTiles(projection,data.groundTiles);
+
+  tiles.clear();
+  mapService->CleanupTileCache();
+
+  return Draw(projection,
+              data,
+              image);
+}
+
+int RenderWorker::Run(int fd)
+{
+  std::string buffer;
+  std::string line;
+
+  while (ReadLine(fd,buffer,line)) {
+    std::istringstream stream(line);
+    std::string        command;
+    RenderRequest      request;
+    std::string        error;
+    std::string        response;
+
+    stream.imbue(std::locale::classic());
+    stream >> command;
+
+    if (command!="RENDER" ||
+        !ParseRenderRequest(stream,false,request,error)) {
+      response=ErrorResponse(error.empty() ? "Unknown command" : error);
+    }
+    else {
+      std::string image;
+
+      if (Render(request,image)) {
+        response=OkResponse(args.format,image);
+      }
+      else {
+        response=ErrorResponse("Rendering failed");
+      }
+    }
+
+    if (!WriteAll(fd,response)) {
+      return 1;
+    }
+  }
+
+  // Master closed the connection
+  return 0;
+}
+
+/**
+ * Least recently used cache of rendered images
+ */
+class ResultCache
+{
+private:
+  using Entry = std::pair<std::string,std::string>;
+
+  size_t                                                   capacity;
+  std::list<Entry>                                         entries;
+  std::unordered_map<std::string,std::list<Entry>::iterator> index;
+
+public:
+  explicit ResultCache(size_t capacity)
+  : capacity(capacity)
+  {
+    // no code
+  }
+
+  const std::string* Get(const std::string& key)
+  {
+    auto entry=index.find(key);
+
+    if (entry==index.end()) {
+      return nullptr;
+    }
+
+    entries.splice(entries.begin(),entries,entry->second);
+
+    return &entry->second->second;
+  }
+
+  void Put(const std::string& key,
+           const std::string& value)
+  {
+    if (capacity==0 || index.contains(key)) {
+      return;
+    }
+
+    entries.emplace_front(key,value);
+    index[key]=entries.begin();
+
+    if (entries.size()>capacity) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+  }
+
+  size_t GetSize() const
+  {
+    return entries.size();
+  }
+};
+
+/**
+ * The master process: accepts client connections, coalesces and queues requests
+ * and dispatches them to the worker processes.
+ */
+class RenderDaemon
+{
+private:
+  struct Worker
+  {
+    pid_t       pid=-1;
+    int         fd=-1;
+    bool        busy=false;
+    Priority    priority=Priority::interactive; //!< Priority of the request currently rendered
+    std::string key;                            //!< Key of the request currently rendered
+    std::string buffer;
+  };
+
+  struct Client
+  {
+    int         fd=-1;
+    std::string buffer;
+  };
+
+  struct PendingRequest
+  {
+    Priority              priority=Priority::interactive;
+    bool                  dispatched=false;
+    std::vector<uint64_t> clients; //!< Clients waiting for the result
+  };
+
+  struct Statistics
+  {
+    size_t requests=0;
+    size_t cacheHits=0;
+    size_t coalesced=0;
+    size_t promoted=0;
+    size_t rendered=0;
+    size_t errors=0;
+    size_t restartedWorkers=0;
+  };
+
+private:
+  const Arguments&                                args;
+  osmscout::DatabaseRef                           database;
+  osmscout::StyleConfigRef                        styleConfig;
+  int                                             listenFd=-1;
+  std::vector<Worker>                             workers;
+  std::map<uint64_t,Client>                       clients;
+  uint64_t                                        nextClientId=1;
+  std::unordered_map<std::string,PendingRequest>  pending;
+  std::deque<std::string>                         interactiveQueue;
+  std::deque<std::string>                         prefetchQueue;
+  ResultCache                                     cache;
+  Statistics                                      statistics;
+
+private:
+  bool StartWorker(Worker& worker);
+  void StopWorker(Worker& worker);
+  void HandleWorkerFailure(Worker& worker);
+  void HandleWorkerResponse(Worker& worker);
+
+  void AcceptClient();
+  void HandleClientData(uint64_t clientId);
+  void HandleClientLine(uint64_t clientId,
+                        const std::string& line);
+  void CloseClient(uint64_t clientId);
+  void SendToClient(uint64_t clientId,
+                    const std::string& response);
+
+  bool PopRequest(std::deque<std::string>& queue,
+                  Priority priority,
+                  std::string& key);
+  void Dispatch();
+
+  std::string GetStatistics() const;
+
+public:
+  RenderDaemon(const Arguments& args,
+               const osmscout::DatabaseRef& database,
+               const osmscout::StyleConfigRef& styleConfig);
+
+  bool Start();
+  void Run();
+  void Stop();
+};
+
+RenderDaemon::RenderDaemon(const Arguments& args,
+                           const osmscout::DatabaseRef& database,
+                           const osmscout::StyleConfigRef& styleConfig)
+: args(args),
+  database(database),
+  styleConfig(styleConfig),
+  workers(args.workers),
+  cache(args.cacheSize)
+{
+  // no code
+}
+
+bool RenderDaemon::StartWorker(Worker& worker)
+{
+  int fds[2];
+
+  if (socketpair(AF_UNIX,SOCK_STREAM,0,fds)!=0) {
+    std::cerr << "Cannot create socket pair: " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  pid_t pid=fork();
+
+  if (pid<0) {
+    std::cerr << "Cannot fork worker: " << strerror(errno) << std::endl;
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+
+  if (pid==0) {
+    // Worker process, close everything belonging to the master
+    signal(SIGINT,SIG_IGN);
+    signal(SIGTERM,SIG_DFL);
+
+    close(fds[0]);
+    close(listenFd);
+
+    for (const auto& [clientId,client] : clients) {
+      close(client.fd);
+    }
+
+    for (const auto& other : workers) {
+      if (other.fd>=0) {
+        close(other.fd);
+      }
+    }
+
+    int result;
+
+    {
+      RenderWorker renderWorker(args,
+                                database,
+                                styleConfig);
+
+      result=renderWorker.Run(fds[1]);
+    }
+
+    close(fds[1]);
+    _exit(result);
+  }
+
+  close(fds[1]);
+
+  worker.pid=pid;
+  worker.fd=fds[0];
+  worker.busy=false;
+  worker.key.clear();
+  worker.buffer.clear();
+
+  return true;
+}
+
+void RenderDaemon::StopWorker(Worker& worker)
+{
+  if (worker.fd>=0) {
+    close(worker.fd);
+    worker.fd=-1;
+  }
+
+  if (worker.pid>0) {
+    kill(worker.pid,SIGTERM);
+    waitpid(worker.pid,nullptr,0);
+    worker.pid=-1;
+  }
+}
+
+/**
+ * The worker died or the communication failed. Waiting clients get an error
+ * and the worker is replaced.
+ */
+void RenderDaemon::HandleWorkerFailure(Worker& worker)
+{
+  std::cerr << "Worker " << worker.pid << " failed, restarting" << std::endl;
+
+  if (worker.busy) {
+    auto entry=pending.find(worker.key);
+
+    if (entry!=pending.end()) {
+      std::vector<uint64_t> waitingClients=std::move(entry->second.clients);
+
+      pending.erase(entry);
+
+      for (auto clientId : waitingClients) {
+        SendToClient(clientId,ErrorResponse("Worker failed"));
+      }
+    }
+
+    statistics.errors++;
+  }
+
+  StopWorker(worker);
+
+  statistics.restartedWorkers++;
+
+  StartWorker(worker);
+}
+
+void RenderDaemon::HandleWorkerResponse(Worker& worker)
+{
+  std::string header;
+  std::string response;
+
+  if (!ReadLine(worker.fd,worker.buffer,header)) {
+    HandleWorkerFailure(worker);
+    return;
+  }
+
+  if (header.starts_with("OK ")) {
+    std::istringstream stream(header);
+    std::string        status;
+    std::string        format;
+    size_t             size=0;
+    std::string        data;
+
+    stream >> status >> format >> size;
+
+    if (!ReadExact(worker.fd,worker.buffer,size,data)) {
+      HandleWorkerFailure(worker);
+      return;
+    }
+
+    response=header+"\n"+data;
+    cache.Put(worker.key,response);
+    statistics.rendered++;
+  }
+  else {
+    response=header+"\n";
+    statistics.errors++;
+  }
+
+  auto entry=pending.find(worker.key);
+
+  worker.busy=false;
+  worker.key.clear();
+
+  if (entry==pending.end()) {
+    return;
+  }
+
+  std::vector<uint64_t> waitingClients=std::move(entry->second.clients);
+
+  pending.erase(entry);
+
+  for (auto clientId : waitingClients) {
+    SendToClient(clientId,response);
+  }
+}
+
+void RenderDaemon::AcceptClient()
+{
+  int fd=accept(listenFd,nullptr,nullptr);
+
+  if (fd<0) {
+    return;
+  }
+
+  // Do not block the master forever on clients not reading their answer
+  timeval timeout{5,0};
+
+  setsockopt(fd,SOL_SOCKET,SO_SNDTIMEO,&timeout,sizeof(timeout));
+
+  clients[nextClientId++].fd=fd;
+}
+
+void RenderDaemon::HandleClientData(uint64_t clientId)
+{
+  Client& client=clients[clientId];
+  char    chunk[4096];
+  ssize_t result=recv(client.fd,chunk,sizeof(chunk),0);
+
+  if (result<=0) {
+    CloseClient(clientId);
+    return;
+  }
+
+  client.buffer.append(chunk,static_cast<size_t>(result));
+
+  size_t pos;
+
+  while (clients.contains(clientId) &&
+         (pos=clients[clientId].buffer.find('\n'))!=std::string::npos) {
+    std::string line=clients[clientId].buffer.substr(0,pos);
+
+    clients[clientId].buffer.erase(0,pos+1);
+
+    if (!line.empty() && line.back()=='\r') {
+      line.pop_back();
+    }
+
+    HandleClientLine(clientId,line);
+  }
+
+  if (clients.contains(clientId) &&
+      clients[clientId].buffer.size()>4096) {
+    SendToClient(clientId,ErrorResponse("Request too long"));
+    CloseClient(clientId);
+  }
+}
+
+void RenderDaemon::HandleClientLine(uint64_t clientId,
+                                    const std::string& line)
+{
+  std::istringstream stream(line);
+  std::string        command;
+
+  stream.imbue(std::locale::classic());
+  stream >> command;
+
+  if (command.empty()) {
+    return;
+  }
+
+  if (command=="STATS") {
+    SendToClient(clientId,OkResponse("text",GetStatistics()));
+    return;
+  }
+
+  if (command!="RENDER") {
+    SendToClient(clientId,ErrorResponse("Unknown command '"+command+"'"));
+    return;
+  }
+
+  RenderRequest request;
+  std::string   error;
+
+  if (!ParseRenderRequest(stream,true,request,error)) {
+    SendToClient(clientId,ErrorResponse(error));
+    return;
+  }
+
+  statistics.requests++;
+
+  std::string        key=request.GetKey();
+  const std::string* cached=cache.Get(key);
+
+  if (cached!=nullptr) {
+    statistics.cacheHits++;
+    SendToClient(clientId,*cached);
+    return;
+  }
+
+  auto entry=pending.find(key);
+
+  if (entry!=pending.end()) {
+    // The same image is already queued or rendered, just wait for the result
+    statistics.coalesced++;
+    entry->second.clients.push_back(clientId);
+
+    if (request.priority==Priority::interactive &&
+        entry->second.priority==Priority::prefetch &&
+        !entry->second.dispatched) {
+      // Somebody is waiting for a prefetched image, move it to the interactive queue.
+      // The entry in the prefetch queue is skipped later on.
+      statistics.promoted++;
+      entry->second.priority=Priority::interactive;
+      interactiveQueue.push_back(key);
+    }
+
+    return;
+  }
+
+  PendingRequest& pendingRequest=pending[key];
+
+  pendingRequest.priority=request.priority;
+  pendingRequest.clients.push_back(clientId);
+
+  if (request.priority==Priority::interactive) {
+    interactiveQueue.push_back(key);
+  }
+  else {
+    prefetchQueue.push_back(key);
+  }
+}
+
+void RenderDaemon::CloseClient(uint64_t clientId)
+{
+  auto client=clients.find(clientId);
+
+  if (client==clients.end()) {
+    return;
+  }
+
+  close(client->second.fd);
+  clients.erase(client);
+
+  // Pending requests are still rendered to fill the cache, the result is just not sent
+}
+
+void RenderDaemon::SendToClient(uint64_t clientId,
+                                const std::string& response)
+{
+  auto client=clients.find(clientId);
+
+  if (client==clients.end()) {
+    return;
+  }
+
+  if (!WriteAll(client->second.fd,response)) {
+    CloseClient(clientId);
+  }
+}
+
+/**
+ * Take the next request from the queue, skipping entries that were already
+ * dispatched or promoted to the other queue
+ */
+bool RenderDaemon::PopRequest(std::deque<std::string>& queue,
+                              Priority priority,
+                              std::string& key)
+{
+  while (!queue.empty()) {
+    key=std::move(queue.front());
+    queue.pop_front();
+
+    auto entry=pending.find(key);
+
+    if (entry!=pending.end() &&
+        !entry->second.dispatched &&
+        entry->second.priority==priority) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void RenderDaemon::Dispatch()
+{
+  size_t maxPrefetchWorkers=args.prefetchWorkers>0 ? args.prefetchWorkers : std::max<size_t>(workers.size()-1,1);
+  size_t prefetchWorkers=std::count_if(workers.begin(),workers.end(),[](const Worker& worker) {
+    return worker.busy && worker.priority==Priority::prefetch;
+  });
+
+  for (auto& worker : workers) {
+    if (worker.busy || worker.fd<0) {
+      continue;
+    }
+
+    std::string key;
+    Priority    priority=Priority::interactive;
+
+    if (!PopRequest(interactiveQueue,Priority::interactive,key)) {
+      // Keep workers free for interactive requests
+      if (prefetchWorkers>=maxPrefetchWorkers ||
+          !PopRequest(prefetchQueue,Priority::prefetch,key)) {
+        return;
+      }
+
+      priority=Priority::prefetch;
+      prefetchWorkers++;
+    }
+
+    pending[key].dispatched=true;
+
+    worker.busy=true;
+    worker.priority=priority;
+    worker.key=key;
+
+    if (!WriteAll(worker.fd,key+"\n")) {
+      HandleWorkerFailure(worker);
+    }
+  }
+}
+
+std::string RenderDaemon::GetStatistics() const
+{
+  std::ostringstream stream;
+  size_t             busyWorkers=std::count_if(workers.begin(),workers.end(),[](const Worker& worker) {
+    return worker.busy;
+  });
+
+  stream << "requests " << statistics.requests << "\n";
+  stream << "cache_hits " << statistics.cacheHits << "\n";
+  stream << "coalesced " << statistics.coalesced << "\n";
+  stream << "promoted " << statistics.promoted << "\n";
+  stream << "rendered " << statistics.rendered << "\n";
+  stream << "errors " << statistics.errors << "\n";
+  stream << "restarted_workers " << statistics.restartedWorkers << "\n";
+  stream << "pending " << pending.size() << "\n";
+  stream << "cached " << cache.GetSize() << "\n";
+  stream << "workers " << workers.size() << "\n";
+  stream << "busy_workers " << busyWorkers << "\n";
+  stream << "clients " << clients.size() << "\n";
+
+  return stream.str();
+}
+
+bool RenderDaemon::Start()
+{
+  sockaddr_un address{};
+
+  if (args.socket.size()>=sizeof(address.sun_path)) {
+    std::cerr << "Socket path '" << args.socket << "' too long" << std::endl;
+    return false;
+  }
+
+  listenFd=socket(AF_UNIX,SOCK_STREAM,0);
+
+  if (listenFd<0) {
+    std::cerr << "Cannot create socket: " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  address.sun_family=AF_UNIX;
+  std::strncpy(address.sun_path,args.socket.c_str(),sizeof(address.sun_path)-1);
+
+  unlink(args.socket.c_str());
+
+  if (bind(listenFd,reinterpret_cast<sockaddr*>(&address),sizeof(address))!=0 ||
+      listen(listenFd,64)!=0) {
+    std::cerr << "Cannot listen on '" << args.socket << "': " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  for (auto& worker : workers) {
+    if (!StartWorker(worker)) {
+      return false;
+    }
+  }
+
+  std::cout << "Listening on '" << args.socket << "' with " << workers.size() << " workers" << std::endl;
+
+  return true;
+}
+
+void RenderDaemon::Run()
+{
+  while (stopRequested==0) {
+    std::vector<pollfd>   fds;
+    std::vector<uint64_t> clientIds;
+
+    fds.push_back({listenFd,POLLIN,0});
+
+    for (const auto& worker : workers) {
+      fds.push_back({worker.fd,POLLIN,0});
+    }
+
+    for (const auto& [clientId,client] : clients) {
+      fds.push_back({client.fd,POLLIN,0});
+      clientIds.push_back(clientId);
+    }
+
+    if (poll(fds.data(),fds.size(),-1)<0) {
+      if (errno==EINTR) {
+        continue;
+      }
+
+      std::cerr << "poll() failed: " << strerror(errno) << std::endl;
+      break;
+    }
+
+    for (size_t i=0; i<workers.size(); i++) {
+      if (fds[1+i].revents!=0) {
+        if (workers[i].busy && (fds[1+i].revents & POLLIN)!=0) {
+          HandleWorkerResponse(workers[i]);
+        }
+        else {
+          HandleWorkerFailure(workers[i]);
+        }
+      }
+    }
+
+    for (size_t i=0; i<clientIds.size(); i++) {
+      if (fds[1+workers.size()+i].revents!=0) {
+        HandleClientData(clientIds[i]);
+      }
+    }
+
+    if ((fds[0].revents & POLLIN)!=0) {
+      AcceptClient();
+    }
+
+    Dispatch();
+  }
+}
+
+void RenderDaemon::Stop()
+{
+  for (auto& worker : workers) {
+    StopWorker(worker);
+  }
+
+  for (const auto& [clientId,client] : clients) {
+    close(client.fd);
+  }
+
+  clients.clear();
+
+  if (listenFd>=0) {
+    close(listenFd);
+    unlink(args.socket.c_str());
+    listenFd=-1;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  osmscout::CmdLineParser argParser("RenderDaemon",
+                                    argc,argv);
+  Arguments               args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      std::vector<std::string>{"h","help"},
+                      "Display help",
+                      true);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.debug=value;
+                      }),
+                      "debug",
+                      "Enable debug output");
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.workers=std::max<size_t>(value,1);
+                      }),
+                      "workers",
+                      "Number of worker processes ("+std::to_string(args.workers)+")");
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.prefetchWorkers=value;
+                      }),
+                      "prefetchWorkers",
+                      "Maximum number of workers rendering prefetch requests (all but one)");
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.cacheSize=value;
+                      }),
+                      "cacheSize",
+                      "Number of rendered images to cache ("+std::to_string(args.cacheSize)+")");
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.format=value;
+                      }),
+                      "format",
+                      "Image format, png (cairo) or svg ("+args.format+")");
+  argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                        args.dpi=value;
+                      }),
+                      "dpi",
+                      "Rendering DPI ("+std::to_string(args.dpi)+")");
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.fontName=value;
+                      }),
+                      "fontName",
+                      "Rendering font");
+  argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                        args.fontSize=value;
+                      }),
+                      "fontSize",
+                      "Rendering font size ("+std::to_string(args.fontSize)+")");
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.iconPaths.push_back(value);
+                      }),
+                      "iconPath",
+                      "Icon lookup directory");
+  argParser.AddOption(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& value) {
+                        args.preloadMin=value;
+                        args.preload=true;
+                      }),
+                      "preloadMin",
+                      "Minimum coordinate of the area to preload before forking");
+  argParser.AddOption(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& value) {
+                        args.preloadMax=value;
+                        args.preload=true;
+                      }),
+                      "preloadMax",
+                      "Maximum coordinate of the area to preload before forking");
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.preloadLevel=value;
+                      }),
+                      "preloadLevel",
+                      "Zoom level used for preloading ("+std::to_string(args.preloadLevel)+")");
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.map=value;
+                          }),
+                          "databaseDir",
+                          "Database directory");
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.style=value;
+                          }),
+                          "stylesheet",
+                          "Map stylesheet");
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.socket=value;
+                          }),
+                          "socket",
+                          "Path of the Unix socket to listen on");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  bool formatSupported=false;
+
+#if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
+  formatSupported=formatSupported || args.format=="png";
+#endif
+#if defined(HAVE_LIB_OSMSCOUTMAPSVG)
+  formatSupported=formatSupported || args.format=="svg";
+#endif
+
+  if (!formatSupported) {
+    std::cerr << "Image format '" << args.format << "' is not supported by this build" << std::endl;
+    return 1;
+  }
+
+  osmscout::log.Debug(args.debug);
+
+  // Everything loaded here is shared with the workers. Memory mapping (the default) is
+  // required, so that the workers do not share the file positions of the inherited descriptors.
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(args.map)) {
+    std::cerr << "Cannot open db" << std::endl;
+    return 1;
+  }
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  if (!styleConfig->Load(args.style)) {
+    std::cerr << "Cannot open style" << std::endl;
+    return 1;
+  }
+
+  if (args.preload) {
+    // Warm up the database caches. The MapService is destroyed again, because its
+    // threads would not survive forking.
+    osmscout::MapService          mapService(database);
+    osmscout::AreaSearchParameter searchParameter;
+    std::list<osmscout::TileRef>  tiles;
+
+    std::cout << "Preloading data..." << std::endl;
+
+    mapService.LookupTiles(osmscout::Magnification(osmscout::MagnificationLevel(static_cast<uint32_t>(args.preloadLevel))),
+                           osmscout::GeoBox(args.preloadMin,args.preloadMax),
+                           tiles);
+
+    if (!mapService.LoadMissingTileData(searchParameter,*styleConfig,tiles)) {
+      std::cerr << "Cannot preload data" << std::endl;
+      return 1;
+    }
+  }
+
+  signal(SIGPIPE,SIG_IGN);
+
+  struct sigaction action{};
+
+  action.sa_handler=HandleStopSignal;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT,&action,nullptr);
+  sigaction(SIGTERM,&action,nullptr);
+
+  RenderDaemon daemon(args,
+                      database,
+                      styleConfig);
+
+  if (!daemon.Start()) {
+    daemon.Stop();
+    return 1;
+  }
+
+  daemon.Run();
+
+  std::cout << "Stopping..." << std::endl;
+
+  daemon.Stop();
+  database->Close();
+
+  return 0;
+}
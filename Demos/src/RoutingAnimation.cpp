@@ -152,6 +152,7 @@ public:
   ~RoutingServiceAnimation() override = default;
 
   bool WalkToOtherDatabases(const osmscout::RoutingProfile& /*state*/,
+                            osmscout::MemoryArena& /*arena*/,
                             osmscout::RoutingService::RNodeRef &current,
                             osmscout::RouteNodeRef &/*currentRouteNode*/,
                             osmscout::RoutingService::OpenList &openList,
@@ -94,8 +94,12 @@ void DumpHelp(osmscout::ImportParameter& parameter)
   std::cout << std::endl;
 
   std::cout << " --strictAreas true|false             assure that areas are simple (default: " << osmscout::BoolToString(parameter.GetStrictAreas()) << ")" << std::endl;
+  std::cout << " --optimizationPreserveTopology true|false" << std::endl;
+  std::cout << "                                      simplify shared borders of low zoom ways and areas identically (default: " << osmscout::BoolToString(parameter.GetOptimizationPreserveTopology()) << ")" << std::endl;
 
   std::cout << " --processingQueueSize <number>       size of of the processing worker queues (default: " << parameter.GetProcessingQueueSize() << ")" << std::endl;
+  std::cout << " --processingThreadCount <number>     number of threads of the parallel processing steps, 0 for one per core (default: " << parameter.GetProcessingThreadCount() << ")" << std::endl;
+  std::cout << " --blockCoordEncoding true|false      smaller, but slower to decode coordinates of ways and areas (default: " << osmscout::BoolToString(parameter.GetBlockCoordEncoding()) << ")" << std::endl;
   std::cout << std::endl;
 
   std::cout << " --numericIndexPageSize <number>      size of an numeric index page in bytes (default: " << parameter.GetNumericIndexPageSize() << ")" << std::endl;
@@ -313,10 +317,15 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
 
   progress.Info(std::string("StrictAreas: ")+
                 (parameter.GetStrictAreas() ? "true" : "false"));
+  progress.Info(std::string("OptimizationPreserveTopology: ")+
+                (parameter.GetOptimizationPreserveTopology() ? "true" : "false"));
 
   progress.Info(std::string("ProcessingQueueSize: ")+
                 std::to_string(parameter.GetProcessingQueueSize()));
 
+  progress.Info(std::string("ProcessingThreadCount: ")+
+                std::to_string(parameter.GetProcessingThreadCount()));
+
   progress.Info(std::string("NumericIndexPageSize: ")+
                 std::to_string(parameter.GetNumericIndexPageSize()));
 
@@ -385,6 +394,9 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
   progress.Info(std::string("Eco: ")+
                 (parameter.IsEco() ? "true" : "false"));
 
+  progress.Info(std::string("BlockCoordEncoding: ")+
+                (parameter.GetBlockCoordEncoding() ? "true" : "false"));
+
   progress.Info(std::string("TextIndexVariant: ") +
                 TextIndexVariantStr(parameter.GetTextIndexVariant()));
 }
@@ -604,6 +616,19 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--optimizationPreserveTopology")==0) {
+      bool optimizationPreserveTopology;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      optimizationPreserveTopology)) {
+        parameter.SetOptimizationPreserveTopology(optimizationPreserveTopology);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--processingQueueSize")==0) {
       size_t processingQueueSize;
 
@@ -617,6 +642,19 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--processingThreadCount")==0) {
+      size_t processingThreadCount;
+
+      if (osmscout::ParseSizeTArgument(argc,
+                                       argv,
+                                       i,
+                                       processingThreadCount)) {
+        parameter.SetProcessingThreadCount(processingThreadCount);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--numericIndexPageSize")==0) {
       size_t numericIndexPageSize;
 
@@ -843,6 +881,19 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--blockCoordEncoding")==0) {
+      bool blockCoordEncoding;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      blockCoordEncoding)) {
+        parameter.SetBlockCoordEncoding(blockCoordEncoding);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--wayDataMemoryMaped")==0) {
       bool wayDataMemoryMaped;
 
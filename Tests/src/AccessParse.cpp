@@ -104,17 +104,18 @@ void CheckParseSuccess(bool canFoot,
                        const std::unordered_map<std::string,std::string>& stringTags,
                        uint8_t& actualAccessValue)
 {
-  osmscout::SilentTagErrorReporter                reporter;
-  osmscout::TypeConfig                            typeConfig;
-  osmscout::TypeInfoRef                           testType=std::make_shared<osmscout::TypeInfo>("TestType");
-  osmscout::FeatureRef                            accessFeature;
-  size_t                                          featureInstanceIndex;
-  std::unordered_map<osmscout::TagId,std::string> tags;
+  osmscout::SilentTagErrorReporter reporter;
+  osmscout::TypeConfig             typeConfig;
+  osmscout::TypeInfoRef            testType=std::make_shared<osmscout::TypeInfo>("TestType");
+  osmscout::FeatureRef             accessFeature;
+  size_t                           featureInstanceIndex;
+  osmscout::TagMap                 tags;
 
   for (const auto &entry : stringTags) {
     osmscout::TagId tagId=typeConfig.GetTagRegistry().RegisterTag(entry.first);
 
-    tags[tagId]=entry.second;
+    tags.Set(tagId,
+             entry.second);
   }
 
   accessFeature=typeConfig.GetFeature(osmscout::AccessFeature::NAME);
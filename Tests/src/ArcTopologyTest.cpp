@@ -0,0 +1,202 @@
+/*
+  ArcTopologyTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscoutimport/ArcTopology.h>
+
+#include <TestMain.h>
+
+static const std::vector<double> minAreas={0.0,1.0e-9,1.0e-7,1.0e-5,1.0e-3,1.0};
+
+static osmscout::Point CreatePoint(double lat,
+                                   double lon)
+{
+  return osmscout::Point(0,osmscout::GeoCoord(lat,lon));
+}
+
+/**
+ * Wiggly border from (50.0,10.0) to (50.0,11.0)
+ */
+static std::vector<osmscout::Point> CreateBorder()
+{
+  std::vector<osmscout::Point> border;
+
+  for (size_t i=0; i<=100; i++) {
+    border.push_back(CreatePoint(50.0+0.01*std::sin(double(i)*0.7)*std::sin(double(i)*0.05),
+                                 10.0+double(i)/100.0));
+  }
+
+  border.front()=CreatePoint(50.0,10.0);
+  border.back()=CreatePoint(50.0,11.0);
+
+  return border;
+}
+
+static std::set<osmscout::Id> GetKeptCoords(const osmscout::ArcTopology& topology,
+                                            size_t line,
+                                            const std::vector<osmscout::Point>& nodes,
+                                            double minArea)
+{
+  std::vector<bool>      keep;
+  std::set<osmscout::Id> coords;
+
+  topology.GetNodesToKeep(line,minArea,keep);
+
+  REQUIRE(keep.size()==nodes.size());
+
+  for (size_t i=0; i<nodes.size(); i++) {
+    if (keep[i]) {
+      coords.insert(nodes[i].GetCoord().GetHash());
+    }
+  }
+
+  return coords;
+}
+
+static void CalculateEffectiveAreas(osmscout::ArcTopology& topology)
+{
+  osmscout::MercatorProjection projection;
+
+  projection.Set(osmscout::GeoCoord(0.0,0.0),
+                 osmscout::Magnification(osmscout::MagnificationLevel(0)),
+                 320.0,
+                 800,480);
+
+  topology.Build();
+  topology.CalculateEffectiveAreas(projection,
+                                   0);
+}
+
+TEST_CASE("Neighbouring areas keep the same nodes on their shared border")
+{
+  std::vector<osmscout::Point> border=CreateBorder();
+  std::vector<osmscout::Point> north(border);
+  std::vector<osmscout::Point> south(border.rbegin(),border.rend());
+
+  north.push_back(CreatePoint(50.5,11.0));
+  north.push_back(CreatePoint(50.6,10.5));
+  north.push_back(CreatePoint(50.5,10.0));
+
+  south.push_back(CreatePoint(49.5,10.0));
+  south.push_back(CreatePoint(49.4,10.5));
+  south.push_back(CreatePoint(49.5,11.0));
+
+  osmscout::ArcTopology topology;
+
+  size_t northLine=topology.AddLine(north,true);
+  size_t southLine=topology.AddLine(south,true);
+
+  CalculateEffectiveAreas(topology);
+
+  // The shared border and the two remaining parts of the rings
+  REQUIRE(topology.GetArcCount()==3);
+
+  std::set<osmscout::Id> borderCoords;
+
+  for (const auto& node : border) {
+    borderCoords.insert(node.GetCoord().GetHash());
+  }
+
+  std::set<osmscout::Id> previousNorth;
+
+  for (double minArea : minAreas) {
+    std::set<osmscout::Id> northCoords=GetKeptCoords(topology,northLine,north,minArea);
+    std::set<osmscout::Id> southCoords=GetKeptCoords(topology,southLine,south,minArea);
+    std::set<osmscout::Id> northBorder;
+    std::set<osmscout::Id> southBorder;
+
+    for (osmscout::Id coord : northCoords) {
+      if (borderCoords.find(coord)!=borderCoords.end()) {
+        northBorder.insert(coord);
+      }
+    }
+
+    for (osmscout::Id coord : southCoords) {
+      if (borderCoords.find(coord)!=borderCoords.end()) {
+        southBorder.insert(coord);
+      }
+    }
+
+    REQUIRE(northBorder==southBorder);
+
+    // Junctions are always kept
+    REQUIRE(northBorder.count(border.front().GetCoord().GetHash())==1);
+    REQUIRE(northBorder.count(border.back().GetCoord().GetHash())==1);
+
+    // Bigger tolerances keep a subset of the nodes of smaller tolerances
+    if (!previousNorth.empty()) {
+      for (osmscout::Id coord : northCoords) {
+        REQUIRE(previousNorth.count(coord)==1);
+      }
+    }
+
+    previousNorth=northCoords;
+  }
+
+  REQUIRE(GetKeptCoords(topology,northLine,north,0.0).size()==north.size());
+  REQUIRE(GetKeptCoords(topology,northLine,north,minAreas.back()).size()<north.size());
+}
+
+TEST_CASE("Ways keep their end points and identical rings their nodes")
+{
+  std::vector<osmscout::Point> way=CreateBorder();
+  std::vector<osmscout::Point> ring;
+
+  for (size_t i=0; i<50; i++) {
+    double angle=2*M_PI*double(i)/50.0;
+
+    ring.push_back(CreatePoint(45.0+0.1*std::sin(angle)*(1.0+0.1*std::sin(angle*7.0)),
+                               5.0+0.1*std::cos(angle)));
+  }
+
+  // The same ring, starting at another node, in the other direction and closed explicitly
+  std::vector<osmscout::Point> otherRing(ring.rbegin()+10,ring.rend());
+
+  otherRing.insert(otherRing.end(),ring.rbegin(),ring.rbegin()+10);
+  otherRing.push_back(otherRing.front());
+
+  osmscout::ArcTopology topology;
+
+  size_t wayLine=topology.AddLine(way,false);
+  size_t ringLine=topology.AddLine(ring,true);
+  size_t otherRingLine=topology.AddLine(otherRing,true);
+
+  CalculateEffectiveAreas(topology);
+
+  REQUIRE(topology.GetArcCount()==2);
+
+  for (double minArea : minAreas) {
+    std::vector<bool> keep;
+
+    topology.GetNodesToKeep(wayLine,minArea,keep);
+
+    REQUIRE(keep.front());
+    REQUIRE(keep.back());
+
+    std::set<osmscout::Id> ringCoords=GetKeptCoords(topology,ringLine,ring,minArea);
+    std::set<osmscout::Id> otherRingCoords=GetKeptCoords(topology,otherRingLine,otherRing,minArea);
+
+    REQUIRE(ringCoords==otherRingCoords);
+  }
+}
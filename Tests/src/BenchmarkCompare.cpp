@@ -0,0 +1,197 @@
+/*
+  BenchmarkCompare - a benchmark program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscoutclient/json/json.hpp>
+
+/*
+  Compares two result files written by SyntheticMapBenchmark and flags
+  scenarios, whose median got slower by more than the given threshold.
+
+  To not report noise, the difference must in addition exceed two standard
+  errors of the difference of the means of both runs.
+
+  Returns 0 if there is no regression, 1 on errors and 2 if there are regressions.
+*/
+
+struct Arguments
+{
+  bool        help=false;
+  std::string baseline;
+  std::string current;
+  double      threshold=10.0; //!< Allowed slowdown in percent
+};
+
+struct Scenario
+{
+  double median=0.0;
+  double stddev=0.0;
+  size_t count=0;
+};
+
+static bool LoadResults(const std::string& filename,
+                        std::map<std::string,Scenario>& scenarios)
+{
+  std::ifstream stream(filename);
+
+  if (!stream) {
+    std::cerr << "Cannot open '" << filename << "'" << std::endl;
+    return false;
+  }
+
+  try {
+    nlohmann::json doc=nlohmann::json::parse(stream);
+
+    for (const auto& entry : doc.at("scenarios")) {
+      Scenario scenario;
+
+      scenario.median=entry.at("median").get<double>();
+      scenario.stddev=entry.at("stddev").get<double>();
+      scenario.count=entry.at("count").get<size_t>();
+
+      scenarios[entry.at("name").get<std::string>()]=scenario;
+    }
+  }
+  catch (const nlohmann::json::exception& e) {
+    std::cerr << "Cannot parse '" << filename << "': " << e.what() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  osmscout::CmdLineParser  argParser("BenchmarkCompare",
+                                     argc,argv);
+  std::vector<std::string> helpArgs{"h","help"};
+  Arguments                args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      helpArgs,
+                      "Return argument help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                        args.threshold=value;
+                      }),
+                      "threshold",
+                      "Allowed slowdown of the median in percent (default: 10)");
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.baseline=value;
+                          }),
+                          "BASELINE",
+                          "Result file of the baseline run");
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.current=value;
+                          }),
+                          "CURRENT",
+                          "Result file of the current run");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  std::map<std::string,Scenario> baseline;
+  std::map<std::string,Scenario> current;
+
+  if (!LoadResults(args.baseline,baseline) ||
+      !LoadResults(args.current,current)) {
+    return 1;
+  }
+
+  size_t regressions=0;
+
+  std::cout << std::left << std::setw(24) << "Scenario";
+  std::cout << std::right << std::setw(14) << "Baseline us" << std::setw(14) << "Current us" << std::setw(10) << "Change";
+  std::cout << "  Status" << std::endl;
+
+  for (const auto& [name,currentScenario] : current) {
+    auto baselineEntry=baseline.find(name);
+
+    std::cout << std::left << std::setw(24) << name << std::right;
+
+    if (baselineEntry==baseline.end()) {
+      std::cout << std::setw(14) << "-" << std::fixed << std::setprecision(1) << std::setw(14) << currentScenario.median;
+      std::cout << std::setw(10) << "-" << "  new" << std::endl;
+      continue;
+    }
+
+    const Scenario& baselineScenario=baselineEntry->second;
+    double          difference=currentScenario.median-baselineScenario.median;
+    double          change=baselineScenario.median>0.0 ? 100.0*difference/baselineScenario.median : 0.0;
+    double          noise=0.0;
+
+    if (baselineScenario.count>0 && currentScenario.count>0) {
+      noise=2.0*std::sqrt(baselineScenario.stddev*baselineScenario.stddev/baselineScenario.count+
+                          currentScenario.stddev*currentScenario.stddev/currentScenario.count);
+    }
+
+    std::string status="ok";
+
+    if (change>args.threshold && difference>noise) {
+      status="REGRESSION";
+      regressions++;
+    }
+    else if (change<-args.threshold && -difference>noise) {
+      status="improved";
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(14) << baselineScenario.median << std::setw(14) << currentScenario.median;
+    std::cout << std::showpos << std::setw(9) << change << "%" << std::noshowpos;
+    std::cout << "  " << status << std::endl;
+  }
+
+  for (const auto& [name,baselineScenario] : baseline) {
+    if (current.find(name)==current.end()) {
+      std::cout << std::left << std::setw(24) << name << std::right;
+      std::cout << std::fixed << std::setprecision(1) << std::setw(14) << baselineScenario.median;
+      std::cout << std::setw(14) << "-" << std::setw(10) << "-" << "  missing" << std::endl;
+    }
+  }
+
+  if (regressions>0) {
+    std::cout << regressions << " scenario(s) regressed by more than " << args.threshold << "%" << std::endl;
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,434 @@
+/*
+  BidirectionalRouting - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <osmscoutimport/Import.h>
+#include <osmscoutimport/ImportProgress.h>
+
+#include <osmscout-test/PreprocessSynthetic.h>
+
+/**
+ * Imports synthetic maps and compares the routes of the unidirectional and the
+ * bidirectional search.
+ */
+
+class QuietImportProgress : public osmscout::ImportProgress
+{
+public:
+  void SetStep(const std::string& /*step*/) override
+  {
+    // no code
+  }
+
+  void SetProgress(double /*current*/, double /*total*/, const std::string& /*label*/) override
+  {
+    // no code
+  }
+
+  void SetAction(const std::string& /*action*/) override
+  {
+    // no code
+  }
+
+  void Debug(const std::string& /*text*/) override
+  {
+    // no code
+  }
+
+  void Info(const std::string& /*text*/) override
+  {
+    // no code
+  }
+
+  void Warning(const std::string& /*text*/) override
+  {
+    // no code
+  }
+};
+
+class PreprocessorFactory : public osmscout::PreprocessorFactory
+{
+private:
+  osmscout::test::SyntheticMapParameter mapParameter;
+
+public:
+  explicit PreprocessorFactory(const osmscout::test::SyntheticMapParameter& mapParameter)
+  : mapParameter(mapParameter)
+  {
+    // no code
+  }
+
+  std::unique_ptr<osmscout::Preprocessor> GetProcessor(const std::string& /*filename*/,
+                                                       osmscout::PreprocessorCallback& callback) const override
+  {
+    return std::make_unique<osmscout::test::PreprocessSynthetic>(callback,mapParameter);
+  }
+};
+
+struct Crossing
+{
+  size_t row;
+  size_t column;
+};
+
+struct Route
+{
+  double             cost;
+  osmscout::Distance length;
+};
+
+/**
+ * Routes between crossings of a synthetic map using the unidirectional and the
+ * bidirectional search
+ */
+class RouteChecker
+{
+private:
+  const osmscout::test::SyntheticMapParameter& mapParameter;
+  osmscout::DatabaseRef                        database;
+  osmscout::SimpleRoutingServiceRef            router;
+  osmscout::FastestPathRoutingProfileRef       profile;
+
+private:
+  std::optional<Route> CalculateRoute(const osmscout::RoutePosition& start,
+                                      const osmscout::RoutePosition& target,
+                                      bool bidirectional)
+  {
+    osmscout::RoutingParameter parameter;
+
+    parameter.SetBidirectional(bidirectional);
+
+    auto result=router->CalculateRoute(*profile,
+                                       start,
+                                       target,
+                                       std::nullopt,
+                                       parameter);
+
+    if (!result.Success()) {
+      return std::nullopt;
+    }
+
+    auto pointsResult=router->TransformRouteDataToPoints(result.GetRoute());
+
+    if (!pointsResult.Success()) {
+      return std::nullopt;
+    }
+
+    const auto& points=pointsResult.GetPoints()->points;
+    Route       route{result.GetCost(),osmscout::Distance()};
+
+    for (size_t i=1; i<points.size(); i++) {
+      route.length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                                   points[i].GetCoord());
+    }
+
+    return route;
+  }
+
+public:
+  explicit RouteChecker(const osmscout::test::SyntheticMapParameter& mapParameter)
+  : mapParameter(mapParameter)
+  {
+    // no code
+  }
+
+  bool Open(const std::string& directory)
+  {
+    osmscout::DatabaseParameter  databaseParameter;
+    osmscout::RouterParameter    routerParameter;
+    std::map<std::string,double> carSpeedTable;
+
+    database=std::make_shared<osmscout::Database>(databaseParameter);
+
+    if (!database->Open(directory)) {
+      std::cerr << "Cannot open database" << std::endl;
+      return false;
+    }
+
+    router=std::make_shared<osmscout::SimpleRoutingService>(database,
+                                                            routerParameter,
+                                                            osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+    if (!router->Open()) {
+      std::cerr << "Cannot open routing database" << std::endl;
+      return false;
+    }
+
+    carSpeedTable["highway_primary"]=70.0;
+    carSpeedTable["highway_residential"]=20.0;
+
+    profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+    profile->ParametrizeForCar(*database->GetTypeConfig(),
+                               carSpeedTable,
+                               160.0);
+
+    // Junction penalties depend on the incoming path, which neither search takes into
+    // account when closing a route node, so the costs would only be comparable on average
+    profile->SetJunctionPenalty(false);
+
+    return true;
+  }
+
+  void Close()
+  {
+    router->Close();
+    database->Close();
+  }
+
+  /**
+   * Route between both crossings using the unidirectional and the bidirectional search.
+   * Returns false, if one of the searches fails.
+   */
+  bool CalculateRoutes(const Crossing& from,
+                       const Crossing& to,
+                       Route& route,
+                       Route& bidirectionalRoute)
+  {
+    auto start=router->GetClosestRoutableNode(mapParameter.GetCrossing(from.row,from.column),
+                                              *profile,
+                                              osmscout::Meters(10));
+    auto target=router->GetClosestRoutableNode(mapParameter.GetCrossing(to.row,to.column),
+                                               *profile,
+                                               osmscout::Meters(10));
+
+    std::cout << "(" << from.row << "," << from.column << ") => (" << to.row << "," << to.column << "): ";
+
+    if (!start.IsValid() ||
+        !target.IsValid()) {
+      std::cout << "cannot find route node for crossing" << std::endl;
+      return false;
+    }
+
+    auto result=CalculateRoute(start.GetRoutePosition(),
+                               target.GetRoutePosition(),
+                               false);
+    auto bidirectionalResult=CalculateRoute(start.GetRoutePosition(),
+                                            target.GetRoutePosition(),
+                                            true);
+
+    if (!result ||
+        !bidirectionalResult) {
+      std::cout << "route failed" << std::endl;
+      return false;
+    }
+
+    route=*result;
+    bidirectionalRoute=*bidirectionalResult;
+
+    std::cout << std::setprecision(10) << route.cost << ", bidirectional: " << bidirectionalRoute.cost << std::endl;
+
+    return true;
+  }
+};
+
+static bool ImportMap(const std::string& typefile,
+                      const std::string& directory,
+                      const osmscout::test::SyntheticMapParameter& mapParameter)
+{
+  osmscout::ImportParameter importParameter;
+  QuietImportProgress       progress;
+  std::error_code           error;
+
+  std::filesystem::create_directories(directory,error);
+
+  if (error) {
+    std::cerr << "Cannot create directory '" << directory << "': " << error.message() << std::endl;
+    return false;
+  }
+
+  importParameter.SetTypefile(typefile);
+  importParameter.SetMapfiles({osmscout::AppendFileToDir(directory,"synthetic.map")});
+  importParameter.SetDestinationDirectory(directory);
+  importParameter.SetPreprocessorFactory(std::make_shared<PreprocessorFactory>(mapParameter));
+  importParameter.AddRouter(osmscout::ImportParameter::Router(osmscout::vehicleCar,
+                                                              osmscout::RoutingService::DEFAULT_FILENAME_BASE));
+
+  try {
+    osmscout::Importer importer(importParameter);
+
+    if (!importer.Import(progress)) {
+      std::cerr << "Import of synthetic map failed" << std::endl;
+      return false;
+    }
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Import of synthetic map failed: " << e.GetDescription() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Pseudo random pairs of crossings all over the map
+ */
+static std::vector<std::pair<Crossing,Crossing>> GetCrossingPairs(const osmscout::test::SyntheticMapParameter& mapParameter)
+{
+  std::vector<std::pair<Crossing,Crossing>> pairs;
+  size_t                                    crossingCount=mapParameter.gridSize+1;
+
+  for (size_t i=0; i<crossingCount*crossingCount; i+=5) {
+    pairs.emplace_back(Crossing{i/crossingCount,i%crossingCount},
+                       Crossing{(i*5+3)%crossingCount,(i*3+1)%crossingCount});
+  }
+
+  return pairs;
+}
+
+/**
+ * Without oneways and turn restrictions both searches find the cheapest route
+ */
+static int CheckUnrestrictedMap(const std::string& typefile,
+                                const std::string& directory)
+{
+  osmscout::test::SyntheticMapParameter mapParameter;
+  RouteChecker                          checker(mapParameter);
+  int                                   failures=0;
+
+  mapParameter.gridSize=8;
+
+  if (!ImportMap(typefile,directory,mapParameter) ||
+      !checker.Open(directory)) {
+    return 1;
+  }
+
+  for (const auto& [from,to] : GetCrossingPairs(mapParameter)) {
+    Route route;
+    Route bidirectionalRoute;
+
+    if (!checker.CalculateRoutes(from,to,route,bidirectionalRoute)) {
+      failures++;
+    }
+    else if (std::abs(bidirectionalRoute.cost-route.cost)>route.cost*1e-9) {
+      std::cerr << "Bidirectional route is not as cheap as the unidirectional route" << std::endl;
+      failures++;
+    }
+  }
+
+  checker.Close();
+
+  return failures;
+}
+
+/**
+ * With oneways and turn restrictions, both searches must respect them. The unidirectional
+ * search closes a route node independent of the path it was reached by, so it misses
+ * the cheapest route, if the next turn is only allowed when coming from another path.
+ * The bidirectional search must not be more expensive.
+ */
+static int CheckRestrictedMap(const std::string& typefile,
+                              const std::string& directory)
+{
+  osmscout::test::SyntheticMapParameter mapParameter;
+  RouteChecker                          checker(mapParameter);
+  int                                   failures=0;
+
+  mapParameter.gridSize=8;
+  mapParameter.routingRestrictions=true;
+
+  if (!ImportMap(typefile,directory,mapParameter) ||
+      !checker.Open(directory)) {
+    return 1;
+  }
+
+  for (const auto& [from,to] : GetCrossingPairs(mapParameter)) {
+    Route route;
+    Route bidirectionalRoute;
+
+    if (!checker.CalculateRoutes(from,to,route,bidirectionalRoute)) {
+      failures++;
+    }
+    else if (bidirectionalRoute.cost-route.cost>route.cost*1e-9) {
+      std::cerr << "Bidirectional route is more expensive than the unidirectional route" << std::endl;
+      failures++;
+    }
+  }
+
+  double blockHeight=osmscout::GetSphericalDistance(mapParameter.GetCrossing(0,0),
+                                                    mapParameter.GetCrossing(1,0)).AsMeter();
+  double blockWidth=osmscout::GetSphericalDistance(mapParameter.GetCrossing(0,0),
+                                                   mapParameter.GetCrossing(0,1)).AsMeter();
+  Route  route;
+  Route  bidirectionalRoute;
+
+  // Street 1 is oneway eastwards, so going west requires a detour
+  if (!checker.CalculateRoutes(Crossing{1,3},Crossing{1,1},route,bidirectionalRoute)) {
+    failures++;
+  }
+  else if (route.length.AsMeter()<2*blockWidth+blockHeight ||
+           bidirectionalRoute.length.AsMeter()<2*blockWidth+blockHeight) {
+    std::cerr << "Route uses oneway street in the wrong direction" << std::endl;
+    failures++;
+  }
+
+  // Turning from primary street 4 into primary avenue 4 is forbidden and avenue 3 is
+  // oneway southwards, so the direct ways via (4,4) or (5,3) cannot be used
+  if (!checker.CalculateRoutes(Crossing{4,3},Crossing{5,4},route,bidirectionalRoute)) {
+    failures++;
+  }
+  else if (route.length.AsMeter()<blockWidth+blockHeight+1.0 ||
+           bidirectionalRoute.length.AsMeter()<blockWidth+blockHeight+1.0) {
+    std::cerr << "Route ignores turn restriction" << std::endl;
+    failures++;
+  }
+
+  checker.Close();
+
+  return failures;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc!=3) {
+    std::cerr << "BidirectionalRouting <typefile> <destination directory>" << std::endl;
+    return 1;
+  }
+
+  std::string typefile=argv[1];
+  std::string destinationDirectory=argv[2];
+  int         failures=0;
+
+  failures+=CheckUnrestrictedMap(typefile,
+                                 osmscout::AppendFileToDir(destinationDirectory,"unrestricted"));
+  failures+=CheckRestrictedMap(typefile,
+                               osmscout::AppendFileToDir(destinationDirectory,"restricted"));
+
+  if (failures>0) {
+    std::cerr << failures << " route(s) failed" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -26,6 +26,8 @@
 
 #include <osmscout/db/WayDataFile.h>
 
+#include <osmscout/io/BlockCoordEncoding.h>
+
 #include <osmscout/util/StopClock.h>
 
 class Statistics
@@ -387,6 +389,64 @@ public:
   }
 };
 
+/**
+ * Like StaticOptimizedDeltaEncoder, but with a separate bit size for the lat and lon deltas
+ * of each block of coordinates (see BlockCoordEncoding).
+ */
+class BlockDeltaEncoder : public Encoder
+{
+private:
+  std::vector<int32_t> deltaBuffer;
+
+public:
+  BlockDeltaEncoder()
+          : Encoder("BlockDeltaEncoder")
+  {
+    // no code
+  }
+
+  void Encode(osmscout::FileOffset /*offset*/, const std::vector<osmscout::Point>& coords) override
+  {
+    if (coords.empty()) {
+      bytesNeeded++;
+      return;
+    }
+
+    if (coords.size()<32) /* 2 bit signal + 2^5 length) */ {
+      bytesNeeded++;
+    }
+    else if (coords.size()<4096) /* 2 bit signal + 2^(5+7) length */ {
+      bytesNeeded+=2;
+    }
+    else /* 2097152 / 2 bit signal + 2^(5+7+8)) length */ {
+      bytesNeeded+=3;
+    }
+
+    uint32_t lastLat=(uint32_t)round(coords[0].GetLat()*osmscout::latConversionFactor);
+    uint32_t lastLon=(uint32_t)round(coords[0].GetLon()*osmscout::lonConversionFactor);
+
+    bytesNeeded+=osmscout::coordByteSize;
+
+    deltaBuffer.resize((coords.size()-1)*2);
+    size_t pos=0;
+    for (size_t i=1; i<coords.size(); i++) {
+      uint32_t currentLat=(uint32_t)round(coords[i].GetLat()*osmscout::latConversionFactor);
+      uint32_t currentLon=(uint32_t)round(coords[i].GetLon()*osmscout::lonConversionFactor);
+
+      deltaBuffer[pos]=currentLat-lastLat;
+      pos++;
+
+      deltaBuffer[pos]=currentLon-lastLon;
+      pos++;
+
+      lastLat=currentLat;
+      lastLon=currentLon;
+    }
+
+    bytesNeeded+=osmscout::GetBlockCoordEncodedSize(deltaBuffer);
+  }
+};
+
 int main(int argc, char* argv[])
 {
   if (argc!=2) {
@@ -401,6 +461,7 @@ int main(int argc, char* argv[])
   encoders.push_back(new MinimumVLQDeltaEncoder());
   encoders.push_back(new VLQDeltaEncoder());
   encoders.push_back(new StaticOptimizedDeltaEncoder());
+  encoders.push_back(new BlockDeltaEncoder());
 
   std::string mapDirectory=argv[1];
   std::string areaDatFilename=osmscout::AppendFileToDir(mapDirectory,"areas.dat");
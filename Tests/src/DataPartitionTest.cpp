@@ -0,0 +1,170 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscoutimport/ParallelProcessing.h>
+
+#include <TestMain.h>
+
+namespace {
+  constexpr uint32_t objectCount=1000;
+
+  /**
+   * Minimal data file object, a variable length encoded number
+   */
+  struct Value
+  {
+    uint32_t value=0;
+
+    void Read(const osmscout::TypeConfig& /*typeConfig*/,
+              osmscout::FileScanner& scanner)
+    {
+      value=scanner.ReadUInt32Number();
+    }
+  };
+
+  /**
+   * Writes the data file and returns its partitions
+   */
+  std::vector<osmscout::DataPartition> WriteDataFile(const std::string& filename,
+                                                     uint32_t partitionSize)
+  {
+    osmscout::FileWriter                 writer;
+    std::vector<osmscout::DataPartition> partitions;
+
+    writer.Open(filename);
+
+    for (uint32_t i=0; i<objectCount; i++) {
+      osmscout::AddToDataPartitions(partitions,
+                                    writer.GetPos(),
+                                    partitionSize);
+
+      writer.WriteNumber(i*i);
+    }
+
+    writer.Close();
+
+    return partitions;
+  }
+
+  std::string GetFilename()
+  {
+    return (std::filesystem::temp_directory_path()/"osmscout-datapartition-test.dat").string();
+  }
+}
+
+TEST_CASE("Partitions of the data file") {
+  std::vector<osmscout::DataPartition> partitions=WriteDataFile(GetFilename(),7);
+
+  REQUIRE(partitions.size()==(objectCount+6)/7);
+  REQUIRE(partitions.front().offset==0);
+  REQUIRE(partitions.front().count==7);
+  REQUIRE(partitions.back().count==objectCount%7);
+}
+
+TEST_CASE("Reading partitions in parallel returns the same objects as a single scanner") {
+  osmscout::TypeConfig                 typeConfig;
+  osmscout::SilentProgress             progress;
+  std::string                          filename=GetFilename();
+  std::vector<osmscout::DataPartition> partitions=WriteDataFile(filename,7);
+  std::vector<osmscout::FileOffset>    expectedOffsets;
+  std::vector<uint32_t>                expectedValues;
+  osmscout::FileScanner                scanner;
+
+  scanner.Open(filename,
+               osmscout::FileScanner::Sequential,
+               false);
+
+  for (uint32_t i=0; i<objectCount; i++) {
+    expectedOffsets.push_back(scanner.GetPos());
+    expectedValues.push_back(scanner.ReadUInt32Number());
+  }
+
+  scanner.Close();
+
+  for (size_t threadCount : {1,4}) {
+    std::vector<std::vector<osmscout::FileOffset>> offsets(partitions.size());
+    std::vector<std::vector<uint32_t>>             values(partitions.size());
+    std::vector<bool>                              finished(partitions.size(),false);
+
+    osmscout::ReadDataPartitions<Value>(typeConfig,
+                                        filename,
+                                        false,
+                                        threadCount,
+                                        partitions,
+                                        progress,
+                                        [&offsets,&values](size_t partition,
+                                                           osmscout::FileOffset offset,
+                                                           const Value& object) {
+                                          offsets[partition].push_back(offset);
+                                          values[partition].push_back(object.value);
+                                        },
+                                        [&finished](size_t partition) {
+                                          finished[partition]=true;
+                                        });
+
+    std::vector<osmscout::FileOffset> allOffsets;
+    std::vector<uint32_t>             allValues;
+
+    for (size_t partition=0; partition<partitions.size(); partition++) {
+      REQUIRE(finished[partition]);
+
+      allOffsets.insert(allOffsets.end(),offsets[partition].begin(),offsets[partition].end());
+      allValues.insert(allValues.end(),values[partition].begin(),values[partition].end());
+    }
+
+    REQUIRE(allOffsets==expectedOffsets);
+    REQUIRE(allValues==expectedValues);
+  }
+}
+
+TEST_CASE("An exception in one partition cancels the other partitions") {
+  osmscout::TypeConfig                 typeConfig;
+  osmscout::SilentProgress             progress;
+  std::string                          filename=GetFilename();
+  std::vector<osmscout::DataPartition> partitions=WriteDataFile(filename,10);
+  std::atomic<bool>                    failed(false);
+  std::atomic<size_t>                  objectsAfterFailure(0);
+  std::atomic<size_t>                  finishedPartitions(0);
+  size_t                               threadCount=4;
+
+  REQUIRE_THROWS_AS(osmscout::ReadDataPartitions<Value>(typeConfig,
+                                                        filename,
+                                                        false,
+                                                        threadCount,
+                                                        partitions,
+                                                        progress,
+                                                        [&](size_t partition,
+                                                            osmscout::FileOffset /*offset*/,
+                                                            const Value& /*object*/) {
+                                                          if (partition==2) {
+                                                            failed=true;
+                                                            throw std::runtime_error("Partition failed");
+                                                          }
+
+                                                          // Other partitions wait for the failure, then give
+                                                          // the failing thread time to cancel the loop
+                                                          while (!failed) {
+                                                            std::this_thread::yield();
+                                                          }
+
+                                                          objectsAfterFailure++;
+                                                          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                                                        },
+                                                        [&finishedPartitions](size_t /*partition*/) {
+                                                          finishedPartitions++;
+                                                        }),
+                    std::runtime_error);
+
+  // At most the one object each other thread was waiting in is processed after the failure
+  REQUIRE(objectsAfterFailure.load()<threadCount);
+  REQUIRE(finishedPartitions.load()==0);
+
+  std::filesystem::remove(filename);
+}
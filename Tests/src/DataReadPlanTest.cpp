@@ -0,0 +1,71 @@
+/*
+  DataReadPlanTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <vector>
+
+#include <osmscout/io/DataReadPlan.h>
+
+#include <TestMain.h>
+
+TEST_CASE("Empty plan")
+{
+  osmscout::DataReadPlan plan(std::vector<osmscout::FileOffset>{});
+
+  REQUIRE(plan.GetOrder().empty());
+  REQUIRE(plan.GetRanges().empty());
+}
+
+TEST_CASE("Offsets are read in file order")
+{
+  std::vector<osmscout::FileOffset> offsets={500,100,300,100,200};
+  osmscout::DataReadPlan            plan(offsets,1000,10);
+
+  REQUIRE(plan.GetOrder()==std::vector<size_t>{1,3,4,2,0});
+
+  REQUIRE(plan.GetRanges().size()==1);
+  REQUIRE(plan.GetRanges()[0].first==0);
+  REQUIRE(plan.GetRanges()[0].last==5);
+  REQUIRE(plan.GetRanges()[0].start==100);
+  REQUIRE(plan.GetRanges()[0].end==510);
+}
+
+TEST_CASE("Distant offsets start a new range")
+{
+  std::vector<osmscout::FileOffset> offsets={10000,0,50,10100,100000};
+  osmscout::DataReadPlan            plan(offsets,100,10);
+
+  REQUIRE(plan.GetOrder()==std::vector<size_t>{1,2,0,3,4});
+
+  const auto& ranges=plan.GetRanges();
+
+  REQUIRE(ranges.size()==3);
+
+  REQUIRE(ranges[0].GetEntryCount()==2);
+  REQUIRE(ranges[0].start==0);
+  REQUIRE(ranges[0].end==60);
+
+  REQUIRE(ranges[1].GetEntryCount()==2);
+  REQUIRE(ranges[1].start==10000);
+  REQUIRE(ranges[1].end==10110);
+
+  REQUIRE(ranges[2].GetEntryCount()==1);
+  REQUIRE(ranges[2].first==4);
+  REQUIRE(ranges[2].start==100000);
+  REQUIRE(ranges[2].end==100010);
+}
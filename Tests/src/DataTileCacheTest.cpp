@@ -0,0 +1,368 @@
+/*
+  DataTileCacheTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscoutmap/DataTileCache.h>
+
+#include <TestMain.h>
+
+using namespace osmscout;
+
+namespace {
+  const Magnification magnification{MagnificationLevel(10)};
+  const GeoCoord      center(50.08,14.42);
+
+  struct TestTypes
+  {
+    TypeConfig  typeConfig;
+    TypeInfoRef nodeType;
+    TypeInfoRef wayType;
+
+    TestTypes()
+    {
+      nodeType=typeConfig.RegisterType(std::make_shared<TypeInfo>("test_node"));
+      nodeType->CanBeNode(true);
+      wayType=typeConfig.RegisterType(std::make_shared<TypeInfo>("test_way"));
+      wayType->CanBeWay(true);
+    }
+  };
+
+  NodeRef CreateNode(const TypeInfoRef& type,
+                     const GeoCoord& coord)
+  {
+    NodeRef node=std::make_shared<Node>();
+
+    node->SetType(type);
+    node->SetCoords(coord);
+
+    return node;
+  }
+
+  WayRef CreateWay(const TypeInfoRef& type,
+                   size_t nodeCount)
+  {
+    WayRef way=std::make_shared<Way>();
+
+    way->SetType(type);
+
+    for (size_t i=0; i<nodeCount; i++) {
+      way->nodes.emplace_back(0,GeoCoord(center.GetLat(),center.GetLon()+double(i)*0.00001));
+    }
+
+    return way;
+  }
+
+  GeoBox MoveEast(const GeoBox& box,
+                  double distance)
+  {
+    return GeoBox(GeoCoord(box.GetMinLat(),box.GetMinLon()+distance),
+                  GeoCoord(box.GetMaxLat(),box.GetMaxLon()+distance));
+  }
+}
+
+TEST_CASE("Prefill from an ancestor two levels up")
+{
+  TestTypes     types;
+  DataTileCache cache(100);
+  TileKey       key(magnification,TileId::GetTile(magnification,center));
+  TileKey       grandParentKey=key.GetParent().GetParent();
+  TypeInfoSet   nodeTypes;
+  TypeInfoSet   emptyTypes;
+  GeoBox        outerBox=grandParentKey.GetBoundingBox();
+  GeoBox        innerBox=key.GetBoundingBox();
+
+  nodeTypes.Set(types.nodeType);
+
+  TileRef grandParent=cache.GetTile(grandParentKey);
+
+  grandParent->GetNodeData().SetData(nodeTypes,
+                                     {CreateNode(types.nodeType,innerBox.GetCenter()),
+                                      CreateNode(types.nodeType,GeoCoord(outerBox.GetMinLat()+0.00001,
+                                                                         outerBox.GetMinLon()+0.00001))});
+
+  TileRef tile=cache.GetTile(key);
+
+  cache.PrefillDataFromCache(*tile,
+                             nodeTypes,
+                             emptyTypes,
+                             emptyTypes,
+                             emptyTypes,
+                             emptyTypes,
+                             emptyTypes);
+
+  REQUIRE(tile->GetNodeData().GetDataSize()==1);
+  REQUIRE(tile->GetNodeData().GetTypes().IsSet(types.nodeType));
+  REQUIRE_FALSE(tile->GetNodeData().IsComplete());
+}
+
+TEST_CASE("Prefill from all four children")
+{
+  TestTypes     types;
+  DataTileCache cache(100);
+  TileKey       childKey(magnification,TileId::GetTile(magnification,center));
+  TileKey       key=childKey.GetParent();
+  Magnification childMagnification(MagnificationLevel(key.GetLevel()+1));
+  TypeInfoSet   nodeTypes;
+  TypeInfoSet   emptyTypes;
+  NodeRef       sharedNode=CreateNode(types.nodeType,center);
+
+  nodeTypes.Set(types.nodeType);
+
+  std::vector<TileRef> children;
+
+  for (uint32_t i=0; i<4; i++) {
+    children.push_back(cache.GetTile(TileKey(childMagnification,
+                                             TileId(key.GetId().GetX()*2+i%2,
+                                                    key.GetId().GetY()*2+i/2))));
+  }
+
+  // The same object is contained in two children and must only be taken once
+  children[0]->GetNodeData().SetData(nodeTypes,{sharedNode});
+  children[1]->GetNodeData().SetData(nodeTypes,{sharedNode});
+  children[2]->GetNodeData().SetData(nodeTypes,{});
+
+  SECTION("Missing types in a child prevent merging") {
+    TileRef tile=cache.GetTile(key);
+
+    cache.PrefillDataFromCache(*tile,nodeTypes,emptyTypes,emptyTypes,emptyTypes,emptyTypes,emptyTypes);
+
+    REQUIRE(tile->GetNodeData().GetTypes().Empty());
+  }
+
+  SECTION("Data of all children is merged") {
+    children[3]->GetNodeData().SetData(nodeTypes,{});
+
+    TileRef tile=cache.GetTile(key);
+
+    cache.PrefillDataFromCache(*tile,nodeTypes,emptyTypes,emptyTypes,emptyTypes,emptyTypes,emptyTypes);
+
+    REQUIRE(tile->GetNodeData().GetTypes().IsSet(types.nodeType));
+    REQUIRE(tile->GetNodeData().GetDataSize()==1);
+  }
+}
+
+TEST_CASE("Evict tiles by memory")
+{
+  TestTypes   types;
+  TypeInfoSet wayTypes;
+
+  wayTypes.Set(types.wayType);
+
+  DataTileCache cache(100);
+  TileId        id=TileId::GetTile(magnification,center);
+  TileRef       usedTile;
+
+  for (uint32_t i=0; i<10; i++) {
+    TileRef tile=cache.GetTile(TileKey(magnification,TileId(id.GetX()+i,id.GetY())));
+
+    tile->GetWayData().SetData(wayTypes,{CreateWay(types.wayType,1000)});
+
+    if (i==0) {
+      usedTile=tile;
+    }
+  }
+
+  size_t tileMemory=usedTile->GetMemorySize();
+
+  REQUIRE(tileMemory>1000*sizeof(Point));
+  REQUIRE(cache.GetCurrentMemory()>=10*tileMemory);
+
+  cache.SetMemoryLimit(3*tileMemory);
+
+  REQUIRE(cache.GetCurrentSize()==3);
+  REQUIRE(cache.GetCurrentMemory()<=3*tileMemory);
+  // Tiles still in use are never evicted, even if they are the least recently used ones
+  REQUIRE(cache.GetCachedTile(usedTile->GetKey())==usedTile);
+}
+
+TEST_CASE("Prefilled objects are only accounted for by their owning tile")
+{
+  TestTypes     types;
+  DataTileCache cache(100);
+  TileKey       key(magnification,TileId::GetTile(magnification,center));
+  TypeInfoSet   wayTypes;
+  TypeInfoSet   emptyTypes;
+
+  wayTypes.Set(types.wayType);
+
+  TileRef parent=cache.GetTile(key.GetParent());
+
+  parent->GetWayData().SetData(wayTypes,{CreateWay(types.wayType,1000)});
+
+  TileRef tile=cache.GetTile(key);
+
+  cache.PrefillDataFromCache(*tile,
+                             emptyTypes,
+                             wayTypes,
+                             emptyTypes,
+                             emptyTypes,
+                             emptyTypes,
+                             emptyTypes);
+
+  REQUIRE(tile->GetWayData().GetDataSize()==1);
+  REQUIRE(parent->GetMemorySize()>1000*sizeof(Point));
+  REQUIRE(tile->GetMemorySize()<1000*sizeof(Point));
+  REQUIRE(cache.GetCurrentMemory()<parent->GetMemorySize()+1000*sizeof(Point));
+}
+
+TEST_CASE("Prefetch tiles in pan direction")
+{
+  DataTileCache cache(100);
+  TileId        id=TileId::GetTile(magnification,center);
+  TileKey       topLeft(magnification,id);
+  TileKey       bottomRight(magnification,TileId(id.GetX()+2,id.GetY()+1));
+  GeoBox        box(topLeft.GetBoundingBox().GetCenter(),
+                    bottomRight.GetBoundingBox().GetCenter());
+  double        tileWidth=topLeft.GetBoundingBox().GetWidth();
+
+  std::list<TileRef> tiles;
+  std::list<TileRef> prefetchTiles;
+
+  cache.GetTilesForBoundingBox(magnification,box,tiles);
+  REQUIRE(tiles.size()==6);
+
+  cache.GetPrefetchTiles(prefetchTiles);
+  REQUIRE(prefetchTiles.empty());
+
+  SECTION("Moving east prefetches the next column") {
+    cache.GetTilesForBoundingBox(magnification,
+                                 MoveEast(box,tileWidth),
+                                 tiles);
+    REQUIRE(tiles.size()==6);
+
+    cache.GetPrefetchTiles(prefetchTiles);
+    REQUIRE(prefetchTiles.size()==2);
+
+    for (const auto& tile : prefetchTiles) {
+      REQUIRE(tile->GetKey().GetId().GetX()==id.GetX()+4);
+      REQUIRE_FALSE(tile->IsComplete());
+    }
+
+    REQUIRE(cache.GetCurrentSize()==10);
+
+    // Prefetch tiles are only returned once
+    cache.GetPrefetchTiles(prefetchTiles);
+    REQUIRE(prefetchTiles.empty());
+  }
+
+  SECTION("Changing the level does not prefetch") {
+    Magnification zoomedIn(MagnificationLevel(magnification.GetLevel()+1));
+
+    cache.GetTilesForBoundingBox(zoomedIn,box,tiles);
+    cache.GetPrefetchTiles(prefetchTiles);
+    REQUIRE(prefetchTiles.empty());
+  }
+
+  SECTION("The last request is remembered per level") {
+    Magnification zoomedIn(MagnificationLevel(magnification.GetLevel()+1));
+
+    cache.GetTilesForBoundingBox(zoomedIn,box,tiles);
+    cache.GetTilesForBoundingBox(magnification,
+                                 MoveEast(box,tileWidth),
+                                 tiles);
+    cache.GetPrefetchTiles(prefetchTiles);
+    REQUIRE(prefetchTiles.size()==2);
+  }
+
+  SECTION("Disabled pan prefetch") {
+    cache.SetPanPrefetch(false);
+    cache.GetTilesForBoundingBox(magnification,
+                                 MoveEast(box,tileWidth),
+                                 tiles);
+    cache.GetPrefetchTiles(prefetchTiles);
+    REQUIRE(prefetchTiles.empty());
+  }
+}
+
+TEST_CASE("Readers see consistent snapshots of the tile data")
+{
+  TestTypes            types;
+  TypeInfoSet          nodeTypes;
+  TileNodeData         data;
+  std::vector<NodeRef> nodes;
+  std::atomic<bool>    stop(false);
+  std::atomic<bool>    inconsistent(false);
+
+  nodeTypes.Set(types.nodeType);
+
+  for (size_t i=0; i<10; i++) {
+    nodes.push_back(CreateNode(types.nodeType,center));
+  }
+
+  std::vector<std::thread> readers;
+
+  for (size_t i=0; i<4; i++) {
+    readers.emplace_back([&data,&stop,&inconsistent]() {
+      while (!stop) {
+        size_t count=0;
+
+        data.CopyData([&count](const NodeRef&) {
+          count++;
+        });
+
+        // Data is always added or set in chunks of 10 nodes
+        if (count%10!=0) {
+          inconsistent=true;
+        }
+      }
+    });
+  }
+
+  for (size_t i=0; i<1000; i++) {
+    data.AddPrefillData(nodeTypes,nodes);
+
+    if (i%10==0) {
+      data.SetData(nodeTypes,nodes);
+    }
+    else {
+      data.AddData(nodeTypes,nodes);
+    }
+  }
+
+  stop=true;
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  REQUIRE_FALSE(inconsistent);
+  REQUIRE(data.IsComplete());
+  // 1000 prefill chunks, the last SetData() and the following 9 AddData()
+  REQUIRE(data.GetDataSize()==(1000+10)*10);
+  REQUIRE(data.GetGeneration()==2000);
+
+  size_t count=0;
+
+  data.CopyData([&count](const NodeRef&) {
+    count++;
+  });
+
+  REQUIRE(count==data.GetDataSize());
+
+  data.Invalidate();
+
+  REQUIRE_FALSE(data.IsComplete());
+  REQUIRE(data.GetDataSize()==(1000+10)*10);
+}
@@ -0,0 +1,272 @@
+/*
+  FileBatchReaderPerformance - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include <osmscout/Area.h>
+
+#include <osmscout/db/AreaDataFile.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileBatchReader.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/util/StopClock.h>
+
+/**
+  Reads all areas of the areas.dat file in the given directory in random order using
+  a memory mapped FileScanner, a buffered FileScanner, the FileBatchReader with the
+  pread() and the io_uring backend and finally via the AreaDataFile without memory
+  mapping. Checks that all variants return the same data and compares execution time.
+
+  Call this program repeately to avoid different timing because of OS file caching.
+*/
+
+static const size_t iterations=10;
+
+struct AreaInfo
+{
+  osmscout::FileOffset offset;
+  osmscout::FileOffset nextOffset;
+  size_t               rings;
+  size_t               nodes;
+
+  bool operator==(const AreaInfo& other) const
+  {
+    return offset==other.offset &&
+           nextOffset==other.nextOffset &&
+           rings==other.rings &&
+           nodes==other.nodes;
+  }
+};
+
+static AreaInfo GetInfo(const osmscout::Area& area)
+{
+  AreaInfo info{area.GetFileOffset(),area.GetNextFileOffset(),area.rings.size(),0};
+
+  for (const auto& ring : area.rings) {
+    info.nodes+=ring.nodes.size();
+  }
+
+  return info;
+}
+
+static bool ReadByScanner(const osmscout::TypeConfig& typeConfig,
+                          const std::string& filename,
+                          bool useMmap,
+                          const std::vector<osmscout::FileOffset>& offsets,
+                          std::vector<AreaInfo>& infos)
+{
+  osmscout::FileScanner scanner;
+
+  scanner.Open(filename,osmscout::FileScanner::LowMemRandom,useMmap);
+
+  infos.clear();
+
+  for (auto offset : offsets) {
+    osmscout::Area area;
+
+    scanner.SetPos(offset);
+    area.Read(typeConfig,scanner);
+
+    infos.push_back(GetInfo(area));
+  }
+
+  scanner.Close();
+
+  return true;
+}
+
+static bool ReadByBatchReader(const osmscout::TypeConfig& typeConfig,
+                              const std::string& filename,
+                              osmscout::FileBatchReader::Backend backend,
+                              const std::vector<osmscout::FileBatchReader::Request>& requests,
+                              std::vector<AreaInfo>& infos)
+{
+  osmscout::FileBatchReader reader;
+  size_t                    bufferSize=0;
+
+  for (const auto& request : requests) {
+    bufferSize=std::max(bufferSize,request.size);
+  }
+
+  reader.Open(filename,backend,bufferSize);
+
+  if (reader.GetBackend()!=backend) {
+    reader.Close();
+    return false;
+  }
+
+  infos.assign(requests.size(),AreaInfo{0,0,0,0});
+
+  reader.Read(requests,
+              [&typeConfig,&filename,&requests,&infos](size_t request,
+                                                       const char* data,
+                                                       size_t size) {
+                osmscout::FileScanner scanner;
+                osmscout::Area        area;
+
+                scanner.OpenMemory(filename,requests[request].offset,data,size);
+                scanner.SetPos(requests[request].offset);
+                area.Read(typeConfig,scanner);
+                scanner.Close();
+
+                infos[request]=GetInfo(area);
+              });
+
+  reader.Close();
+
+  return true;
+}
+
+static bool ReadByDataFile(const osmscout::TypeConfigRef& typeConfig,
+                           const std::string& mapDirectory,
+                           const std::vector<osmscout::FileOffset>& offsets,
+                           std::vector<AreaInfo>& infos)
+{
+  osmscout::AreaDataFile         dataFile(0);
+  std::vector<osmscout::AreaRef> areas;
+
+  if (!dataFile.Open(typeConfig,mapDirectory,false)) {
+    return false;
+  }
+
+  if (!dataFile.GetByOffset(offsets.begin(),offsets.end(),offsets.size(),areas)) {
+    dataFile.Close();
+    return false;
+  }
+
+  dataFile.Close();
+
+  infos.clear();
+
+  for (const auto& area : areas) {
+    infos.push_back(GetInfo(*area));
+  }
+
+  return true;
+}
+
+template<typename Function>
+static bool Measure(const std::string& name,
+                    const std::vector<AreaInfo>& expected,
+                    Function function)
+{
+  osmscout::StopClock   timer;
+  std::vector<AreaInfo> infos;
+
+  for (size_t i=0; i<iterations; i++) {
+    if (!function(infos)) {
+      std::cout << name << ": not available" << std::endl;
+      return true;
+    }
+
+    if (infos!=expected) {
+      std::cerr << name << ": data differs!" << std::endl;
+      return false;
+    }
+  }
+
+  timer.Stop();
+
+  std::cout << name << ": reading " << iterations << "x" << expected.size() << " areas took " << timer << std::endl;
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  osmscout::TypeConfigRef typeConfig=std::make_shared<osmscout::TypeConfig>();
+
+  if (argc!=2) {
+    std::cerr << "FileBatchReaderPerformance <map directory>" << std::endl;
+    return 1;
+  }
+
+  std::string mapDirectory=argv[1];
+  std::string areaDatFilename=osmscout::AppendFileToDir(mapDirectory,osmscout::AreaDataFile::AREAS_DAT);
+
+  if (!typeConfig->LoadFromDataFile(mapDirectory)) {
+    std::cerr << "Cannot open type configuration!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "io_uring is " << (osmscout::FileBatchReader::IsIoUringAvailable() ? "" : "NOT ") << "available" << std::endl;
+
+  try {
+    std::vector<osmscout::FileOffset>               offsets;
+    std::vector<osmscout::FileBatchReader::Request> requests;
+    std::vector<AreaInfo>                           expected;
+    osmscout::FileScanner                           scanner;
+
+    scanner.Open(areaDatFilename,osmscout::FileScanner::Sequential,true);
+
+    uint32_t areaCount=scanner.ReadUInt32();
+
+    for (size_t a=1; a<=areaCount; a++) {
+      osmscout::Area area;
+
+      area.Read(*typeConfig,
+                scanner);
+
+      offsets.push_back(area.GetFileOffset());
+    }
+
+    scanner.Close();
+
+    std::shuffle(offsets.begin(),offsets.end(),std::mt19937(42));
+
+    ReadByScanner(*typeConfig,areaDatFilename,true,offsets,expected);
+
+    // Each request reads exactly one area
+    for (const auto& info : expected) {
+      requests.push_back(osmscout::FileBatchReader::Request{info.offset,size_t(info.nextOffset-info.offset)});
+    }
+
+    bool result=true;
+
+    result&=Measure("FileScanner (mmap)",expected,[&](std::vector<AreaInfo>& infos) {
+      return ReadByScanner(*typeConfig,areaDatFilename,true,offsets,infos);
+    });
+
+    result&=Measure("FileScanner (buffered)",expected,[&](std::vector<AreaInfo>& infos) {
+      return ReadByScanner(*typeConfig,areaDatFilename,false,offsets,infos);
+    });
+
+    result&=Measure("FileBatchReader (pread)",expected,[&](std::vector<AreaInfo>& infos) {
+      return ReadByBatchReader(*typeConfig,areaDatFilename,osmscout::FileBatchReader::Backend::PRead,requests,infos);
+    });
+
+    result&=Measure("FileBatchReader (io_uring)",expected,[&](std::vector<AreaInfo>& infos) {
+      return ReadByBatchReader(*typeConfig,areaDatFilename,osmscout::FileBatchReader::Backend::IoUring,requests,infos);
+    });
+
+    result&=Measure("AreaDataFile (no mmap)",expected,[&](std::vector<AreaInfo>& infos) {
+      return ReadByDataFile(typeConfig,mapDirectory,offsets,infos);
+    });
+
+    return result ? 0 : 1;
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    return 1;
+  }
+}
@@ -1,6 +1,8 @@
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <limits>
+#include <random>
 
 #include <osmscout/io/FileScanner.h>
 #include <osmscout/io/FileWriter.h>
@@ -380,3 +382,108 @@ TEST_CASE("FileScannerWriter")
     scanner.Close();
   }
 }
+
+std::vector<osmscout::Point> CreateRandomWalk(std::mt19937& generator,
+                                              size_t count,
+                                              int maxStep,
+                                              bool withSerials)
+{
+  std::uniform_int_distribution<int> stepDistribution(-maxStep,maxStep);
+  std::vector<osmscout::Point>       points;
+  int64_t                            lat=int64_t(141.5*osmscout::latConversionFactor);
+  int64_t                            lon=int64_t(187.4*osmscout::lonConversionFactor);
+
+  for (size_t i=0; i<count; i++) {
+    uint8_t serial=withSerials && i%3==0 ? uint8_t(i%255+1) : 0;
+
+    // Use raw coordinate values, so that the coordinates do not change by writing them
+    points.emplace_back(serial,osmscout::GeoCoord(lat/osmscout::latConversionFactor-90.0,
+                                                  lon/osmscout::lonConversionFactor-180.0));
+
+    lat+=stepDistribution(generator);
+    lon+=stepDistribution(generator);
+  }
+
+  return points;
+}
+
+TEST_CASE("Block encoded coordinates")
+{
+  osmscout::FileWriter  writer;
+  osmscout::FileScanner scanner;
+  std::mt19937          generator(4711);
+
+  std::vector<std::vector<osmscout::Point>> outCoords;
+
+  for (int maxStep : {1, 100, 5000, 200000}) {
+    for (size_t count : {2, 16, 17, 33, 1000, 2000}) {
+      outCoords.push_back(CreateRandomWalk(generator,count,maxStep,false));
+      outCoords.push_back(CreateRandomWalk(generator,count,maxStep,true));
+    }
+  }
+
+  // Mostly small deltas with a single big one, the fixed delta size would be 24 bit
+  std::vector<osmscout::Point> jump=CreateRandomWalk(generator,1000,10,false);
+
+  for (size_t i=500; i<jump.size(); i++) {
+    double latValue=std::round((jump[i].GetLat()+90.0)*osmscout::latConversionFactor)+100000;
+
+    jump[i].SetCoord(osmscout::GeoCoord(latValue/osmscout::latConversionFactor-90.0,
+                                        jump[i].GetLon()));
+  }
+
+  writer.Open("test.dat");
+  writer.SetBlockCoordEncoding(true);
+
+  for (size_t i=0; i<outCoords.size(); i++) {
+    writer.Write(outCoords[i],i%2==1);
+  }
+
+  osmscout::FileOffset jumpOffset=writer.GetPos();
+
+  writer.Write(jump,false);
+
+  osmscout::FileOffset finalWriteFileOffset=writer.GetPos();
+
+  writer.Close();
+
+  REQUIRE(finalWriteFileOffset-jumpOffset<jump.size()*3);
+
+  for (int mmapMode = 0; mmapMode <= 1; mmapMode++)
+  {
+    scanner.Open("test.dat", osmscout::FileScanner::Normal, (bool)mmapMode);
+
+    osmscout::GeoBox                     boundingBox;
+    std::vector<osmscout::SegmentGeoBox> segments;
+    std::vector<osmscout::Point>         inCoords;
+
+    for (size_t i=0; i<outCoords.size(); i++) {
+      inCoords.clear();
+      scanner.Read(inCoords, segments, boundingBox, i%2==1);
+      REQUIRE(Equals(inCoords, outCoords[i]));
+
+      if (i%2==1) {
+        for (size_t j=0; j<inCoords.size(); j++) {
+          REQUIRE(inCoords[j].GetSerial()==outCoords[i][j].GetSerial());
+        }
+      }
+    }
+
+    scanner.Read(inCoords, segments, boundingBox, false);
+    REQUIRE(Equals(inCoords, jump));
+
+    REQUIRE(scanner.GetPos() == finalWriteFileOffset);
+
+    scanner.Close();
+  }
+
+  // Without request the fixed delta size (here 24 bit) is used
+  osmscout::FileWriter fixedWriter;
+
+  fixedWriter.Open("test.dat");
+  fixedWriter.Write(jump,false);
+
+  REQUIRE(fixedWriter.GetPos()>=(jump.size()-1)*6);
+
+  fixedWriter.Close();
+}
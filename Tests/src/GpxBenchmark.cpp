@@ -0,0 +1,370 @@
+/*
+  GpxBenchmark - a benchmark program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscout/cli/CmdLineParsing.h>
+#include <osmscout/io/File.h>
+
+#include <osmscoutgpx/Export.h>
+#include <osmscoutgpx/Import.h>
+
+/*
+  Measures the throughput of gpx import and export. Synthetic gpx files are
+  written using the streaming writer and then read using the different
+  import variants:
+
+  - ImportGpx: whole file as GpxFile
+  - ImportGpxStream: chunks of TrackPoint objects or compact columns
+  - ImportGpxFiles/ImportGpxStreams: all files, concurrently
+
+  The point counts of all variants are compared, so the program fails if
+  the variants do not agree.
+*/
+
+struct Arguments
+{
+  bool        help=false;
+  std::string directory=".";
+  size_t      points=1000000;  //!< Points per file
+  size_t      files=4;
+  size_t      threads=std::max(1u,std::thread::hardware_concurrency());
+};
+
+class CountingHandler : public osmscout::gpx::GpxStreamHandler
+{
+public:
+  size_t points=0;
+  size_t tracks=0;
+  double latitudeSum=0.0;
+
+  void OnTrackPoints(const osmscout::gpx::TrackPointChunk& chunk) override
+  {
+    points+=chunk.GetSize();
+
+    for (const auto& point : chunk.points) {
+      latitudeSum+=point.coord.GetLat();
+    }
+
+    for (size_t i=0; i<chunk.columns.GetSize(); i++) {
+      latitudeSum+=chunk.columns.GetCoord(i).GetLat();
+    }
+  }
+
+  void OnTrack(size_t /*index*/, osmscout::gpx::Track&& /*track*/) override
+  {
+    tracks++;
+  }
+};
+
+/**
+ * Adds the number of received points to the given total on destruction
+ */
+class AccumulatingHandler : public CountingHandler
+{
+private:
+  std::atomic<size_t>& total;
+
+public:
+  explicit AccumulatingHandler(std::atomic<size_t>& total)
+  : total(total)
+  {
+    // no code
+  }
+
+  ~AccumulatingHandler() override
+  {
+    total+=points;
+  }
+};
+
+static size_t GetPointCount(const osmscout::gpx::GpxFile& file)
+{
+  size_t count=0;
+
+  for (const auto& track : file.tracks) {
+    count+=track.GetPointCount();
+  }
+
+  return count;
+}
+
+static osmscout::gpx::TrackPoint CreatePoint(size_t index)
+{
+  osmscout::gpx::TrackPoint point(osmscout::GeoCoord(50.0+double(index%100000)*0.00001,
+                                                     14.0+double(index/100000)*0.00001));
+
+  point.elevation=200.0+double(index%1000)*0.1;
+  point.timestamp=osmscout::Timestamp(std::chrono::seconds(1700000000+index));
+  point.hdop=3.5;
+
+  return point;
+}
+
+static bool WriteFile(const std::string& filename,
+                      size_t pointCount)
+{
+  osmscout::gpx::GpxStreamWriter writer(filename);
+  osmscout::gpx::GpxFile         metadata;
+  osmscout::gpx::Track           track;
+
+  metadata.name="GpxBenchmark";
+  track.name="Synthetic track";
+
+  if (!writer.WriteHeader(metadata) ||
+      !writer.StartTrack(track) ||
+      !writer.StartSegment()) {
+    return false;
+  }
+
+  std::vector<osmscout::gpx::TrackPoint> points;
+
+  points.reserve(4096);
+
+  for (size_t i=0; i<pointCount; i++) {
+    points.push_back(CreatePoint(i));
+
+    if (points.size()==4096 || i+1==pointCount) {
+      if (!writer.WriteTrackPoints(points)) {
+        return false;
+      }
+
+      points.clear();
+    }
+  }
+
+  return writer.EndSegment() &&
+         writer.EndTrack() &&
+         writer.Close();
+}
+
+static void Report(const std::string& name,
+                   double seconds,
+                   size_t points,
+                   osmscout::FileOffset bytes)
+{
+  std::cout << std::left << std::setw(28) << name << std::right;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(10) << seconds*1000.0 << " ms";
+  std::cout << std::setw(12) << double(points)/seconds/1000.0 << " kpt/s";
+  std::cout << std::setw(10) << double(bytes)/seconds/(1024.0*1024.0) << " MiB/s" << std::endl;
+}
+
+static double Measure(const std::function<void()>& function)
+{
+  auto start=std::chrono::steady_clock::now();
+
+  function();
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+int main(int argc, char* argv[])
+{
+  osmscout::CmdLineParser  argParser("GpxBenchmark",
+                                     argc,argv);
+  std::vector<std::string> helpArgs{"h","help"};
+  Arguments                args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      helpArgs,
+                      "Return argument help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.directory=value;
+                      }),
+                      "directory",
+                      "Directory for the generated gpx files (default: .)");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.points=value;
+                      }),
+                      "points",
+                      "Number of track points per file (default: "+std::to_string(args.points)+")");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.files=value;
+                      }),
+                      "files",
+                      "Number of files (default: "+std::to_string(args.files)+")");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.threads=value;
+                      }),
+                      "threads",
+                      "Number of threads for the batch import (default: "+std::to_string(args.threads)+")");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  if (args.files==0) {
+    std::cerr << "ERROR: At least one file is required" << std::endl;
+    return 1;
+  }
+
+  std::error_code error;
+
+  std::filesystem::create_directories(args.directory,error);
+
+  if (error) {
+    std::cerr << "ERROR: Cannot create directory '" << args.directory << "': " << error.message() << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> filenames;
+
+  for (size_t i=0; i<args.files; i++) {
+    filenames.push_back(osmscout::AppendFileToDir(args.directory,"benchmark-"+std::to_string(i)+".gpx"));
+  }
+
+  // Export
+
+  double exportTime=Measure([&]() {
+    for (const auto& filename : filenames) {
+      if (!WriteFile(filename,args.points)) {
+        std::cerr << "ERROR: Cannot write '" << filename << "'" << std::endl;
+        std::exit(1);
+      }
+    }
+  });
+
+  osmscout::FileOffset fileSize=osmscout::GetFileSize(filenames.front());
+  size_t               totalPoints=args.points*args.files;
+  bool                 success=true;
+
+  std::cout << args.files << " file(s), " << args.points << " points and " << fileSize << " bytes per file, ";
+  std::cout << args.threads << " thread(s)" << std::endl;
+
+  Report("GpxStreamWriter",exportTime,totalPoints,fileSize*args.files);
+
+  osmscout::gpx::GpxFile gpxFile;
+
+  double importTime=Measure([&]() {
+    osmscout::gpx::ImportGpx(filenames.front(),gpxFile);
+  });
+
+  Report("ImportGpx",importTime,GetPointCount(gpxFile),fileSize);
+
+  if (GetPointCount(gpxFile)!=args.points) {
+    std::cerr << "ERROR: ImportGpx returned " << GetPointCount(gpxFile) << " points" << std::endl;
+    success=false;
+  }
+
+  std::string exportFilename=osmscout::AppendFileToDir(args.directory,"benchmark-export.gpx");
+
+  double exportFileTime=Measure([&]() {
+    if (!osmscout::gpx::ExportGpx(gpxFile,exportFilename)) {
+      std::cerr << "ERROR: Cannot write '" << exportFilename << "'" << std::endl;
+      std::exit(1);
+    }
+  });
+
+  Report("ExportGpx",exportFileTime,args.points,osmscout::GetFileSize(exportFilename));
+
+  gpxFile=osmscout::gpx::GpxFile();
+
+  for (auto storage : {osmscout::gpx::TrackPointStorage::Points,osmscout::gpx::TrackPointStorage::Columns}) {
+    osmscout::gpx::GpxStreamOptions options;
+    CountingHandler                 handler;
+
+    options.storage=storage;
+
+    double time=Measure([&]() {
+      osmscout::gpx::ImportGpxStream(filenames.front(),handler,options);
+    });
+
+    Report(storage==osmscout::gpx::TrackPointStorage::Points ? "ImportGpxStream (points)" : "ImportGpxStream (columns)",
+           time,
+           handler.points,
+           fileSize);
+
+    if (handler.points!=args.points || handler.tracks!=1) {
+      std::cerr << "ERROR: ImportGpxStream returned " << handler.points << " points" << std::endl;
+      success=false;
+    }
+  }
+
+  for (size_t threads : {size_t(1),args.threads}) {
+    std::vector<osmscout::gpx::GpxFile> gpxFiles;
+    size_t                              points=0;
+
+    double time=Measure([&]() {
+      osmscout::gpx::ImportGpxFiles(filenames,gpxFiles,threads);
+    });
+
+    for (const auto& file : gpxFiles) {
+      points+=GetPointCount(file);
+    }
+
+    Report("ImportGpxFiles ("+std::to_string(threads)+" threads)",time,points,fileSize*args.files);
+
+    if (points!=totalPoints) {
+      std::cerr << "ERROR: ImportGpxFiles returned " << points << " points" << std::endl;
+      success=false;
+    }
+
+    if (args.threads==1) {
+      break;
+    }
+  }
+
+  osmscout::gpx::GpxStreamOptions options;
+  std::atomic<size_t>             points=0;
+
+  options.storage=osmscout::gpx::TrackPointStorage::Columns;
+
+  double batchTime=Measure([&]() {
+    osmscout::gpx::ImportGpxStreams(filenames,
+                                    [&points](size_t) {
+                                      return std::make_unique<AccumulatingHandler>(points);
+                                    },
+                                    options,
+                                    args.threads);
+  });
+
+  Report("ImportGpxStreams ("+std::to_string(args.threads)+" threads)",batchTime,points,fileSize*args.files);
+
+  if (points!=totalPoints) {
+    std::cerr << "ERROR: ImportGpxStreams returned " << points << " points" << std::endl;
+    success=false;
+  }
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+/*
+  GpxStreamTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <osmscoutgpx/Export.h>
+#include <osmscoutgpx/Import.h>
+#include <osmscoutgpx/TrackPointColumns.h>
+
+#include <TestMain.h>
+
+using namespace osmscout;
+using namespace osmscout::gpx;
+
+namespace {
+  std::string GetTestFile(const std::string& name)
+  {
+    std::filesystem::path directory=std::filesystem::temp_directory_path()/"osmscout-gpxstream-test";
+
+    std::filesystem::create_directories(directory);
+
+    return (directory/name).string();
+  }
+
+  TrackPoint CreatePoint(size_t index)
+  {
+    TrackPoint point(GeoCoord(50.0+double(index)*0.0001,
+                              14.0+double(index)*0.0002));
+
+    // Only every second point has all attributes set
+    if (index%2==0) {
+      point.elevation=200.0+double(index);
+      point.timestamp=Timestamp(std::chrono::seconds(1700000000+index));
+      point.course=double(index%360);
+      point.hdop=1.5;
+      point.vdop=2.5;
+      point.pdop=3.5;
+    }
+
+    return point;
+  }
+
+  std::vector<TrackPoint> CreatePoints(size_t offset,
+                                       size_t count)
+  {
+    std::vector<TrackPoint> points;
+
+    for (size_t i=0; i<count; i++) {
+      points.push_back(CreatePoint(offset+i));
+    }
+
+    return points;
+  }
+
+  void RequireEqual(const TrackPoint& point,
+                    const TrackPoint& expected)
+  {
+    REQUIRE(point.coord.GetLat()==Approx(expected.coord.GetLat()).margin(1e-7));
+    REQUIRE(point.coord.GetLon()==Approx(expected.coord.GetLon()).margin(1e-7));
+    REQUIRE(point.elevation.has_value()==expected.elevation.has_value());
+    REQUIRE(point.timestamp==expected.timestamp);
+    REQUIRE(point.course.has_value()==expected.course.has_value());
+    REQUIRE(point.hdop.has_value()==expected.hdop.has_value());
+    REQUIRE(point.vdop.has_value()==expected.vdop.has_value());
+    REQUIRE(point.pdop.has_value()==expected.pdop.has_value());
+
+    if (expected.elevation) {
+      REQUIRE(*point.elevation==Approx(*expected.elevation));
+    }
+
+    if (expected.course) {
+      REQUIRE(*point.course==Approx(*expected.course));
+    }
+
+    if (expected.hdop) {
+      REQUIRE(*point.hdop==Approx(*expected.hdop));
+      REQUIRE(*point.vdop==Approx(*expected.vdop));
+      REQUIRE(*point.pdop==Approx(*expected.pdop));
+    }
+  }
+
+  /**
+   * Two tracks, the first with segments of 5 and 0 points, the second with a segment of 7 points
+   */
+  void WriteTestFile(const std::string& filename)
+  {
+    GpxStreamWriter writer(filename);
+    GpxFile         metadata;
+    Waypoint        waypoint(GeoCoord(50.5,14.5));
+    Route           route;
+    Track           firstTrack;
+    Track           secondTrack;
+
+    metadata.name="GpxStreamTest";
+    waypoint.name="Waypoint";
+    route.name="Route";
+    route.points.emplace_back(GeoCoord(50.6,14.6));
+    firstTrack.name="First";
+    secondTrack.name="Second";
+
+    REQUIRE(writer.WriteHeader(metadata));
+    REQUIRE(writer.WriteWaypoint(waypoint));
+    REQUIRE(writer.WriteRoute(route));
+
+    REQUIRE(writer.StartTrack(firstTrack));
+    REQUIRE(writer.StartSegment());
+    REQUIRE(writer.WriteTrackPoints(CreatePoints(0,3)));
+
+    TrackPointColumns columns;
+
+    columns.Append(CreatePoints(3,2));
+
+    REQUIRE(writer.WriteTrackPoints(columns));
+    REQUIRE(writer.EndSegment());
+    REQUIRE(writer.StartSegment());
+    REQUIRE(writer.EndSegment());
+    REQUIRE(writer.EndTrack());
+
+    REQUIRE(writer.StartTrack(secondTrack));
+    REQUIRE(writer.StartSegment());
+    REQUIRE(writer.WriteTrackPoints(CreatePoints(5,7)));
+    REQUIRE(writer.EndSegment());
+    REQUIRE(writer.EndTrack());
+
+    REQUIRE(writer.Close());
+  }
+
+  struct ReceivedChunk
+  {
+    size_t                  track;
+    size_t                  segment;
+    size_t                  offset;
+    bool                    last;
+    std::vector<TrackPoint> points;
+  };
+
+  class CollectingHandler : public GpxStreamHandler
+  {
+  public:
+    std::vector<std::string>   calls;
+    std::vector<ReceivedChunk> chunks;
+    std::vector<Track>         tracks;
+
+    void OnMetadata(const GpxFile& metadata) override
+    {
+      calls.push_back("metadata "+metadata.name.value_or(""));
+    }
+
+    void OnWaypoint(Waypoint&& waypoint) override
+    {
+      calls.push_back("waypoint "+waypoint.name.value_or(""));
+    }
+
+    void OnRoute(Route&& route) override
+    {
+      calls.push_back("route "+route.name.value_or(""));
+    }
+
+    void OnTrackPoints(const TrackPointChunk& chunk) override
+    {
+      ReceivedChunk received{chunk.track,
+                             chunk.segment,
+                             chunk.offset,
+                             chunk.last,
+                             chunk.points};
+
+      // Only one of both storages is used
+      REQUIRE((chunk.points.empty() || chunk.columns.IsEmpty()));
+
+      chunk.columns.CopyTo(received.points);
+
+      if (calls.empty() || calls.back()!="points") {
+        calls.emplace_back("points");
+      }
+
+      chunks.push_back(std::move(received));
+    }
+
+    void OnTrack(size_t index, Track&& track) override
+    {
+      REQUIRE(index==tracks.size());
+      REQUIRE(track.segments.empty());
+
+      calls.push_back("track "+track.name.value_or(""));
+      tracks.push_back(std::move(track));
+    }
+  };
+
+  void RequireChunks(const CollectingHandler& handler,
+                     size_t chunkSize)
+  {
+    struct Segment
+    {
+      size_t track;
+      size_t segment;
+      size_t firstPoint;
+      size_t pointCount;
+    };
+
+    std::vector<Segment> segments{{0,0,0,5},{0,1,5,0},{1,0,5,7}};
+    size_t               chunkIndex=0;
+
+    for (const auto& segment : segments) {
+      size_t offset=0;
+
+      while (true) {
+        REQUIRE(chunkIndex<handler.chunks.size());
+
+        const ReceivedChunk& chunk=handler.chunks[chunkIndex++];
+        size_t               expectedSize=std::min(chunkSize,segment.pointCount-offset);
+
+        REQUIRE(chunk.track==segment.track);
+        REQUIRE(chunk.segment==segment.segment);
+        REQUIRE(chunk.offset==offset);
+        REQUIRE(chunk.points.size()==expectedSize);
+
+        for (size_t i=0; i<chunk.points.size(); i++) {
+          RequireEqual(chunk.points[i],CreatePoint(segment.firstPoint+offset+i));
+        }
+
+        offset+=chunk.points.size();
+
+        if (chunk.last) {
+          break;
+        }
+
+        REQUIRE(chunk.points.size()==chunkSize);
+      }
+
+      REQUIRE(offset==segment.pointCount);
+    }
+
+    REQUIRE(chunkIndex==handler.chunks.size());
+  }
+}
+
+TEST_CASE("Stream track points in chunks")
+{
+  std::string filename=GetTestFile("chunks.gpx");
+
+  WriteTestFile(filename);
+
+  for (auto storage : {TrackPointStorage::Points, TrackPointStorage::Columns}) {
+    for (size_t chunkSize : {1,2,3,5,100}) {
+      CollectingHandler handler;
+      GpxStreamOptions  options;
+
+      options.chunkSize=chunkSize;
+      options.storage=storage;
+
+      REQUIRE(ImportGpxStream(filename,handler,options));
+
+      REQUIRE(handler.calls==std::vector<std::string>{"metadata GpxStreamTest",
+                                                      "waypoint Waypoint",
+                                                      "route Route",
+                                                      "points",
+                                                      "track First",
+                                                      "points",
+                                                      "track Second"});
+      REQUIRE(handler.tracks.size()==2);
+
+      RequireChunks(handler,chunkSize);
+    }
+  }
+}
+
+TEST_CASE("Streamed file matches the non streaming import")
+{
+  std::string filename=GetTestFile("roundtrip.gpx");
+
+  WriteTestFile(filename);
+
+  GpxFile gpxFile;
+
+  REQUIRE(ImportGpx(filename,gpxFile));
+  REQUIRE(gpxFile.name==std::optional<std::string>("GpxStreamTest"));
+  REQUIRE(gpxFile.waypoints.size()==1);
+  REQUIRE(gpxFile.routes.size()==1);
+  REQUIRE(gpxFile.routes[0].points.size()==1);
+  REQUIRE(gpxFile.tracks.size()==2);
+  REQUIRE(gpxFile.tracks[0].segments.size()==2);
+  REQUIRE(gpxFile.tracks[0].segments[0].points.size()==5);
+  REQUIRE(gpxFile.tracks[0].segments[1].points.empty());
+  REQUIRE(gpxFile.tracks[1].segments.size()==1);
+  REQUIRE(gpxFile.tracks[1].segments[0].points.size()==7);
+
+  for (size_t i=0; i<5; i++) {
+    RequireEqual(gpxFile.tracks[0].segments[0].points[i],CreatePoint(i));
+  }
+
+  for (size_t i=0; i<7; i++) {
+    RequireEqual(gpxFile.tracks[1].segments[0].points[i],CreatePoint(5+i));
+  }
+
+  // Export and stream again, the result has to be the same
+  std::string exportedFilename=GetTestFile("exported.gpx");
+
+  REQUIRE(ExportGpx(gpxFile,exportedFilename));
+
+  CollectingHandler handler;
+
+  REQUIRE(ImportGpxStream(exportedFilename,handler));
+  RequireChunks(handler,GpxStreamOptions().chunkSize);
+}
+
+TEST_CASE("Track point columns store unset attributes")
+{
+  TrackPointColumns columns;
+  TrackPoint        unset(GeoCoord(50.0,14.0));
+  TrackPoint        set=CreatePoint(0);
+
+  columns.Append(unset);
+  columns.Append(set);
+
+  REQUIRE(columns.GetSize()==2);
+
+  TrackPoint first=columns.Get(0);
+
+  REQUIRE_FALSE(first.elevation.has_value());
+  REQUIRE_FALSE(first.timestamp.has_value());
+  REQUIRE_FALSE(first.course.has_value());
+  REQUIRE_FALSE(first.hdop.has_value());
+  REQUIRE_FALSE(first.vdop.has_value());
+  REQUIRE_FALSE(first.pdop.has_value());
+
+  RequireEqual(columns.Get(1),set);
+
+  std::vector<TrackPoint> points;
+
+  columns.CopyTo(points);
+
+  REQUIRE(points.size()==2);
+  RequireEqual(points[0],unset);
+  RequireEqual(points[1],set);
+
+  columns.Clear();
+
+  REQUIRE(columns.IsEmpty());
+}
+
+TEST_CASE("Stream writer enforces the element order")
+{
+  std::string filename=GetTestFile("order.gpx");
+  Waypoint    waypoint(GeoCoord(50.5,14.5));
+  Route       route;
+  Track       track;
+
+  SECTION("No waypoints or routes after a track") {
+    GpxStreamWriter writer(filename);
+
+    REQUIRE(writer.StartTrack(track));
+    REQUIRE(writer.StartSegment());
+    REQUIRE_FALSE(writer.WriteWaypoint(waypoint));
+    REQUIRE_FALSE(writer.WriteRoute(route));
+    REQUIRE(writer.EndSegment());
+    REQUIRE(writer.EndTrack());
+    REQUIRE_FALSE(writer.WriteWaypoint(waypoint));
+    REQUIRE_FALSE(writer.WriteRoute(route));
+    REQUIRE(writer.StartTrack(track));
+    REQUIRE(writer.EndTrack());
+    REQUIRE(writer.Close());
+  }
+
+  SECTION("No waypoints after a route") {
+    GpxStreamWriter writer(filename);
+
+    REQUIRE(writer.WriteRoute(route));
+    REQUIRE_FALSE(writer.WriteWaypoint(waypoint));
+    REQUIRE(writer.WriteRoute(route));
+    REQUIRE(writer.Close());
+  }
+
+  SECTION("Track points only inside of segments") {
+    GpxStreamWriter writer(filename);
+
+    REQUIRE_FALSE(writer.WriteTrackPoints(CreatePoints(0,1)));
+    REQUIRE_FALSE(writer.StartSegment());
+    REQUIRE(writer.StartTrack(track));
+    REQUIRE_FALSE(writer.WriteTrackPoints(CreatePoints(0,1)));
+    REQUIRE_FALSE(writer.EndSegment());
+    REQUIRE(writer.Close());
+    REQUIRE_FALSE(writer.Close());
+  }
+
+  GpxFile gpxFile;
+
+  REQUIRE(ImportGpx(filename,gpxFile));
+}
@@ -172,6 +172,7 @@ static const std::set<std::string> allowedDependencies{
     "osmscoutgpx => osmscout.log",
     "osmscoutgpx => osmscout.util",
     "osmscoutgpx => osmscout.io",
+    "osmscoutgpx => osmscout.routing",
     "osmscoutgpx => osmscout", // Fix this
 
     "osmscoutimport => osmscout.system",
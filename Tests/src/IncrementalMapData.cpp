@@ -0,0 +1,184 @@
+/*
+  IncrementalMapData - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscoutmap/MapService.h>
+#include <osmscoutmap/StyleConfig.h>
+
+template<class O>
+std::vector<osmscout::FileOffset> GetOffsets(const std::vector<O>& objects)
+{
+  std::vector<osmscout::FileOffset> offsets;
+
+  offsets.reserve(objects.size());
+
+  for (const auto& object : objects) {
+    offsets.push_back(object->GetFileOffset());
+  }
+
+  std::sort(offsets.begin(),offsets.end());
+
+  return offsets;
+}
+
+bool Compare(const osmscout::MapData& expected,
+             const osmscout::MapData& actual)
+{
+  bool result=true;
+
+  if (GetOffsets(expected.nodes)!=GetOffsets(actual.nodes)) {
+    std::cerr << "Nodes differ: " << expected.nodes.size() << " <=> " << actual.nodes.size() << std::endl;
+    result=false;
+  }
+
+  if (GetOffsets(expected.ways)!=GetOffsets(actual.ways)) {
+    std::cerr << "Ways differ: " << expected.ways.size() << " <=> " << actual.ways.size() << std::endl;
+    result=false;
+  }
+
+  if (GetOffsets(expected.areas)!=GetOffsets(actual.areas)) {
+    std::cerr << "Areas differ: " << expected.areas.size() << " <=> " << actual.areas.size() << std::endl;
+    result=false;
+  }
+
+  if (GetOffsets(expected.routes)!=GetOffsets(actual.routes)) {
+    std::cerr << "Routes differ: " << expected.routes.size() << " <=> " << actual.routes.size() << std::endl;
+    result=false;
+  }
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc!=3) {
+    std::cerr << "IncrementalMapData <database directory> <style file>" << std::endl;
+    return 1;
+  }
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(argv[1])) {
+    std::cerr << "Cannot open database" << std::endl;
+    return 1;
+  }
+
+  osmscout::MapServiceRef  mapService=std::make_shared<osmscout::MapService>(database);
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  if (!styleConfig->Load(argv[2])) {
+    std::cerr << "Cannot open style" << std::endl;
+    return 1;
+  }
+
+  osmscout::AreaSearchParameter    searchParameter;
+  osmscout::IncrementalMapData     incrementalData;
+  osmscout::MapData                incrementalMapData;
+  osmscout::MercatorProjection     projection;
+  osmscout::GeoCoord               center(50.418,14.57);
+  osmscout::Magnification          magnification(osmscout::Magnification::magClose);
+  int                              errors=0;
+
+  // Pan in small steps, zoom in and zoom out again
+  for (size_t step=0; step<12; step++) {
+    if (step==8) {
+      magnification.SetLevel(osmscout::MagnificationLevel(magnification.GetLevel()+1));
+    }
+    else if (step==10) {
+      magnification.SetLevel(osmscout::MagnificationLevel(magnification.GetLevel()-1));
+    }
+    else if (step>0) {
+      center=osmscout::GeoCoord(center.GetLat()+0.003,
+                                center.GetLon()+0.006);
+    }
+
+    projection.Set(center,
+                   magnification,
+                   96.0,
+                   800,
+                   600);
+
+    std::list<osmscout::TileRef> tiles;
+    osmscout::MapData            data;
+
+    mapService->LookupTiles(projection,tiles);
+    mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles);
+    mapService->AddTileDataToMapData(tiles,data);
+    mapService->AddTileDataToMapData(tiles,incrementalData,incrementalMapData);
+
+    const auto& statistics=incrementalData.GetStatistics();
+
+    std::cout << "Step " << step << ": " << tiles.size() << " tiles, ";
+    std::cout << statistics.addedTiles << " added, ";
+    std::cout << statistics.removedTiles << " removed, ";
+    std::cout << statistics.changedTiles << " changed, ";
+    std::cout << statistics.keptTiles << " kept, ";
+    std::cout << data.nodes.size() << " nodes, " << data.ways.size() << " ways, " << data.areas.size() << " areas" << std::endl;
+
+    if (!Compare(data,incrementalMapData)) {
+      std::cerr << "Step " << step << ": incremental MapData differs" << std::endl;
+      errors++;
+    }
+
+    if (step==0 && !statistics.rebuild) {
+      std::cerr << "Step " << step << ": expected initial rebuild" << std::endl;
+      errors++;
+    }
+
+    if (step>0 && statistics.rebuild) {
+      std::cerr << "Step " << step << ": unexpected rebuild" << std::endl;
+      errors++;
+    }
+
+    if (step>0 && step<8 && statistics.keptTiles==0) {
+      std::cerr << "Step " << step << ": expected unchanged tiles while panning" << std::endl;
+      errors++;
+    }
+  }
+
+  // Somebody else clearing the MapData must result in a rebuild
+  incrementalMapData.ClearDBData();
+
+  std::list<osmscout::TileRef> tiles;
+  osmscout::MapData            data;
+
+  mapService->LookupTiles(projection,tiles);
+  mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles);
+  mapService->AddTileDataToMapData(tiles,data);
+  mapService->AddTileDataToMapData(tiles,incrementalData,incrementalMapData);
+
+  if (!incrementalData.GetStatistics().rebuild ||
+      !Compare(data,incrementalMapData)) {
+    std::cerr << "MapData not rebuilt after external change" << std::endl;
+    errors++;
+  }
+
+  database->Close();
+
+  return errors==0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+/*
+  MPSCQueue - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <osmscout/async/MPSCQueue.h>
+
+#include <TestMain.h>
+
+TEST_CASE("Empty queue")
+{
+  osmscout::MPSCQueue<int> queue;
+
+  REQUIRE_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE("Single producer keeps FIFO order")
+{
+  osmscout::MPSCQueue<std::unique_ptr<int>> queue;
+
+  for (int i=0; i<100; i++) {
+    queue.Push(std::make_unique<int>(i));
+  }
+
+  for (int i=0; i<100; i++) {
+    auto value=queue.TryPop();
+
+    REQUIRE(value.has_value());
+    REQUIRE(*value.value()==i);
+  }
+
+  REQUIRE_FALSE(queue.TryPop().has_value());
+
+  // Elements left in the queue are freed by the destructor
+  queue.Push(std::make_unique<int>(1));
+}
+
+TEST_CASE("Multiple producers keep their own order")
+{
+  const size_t producerCount=4;
+  const size_t valueCount=100000;
+
+  osmscout::MPSCQueue<std::pair<size_t,size_t>> queue;
+  std::vector<std::thread>                      producers;
+
+  for (size_t producer=0; producer<producerCount; producer++) {
+    producers.emplace_back([&queue,producer]() {
+      for (size_t value=0; value<valueCount; value++) {
+        queue.Push(std::make_pair(producer,value));
+      }
+    });
+  }
+
+  std::vector<size_t> nextValue(producerCount,0);
+  size_t              received=0;
+  bool                ordered=true;
+
+  while (received<producerCount*valueCount) {
+    auto entry=queue.TryPop();
+
+    if (!entry) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    if (entry->second!=nextValue[entry->first]) {
+      ordered=false;
+    }
+
+    nextValue[entry->first]=entry->second+1;
+    received++;
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  REQUIRE(ordered);
+  REQUIRE_FALSE(queue.TryPop().has_value());
+
+  for (size_t producer=0; producer<producerCount; producer++) {
+    REQUIRE(nextValue[producer]==valueCount);
+  }
+}
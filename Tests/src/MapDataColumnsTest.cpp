@@ -0,0 +1,254 @@
+/*
+  MapDataColumnsTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscoutmap/MapData.h>
+
+#include <TestMain.h>
+
+using namespace osmscout;
+
+namespace {
+  struct TestTypes
+  {
+    TypeConfig  typeConfig;
+    TypeInfoRef nodeType;
+    TypeInfoRef wayType;
+    TypeInfoRef areaType;
+
+    TestTypes()
+    {
+      nodeType=typeConfig.RegisterType(std::make_shared<TypeInfo>("test_node"));
+      nodeType->CanBeNode(true);
+      wayType=typeConfig.RegisterType(std::make_shared<TypeInfo>("test_way"));
+      wayType->CanBeWay(true);
+      areaType=typeConfig.RegisterType(std::make_shared<TypeInfo>("test_area"));
+      areaType->CanBeArea(true);
+    }
+  };
+
+  NodeRef CreateNode(const TypeInfoRef& type,
+                     const GeoCoord& coord)
+  {
+    NodeRef node=std::make_shared<Node>();
+
+    node->SetType(type);
+    node->SetCoords(coord);
+
+    return node;
+  }
+
+  WayRef CreateWay(const TypeInfoRef& type,
+                   const GeoCoord& start,
+                   size_t nodeCount)
+  {
+    WayRef way=std::make_shared<Way>();
+
+    way->SetType(type);
+
+    for (size_t i=0; i<nodeCount; i++) {
+      way->nodes.emplace_back(i,GeoCoord(start.GetLat(),start.GetLon()+double(i)*0.001));
+    }
+
+    return way;
+  }
+
+  Area::Ring CreateRing(const TypeInfoRef& type,
+                        uint8_t level,
+                        const GeoBox& box)
+  {
+    Area::Ring ring;
+
+    ring.SetType(type);
+    ring.SetRing(level);
+    ring.nodes.emplace_back(0,box.GetMinCoord());
+    ring.nodes.emplace_back(0,GeoCoord(box.GetMinLat(),box.GetMaxLon()));
+    ring.nodes.emplace_back(0,box.GetMaxCoord());
+    ring.nodes.emplace_back(0,GeoCoord(box.GetMaxLat(),box.GetMinLon()));
+
+    return ring;
+  }
+
+  void FillMapData(const TestTypes& types,
+                   MapData& data)
+  {
+    data.nodes.push_back(CreateNode(types.nodeType,GeoCoord(50.0,14.0)));
+    data.nodes.push_back(CreateNode(types.nodeType,GeoCoord(50.1,14.1)));
+
+    data.ways.push_back(CreateWay(types.wayType,GeoCoord(50.0,14.0),3));
+    data.ways.push_back(CreateWay(types.wayType,GeoCoord(51.0,15.0),5));
+
+    AreaRef simpleArea=std::make_shared<Area>();
+
+    simpleArea->rings.push_back(CreateRing(types.areaType,
+                                           Area::outerRingId,
+                                           GeoBox(GeoCoord(50.0,14.0),GeoCoord(50.5,14.5))));
+
+    AreaRef multipolygon=std::make_shared<Area>();
+    Area::Ring  master;
+
+    master.SetType(types.areaType);
+    master.MarkAsMasterRing();
+
+    multipolygon->rings.push_back(master);
+    multipolygon->rings.push_back(CreateRing(types.areaType,
+                                             Area::outerRingId,
+                                             GeoBox(GeoCoord(52.0,16.0),GeoCoord(53.0,17.0))));
+    multipolygon->rings.push_back(CreateRing(types.typeConfig.typeInfoIgnore,
+                                             Area::outerRingId+1,
+                                             GeoBox(GeoCoord(52.2,16.2),GeoCoord(52.8,16.8))));
+
+    data.areas.push_back(simpleArea);
+    data.areas.push_back(multipolygon);
+  }
+}
+
+TEST_CASE("Columns mirror nodes, ways and areas of MapData")
+{
+  TestTypes types;
+  MapData   data;
+
+  FillMapData(types,data);
+
+  REQUIRE_FALSE(data.HasColumns());
+
+  data.columns.Assign(data.nodes,
+                      data.ways,
+                      data.areas);
+
+  REQUIRE(data.HasColumns());
+
+  const MapDataColumns& columns=data.columns;
+
+  REQUIRE(columns.GetNodeCount()==2);
+  REQUIRE(columns.nodes.coords[1]==data.nodes[1]->GetCoords());
+  REQUIRE(columns.nodes.types[0]==types.nodeType->GetNodeId());
+  REQUIRE(columns.nodes.features[0]==&data.nodes[0]->GetFeatureValueBuffer());
+
+  REQUIRE(columns.GetWayCount()==2);
+  REQUIRE(columns.ways.points.size()==8);
+  REQUIRE(columns.ways.types[1]==types.wayType->GetWayId());
+
+  PointRange wayPoints=columns.GetWayPoints(1);
+
+  REQUIRE(wayPoints.size()==5);
+  REQUIRE(wayPoints[4].GetCoord()==data.ways[1]->nodes[4].GetCoord());
+  REQUIRE(columns.ways.boundingBoxes[1].GetMinCoord()==data.ways[1]->GetBoundingBox().GetMinCoord());
+  REQUIRE(columns.ways.boundingBoxes[1].GetMaxCoord()==data.ways[1]->GetBoundingBox().GetMaxCoord());
+
+  REQUIRE(columns.GetAreaCount()==2);
+  REQUIRE(columns.areas.ringOffsets==std::vector<size_t>{0,1,4});
+  REQUIRE(columns.areas.ringLevels[1]==Area::masterRingId);
+  REQUIRE(columns.areas.ringLevels[3]==Area::outerRingId+1);
+  REQUIRE(columns.GetRingPoints(1).empty());
+  REQUIRE(columns.GetRingPoints(3).size()==4);
+  REQUIRE(columns.areas.ringFeatures[2]==&data.areas[1]->rings[1].GetFeatureValueBuffer());
+
+  for (size_t i=0; i<data.areas.size(); i++) {
+    GeoBox expected=data.areas[i]->GetBoundingBox();
+
+    REQUIRE(columns.areas.boundingBoxes[i].GetMinCoord()==expected.GetMinCoord());
+    REQUIRE(columns.areas.boundingBoxes[i].GetMaxCoord()==expected.GetMaxCoord());
+  }
+}
+
+TEST_CASE("Refilling columns reuses allocated memory")
+{
+  TestTypes types;
+  MapData   data;
+
+  FillMapData(types,data);
+
+  data.columns.Assign(data.nodes,
+                      data.ways,
+                      data.areas);
+
+  size_t memorySize=data.columns.GetMemorySize();
+
+  REQUIRE(memorySize>0);
+
+  data.columns.Assign(data.nodes,
+                      data.ways,
+                      data.areas);
+
+  REQUIRE(data.columns.GetMemorySize()==memorySize);
+
+  data.ClearDBData();
+
+  REQUIRE(data.columns.IsEmpty());
+  REQUIRE_FALSE(data.HasColumns());
+  REQUIRE(data.columns.GetMemorySize()==memorySize);
+}
+
+TEST_CASE("Columns are outdated after MapData changed")
+{
+  TestTypes types;
+  MapData   data;
+
+  FillMapData(types,data);
+
+  data.columns.Assign(data.nodes,
+                      data.ways,
+                      data.areas);
+
+  data.ways.pop_back();
+
+  REQUIRE_FALSE(data.HasColumns());
+}
+
+TEST_CASE("Columns are outdated after objects were replaced or reordered")
+{
+  TestTypes types;
+  MapData   data;
+
+  FillMapData(types,data);
+
+  data.columns.Assign(data.nodes,
+                      data.ways,
+                      data.areas);
+
+  REQUIRE(data.HasColumns());
+
+  SECTION("Replaced way") {
+    std::weak_ptr<Way> replaced=data.ways[0];
+
+    data.ways[0]=std::make_shared<Way>(*data.ways[0]);
+
+    // The columns keep the replaced way, so its address cannot be reused
+    REQUIRE_FALSE(replaced.expired());
+    REQUIRE_FALSE(data.HasColumns());
+  }
+
+  SECTION("Reordered nodes") {
+    std::swap(data.nodes[0],data.nodes[1]);
+
+    REQUIRE_FALSE(data.HasColumns());
+  }
+
+  SECTION("Replaced area") {
+    data.areas[1]=data.areas[0];
+
+    REQUIRE_FALSE(data.HasColumns());
+  }
+}
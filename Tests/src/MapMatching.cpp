@@ -0,0 +1,186 @@
+/*
+  MapMatching - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/routing/MapMatchingService.h>
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/util/Geometry.h>
+
+int main(int argc, char* argv[])
+{
+  if (argc!=2) {
+    std::cerr << "MapMatching <database directory>" << std::endl;
+    return 1;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(argv[1])) {
+    std::cerr << "Cannot open db " << argv[1] << std::endl;
+    return 1;
+  }
+
+  auto                         profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+  std::map<std::string,double> speedMap;
+  osmscout::TypeInfoSet        routableTypes;
+
+  for (const auto& type : database->GetTypeConfig()->GetTypes()) {
+    if (!type->GetIgnore() &&
+        type->CanBeWay() &&
+        type->CanRoute(osmscout::vehicleCar)) {
+      routableTypes.Set(type);
+      speedMap[type->GetName()]=50.0;
+    }
+  }
+
+  profile->ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  // Use the longest routable way near the test coordinate as ground truth
+  osmscout::WayRef way;
+  auto             searchResult=database->LoadWaysInRadius(osmscout::GeoCoord(50.412,14.534),
+                                                           routableTypes,
+                                                           osmscout::Meters(500));
+
+  for (const auto& entry : searchResult.GetWayResults()) {
+    if (profile->CanUse(*entry.GetWay()) &&
+        (!way || entry.GetWay()->nodes.size()>way->nodes.size())) {
+      way=entry.GetWay();
+    }
+  }
+
+  if (!way || way->nodes.size()<3) {
+    std::cerr << "No suitable way found" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Using way " << way->GetFileOffset() << " with " << way->nodes.size() << " nodes" << std::endl;
+
+  // Fixes on the way with a small offset to the north
+  std::vector<osmscout::MapMatchingFix> trace;
+
+  for (size_t i=1; i<way->nodes.size(); i++) {
+    osmscout::GeoCoord a=way->nodes[i-1].GetCoord();
+    osmscout::GeoCoord b=way->nodes[i].GetCoord();
+
+    trace.emplace_back(osmscout::GeoCoord(a.GetLat()+0.00003,a.GetLon()));
+    trace.emplace_back(osmscout::GeoCoord((a.GetLat()+b.GetLat())/2+0.00003,(a.GetLon()+b.GetLon())/2));
+  }
+
+  osmscout::MapMatchingParameter parameter;
+
+  parameter.SetThreads(2);
+
+  osmscout::MapMatchingService matcher(database,profile,parameter);
+  osmscout::MapMatchingResult  result=matcher.Match(trace);
+
+  size_t onWay=0;
+
+  for (const auto& fix : result.GetFixes()) {
+    if (fix.matched && fix.object==way->GetObjectFileRef()) {
+      onWay++;
+    }
+  }
+
+  std::cout << "Matched " << result.GetMatchedCount() << "/" << trace.size() << " fixes, "
+            << onWay << " on expected way, " << result.GetPath().size() << " ways in path, "
+            << result.GetBreakCount() << " breaks" << std::endl;
+
+  int errors=0;
+
+  if (result.GetMatchedCount()!=trace.size()) {
+    std::cerr << "Not all fixes were matched" << std::endl;
+    errors++;
+  }
+
+  if (onWay*10<trace.size()*9) {
+    std::cerr << "Less than 90% of fixes matched to the expected way" << std::endl;
+    errors++;
+  }
+
+  // A gap in the trace larger than the maximum transition distance starts a new model
+  // instead of searching a path across the gap
+  std::vector<osmscout::MapMatchingFix> gapTrace;
+  osmscout::Distance                    maxFixDistance;
+
+  for (size_t i=0; i<trace.size(); i++) {
+    if (i>=trace.size()/3 && i<trace.size()*2/3) {
+      continue;
+    }
+
+    if (i>0 && i!=trace.size()*2/3) {
+      maxFixDistance=std::max(maxFixDistance,
+                              osmscout::GetSphericalDistance(trace[i-1].coord,trace[i].coord));
+    }
+
+    gapTrace.push_back(trace[i]);
+  }
+
+  osmscout::Distance gap=osmscout::GetSphericalDistance(gapTrace[trace.size()/3-1].coord,
+                                                        gapTrace[trace.size()/3].coord);
+
+  if (gap>maxFixDistance) {
+    osmscout::MapMatchingParameter gapParameter(parameter);
+
+    gapParameter.SetMaxTransitionDistance((maxFixDistance+gap)/2);
+
+    osmscout::MapMatchingService gapMatcher(database,profile,gapParameter);
+    osmscout::MapMatchingResult  gapResult=gapMatcher.Match(gapTrace);
+
+    std::cout << "Gap of " << gap.AsMeter() << " m: matched " << gapResult.GetMatchedCount() << "/" << gapTrace.size()
+              << " fixes, " << gapResult.GetBreakCount() << " breaks" << std::endl;
+
+    if (gapResult.GetBreakCount()!=1) {
+      std::cerr << "Gap in the trace did not break the model" << std::endl;
+      errors++;
+    }
+
+    if (gapResult.GetMatchedCount()!=gapTrace.size()) {
+      std::cerr << "Not all fixes around the gap were matched" << std::endl;
+      errors++;
+    }
+  }
+  else {
+    std::cerr << "Way too short for a gap in the trace" << std::endl;
+    errors++;
+  }
+
+  // Parallel matching must produce the same result as sequential matching
+  std::vector<std::vector<osmscout::MapMatchingFix>> traces(4,trace);
+  auto                                               results=matcher.Match(traces);
+
+  for (const auto& parallelResult : results) {
+    if (parallelResult.GetPath()!=result.GetPath() ||
+        parallelResult.GetMatchedCount()!=result.GetMatchedCount()) {
+      std::cerr << "Parallel result differs" << std::endl;
+      errors++;
+    }
+  }
+
+  database->Close();
+
+  return errors==0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/*
+  MemoryArenaTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <list>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <osmscout/util/MemoryArena.h>
+
+#include <TestMain.h>
+
+TEST_CASE("Allocations beyond the buffer grow the arena on reset")
+{
+  osmscout::MemoryArena arena(1024);
+
+  {
+    std::pmr::list<std::pmr::string> values(&arena);
+
+    for (size_t i=0; i<1000; i++) {
+      values.emplace_back("a value that does not fit into the small string buffer");
+    }
+
+    REQUIRE(values.back()=="a value that does not fit into the small string buffer");
+  }
+
+  REQUIRE(arena.GetOverflow()>0);
+
+  arena.Reset();
+
+  REQUIRE(arena.GetCapacity()>1024);
+  REQUIRE(arena.GetOverflow()==0);
+}
+
+TEST_CASE("Buffers beyond the maximum capacity are released on reset")
+{
+  osmscout::MemoryArena arena(1024,
+                              64*1024);
+
+  {
+    std::pmr::vector<char> values(&arena);
+
+    values.resize(8*1024);
+  }
+
+  arena.Reset();
+
+  REQUIRE(arena.GetCapacity()>1024);
+  REQUIRE(arena.GetCapacity()<=64*1024);
+
+  {
+    std::pmr::vector<char> values(&arena);
+
+    values.resize(1024*1024);
+  }
+
+  arena.Reset();
+
+  REQUIRE(arena.GetCapacity()==1024);
+  REQUIRE(arena.GetOverflow()==0);
+}
+
+TEST_CASE("Reused arena does not allocate from the heap")
+{
+  osmscout::MemoryArena arena(1024);
+
+  for (size_t run=0; run<3; run++) {
+    arena.Reset();
+
+    std::pmr::set<int> values(&arena);
+
+    for (int i=0; i<10000; i++) {
+      values.insert(i);
+    }
+
+    // Freed nodes are reused from the pool
+    for (int i=0; i<10000; i++) {
+      values.erase(i);
+      values.insert(i+10000);
+    }
+
+    REQUIRE(values.size()==10000);
+
+    if (run>0) {
+      REQUIRE(arena.GetOverflow()==0);
+    }
+  }
+}
+
+TEST_CASE("Shared objects can be allocated in the arena")
+{
+  osmscout::MemoryArena arena;
+
+  auto value=std::allocate_shared<std::pair<int,double>>(std::pmr::polymorphic_allocator<std::pair<int,double>>(&arena),
+                                                          42,
+                                                          1.5);
+
+  REQUIRE(value->first==42);
+  REQUIRE(value->second==1.5);
+}
@@ -0,0 +1,121 @@
+#include <thread>
+#include <vector>
+
+#include <osmscout/util/Metrics.h>
+
+#include <TestMain.h>
+
+TEST_CASE("Histogram bucket boundaries are consistent") {
+  for (size_t index=0; index<osmscout::MetricHistogram::BucketCount; index++) {
+    uint64_t lower=osmscout::MetricHistogram::GetBucketLowerBound(index);
+    uint64_t upper=osmscout::MetricHistogram::GetBucketUpperBound(index);
+
+    REQUIRE(lower<=upper);
+    REQUIRE(osmscout::MetricHistogram::GetBucketIndex(lower)==index);
+    REQUIRE(osmscout::MetricHistogram::GetBucketIndex(upper)==index);
+
+    if (index>0) {
+      REQUIRE(osmscout::MetricHistogram::GetBucketUpperBound(index-1)+1==lower);
+    }
+  }
+
+  REQUIRE(osmscout::MetricHistogram::GetBucketUpperBound(osmscout::MetricHistogram::BucketCount-1)==UINT64_MAX);
+}
+
+TEST_CASE("Disabled metrics do not record") {
+  osmscout::MetricsRegistry& registry=osmscout::MetricsRegistry::Instance();
+
+  registry.SetEnabled(false);
+  registry.Reset();
+
+  osmscout::MetricCounter&   counter=registry.GetCounter("test_disabled_total","Test counter");
+  osmscout::MetricHistogram& histogram=registry.GetHistogram("test_disabled_microseconds","Test histogram");
+
+  counter.Increment();
+  histogram.Record(10);
+
+  auto snapshot=registry.GetSnapshot();
+
+  REQUIRE(snapshot.GetCounter("test_disabled_total")!=nullptr);
+  REQUIRE(snapshot.GetCounter("test_disabled_total")->value==0);
+  REQUIRE(snapshot.GetHistogram("test_disabled_microseconds")->count==0);
+}
+
+TEST_CASE("Counters aggregate over threads") {
+  osmscout::MetricsRegistry& registry=osmscout::MetricsRegistry::Instance();
+
+  registry.SetEnabled(true);
+  registry.Reset();
+
+  osmscout::MetricCounter& counter=registry.GetCounter("test_threads_total","Test counter");
+
+  REQUIRE(&counter==&registry.GetCounter("test_threads_total","Test counter"));
+
+  std::vector<std::thread> threads;
+
+  for (size_t t=0; t<4; t++) {
+    threads.emplace_back([&counter]() {
+      for (size_t i=0; i<10000; i++) {
+        counter.Increment();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(counter.GetValue()==40000);
+
+  registry.SetEnabled(false);
+}
+
+TEST_CASE("Histogram statistics and export") {
+  osmscout::MetricsRegistry& registry=osmscout::MetricsRegistry::Instance();
+
+  registry.SetEnabled(true);
+  registry.Reset();
+
+  osmscout::MetricHistogram& histogram=registry.GetHistogram("test_latency_microseconds","Test \"latency\"");
+  osmscout::MetricGauge&     gauge=registry.GetGauge("test_gauge","Test gauge");
+
+  for (uint64_t value=1; value<=1000; value++) {
+    histogram.Record(value);
+  }
+
+  gauge.Add(5);
+  gauge.Sub(2);
+
+  auto snapshot=registry.GetSnapshot();
+  auto value=snapshot.GetHistogram("test_latency_microseconds");
+
+  REQUIRE(value!=nullptr);
+  REQUIRE(value->count==1000);
+  REQUIRE(value->sum==500500);
+  REQUIRE(value->min==1);
+  REQUIRE(value->max==1000);
+  REQUIRE(value->GetMean()==Approx(500.5));
+
+  // relative error of buckets is at most 12.5%
+  REQUIRE(value->GetPercentile(50.0)>=500);
+  REQUIRE(value->GetPercentile(50.0)<=563);
+  REQUIRE(value->GetPercentile(99.0)>=990);
+  REQUIRE(value->GetPercentile(100.0)==1000);
+
+  REQUIRE(snapshot.GetGauge("test_gauge")->value==3);
+
+  std::string prometheus=snapshot.ToPrometheus();
+
+  REQUIRE(prometheus.find("# TYPE test_latency_microseconds histogram\n")!=std::string::npos);
+  REQUIRE(prometheus.find("test_latency_microseconds_bucket{le=\"+Inf\"} 1000\n")!=std::string::npos);
+  REQUIRE(prometheus.find("test_latency_microseconds_sum 500500\n")!=std::string::npos);
+  REQUIRE(prometheus.find("test_gauge 3\n")!=std::string::npos);
+
+  std::string json=snapshot.ToJson();
+
+  REQUIRE(json.find("\"name\":\"test_latency_microseconds\"")!=std::string::npos);
+  REQUIRE(json.find("\"help\":\"Test \\\"latency\\\"\"")!=std::string::npos);
+  REQUIRE(json.find("\"count\":1000")!=std::string::npos);
+
+  registry.SetEnabled(false);
+}
@@ -17,7 +17,9 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <cmath>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <thread>
 #include <vector>
@@ -31,6 +33,8 @@
 
 #include <osmscout/io/FileScanner.h>
 
+#include <osmscout/util/Geometry.h>
+
 struct Arguments
 {
   bool                     help=false;
@@ -39,6 +43,26 @@ struct Arguments
   osmscout::GeoCoord       target;
 };
 
+osmscout::Distance GetRouteLength(osmscout::MultiDBRoutingService& router,
+                                  const osmscout::RoutingResult& routingResult)
+{
+  auto               pointsResult=router.TransformRouteDataToPoints(routingResult.GetRoute());
+  osmscout::Distance length;
+
+  if (!pointsResult.Success()) {
+    return length;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord());
+  }
+
+  return length;
+}
+
 void GetCarSpeedTable(std::map<std::string,double>& map)
 {
   map["highway_motorway"]=110.0;
@@ -185,6 +209,36 @@ int main(int argc, char* argv[])
 
   auto routeDescriptionResult=router->TransformRouteDataToRouteDescription(routingResult.GetRoute());
 
+  std::cout << "Calculate route bidirectional..." << std::endl;
+
+  osmscout::RoutingParameter bidirectionalParameter;
+  bidirectionalParameter.SetBidirectional(true);
+  auto                       bidirectionalResult=router->CalculateRoute(startNode,targetNode,std::nullopt,bidirectionalParameter);
+
+  if (!bidirectionalResult.Success()){
+    std::cerr << "Bidirectional route failed" << std::endl;
+    return 1;
+  }
+
+  osmscout::Distance length=GetRouteLength(*router,routingResult);
+  osmscout::Distance bidirectionalLength=GetRouteLength(*router,bidirectionalResult);
+
+  std::cout << "Route length: " << length.AsString() << " (" << routingResult.GetExpandedNodes() << " nodes expanded), ";
+  std::cout << "bidirectional: " << bidirectionalLength.AsString() << " (" << bidirectionalResult.GetForwardExpandedNodes();
+  std::cout << " + " << bidirectionalResult.GetBackwardExpandedNodes() << " nodes expanded)" << std::endl;
+  std::cout << "Route cost: " << std::setprecision(10) << routingResult.GetCost() << ", bidirectional: " << bidirectionalResult.GetCost() << std::endl;
+
+  if (bidirectionalResult.GetBackwardExpandedNodes()==0 ||
+      std::abs(bidirectionalLength.AsMeter()-length.AsMeter())>length.AsMeter()*0.05) {
+    std::cerr << "Bidirectional route differs from unidirectional route" << std::endl;
+    return 1;
+  }
+
+  if (std::abs(bidirectionalResult.GetCost()-routingResult.GetCost())>routingResult.GetCost()*1e-9) {
+    std::cerr << "Bidirectional route is not as cheap as the unidirectional route" << std::endl;
+    return 1;
+  }
+
   std::cout << "Closing RoutingServices and databases..." << std::endl;
 
   router->Close();
@@ -0,0 +1,261 @@
+/*
+  ParallelImport - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/db/LocationIndex.h>
+
+#include <osmscoutimport/Import.h>
+#include <osmscoutimport/ImportErrorReporter.h>
+#include <osmscoutimport/ImportProgress.h>
+#include <osmscoutimport/ParallelProcessing.h>
+
+#include <osmscout-test/PreprocessSynthetic.h>
+
+/**
+ * Imports a synthetic map with valid and broken multipolygon relations using one and
+ * multiple threads and checks that the parallel import steps (relation areas and
+ * the region assignment of the location index) write the same data and report the
+ * same errors in both cases.
+ */
+
+//! Temporary file of the relation areas, written by the RelAreaDataGenerator
+static const char* const RELAREA_TMP="relarea.tmp";
+
+/**
+ * Collects the warnings and errors regarding relations
+ */
+class RecordingImportProgress : public osmscout::ImportProgress
+{
+public:
+  std::vector<std::string> messages;
+
+private:
+  void Record(const std::string& text)
+  {
+    if (text.find("relation")!=std::string::npos) {
+      messages.push_back(text);
+    }
+  }
+
+public:
+  void SetStep(const std::string& /*step*/) override
+  {
+    // no code
+  }
+
+  void SetProgress(double /*current*/, double /*total*/, const std::string& /*label*/) override
+  {
+    // no code
+  }
+
+  void SetAction(const std::string& /*action*/) override
+  {
+    // no code
+  }
+
+  void Debug(const std::string& /*text*/) override
+  {
+    // no code
+  }
+
+  void Info(const std::string& /*text*/) override
+  {
+    // no code
+  }
+
+  void Warning(const std::string& text) override
+  {
+    Record(text);
+  }
+
+  void Error(const std::string& text) override
+  {
+    Record(text);
+  }
+};
+
+class PreprocessorFactory : public osmscout::PreprocessorFactory
+{
+private:
+  osmscout::test::SyntheticMapParameter mapParameter;
+
+public:
+  explicit PreprocessorFactory(const osmscout::test::SyntheticMapParameter& mapParameter)
+  : mapParameter(mapParameter)
+  {
+    // no code
+  }
+
+  std::unique_ptr<osmscout::Preprocessor> GetProcessor(const std::string& /*filename*/,
+                                                       osmscout::PreprocessorCallback& callback) const override
+  {
+    return std::make_unique<osmscout::test::PreprocessSynthetic>(callback,mapParameter);
+  }
+};
+
+static bool ImportMap(const std::string& typefile,
+                      const std::string& directory,
+                      const osmscout::test::SyntheticMapParameter& mapParameter,
+                      size_t threadCount,
+                      RecordingImportProgress& progress)
+{
+  osmscout::ImportParameter importParameter;
+  std::error_code           error;
+
+  std::filesystem::create_directories(directory,error);
+
+  if (error) {
+    std::cerr << "Cannot create directory '" << directory << "': " << error.message() << std::endl;
+    return false;
+  }
+
+  importParameter.SetTypefile(typefile);
+  importParameter.SetMapfiles({osmscout::AppendFileToDir(directory,"synthetic.map")});
+  importParameter.SetDestinationDirectory(directory);
+  importParameter.SetPreprocessorFactory(std::make_shared<PreprocessorFactory>(mapParameter));
+  importParameter.SetProcessingThreadCount(threadCount);
+
+  try {
+    osmscout::Importer importer(importParameter);
+
+    if (!importer.Import(progress)) {
+      std::cerr << "Import of synthetic map failed" << std::endl;
+      return false;
+    }
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Import of synthetic map failed: " << e.GetDescription() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+static std::string ReadFile(const std::string& filename)
+{
+  std::ifstream file(filename,std::ios::binary);
+
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+static uint32_t GetRelationAreaCount(const std::string& directory)
+{
+  osmscout::FileScanner scanner;
+
+  scanner.Open(osmscout::AppendFileToDir(directory,RELAREA_TMP),
+               osmscout::FileScanner::Sequential,
+               false);
+
+  uint32_t count=scanner.ReadUInt32();
+
+  scanner.Close();
+
+  return count;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc!=3) {
+    std::cerr << "ParallelImport <typefile> <destination directory>" << std::endl;
+    return 1;
+  }
+
+  std::string                           typefile=argv[1];
+  std::string                           destinationDirectory=argv[2];
+  osmscout::test::SyntheticMapParameter mapParameter;
+  RecordingImportProgress               singleProgress;
+  RecordingImportProgress               parallelProgress;
+  std::string                           singleDirectory=osmscout::AppendFileToDir(destinationDirectory,"single");
+  std::string                           parallelDirectory=osmscout::AppendFileToDir(destinationDirectory,"parallel");
+  int                                   failures=0;
+
+  mapParameter.gridSize=8;
+  mapParameter.multipolygons=true;
+
+  if (!ImportMap(typefile,singleDirectory,mapParameter,1,singleProgress)) {
+    return 1;
+  }
+
+  if (!ImportMap(typefile,parallelDirectory,mapParameter,4,parallelProgress)) {
+    return 1;
+  }
+
+  try {
+    // Every second of the multipolygons cannot be assembled
+    uint32_t areaCount=GetRelationAreaCount(singleDirectory);
+
+    std::cout << "Relation areas: " << areaCount << std::endl;
+
+    if (areaCount!=mapParameter.gridSize/2) {
+      std::cerr << "Expected " << mapParameter.gridSize/2 << " relation areas" << std::endl;
+      failures++;
+    }
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Cannot read relation areas: " << e.GetDescription() << std::endl;
+    failures++;
+  }
+
+  // Relation ids start at 1, the broken relations are the ones with an even id
+  for (size_t id=2; id<=mapParameter.gridSize; id+=2) {
+    bool reported=false;
+
+    for (const auto& message : singleProgress.messages) {
+      if (message.find("relation "+std::to_string(id)+" ")!=std::string::npos) {
+        reported=true;
+      }
+    }
+
+    if (!reported) {
+      std::cerr << "Broken relation " << id << " is not reported" << std::endl;
+      failures++;
+    }
+  }
+
+  if (singleProgress.messages!=parallelProgress.messages) {
+    std::cerr << "Relation errors differ between single and multi threaded import" << std::endl;
+    failures++;
+  }
+
+  for (const auto& file : {RELAREA_TMP,
+                           osmscout::ImportErrorReporter::FILENAME_RELATION_HTML,
+                           "areas.dat",
+                           osmscout::LocationIndex::FILENAME_LOCATION_IDX}) {
+    std::string singleData=ReadFile(osmscout::AppendFileToDir(singleDirectory,file));
+
+    if (singleData.empty() ||
+        singleData!=ReadFile(osmscout::AppendFileToDir(parallelDirectory,file))) {
+      std::cerr << "File '" << file << "' differs between single and multi threaded import" << std::endl;
+      failures++;
+    }
+  }
+
+  return failures;
+}
@@ -0,0 +1,222 @@
+/*
+  PreparedPolygonTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/PackedRTree.h>
+#include <osmscout/util/PreparedPolygon.h>
+
+#include <TestMain.h>
+
+static std::vector<osmscout::GeoCoord> CreateStar(size_t count)
+{
+  std::vector<osmscout::GeoCoord> nodes;
+
+  for (size_t i=0; i<count; i++) {
+    double angle=2*M_PI*double(i)/double(count);
+    double radius=i%2==0 ? 1.0 : 0.4;
+
+    // Round to a grid, so that some nodes share their latitude
+    nodes.emplace_back(50.0+std::round(radius*std::sin(angle)*100.0)/100.0,
+                       10.0+std::round(radius*std::cos(angle)*100.0)/100.0);
+  }
+
+  return nodes;
+}
+
+TEST_CASE("Prepared polygon matches GetRelationOfPointToArea")
+{
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> latDistribution(48.8,51.2);
+  std::uniform_real_distribution<double> lonDistribution(8.8,11.2);
+
+  for (size_t count : {3,4,10,64,1000}) {
+    std::vector<osmscout::GeoCoord> nodes=CreateStar(count);
+    osmscout::PreparedPolygon       polygon(nodes);
+
+    for (size_t i=0; i<10000; i++) {
+      osmscout::GeoCoord point(latDistribution(generator),
+                               lonDistribution(generator));
+
+      REQUIRE(polygon.GetRelationOfPoint(point)==osmscout::GetRelationOfPointToArea(point,nodes));
+    }
+
+    // Points on the grid hit nodes and node latitudes exactly
+    for (double lat=48.9; lat<=51.1; lat+=0.01) {
+      for (double lon=8.9; lon<=11.1; lon+=0.05) {
+        osmscout::GeoCoord point(std::round(lat*100.0)/100.0,
+                                 std::round(lon*100.0)/100.0);
+
+        REQUIRE(polygon.GetRelationOfPoint(point)==osmscout::GetRelationOfPointToArea(point,nodes));
+      }
+    }
+
+    for (const auto& node : nodes) {
+      REQUIRE(polygon.GetRelationOfPoint(node)==0);
+    }
+  }
+}
+
+TEST_CASE("Prepared polygon area tests match the generic functions")
+{
+  std::vector<osmscout::GeoCoord> nodes=CreateStar(100);
+  osmscout::PreparedPolygon       polygon(nodes);
+
+  std::vector<osmscout::GeoCoord> inner={osmscout::GeoCoord(50.0,10.0),
+                                         osmscout::GeoCoord(50.1,10.0),
+                                         osmscout::GeoCoord(50.1,10.1)};
+  std::vector<osmscout::GeoCoord> crossing={osmscout::GeoCoord(50.0,10.0),
+                                            osmscout::GeoCoord(50.0,12.0),
+                                            osmscout::GeoCoord(50.1,12.0)};
+  std::vector<osmscout::GeoCoord> outer={osmscout::GeoCoord(52.0,12.0),
+                                         osmscout::GeoCoord(52.0,13.0),
+                                         osmscout::GeoCoord(53.0,13.0)};
+
+  for (const auto& area : {inner,crossing,outer}) {
+    REQUIRE(polygon.ContainsCompletely(area)==osmscout::IsAreaCompletelyInArea(area,nodes));
+    REQUIRE(polygon.ContainsAtLeastPartly(area,osmscout::GetBoundingBox(area))==osmscout::IsAreaAtLeastPartlyInArea(area,nodes));
+  }
+
+  REQUIRE(polygon.ContainsCompletely(inner));
+  REQUIRE(polygon.ContainsAtLeastPartly(crossing,osmscout::GetBoundingBox(crossing)));
+  REQUIRE(!polygon.ContainsCompletely(crossing));
+  REQUIRE(!polygon.ContainsAtLeastPartly(outer,osmscout::GetBoundingBox(outer)));
+}
+
+TEST_CASE("Packed R-tree queries match a linear search")
+{
+  std::mt19937                           generator(4711);
+  std::uniform_real_distribution<double> latDistribution(-80.0,80.0);
+  std::uniform_real_distribution<double> lonDistribution(-170.0,170.0);
+  std::uniform_real_distribution<double> sizeDistribution(0.0,10.0);
+  std::vector<osmscout::GeoBox>          boxes;
+
+  for (size_t i=0; i<2000; i++) {
+    osmscout::GeoCoord corner(latDistribution(generator),
+                              lonDistribution(generator));
+
+    boxes.emplace_back(corner,
+                       osmscout::GeoCoord(corner.GetLat()+sizeDistribution(generator),
+                                          corner.GetLon()+sizeDistribution(generator)));
+  }
+
+  osmscout::PackedRTree tree;
+
+  tree.Build(boxes);
+
+  REQUIRE(tree.GetSize()==boxes.size());
+
+  for (size_t i=0; i<1000; i++) {
+    osmscout::GeoCoord  coord(latDistribution(generator),
+                              lonDistribution(generator));
+    osmscout::GeoBox    queryBox(coord,
+                                 osmscout::GeoCoord(coord.GetLat()+sizeDistribution(generator),
+                                                    coord.GetLon()+sizeDistribution(generator)));
+    std::vector<size_t> expectedCoord;
+    std::vector<size_t> expectedBox;
+    std::vector<size_t> actualCoord;
+    std::vector<size_t> actualBox;
+
+    for (size_t b=0; b<boxes.size(); b++) {
+      if (boxes[b].Includes(coord,/*openInterval*/ false)) {
+        expectedCoord.push_back(b);
+      }
+      if (boxes[b].Intersects(queryBox,/*openInterval*/ false)) {
+        expectedBox.push_back(b);
+      }
+    }
+
+    tree.Query(coord,actualCoord);
+    tree.Query(queryBox,actualBox);
+
+    std::sort(actualCoord.begin(),actualCoord.end());
+    std::sort(actualBox.begin(),actualBox.end());
+
+    REQUIRE(actualCoord==expectedCoord);
+    REQUIRE(actualBox==expectedBox);
+  }
+}
+
+TEST_CASE("Packed R-tree handles empty trees, deep trees and touching boxes")
+{
+  osmscout::PackedRTree emptyTree;
+  std::vector<size_t>   items;
+
+  emptyTree.Build({});
+
+  REQUIRE(emptyTree.GetSize()==0);
+
+  emptyTree.Query(osmscout::GeoCoord(1.0,1.0),items);
+  emptyTree.Query(osmscout::GeoBox(osmscout::GeoCoord(0.0,0.0),
+                                   osmscout::GeoCoord(2.0,2.0)),
+                  items);
+
+  REQUIRE(items.empty());
+
+  // A grid of boxes sharing their borders, each followed by a point box at its south west corner
+  std::vector<osmscout::GeoBox> boxes;
+
+  for (size_t row=0; row<20; row++) {
+    for (size_t column=0; column<20; column++) {
+      osmscout::GeoCoord corner(row*1.0,column*1.0);
+
+      boxes.emplace_back(corner,
+                         osmscout::GeoCoord(corner.GetLat()+1.0,
+                                            corner.GetLon()+1.0));
+      boxes.emplace_back(corner,corner);
+    }
+  }
+
+  for (size_t nodeCapacity : {2,3,16}) {
+    osmscout::PackedRTree tree(nodeCapacity);
+
+    tree.Build(boxes);
+
+    REQUIRE(tree.GetSize()==boxes.size());
+
+    for (double lat=-0.5; lat<=20.5; lat+=0.5) {
+      for (double lon=-0.5; lon<=20.5; lon+=0.5) {
+        osmscout::GeoCoord  coord(lat,lon);
+        osmscout::GeoBox    queryBox(coord,coord);
+        std::vector<size_t> expected;
+        std::vector<size_t> actualCoord;
+        std::vector<size_t> actualBox;
+
+        for (size_t b=0; b<boxes.size(); b++) {
+          if (boxes[b].Includes(coord,/*openInterval*/ false)) {
+            expected.push_back(b);
+          }
+        }
+
+        tree.Query(coord,actualCoord);
+        tree.Query(queryBox,actualBox);
+
+        std::sort(actualCoord.begin(),actualCoord.end());
+        std::sort(actualBox.begin(),actualBox.end());
+
+        REQUIRE(actualCoord==expected);
+        REQUIRE(actualBox==expected);
+      }
+    }
+  }
+}
@@ -0,0 +1,165 @@
+#include <osmscout/navigation/DataAgent.h>
+
+#include <TestMain.h>
+
+namespace {
+  osmscout::WayRef CreateWay(const std::vector<osmscout::GeoCoord>& coords)
+  {
+    auto way=std::make_shared<osmscout::Way>();
+
+    for (const auto& coord : coords) {
+      way->nodes.emplace_back(0,coord);
+    }
+
+    return way;
+  }
+}
+
+TEST_CASE("Find nearest way segment") {
+  osmscout::RoutableObjects objects;
+  auto&                     dbObjects=objects.dbMap[0];
+
+  // grid of parallel horizontal ways, ~110 m apart
+  for (size_t i=0; i<20; i++) {
+    std::vector<osmscout::GeoCoord> coords;
+    for (size_t j=0; j<50; j++) {
+      coords.emplace_back(50.0+static_cast<double>(i)*0.001,
+                          14.0+static_cast<double>(j)*0.0005);
+    }
+    dbObjects.ways[i+1]=CreateWay(coords);
+  }
+
+  objects.BuildIndex();
+
+  REQUIRE(objects.segmentIndex.IsBuilt());
+  REQUIRE(objects.segmentIndex.GetSegmentCount()>=20*49);
+
+  osmscout::RoutableSegmentIndex::NearestObject nearest;
+
+  REQUIRE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.00505,14.0101),
+                                           osmscout::Meters(30),
+                                           nearest));
+  REQUIRE(nearest.way);
+  REQUIRE(nearest.way==dbObjects.ways[6]);
+  REQUIRE(nearest.coord.GetLat()==Approx(50.005));
+  REQUIRE(nearest.coord.GetLon()==Approx(14.0101));
+
+  // Between two ways, but too far from both
+  REQUIRE_FALSE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.0055,14.0101),
+                                                 osmscout::Meters(30),
+                                                 nearest));
+
+  // Outside of all objects
+  REQUIRE_FALSE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(51.0,15.0),
+                                                 osmscout::Meters(30),
+                                                 nearest));
+}
+
+TEST_CASE("Coordinate inside of routable area") {
+  osmscout::RoutableObjects objects;
+  auto&                     dbObjects=objects.dbMap[1];
+  auto                      area=std::make_shared<osmscout::Area>();
+  osmscout::Area::Ring      outer;
+  osmscout::Area::Ring      inner;
+
+  outer.MarkAsOuterRing();
+  outer.nodes={osmscout::Point(0,osmscout::GeoCoord(50.0,14.0)),
+               osmscout::Point(0,osmscout::GeoCoord(50.0,14.01)),
+               osmscout::Point(0,osmscout::GeoCoord(50.01,14.01)),
+               osmscout::Point(0,osmscout::GeoCoord(50.01,14.0))};
+  inner.SetRing(2);
+  inner.nodes={osmscout::Point(0,osmscout::GeoCoord(50.004,14.004)),
+               osmscout::Point(0,osmscout::GeoCoord(50.004,14.006)),
+               osmscout::Point(0,osmscout::GeoCoord(50.006,14.006)),
+               osmscout::Point(0,osmscout::GeoCoord(50.006,14.004))};
+  area->rings.push_back(outer);
+  area->rings.push_back(inner);
+  dbObjects.areas[1]=area;
+
+  objects.BuildIndex();
+
+  osmscout::RoutableSegmentIndex::NearestObject nearest;
+
+  REQUIRE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.002,14.002),
+                                           osmscout::Meters(30),
+                                           nearest));
+  REQUIRE(nearest.area==area);
+  REQUIRE(nearest.databaseId==1);
+  REQUIRE(nearest.distance==0.0);
+
+  // inside of the hole, but too far from any ring
+  REQUIRE_FALSE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.005,14.005),
+                                                 osmscout::Meters(30),
+                                                 nearest));
+}
+
+TEST_CASE("Area rings without nodes are skipped") {
+  osmscout::RoutableObjects objects;
+  auto&                     dbObjects=objects.dbMap[1];
+  auto                      area=std::make_shared<osmscout::Area>();
+  osmscout::Area::Ring      outer;
+  osmscout::Area::Ring      empty;
+
+  outer.MarkAsOuterRing();
+  outer.nodes={osmscout::Point(0,osmscout::GeoCoord(50.0,14.0)),
+               osmscout::Point(0,osmscout::GeoCoord(50.0,14.01)),
+               osmscout::Point(0,osmscout::GeoCoord(50.01,14.01)),
+               osmscout::Point(0,osmscout::GeoCoord(50.01,14.0))};
+  empty.SetRing(2);
+  area->rings.push_back(empty);
+  area->rings.push_back(outer);
+  dbObjects.areas[1]=area;
+
+  objects.BuildIndex();
+
+  osmscout::RoutableSegmentIndex::NearestObject nearest;
+
+  REQUIRE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.005,14.005),
+                                           osmscout::Meters(30),
+                                           nearest));
+  REQUIRE(nearest.area==area);
+  REQUIRE(nearest.distance==0.0);
+}
+
+TEST_CASE("Coordinate inside one of many routable areas") {
+  osmscout::RoutableObjects objects;
+  auto&                     dbObjects=objects.dbMap[1];
+
+  // 10x10 squares of ~70 m, ~1 km apart
+  for (size_t i=0; i<10; i++) {
+    for (size_t j=0; j<10; j++) {
+      auto                 area=std::make_shared<osmscout::Area>();
+      osmscout::Area::Ring outer;
+      double               lat=50.0+static_cast<double>(i)*0.01;
+      double               lon=14.0+static_cast<double>(j)*0.01;
+
+      outer.MarkAsOuterRing();
+      outer.nodes={osmscout::Point(0,osmscout::GeoCoord(lat,lon)),
+                   osmscout::Point(0,osmscout::GeoCoord(lat,lon+0.001)),
+                   osmscout::Point(0,osmscout::GeoCoord(lat+0.001,lon+0.001)),
+                   osmscout::Point(0,osmscout::GeoCoord(lat+0.001,lon))};
+      area->rings.push_back(outer);
+      dbObjects.areas[i*10+j+1]=area;
+    }
+  }
+
+  objects.BuildIndex();
+
+  osmscout::RoutableSegmentIndex::NearestObject nearest;
+
+  for (size_t i=0; i<10; i++) {
+    for (size_t j=0; j<10; j++) {
+      REQUIRE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.0005+static_cast<double>(i)*0.01,
+                                                                  14.0005+static_cast<double>(j)*0.01),
+                                               osmscout::Meters(10),
+                                               nearest));
+      REQUIRE(nearest.area==dbObjects.areas[i*10+j+1]);
+      REQUIRE(nearest.distance==0.0);
+    }
+  }
+
+  // Between the areas
+  REQUIRE_FALSE(objects.segmentIndex.FindNearest(osmscout::GeoCoord(50.005,14.005),
+                                                 osmscout::Meters(10),
+                                                 nearest));
+}
@@ -0,0 +1,779 @@
+/*
+  SyntheticMapBenchmark - a benchmark program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/location/LocationService.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscoutimport/Import.h>
+#include <osmscoutimport/ImportProgress.h>
+
+#include <osmscoutmap/MapPainterNoOp.h>
+#include <osmscoutmap/MapService.h>
+
+#include <osmscout-test/PreprocessSynthetic.h>
+
+/*
+  Generates a synthetic city using the importer and measures the main
+  code paths of the library against it. Results are written as JSON and
+  can be compared against a baseline using BenchmarkCompare:
+
+  SyntheticMapBenchmark --typefile stylesheets/map.ost --style stylesheets/standard.oss --destination /tmp/synthetic --output current.json
+  BenchmarkCompare baseline.json current.json
+*/
+
+struct Arguments
+{
+  bool        help=false;
+  bool        verbose=false;
+  bool        skipImport=false;
+  std::string typefile;
+  std::string stylesheet;
+  std::string destinationDirectory=".";
+  std::string output="benchmark.json";
+  size_t      iterations=10;
+  size_t      warmup=1;
+  osmscout::test::SyntheticMapParameter mapParameter;
+};
+
+struct ScenarioResult
+{
+  std::string         name;
+  std::string         description;
+  std::vector<double> samples; //!< Duration of each iteration in microseconds
+
+  double GetMean() const
+  {
+    return std::accumulate(samples.begin(),samples.end(),0.0)/samples.size();
+  }
+
+  double GetStdDev() const
+  {
+    if (samples.size()<2) {
+      return 0.0;
+    }
+
+    double mean=GetMean();
+    double sum=0.0;
+
+    for (double sample : samples) {
+      sum+=(sample-mean)*(sample-mean);
+    }
+
+    return std::sqrt(sum/(samples.size()-1));
+  }
+
+  /**
+   * Percentile using linear interpolation between the closest ranks
+   */
+  double GetPercentile(double percentile) const
+  {
+    std::vector<double> sorted(samples);
+
+    std::sort(sorted.begin(),sorted.end());
+
+    double rank=percentile/100.0*(sorted.size()-1);
+    auto   lower=static_cast<size_t>(std::floor(rank));
+    size_t upper=std::min(lower+1,sorted.size()-1);
+
+    return sorted[lower]+(rank-lower)*(sorted[upper]-sorted[lower]);
+  }
+};
+
+class BenchmarkImportProgress : public osmscout::ImportProgress
+{
+private:
+  bool verbose;
+
+public:
+  explicit BenchmarkImportProgress(bool verbose)
+  : verbose(verbose)
+  {
+    // no code
+  }
+
+  void SetProgress(double current, double total, const std::string& label) override
+  {
+    if (verbose) {
+      ImportProgress::SetProgress(current,total,label);
+    }
+  }
+
+  void SetAction(const std::string& action) override
+  {
+    if (verbose) {
+      ImportProgress::SetAction(action);
+    }
+  }
+
+  void Debug(const std::string& text) override
+  {
+    if (verbose) {
+      ImportProgress::Debug(text);
+    }
+  }
+
+  void Info(const std::string& text) override
+  {
+    if (verbose) {
+      ImportProgress::Info(text);
+    }
+  }
+};
+
+class PreprocessorFactory : public osmscout::PreprocessorFactory
+{
+private:
+  osmscout::test::SyntheticMapParameter mapParameter;
+
+public:
+  explicit PreprocessorFactory(const osmscout::test::SyntheticMapParameter& mapParameter)
+  : mapParameter(mapParameter)
+  {
+    // no code
+  }
+
+  std::unique_ptr<osmscout::Preprocessor> GetProcessor(const std::string& /*filename*/,
+                                                       osmscout::PreprocessorCallback& callback) const override
+  {
+    return std::make_unique<osmscout::test::PreprocessSynthetic>(callback,mapParameter);
+  }
+};
+
+static std::string EscapeJson(const std::string& text)
+{
+  std::string result;
+
+  for (char c : text) {
+    if (c=='"' || c=='\\') {
+      result+='\\';
+    }
+
+    result+=c;
+  }
+
+  return result;
+}
+
+static bool ImportSyntheticMap(const Arguments& args,
+                               ScenarioResult& result)
+{
+  osmscout::ImportParameter importParameter;
+  BenchmarkImportProgress   progress(args.verbose);
+  std::error_code           error;
+
+  std::filesystem::create_directories(args.destinationDirectory,error);
+
+  if (error) {
+    std::cerr << "Cannot create directory '" << args.destinationDirectory << "': " << error.message() << std::endl;
+    return false;
+  }
+
+  importParameter.SetTypefile(args.typefile);
+  importParameter.SetMapfiles({osmscout::AppendFileToDir(args.destinationDirectory,"synthetic.map")});
+  importParameter.SetDestinationDirectory(args.destinationDirectory);
+  importParameter.SetPreprocessorFactory(std::make_shared<PreprocessorFactory>(args.mapParameter));
+  importParameter.AddRouter(osmscout::ImportParameter::Router(osmscout::vehicleFoot|osmscout::vehicleBicycle|osmscout::vehicleCar,
+                                                              osmscout::RoutingService::DEFAULT_FILENAME_BASE));
+
+  try {
+    osmscout::Importer importer(importParameter);
+    auto               start=std::chrono::steady_clock::now();
+
+    if (!importer.Import(progress)) {
+      std::cerr << "Import of synthetic map failed" << std::endl;
+      return false;
+    }
+
+    result.samples.push_back(std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now()-start).count());
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Import of synthetic map failed: " << e.GetDescription() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Runs the scenario the given number of warmup and measured iterations. Each iteration
+ * must return true, else the benchmark is aborted.
+ */
+static bool RunScenario(const Arguments& args,
+                        const std::string& name,
+                        const std::string& description,
+                        const std::function<bool()>& iteration,
+                        std::list<ScenarioResult>& results)
+{
+  ScenarioResult result;
+
+  result.name=name;
+  result.description=description;
+
+  std::cout << "Running '" << name << "'..." << std::flush;
+
+  for (size_t i=0; i<args.warmup; i++) {
+    if (!iteration()) {
+      std::cout << std::endl;
+      std::cerr << "Scenario '" << name << "' failed" << std::endl;
+      return false;
+    }
+  }
+
+  for (size_t i=0; i<args.iterations; i++) {
+    auto start=std::chrono::steady_clock::now();
+
+    if (!iteration()) {
+      std::cout << std::endl;
+      std::cerr << "Scenario '" << name << "' failed" << std::endl;
+      return false;
+    }
+
+    result.samples.push_back(std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now()-start).count());
+  }
+
+  std::cout << " median " << std::fixed << std::setprecision(1) << result.GetPercentile(50.0) << " us" << std::endl;
+
+  results.push_back(std::move(result));
+
+  return true;
+}
+
+static void GetCarSpeedTable(std::map<std::string,double>& map)
+{
+  map["highway_motorway"]=110.0;
+  map["highway_motorway_trunk"]=100.0;
+  map["highway_motorway_primary"]=70.0;
+  map["highway_motorway_link"]=60.0;
+  map["highway_motorway_junction"]=60.0;
+  map["highway_trunk"]=100.0;
+  map["highway_trunk_link"]=60.0;
+  map["highway_primary"]=70.0;
+  map["highway_primary_link"]=60.0;
+  map["highway_secondary"]=60.0;
+  map["highway_secondary_link"]=50.0;
+  map["highway_tertiary"]=55.0;
+  map["highway_tertiary_link"]=55.0;
+  map["highway_unclassified"]=50.0;
+  map["highway_road"]=50.0;
+  map["highway_residential"]=20.0;
+  map["highway_roundabout"]=40.0;
+  map["highway_living_street"]=10.0;
+  map["highway_service"]=30.0;
+}
+
+template<class O>
+static bool ScanDataFile(const osmscout::TypeConfig& typeConfig,
+                         const std::string& filename)
+{
+  osmscout::FileScanner scanner;
+
+  try {
+    scanner.Open(filename,osmscout::FileScanner::Sequential,true);
+
+    uint32_t count=scanner.ReadUInt32();
+
+    for (uint32_t i=0; i<count; i++) {
+      O object;
+
+      object.Read(typeConfig,
+                  scanner);
+    }
+
+    scanner.Close();
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    scanner.CloseFailsafe();
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Query boxes of 2x2 blocks, covering the whole map
+ */
+static std::vector<osmscout::GeoBox> GetQueryBoxes(const osmscout::test::SyntheticMapParameter& mapParameter)
+{
+  std::vector<osmscout::GeoBox> boxes;
+  osmscout::GeoBox              box=mapParameter.GetBoundingBox();
+  size_t                        count=std::max<size_t>(mapParameter.gridSize/2,1);
+
+  for (size_t row=0; row<count; row++) {
+    for (size_t column=0; column<count; column++) {
+      boxes.emplace_back(osmscout::GeoCoord(box.GetMinLat()+row*box.GetHeight()/count,
+                                            box.GetMinLon()+column*box.GetWidth()/count),
+                         osmscout::GeoCoord(box.GetMinLat()+(row+1)*box.GetHeight()/count,
+                                            box.GetMinLon()+(column+1)*box.GetWidth()/count));
+    }
+  }
+
+  return boxes;
+}
+
+static std::vector<osmscout::MercatorProjection> GetViewports(const osmscout::test::SyntheticMapParameter& mapParameter)
+{
+  std::vector<osmscout::MercatorProjection> projections;
+  osmscout::GeoBox                          box=mapParameter.GetBoundingBox();
+  std::vector<std::pair<osmscout::GeoCoord,osmscout::MagnificationLevel>> viewports={
+    {box.GetCenter(),osmscout::Magnification::magCity},
+    {box.GetCenter(),osmscout::Magnification::magSuburb},
+    {osmscout::GeoCoord(box.GetMinLat()+box.GetHeight()/4,box.GetMinLon()+box.GetWidth()/4),osmscout::Magnification::magDetail},
+    {osmscout::GeoCoord(box.GetMaxLat()-box.GetHeight()/4,box.GetMaxLon()-box.GetWidth()/4),osmscout::Magnification::magClose}
+  };
+
+  for (const auto& [center,level] : viewports) {
+    osmscout::MercatorProjection projection;
+
+    projection.Set(center,
+                   osmscout::Magnification(level),
+                   96.0,
+                   800,
+                   600);
+
+    projections.push_back(projection);
+  }
+
+  return projections;
+}
+
+static bool WriteResults(const Arguments& args,
+                         const std::list<ScenarioResult>& results)
+{
+  std::ofstream stream(args.output);
+
+  if (!stream) {
+    std::cerr << "Cannot open '" << args.output << "' for writing" << std::endl;
+    return false;
+  }
+
+  stream.imbue(std::locale::classic());
+  stream << std::fixed << std::setprecision(3);
+
+  stream << "{" << std::endl;
+  stream << "  \"benchmark\": \"SyntheticMapBenchmark\"," << std::endl;
+  stream << "  \"parameter\": {" << std::endl;
+  stream << "    \"seed\": " << args.mapParameter.seed << "," << std::endl;
+  stream << "    \"gridSize\": " << args.mapParameter.gridSize << "," << std::endl;
+  stream << "    \"iterations\": " << args.iterations << "," << std::endl;
+  stream << "    \"warmup\": " << args.warmup << std::endl;
+  stream << "  }," << std::endl;
+  stream << "  \"scenarios\": [" << std::endl;
+
+  for (auto result=results.begin(); result!=results.end(); ++result) {
+    stream << "    {" << std::endl;
+    stream << "      \"name\": \"" << EscapeJson(result->name) << "\"," << std::endl;
+    stream << "      \"description\": \"" << EscapeJson(result->description) << "\"," << std::endl;
+    stream << "      \"unit\": \"us\"," << std::endl;
+    stream << "      \"count\": " << result->samples.size() << "," << std::endl;
+    stream << "      \"min\": " << result->GetPercentile(0.0) << "," << std::endl;
+    stream << "      \"max\": " << result->GetPercentile(100.0) << "," << std::endl;
+    stream << "      \"mean\": " << result->GetMean() << "," << std::endl;
+    stream << "      \"median\": " << result->GetPercentile(50.0) << "," << std::endl;
+    stream << "      \"p95\": " << result->GetPercentile(95.0) << "," << std::endl;
+    stream << "      \"stddev\": " << result->GetStdDev() << "," << std::endl;
+    stream << "      \"samples\": [";
+
+    for (auto sample=result->samples.begin(); sample!=result->samples.end(); ++sample) {
+      if (sample!=result->samples.begin()) {
+        stream << ", ";
+      }
+
+      stream << *sample;
+    }
+
+    stream << "]" << std::endl;
+    stream << "    }" << (std::next(result)!=results.end() ? "," : "") << std::endl;
+  }
+
+  stream << "  ]" << std::endl;
+  stream << "}" << std::endl;
+
+  return static_cast<bool>(stream);
+}
+
+int main(int argc, char* argv[])
+{
+  osmscout::CmdLineParser  argParser("SyntheticMapBenchmark",
+                                     argc,argv);
+  std::vector<std::string> helpArgs{"h","help"};
+  Arguments                args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      helpArgs,
+                      "Return argument help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.verbose=value;
+                      }),
+                      "verbose",
+                      "Print import progress");
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.skipImport=value;
+                      }),
+                      "skip-import",
+                      "Reuse the database already imported to the destination directory");
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.typefile=value;
+                      }),
+                      "typefile",
+                      "Type definition file (map.ost)");
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.stylesheet=value;
+                      }),
+                      "style",
+                      "Style sheet used for loading and rendering");
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.destinationDirectory=value;
+                      }),
+                      "destination",
+                      "Directory the synthetic database is imported to");
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.output=value;
+                      }),
+                      "output",
+                      "JSON file the results are written to");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.iterations=value;
+                      }),
+                      "iterations",
+                      "Number of measured iterations per scenario (default: 10)");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.warmup=value;
+                      }),
+                      "warmup",
+                      "Number of unmeasured iterations per scenario (default: 1)");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.mapParameter.gridSize=value;
+                      }),
+                      "grid-size",
+                      "Number of blocks of the synthetic city in each direction (default: 16)");
+
+  argParser.AddOption(osmscout::CmdLineULongOption([&args](const unsigned long& value) {
+                        args.mapParameter.seed=value;
+                      }),
+                      "seed",
+                      "Seed of the synthetic map generator (default: 1)");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  if ((!args.skipImport && args.typefile.empty()) ||
+      args.stylesheet.empty() ||
+      args.iterations==0) {
+    std::cerr << "ERROR: Type file, style sheet and a non-zero number of iterations are required" << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+
+  std::list<ScenarioResult> results;
+
+  if (!args.skipImport) {
+    ScenarioResult importResult;
+
+    importResult.name="import";
+    importResult.description="Import of the synthetic map (single run)";
+
+    std::cout << "Importing synthetic map to '" << args.destinationDirectory << "'..." << std::endl;
+
+    if (!ImportSyntheticMap(args,importResult)) {
+      return 1;
+    }
+
+    results.push_back(std::move(importResult));
+  }
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!RunScenario(args,
+                   "database.open",
+                   "Open and close the database",
+                   [&]() {
+                     if (!database->Open(args.destinationDirectory)) {
+                       return false;
+                     }
+
+                     database->Close();
+
+                     return true;
+                   },
+                   results)) {
+    return 1;
+  }
+
+  if (!database->Open(args.destinationDirectory)) {
+    std::cerr << "Cannot open database" << std::endl;
+    return 1;
+  }
+
+  osmscout::TypeConfigRef typeConfig=database->GetTypeConfig();
+
+  if (!RunScenario(args,
+                   "filescanner.decode",
+                   "Sequentially decode all nodes, ways and areas",
+                   [&]() {
+                     return ScanDataFile<osmscout::Node>(*typeConfig,osmscout::AppendFileToDir(args.destinationDirectory,osmscout::NodeDataFile::NODES_DAT)) &&
+                            ScanDataFile<osmscout::Way>(*typeConfig,osmscout::AppendFileToDir(args.destinationDirectory,osmscout::WayDataFile::WAYS_DAT)) &&
+                            ScanDataFile<osmscout::Area>(*typeConfig,osmscout::AppendFileToDir(args.destinationDirectory,osmscout::AreaDataFile::AREAS_DAT));
+                   },
+                   results)) {
+    return 1;
+  }
+
+  std::vector<osmscout::GeoBox> queryBoxes=GetQueryBoxes(args.mapParameter);
+  osmscout::TypeInfoSet         nodeTypes(typeConfig->GetNodeTypes());
+  osmscout::TypeInfoSet         wayTypes(typeConfig->GetWayTypes());
+  osmscout::TypeInfoSet         areaTypes(typeConfig->GetAreaTypes());
+
+  if (!RunScenario(args,
+                   "index.lookup",
+                   "Look up nodes, ways and areas of all types in 2x2 block boxes",
+                   [&]() {
+                     for (const auto& box : queryBoxes) {
+                       std::vector<osmscout::FileOffset>     offsets;
+                       std::vector<osmscout::DataBlockSpan> spans;
+                       osmscout::TypeInfoSet                 loadedTypes;
+
+                       if (!database->GetAreaNodeIndex()->GetOffsets(box,nodeTypes,offsets,loadedTypes) ||
+                           !database->GetAreaWayIndex()->GetOffsets(box,wayTypes,offsets,loadedTypes) ||
+                           !database->GetAreaAreaIndex()->GetAreasInArea(*typeConfig,box,std::numeric_limits<size_t>::max(),areaTypes,spans,loadedTypes)) {
+                         return false;
+                       }
+                     }
+
+                     return true;
+                   },
+                   results)) {
+    return 1;
+  }
+
+  osmscout::MapServiceRef  mapService=std::make_shared<osmscout::MapService>(database);
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(typeConfig);
+
+  if (!styleConfig->Load(args.stylesheet)) {
+    std::cerr << "Cannot open style" << std::endl;
+    return 1;
+  }
+
+  std::vector<osmscout::MercatorProjection> viewports=GetViewports(args.mapParameter);
+  std::vector<osmscout::MapData>            viewportData(viewports.size());
+  osmscout::AreaSearchParameter             searchParameter;
+
+  if (!RunScenario(args,
+                   "mapservice.load",
+                   "Load the tiles of multiple viewports with empty tile and data caches",
+                   [&]() {
+                     database->FlushCache();
+                     mapService->FlushTileCache();
+
+                     for (size_t i=0; i<viewports.size(); i++) {
+                       std::list<osmscout::TileRef> tiles;
+
+                       viewportData[i].ClearDBData();
+
+                       mapService->LookupTiles(viewports[i],tiles);
+
+                       if (!mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles)) {
+                         return false;
+                       }
+
+                       mapService->AddTileDataToMapData(tiles,viewportData[i]);
+                     }
+
+                     return true;
+                   },
+                   results)) {
+    return 1;
+  }
+
+  osmscout::MapPainterNoOp painter(styleConfig);
+  osmscout::MapParameter   drawParameter;
+
+  if (!RunScenario(args,
+                   "render.noop",
+                   "Render multiple viewports using the no-op painter",
+                   [&]() {
+                     for (size_t i=0; i<viewports.size(); i++) {
+                       if (!painter.DrawMap(viewports[i],drawParameter,viewportData[i])) {
+                         return false;
+                       }
+                     }
+
+                     return true;
+                   },
+                   results)) {
+    return 1;
+  }
+
+  for (auto& data : viewportData) {
+    data.columns.Assign(data.nodes,
+                        data.ways,
+                        data.areas);
+  }
+
+  if (!RunScenario(args,
+                   "render.noop.columns",
+                   "Render multiple viewports using the no-op painter and column oriented map data",
+                   [&]() {
+                     for (size_t i=0; i<viewports.size(); i++) {
+                       if (!painter.DrawMap(viewports[i],drawParameter,viewportData[i])) {
+                         return false;
+                       }
+                     }
+
+                     return true;
+                   },
+                   results)) {
+    return 1;
+  }
+
+  osmscout::RouterParameter              routerParameter;
+  osmscout::SimpleRoutingServiceRef      router=std::make_shared<osmscout::SimpleRoutingService>(database,
+                                                                                                 routerParameter,
+                                                                                                 osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::FastestPathRoutingProfileRef routingProfile=std::make_shared<osmscout::FastestPathRoutingProfile>(typeConfig);
+  std::map<std::string,double>           carSpeedTable;
+  osmscout::GeoBox                       mapBox=args.mapParameter.GetBoundingBox();
+
+  if (!router->Open()) {
+    std::cerr << "Cannot open routing database" << std::endl;
+    return 1;
+  }
+
+  GetCarSpeedTable(carSpeedTable);
+
+  routingProfile->ParametrizeForCar(*typeConfig,
+                                    carSpeedTable,
+                                    160.0);
+
+  auto start=router->GetClosestRoutableNode(mapBox.GetBottomLeft(),*routingProfile,osmscout::Kilometers(1));
+  auto target=router->GetClosestRoutableNode(mapBox.GetTopRight(),*routingProfile,osmscout::Kilometers(1));
+
+  if (!start.IsValid() ||
+      !target.IsValid()) {
+    std::cerr << "Cannot find routing start or target node" << std::endl;
+    return 1;
+  }
+
+  if (!RunScenario(args,
+                   "routing.car",
+                   "Route by car between opposite corners of the map",
+                   [&]() {
+                     osmscout::RoutingParameter parameter;
+
+                     return router->CalculateRoute(*routingProfile,
+                                                   start.GetRoutePosition(),
+                                                   target.GetRoutePosition(),
+                                                   std::nullopt,
+                                                   parameter).Success();
+                   },
+                   results)) {
+    return 1;
+  }
+
+  router->Close();
+
+  osmscout::LocationServiceRef locationService=std::make_shared<osmscout::LocationService>(database);
+  std::vector<std::string>     searchStrings;
+
+  for (size_t row=0; row<=args.mapParameter.gridSize; row+=std::max<size_t>(args.mapParameter.gridSize/4,1)) {
+    searchStrings.push_back(args.mapParameter.cityName+" "+args.mapParameter.GetStreetName(row));
+  }
+
+  if (!RunScenario(args,
+                   "location.search",
+                   "Search for streets by string",
+                   [&]() {
+                     for (const auto& searchString : searchStrings) {
+                       osmscout::LocationStringSearchParameter searchParameter(searchString);
+                       osmscout::LocationSearchResult          searchResult;
+
+                       if (!locationService->SearchForLocationByString(searchParameter,searchResult) ||
+                           searchResult.results.empty()) {
+                         return false;
+                       }
+                     }
+
+                     return true;
+                   },
+                   results)) {
+    return 1;
+  }
+
+  database->Close();
+
+  if (!WriteResults(args,results)) {
+    return 1;
+  }
+
+  std::cout << "Results written to '" << args.output << "'" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+  TagMapTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <string>
+#include <vector>
+
+#include <osmscout/Tag.h>
+
+#include <TestMain.h>
+
+TEST_CASE("Set replaces the value of an existing tag")
+{
+  osmscout::TagMap tags;
+
+  tags.Set(1,
+           "primary");
+  tags.Set(2,
+           "Main Street");
+  tags.Set(1,
+           "secondary");
+
+  REQUIRE(tags.size()==2);
+  REQUIRE(tags.find(1)->second=="secondary");
+  REQUIRE(tags.find(2)->second=="Main Street");
+  REQUIRE(tags.find(3)==tags.end());
+
+  REQUIRE(tags.erase(1)==1);
+  REQUIRE(tags.erase(1)==0);
+  REQUIRE_FALSE(tags.contains(1));
+  REQUIRE(tags.contains(2));
+}
+
+TEST_CASE("Set copies the value")
+{
+  osmscout::TagMap tags;
+
+  {
+    std::string value="a value that does not fit into the small string buffer";
+
+    tags.Set(1,
+             value);
+    value.assign(value.size(),
+                 'x');
+  }
+
+  REQUIRE(tags.find(1)->second=="a value that does not fit into the small string buffer");
+}
+
+TEST_CASE("Copies do not reference the values of the original")
+{
+  osmscout::TagMap copy;
+
+  {
+    osmscout::TagValuePool pool;
+    osmscout::TagMap       tags(pool.GetResource());
+
+    tags.SetView(1,
+                 pool.Intern(std::string("residential")));
+
+    copy=tags;
+  }
+
+  REQUIRE(copy.size()==1);
+  REQUIRE(copy.find(1)->second=="residential");
+}
+
+TEST_CASE("Pool stores equal values once")
+{
+  osmscout::TagValuePool pool;
+  std::string            yes="yes";
+
+  std::string_view first=pool.Intern(yes);
+  std::string_view second=pool.Intern(std::string("yes"));
+  std::string_view empty=pool.Intern("");
+
+  REQUIRE(first=="yes");
+  REQUIRE(first.data()==second.data());
+  REQUIRE(first.data()!=yes.data());
+  REQUIRE(empty.empty());
+
+  std::vector<osmscout::TagMap> objects;
+
+  for (size_t i=0; i<1000; i++) {
+    osmscout::TagMap tags(pool.GetResource());
+
+    tags.SetView(1,
+                 pool.Intern("yes"));
+    tags.SetView(2,
+                 pool.Intern(std::to_string(i%10)));
+
+    objects.push_back(std::move(tags));
+  }
+
+  REQUIRE(objects[999].find(1)->second.data()==first.data());
+  REQUIRE(objects[999].find(2)->second=="9");
+  REQUIRE(objects[9].find(2)->second.data()==objects[999].find(2)->second.data());
+}
@@ -0,0 +1,183 @@
+/*
+  TextLayoutCacheTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscoutmap/TextLayoutCache.h>
+
+#include <TestMain.h>
+
+using namespace osmscout;
+
+namespace {
+  struct TestLayout
+  {
+    std::string text;
+    double      width;
+  };
+
+  TextLayoutKey CreateKey(const std::string& text,
+                          double pixelSize=12.0)
+  {
+    TextLayoutKey key;
+
+    key.text=text;
+    key.fontName="sans-serif";
+    key.fontSize=1.0;
+    key.pixelSize=pixelSize;
+
+    return key;
+  }
+
+  std::shared_ptr<TestLayout> Get(TextLayoutCache<TestLayout>& cache,
+                                  const TextLayoutKey& key,
+                                  size_t& layoutCount)
+  {
+    return cache.GetOrCreate(key,[&key,&layoutCount]() {
+      layoutCount++;
+      return std::make_shared<TestLayout>(TestLayout{key.text,key.text.length()*key.pixelSize});
+    });
+  }
+}
+
+TEST_CASE("Identical labels are only layouted once")
+{
+  TextLayoutCache<TestLayout> cache(10);
+  size_t                      layoutCount=0;
+
+  auto first=Get(cache,CreateKey("Main Street"),layoutCount);
+  auto second=Get(cache,CreateKey("Main Street"),layoutCount);
+
+  REQUIRE(layoutCount==1);
+  REQUIRE(first==second);
+
+  TextLayoutCacheStatistics statistics=cache.GetStatistics();
+
+  REQUIRE(statistics.hits==1);
+  REQUIRE(statistics.misses==1);
+  REQUIRE(statistics.entries==1);
+  REQUIRE(statistics.GetHitRate()==Approx(0.5));
+}
+
+TEST_CASE("All layout parameter are part of the key")
+{
+  TextLayoutCache<TestLayout> cache(10);
+  size_t                      layoutCount=0;
+  TextLayoutKey               key=CreateKey("Main Street");
+
+  Get(cache,key,layoutCount);
+
+  Get(cache,CreateKey("Main Street",14.0),layoutCount);
+  REQUIRE(layoutCount==2);
+
+  key.wrapWidth=100;
+  Get(cache,key,layoutCount);
+  REQUIRE(layoutCount==3);
+
+  key.enableWrapping=true;
+  Get(cache,key,layoutCount);
+  REQUIRE(layoutCount==4);
+
+  key.contourLabel=true;
+  Get(cache,key,layoutCount);
+  REQUIRE(layoutCount==5);
+
+  key.fontName="serif";
+  Get(cache,key,layoutCount);
+  REQUIRE(layoutCount==6);
+
+  REQUIRE(cache.GetStatistics().entries==6);
+}
+
+TEST_CASE("Least recently used layouts are evicted")
+{
+  TextLayoutCache<TestLayout> cache(2);
+  size_t                      layoutCount=0;
+
+  Get(cache,CreateKey("A"),layoutCount);
+  Get(cache,CreateKey("B"),layoutCount);
+  Get(cache,CreateKey("A"),layoutCount); // A is now most recently used
+  Get(cache,CreateKey("C"),layoutCount); // evicts B
+
+  REQUIRE(layoutCount==3);
+
+  Get(cache,CreateKey("A"),layoutCount);
+  REQUIRE(layoutCount==3);
+
+  Get(cache,CreateKey("B"),layoutCount);
+  REQUIRE(layoutCount==4);
+
+  TextLayoutCacheStatistics statistics=cache.GetStatistics();
+
+  REQUIRE(statistics.entries==2);
+  REQUIRE(statistics.evictions==2);
+
+  cache.SetCapacity(1);
+  REQUIRE(cache.GetStatistics().entries==1);
+}
+
+TEST_CASE("Capacity 0 disables caching")
+{
+  TextLayoutCache<TestLayout> cache(0);
+  size_t                      layoutCount=0;
+
+  auto layout=Get(cache,CreateKey("A"),layoutCount);
+
+  Get(cache,CreateKey("A"),layoutCount);
+
+  REQUIRE(layout);
+  REQUIRE(layout->text=="A");
+  REQUIRE(layoutCount==2);
+  REQUIRE(cache.GetStatistics().entries==0);
+}
+
+TEST_CASE("Concurrent access")
+{
+  TextLayoutCache<TestLayout> cache(50);
+  std::vector<std::thread>    threads;
+  std::atomic<size_t>         errors=0;
+
+  for (size_t t=0; t<4; t++) {
+    threads.emplace_back([&cache,&errors]() {
+      size_t layoutCount=0;
+
+      for (size_t i=0; i<1000; i++) {
+        auto key=CreateKey("Street "+std::to_string(i%100));
+        auto layout=Get(cache,key,layoutCount);
+
+        if (layout->text!=key.text) {
+          errors++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  TextLayoutCacheStatistics statistics=cache.GetStatistics();
+
+  REQUIRE(errors==0);
+  REQUIRE(statistics.hits+statistics.misses==4000);
+  REQUIRE(statistics.entries==50);
+}
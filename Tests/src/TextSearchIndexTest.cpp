@@ -0,0 +1,174 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <osmscout/db/TextSearchIndex.h>
+
+#include <osmscout/util/String.h>
+
+#include <TestMain.h>
+
+namespace {
+  constexpr uint8_t offsetSizeBytes=4;
+
+  std::string BuildKey(const std::string& text,
+                       osmscout::FileOffset offset,
+                       osmscout::RefType type)
+  {
+    std::string key=osmscout::UTF8NormForLookup(text);
+
+    key.push_back(static_cast<char>(type));
+
+    // most significant byte first
+    for (size_t i=0; i<offsetSizeBytes; i++) {
+      key.push_back(static_cast<char>((offset >> ((offsetSizeBytes-1-i)*8)) & 0xff));
+    }
+
+    return key;
+  }
+
+  void WriteTrie(const std::filesystem::path& file,
+                 const std::vector<std::string>& keys)
+  {
+    marisa::Keyset keyset;
+
+    for (const auto& key : keys) {
+      keyset.push_back(key.c_str(),
+                       key.length());
+    }
+
+    std::string offsetSizeKey;
+
+    offsetSizeKey.push_back(4);
+    offsetSizeKey+=std::to_string(offsetSizeBytes);
+
+    keyset.push_back(offsetSizeKey.c_str(),
+                     offsetSizeKey.length());
+
+    marisa::Trie trie;
+
+    trie.build(keyset);
+    trie.save(file.string().c_str());
+  }
+
+  std::filesystem::path CreateIndex()
+  {
+    std::filesystem::path directory=std::filesystem::temp_directory_path()/"osmscout-textsearchindex-test";
+
+    std::filesystem::create_directories(directory);
+
+    WriteTrie(directory/osmscout::TextSearchIndex::TEXT_POI_DAT,
+              {BuildKey("Vysoká škola",1,osmscout::refNode),
+               BuildKey("Vysoká",2,osmscout::refArea),
+               BuildKey("Bosyně",3,osmscout::refWay),
+               BuildKey("Hospoda",4,osmscout::refNode)});
+
+    WriteTrie(directory/osmscout::TextSearchIndex::TEXT_LOC_DAT,
+              {BuildKey("Vysoká",5,osmscout::refWay),
+               BuildKey("Nádražní",6,osmscout::refWay),
+               BuildKey("Hospodářská",7,osmscout::refWay)});
+
+    WriteTrie(directory/osmscout::TextSearchIndex::TEXT_REGION_DAT,
+              {BuildKey("Mělník",8,osmscout::refArea)});
+
+    // More objects for one text than are enumerated below a prefix during fuzzy search
+    std::vector<std::string> otherKeys;
+
+    for (osmscout::FileOffset offset=100; offset<400; offset++) {
+      otherKeys.push_back(BuildKey("Hlavní",offset,osmscout::refWay));
+    }
+
+    WriteTrie(directory/osmscout::TextSearchIndex::TEXT_OTHER_DAT,
+              otherKeys);
+
+    return directory;
+  }
+
+  const osmscout::TextSearchIndex::FuzzyResult* FindResult(const std::vector<osmscout::TextSearchIndex::FuzzyResult>& results,
+                                                            const std::string& text)
+  {
+    for (const auto& result : results) {
+      if (result.text==osmscout::UTF8NormForLookup(text)) {
+        return &result;
+      }
+    }
+
+    return nullptr;
+  }
+}
+
+TEST_CASE("Exact prefix search over all tries") {
+  osmscout::TextSearchIndex index;
+
+  REQUIRE(index.Load(CreateIndex().string()));
+
+  osmscout::TextSearchIndex::ResultsMap results;
+
+  REQUIRE(index.Search("vysoká",true,true,true,true,false,results));
+  REQUIRE(results.size()==2);
+  REQUIRE(results[osmscout::UTF8NormForLookup("Vysoká")].size()==2);
+
+  REQUIRE(index.Search("vysika",true,true,true,true,false,results));
+  REQUIRE(results.empty());
+}
+
+TEST_CASE("Fuzzy search tolerates typos") {
+  osmscout::TextSearchIndex                         index;
+  std::vector<osmscout::TextSearchIndex::FuzzyResult> results;
+
+  REQUIRE(index.Load(CreateIndex().string()));
+
+  // substitution
+  REQUIRE(index.SearchFuzzy("vysiká",true,true,true,true,false,1,10,results));
+  REQUIRE(results.size()==2);
+  REQUIRE(results[0].text==osmscout::UTF8NormForLookup("Vysoká"));
+  REQUIRE(results[0].distance==1);
+  REQUIRE(results[0].refs.size()==2);
+  REQUIRE(FindResult(results,"Vysoká škola")!=nullptr);
+
+  // transposition
+  REQUIRE(index.SearchFuzzy("bosnyě",true,true,true,true,false,1,10,results));
+  REQUIRE(results.size()==1);
+  REQUIRE(results[0].text==osmscout::UTF8NormForLookup("Bosyně"));
+  REQUIRE(results[0].distance==1);
+
+  // deletion and multi byte characters
+  REQUIRE(index.SearchFuzzy("mělnk",true,true,true,true,false,1,10,results));
+  REQUIRE(FindResult(results,"Mělník")!=nullptr);
+
+  // exact prefix matches rank first
+  REQUIRE(index.SearchFuzzy("hospod",true,true,true,true,false,1,10,results));
+  REQUIRE(results.size()==2);
+  REQUIRE(results[0].distance==0);
+  REQUIRE(results[0].text==osmscout::UTF8NormForLookup("Hospoda"));
+
+  // only requested tries are searched
+  REQUIRE(index.SearchFuzzy("hospod",false,true,false,false,false,1,10,results));
+  REQUIRE(results.size()==1);
+  REQUIRE(results[0].text==osmscout::UTF8NormForLookup("Hospodářská"));
+
+  // distance limit
+  REQUIRE(index.SearchFuzzy("vasiká",true,true,true,true,false,1,10,results));
+  REQUIRE(results.empty());
+}
+
+TEST_CASE("Fuzzy search results are capped") {
+  osmscout::TextSearchIndex                         index;
+  std::vector<osmscout::TextSearchIndex::FuzzyResult> results;
+
+  REQUIRE(index.Load(CreateIndex().string()));
+
+  REQUIRE(index.SearchFuzzy("vysoka",true,true,true,true,false,2,1,results));
+  REQUIRE(results.size()==1);
+  REQUIRE(results[0].text==osmscout::UTF8NormForLookup("Vysoká"));
+
+  // all objects of a ranked text are returned
+  REQUIRE(index.SearchFuzzy("hlavny",true,true,true,true,false,1,1,results));
+  REQUIRE(results.size()==1);
+  REQUIRE(results[0].text==osmscout::UTF8NormForLookup("Hlavní"));
+  REQUIRE(results[0].refs.size()==300);
+
+  REQUIRE(osmscout::TextSearchIndex::GetDefaultMaxDistance("abc")==0);
+  REQUIRE(osmscout::TextSearchIndex::GetDefaultMaxDistance("vysoká")==1);
+  REQUIRE(osmscout::TextSearchIndex::GetDefaultMaxDistance("hospodářská")==2);
+}
@@ -17,6 +17,8 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 
@@ -145,3 +147,207 @@ TEST_CASE("Optimized area is still simple")
   REQUIRE(AreaIsSimple(optimised));
 }
 
+
+static std::vector<osmscout::GeoCoord> GetStarPolygon(const osmscout::GeoCoord& center,
+                                                      double radius,
+                                                      size_t count)
+{
+  std::vector<osmscout::GeoCoord> coords;
+
+  coords.reserve(count);
+
+  for (size_t i=0; i<count; i++) {
+    double angle=2*M_PI*double(i)/double(count);
+    // radius oscillates between 0.2 and 3.0 times the base radius, so the polygon
+    // leaves and re-enters the visible area multiple times
+    double r=radius*(1.6+1.4*std::sin(angle*7)*std::cos(angle*3));
+
+    coords.emplace_back(center.GetLat()+r*std::sin(angle),
+                        center.GetLon()+r*std::cos(angle));
+  }
+
+  return coords;
+}
+
+static std::vector<osmscout::Vertex2D> GetPoints(const osmscout::TransBuffer& transBuffer)
+{
+  std::vector<osmscout::Vertex2D> points;
+
+  if (transBuffer.IsEmpty()) {
+    return points;
+  }
+
+  for (size_t p=transBuffer.GetStart(); p<=transBuffer.GetEnd(); p++) {
+    if (transBuffer.points[p].draw) {
+      points.emplace_back(transBuffer.points[p].x,
+                          transBuffer.points[p].y);
+    }
+  }
+
+  return points;
+}
+
+static int GetWindingNumber(const std::vector<osmscout::Vertex2D>& polygon,
+                            double x,
+                            double y)
+{
+  int winding=0;
+
+  for (size_t i=0; i<polygon.size(); i++) {
+    const osmscout::Vertex2D& a=polygon[i];
+    const osmscout::Vertex2D& b=polygon[(i+1)%polygon.size()];
+    double                    side=(b.GetX()-a.GetX())*(y-a.GetY())-(x-a.GetX())*(b.GetY()-a.GetY());
+
+    if (a.GetY()<=y) {
+      if (b.GetY()>y && side>0) {
+        winding++;
+      }
+    }
+    else if (b.GetY()<=y && side<0) {
+      winding--;
+    }
+  }
+
+  return winding;
+}
+
+TEST_CASE("Clipped area covers the same visible region")
+{
+  osmscout::MercatorProjection projection;
+  osmscout::Magnification      mag;
+
+  mag.SetLevel(osmscout::Magnification::magCity);
+  projection.Set(osmscout::GeoCoord(50.0,14.0),
+                 /*angle*/ 0.3,
+                 mag,
+                 /*dpi*/ 96,
+                 /*width*/ 800,
+                 /*height*/ 600);
+
+  osmscout::GeoBox                clipBox=osmscout::CalculateClipBox(projection,20.0);
+  std::vector<osmscout::GeoCoord> polygon=GetStarPolygon(projection.GetCenter(),
+                                                         projection.GetDimensions().GetHeight()/2,
+                                                         5000);
+  std::vector<osmscout::SegmentGeoBox> segments;
+
+  REQUIRE(clipBox.IsValid());
+
+  osmscout::ComputeSegmentBoxes(polygon,
+                                segments,
+                                polygon.size(),
+                                500);
+
+  osmscout::TransBuffer transBuffer;
+
+  osmscout::TransformArea(polygon,
+                          transBuffer,
+                          projection,
+                          osmscout::TransPolygon::none,
+                          0.0);
+
+  std::vector<osmscout::Vertex2D> full=GetPoints(transBuffer);
+
+  osmscout::TransformArea(polygon,
+                          segments,
+                          clipBox,
+                          transBuffer,
+                          projection,
+                          osmscout::TransPolygon::none,
+                          0.0);
+
+  std::vector<osmscout::Vertex2D> clipped=GetPoints(transBuffer);
+
+  REQUIRE(full.size()==polygon.size());
+  REQUIRE(clipped.size()<full.size()/2);
+
+  for (double y=0.5; y<projection.GetHeight(); y+=10.0) {
+    for (double x=0.5; x<projection.GetWidth(); x+=10.0) {
+      REQUIRE(GetWindingNumber(full,x,y)==GetWindingNumber(clipped,x,y));
+    }
+  }
+}
+
+TEST_CASE("Clipped way keeps the visible nodes and its end points")
+{
+  osmscout::MercatorProjection projection;
+  osmscout::Magnification      mag;
+
+  mag.SetLevel(osmscout::Magnification::magCity);
+  projection.Set(osmscout::GeoCoord(50.0,14.0),
+                 /*angle*/ 0,
+                 mag,
+                 /*dpi*/ 96,
+                 /*width*/ 800,
+                 /*height*/ 600);
+
+  osmscout::GeoBox                clipBox=osmscout::CalculateClipBox(projection,20.0);
+  std::vector<osmscout::GeoCoord> way=GetStarPolygon(projection.GetCenter(),
+                                                     projection.GetDimensions().GetHeight(),
+                                                     3000);
+  osmscout::TransBuffer           transBuffer;
+
+  osmscout::TransformWay(way,
+                         transBuffer,
+                         projection,
+                         osmscout::TransPolygon::none,
+                         0.0);
+
+  std::vector<osmscout::Vertex2D> full=GetPoints(transBuffer);
+
+  osmscout::TransformWay(way,
+                         std::vector<osmscout::SegmentGeoBox>(),
+                         clipBox,
+                         transBuffer,
+                         projection,
+                         osmscout::TransPolygon::none,
+                         0.0);
+
+  std::vector<osmscout::Vertex2D> clipped=GetPoints(transBuffer);
+
+  REQUIRE(clipped.size()<way.size()/2);
+
+  // The clipped way must be a subsequence of the full way
+  std::vector<size_t> indices;
+  size_t              pos=0;
+
+  for (const auto& point : clipped) {
+    while (pos<full.size() &&
+           (std::abs(full[pos].GetX()-point.GetX())>1e-6 ||
+            std::abs(full[pos].GetY()-point.GetY())>1e-6)) {
+      pos++;
+    }
+
+    REQUIRE(pos<full.size());
+    indices.push_back(pos);
+    pos++;
+  }
+
+  // End points are kept
+  REQUIRE(indices.front()==0);
+  REQUIRE(indices.back()==way.size()-1);
+
+  // All nodes within the clip box are kept
+  for (size_t i=0; i<way.size(); i++) {
+    if (clipBox.Includes(way[i],false)) {
+      REQUIRE(std::binary_search(indices.begin(),indices.end(),i));
+    }
+  }
+
+  // Shortcuts stay on one side of the visible area
+  osmscout::ScreenBox screenBox=projection.GetScreenBox();
+
+  for (size_t i=0; i+1<indices.size(); i++) {
+    if (indices[i+1]==indices[i]+1) {
+      continue;
+    }
+
+    const auto& a=clipped[i];
+    const auto& b=clipped[i+1];
+    bool        sameSide=(a.GetX()<screenBox.GetMinX() && b.GetX()<screenBox.GetMinX()) ||
+                         (a.GetX()>screenBox.GetMaxX() && b.GetX()>screenBox.GetMaxX()) ||
+                         (a.GetY()<screenBox.GetMinY() && b.GetY()<screenBox.GetMinY()) ||
+                         (a.GetY()>screenBox.GetMaxY() && b.GetY()>screenBox.GetMaxY());
+
+    REQUIRE(sameSide);
+  }
+}
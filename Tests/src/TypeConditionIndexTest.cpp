@@ -0,0 +1,249 @@
+/*
+  TypeConditionIndexTest - a test program for libosmscout
+  Copyright (C) 2026  libosmscout contributors
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#include <TestMain.h>
+
+using namespace osmscout;
+
+namespace {
+  struct TestConfig
+  {
+    TypeConfig typeConfig;
+    TagId      tagAmenity;
+    TagId      tagHighway;
+    TagId      tagLanduse;
+    TagId      tagLayer;
+    TagId      tagAccess;
+
+    TestConfig()
+    {
+      TagRegistry& tagRegistry=typeConfig.GetTagRegistry();
+
+      tagAmenity=tagRegistry.RegisterTag("amenity");
+      tagHighway=tagRegistry.RegisterTag("highway");
+      tagLanduse=tagRegistry.RegisterTag("landuse");
+      tagLayer=tagRegistry.RegisterTag("layer");
+      tagAccess=tagRegistry.RegisterTag("access");
+
+      // amenity=restaurant and not access=private
+      auto privateAccess=std::make_shared<TagBinaryCondition>(tagAccess,operatorEqual,std::string("private"));
+      auto publicRestaurant=std::make_shared<TagBoolCondition>(TagBoolCondition::boolAnd);
+
+      publicRestaurant->AddCondition(std::make_shared<TagBinaryCondition>(tagAmenity,operatorEqual,std::string("restaurant")));
+      publicRestaurant->AddCondition(std::make_shared<TagNotCondition>(privateAccess));
+
+      RegisterType("amenity_restaurant_public",TypeInfo::typeNode | TypeInfo::typeArea,publicRestaurant);
+
+      // amenity IN (restaurant,cafe)
+      auto food=std::make_shared<TagIsInCondition>(tagAmenity);
+
+      food->AddTagValue("restaurant");
+      food->AddTagValue("cafe");
+
+      RegisterType("amenity_food",TypeInfo::typeNode | TypeInfo::typeArea,food);
+
+      // highway=primary or highway=secondary
+      auto mainRoad=std::make_shared<TagBoolCondition>(TagBoolCondition::boolOr);
+
+      mainRoad->AddCondition(std::make_shared<TagBinaryCondition>(tagHighway,operatorEqual,std::string("primary")));
+      mainRoad->AddCondition(std::make_shared<TagBinaryCondition>(tagHighway,operatorEqual,std::string("secondary")));
+
+      RegisterType("highway_main",TypeInfo::typeWay,mainRoad);
+
+      // layer>1
+      RegisterType("layered",
+                   TypeInfo::typeWay | TypeInfo::typeArea,
+                   std::make_shared<TagBinaryCondition>(tagLayer,operatorGreater,size_t(1)));
+
+      // landuse=*
+      RegisterType("landuse",TypeInfo::typeArea | TypeInfo::typeRelation,std::make_shared<TagExistsCondition>(tagLanduse));
+
+      // highway=* but not highway=primary
+      RegisterType("highway_other",
+                   TypeInfo::typeWay | TypeInfo::typeNode,
+                   std::make_shared<TagBinaryCondition>(tagHighway,operatorNotEqual,std::string("primary")));
+
+      // not amenity=*
+      RegisterType("no_amenity",
+                   TypeInfo::typeRelation,
+                   std::make_shared<TagNotCondition>(std::make_shared<TagExistsCondition>(tagAmenity)));
+
+      typeConfig.BuildConditionIndex();
+    }
+
+    void RegisterType(const std::string& name,
+                      unsigned char types,
+                      const TagConditionRef& condition)
+    {
+      TypeInfoRef type=std::make_shared<TypeInfo>(name);
+
+      type->CanBeNode((types & TypeInfo::typeNode)!=0);
+      type->CanBeWay((types & TypeInfo::typeWay)!=0);
+      type->CanBeArea((types & TypeInfo::typeArea)!=0);
+      type->CanBeRelation((types & TypeInfo::typeRelation)!=0);
+      type->AddCondition(types,condition);
+
+      typeConfig.RegisterType(type);
+    }
+  };
+
+  /**
+   * Evaluates all conditions in order without the index
+   */
+  TypeInfoRef GetFirstMatchingType(const TypeConfig& typeConfig,
+                                   const TagMap& tagMap,
+                                   unsigned char objectType)
+  {
+    for (const auto& type : typeConfig.GetTypes()) {
+      if (!type->HasConditions()) {
+        continue;
+      }
+
+      for (const auto& cond : type->GetConditions()) {
+        if ((cond.types & objectType)!=0 &&
+            cond.condition->Evaluate(tagMap)) {
+          return type;
+        }
+      }
+    }
+
+    return typeConfig.typeInfoIgnore;
+  }
+}
+
+TEST_CASE("Index returns the first matching type")
+{
+  TestConfig config;
+  TagMap     tags;
+
+  tags.Set(config.tagAmenity,
+           "restaurant");
+
+  REQUIRE(config.typeConfig.GetNodeType(tags)->GetName()=="amenity_restaurant_public");
+
+  tags.Set(config.tagAccess,
+           "private");
+
+  REQUIRE(config.typeConfig.GetNodeType(tags)->GetName()=="amenity_food");
+
+  tags.clear();
+  tags.Set(config.tagHighway,
+           "primary");
+
+  TypeInfoRef wayType;
+  TypeInfoRef areaType;
+
+  REQUIRE(config.typeConfig.GetWayAreaType(tags,wayType,areaType));
+  REQUIRE(wayType->GetName()=="highway_main");
+  REQUIRE(areaType==config.typeConfig.typeInfoIgnore);
+  REQUIRE(config.typeConfig.GetNodeType(tags)==config.typeConfig.typeInfoIgnore);
+
+  tags.Set(config.tagHighway,
+           "track");
+
+  REQUIRE(config.typeConfig.GetNodeType(tags)->GetName()=="highway_other");
+
+  tags.clear();
+  tags.Set(config.tagLayer,
+           "2");
+  tags.Set(config.tagLanduse,
+           "forest");
+
+  REQUIRE(config.typeConfig.GetWayAreaType(tags,wayType,areaType));
+  REQUIRE(wayType->GetName()=="layered");
+  REQUIRE(areaType->GetName()=="layered");
+
+  tags.Set(config.tagLayer,
+           "1");
+
+  REQUIRE(config.typeConfig.GetWayAreaType(tags,wayType,areaType));
+  REQUIRE(wayType==config.typeConfig.typeInfoIgnore);
+  REQUIRE(areaType->GetName()=="landuse");
+
+  tags.Set(config.typeConfig.tagType,
+           "multipolygon");
+
+  REQUIRE(config.typeConfig.GetRelationType(tags)->GetName()=="landuse");
+
+  tags.Set(config.typeConfig.tagType,
+           "route");
+  tags.Set(config.tagAmenity,
+           "cafe");
+
+  REQUIRE(config.typeConfig.GetRelationType(tags)->GetName()=="landuse");
+
+  tags.erase(config.tagLanduse);
+
+  REQUIRE(config.typeConfig.GetRelationType(tags)==config.typeConfig.typeInfoIgnore);
+
+  tags.erase(config.tagAmenity);
+
+  REQUIRE(config.typeConfig.GetRelationType(tags)->GetName()=="no_amenity");
+}
+
+TEST_CASE("Index matches the evaluation of all conditions")
+{
+  TestConfig                     config;
+  std::mt19937                   generator(42);
+  const std::vector<TagId>       tagIds={config.tagAmenity,
+                                         config.tagHighway,
+                                         config.tagLanduse,
+                                         config.tagLayer,
+                                         config.tagAccess};
+  const std::vector<std::string> values={"restaurant","cafe","primary","secondary","track",
+                                         "private","forest","0","1","2","3"};
+
+  for (size_t run=0; run<10000; run++) {
+    TagMap tags;
+
+    for (TagId tag : tagIds) {
+      if (generator()%2==0) {
+        tags.Set(tag,
+                 values[generator()%values.size()]);
+      }
+    }
+
+    if (tags.empty()) {
+      continue;
+    }
+
+    TypeInfoRef wayType;
+    TypeInfoRef areaType;
+
+    config.typeConfig.GetWayAreaType(tags,wayType,areaType);
+
+    TypeInfoRef expectedWayAreaType=GetFirstMatchingType(config.typeConfig,
+                                                         tags,
+                                                         TypeInfo::typeWay | TypeInfo::typeArea);
+
+    REQUIRE(config.typeConfig.GetNodeType(tags)==GetFirstMatchingType(config.typeConfig,
+                                                                       tags,
+                                                                       TypeInfo::typeNode));
+    REQUIRE((wayType==expectedWayAreaType || areaType==expectedWayAreaType));
+    REQUIRE(config.typeConfig.GetRelationType(tags)==GetFirstMatchingType(config.typeConfig,
+                                                                           tags,
+                                                                           TypeInfo::typeRelation));
+  }
+}
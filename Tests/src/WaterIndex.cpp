@@ -17,8 +17,15 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <cmath>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string>
+
+#include <osmscout/projection/MercatorProjection.h>
 
 #include <osmscoutimport/WaterIndexProcessor.h>
 
@@ -190,3 +197,147 @@ TEST_CASE("Synthetize coastlines")
   REQUIRE((*it)->coast[1].GetCoord()==GeoCoord(0, 0));
   REQUIRE((*it)->coast[2].GetCoord()==GeoCoord(0, 0.5));
 }
+
+/**
+ * A wavy coastline running west to east with land in the north and
+ * islands of different size south of it
+ */
+std::list<WaterIndexProcessor::CoastRef> MkCoastlines()
+{
+  std::list<WaterIndexProcessor::CoastRef> coastlines;
+  Id                                       nodeId=1;
+  std::vector<Point>                       coords;
+
+  for (size_t i=0; i<=200; i++) {
+    coords.emplace_back(nodeId++, GeoCoord(50.5+0.05*std::sin(i*0.3), 10.0+i*0.01));
+  }
+  coastlines.push_back(MkCoastline(1, std::move(coords)));
+
+  for (size_t i=0; i<20; i++) {
+    double lat=50.05+0.08*(i%5);
+    double lon=10.1+0.45*(i/5);
+    double size=0.005+0.004*(i%7);
+
+    coords.clear();
+    coords.emplace_back(nodeId, GeoCoord(lat-size, lon-size));
+    coords.emplace_back(nodeId+1, GeoCoord(lat-size, lon+size));
+    coords.emplace_back(nodeId+2, GeoCoord(lat+size, lon+size));
+    coords.emplace_back(nodeId+3, GeoCoord(lat+size, lon-size));
+    coords.emplace_back(nodeId, GeoCoord(lat-size, lon-size));
+    coastlines.push_back(MkCoastline(2+i, std::move(coords)));
+
+    nodeId+=4;
+  }
+
+  return coastlines;
+}
+
+/**
+ * Generates the water index for the coastlines above the same way as
+ * WaterIndexGenerator and returns the content of the index file
+ */
+std::string GenerateWaterIndex(size_t threadCount)
+{
+  WaterIndexProcessor                      processor(threadCount);
+  SilentProgress                           progress;
+  std::list<WaterIndexProcessor::CoastRef> coastlines=MkCoastlines();
+  std::list<WaterIndexProcessor::CoastRef> boundingPolygons;
+  GeoBox                                   boundingBox(GeoCoord(49.9,9.9),GeoCoord(50.7,12.1));
+  std::vector<WaterIndexProcessor::Level>  levels;
+  double                                   cellWidth=360.0;
+  double                                   cellHeight=180.0;
+  std::string                              filename=(std::filesystem::temp_directory_path()/("water-"+std::to_string(threadCount)+".idx")).string();
+
+  for (uint32_t zoomLevel=0; zoomLevel<=14; zoomLevel++) {
+    if (zoomLevel>=8) {
+      WaterIndexProcessor::Level level;
+
+      level.level=zoomLevel;
+      level.SetBox(boundingBox,
+                   cellWidth,
+                   cellHeight);
+
+      levels.push_back(level);
+    }
+
+    cellWidth=cellWidth/2.0;
+    cellHeight=cellHeight/2.0;
+  }
+
+  processor.MergeCoastlines(progress,coastlines);
+
+  FileWriter writer;
+
+  writer.Open(filename);
+
+  processor.DumpIndexHeader(writer,
+                            levels);
+
+  for (auto& level : levels) {
+    Magnification                          magnification(MagnificationLevel(level.level));
+    MercatorProjection                     projection;
+    std::map<Pixel,std::list<GroundTile> > cellGroundTileMap;
+    WaterIndexProcessor::Data              data;
+
+    projection.Set(GeoCoord(0.0,0.0),magnification,72,640,480);
+
+    processor.CalculateCoastlineData(progress,
+                                     TransPolygon::quality,
+                                     1.0,
+                                     4.0,
+                                     projection,
+                                     level.stateMap,
+                                     coastlines,
+                                     data);
+    processor.MarkCoastlineCells(progress,
+                                 level.stateMap,
+                                 data);
+    processor.HandleCoastlinesPartiallyInACell(progress,
+                                               level.stateMap,
+                                               cellGroundTileMap,
+                                               data);
+    processor.HandleAreaCoastlinesCompletelyInACell(progress,
+                                                    level.stateMap,
+                                                    data,
+                                                    cellGroundTileMap);
+    processor.CalculateCoastEnvironment(progress,
+                                        level.stateMap,
+                                        cellGroundTileMap);
+    processor.FillWater(progress,
+                        level,
+                        20,
+                        boundingPolygons);
+    processor.FillWaterAroundIsland(progress,
+                                    level.stateMap,
+                                    cellGroundTileMap,
+                                    boundingPolygons);
+    processor.FillLand(progress,
+                       level.stateMap);
+    processor.CalculateHasCellData(level,
+                                   cellGroundTileMap);
+    processor.WriteTiles(progress,
+                         cellGroundTileMap,
+                         level,
+                         writer);
+  }
+
+  writer.Close();
+
+  std::ifstream file(filename,std::ios::binary);
+  std::string   content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+
+  file.close();
+  std::filesystem::remove(filename);
+
+  return content;
+}
+
+TEST_CASE("Water index does not depend on the number of threads")
+{
+  std::string sequential=GenerateWaterIndex(1);
+
+  REQUIRE(sequential.size()>0);
+  REQUIRE(GenerateWaterIndex(2)==sequential);
+  REQUIRE(GenerateWaterIndex(4)==sequential);
+}
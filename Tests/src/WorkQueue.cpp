@@ -27,8 +27,8 @@
 class Worker
 {
 private:
+  osmscout::WorkQueue<int> queue;  // must be constructed before the worker thread starts
   std::thread              worker;
-  osmscout::WorkQueue<int> queue;
 
 private:
   int Work(int a, int b)
@@ -65,6 +65,11 @@
 #cmakedefine HAVE_INTTYPES_H 1
 #endif
 
+/* Define to 1 if you have the <linux/io_uring.h> header file. */
+#ifndef HAVE_LINUX_IO_URING_H
+#cmakedefine HAVE_LINUX_IO_URING_H 1
+#endif
+
 /* Define to 1 if the system has the type `long long'. */
 #ifndef HAVE_LONG_LONG
 #cmakedefine HAVE_LONG_LONG 1
@@ -95,6 +95,7 @@ include(CheckIncludeFileCXX)
 check_include_file(dlfcn.h HAVE_DLFCN_H)
 check_include_file(fcntl.h HAVE_FCNTL_H)
 check_include_file(inttypes.h HAVE_INTTYPES_H)
+check_include_file(linux/io_uring.h HAVE_LINUX_IO_URING_H)
 check_include_file(memory.h HAVE_MEMORY_H)
 check_include_file(stdint.h HAVE_STDINT_H)
 check_include_file(stdlib.h HAVE_STDLIB_H)
@@ -22,6 +22,7 @@
 
 #include <osmscoutgpx/GpxFile.h>
 #include <osmscoutgpx/Import.h>
+#include <osmscoutgpx/TrackPointColumns.h>
 #include <osmscoutgpx/GPXImportExport.h>
 
 #include <osmscout/io/File.h>
@@ -30,7 +31,9 @@
 #include <osmscout/async/Breaker.h>
 
 #include <cstdio>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace osmscout::gpx {
 
@@ -38,6 +41,69 @@ extern OSMSCOUT_GPX_API bool ExportGpx(const GpxFile &gpxFile,
                                        const std::string &filePath,
                                        BreakerRef breaker = nullptr,
                                        ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+class GpxWritter;
+
+/**
+ * Writes a gpx file incrementally, so that tracks of any size can be exported
+ * chunk by chunk without holding them in memory.
+ *
+ * The gpx schema expects metadata, waypoints, routes and tracks in this order.
+ * Track points have to be written between StartSegment and EndSegment, segments
+ * between StartTrack and EndTrack. Calls in a wrong state fail, this includes
+ * writing a waypoint after a route or track and writing a route after a track.
+ * The document is completed by Close() or the destructor.
+ */
+class OSMSCOUT_GPX_API GpxStreamWriter {
+private:
+  enum class State {
+    Initial,
+    Waypoints, //!< Header written, waypoints, routes and tracks may follow
+    Routes,    //!< Route written, routes and tracks may follow
+    Tracks,    //!< Track written, only tracks may follow
+    Track,
+    Segment,
+    Closed
+  };
+
+  std::unique_ptr<GpxWritter> writer;
+  State                       state=State::Initial;
+
+public:
+  explicit GpxStreamWriter(const std::string &filePath,
+                           BreakerRef breaker = nullptr,
+                           ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+  GpxStreamWriter(const GpxStreamWriter&) = delete;
+  GpxStreamWriter& operator=(const GpxStreamWriter&) = delete;
+
+  ~GpxStreamWriter();
+
+  /**
+   * Start the document and write the metadata (name, desc, timestamp) of the given file.
+   * Other content of the file is ignored. Optional, an empty header is written
+   * implicitly otherwise.
+   */
+  bool WriteHeader(const GpxFile &metadata);
+
+  bool WriteWaypoint(const Waypoint &waypoint);
+  bool WriteRoute(const Route &route);
+
+  /**
+   * Start a track and write its properties. Segments of the given track are ignored.
+   */
+  bool StartTrack(const Track &track);
+  bool StartSegment();
+  bool WriteTrackPoints(const std::vector<TrackPoint> &points);
+  bool WriteTrackPoints(const TrackPointColumns &points);
+  bool EndSegment();
+  bool EndTrack();
+
+  /**
+   * Close all open elements and finish the document
+   */
+  bool Close();
+};
 }
 
 #endif //LIBOSMSCOUT_GPX_EXPORT_H
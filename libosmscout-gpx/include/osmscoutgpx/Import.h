@@ -21,6 +21,7 @@
 */
 
 #include <osmscoutgpx/GpxFile.h>
+#include <osmscoutgpx/TrackPointColumns.h>
 #include <osmscoutgpx/Utils.h>
 #include <osmscoutgpx/GPXImportExport.h>
 
@@ -30,7 +31,10 @@
 #include <osmscout/async/Breaker.h>
 
 #include <cstdio>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace osmscout::gpx {
 
@@ -40,6 +44,105 @@ extern OSMSCOUT_GPX_API bool ImportGpx(const std::string &filePath,
                                        BreakerRef breaker =nullptr,
                                        ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
 
+/**
+ * How track points are passed to GpxStreamHandler::OnTrackPoints
+ */
+enum class TrackPointStorage {
+  Points,  //!< TrackPointChunk::points is filled
+  Columns  //!< TrackPointChunk::columns is filled
+};
+
+struct OSMSCOUT_GPX_API GpxStreamOptions {
+  size_t            chunkSize=4096; //!< Maximum number of track points per chunk
+  TrackPointStorage storage=TrackPointStorage::Points;
+};
+
+/**
+ * A chunk of consecutive points of a track segment. The chunk is reused
+ * for the following points after the callback returned.
+ */
+struct OSMSCOUT_GPX_API TrackPointChunk {
+  size_t                  track=0;    //!< Index of the track in the file
+  size_t                  segment=0;  //!< Index of the segment in the track
+  size_t                  offset=0;   //!< Index of the first point of the chunk in the segment
+  bool                    last=false; //!< Last chunk of the segment, may be empty
+  std::vector<TrackPoint> points;     //!< Points, if TrackPointStorage::Points is used
+  TrackPointColumns       columns;    //!< Points, if TrackPointStorage::Columns is used
+
+  size_t GetSize() const
+  {
+    return points.size()+columns.GetSize();
+  }
+};
+
+/**
+ * Receiver of the content of a gpx file read by ImportGpxStream.
+ *
+ * Track points are passed in chunks while parsing, so memory consumption
+ * does not depend on the size of the file. Callbacks are called in document order.
+ */
+class OSMSCOUT_GPX_API GpxStreamHandler {
+public:
+  virtual ~GpxStreamHandler() = default;
+
+  /**
+   * Called at the end of the metadata element. Only name, desc and timestamp are set.
+   */
+  virtual void OnMetadata(const GpxFile& metadata);
+
+  virtual void OnWaypoint(Waypoint&& waypoint);
+
+  virtual void OnRoute(Route&& route);
+
+  virtual void OnTrackPoints(const TrackPointChunk& chunk);
+
+  /**
+   * Called at the end of a track, after all of its points were passed.
+   * The track does not contain any segments.
+   */
+  virtual void OnTrack(size_t index, Track&& track);
+};
+
+/**
+ * Parse the given gpx file and pass its content to the handler while parsing.
+ */
+extern OSMSCOUT_GPX_API bool ImportGpxStream(const std::string &filePath,
+                                             GpxStreamHandler &handler,
+                                             const GpxStreamOptions &options = GpxStreamOptions(),
+                                             BreakerRef breaker = nullptr,
+                                             ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+/**
+ * Import the given files concurrently using threadCount threads (0 for the number
+ * of hardware threads). output is resized to the number of files.
+ *
+ * Progress is reported as the ratio of processed files, errors are prefixed
+ * with the file path. The callback is never called concurrently.
+ *
+ * @return true if all files were imported successfully
+ */
+extern OSMSCOUT_GPX_API bool ImportGpxFiles(const std::vector<std::string> &filePaths,
+                                            std::vector<GpxFile> &output,
+                                            size_t threadCount = 0,
+                                            BreakerRef breaker = nullptr,
+                                            ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+using GpxStreamHandlerFactory = std::function<std::unique_ptr<GpxStreamHandler>(size_t fileIndex)>;
+
+/**
+ * Stream the given files concurrently using threadCount threads (0 for the number
+ * of hardware threads). For every file a new handler is requested from the factory.
+ * The handler is called from the worker thread and destroyed after the file
+ * was processed.
+ *
+ * @return true if all files were imported successfully
+ */
+extern OSMSCOUT_GPX_API bool ImportGpxStreams(const std::vector<std::string> &filePaths,
+                                              const GpxStreamHandlerFactory &handlerFactory,
+                                              const GpxStreamOptions &options = GpxStreamOptions(),
+                                              size_t threadCount = 0,
+                                              BreakerRef breaker = nullptr,
+                                              ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
 }
 
 #endif //LIBOSMSCOUT_GPX_IMPORT_H
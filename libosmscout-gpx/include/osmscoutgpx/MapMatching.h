@@ -0,0 +1,68 @@
+#ifndef OSMSCOUT_GPX_MAPMATCHING_H
+#define OSMSCOUT_GPX_MAPMATCHING_H
+
+/*
+  This source is part of the libosmscout-gpx library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutgpx/GPXImportExport.h>
+#include <osmscoutgpx/Track.h>
+
+#include <osmscout/routing/MapMatchingService.h>
+
+#include <vector>
+
+namespace osmscout::gpx {
+
+/**
+ * Convert track segment to map matching input. Horizontal dilution of precision
+ * is dimensionless, so if available, it is multiplied by the user equivalent
+ * range error (UERE) of the receiver to get the accuracy of the fix. Fixes
+ * without hdop get no accuracy, so MapMatchingParameter::GetGpsSigma() is used
+ * for them.
+ *
+ * @param segment
+ * @param uere user equivalent range error of the receiver
+ * @return fixes for map matching
+ */
+extern OSMSCOUT_GPX_API std::vector<MapMatchingFix> ToMapMatchingTrace(const TrackSegment &segment,
+                                                                       const Distance &uere=Meters(5));
+
+/**
+ * Match all segments of the track to the road network.
+ *
+ * @param service
+ * @param track
+ * @return one result per track segment
+ */
+extern OSMSCOUT_GPX_API std::vector<MapMatchingResult> MatchTrack(const MapMatchingService &service,
+                                                                  const Track &track);
+
+/**
+ * Match all segments of all tracks to the road network. Segments are processed
+ * in parallel, see MapMatchingParameter::SetThreads.
+ *
+ * @param service
+ * @param tracks
+ * @return for each track one result per track segment
+ */
+extern OSMSCOUT_GPX_API std::vector<std::vector<MapMatchingResult>> MatchTracks(const MapMatchingService &service,
+                                                                                const std::vector<Track> &tracks);
+}
+
+#endif //OSMSCOUT_GPX_MAPMATCHING_H
@@ -0,0 +1,91 @@
+#ifndef OSMSCOUT_GPX_TRACKPOINTCOLUMNS_H
+#define OSMSCOUT_GPX_TRACKPOINTCOLUMNS_H
+
+/*
+  This source is part of the libosmscout-gpx library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutgpx/TrackPoint.h>
+
+#include <osmscoutgpx/GPXImportExport.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace osmscout::gpx {
+
+/**
+ * Compact, column oriented storage of track points.
+ *
+ * Instead of a vector of TrackPoint objects (with an std::optional for every
+ * attribute) each attribute is stored in its own array:
+ *
+ * - coordinates as fixed point numbers with a precision of 1e-7 degree
+ * - timestamps with millisecond precision
+ * - elevation, course and dilutions as float, NaN if not set
+ *
+ * This needs about a third of the memory of std::vector<TrackPoint> and
+ * allows fast iteration over a single attribute (for example all coordinates).
+ */
+class OSMSCOUT_GPX_API TrackPointColumns {
+private:
+  static constexpr int64_t NoTimestamp=std::numeric_limits<int64_t>::min();
+
+  std::vector<int32_t> latitudes;  //!< Latitude in 1e-7 degree
+  std::vector<int32_t> longitudes; //!< Longitude in 1e-7 degree
+  std::vector<int64_t> timestamps; //!< Milliseconds since epoch, NoTimestamp if not set
+  std::vector<float>   elevations;
+  std::vector<float>   courses;
+  std::vector<float>   hdops;
+  std::vector<float>   vdops;
+  std::vector<float>   pdops;
+
+public:
+  size_t GetSize() const
+  {
+    return latitudes.size();
+  }
+
+  bool IsEmpty() const
+  {
+    return latitudes.empty();
+  }
+
+  void Reserve(size_t size);
+  void Clear();
+
+  void Append(const TrackPoint& point);
+  void Append(const std::vector<TrackPoint>& points);
+
+  GeoCoord GetCoord(size_t index) const;
+  TrackPoint Get(size_t index) const;
+
+  /**
+   * Append all points to the given vector
+   */
+  void CopyTo(std::vector<TrackPoint>& points) const;
+
+  /**
+   * Return the number of bytes allocated for the points
+   */
+  size_t GetMemorySize() const;
+};
+}
+
+#endif //OSMSCOUT_GPX_TRACKPOINTCOLUMNS_H
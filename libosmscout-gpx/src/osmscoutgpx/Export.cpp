@@ -31,6 +31,8 @@
 using namespace osmscout;
 using namespace osmscout::gpx;
 
+namespace osmscout::gpx {
+
 /**
  * Inspired by http://www.xmlsoft.org/examples/testWriter.c
  */
@@ -43,13 +45,10 @@ private:
 
   xmlTextWriterPtr    writer;
   ProcessCallbackRef  callback;
-  const GpxFile       &gpxFile;
   BreakerRef          breaker;
 
 private:
   bool WriteGpxHeader();
-  bool StartElement(const char *name);
-  bool EndElement();
 
   bool WriteAttribute(const char *name, const char *content);
   bool WriteAttribute(const char *name, double value, std::streamsize precision=6);
@@ -65,13 +64,9 @@ private:
    */
   bool WriteTextElement(const char *elementName, const Timestamp &timestamp);
 
-  bool WriteMetadata(const GpxFile file);
-
-  bool WriteWaypoint(const Waypoint &waypoint);
   bool WriteWaypoints(const std::vector<Waypoint> &waypoints);
 
   bool WriteTrackPoint(const char *elemName, const TrackPoint &point);
-  bool WriteTrackPoints(const char *elemName, const std::vector<TrackPoint> &points);
 
   bool WriteTrackSegment(const TrackSegment &segment);
   bool WriteTrackSegments(const std::vector<TrackSegment> &segments);
@@ -79,19 +74,18 @@ private:
   bool WriteTrack(const Track &track);
   bool WriteTracks(const std::vector<Track> &tracks);
 
-  bool WriteRoute(const Route &route);
   bool WriteRoutes(const std::vector<Route> &routes);
 
   bool WriteExtensions(const Extensions &ext);
 
+  bool IsAborted() const;
+
 public:
-  GpxWritter(const GpxFile &gpxFile,
-             const std::string &filePath,
+  GpxWritter(const std::string &filePath,
              BreakerRef breaker,
              ProcessCallbackRef callback):
       writer(nullptr),
       callback(callback),
-      gpxFile(gpxFile),
       breaker(breaker)
   {
     /* Create a new XmlWriter for uri, with no compression. */
@@ -114,20 +108,27 @@ public:
     }
   }
 
-  bool Process()
-  {
-    if (writer==nullptr) {
-      return false;
-    }
+  bool StartElement(const char *name);
+  bool EndElement();
 
-    if (xmlTextWriterStartDocument(writer, nullptr, Encoding, nullptr) < 0) {
-      if (callback) {
-        callback->Error("Error at xmlTextWriterStartDocument");
-      }
-      return false;
-    }
+  bool StartDocument();
+  bool EndDocument();
 
-    if (!WriteGpxHeader()){
+  bool WriteMetadata(const GpxFile &file);
+  bool WriteWaypoint(const Waypoint &waypoint);
+  bool WriteRoute(const Route &route);
+
+  /**
+   * Start the trk element and write the track properties, segments are not written
+   */
+  bool StartTrack(const Track &track);
+
+  bool WriteTrackPoints(const char *elemName, const std::vector<TrackPoint> &points);
+  bool WriteTrackPoints(const char *elemName, const TrackPointColumns &points);
+
+  bool Process(const GpxFile &gpxFile)
+  {
+    if (!StartDocument()){
       return false;
     }
 
@@ -147,16 +148,54 @@ public:
       return false;
     }
 
-    if (xmlTextWriterEndDocument(writer) < 0) {
-      if (callback) {
-        callback->Error("Error at xmlTextWriterEndDocument");
-      }
-      return false;
+    return EndDocument();
+  }
+};
+
+}
+
+bool GpxWritter::StartDocument()
+{
+  if (writer==nullptr) {
+    return false;
+  }
+
+  if (xmlTextWriterStartDocument(writer, nullptr, Encoding, nullptr) < 0) {
+    if (callback) {
+      callback->Error("Error at xmlTextWriterStartDocument");
     }
+    return false;
+  }
 
+  return WriteGpxHeader();
+}
+
+bool GpxWritter::EndDocument()
+{
+  if (writer==nullptr) {
+    return false;
+  }
+
+  if (xmlTextWriterEndDocument(writer) < 0) {
+    if (callback) {
+      callback->Error("Error at xmlTextWriterEndDocument");
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool GpxWritter::IsAborted() const
+{
+  if (breaker && breaker->IsAborted()){
+    if (callback) {
+      callback->Error("aborted");
+    }
     return true;
   }
-};
+  return false;
+}
 
 bool GpxWritter::StartElement(const char *name)
 {
@@ -357,10 +396,7 @@ bool GpxWritter::WriteTrackPoint(const char *elemName, const TrackPoint &point)
 bool GpxWritter::WriteTrackPoints(const char *elemName, const std::vector<TrackPoint> &points)
 {
   for (const auto& point: points){
-    if (breaker && breaker->IsAborted()){
-      if (callback) {
-        callback->Error("aborted");
-      }
+    if (IsAborted()){
       return false;
     }
 
@@ -371,6 +407,20 @@ bool GpxWritter::WriteTrackPoints(const char *elemName, const std::vector<TrackP
   return true;
 }
 
+bool GpxWritter::WriteTrackPoints(const char *elemName, const TrackPointColumns &points)
+{
+  for (size_t i=0; i<points.GetSize(); i++){
+    if (IsAborted()){
+      return false;
+    }
+
+    if (!WriteTrackPoint(elemName, points.Get(i))){
+      return false;
+    }
+  }
+  return true;
+}
+
 bool GpxWritter::WriteTrackSegment(const TrackSegment &segment)
 {
   return StartElement("trkseg") &&
@@ -388,7 +438,7 @@ bool GpxWritter::WriteTrackSegments(const std::vector<TrackSegment> &segments)
   return true;
 }
 
-bool GpxWritter::WriteTrack(const Track &track)
+bool GpxWritter::StartTrack(const Track &track)
 {
   if (!StartElement("trk")){
     return false;
@@ -434,7 +484,13 @@ bool GpxWritter::WriteTrack(const Track &track)
     }
   }
 
-  return WriteTrackSegments(track.segments) &&
+  return true;
+}
+
+bool GpxWritter::WriteTrack(const Track &track)
+{
+  return StartTrack(track) &&
+      WriteTrackSegments(track.segments) &&
       EndElement();
 }
 
@@ -472,7 +528,7 @@ bool GpxWritter::WriteRoutes(const std::vector<Route> &routes)
   return true;
 }
 
-bool GpxWritter::WriteMetadata(const GpxFile file)
+bool GpxWritter::WriteMetadata(const GpxFile &file)
 {
   if (!file.name && !file.desc && !file.timestamp){
     return true;
@@ -504,10 +560,7 @@ bool GpxWritter::WriteMetadata(const GpxFile file)
 bool GpxWritter::WriteWaypoints(const std::vector<Waypoint> &waypoints)
 {
   for (const auto& waypoint: waypoints){
-    if (breaker && breaker->IsAborted()){
-      if (callback) {
-        callback->Error("aborted");
-      }
+    if (IsAborted()){
       return false;
     }
     if (!WriteWaypoint(waypoint)){
@@ -520,10 +573,7 @@ bool GpxWritter::WriteWaypoints(const std::vector<Waypoint> &waypoints)
 bool GpxWritter::WriteExtensions(const Extensions &ext)
 {
   for (const auto& elem: ext.elements){
-    if (breaker && breaker->IsAborted()){
-      if (callback) {
-        callback->Error("aborted");
-      }
+    if (IsAborted()){
       return false;
     }
     if (!WriteTextElement(elem.GetName().c_str(), elem.GetValue().c_str())){
@@ -538,6 +588,138 @@ bool gpx::ExportGpx(const GpxFile &gpxFile,
                     BreakerRef breaker,
                     ProcessCallbackRef callback)
 {
-  GpxWritter writter(gpxFile, filePath, breaker, callback);
-  return writter.Process();
+  GpxWritter writter(filePath, breaker, callback);
+  return writter.Process(gpxFile);
+}
+
+GpxStreamWriter::GpxStreamWriter(const std::string &filePath,
+                                 BreakerRef breaker,
+                                 ProcessCallbackRef callback):
+  writer(std::make_unique<GpxWritter>(filePath, breaker, callback))
+{
+  // no code
+}
+
+GpxStreamWriter::~GpxStreamWriter()
+{
+  if (state!=State::Closed) {
+    Close();
+  }
+}
+
+bool GpxStreamWriter::WriteHeader(const GpxFile &metadata)
+{
+  if (state!=State::Initial) {
+    return false;
+  }
+
+  state=State::Waypoints;
+
+  return writer->StartDocument() &&
+      writer->WriteMetadata(metadata);
+}
+
+bool GpxStreamWriter::WriteWaypoint(const Waypoint &waypoint)
+{
+  if (state==State::Initial && !WriteHeader(GpxFile())) {
+    return false;
+  }
+
+  return state==State::Waypoints &&
+      writer->WriteWaypoint(waypoint);
+}
+
+bool GpxStreamWriter::WriteRoute(const Route &route)
+{
+  if (state==State::Initial && !WriteHeader(GpxFile())) {
+    return false;
+  }
+
+  if (state!=State::Waypoints &&
+      state!=State::Routes) {
+    return false;
+  }
+
+  state=State::Routes;
+
+  return writer->WriteRoute(route);
+}
+
+bool GpxStreamWriter::StartTrack(const Track &track)
+{
+  if (state==State::Initial && !WriteHeader(GpxFile())) {
+    return false;
+  }
+
+  if (state!=State::Waypoints &&
+      state!=State::Routes &&
+      state!=State::Tracks) {
+    return false;
+  }
+
+  state=State::Track;
+
+  return writer->StartTrack(track);
+}
+
+bool GpxStreamWriter::StartSegment()
+{
+  if (state!=State::Track) {
+    return false;
+  }
+
+  state=State::Segment;
+
+  return writer->StartElement("trkseg");
+}
+
+bool GpxStreamWriter::WriteTrackPoints(const std::vector<TrackPoint> &points)
+{
+  return state==State::Segment &&
+      writer->WriteTrackPoints("trkpt", points);
+}
+
+bool GpxStreamWriter::WriteTrackPoints(const TrackPointColumns &points)
+{
+  return state==State::Segment &&
+      writer->WriteTrackPoints("trkpt", points);
+}
+
+bool GpxStreamWriter::EndSegment()
+{
+  if (state!=State::Segment) {
+    return false;
+  }
+
+  state=State::Track;
+
+  return writer->EndElement();
+}
+
+bool GpxStreamWriter::EndTrack()
+{
+  if (state!=State::Track) {
+    return false;
+  }
+
+  state=State::Tracks;
+
+  return writer->EndElement();
+}
+
+bool GpxStreamWriter::Close()
+{
+  if (state==State::Closed) {
+    return false;
+  }
+
+  if (state==State::Initial && !WriteHeader(GpxFile())) {
+    state=State::Closed;
+    return false;
+  }
+
+  state=State::Closed;
+
+  // Ends all open elements
+  return writer->EndDocument();
 }
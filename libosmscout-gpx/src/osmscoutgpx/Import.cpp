@@ -17,10 +17,14 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include <libxml/parser.h>
@@ -94,12 +98,20 @@ private:
   xmlParserCtxtPtr  ctxt;
   FileOffset        fileSize;
 
+  GpxFile           streamMetadata; // output in streaming mode, only metadata is filled
   GpxFile           &output;
   BreakerRef        breaker;
   ProcessCallbackRef callback;
 
   size_t            errorCnt;
 
+  // streaming mode
+  GpxStreamHandler  *handler=nullptr;
+  GpxStreamOptions  options;
+  TrackPointChunk   chunk;
+  size_t            trackIndex=0;
+  size_t            segmentIndex=0;
+
 public:
   GpxParser(const std::string &filePath,
          GpxFile &output,
@@ -112,6 +124,38 @@ public:
   breaker(breaker),
   callback(callback),
   errorCnt(0)
+  {
+    Open(filePath);
+  }
+
+  GpxParser(const std::string &filePath,
+            GpxStreamHandler &handler,
+            const GpxStreamOptions &options,
+            const BreakerRef& breaker,
+            const ProcessCallbackRef& callback):
+  file(nullptr),
+  ctxt(nullptr),
+  fileSize(0),
+  output(streamMetadata),
+  breaker(breaker),
+  callback(callback),
+  errorCnt(0),
+  handler(&handler),
+  options(options)
+  {
+    this->options.chunkSize=std::max<size_t>(options.chunkSize,1);
+
+    if (this->options.storage==TrackPointStorage::Columns) {
+      chunk.columns.Reserve(this->options.chunkSize);
+    }
+    else {
+      chunk.points.reserve(this->options.chunkSize);
+    }
+
+    Open(filePath);
+  }
+
+  void Open(const std::string &filePath)
   {
     memset(&saxParser,0,sizeof(xmlSAXHandler));
     saxParser.initialized=XML_SAX2_MAGIC;
@@ -159,14 +203,15 @@ public:
       return false;
     }
 
-    char chars[1024];
+    // Large chunks reduce the per call overhead of the push parser for big files
+    std::vector<char> chars(64*1024);
 
-    size_t res=std::fread(chars,1,4,file);
+    size_t res=std::fread(chars.data(),1,4,file);
     if (res!=4) {
       return false;
     }
 
-    ctxt=xmlCreatePushParserCtxt(&saxParser,this,chars,
+    ctxt=xmlCreatePushParserCtxt(&saxParser,this,chars.data(),
                                  static_cast<int>(res),
                                  nullptr);
 
@@ -174,8 +219,8 @@ public:
     xmlCtxtUseOptions(ctxt,XML_PARSE_NOENT|XML_PARSE_NONET);
 
     FileOffset position=0;
-    while ((res=std::fread(chars,1,sizeof(chars),file))>0) {
-      if (::xmlParseChunk(ctxt,chars,
+    while ((res=std::fread(chars.data(),1,chars.size(),file))>0) {
+      if (::xmlParseChunk(ctxt,chars.data(),
                         static_cast<int>(res),0)!=0) {
         ::xmlParserError(ctxt,"xmlParseChunk");
         return false;
@@ -195,7 +240,7 @@ public:
       }
     }
 
-    if (::xmlParseChunk(ctxt,chars,0,1)!=0) {
+    if (::xmlParseChunk(ctxt,chars.data(),0,1)!=0) {
       ::xmlParserError(ctxt,"xmlParseChunk");
       return false;
     }
@@ -203,6 +248,61 @@ public:
     return errorCnt==0;
   }
 
+  bool IsStreaming() const
+  {
+    return handler!=nullptr;
+  }
+
+  GpxStreamHandler& GetHandler()
+  {
+    assert(handler!=nullptr);
+    return *handler;
+  }
+
+  void StartSegment()
+  {
+    chunk.track=trackIndex;
+    chunk.segment=segmentIndex;
+    chunk.offset=0;
+  }
+
+  void AddTrackPoint(TrackPoint&& point)
+  {
+    if (options.storage==TrackPointStorage::Columns) {
+      chunk.columns.Append(point);
+    }
+    else {
+      chunk.points.push_back(std::move(point));
+    }
+
+    if (chunk.GetSize()>=options.chunkSize) {
+      FlushChunk(false);
+    }
+  }
+
+  void FlushChunk(bool last)
+  {
+    chunk.last=last;
+    handler->OnTrackPoints(chunk);
+
+    chunk.offset+=chunk.GetSize();
+    chunk.points.clear();
+    chunk.columns.Clear();
+  }
+
+  void EndSegment()
+  {
+    FlushChunk(true);
+    segmentIndex++;
+  }
+
+  void EndTrack(Track&& track)
+  {
+    handler->OnTrack(trackIndex,std::move(track));
+    trackIndex++;
+    segmentIndex=0;
+  }
+
   void StartDocument()
   {
     assert(contextStack.empty());
@@ -513,7 +613,12 @@ public:
 
   ~TrkptContext() override
   {
-    segment.points.push_back(std::move(point));
+    if (parser.IsStreaming()) {
+      parser.AddTrackPoint(std::move(point));
+    }
+    else {
+      segment.points.push_back(std::move(point));
+    }
   }
 
   const char *ContextName() const override
@@ -550,7 +655,12 @@ public:
 
   ~WaypointContext() override
   {
-    output.waypoints.push_back(std::move(waypoint));
+    if (parser.IsStreaming()) {
+      parser.GetHandler().OnWaypoint(std::move(waypoint));
+    }
+    else {
+      output.waypoints.push_back(std::move(waypoint));
+    }
   }
 
   const char *ContextName() const override
@@ -653,6 +763,9 @@ public:
 
   ~MetadataContext() override
   {
+    if (parser.IsStreaming()) {
+      parser.GetHandler().OnMetadata(output);
+    }
   }
 
   const char *ContextName() const override
@@ -698,11 +811,21 @@ private:
   TrackSegment segment;
 public:
   TrkSegContext(xmlParserCtxtPtr ctxt, Track &track, GpxParser &parser) :
-      GpxParserContext(ctxt, parser), track(track) {}
+      GpxParserContext(ctxt, parser), track(track)
+  {
+    if (parser.IsStreaming()) {
+      parser.StartSegment();
+    }
+  }
 
   ~TrkSegContext() override
   {
-    track.segments.push_back(std::move(segment));
+    if (parser.IsStreaming()) {
+      parser.EndSegment();
+    }
+    else {
+      track.segments.push_back(std::move(segment));
+    }
   }
 
   const char *ContextName() const override
@@ -742,7 +865,12 @@ public:
 
   ~RouteContext() override
   {
-    output.routes.push_back(std::move(route));
+    if (parser.IsStreaming()) {
+      parser.GetHandler().OnRoute(std::move(route));
+    }
+    else {
+      output.routes.push_back(std::move(route));
+    }
   }
 
   const char *ContextName() const override
@@ -825,7 +953,12 @@ public:
 
   ~TrkContext() override
   {
-    output.tracks.push_back(std::move(track));
+    if (parser.IsStreaming()) {
+      parser.EndTrack(std::move(track));
+    }
+    else {
+      output.tracks.push_back(std::move(track));
+    }
   }
 
   const char *ContextName() const override
@@ -930,3 +1063,211 @@ bool gpx::ImportGpx(const std::string &filePath,
   GpxParser parser(filePath, output, breaker, callback);
   return parser.Process();
 }
+
+void GpxStreamHandler::OnMetadata(const GpxFile &)
+{
+  // no code
+}
+
+void GpxStreamHandler::OnWaypoint(Waypoint &&)
+{
+  // no code
+}
+
+void GpxStreamHandler::OnRoute(Route &&)
+{
+  // no code
+}
+
+void GpxStreamHandler::OnTrackPoints(const TrackPointChunk &)
+{
+  // no code
+}
+
+void GpxStreamHandler::OnTrack(size_t, Track &&)
+{
+  // no code
+}
+
+bool gpx::ImportGpxStream(const std::string &filePath,
+                          GpxStreamHandler &handler,
+                          const GpxStreamOptions &options,
+                          BreakerRef breaker,
+                          ProcessCallbackRef callback)
+{
+  GpxParser parser(filePath, handler, options, breaker, callback);
+  return parser.Process();
+}
+
+namespace {
+
+/**
+ * Serializes the callbacks of concurrently processed files into the callback
+ * of the caller. Progress of single files is dropped, progress is reported as
+ * ratio of processed files instead.
+ */
+class BatchProcessCallback {
+private:
+  std::mutex         mutex;
+  ProcessCallbackRef callback;
+  size_t             fileCount;
+  size_t             processedFiles=0;
+
+public:
+  BatchProcessCallback(const ProcessCallbackRef &callback,
+                       size_t fileCount):
+    callback(callback),
+    fileCount(fileCount)
+  {
+    // no code
+  }
+
+  void Error(const std::string &filePath,
+             const std::string &error)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    if (callback) {
+      callback->Error(filePath + ": " + error);
+    }
+  }
+
+  void FileProcessed()
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    processedFiles++;
+
+    if (callback) {
+      callback->Progress(static_cast<double>(processedFiles) / static_cast<double>(fileCount));
+    }
+  }
+};
+
+class FileProcessCallback : public ProcessCallback {
+private:
+  BatchProcessCallback &batchCallback;
+  std::string          filePath;
+
+public:
+  FileProcessCallback(BatchProcessCallback &batchCallback,
+                      const std::string &filePath):
+    batchCallback(batchCallback),
+    filePath(filePath)
+  {
+    // no code
+  }
+
+  void Progress(double) override
+  {
+    // no code
+  }
+
+  void Error(const std::string &error) override
+  {
+    batchCallback.Error(filePath, error);
+  }
+};
+
+using FileProcessor = std::function<bool(size_t fileIndex, const ProcessCallbackRef &callback)>;
+
+bool ProcessFilesConcurrently(const std::vector<std::string> &filePaths,
+                              size_t threadCount,
+                              const BreakerRef &breaker,
+                              const ProcessCallbackRef &callback,
+                              const FileProcessor &processor)
+{
+  BatchProcessCallback batchCallback(callback, filePaths.size());
+  std::atomic<size_t>  nextFile=0;
+  std::atomic<bool>    success=true;
+
+  if (threadCount==0) {
+    threadCount=std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  threadCount=std::min(threadCount, filePaths.size());
+
+  auto worker=[&]() {
+    size_t fileIndex;
+
+    while ((fileIndex=nextFile++)<filePaths.size()) {
+      if (breaker && breaker->IsAborted()) {
+        success=false;
+        return;
+      }
+
+      auto fileCallback=std::make_shared<FileProcessCallback>(batchCallback, filePaths[fileIndex]);
+
+      if (!processor(fileIndex, fileCallback)) {
+        success=false;
+      }
+
+      batchCallback.FileProcessed();
+    }
+  };
+
+  std::vector<std::thread> threads;
+
+  threads.reserve(threadCount);
+
+  for (size_t i=1; i<threadCount; i++) {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  return success;
+}
+
+}
+
+bool gpx::ImportGpxFiles(const std::vector<std::string> &filePaths,
+                         std::vector<GpxFile> &output,
+                         size_t threadCount,
+                         BreakerRef breaker,
+                         ProcessCallbackRef callback)
+{
+  output.clear();
+  output.resize(filePaths.size());
+
+  return ProcessFilesConcurrently(filePaths,
+                                  threadCount,
+                                  breaker,
+                                  callback,
+                                  [&](size_t fileIndex, const ProcessCallbackRef &fileCallback) {
+                                    return ImportGpx(filePaths[fileIndex],
+                                                     output[fileIndex],
+                                                     breaker,
+                                                     fileCallback);
+                                  });
+}
+
+bool gpx::ImportGpxStreams(const std::vector<std::string> &filePaths,
+                           const GpxStreamHandlerFactory &handlerFactory,
+                           const GpxStreamOptions &options,
+                           size_t threadCount,
+                           BreakerRef breaker,
+                           ProcessCallbackRef callback)
+{
+  return ProcessFilesConcurrently(filePaths,
+                                  threadCount,
+                                  breaker,
+                                  callback,
+                                  [&](size_t fileIndex, const ProcessCallbackRef &fileCallback) {
+                                    std::unique_ptr<GpxStreamHandler> handler=handlerFactory(fileIndex);
+
+                                    if (!handler) {
+                                      return false;
+                                    }
+
+                                    return ImportGpxStream(filePaths[fileIndex],
+                                                           *handler,
+                                                           options,
+                                                           breaker,
+                                                           fileCallback);
+                                  });
+}
@@ -0,0 +1,72 @@
+/*
+  This source is part of the libosmscout-gpx library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutgpx/MapMatching.h>
+
+using namespace osmscout;
+using namespace osmscout::gpx;
+
+std::vector<MapMatchingFix> osmscout::gpx::ToMapMatchingTrace(const TrackSegment &segment,
+                                                                const Distance &uere)
+{
+  std::vector<MapMatchingFix> trace;
+  trace.reserve(segment.points.size());
+  for (const auto &point:segment.points){
+    std::optional<Distance> accuracy;
+    if (point.hdop){
+      accuracy=uere*(*point.hdop);
+    }
+    trace.emplace_back(point.coord, accuracy);
+  }
+  return trace;
+}
+
+std::vector<MapMatchingResult> osmscout::gpx::MatchTrack(const MapMatchingService &service,
+                                                         const Track &track)
+{
+  std::vector<std::vector<MapMatchingFix>> traces;
+  traces.reserve(track.segments.size());
+  for (const auto &segment:track.segments){
+    traces.push_back(ToMapMatchingTrace(segment));
+  }
+  return service.Match(traces);
+}
+
+std::vector<std::vector<MapMatchingResult>> osmscout::gpx::MatchTracks(const MapMatchingService &service,
+                                                                       const std::vector<Track> &tracks)
+{
+  // flatten all segments, so that they are distributed over all worker threads
+  std::vector<std::vector<MapMatchingFix>> traces;
+  for (const auto &track:tracks){
+    for (const auto &segment:track.segments){
+      traces.push_back(ToMapMatchingTrace(segment));
+    }
+  }
+
+  std::vector<MapMatchingResult> results=service.Match(traces);
+
+  std::vector<std::vector<MapMatchingResult>> result;
+  result.reserve(tracks.size());
+  auto it=std::make_move_iterator(results.begin());
+  for (const auto &track:tracks){
+    result.emplace_back(it, it+track.segments.size());
+    it+=track.segments.size();
+  }
+  return result;
+}
@@ -0,0 +1,145 @@
+/*
+  This source is part of the libosmscout-gpx library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutgpx/TrackPointColumns.h>
+
+#include <cmath>
+#include <limits>
+
+using namespace osmscout;
+using namespace osmscout::gpx;
+
+namespace {
+  constexpr double CoordConversionFactor=10000000.0;
+
+  int32_t ToFixedPoint(double degree)
+  {
+    return static_cast<int32_t>(std::lround(degree*CoordConversionFactor));
+  }
+
+  float ToFloat(const std::optional<double>& value)
+  {
+    return value ? static_cast<float>(*value) : std::numeric_limits<float>::quiet_NaN();
+  }
+
+  std::optional<double> ToOptional(float value)
+  {
+    if (std::isnan(value)) {
+      return std::nullopt;
+    }
+
+    return static_cast<double>(value);
+  }
+}
+
+void TrackPointColumns::Reserve(size_t size)
+{
+  latitudes.reserve(size);
+  longitudes.reserve(size);
+  timestamps.reserve(size);
+  elevations.reserve(size);
+  courses.reserve(size);
+  hdops.reserve(size);
+  vdops.reserve(size);
+  pdops.reserve(size);
+}
+
+void TrackPointColumns::Clear()
+{
+  latitudes.clear();
+  longitudes.clear();
+  timestamps.clear();
+  elevations.clear();
+  courses.clear();
+  hdops.clear();
+  vdops.clear();
+  pdops.clear();
+}
+
+void TrackPointColumns::Append(const TrackPoint& point)
+{
+  latitudes.push_back(ToFixedPoint(point.coord.GetLat()));
+  longitudes.push_back(ToFixedPoint(point.coord.GetLon()));
+
+  if (point.timestamp) {
+    timestamps.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(point.timestamp->time_since_epoch()).count());
+  }
+  else {
+    timestamps.push_back(NoTimestamp);
+  }
+
+  elevations.push_back(ToFloat(point.elevation));
+  courses.push_back(ToFloat(point.course));
+  hdops.push_back(ToFloat(point.hdop));
+  vdops.push_back(ToFloat(point.vdop));
+  pdops.push_back(ToFloat(point.pdop));
+}
+
+void TrackPointColumns::Append(const std::vector<TrackPoint>& points)
+{
+  Reserve(GetSize()+points.size());
+
+  for (const auto& point : points) {
+    Append(point);
+  }
+}
+
+GeoCoord TrackPointColumns::GetCoord(size_t index) const
+{
+  return GeoCoord(latitudes[index]/CoordConversionFactor,
+                  longitudes[index]/CoordConversionFactor);
+}
+
+TrackPoint TrackPointColumns::Get(size_t index) const
+{
+  TrackPoint point(GetCoord(index));
+
+  if (timestamps[index]!=NoTimestamp) {
+    point.timestamp=Timestamp(std::chrono::duration_cast<Timestamp::duration>(std::chrono::milliseconds(timestamps[index])));
+  }
+
+  point.elevation=ToOptional(elevations[index]);
+  point.course=ToOptional(courses[index]);
+  point.hdop=ToOptional(hdops[index]);
+  point.vdop=ToOptional(vdops[index]);
+  point.pdop=ToOptional(pdops[index]);
+
+  return point;
+}
+
+void TrackPointColumns::CopyTo(std::vector<TrackPoint>& points) const
+{
+  points.reserve(points.size()+GetSize());
+
+  for (size_t i=0; i<GetSize(); i++) {
+    points.push_back(Get(i));
+  }
+}
+
+size_t TrackPointColumns::GetMemorySize() const
+{
+  return latitudes.capacity()*sizeof(int32_t)+
+         longitudes.capacity()*sizeof(int32_t)+
+         timestamps.capacity()*sizeof(int64_t)+
+         (elevations.capacity()+
+          courses.capacity()+
+          hdops.capacity()+
+          vdops.capacity()+
+          pdops.capacity())*sizeof(float);
+}
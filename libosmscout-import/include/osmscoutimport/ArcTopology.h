@@ -0,0 +1,129 @@
+#ifndef OSMSCOUT_IMPORT_ARCTOPOLOGY_H
+#define OSMSCOUT_IMPORT_ARCTOPOLOGY_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutimport/ImportImportExport.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/GeoCoord.h>
+#include <osmscout/Point.h>
+
+#include <osmscout/projection/Projection.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * Splits a set of lines (ways and area rings) into arcs, so that lines sharing
+   * a border reference the same arc, and simplifies every arc once using the
+   * Visvalingam-Whyatt algorithm.
+   *
+   * Nodes are identified by their coordinate. A node is a junction, if it is the
+   * end of an open line or if its neighbours differ between the lines using it.
+   * Arcs run from junction to junction. Since every line is simplified by selecting
+   * the nodes of its arcs, shared borders stay identical and no gaps or slivers
+   * appear between neighbouring objects.
+   *
+   * The simplification stores the effective area of each node, so that the nodes
+   * to keep for any tolerance (and thus for every magnification level) can be
+   * selected without simplifying again. The selected node sets are nested: a node
+   * kept for a bigger tolerance is also kept for all smaller ones.
+   *
+   * Usage: AddLine() for all lines, Build(), CalculateEffectiveAreas() and then
+   * GetNodesToKeep() for each line and tolerance.
+   */
+  class OSMSCOUT_IMPORT_API ArcTopology CLASS_FINAL
+  {
+  private:
+    struct ArcRef
+    {
+      uint32_t arc;      //!< Index of the arc
+      bool     reversed; //!< The line uses the arc in reverse direction
+    };
+
+    struct Line
+    {
+      std::vector<uint32_t> nodeMap;  //!< Index of the original node in keys and coords
+      std::vector<Id>       keys;     //!< Keys of the nodes without succeeding duplicates, cleared by Build()
+      std::vector<GeoCoord> coords;   //!< Coordinates of the nodes, cleared by Build()
+      size_t                size;     //!< Number of nodes without succeeding duplicates
+      bool                  closed;   //!< The line is a ring, the last node connects to the first
+      bool                  trivial;  //!< The line has too few nodes to be simplified
+      size_t                start=0;  //!< Index of the node the first arc starts with
+      std::vector<ArcRef>   arcs;     //!< The arcs of the line, in line order
+    };
+
+    struct Arc
+    {
+      std::vector<GeoCoord> coords;         //!< Coordinates of the nodes, in canonical direction
+      std::vector<double>   effectiveAreas; //!< Effective area of each node, infinite for the end points
+    };
+
+  private:
+    std::vector<Line> lines;
+    std::vector<Arc>  arcs;
+
+  public:
+    /**
+     * Adds a way or an area ring and returns the index of the line
+     */
+    size_t AddLine(const std::vector<Point>& nodes,
+                   bool closed);
+
+    /**
+     * Detects the junctions and splits all lines into shared arcs
+     */
+    void Build();
+
+    /**
+     * Calculates the effective area of all arc nodes in pixel coordinates of the given projection,
+     * using the given configured number of threads (see GetProcessingThreadCount())
+     */
+    void CalculateEffectiveAreas(const Projection& projection,
+                                 size_t threadCount);
+
+    /**
+     * Marks the nodes of the given line to keep, if all nodes with an effective area
+     * smaller than minArea get dropped. The result has one entry for each node passed
+     * to AddLine().
+     */
+    void GetNodesToKeep(size_t line,
+                        double minArea,
+                        std::vector<bool>& keep) const;
+
+    size_t GetLineCount() const
+    {
+      return lines.size();
+    }
+
+    size_t GetArcCount() const
+    {
+      return arcs.size();
+    }
+  };
+}
+
+#endif
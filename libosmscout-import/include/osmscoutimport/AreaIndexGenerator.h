@@ -21,10 +21,14 @@
 */
 
 #include <osmscoutimport/Import.h>
+#include <osmscoutimport/ParallelProcessing.h>
 
-#include <list>
+#include <algorithm>
 #include <map>
+#include <mutex>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include <osmscout/Pixel.h>
 
@@ -48,7 +52,24 @@ namespace osmscout {
   {
   protected:
     using CoordCountMap = std::map<TileId, size_t>;
-    using CoordOffsetsMap = std::map<TileId, std::list<FileOffset>>;
+
+    /**
+     * Object of the given type in the given cell. A data partition collects the entries of
+     * its objects in a run sorted by type, cell and offset.
+     */
+    struct CellEntry
+    {
+      size_t     typeIndex;
+      TileId     tile;
+      FileOffset offset;
+
+      bool operator<(const CellEntry& other) const
+      {
+        return std::tie(typeIndex,tile,offset)<std::tie(other.typeIndex,other.tile,other.offset);
+      }
+    };
+
+    using CellRun = std::vector<CellEntry>;
 
     struct TypeData
     {
@@ -108,7 +129,8 @@ namespace osmscout {
                                const MagnificationLevel& minLevelParam,
                                const MagnificationLevel& maxLevelParam,
                                bool useMmap,
-                               MagnificationLevel& maxLevel) const;
+                               MagnificationLevel& maxLevel,
+                               std::vector<DataPartition>& partitions) const;
 
     /**
      * For each cell we store a file offset to the bitmap data or 0, if there is no data for the cell. The bitmap entry itself
@@ -119,13 +141,14 @@ namespace osmscout {
      * @param writer
      * @param typeInfo
      * @param typeData
-     * @param typeCellOffsets
+     * @param typeCells
+     *    Entries of the type, sorted by cell and offset
      */
     void WriteBitmap(Progress& progress,
                      FileWriter& writer,
                      const TypeInfo& typeInfo,
                      const TypeData& typeData,
-                     const CoordOffsetsMap& typeCellOffsets);
+                     const std::vector<CellEntry>& typeCells);
 
     virtual void WriteTypeId(const TypeConfigRef& typeConfig,
                              const TypeInfoRef &type,
@@ -145,30 +168,42 @@ namespace osmscout {
                                                FileWriter& writer,
                                                const TypeInfo& typeInfo,
                                                const TypeData& typeData,
-                                               const CoordOffsetsMap& typeCellOffsets)
+                                               const std::vector<CellEntry>& typeCells)
   {
     size_t              dataSize=0;
     std::array<char,10> buffer;
 
+    auto getCellEnd=[&typeCells](typename std::vector<CellEntry>::const_iterator cell) {
+      return std::find_if(cell,
+                          typeCells.end(),
+                          [&cell](const CellEntry& entry) {
+                            return entry.tile!=cell->tile;
+                          });
+    };
+
     //
     // Calculate the number of entries and the overall size of the data in the bitmap entries
     // We need the overall size of the bitmap entry data, because we would store the file offset only with
     // that much bytes we need to address the last data entry.
 
-    for (const auto& cell : typeCellOffsets) {
-      dataSize+=EncodeNumber(cell.second.size(),
+    for (auto cell=typeCells.begin(); cell!=typeCells.end();) {
+      auto cellEnd=getCellEnd(cell);
+
+      dataSize+=EncodeNumber(size_t(cellEnd-cell),
                              buffer);
 
       FileOffset previousOffset=0;
 
-      for (const auto& offset : cell.second) {
-        FileOffset data=offset-previousOffset;
+      for (auto entry=cell; entry!=cellEnd; ++entry) {
+        FileOffset data=entry->offset-previousOffset;
 
         dataSize+=EncodeNumber(data,
                                buffer);
 
-        previousOffset=offset;
+        previousOffset=entry->offset;
       }
+
+      cell=cellEnd;
     }
 
     // "+1" because we add +1 to every offset, to generate offset > 0
@@ -207,10 +242,11 @@ namespace osmscout {
     FileOffset dataStartOffset=writer.GetPos();
 
     // Now write the list of offsets of objects for every cell with content
-    for (const auto& cell : typeCellOffsets) {
+    for (auto cell=typeCells.begin(); cell!=typeCells.end();) {
+      auto       cellEnd=getCellEnd(cell);
       FileOffset bitmapCellOffset=bitmapOffset+
-                                  ((cell.first.GetY()-typeData.tileBox.GetMinY())*typeData.tileBox.GetWidth()+
-                                   cell.first.GetX()-typeData.tileBox.GetMinX())*(FileOffset)dataOffsetBytes;
+                                  ((cell->tile.GetY()-typeData.tileBox.GetMinY())*typeData.tileBox.GetWidth()+
+                                   cell->tile.GetX()-typeData.tileBox.GetMinX())*(FileOffset)dataOffsetBytes;
       FileOffset previousOffset=0;
 
       assert(bitmapCellOffset>=bitmapOffset);
@@ -226,17 +262,19 @@ namespace osmscout {
 
       writer.SetPos(cellOffset);
 
-      writer.WriteNumber((uint32_t)cell.second.size());
+      writer.WriteNumber((uint32_t)(cellEnd-cell));
 
       // FileOffsets are already in increasing order, since
-      // File is scanned from start to end
-      for (const auto& offset : cell.second) {
-        assert(offset>previousOffset);
+      // entries are sorted by offset
+      for (auto entry=cell; entry!=cellEnd; ++entry) {
+        assert(entry->offset>previousOffset);
 
-        writer.WriteNumber((FileOffset)(offset-previousOffset));
+        writer.WriteNumber((FileOffset)(entry->offset-previousOffset));
 
-        previousOffset=offset;
+        previousOffset=entry->offset;
       }
+
+      cell=cellEnd;
     }
   }
 
@@ -341,10 +379,10 @@ namespace osmscout {
   {
     using namespace std::string_literals;
 
-    FileScanner           scanner;
-    FileWriter            writer;
-    std::vector<TypeData> typeData;
-    MagnificationLevel    maxLevel;
+    FileWriter                 writer;
+    std::vector<TypeData>      typeData;
+    MagnificationLevel         maxLevel;
+    std::vector<DataPartition> partitions;
 
     progress.Info("Minimum magnification: "s + areaIndexMinMag);
 
@@ -362,7 +400,8 @@ namespace osmscout {
                                areaIndexMinMag,
                                areaIndexMaxMag,
                                useMmap,
-                               maxLevel)) {
+                               maxLevel,
+                               partitions)) {
       return false;
     }
 
@@ -408,17 +447,10 @@ namespace osmscout {
         }
       }
 
-      scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
-                                   dataFile),
-                   FileScanner::Sequential,
-                   useMmap);
-
       for (MagnificationLevel l=areaIndexMinMag; l <= maxLevel; l++) {
         Magnification magnification(l);
         TypeInfoSet   indexTypes(*typeConfig);
 
-        scanner.GotoBegin();
-
         for (const auto &type : types) {
           if (typeData[type->GetIndex()].HasEntries() &&
               typeData[type->GetIndex()].indexLevel==l) {
@@ -432,49 +464,73 @@ namespace osmscout {
 
         progress.Info("Scanning "s + typeNamePlural + " for index level "s + l);
 
-        std::vector<CoordOffsetsMap> typeCellOffsets(typeConfig->GetTypeCount());
-
-        uint32_t objectCount=scanner.ReadUInt32();
-
-        Object obj;
-
-        for (uint32_t w=1; w <= objectCount; w++) {
-          progress.SetProgress(w, objectCount);
-
-          FileOffset offset=scanner.GetPos();
-
-          obj.Read(*typeConfig,
-                   scanner);
+        std::vector<CellRun> runs(partitions.size());
+
+        ReadDataPartitions<Object>(*typeConfig,
+                                   AppendFileToDir(parameter.GetDestinationDirectory(),
+                                                   dataFile),
+                                   useMmap,
+                                   parameter.GetProcessingThreadCount(),
+                                   partitions,
+                                   progress,
+                                   [&indexTypes,&magnification,&runs](size_t partition,
+                                                                      FileOffset offset,
+                                                                      const Object& obj) {
+                                     if (!indexTypes.IsSet(obj.GetType())) {
+                                       return;
+                                     }
+
+                                     TileIdBox box(magnification, obj.GetBoundingBox());
+
+                                     for (const auto& tileId : box) {
+                                       runs[partition].push_back(CellEntry{obj.GetType()->GetIndex(),
+                                                                           tileId,
+                                                                           offset});
+                                     }
+                                   },
+                                   [&runs](size_t partition) {
+                                     std::sort(runs[partition].begin(),
+                                               runs[partition].end());
+                                   });
 
-          if (!indexTypes.IsSet(obj.GetType())) {
-            continue;
-          }
-
-          TileIdBox box(magnification, obj.GetBoundingBox());
-
-          for (const auto& tileId : box) {
-            typeCellOffsets[obj.GetType()->GetIndex()][tileId].push_back(offset);
+        for (const auto &type : indexTypes) {
+          size_t                 index=type->GetIndex();
+          std::vector<CellEntry> typeCells;
+
+          // Partitions are in file order, so a stable sort by cell keeps the offsets of
+          // each cell in increasing order
+          for (const auto& run : runs) {
+            auto range=std::equal_range(run.begin(),
+                                        run.end(),
+                                        CellEntry{index,TileId(0,0),0},
+                                        [](const CellEntry& a, const CellEntry& b) {
+                                          return a.typeIndex<b.typeIndex;
+                                        });
+
+            typeCells.insert(typeCells.end(),
+                             range.first,
+                             range.second);
           }
-        }
 
-        for (const auto &type : indexTypes) {
-          size_t index=type->GetIndex();
+          std::stable_sort(typeCells.begin(),
+                           typeCells.end(),
+                           [](const CellEntry& a, const CellEntry& b) {
+                             return a.tile<b.tile;
+                           });
 
           WriteBitmap(progress,
                       writer,
                       *typeConfig->GetTypeInfo(index),
                       typeData[index],
-                      typeCellOffsets[index]);
+                      typeCells);
         }
       }
 
-      scanner.Close();
       writer.Close();
     }
     catch (IOException& e) {
       progress.Error(e.GetDescription());
 
-      scanner.CloseFailsafe();
       writer.CloseFailsafe();
 
       return false;
@@ -516,21 +572,20 @@ namespace osmscout {
                                                          const MagnificationLevel& minLevelParam,
                                                          const MagnificationLevel& maxLevelParam,
                                                          bool useMmap,
-                                                         MagnificationLevel& maxLevel) const
+                                                         MagnificationLevel& maxLevel,
+                                                         std::vector<DataPartition>& partitions) const
   {
     FileScanner        scanner;
     TypeInfoSet        remainingObjectTypes;
     MagnificationLevel level=minLevelParam;
+    std::string        filename=AppendFileToDir(parameter.GetDestinationDirectory(),
+                                                dataFile);
 
     maxLevel=MagnificationLevel(0);
     typeData.resize(typeConfig.GetTypeCount());
+    partitions.clear();
 
     try {
-      scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
-                                   dataFile),
-                   FileScanner::Sequential,
-                   useMmap);
-
       remainingObjectTypes.Set(types);
 
       while (!remainingObjectTypes.Empty() &&
@@ -541,21 +596,11 @@ namespace osmscout {
 
         progress.Info("Scanning Level " + level + " (" + std::to_string(remainingObjectTypes.Size()) + " types remaining)");
 
-        scanner.GotoBegin();
-
-        uint32_t objectCount=scanner.ReadUInt32();
-
-        Object obj;
-
-        for (uint32_t objI=1; objI <= objectCount; objI++) {
-          progress.SetProgress(objI, objectCount);
-
-          obj.Read(typeConfig,
-                   scanner);
-
+        auto collectCells=[&currentObjectTypes,&magnification](const Object& obj,
+                                                               CellRun& run) {
           // Count number of entries per current type and coordinate
           if (!currentObjectTypes.IsSet(obj.GetType())) {
-            continue;
+            return;
           }
 
           GeoBox boundingBox=obj.GetBoundingBox();
@@ -564,8 +609,85 @@ namespace osmscout {
                         TileId::GetTile(magnification,boundingBox.GetMaxCoord()));
 
           for (const auto& tileId : box) {
-            cellFillCount[obj.GetType()->GetIndex()][tileId]++;
+            run.push_back(CellEntry{obj.GetType()->GetIndex(),tileId,0});
           }
+        };
+
+        // Expects the run to be sorted
+        auto countCells=[&cellFillCount](CellRun& run) {
+          for (auto cell=run.begin(); cell!=run.end();) {
+            auto cellEnd=std::find_if(cell,
+                                      run.end(),
+                                      [&cell](const CellEntry& entry) {
+                                        return entry.typeIndex!=cell->typeIndex ||
+                                               entry.tile!=cell->tile;
+                                      });
+
+            cellFillCount[cell->typeIndex][cell->tile]+=size_t(cellEnd-cell);
+
+            cell=cellEnd;
+          }
+
+          run.clear();
+        };
+
+        if (partitions.empty()) {
+          // The first scan is sequential and splits the file into partitions,
+          // that the following scans read in parallel
+          CellRun run;
+          Object  obj;
+
+          scanner.Open(filename,
+                       FileScanner::Sequential,
+                       useMmap);
+
+          uint32_t objectCount=scanner.ReadUInt32();
+
+          for (uint32_t objI=1; objI <= objectCount; objI++) {
+            progress.SetProgress(objI, objectCount);
+
+            AddToDataPartitions(partitions,
+                                scanner.GetPos());
+
+            obj.Read(typeConfig,
+                     scanner);
+
+            collectCells(obj,run);
+
+            if (partitions.back().count==DATA_PARTITION_SIZE ||
+                objI==objectCount) {
+              std::sort(run.begin(),
+                        run.end());
+
+              countCells(run);
+            }
+          }
+
+          scanner.Close();
+        }
+        else {
+          std::vector<CellRun> runs(partitions.size());
+          std::mutex           countMutex;
+
+          ReadDataPartitions<Object>(typeConfig,
+                                     filename,
+                                     useMmap,
+                                     parameter.GetProcessingThreadCount(),
+                                     partitions,
+                                     progress,
+                                     [&collectCells,&runs](size_t partition,
+                                                           FileOffset /*offset*/,
+                                                           const Object& obj) {
+                                       collectCells(obj,runs[partition]);
+                                     },
+                                     [&countCells,&countMutex,&runs](size_t partition) {
+                                       std::sort(runs[partition].begin(),
+                                                 runs[partition].end());
+
+                                       std::scoped_lock<std::mutex> lock(countMutex);
+
+                                       countCells(runs[partition]);
+                                     });
         }
 
         // Check if cell fill for current type is in defined limits
@@ -602,11 +724,10 @@ namespace osmscout {
 
         level++;
       }
-
-      scanner.Close();
     }
     catch (IOException& e) {
       progress.Error(e.GetDescription());
+      scanner.CloseFailsafe();
       return false;
     }
 
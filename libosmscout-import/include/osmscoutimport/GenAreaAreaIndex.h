@@ -20,8 +20,11 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <osmscout/Area.h>
 #include <osmscout/Pixel.h>
@@ -55,6 +58,8 @@ namespace osmscout {
 
     using Level = std::map<Pixel, AreaLeaf>;
 
+    class AreaReader;
+
   private:
     std::list<SortDataGenerator<Area>::ProcessingFilterRef> filters;
 
@@ -64,9 +69,18 @@ namespace osmscout {
 
     void EnrichLevels(std::vector<Level>& levels);
 
+    static std::unordered_map<TypeId,std::list<FileOffset>> GetTypeOffsets(const AreaLeaf& leaf);
+
+    void CollectReadOrder(const ImportParameter& parameter,
+                          const std::vector<Level>& levels,
+                          size_t level,
+                          const Pixel& pixel,
+                          const AreaLeaf& leaf,
+                          std::vector<FileOffset>& readOrder) const;
+
     bool CopyData(const TypeConfig& typeConfig,
                   Progress& progress,
-                  FileScanner& scanner,
+                  AreaReader& reader,
                   FileWriter& dataWriter,
                   FileWriter& mapWriter,
                   const std::list<FileOffset>& srcOffsets,
@@ -76,7 +90,7 @@ namespace osmscout {
     bool WriteChildCells(const TypeConfig& typeConfig,
                          Progress& progress,
                          const ImportParameter& parameter,
-                         FileScanner& scanner,
+                         AreaReader& reader,
                          FileWriter& indexWriter,
                          FileWriter& dataWriter,
                          FileWriter& mapWriter,
@@ -89,7 +103,7 @@ namespace osmscout {
     bool WriteCell(const TypeConfig& typeConfig,
                    Progress& progress,
                    const ImportParameter& parameter,
-                   FileScanner& scanner,
+                   AreaReader& reader,
                    FileWriter& indexWriter,
                    FileWriter& dataWriter,
                    FileWriter& mapWriter,
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include <osmscoutimport/Import.h>
+#include <osmscoutimport/ParallelProcessing.h>
 
 #include <osmscout/system/Compiler.h>
 
@@ -73,7 +74,8 @@ namespace osmscout {
     bool AnalyseDistribution(const TypeConfigRef& typeConfig,
                              const ImportParameter& parameter,
                              Progress& progress,
-                             std::vector<DistributionData>& data);
+                             std::vector<DistributionData>& data,
+                             std::vector<DataPartition>& partitions);
     void DumpDistribution(Progress& progress,
                           const std::vector<DistributionData>& data);
 
@@ -110,7 +112,8 @@ namespace osmscout {
     bool WriteData(const TypeConfigRef& typeConfig,
                    const ImportParameter& parameter,
                    Progress& progress,
-                   const std::vector<DistributionData>& data);
+                   const std::vector<DistributionData>& data,
+                   const std::vector<DataPartition>& partitions);
 
   public:
     void GetDescription(const ImportParameter& parameter,
@@ -33,6 +33,9 @@
 
 #include <osmscout/TypeInfoSet.h>
 
+#include <osmscout/util/PackedRTree.h>
+#include <osmscout/util/PreparedPolygon.h>
+
 #include <osmscoutimport/Import.h>
 
 #include <osmscout/system/Compiler.h>
@@ -193,6 +196,7 @@ namespace osmscout {
       int8_t                             level{-1};          //!< Admin level or -1 if not set
 
       std::vector<std::vector<GeoCoord>> areas;              //!< the geometric area of this region
+      std::vector<PreparedPolygon>       preparedAreas;      //!< the areas prepared for fast containment tests
       std::list<RegionPOI>               pois;               //!< A list of POIs in this region
       PostalAreaMap                      postalAreas;        //!< Collection of objects without a postal code
       PostalAreaMap::iterator            defaultPostalArea;  //!< PostalArea for postal code ""
@@ -221,21 +225,15 @@ namespace osmscout {
       void AddAlias(const RegionAlias& location,
                     const GeoCoord& node);
 
-      void AddPOINode(const FileOffset& fileOffset,
-                      const std::string& name,
-                      bool& added);
+      void AddPOI(const ObjectFileRef& object,
+                  const std::string& name);
 
-      void AddPOIArea(const FileOffset& fileOffset,
-                      const std::string& name,
-                      const std::vector<Point>& nodes,
-                      const GeoBox& boundingBox,
-                      bool& added);
+      Region& GetEnclosingRegion(const std::vector<Point>& nodes,
+                                 const GeoBox& boundingBox);
 
-      bool AddPOIWay(const FileOffset& fileOffset,
-                     const std::string& name,
-                     const std::vector<Point>& nodes,
-                     const GeoBox& boundingBox,
-                     bool& added);
+      bool GetRegionsForWay(const std::vector<Point>& nodes,
+                            const GeoBox& boundingBox,
+                            std::vector<Region*>& result);
 
       void AddLocationObject(const std::string& name,
                              const std::string& postalCode,
@@ -247,11 +245,6 @@ namespace osmscout {
                            const std::string& postalCode,
                            const GeoBox& boundingBox);
 
-      bool AddLocationWay(const Way& way,
-                          const std::string& name,
-                          const std::string& postalCode,
-                          const GeoBox& boundingBox);
-
       bool AddRegion(const RegionRef& region,
                      bool assume_contains=true);
 
@@ -261,17 +254,18 @@ namespace osmscout {
                                        size_t refinement=0);
     };
 
+    /**
+     * Index for finding the smallest region containing a given coordinate, based on
+     * an R-tree over the bounding boxes of the areas of all regions.
+     */
     class RegionIndex CLASS_FINAL
     {
     private:
-      double                                cellWidth;
-      double                                cellHeight;
-      std::map<Pixel,std::list<RegionRef> > index;
+      std::vector<RegionRef> regions;     //!< All indexed regions, smaller regions first
+      std::vector<size_t>    areaRegions; //!< Index of the region in regions for each indexed area
+      PackedRTree            areaTree;    //!< R-tree over the bounding boxes of all areas
 
     public:
-      RegionIndex(double cellWidth,
-                  double cellheight);
-
       void IndexRegions(const std::vector<std::list<locidx::RegionRef> >& regionTree);
 
       RegionRef GetRegionForNode(const RegionRef& rootRegion,
@@ -383,31 +377,12 @@ namespace osmscout {
                             bool allowDuplicates,
                             bool& added);
 
-    void AddAddressAreaToRegion(Progress& progress,
-                                locidx::Region& region,
-                                const FileOffset& fileOffset,
-                                const std::string& location,
-                                const std::string& address,
-                                const std::string &postalCode,
-                                const std::vector<Point>& nodes,
-                                const GeoBox& boundingBox,
-                                bool& added);
-
     bool IndexAddressAreas(const TypeConfig& typeConfig,
                            const ImportParameter& parameter,
                            Progress& progress,
                            locidx::RegionRef& rootRegion,
                            const locidx::RegionIndex& regionIndex);
 
-    bool AddAddressWayToRegion(Progress& progress,
-                               locidx::Region& region,
-                               const FileOffset& fileOffset,
-                               const std::string& location,
-                               const std::string& address,
-                               const std::vector<Point>& nodes,
-                               const GeoBox& boundingBox,
-                               bool& added);
-
     bool IndexAddressWays(const TypeConfig& typeConfig,
                           const ImportParameter& parameter,
                           Progress& progress,
@@ -25,6 +25,7 @@
 #include <map>
 #include <unordered_map>
 
+#include <osmscoutimport/ArcTopology.h>
 #include <osmscoutimport/Import.h>
 
 #include <osmscout/TypeInfoSet.h>
@@ -115,7 +116,9 @@ namespace osmscout {
                        double dpi,
                        double pixel,
                        const Magnification& magnification,
-                       TransPolygon::OptimizeMethod optimizeAreaMethod);
+                       TransPolygon::OptimizeMethod optimizeAreaMethod,
+                       const ArcTopology* topology,
+                       size_t firstLine);
 
   public:
     void GetDescription(const ImportParameter& parameter,
@@ -27,6 +27,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <osmscoutimport/ArcTopology.h>
 #include <osmscoutimport/Import.h>
 
 #include <osmscout/Area.h>
@@ -107,7 +108,9 @@ namespace osmscout {
                       double dpi,
                       double pixel,
                       const Magnification& magnification,
-                      TransPolygon::OptimizeMethod optimizeWayMethod);
+                      TransPolygon::OptimizeMethod optimizeWayMethod,
+                      const ArcTopology* topology,
+                      size_t firstLine);
 
     void WriteWays(const TypeConfig& typeConfig,
                    FileWriter& writer,
@@ -23,8 +23,10 @@
 #include <osmscoutimport/Import.h>
 
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <osmscout/Area.h>
 
@@ -32,6 +34,7 @@
 
 #include <osmscout/util/Geometry.h>
 
+#include <osmscoutimport/ImportErrorReporter.h>
 #include <osmscoutimport/RawRelation.h>
 #include <osmscoutimport/RawRelIndexedDataFile.h>
 #include <osmscoutimport/RawWay.h>
@@ -180,6 +183,66 @@ namespace osmscout {
       }
     };
 
+    /**
+     * Collects the messages and relation error reports of one relation, so that they
+     * can be passed on in relation order after the relation has been assembled
+     */
+    class RelationProgress CLASS_FINAL : public Progress
+    {
+    private:
+      enum class MessageType {
+        debug,
+        info,
+        warning,
+        error,
+        relationReport
+      };
+
+      struct Message
+      {
+        MessageType type;
+        std::string text;
+        OSMId       id=0;        //!< Relation id of a relation report
+        TypeInfoRef objectType;  //!< Relation type of a relation report
+      };
+
+      std::vector<Message> messages;
+
+    public:
+      void Debug(const std::string& text) override;
+      void Info(const std::string& text) override;
+      void Warning(const std::string& text) override;
+      void Error(const std::string& text) override;
+
+      void ReportRelation(OSMId id,
+                          const TypeInfoRef& type,
+                          const std::string& error);
+
+      void Replay(Progress& progress,
+                  ImportErrorReporter& errorReporter) const;
+    };
+
+    /**
+     * A relation on its way through the pipeline of member loading, ring assembly and writing
+     */
+    struct RelationJob
+    {
+      size_t                      index=0;         //!< Index of the relation in the raw relation file
+      RawRelation                 rawRelation;
+      std::string                 name;
+      bool                        membersResolved=false;
+      std::list<MultipolygonPart> parts;           //!< Resolved members, cleared after assembly
+      Area                        relation;        //!< The resulting area
+      std::vector<OSMId>          areaWayIds;      //!< Ways that are part of the area and must not be indexed as areas themselves
+      bool                        write=false;     //!< The area is valid and should be written
+      RelationProgress            progress;
+    };
+
+    using RelationJobRef = std::shared_ptr<RelationJob>;
+
+    class MemberReader;
+    class RingAssembler;
+
   private:
     std::list<MultipolygonPart>::const_iterator FindTopLevel(const std::list<MultipolygonPart>& rings,
                                                              const GroupingState& state,
@@ -199,7 +262,7 @@ namespace osmscout {
 
     bool BuildRings(const TypeConfig& typeConfig,
                     const ImportParameter& parameter,
-                    Progress& progress,
+                    RelationProgress& progress,
                     OSMId id,
                     const std::string& name,
                     const TypeInfoRef& type,
@@ -207,7 +270,7 @@ namespace osmscout {
 
     bool ResolveMultipolygon(const TypeConfig& typeConfig,
                              const ImportParameter& parameter,
-                             Progress& progress,
+                             RelationProgress& progress,
                              OSMId id,
                              const std::string& name,
                              const TypeInfoRef& type,
@@ -245,20 +308,28 @@ namespace osmscout {
                                   std::list<MultipolygonPart>& parts);
 
     bool HandleMultipolygonRelation(const ImportParameter& parameter,
-                                    Progress& progress,
+                                    RelationProgress& progress,
                                     const TypeConfig& typeConfig,
-                                    IdSet& wayAreaIndexBlacklist,
-                                    CoordDataFile& coordDataFile,
-                                    RawWayIndexedDataFile& wayDataFile,
-                                    RawRelationIndexedDataFile& relDataFile,
-                                    RawRelation& rawRelation,
+                                    const RawRelation& rawRelation,
                                     const std::string& name,
+                                    std::list<MultipolygonPart>& parts,
+                                    std::vector<OSMId>& areaWayIds,
                                     Area& relation);
 
+    bool IsWritable(RelationProgress& progress,
+                    const RawRelation& rawRelation,
+                    const std::string& name,
+                    const Area& relation) const;
+
+    void AssembleRelation(const ImportParameter& parameter,
+                          const TypeConfig& typeConfig,
+                          RelationJob& job);
+
     std::string ResolveRelationName(const FeatureRef& featureName,
                                     const RawRelation& rawRelation) const;
 
     TypeInfoRef AutodetectRelationType(const ImportParameter& parameter,
+                                       RelationProgress& progress,
                                        const TypeConfig& typeConfig,
                                        const RawRelation& rawRelation,
                                        std::list<MultipolygonPart>& parts,
@@ -127,6 +127,7 @@ private:
   size_t                       sortTileMag;              //<! Zoom level for individual sorting cells
 
   size_t                       processingQueueSize;      //!< Size of the processing worker queues
+  size_t                       processingThreadCount;    //!< Number of threads of the parallel processing steps, 0 for one thread per core
 
   size_t                       numericIndexPageSize;     //<! Size of an numeric index page in bytes
 
@@ -176,6 +177,7 @@ private:
   size_t                       optimizationCellSizeAverage; //<! Average entries per index cell
   size_t                       optimizationCellSizeMax;  //<! Maximum number of entries  per index cell
   TransPolygon::OptimizeMethod optimizationWayMethod;    //<! what method to use to optimize ways
+  bool                         optimizationPreserveTopology; //<! Simplify shared borders of ways and areas identically
 
   size_t                       routeNodeBlockSize;       //<! Number of route nodes loaded during import until ways get resolved
   uint32_t                     routeNodeTileMag;         //<! Size of a routing tile
@@ -195,6 +197,8 @@ private:
 
   TextIndexVariant             textIndexVariant;
 
+  bool                         blockCoordEncoding;       //<! Store coordinates of ways and areas in the smaller, but slower to decode block encoding
+
 public:
   ImportParameter();
   virtual ~ImportParameter();
@@ -219,6 +223,7 @@ public:
   size_t GetSortTileMag() const;
 
   size_t GetProcessingQueueSize() const;
+  size_t GetProcessingThreadCount() const;
 
   size_t GetNumericIndexPageSize() const;
 
@@ -269,6 +274,7 @@ public:
   size_t GetOptimizationCellSizeAverage() const;
   size_t GetOptimizationCellSizeMax() const;
   TransPolygon::OptimizeMethod GetOptimizationWayMethod() const;
+  bool GetOptimizationPreserveTopology() const;
 
   size_t GetRouteNodeBlockSize() const;
   uint32_t GetRouteNodeTileMag() const;
@@ -303,6 +309,7 @@ public:
   void SetSortTileMag(size_t sortTileMag);
 
   void SetProcessingQueueSize(size_t processingQueueSize);
+  void SetProcessingThreadCount(size_t processingThreadCount);
 
   void SetNumericIndexPageSize(size_t numericIndexPageSize);
 
@@ -353,6 +360,7 @@ public:
   void SetOptimizationCellSizeAverage(size_t optimizationCellSizeAverage);
   void SetOptimizationCellSizeMax(size_t optimizationCellSizeMax);
   void SetOptimizationWayMethod(TransPolygon::OptimizeMethod optimizationWayMethod);
+  void SetOptimizationPreserveTopology(bool optimizationPreserveTopology);
 
   void SetRouteNodeBlockSize(size_t blockSize);
   void SetRouteNodeTileMag(uint32_t routeNodeTileMag);
@@ -377,6 +385,9 @@ public:
   void SetTextIndexVariant(TextIndexVariant textIndexVariant);
   TextIndexVariant GetTextIndexVariant() const;
 
+  void SetBlockCoordEncoding(bool blockCoordEncoding);
+  bool GetBlockCoordEncoding() const;
+
   static size_t GetDefaultStartStep();
   static size_t GetDefaultEndStep();
 };
@@ -0,0 +1,355 @@
+#ifndef OSMSCOUT_IMPORT_PARALLELPROCESSING_H
+#define OSMSCOUT_IMPORT_PARALLELPROCESSING_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/util/Progress.h>
+
+#include <osmscout/system/Compiler.h>
+
+#include <osmscoutimport/ImportImportExport.h>
+
+namespace osmscout {
+
+  /**
+   * Returns the number of threads to use for the given configured thread count
+   * (see ImportParameter::GetProcessingThreadCount()). 0 means one thread per core.
+   * The result of the import does not depend on the number of threads.
+   */
+  extern OSMSCOUT_IMPORT_API size_t GetProcessingThreadCount(size_t threadCount);
+
+  /**
+   * Progress collecting the messages of one strip of a parallel loop, so that
+   * they can be passed on in index order after the loop has finished
+   */
+  class BufferedProgress CLASS_FINAL : public Progress
+  {
+  private:
+    enum class MessageType {
+      debug,
+      info,
+      warning,
+      error
+    };
+
+    std::vector<std::pair<MessageType,std::string>> messages;
+
+  public:
+    void Debug(const std::string& text) override
+    {
+      messages.emplace_back(MessageType::debug,text);
+    }
+
+    void Info(const std::string& text) override
+    {
+      messages.emplace_back(MessageType::info,text);
+    }
+
+    void Warning(const std::string& text) override
+    {
+      messages.emplace_back(MessageType::warning,text);
+    }
+
+    void Error(const std::string& text) override
+    {
+      messages.emplace_back(MessageType::error,text);
+    }
+
+    void Replay(Progress& progress) const
+    {
+      for (const auto& [type,text] : messages) {
+        switch (type) {
+        case MessageType::debug:
+          progress.Debug(text);
+          break;
+        case MessageType::info:
+          progress.Info(text);
+          break;
+        case MessageType::warning:
+          progress.Warning(text);
+          break;
+        case MessageType::error:
+          progress.Error(text);
+          break;
+        }
+      }
+    }
+  };
+
+  /**
+   * Splits the index range [0,count) into strips of consecutive indexes and calls
+   * `stripFunction(strip,first,end)` for each strip. The strips are processed by
+   * GetProcessingThreadCount(threadCount) threads, the calling thread takes part. After each
+   * strip processed by the calling thread, `stripFinished(processed)` is called with
+   * the number of indexes processed by all threads so far.
+   *
+   * If `stripFunction` throws, no further strips are started. The exception is rethrown
+   * to the caller after all threads have finished their current strip.
+   */
+  template<typename StripFunction, typename StripFinished>
+  void ProcessStrips(size_t threadCount,
+                     size_t count,
+                     size_t stripSize,
+                     const StripFunction& stripFunction,
+                     const StripFinished& stripFinished)
+  {
+    size_t              threads=GetProcessingThreadCount(threadCount);
+    size_t              stripCount=(count+stripSize-1)/stripSize;
+    std::atomic<size_t> nextStrip(0);
+    std::atomic<size_t> processed(0);
+    std::atomic<bool>   cancelled(false);
+
+    auto processStrips=[&](bool callingThread) {
+      size_t strip;
+
+      while (!cancelled &&
+             (strip=nextStrip++)<stripCount) {
+        size_t end=std::min(count,(strip+1)*stripSize);
+
+        try {
+          stripFunction(strip,
+                        strip*stripSize,
+                        end);
+        }
+        catch (...) {
+          cancelled=true;
+          throw;
+        }
+
+        processed+=end-strip*stripSize;
+
+        if (callingThread) {
+          stripFinished(processed.load());
+        }
+      }
+    };
+
+    std::vector<std::future<void>> workers;
+
+    for (size_t t=1; t<std::min(threads,stripCount); t++) {
+      workers.push_back(std::async(std::launch::async,processStrips,false));
+    }
+
+    std::exception_ptr exception;
+
+    try {
+      processStrips(true);
+    }
+    catch (...) {
+      exception=std::current_exception();
+    }
+
+    for (auto& worker : workers) {
+      try {
+        worker.get();
+      }
+      catch (...) {
+        if (!exception) {
+          exception=std::current_exception();
+        }
+      }
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  /**
+   * Returns the strip size for processing count indexes in parallel with the
+   * given configured thread count
+   */
+  inline size_t GetStripSize(size_t threadCount,
+                             size_t count)
+  {
+    size_t threads=GetProcessingThreadCount(threadCount);
+
+    // More strips than threads, since the costs of the indexes differ a lot
+    return std::max(size_t(1),count/(threads*16));
+  }
+
+  /**
+   * Calls `function(index)` for all indexes in [0,count) using
+   * GetProcessingThreadCount(threadCount) threads.
+   *
+   * `function` must only modify state owned by its index.
+   */
+  template<typename Function>
+  void ProcessInStrips(size_t threadCount,
+                       size_t count,
+                       const Function& function)
+  {
+    ProcessStrips(threadCount,
+                  count,
+                  GetStripSize(threadCount,count),
+                  [&function](size_t /*strip*/, size_t first, size_t end) {
+                    for (size_t index=first; index<end; index++) {
+                      function(index);
+                    }
+                  },
+                  [](size_t /*processed*/) {
+                    // no code
+                  });
+  }
+
+  /**
+   * Calls `function(index,progress)` for all indexes in [0,count) using
+   * GetProcessingThreadCount(threadCount) threads. The calling thread reports the progress.
+   *
+   * `function` must only modify state owned by its index. Messages reported to the passed
+   * progress are forwarded to `progress` in index order after all strips are finished,
+   * so the log output does not depend on scheduling.
+   */
+  template<typename Function>
+  void ProcessInStrips(Progress& progress,
+                       size_t threadCount,
+                       size_t count,
+                       const Function& function)
+  {
+    size_t                        stripSize=GetStripSize(threadCount,count);
+    std::vector<BufferedProgress> stripProgress((count+stripSize-1)/stripSize);
+
+    ProcessStrips(threadCount,
+                  count,
+                  stripSize,
+                  [&function,&stripProgress](size_t strip, size_t first, size_t end) {
+                    for (size_t index=first; index<end; index++) {
+                      function(index,stripProgress[strip]);
+                    }
+                  },
+                  [&progress,count](size_t processed) {
+                    progress.SetProgress(processed,count);
+                  });
+
+    for (const auto& buffer : stripProgress) {
+      buffer.Replay(progress);
+    }
+  }
+
+  /**
+   * A range of consecutive objects in a data file
+   */
+  struct DataPartition
+  {
+    FileOffset offset; //!< File offset of the first object
+    uint32_t   count;  //!< Number of objects
+  };
+
+  /**
+   * Number of objects per data partition
+   */
+  static constexpr uint32_t DATA_PARTITION_SIZE=65536;
+
+  /**
+   * Adds the object at the given offset to the partitions, while reading a data file
+   * sequentially, so that later passes can read the file in parallel
+   */
+  inline void AddToDataPartitions(std::vector<DataPartition>& partitions,
+                                  FileOffset offset,
+                                  uint32_t partitionSize=DATA_PARTITION_SIZE)
+  {
+    if (partitions.empty() ||
+        partitions.back().count==partitionSize) {
+      partitions.push_back(DataPartition{offset,0});
+    }
+
+    partitions.back().count++;
+  }
+
+  /**
+   * Reads the given partitions of a data file using GetProcessingThreadCount(threadCount)
+   * threads, each partition with its own FileScanner. Calls
+   * `objectFunction(partition,offset,object)` for every object in file order of the
+   * partition and `partitionFinished(partition)` after the last object of a partition.
+   * The calling thread reports the progress.
+   *
+   * An exception of any partition stops the reading of the other partitions after
+   * their current object, `partitionFinished` is not called for them. The exception
+   * is thrown to the caller.
+   */
+  template<typename Object, typename ObjectFunction, typename PartitionFinished>
+  void ReadDataPartitions(const TypeConfig& typeConfig,
+                          const std::string& filename,
+                          bool useMmap,
+                          size_t threadCount,
+                          const std::vector<DataPartition>& partitions,
+                          Progress& progress,
+                          const ObjectFunction& objectFunction,
+                          const PartitionFinished& partitionFinished)
+  {
+    std::atomic<bool> cancelled(false);
+
+    ProcessStrips(threadCount,
+                  partitions.size(),
+                  1,
+                  [&](size_t partition, size_t /*first*/, size_t /*end*/) {
+                    FileScanner scanner;
+                    Object      object;
+
+                    try {
+                      scanner.Open(filename,
+                                   FileScanner::Sequential,
+                                   useMmap);
+
+                      scanner.SetPos(partitions[partition].offset);
+
+                      for (uint32_t i=0; i<partitions[partition].count && !cancelled; i++) {
+                        FileOffset offset=scanner.GetPos();
+
+                        object.Read(typeConfig,
+                                    scanner);
+
+                        objectFunction(partition,
+                                       offset,
+                                       object);
+                      }
+
+                      scanner.Close();
+                    }
+                    catch (...) {
+                      cancelled=true;
+                      scanner.CloseFailsafe();
+                      throw;
+                    }
+
+                    if (!cancelled) {
+                      partitionFinished(partition);
+                    }
+                  },
+                  [&progress,&partitions](size_t processed) {
+                    progress.SetProgress(processed,partitions.size());
+                  });
+  }
+}
+
+#endif
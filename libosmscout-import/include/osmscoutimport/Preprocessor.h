@@ -43,6 +43,12 @@ namespace osmscout {
 
       RawNodeData() = default;
 
+      explicit RawNodeData(std::pmr::memory_resource* resource)
+      : tags(resource)
+      {
+        // no code
+      }
+
       RawNodeData(OSMId id,
                   const GeoCoord& coord)
       : id(id),
@@ -57,6 +63,14 @@ namespace osmscout {
       OSMId              id;
       TagMap             tags;
       std::vector<OSMId> nodes;
+
+      RawWayData() = default;
+
+      explicit RawWayData(std::pmr::memory_resource* resource)
+      : tags(resource)
+      {
+        // no code
+      }
     };
 
     struct RawRelationData
@@ -64,10 +78,19 @@ namespace osmscout {
       OSMId                            id;
       TagMap                           tags;
       std::vector<RawRelation::Member> members;
+
+      RawRelationData() = default;
+
+      explicit RawRelationData(std::pmr::memory_resource* resource)
+      : tags(resource)
+      {
+        // no code
+      }
     };
 
     struct RawBlockData
     {
+      TagValuePool                 tagValues;    //!< Storage for tag values referenced by the objects, must be destroyed last
       std::vector<RawNodeData>     nodeData;
       std::vector<RawWayData>      wayData;
       std::vector<RawRelationData> relationData;
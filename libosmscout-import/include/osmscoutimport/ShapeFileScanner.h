@@ -52,6 +52,9 @@ namespace osmscout {
   /**
    * Class for reading shape files
    *
+   * The file is streamed record by record. Each record is read with one call
+   * and decoded from memory.
+   *
    * Shape file basic types:
    * Integer: Signed 32-bit integer (4 bytes)
    * Double: Signed 64-bit IEEE double-precision floating point number (8 bytes)
@@ -61,13 +64,11 @@ namespace osmscout {
   private:
     std::string           filename;
     FILE                  *file;
+    std::vector<uint8_t>  data;   //!< Raw content of the current header or record
     std::vector<GeoCoord> buffer;
 
   private:
-    uint8_t ReadByte();
-    int32_t ReadIntegerBE();
-    int32_t ReadIntegerLE();
-    double ReadDoubleLE();
+    const uint8_t* ReadBlock(size_t size);
 
   public:
     explicit ShapeFileScanner(const std::string& filename);
@@ -408,6 +408,9 @@ namespace osmscout {
       }
     };
 
+  private:
+    size_t threadCount; //!< Number of threads of the parallel processing steps, 0 for one thread per core
+
   private:
     std::string StateToString(State state) const;
     std::string TypeToString(GroundTile::Type type) const;
@@ -609,15 +612,23 @@ namespace osmscout {
                                std::list<CoastRef>& synthesized);
 
     /**
-     * Generate all ground tiles (store to `cellGroundTileMap`) for given `cell`.
+     * Generate all ground tiles (store to `groundTiles`) for given `cell`.
+     *
+     * Only reads `data`, so it may be called for different cells in parallel.
      */
     void HandleCoastlineCell(Progress& progress,
                              const Pixel &cell,
                              const std::list<size_t>& intersectCoastlines,
                              const StateMap& stateMap,
-                             std::map<Pixel,std::list<GroundTile> >& cellGroundTileMap,
+                             std::list<GroundTile>& groundTiles,
                              Data& data);
 
+    CoastlineDataRef TransformCoastline(TransPolygon::OptimizeMethod optimizationMethod,
+                                        double tolerance,
+                                        double minObjectDimension,
+                                        const Projection& projection,
+                                        const Coast& coast);
+
     void TransformCoastlines(Progress& progress,
                              TransPolygon::OptimizeMethod optimizationMethod,
                              double tolerance,
@@ -638,11 +649,18 @@ namespace osmscout {
                            std::vector<CoastlineDataRef> &transformedCoastlines);
 
       /**
-       * Comparator of coastline size (GeoBox::GetSize) for descending sort
+       * Comparator of coastline size (GeoBox::GetSize) for descending sort, coastlines of
+       * the same size are ordered by id
        */
     static bool CoastlineGeoSizeSorter(const CoastlineDataRef &a, const CoastlineDataRef &b);
 
 public:
+    explicit WaterIndexProcessor(size_t threadCount=0)
+    : threadCount(threadCount)
+    {
+      // no code
+    }
+
     /**
      * Merge short coastline ways to bigger one and create areas if possible.
      */
@@ -0,0 +1,393 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutimport/ArcTopology.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+#include <osmscoutimport/ParallelProcessing.h>
+
+namespace osmscout {
+
+  namespace {
+    struct NodeState
+    {
+      Id   first;    //!< Smaller key of the neighbours at the first occurrence
+      Id   second;   //!< Bigger key of the neighbours at the first occurrence
+      bool junction;
+    };
+
+    void AddOccurrence(std::unordered_map<Id,NodeState>& nodes,
+                       Id key,
+                       Id previous,
+                       Id next)
+    {
+      Id first=std::min(previous,next);
+      Id second=std::max(previous,next);
+
+      auto [entry,inserted]=nodes.try_emplace(key,NodeState{first,second,false});
+
+      if (!inserted &&
+          (entry->second.first!=first || entry->second.second!=second)) {
+        entry->second.junction=true;
+      }
+    }
+
+    void AddJunction(std::unordered_map<Id,NodeState>& nodes,
+                     Id key)
+    {
+      nodes[key].junction=true;
+    }
+
+    Id GetArcHash(const std::vector<Id>& keys)
+    {
+      Id hash=keys.size();
+
+      for (Id key : keys) {
+        hash^=key+0x9e3779b97f4a7c15ULL+(hash << 6u)+(hash >> 2u);
+      }
+
+      return hash;
+    }
+
+    double GetTriangleArea(const std::vector<double>& x,
+                           const std::vector<double>& y,
+                           size_t a,
+                           size_t b,
+                           size_t c)
+    {
+      return std::fabs((x[b]-x[a])*(y[c]-y[a])-(x[c]-x[a])*(y[b]-y[a]))/2.0;
+    }
+
+    /**
+     * Visvalingam-Whyatt: repeatedly removes the node forming the smallest triangle with
+     * its remaining neighbours. The effective area of a node is the area of its triangle at
+     * the time of removal, but at least the effective area of the nodes removed before, so
+     * that dropping all nodes below a threshold yields the same result as the iteration.
+     */
+    void CalculateVisvalingamWhyattAreas(const std::vector<double>& x,
+                                         const std::vector<double>& y,
+                                         std::vector<double>& effectiveAreas)
+    {
+      struct Entry
+      {
+        double area;
+        size_t index;
+
+        bool operator<(const Entry& other) const
+        {
+          // Smallest area first, ties in node order to stay deterministic
+          if (area!=other.area) {
+            return area>other.area;
+          }
+
+          return index>other.index;
+        }
+      };
+
+      size_t              count=x.size();
+      std::vector<size_t> previous(count);
+      std::vector<size_t> next(count);
+      std::vector<double> areas(count,std::numeric_limits<double>::infinity());
+      std::priority_queue<Entry> queue;
+
+      for (size_t i=1; i+1<count; i++) {
+        previous[i]=i-1;
+        next[i]=i+1;
+        areas[i]=GetTriangleArea(x,y,i-1,i,i+1);
+        queue.push(Entry{areas[i],i});
+      }
+
+      effectiveAreas=areas;
+
+      double maxArea=0.0;
+
+      while (!queue.empty()) {
+        Entry entry=queue.top();
+
+        queue.pop();
+
+        // Outdated entry of a node already removed or recalculated
+        if (entry.area!=areas[entry.index] ||
+            std::isinf(areas[entry.index])) {
+          continue;
+        }
+
+        maxArea=std::max(maxArea,entry.area);
+        effectiveAreas[entry.index]=maxArea;
+        areas[entry.index]=std::numeric_limits<double>::infinity();
+
+        size_t p=previous[entry.index];
+        size_t n=next[entry.index];
+
+        next[p]=n;
+        previous[n]=p;
+
+        if (p>0) {
+          areas[p]=GetTriangleArea(x,y,previous[p],p,n);
+          queue.push(Entry{areas[p],p});
+        }
+
+        if (n+1<count) {
+          areas[n]=GetTriangleArea(x,y,p,n,next[n]);
+          queue.push(Entry{areas[n],n});
+        }
+      }
+    }
+  }
+
+  size_t ArcTopology::AddLine(const std::vector<Point>& nodes,
+                              bool closed)
+  {
+    Line line;
+
+    line.closed=closed;
+    line.nodeMap.reserve(nodes.size());
+    line.keys.reserve(nodes.size());
+    line.coords.reserve(nodes.size());
+
+    for (const auto& node : nodes) {
+      Id key=node.GetCoord().GetHash();
+
+      if (line.keys.empty() ||
+          line.keys.back()!=key) {
+        line.keys.push_back(key);
+        line.coords.push_back(node.GetCoord());
+      }
+
+      line.nodeMap.push_back(uint32_t(line.keys.size()-1));
+    }
+
+    // The ring may repeat its first node at the end
+    if (closed &&
+        line.keys.size()>1 &&
+        line.keys.front()==line.keys.back()) {
+      line.keys.pop_back();
+      line.coords.pop_back();
+
+      for (auto& index : line.nodeMap) {
+        if (index==line.keys.size()) {
+          index=0;
+        }
+      }
+    }
+
+    line.size=line.keys.size();
+    line.trivial=closed ? line.size<3 : line.size<2;
+
+    lines.push_back(std::move(line));
+
+    return lines.size()-1;
+  }
+
+  void ArcTopology::Build()
+  {
+    std::unordered_map<Id,NodeState> nodes;
+
+    for (const auto& line : lines) {
+      if (line.trivial) {
+        continue;
+      }
+
+      size_t size=line.size;
+
+      for (size_t i=0; i<size; i++) {
+        if (line.closed) {
+          AddOccurrence(nodes,
+                        line.keys[i],
+                        line.keys[(i+size-1)%size],
+                        line.keys[(i+1)%size]);
+        }
+        else if (i==0 || i+1==size) {
+          AddJunction(nodes,
+                      line.keys[i]);
+        }
+        else {
+          AddOccurrence(nodes,
+                        line.keys[i],
+                        line.keys[i-1],
+                        line.keys[i+1]);
+        }
+      }
+    }
+
+    // Rings without any junction are only shared with identical rings, they all
+    // start their arc at the node with the smallest key
+    for (const auto& line : lines) {
+      if (line.trivial ||
+          !line.closed) {
+        continue;
+      }
+
+      bool hasJunction=std::any_of(line.keys.begin(),
+                                   line.keys.end(),
+                                   [&nodes](Id key) {
+                                     return nodes[key].junction;
+                                   });
+
+      if (!hasJunction) {
+        AddJunction(nodes,
+                    *std::min_element(line.keys.begin(),line.keys.end()));
+      }
+    }
+
+    std::unordered_map<Id,std::vector<uint32_t>> arcsByHash;
+    std::vector<std::vector<Id>>                 arcKeys;
+
+    for (auto& line : lines) {
+      if (line.trivial) {
+        line.keys.clear();
+        line.keys.shrink_to_fit();
+        line.coords.clear();
+        line.coords.shrink_to_fit();
+        continue;
+      }
+
+      size_t size=line.size;
+
+      line.start=0;
+
+      if (line.closed) {
+        while (!nodes[line.keys[line.start]].junction) {
+          line.start++;
+        }
+      }
+
+      size_t first=line.start;
+      size_t end=line.closed ? line.start+size : size-1;
+
+      while (first<end) {
+        size_t last=first+1;
+
+        while (last<end &&
+               !nodes[line.keys[last%size]].junction) {
+          last++;
+        }
+
+        std::vector<Id>       keys;
+        std::vector<GeoCoord> coords;
+
+        keys.reserve(last-first+1);
+        coords.reserve(last-first+1);
+
+        for (size_t i=first; i<=last; i++) {
+          keys.push_back(line.keys[i%size]);
+          coords.push_back(line.coords[i%size]);
+        }
+
+        // Shared arcs are stored in the lexicographically smaller direction
+        bool reversed=std::lexicographical_compare(keys.rbegin(),keys.rend(),
+                                                   keys.begin(),keys.end());
+
+        if (reversed) {
+          std::reverse(keys.begin(),keys.end());
+          std::reverse(coords.begin(),coords.end());
+        }
+
+        auto&    candidates=arcsByHash[GetArcHash(keys)];
+        uint32_t arcIndex=uint32_t(arcs.size());
+
+        for (uint32_t candidate : candidates) {
+          if (arcKeys[candidate]==keys) {
+            arcIndex=candidate;
+            break;
+          }
+        }
+
+        if (arcIndex==arcs.size()) {
+          candidates.push_back(arcIndex);
+          arcKeys.push_back(std::move(keys));
+          arcs.push_back(Arc{std::move(coords),{}});
+        }
+
+        line.arcs.push_back(ArcRef{arcIndex,reversed});
+
+        first=last;
+      }
+
+      line.keys.clear();
+      line.keys.shrink_to_fit();
+      line.coords.clear();
+      line.coords.shrink_to_fit();
+    }
+  }
+
+  void ArcTopology::CalculateEffectiveAreas(const Projection& projection,
+                                            size_t threadCount)
+  {
+    ProcessInStrips(threadCount,
+                    arcs.size(),
+                    [this,&projection](size_t index) {
+                      Arc&                arc=arcs[index];
+                      std::vector<double> x(arc.coords.size());
+                      std::vector<double> y(arc.coords.size());
+
+                      for (size_t i=0; i<arc.coords.size(); i++) {
+                        Vertex2D pixel;
+
+                        projection.GeoToPixel(arc.coords[i],pixel);
+                        x[i]=pixel.GetX();
+                        y[i]=pixel.GetY();
+                      }
+
+                      CalculateVisvalingamWhyattAreas(x,
+                                                      y,
+                                                      arc.effectiveAreas);
+                    });
+  }
+
+  void ArcTopology::GetNodesToKeep(size_t lineIndex,
+                                   double minArea,
+                                   std::vector<bool>& keep) const
+  {
+    const Line& line=lines[lineIndex];
+
+    keep.assign(line.nodeMap.size(),true);
+
+    if (line.trivial) {
+      return;
+    }
+
+    std::vector<bool> keepNode(line.size,false);
+    size_t            position=line.start;
+
+    for (const auto& ref : line.arcs) {
+      const Arc& arc=arcs[ref.arc];
+      size_t     count=arc.effectiveAreas.size();
+
+      for (size_t i=0; i<count; i++) {
+        size_t arcNode=ref.reversed ? count-1-i : i;
+
+        if (arc.effectiveAreas[arcNode]>=minArea) {
+          keepNode[(position+i)%line.size]=true;
+        }
+      }
+
+      position+=count-1;
+    }
+
+    for (size_t i=0; i<line.nodeMap.size(); i++) {
+      keep[i]=keepNode[line.nodeMap[i]];
+    }
+  }
+}
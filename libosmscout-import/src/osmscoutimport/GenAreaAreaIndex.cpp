@@ -19,6 +19,7 @@
 
 #include <osmscoutimport/GenAreaAreaIndex.h>
 
+#include <future>
 #include <numeric>
 #include <vector>
 
@@ -38,6 +39,7 @@
 #include <osmscout/util/Geometry.h>
 
 #include <osmscoutimport/GenOptimizeAreaWayIds.h>
+#include <osmscoutimport/ParallelProcessing.h>
 
 namespace osmscout {
 
@@ -501,6 +503,132 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Reads the areas of the source file in the order they are written to the data file.
+   * Batches of areas are read in parallel, while the areas of the previous batch are
+   * written.
+   */
+  class AreaAreaIndexGenerator::AreaReader CLASS_FINAL
+  {
+  public:
+    struct Record
+    {
+      FileOffset offset;
+      uint8_t    objectType;
+      Id         id;
+      Area       area;
+    };
+
+  private:
+    static constexpr size_t BATCH_SIZE=10000;
+
+  private:
+    const TypeConfig&                    typeConfig;
+    std::string                          filename;
+    bool                                 useMmap;
+    size_t                               threadCount;
+    std::vector<FileOffset>              readOrder;
+    size_t                               nextBatchStart=0;
+    std::vector<Record>                  batch;
+    size_t                               nextRecord=0;
+    std::future<std::vector<Record>>     nextBatch;
+
+  private:
+    std::vector<Record> ReadBatch(size_t start) const
+    {
+      std::vector<Record> records(std::min(BATCH_SIZE,readOrder.size()-start));
+
+      ProcessStrips(threadCount,
+                    records.size(),
+                    GetStripSize(threadCount,records.size()),
+                    [this,start,&records](size_t /*strip*/, size_t first, size_t end) {
+                      FileScanner scanner;
+
+                      try {
+                        scanner.Open(filename,
+                                     FileScanner::FastRandom,
+                                     useMmap);
+
+                        for (size_t i=first; i<end; i++) {
+                          Record& record=records[i];
+
+                          record.offset=readOrder[start+i];
+
+                          scanner.SetPos(record.offset);
+
+                          record.objectType=scanner.ReadUInt8();
+                          record.id=scanner.ReadUInt64();
+
+                          record.area.Read(typeConfig,
+                                           scanner);
+                        }
+
+                        scanner.Close();
+                      }
+                      catch (IOException&) {
+                        scanner.CloseFailsafe();
+                        throw;
+                      }
+                    },
+                    [](size_t /*processed*/) {
+                      // no code
+                    });
+
+      return records;
+    }
+
+    void StartNextBatch()
+    {
+      if (nextBatchStart>=readOrder.size()) {
+        return;
+      }
+
+      nextBatch=std::async(std::launch::async,
+                           &AreaReader::ReadBatch,
+                           this,
+                           nextBatchStart);
+
+      nextBatchStart+=BATCH_SIZE;
+    }
+
+  public:
+    AreaReader(const TypeConfig& typeConfig,
+               const std::string& filename,
+               bool useMmap,
+               size_t threadCount,
+               std::vector<FileOffset>&& readOrder)
+    : typeConfig(typeConfig),
+      filename(filename),
+      useMmap(useMmap),
+      threadCount(threadCount),
+      readOrder(std::move(readOrder))
+    {
+      StartNextBatch();
+    }
+
+    ~AreaReader()
+    {
+      if (nextBatch.valid()) {
+        nextBatch.wait();
+      }
+    }
+
+    /**
+     * Returns the next area in read order, throws an IOException if reading fails
+     */
+    Record& Next()
+    {
+      if (nextRecord>=batch.size()) {
+        batch=nextBatch.get();
+        nextRecord=0;
+
+        StartNextBatch();
+      }
+
+      return batch[nextRecord++];
+    }
+  };
+
   void AreaAreaIndexGenerator::GetDescription(const ImportParameter& /*parameter*/,
                                              ImportModuleDescription& description) const
   {
@@ -556,9 +684,59 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Groups the areas of the leaf by their type
+   */
+  std::unordered_map<TypeId,std::list<FileOffset>> AreaAreaIndexGenerator::GetTypeOffsets(const AreaLeaf& leaf)
+  {
+    std::unordered_map<TypeId,std::list<FileOffset>> offsetsTypeMap;
+
+    for (const auto& entry : leaf.areas) {
+      offsetsTypeMap[entry.type].push_back(entry.offset);
+    }
+
+    return offsetsTypeMap;
+  }
+
+  /**
+   * Collects the offsets of the areas in the order WriteCell() copies them
+   */
+  void AreaAreaIndexGenerator::CollectReadOrder(const ImportParameter& parameter,
+                                                const std::vector<Level>& levels,
+                                                size_t level,
+                                                const Pixel& pixel,
+                                                const AreaLeaf& leaf,
+                                                std::vector<FileOffset>& readOrder) const
+  {
+    if (level<parameter.GetAreaAreaIndexMaxMag()) {
+      // top left, top right, bottom left, bottom right
+      for (const Pixel& childPixel : {Pixel(pixel.x*2,pixel.y*2+1),
+                                      Pixel(pixel.x*2+1,pixel.y*2+1),
+                                      Pixel(pixel.x*2,pixel.y*2),
+                                      Pixel(pixel.x*2+1,pixel.y*2)}) {
+        auto childCell=levels[level+1].find(childPixel);
+
+        if (childCell!=levels[level+1].end()) {
+          CollectReadOrder(parameter,
+                           levels,
+                           level+1,
+                           childPixel,
+                           childCell->second,
+                           readOrder);
+        }
+      }
+    }
+
+    for (const auto& entry : GetTypeOffsets(leaf)) {
+      readOrder.insert(readOrder.end(),
+                       entry.second.begin(),
+                       entry.second.end());
+    }
+  }
+
   bool AreaAreaIndexGenerator::CopyData(const TypeConfig& typeConfig,
                                         Progress& progress,
-                                        FileScanner& scanner,
+                                        AreaReader& reader,
                                         FileWriter& dataWriter,
                                         FileWriter& mapWriter,
                                         const std::list<FileOffset>& srcOffsets,
@@ -567,17 +745,14 @@ namespace osmscout {
   {
     dataStartOffset=0;
 
-    for (FileOffset srcOffset : srcOffsets) {
-      Area area;
-      bool save=true;
-
-      scanner.SetPos(srcOffset);
+    for ([[maybe_unused]] FileOffset srcOffset : srcOffsets) {
+      AreaReader::Record& record=reader.Next();
+      Area&               area=record.area;
+      uint8_t             objectType=record.objectType;
+      Id                  id=record.id;
+      bool                save=true;
 
-      uint8_t objectType=scanner.ReadUInt8();
-      Id      id=scanner.ReadUInt64();
-
-      area.Read(typeConfig,
-                scanner);
+      assert(record.offset==srcOffset);
 
       //  std::cout << (size_t)objectType << " " << id << " " << area.GetType()->GetName() << " " << area.GetType()->GetIndex() << std::endl;
 
@@ -623,7 +798,7 @@ namespace osmscout {
   bool AreaAreaIndexGenerator::WriteChildCells(const TypeConfig& typeConfig,
                                                Progress& progress,
                                                const ImportParameter& parameter,
-                                               FileScanner& scanner,
+                                               AreaReader& reader,
                                                FileWriter& indexWriter,
                                                FileWriter& dataWriter,
                                                FileWriter& mapWriter,
@@ -642,7 +817,7 @@ namespace osmscout {
       if (!WriteCell(typeConfig,
                      progress,
                      parameter,
-                     scanner,
+                     reader,
                      indexWriter,
                      dataWriter,
                      mapWriter,
@@ -665,7 +840,7 @@ namespace osmscout {
       if (!WriteCell(typeConfig,
                      progress,
                      parameter,
-                     scanner,
+                     reader,
                      indexWriter,
                      dataWriter,
                      mapWriter,
@@ -688,7 +863,7 @@ namespace osmscout {
       if (!WriteCell(typeConfig,
                      progress,
                      parameter,
-                     scanner,
+                     reader,
                      indexWriter,
                      dataWriter,
                      mapWriter,
@@ -711,7 +886,7 @@ namespace osmscout {
       if (!WriteCell(typeConfig,
                      progress,
                      parameter,
-                     scanner,
+                     reader,
                      indexWriter,
                      dataWriter,
                      mapWriter,
@@ -757,7 +932,7 @@ namespace osmscout {
   bool AreaAreaIndexGenerator::WriteCell(const TypeConfig& typeConfig,
                                          Progress& progress,
                                          const ImportParameter& parameter,
-                                         FileScanner& scanner,
+                                         AreaReader& reader,
                                          FileWriter& indexWriter,
                                          FileWriter& dataWriter,
                                          FileWriter& mapWriter,
@@ -772,7 +947,7 @@ namespace osmscout {
       if (!WriteChildCells(typeConfig,
                            progress,
                            parameter,
-                           scanner,
+                           reader,
                            indexWriter,
                            dataWriter,
                            mapWriter,
@@ -788,11 +963,8 @@ namespace osmscout {
       dataStartOffset=indexWriter.GetPos();
     }
 
-    std::unordered_map<TypeId,std::list<FileOffset>> offsetsTypeMap;
-
-    for (const auto& entry : leaf.areas) {
-      offsetsTypeMap[entry.type].push_back(entry.offset);
-    }
+    // Same order as in CollectReadOrder()
+    std::unordered_map<TypeId,std::list<FileOffset>> offsetsTypeMap=GetTypeOffsets(leaf);
 
     // Number of types
     indexWriter.WriteNumber((uint32_t)offsetsTypeMap.size());
@@ -806,7 +978,7 @@ namespace osmscout {
       // The index reading code has to handle this!
       CopyData(typeConfig,
                progress,
-               scanner,
+               reader,
                dataWriter,
                mapWriter,
                entry.second,
@@ -908,6 +1080,24 @@ namespace osmscout {
         progress.Info("Level "+std::to_string(i)+" has " + std::to_string(levels[i].size())+" entries");
       }
 
+      std::string             areasFilename=scanner.GetFilename();
+      std::vector<FileOffset> readOrder;
+
+      scanner.Close();
+
+      CollectReadOrder(parameter,
+                       levels,
+                       0,
+                       Pixel(0,0),
+                       levels[0][Pixel(0,0)],
+                       readOrder);
+
+      AreaReader reader(*typeConfig,
+                        areasFilename,
+                        parameter.GetWayDataMemoryMaped(),
+                        parameter.GetProcessingThreadCount(),
+                        std::move(readOrder));
+
       //
       // Writing index, data and idmap files
       //
@@ -933,6 +1123,7 @@ namespace osmscout {
 
       dataWriter.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                       AreaDataFile::AREAS_DAT));
+      dataWriter.SetBlockCoordEncoding(parameter.GetBlockCoordEncoding());
 
       dataWriter.Write(overallDataCount);
 
@@ -949,7 +1140,7 @@ namespace osmscout {
       if (!WriteCell(*typeConfig,
                      progress,
                      parameter,
-                     scanner,
+                     reader,
                      indexWriter,
                      dataWriter,
                      mapWriter,
@@ -979,7 +1170,6 @@ namespace osmscout {
 
       progress.Info(std::to_string(overallDataCount) + " object(s) written to file '"+dataWriter.GetFilename()+"'");
 
-      scanner.Close();
       indexWriter.Close();
       dataWriter.Close();
       mapWriter.Close();
@@ -19,6 +19,7 @@
 
 #include <osmscoutimport/GenAreaNodeIndex.h>
 
+#include <algorithm>
 #include <numeric>
 
 #include <osmscout/Node.h>
@@ -36,6 +37,33 @@
 
 namespace osmscout {
 
+  /**
+   * Number of data partitions per thread, that are read at once while collecting tile data
+   */
+  static const size_t TILE_DATA_PARTITION_WINDOW=4;
+
+  /**
+   * Node of a type with a simple list index
+   */
+  struct ListEntry
+  {
+    TypeId     typeId;
+    GeoCoord   coord;
+    FileOffset offset;
+  };
+
+  /**
+   * Node of a type with a complex index
+   */
+  struct TileEntry
+  {
+    TypeId                            typeId;
+    AreaNodeIndexGenerator::IndexType indexType;
+    TileId                            tileId;
+    GeoCoord                          coord;
+    FileOffset                        offset;
+  };
+
   /**
    * Count the number of types for that we have found data for.
    *
@@ -143,7 +171,8 @@ namespace osmscout {
   bool AreaNodeIndexGenerator::AnalyseDistribution(const TypeConfigRef& typeConfig,
                                                    const ImportParameter& parameter,
                                                    Progress& progress,
-                                                   std::vector<DistributionData>& data)
+                                                   std::vector<DistributionData>& data,
+                                                   std::vector<DataPartition>& partitions)
   {
     data.resize(typeConfig->GetNodeTypes().size()+1);
 
@@ -168,6 +197,9 @@ namespace osmscout {
 
         Node node;
 
+        AddToDataPartitions(partitions,
+                            nodeScanner.GetPos());
+
         node.Read(*typeConfig,
                   nodeScanner);
 
@@ -518,19 +550,16 @@ namespace osmscout {
   bool AreaNodeIndexGenerator::WriteData(const TypeConfigRef& typeConfig,
                                          const ImportParameter& parameter,
                                          Progress& progress,
-                                         const std::vector<DistributionData>& data)
+                                         const std::vector<DistributionData>& data,
+                                         const std::vector<DataPartition>& partitions)
   {
     progress.SetAction("Generating 'areanode.idx'");
 
     try {
-      FileScanner nodeScanner;
       FileWriter  writer;
       auto        level=parameter.GetAreaNodeGridMag();
-
-      nodeScanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
-                                       NodeDataFile::NODES_DAT),
-                       FileScanner::Sequential,
-                       true);
+      std::string nodesFilename=AppendFileToDir(parameter.GetDestinationDirectory(),
+                                                NodeDataFile::NODES_DAT);
 
       writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                   AreaNodeIndex::AREA_NODE_IDX));
@@ -561,26 +590,39 @@ namespace osmscout {
       //
 
       std::vector<std::list<std::pair<GeoCoord,FileOffset>>> listData(data.size());
-
-      nodeScanner.GotoBegin();
-      uint32_t nodeCount=nodeScanner.ReadUInt32();
+      std::vector<std::vector<ListEntry>>                    partitionListData(partitions.size());
 
       //
       // Collect all node offsets for each bitmap cell for all current types
       //
-      for (uint32_t n=1; n<=nodeCount; n++) {
-        progress.SetProgress(n,nodeCount);
-
-        Node node;
-
-        node.Read(*typeConfig,
-                  nodeScanner);
-
-        auto typeId=node.GetType()->GetNodeId();
-
-        if (!data[typeId].IsComplexIndex()) {
-          listData[typeId].emplace_back(node.GetCoords(), node.GetFileOffset());
+      ReadDataPartitions<Node>(*typeConfig,
+                               nodesFilename,
+                               true,
+                               parameter.GetProcessingThreadCount(),
+                               partitions,
+                               progress,
+                               [&data,&partitionListData](size_t partition,
+                                                          FileOffset /*offset*/,
+                                                          const Node& node) {
+                                 auto typeId=node.GetType()->GetNodeId();
+
+                                 if (!data[typeId].IsComplexIndex()) {
+                                   partitionListData[partition].push_back(ListEntry{typeId,
+                                                                                    node.GetCoords(),
+                                                                                    node.GetFileOffset()});
+                                 }
+                               },
+                               [](size_t /*partition*/) {
+                                 // no code
+                               });
+
+      // Partitions are in file order
+      for (auto& entries : partitionListData) {
+        for (const auto& entry : entries) {
+          listData[entry.typeId].emplace_back(entry.coord,entry.offset);
         }
+
+        entries=std::vector<ListEntry>();
       }
 
       //
@@ -603,65 +645,87 @@ namespace osmscout {
       progress.Info("Writing tile list and bitmap index data");
 
       std::vector<std::map<TileId,std::list<std::pair<GeoCoord,FileOffset>>>> tileData(data.size());
-
-      nodeScanner.GotoBegin();
-
-      nodeCount=nodeScanner.ReadUInt32();
+      size_t                                                                 windowSize=TILE_DATA_PARTITION_WINDOW*
+                                                                                        GetProcessingThreadCount(parameter.GetProcessingThreadCount());
 
       //
-      // Collect all node offsets for each tile for all current types
+      // Collect all node offsets for each tile for all current types. The nodes are read
+      // in parallel in windows of partitions, the tiles are written in file order, as soon
+      // as all their nodes are collected.
       //
-      for (uint32_t n=1; n<=nodeCount; n++) {
-        progress.SetProgress(n,nodeCount);
-
-        Node node;
-
-        node.Read(*typeConfig,
-                  nodeScanner);
-
-        auto typeId=node.GetType()->GetNodeId();
-
-        if (!data[typeId].IsComplexIndex()) {
-          continue;
-        }
-
-        auto tileId=TileId::GetTile(level,node.GetCoords());
-
-        IndexType indexType;
-
-        if (data[typeId].listTiles.find(tileId)!=data[typeId].listTiles.end()) {
-          indexType=IndexType::IndexTypeList;
-        }
-        else if (data[typeId].bitmapTiles.find(tileId)!=data[typeId].bitmapTiles.end()) {
-          indexType=IndexType::IndexTypeBitmap;
-        }
-        else {
-          continue;
-        }
-
-        tileData[typeId][tileId].emplace_back(node.GetCoords(), node.GetFileOffset());
-
-        if (tileData[typeId][tileId].size()==data[typeId].tileFillCount.find(tileId)->second) {
-          if (indexType==IndexType::IndexTypeList) {
-            WriteTileListData(parameter,
-                              data[typeId],
-                              tileData[typeId][tileId],
-                              tileIndexOffsets[typeId][tileId],
-                              writer);
-          }
-          else {
-            WriteBitmapData(parameter,
-                            tileId,
-                            tileData[typeId][tileId],
-                            bitmapIndexOffsets[typeId][tileId],
-                            writer);
+      for (size_t windowStart=0; windowStart<partitions.size(); windowStart+=windowSize) {
+        std::vector<DataPartition>          window(partitions.begin()+windowStart,
+                                                   partitions.begin()+std::min(windowStart+windowSize,
+                                                                               partitions.size()));
+        std::vector<std::vector<TileEntry>> partitionTileData(window.size());
+
+        ReadDataPartitions<Node>(*typeConfig,
+                                 nodesFilename,
+                                 true,
+                                 parameter.GetProcessingThreadCount(),
+                                 window,
+                                 progress,
+                                 [&data,&level,&partitionTileData](size_t partition,
+                                                                   FileOffset /*offset*/,
+                                                                   const Node& node) {
+                                   auto typeId=node.GetType()->GetNodeId();
+
+                                   if (!data[typeId].IsComplexIndex()) {
+                                     return;
+                                   }
+
+                                   auto      tileId=TileId::GetTile(level,node.GetCoords());
+                                   IndexType indexType;
+
+                                   if (data[typeId].listTiles.find(tileId)!=data[typeId].listTiles.end()) {
+                                     indexType=IndexType::IndexTypeList;
+                                   }
+                                   else if (data[typeId].bitmapTiles.find(tileId)!=data[typeId].bitmapTiles.end()) {
+                                     indexType=IndexType::IndexTypeBitmap;
+                                   }
+                                   else {
+                                     return;
+                                   }
+
+                                   partitionTileData[partition].push_back(TileEntry{typeId,
+                                                                                    indexType,
+                                                                                    tileId,
+                                                                                    node.GetCoords(),
+                                                                                    node.GetFileOffset()});
+                                 },
+                                 [](size_t /*partition*/) {
+                                   // no code
+                                 });
+
+        for (const auto& entries : partitionTileData) {
+          for (const auto& entry : entries) {
+            auto typeId=entry.typeId;
+            auto tileId=entry.tileId;
+
+            tileData[typeId][tileId].emplace_back(entry.coord, entry.offset);
+
+            if (tileData[typeId][tileId].size()==data[typeId].tileFillCount.find(tileId)->second) {
+              if (entry.indexType==IndexType::IndexTypeList) {
+                WriteTileListData(parameter,
+                                  data[typeId],
+                                  tileData[typeId][tileId],
+                                  tileIndexOffsets[typeId][tileId],
+                                  writer);
+              }
+              else {
+                WriteBitmapData(parameter,
+                                tileId,
+                                tileData[typeId][tileId],
+                                bitmapIndexOffsets[typeId][tileId],
+                                writer);
+              }
+
+              tileData[typeId][tileId].clear();
+            }
           }
-
-          tileData[typeId][tileId].clear();
         }
       }
 
-      nodeScanner.Close();
       writer.Close();
     }
     catch (IOException& e) {
@@ -678,10 +742,13 @@ namespace osmscout {
   {
     std::vector<DistributionData> distributionData;
 
+    std::vector<DataPartition>    partitions;
+
     if (!AnalyseDistribution(typeConfig,
                              parameter,
                              progress,
-                             distributionData)) {
+                             distributionData,
+                             partitions)) {
       return false;
     }
 
@@ -692,6 +759,7 @@ namespace osmscout {
     return WriteData(typeConfig,
                      parameter,
                      progress,
-                     distributionData);
+                     distributionData,
+                     partitions);
   }
 }
@@ -26,8 +26,6 @@
 #include <map>
 #include <set>
 
-#include <osmscout/Pixel.h>
-
 #include <osmscout/FeatureReader.h>
 
 #include <osmscout/db/LocationIndex.h>
@@ -56,6 +54,7 @@
 #include <osmscoutimport/SortWayDat.h>
 #include <osmscoutimport/SortNodeDat.h>
 #include <osmscoutimport/GenAreaAreaIndex.h>
+#include <osmscoutimport/ParallelProcessing.h>
 
 //#define REGION_DEBUG
 
@@ -65,7 +64,35 @@
 
 namespace osmscout {
 
-  static const size_t REGION_INDEX_LEVEL=14;
+  //! Number of objects read, before they are assigned to regions in parallel
+  static const size_t REGION_ASSIGNMENT_BATCH_SIZE=10000;
+
+  /**
+   * Resolves the target regions of the given objects in parallel using `assign`, then
+   * passes the objects in their original order to `add` and clears the batch. threadCount
+   * is the configured number of threads (see GetProcessingThreadCount()).
+   *
+   * `assign` must only read the region tree, so that all changes happen in `add` in the
+   * same order as without batching.
+   */
+  template<typename Entry, typename Assign, typename Add>
+  static void AssignRegions(size_t threadCount,
+                            std::vector<Entry>& batch,
+                            const Assign& assign,
+                            const Add& add)
+  {
+    ProcessInStrips(threadCount,
+                    batch.size(),
+                    [&batch,&assign](size_t index) {
+                      assign(batch[index]);
+                    });
+
+    for (const auto& entry : batch) {
+      add(entry);
+    }
+
+    batch.clear();
+  }
 
   const char* const LocationIndexGenerator::FILENAME_LOCATION_REGION_TXT  = "location_region.txt";
   const char* const LocationIndexGenerator::FILENAME_LOCATION_FULL_TXT    = "location_full.txt";
@@ -113,14 +140,18 @@ namespace osmscout {
 
     /**
      * Calculates the bounding box of each area and the over all bounding box of all
-     * areas.
+     * areas. Also prepares the areas for containment tests.
      */
     void Region::CalculateMinMax()
     {
+      boundingBoxes.clear();
       boundingBoxes.reserve(areas.size());
+      preparedAreas.clear();
+      preparedAreas.reserve(areas.size());
 
       for (const auto& area : areas) {
-        boundingBoxes.push_back(osmscout::GetBoundingBox(area));
+        preparedAreas.emplace_back(area);
+        boundingBoxes.push_back(preparedAreas.back().GetBoundingBox());
       }
 
       GeoBox boundingBox;
@@ -293,7 +324,7 @@ namespace osmscout {
       size_t in = 0;
       size_t out = 0;
       size_t curr_subarea = 0;
-      const size_t nareas = areas.size();
+      const size_t nareas = preparedAreas.size();
 
       size_t quorum_isin = (size_t)round(child.probePoints.size() * 0.9);
       size_t quorum_isout = child.probePoints.size() - quorum_isin;
@@ -302,9 +333,7 @@ namespace osmscout {
         bool        isin=false;
 
         for (size_t i=0; !isin && i<nareas; ++i) {
-          const auto& area=areas[curr_subarea];
-
-          if (osmscout::GetRelationOfPointToArea(p,area)>=0) {
+          if (preparedAreas[curr_subarea].GetRelationOfPoint(p)>=0) {
             isin=true;
           }
           else {
@@ -350,8 +379,8 @@ namespace osmscout {
                           const GeoCoord& node)
     {
       for (const auto& childRegion : regions) {
-        for (const auto& area : childRegion->areas) {
-          if (IsCoordInArea(node,area)) {
+        for (const auto& area : childRegion->preparedAreas) {
+          if (area.Contains(node)) {
             childRegion->AddAlias(location,
                                   node);
             return;
@@ -366,22 +395,20 @@ namespace osmscout {
       aliases.push_back(location);
     }
 
-    void Region::AddPOINode(const FileOffset& fileOffset,
-                            const std::string& name,
-                            bool& added)
+    void Region::AddPOI(const ObjectFileRef& object,
+                        const std::string& name)
     {
-      RegionPOI poi(name,ObjectFileRef(fileOffset,refNode));
-
-      pois.push_back(poi);
-
-      added=true;
+      pois.emplace_back(name,
+                        object);
     }
 
-    void Region::AddPOIArea(const FileOffset& fileOffset,
-                            const std::string& name,
-                            const std::vector<Point>& nodes,
-                            const GeoBox& boundingBox,
-                            bool& added)
+    /**
+     * Returns the deepest region (this region or one of its descendants), that completely
+     * contains the given area. The region tree is not changed, so the method can be called
+     * from multiple threads.
+     */
+    Region& Region::GetEnclosingRegion(const std::vector<Point>& nodes,
+                                       const GeoBox& boundingBox)
     {
       for (const auto& childRegion : regions) {
         // Fast check, if the object is in the bounds of the area
@@ -389,64 +416,66 @@ namespace osmscout {
           continue;
         }
 
-        for (const auto& childArea : childRegion->areas) {
-          if (IsAreaCompletelyInArea(nodes,childArea)) {
-            childRegion->AddPOIArea(fileOffset,
-                                    name,
-                                    nodes,
-                                    boundingBox,
-                                    added);
-            return;
+        for (const auto& childArea : childRegion->preparedAreas) {
+          if (childArea.ContainsCompletely(nodes)) {
+            return childRegion->GetEnclosingRegion(nodes,
+                                                   boundingBox);
           }
         }
       }
 
-      locidx::RegionPOI poi(name,ObjectFileRef(fileOffset,refArea));
-
-      pois.push_back(poi);
-
-      added=true;
+      return *this;
     }
 
-    bool Region::AddPOIWay(const FileOffset& fileOffset,
-                           const std::string& name,
-                           const std::vector<Point>& nodes,
-                           const GeoBox& boundingBox,
-                           bool& added)
+    /**
+     * Collects the regions a way has to be added to. These are the deepest regions
+     * overlapping with the way and their parents up to the region that completely
+     * contains the way. The region tree is not changed, so the method can be called
+     * from multiple threads.
+     *
+     * The code is designed to minimize the number of "point in area" checks, it assumes that
+     * if one point of an object is in a area it is very likely that all points of the object
+     * are in the area.
+     *
+     * @return true, if this region completely contains the way
+     */
+    bool Region::GetRegionsForWay(const std::vector<Point>& nodes,
+                                  const GeoBox& boundingBox,
+                                  std::vector<Region*>& result)
     {
       for (const auto& childRegion : regions) {
         // Fast check, if the object is in the bounds of the area
-        if (childRegion->CouldContain(boundingBox)) {
-          // Check if one point is in the area
-          for (const auto& childArea : childRegion->areas) {
-            bool match=IsAreaAtLeastPartlyInArea(nodes,childArea);
-
-            if (match) {
-              bool completeMatch=childRegion->AddPOIWay(fileOffset,
-                                                        name,
-                                                        nodes,
-                                                        boundingBox,
-                                                        added);
-
-              if (completeMatch) {
-                // We are done, the object is completely enclosed by one of our sub areas
-                return true;
-              }
+        if (!childRegion->CouldContain(boundingBox)) {
+          continue;
+        }
+
+        // Check if one point is in the area
+        for (const auto& childArea : childRegion->preparedAreas) {
+          bool match=childArea.ContainsAtLeastPartly(nodes,
+                                                     boundingBox);
+
+          if (match) {
+            bool completeMatch=childRegion->GetRegionsForWay(nodes,
+                                                             boundingBox,
+                                                             result);
+
+            if (completeMatch) {
+              // We are done, the object is completely enclosed by one of our sub areas
+              return true;
             }
           }
         }
       }
 
-      locidx::RegionPOI poi(name,ObjectFileRef(fileOffset,refWay));
-
-      pois.push_back(poi);
-
-      added=true;
+      // If we (at least partly) contain it, we add it to the area but continue
+      // This means we either do not have any child area or the object is only partially
+      // in a child area (and thus should be part of this area, too)
+      result.push_back(this);
 
-      return std::any_of(areas.begin(),
-                         areas.end(),
+      return std::any_of(preparedAreas.begin(),
+                         preparedAreas.end(),
                          [&nodes] (const auto& area) {
-                           return IsAreaCompletelyInArea(nodes,area);
+                           return area.ContainsCompletely(nodes);
                          });
     }
 
@@ -493,9 +522,9 @@ namespace osmscout {
           continue;
         }
 
-        for (const auto& childArea : childRegion->areas) {
+        for (const auto& childArea : childRegion->preparedAreas) {
           // Check if one point is in the area
-          bool match=IsCoordInArea(nodes[0],childArea);
+          bool match=childArea.Contains(nodes[0].GetCoord());
 
           if (match) {
             bool completeMatch=childRegion->AddLocationArea(area,
@@ -520,59 +549,10 @@ namespace osmscout {
                         postalCode,
                         ObjectFileRef(area.GetFileOffset(),refArea));
 
-      return std::any_of(areas.begin(),
-                         areas.end(),
+      return std::any_of(preparedAreas.begin(),
+                         preparedAreas.end(),
                          [&nodes] (const auto& childArea) {
-                           return IsAreaCompletelyInArea(nodes,childArea);
-                         });
-    }
-
-    /**
-      Add the given location way to the hierarchical area index.
-
-      The code is designed to minimize the number of "point in area" checks, it assumes that
-      if one point of an object is in a area it is very likely that all points of the object
-      are in the area.
-      */
-    bool Region::AddLocationWay(const Way& way,
-                                const std::string& name,
-                                const std::string& postalCode,
-                                const GeoBox& boundingBox)
-    {
-      for (const auto& childRegion : regions) {
-        // Fast check, if the object is in the bounds of the area
-        if (!childRegion->CouldContain(boundingBox)) {
-          continue;
-        }
-
-        // Check if one point is in the area
-        for (const auto& childArea : childRegion->areas) {
-          bool match=IsAreaAtLeastPartlyInArea(way.nodes,childArea);
-
-          if (match) {
-            bool completeMatch=childRegion->AddLocationWay(way,
-                                                           name,
-                                                           postalCode,
-                                                           boundingBox);
-
-            if (completeMatch) {
-              // We are done, the object is completely enclosed by one of our sub areas
-              return true;
-            }
-          }
-        }
-      }
-
-      // If we (at least partly) contain it, we add it to the area but continue
-
-      AddLocationObject(name,
-                        postalCode,
-                        ObjectFileRef(way.GetFileOffset(),refWay));
-
-      return std::any_of(areas.begin(),
-                         areas.end(),
-                         [&way] (const auto& area) {
-                           return IsAreaCompletelyInArea(way.nodes,area);
+                           return childArea.ContainsCompletely(nodes);
                          });
     }
 
@@ -608,44 +588,39 @@ namespace osmscout {
       return added;
     }
 
-    RegionIndex::RegionIndex(double cellWidth,
-                             double cellHeight)
-    : cellWidth(cellWidth),
-      cellHeight(cellHeight)
-    {
-    }
-
     void RegionIndex::IndexRegions(const std::vector<std::list<locidx::RegionRef> >& regionTree)
     {
+      regions.clear();
+      areaRegions.clear();
+
       for (size_t level=regionTree.size()-1; level>=1; level--) {
-        for (const auto& region : regionTree[level]) {
-          for (const auto& boundingBox : region->GetAreaBoundingBoxes()) {
-            uint32_t cellMinX=(uint32_t)((boundingBox.GetMinLon()+180.0)/cellWidth);
-            uint32_t cellMaxX=(uint32_t)((boundingBox.GetMaxLon()+180.0)/cellWidth);
-            uint32_t cellMinY=(uint32_t)((boundingBox.GetMinLat()+90.0)/cellHeight);
-            uint32_t cellMaxY=(uint32_t)((boundingBox.GetMaxLat()+90.0)/cellHeight);
-
-            for (uint32_t y=cellMinY; y<=cellMaxY; y++) {
-              for (uint32_t x=cellMinX; x<=cellMaxX; x++) {
-                Pixel pixel(x,y);
-
-                index[pixel].push_back(region);
-              }
-            }
-          }
-        }
+        regions.insert(regions.end(),
+                       regionTree[level].begin(),
+                       regionTree[level].end());
       }
 
-      for (auto& [pixel,regionList] : index) {
-        regionList.sort([](const locidx::RegionRef& a, const locidx::RegionRef& b) {
-          return a->GetBoundingBox().GetSize()<b->GetBoundingBox().GetSize();
-        });
+      std::stable_sort(regions.begin(),
+                       regions.end(),
+                       [](const locidx::RegionRef& a, const locidx::RegionRef& b) {
+                         return a->GetBoundingBox().GetSize()<b->GetBoundingBox().GetSize();
+                       });
+
+      std::vector<GeoBox> areaBoxes;
+
+      for (size_t r=0; r<regions.size(); r++) {
+        for (const auto& boundingBox : regions[r]->GetAreaBoundingBoxes()) {
+          areaBoxes.push_back(boundingBox);
+          areaRegions.push_back(r);
+        }
       }
+
+      areaTree.Build(areaBoxes);
     }
 
     /**
-     * Returns the region that contains the given geo coordinate or the passed root region
-     * if no child region was found.
+     * Returns the smallest region that contains the given geo coordinate or the passed root region
+     * if no child region was found. The index is not changed, so the method can be called from
+     * multiple threads.
      *
      * @param rootRegion
      *    region to return if no other region was found
@@ -657,17 +632,30 @@ namespace osmscout {
     RegionRef RegionIndex::GetRegionForNode(const RegionRef& rootRegion,
                                             const GeoCoord& coord) const
     {
-      uint32_t minX=(uint32_t)((coord.GetLon()+180.0)/cellWidth);
-      uint32_t minY=(uint32_t)((coord.GetLat()+90.0)/cellHeight);
+      std::vector<size_t> areas;
 
-      const auto indexCell=index.find(Pixel(minX,minY));
+      areaTree.Query(coord,
+                     areas);
 
-      if (indexCell!=index.end()) {
-        for (const auto& region : indexCell->second) {
-          for (const auto& area : region->areas) {
-            if (IsCoordInArea(coord,area)) {
-              return region;
-            }
+      std::vector<size_t> candidates;
+
+      candidates.reserve(areas.size());
+      for (size_t area : areas) {
+        candidates.push_back(areaRegions[area]);
+      }
+
+      std::sort(candidates.begin(),
+                candidates.end());
+      candidates.erase(std::unique(candidates.begin(),
+                                   candidates.end()),
+                       candidates.end());
+
+      for (size_t candidate : candidates) {
+        const RegionRef& region=regions[candidate];
+
+        for (const auto& area : region->preparedAreas) {
+          if (area.Contains(coord)) {
+            return region;
           }
         }
       }
@@ -1602,6 +1590,16 @@ namespace osmscout {
                                                  const locidx::RegionIndex& regionIndex,
                                                  locidx::RegionRef& rootRegion)
   {
+    struct LocationWay
+    {
+      FileOffset                   fileOffset;
+      std::string                  name;
+      std::string                  postalCode;
+      std::vector<Point>           nodes;
+      GeoBox                       boundingBox;
+      std::vector<locidx::Region*> regions;     //!< Regions to add the way to
+    };
+
     FileScanner scanner;
 
     try {
@@ -1609,6 +1607,28 @@ namespace osmscout {
       NameFeatureLabelReader       nameReader(typeConfig);
       RefFeatureLabelReader        refReader(typeConfig);
       PostalCodeFeatureValueReader postalCodeReader(typeConfig);
+      std::vector<LocationWay>     batch;
+
+      auto assignRegions=[&regionIndex,&rootRegion](LocationWay& entry) {
+        // This is an optimization. Instead of propagating the way down the region tree
+        // we make a fast lookup for a matching candidate...
+        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
+                                                              entry.boundingBox.GetCenter());
+
+        region->GetRegionsForWay(entry.nodes,
+                                 entry.boundingBox,
+                                 entry.regions);
+      };
+
+      auto addToRegions=[&waysFound](const LocationWay& entry) {
+        for (auto* region : entry.regions) {
+          region->AddLocationObject(entry.name,
+                                    entry.postalCode,
+                                    ObjectFileRef(entry.fileOffset,refWay));
+        }
+
+        waysFound++;
+      };
 
       scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                    WayDataFile::WAYS_DAT),
@@ -1640,21 +1660,27 @@ namespace osmscout {
         }
 
         const PostalCodeFeatureValue *postalCodeValue=postalCodeReader.GetValue(way.GetFeatureValueBuffer());
-        GeoBox                       boundingBox=way.GetBoundingBox();
+        LocationWay&                 entry=batch.emplace_back();
 
+        entry.fileOffset=way.GetFileOffset();
+        entry.name=name;
+        entry.postalCode=postalCodeValue!=nullptr ? postalCodeValue->GetPostalCode() : "";
+        entry.boundingBox=way.GetBoundingBox();
+        entry.nodes=std::move(way.nodes);
 
-        // This is an optimization. Instead of propagating the alias down the region tree
-        // we make a fast lookup for a matching candidate...
-        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
-                                                              boundingBox.GetCenter());
-        region->AddLocationWay(way,
-                               name,
-                               postalCodeValue!=nullptr ? postalCodeValue->GetPostalCode() : "",
-                               boundingBox);
-
-        waysFound++;
+        if (batch.size()>=REGION_ASSIGNMENT_BATCH_SIZE) {
+          AssignRegions(parameter.GetProcessingThreadCount(),
+                        batch,
+                        assignRegions,
+                        addToRegions);
+        }
       }
 
+      AssignRegions(parameter.GetProcessingThreadCount(),
+                    batch,
+                    assignRegions,
+                    addToRegions);
+
       progress.Info(std::string("Found ")+std::to_string(waysFound)+" locations of type 'way'");
 
       scanner.Close();
@@ -1795,62 +1821,66 @@ namespace osmscout {
     added=true;
   }
 
-  void LocationIndexGenerator::AddAddressAreaToRegion(Progress& progress,
-                                                      locidx::Region& region,
-                                                      const FileOffset& fileOffset,
-                                                      const std::string& location,
-                                                      const std::string& address,
-                                                      const std::string &postalCode,
-                                                      const std::vector<Point>& nodes,
-                                                      const GeoBox& boundingBox,
-                                                      bool& added)
-  {
-    for (const auto& childRegion : region.regions) {
-      // Fast check, if the object is in the bounds of the area
-      if (childRegion->CouldContain(boundingBox)) {
-        for (const auto& childArea : childRegion->areas) {
-          if (IsAreaCompletelyInArea(nodes,childArea)) {
-            AddAddressAreaToRegion(progress,
-                                   *childRegion,
-                                   fileOffset,
-                                   location,
-                                   address,
-                                   postalCode,
-                                   nodes,
-                                   boundingBox,
-                                   added);
-            return;
-          }
-        }
-      }
-    }
-
-    AddAddressToRegion(progress,
-                       region,
-                       ObjectFileRef(fileOffset,refArea),
-                       location,
-                       address,
-                       postalCode,
-                       false,
-                       added);
-  }
-
   bool LocationIndexGenerator::IndexAddressAreas(const TypeConfig& typeConfig,
                                                  const ImportParameter& parameter,
                                                  Progress& progress,
                                                  locidx::RegionRef& rootRegion,
                                                  const locidx::RegionIndex& regionIndex)
   {
+    struct AddressArea
+    {
+      FileOffset         fileOffset;
+      std::string        name;
+      std::string        postalCode;
+      std::string        location;
+      std::string        address;
+      std::vector<Point> nodes;
+      GeoBox             boundingBox;
+      bool               isAddress;
+      bool               isPOI;
+      locidx::Region*    region=nullptr; //!< Region to add the area to
+    };
+
     FileScanner scanner;
 
     try {
-      size_t             addressFound=0;
-      size_t             poiFound=0;
-      size_t             postalCodeFound=0;
-      FileOffset         fileOffset;
-      TypeId             typeId;
-      TypeInfoRef        type;
-      std::vector<Point> nodes;
+      size_t                   addressFound=0;
+      size_t                   poiFound=0;
+      size_t                   postalCodeFound=0;
+      std::vector<AddressArea> batch;
+
+      auto assignRegion=[&regionIndex,&rootRegion](AddressArea& entry) {
+        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
+                                                              entry.boundingBox.GetCenter());
+
+        entry.region=&region->GetEnclosingRegion(entry.nodes,
+                                                 entry.boundingBox);
+      };
+
+      auto addToRegion=[this,&progress,&addressFound,&poiFound](const AddressArea& entry) {
+        if (entry.isAddress) {
+          bool added=false;
+
+          AddAddressToRegion(progress,
+                             *entry.region,
+                             ObjectFileRef(entry.fileOffset,refArea),
+                             entry.location,
+                             entry.address,
+                             entry.postalCode,
+                             false,
+                             added);
+
+          if (added) {
+            addressFound++;
+          }
+        }
+
+        if (entry.isPOI) {
+          entry.region->AddPOI(ObjectFileRef(entry.fileOffset,refArea),
+                               entry.name);
+          poiFound++;
+        }
+      };
 
       scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                    AreaAreaIndexGenerator::AREAADDRESS_DAT),
@@ -1860,78 +1890,52 @@ namespace osmscout {
       uint32_t areaCount=scanner.ReadUInt32();
 
       for (uint32_t a=1; a<=areaCount; a++) {
-        uint32_t           tmpType;
-        std::string        name;
-        std::string        postalCode;
-        std::string        location;
-        std::string        address;
+        AddressArea entry;
 
         progress.SetProgress(a,areaCount);
 
-        fileOffset=scanner.ReadFileOffset();
-        tmpType=scanner.ReadUInt32Number();
+        entry.fileOffset=scanner.ReadFileOffset();
+
+        uint32_t tmpType=scanner.ReadUInt32Number();
 
-        name=scanner.ReadString();
-        postalCode=scanner.ReadString();
-        location=scanner.ReadString();
-        address=scanner.ReadString();
+        entry.name=scanner.ReadString();
+        entry.postalCode=scanner.ReadString();
+        entry.location=scanner.ReadString();
+        entry.address=scanner.ReadString();
 
-        GeoBox boundingBox;
         std::vector<SegmentGeoBox> segments;
-        scanner.Read(nodes,segments,boundingBox,false);
+        scanner.Read(entry.nodes,segments,entry.boundingBox,false);
 
-        typeId=(TypeId)tmpType;
-        type=typeConfig.GetAreaTypeInfo(typeId);
+        TypeInfoRef type=typeConfig.GetAreaTypeInfo((TypeId)tmpType);
 
-        bool isAddress=!location.empty() &&
-                       !address.empty();
-        bool isPOI=!name.empty() &&
-                   type->GetIndexAsPOI();
+        entry.isAddress=!entry.location.empty() &&
+                        !entry.address.empty();
+        entry.isPOI=!entry.name.empty() &&
+                    type->GetIndexAsPOI();
 
-        if (!postalCode.empty()) {
+        if (!entry.postalCode.empty()) {
           postalCodeFound++;
         }
 
-        if (!isAddress && !isPOI) {
+        if (!entry.isAddress && !entry.isPOI) {
           continue;
         }
 
-        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
-                                                              boundingBox.GetCenter());
-
-        if (isAddress) {
-          bool added=false;
+        batch.push_back(std::move(entry));
 
-          AddAddressAreaToRegion(progress,
-                                 *region,
-                                 fileOffset,
-                                 location,
-                                 address,
-                                 postalCode,
-                                 nodes,
-                                 boundingBox,
-                                 added);
-
-          if (added) {
-            addressFound++;
-          }
-        }
-
-        if (isPOI) {
-          bool added=false;
-
-          region->AddPOIArea(fileOffset,
-                             name,
-                             nodes,
-                             boundingBox,
-                             added);
-
-          if (added) {
-            poiFound++;
-          }
+        if (batch.size()>=REGION_ASSIGNMENT_BATCH_SIZE) {
+          AssignRegions(parameter.GetProcessingThreadCount(),
+                        batch,
+                        assignRegion,
+                        addToRegion);
         }
       }
 
+      AssignRegions(parameter.GetProcessingThreadCount(),
+                    batch,
+                    assignRegion,
+                    addToRegion);
+
       progress.Info(std::to_string(areaCount)+" areas analyzed, "+
                     std::to_string(addressFound)+" addresses founds, "+
                     std::to_string(poiFound)+" POIs founds, "+
@@ -1947,74 +1951,45 @@ namespace osmscout {
     return true;
   }
 
-  bool LocationIndexGenerator::AddAddressWayToRegion(Progress& progress,
-                                                     locidx::Region& region,
-                                                     const FileOffset& fileOffset,
-                                                     const std::string& location,
-                                                     const std::string& address,
-                                                     const std::vector<Point>& nodes,
-                                                     const GeoBox& boundingBox,
-                                                     bool& added)
-  {
-    for (const auto& childRegion : region.regions) {
-      // Fast check, if the object is in the bounds of the area
-      if (childRegion->CouldContain(boundingBox)) {
-        // Check if one point is in the area
-        for (const auto& childArea : childRegion->areas) {
-          bool match=IsAreaAtLeastPartlyInArea(nodes,childArea);
-
-          if (match) {
-            bool completeMatch=AddAddressWayToRegion(progress,
-                                                     *childRegion,
-                                                     fileOffset,
-                                                     location,
-                                                     address,
-                                                     nodes,
-                                                     boundingBox,
-                                                     added);
-
-            if (completeMatch) {
-              // We are done, the object is completely enclosed by one of our sub areas
-              return true;
-            }
-          }
-        }
-      }
-    }
-
-    AddAddressToRegion(progress,
-                       region,
-                       ObjectFileRef(fileOffset,refWay),
-                       location,
-                       address,
-                       "",
-                       false,
-                       added);
-
-    for (const auto& area : region.areas) {
-      if (IsAreaCompletelyInArea(nodes,area)) {
-        return true;
-      }
-    }
-
-    return false;
-  }
-
   bool LocationIndexGenerator::IndexAddressWays(const TypeConfig& typeConfig,
                                                 const ImportParameter& parameter,
                                                 Progress& progress,
                                                 const locidx::RegionRef& rootRegion,
                                                 const locidx::RegionIndex& regionIndex)
   {
+    struct POIWay
+    {
+      FileOffset                   fileOffset;
+      std::string                  name;
+      std::vector<Point>           nodes;
+      GeoBox                       boundingBox;
+      std::vector<locidx::Region*> regions;     //!< Regions to add the way to
+    };
+
     FileScanner scanner;
 
     try {
-      size_t             poiFound=0;
-      size_t             postalCodeFound=0;
-      FileOffset         fileOffset;
-      TypeId             typeId;
-      TypeInfoRef        type;
-      std::vector<Point> nodes;
+      size_t              poiFound=0;
+      size_t              postalCodeFound=0;
+      std::vector<POIWay> batch;
+
+      auto assignRegions=[&regionIndex,&rootRegion](POIWay& entry) {
+        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
+                                                              entry.boundingBox.GetCenter());
+
+        region->GetRegionsForWay(entry.nodes,
+                                 entry.boundingBox,
+                                 entry.regions);
+      };
+
+      auto addToRegions=[&poiFound](const POIWay& entry) {
+        for (auto* region : entry.regions) {
+          region->AddPOI(ObjectFileRef(entry.fileOffset,refWay),
+                         entry.name);
+        }
+
+        poiFound++;
+      };
 
       scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                    SortWayDataGenerator::WAYADDRESS_DAT),
@@ -2024,26 +1999,24 @@ namespace osmscout {
       uint32_t wayCount=scanner.ReadUInt32();
 
       for (uint32_t w=1; w<=wayCount; w++) {
-        uint32_t           tmpType;
-        std::string        name;
-        std::string        postalCode;
+        POIWay entry;
 
         progress.SetProgress(w,wayCount);
 
-        fileOffset=scanner.ReadFileOffset();
-        tmpType=scanner.ReadUInt32Number();
+        entry.fileOffset=scanner.ReadFileOffset();
 
-        name=scanner.ReadString();
-        postalCode=scanner.ReadString();
+        uint32_t tmpType=scanner.ReadUInt32Number();
+
+        entry.name=scanner.ReadString();
+
+        std::string postalCode=scanner.ReadString();
 
-        GeoBox boundingBox;
         std::vector<SegmentGeoBox> segments;
-        scanner.Read(nodes,segments,boundingBox,false);
+        scanner.Read(entry.nodes,segments,entry.boundingBox,false);
 
-        typeId=(TypeId)tmpType;
-        type=typeConfig.GetWayTypeInfo(typeId);
+        TypeInfoRef type=typeConfig.GetWayTypeInfo((TypeId)tmpType);
 
-        bool isPOI=!name.empty() &&
+        bool isPOI=!entry.name.empty() &&
                    type->GetIndexAsPOI();
 
         if (!postalCode.empty()) {
@@ -2054,22 +2027,21 @@ namespace osmscout {
           continue;
         }
 
-        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
-                                                              boundingBox.GetCenter());
-
-        bool added=false;
+        batch.push_back(std::move(entry));
 
-        region->AddPOIWay(fileOffset,
-                          name,
-                          nodes,
-                          boundingBox,
-                          added);
-
-        if (added) {
-          poiFound++;
+        if (batch.size()>=REGION_ASSIGNMENT_BATCH_SIZE) {
+          AssignRegions(parameter.GetProcessingThreadCount(),
+                        batch,
+                        assignRegions,
+                        addToRegions);
         }
       }
 
+      AssignRegions(parameter.GetProcessingThreadCount(),
+                    batch,
+                    assignRegions,
+                    addToRegions);
+
       progress.Info(std::to_string(wayCount)+" ways analyzed, "+std::to_string(poiFound)+" POIs founds");
 
       progress.Info(std::to_string(wayCount)+" ways analyzed, "+
@@ -2166,16 +2138,58 @@ namespace osmscout {
                                                  const locidx::RegionRef& rootRegion,
                                                  const locidx::RegionIndex& regionIndex)
   {
+    struct AddressNode
+    {
+      FileOffset        fileOffset;
+      std::string       name;
+      std::string       postalCode;
+      std::string       location;
+      std::string       address;
+      GeoCoord          coord;
+      bool              isAddress;
+      bool              isPOI;
+      locidx::RegionRef region;     //!< Region to add the node to
+    };
+
     FileScanner scanner;
 
     try {
-      size_t      addressFound=0;
-      size_t      poiFound=0;
-      size_t      postalCodeFound=0;
-      FileOffset  fileOffset;
-      TypeId      typeId;
-      TypeInfoRef type;
-      GeoCoord    coord;
+      size_t                   addressFound=0;
+      size_t                   poiFound=0;
+      size_t                   postalCodeFound=0;
+      std::vector<AddressNode> batch;
+
+      auto assignRegion=[&regionIndex,&rootRegion](AddressNode& entry) {
+        entry.region=regionIndex.GetRegionForNode(rootRegion,
+                                                  entry.coord);
+      };
+
+      auto addToRegion=[this,&progress,&addressFound,&poiFound](const AddressNode& entry) {
+        if (!entry.region) {
+          return;
+        }
+
+        if (entry.isAddress) {
+          bool added=false;
+
+          AddAddressNodeToRegion(progress,
+                                 *entry.region,
+                                 entry.fileOffset,
+                                 entry.location,
+                                 entry.address,
+                                 entry.postalCode,
+                                 added);
+          if (added) {
+            addressFound++;
+          }
+        }
+
+        if (entry.isPOI) {
+          entry.region->AddPOI(ObjectFileRef(entry.fileOffset,refNode),
+                               entry.name);
+          poiFound++;
+        }
+      };
 
       scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                    SortNodeDataGenerator::NODEADDRESS_DAT),
@@ -2185,74 +2199,51 @@ namespace osmscout {
       uint32_t nodeCount=scanner.ReadUInt32();
 
       for (uint32_t n=1; n<=nodeCount; n++) {
-        uint32_t    tmpType;
-        std::string name;
-        std::string postalCode;
-        std::string location;
-        std::string address;
+        AddressNode entry;
 
         progress.SetProgress(n,nodeCount);
 
-        fileOffset=scanner.ReadFileOffset();
-        tmpType=scanner.ReadUInt32Number();
+        entry.fileOffset=scanner.ReadFileOffset();
 
-        name=scanner.ReadString();
-        postalCode=scanner.ReadString();
-        location=scanner.ReadString();
-        address=scanner.ReadString();
+        uint32_t tmpType=scanner.ReadUInt32Number();
 
-        coord=scanner.ReadCoord();
+        entry.name=scanner.ReadString();
+        entry.postalCode=scanner.ReadString();
+        entry.location=scanner.ReadString();
+        entry.address=scanner.ReadString();
 
-        typeId=(TypeId)tmpType;
-        type=typeConfig.GetNodeTypeInfo(typeId);
+        entry.coord=scanner.ReadCoord();
 
-        bool isAddress=!location.empty() &&
-                       !address.empty();
-        bool isPOI=!name.empty() &&
-                   type->GetIndexAsPOI();
+        TypeInfoRef type=typeConfig.GetNodeTypeInfo((TypeId)tmpType);
 
-        if (!postalCode.empty()) {
-          postalCodeFound++;
-        }
+        entry.isAddress=!entry.location.empty() &&
+                        !entry.address.empty();
+        entry.isPOI=!entry.name.empty() &&
+                    type->GetIndexAsPOI();
 
-        if (!isAddress && !isPOI) {
-          continue;
+        if (!entry.postalCode.empty()) {
+          postalCodeFound++;
         }
 
-        locidx::RegionRef region=regionIndex.GetRegionForNode(rootRegion,
-                                                              coord);
-
-        if (!region) {
+        if (!entry.isAddress && !entry.isPOI) {
           continue;
         }
 
-        if (isAddress) {
-          bool added=false;
+        batch.push_back(std::move(entry));
 
-          AddAddressNodeToRegion(progress,
-                                 *region,
-                                 fileOffset,
-                                 location,
-                                 address,
-                                 postalCode,
-                                 added);
-          if (added) {
-            addressFound++;
-          }
-        }
-
-        if (isPOI) {
-          bool added=false;
-
-          region->AddPOINode(fileOffset,
-                             name,
-                             added);
-          if (added) {
-            poiFound++;
-          }
+        if (batch.size()>=REGION_ASSIGNMENT_BATCH_SIZE) {
+          AssignRegions(parameter.GetProcessingThreadCount(),
+                        batch,
+                        assignRegion,
+                        addToRegion);
         }
       }
 
+      AssignRegions(parameter.GetProcessingThreadCount(),
+                    batch,
+                    assignRegion,
+                    addToRegion);
+
       progress.Info(std::to_string(nodeCount)+" nodes analyzed, "+
                     std::to_string(addressFound)+" addresses founds, "+
                     std::to_string(poiFound)+" POIs founds, "+
@@ -2793,8 +2784,7 @@ namespace osmscout {
 
       progress.SetAction("Index regions");
 
-      locidx::RegionIndex regionIndex(360.0/pow(2.0,REGION_INDEX_LEVEL),
-                                      180.0/pow(2.0,REGION_INDEX_LEVEL));
+      locidx::RegionIndex regionIndex;
 
       regionIndex.IndexRegions(regionTree);
 
@@ -19,6 +19,9 @@
 
 #include <osmscoutimport/GenOptimizeAreasLowZoom.h>
 
+#include <cmath>
+#include <memory>
+
 #include <osmscout/Pixel.h>
 #include <osmscout/Way.h>
 
@@ -182,30 +185,68 @@ namespace osmscout
                                                     double dpi,
                                                     double pixel,
                                                     const Magnification& magnification,
-                                                    TransPolygon::OptimizeMethod optimizeAreaMethod)
+                                                    TransPolygon::OptimizeMethod optimizeAreaMethod,
+                                                    const ArcTopology* topology,
+                                                    size_t firstLine)
   {
     MercatorProjection projection;
+    // The effective areas of the topology are calculated for magnification level 0
+    double             minArea=std::pow(pixel/8.0/magnification.GetMagnification(),2.0);
+    size_t             nextLine=firstLine;
+    std::vector<bool>  keep;
 
     projection.Set(GeoCoord(0.0,0.0),magnification,dpi,width,height);
 
     for (const auto &area :areas) {
       TransBuffer             transBuffer;
       std::vector<Area::Ring> newRings;
+      std::vector<size_t>     ringLines(area->rings.size());
       double                  xmin;
       double                  xmax;
       double                  ymin;
       double                  ymax;
 
+      // Same order as the rings were added to the topology
+      for (size_t r=0; r<area->rings.size(); r++) {
+        if (!(area->rings[r].IsMaster() &&
+              area->rings[r].nodes.empty())) {
+          ringLines[r]=nextLine++;
+        }
+      }
+
       size_t r=0;
       while (r<area->rings.size()) {
         if (!(area->rings[r].IsMaster() &&
               area->rings[r].nodes.empty())) {
-          TransformArea(area->rings[r].nodes,
-                        transBuffer,
-                        projection,
-                        optimizeAreaMethod,
-                        pixel/8.0,
-                        TransPolygon::OutputConstraint::simple);
+          if (topology!=nullptr) {
+            TransformArea(area->rings[r].nodes,
+                          transBuffer,
+                          projection,
+                          TransPolygon::none,
+                          pixel/8.0);
+
+            if (transBuffer.GetLength()==area->rings[r].nodes.size()) {
+              topology->GetNodesToKeep(ringLines[r],
+                                       minArea,
+                                       keep);
+
+              for (size_t i=0; i<keep.size(); i++) {
+                transBuffer.points[i].draw=keep[i];
+              }
+
+              FinishOptimization(transBuffer,
+                                 true,
+                                 TransPolygon::OutputConstraint::simple);
+            }
+          }
+          else {
+            TransformArea(area->rings[r].nodes,
+                          transBuffer,
+                          projection,
+                          optimizeAreaMethod,
+                          pixel/8.0,
+                          TransPolygon::OutputConstraint::simple);
+          }
 
           transBuffer.GetBoundingBox(xmin,ymin,xmax,ymax);
 
@@ -529,6 +570,48 @@ namespace osmscout
 
         typesToProcess.Remove(loadedTypes);
 
+        //
+        // Build the shared topology of all loaded areas
+        //
+
+        std::unique_ptr<ArcTopology> topology;
+        std::vector<size_t>          firstLines(typeConfig.GetTypeCount(),0);
+
+        if (parameter.GetOptimizationPreserveTopology() &&
+            parameter.GetOptimizationWayMethod()!=TransPolygon::none) {
+          progress.SetAction("Building topology");
+
+          topology=std::make_unique<ArcTopology>();
+
+          for (const auto& type : loadedTypes) {
+            firstLines[type->GetIndex()]=topology->GetLineCount();
+
+            for (const auto& area : allAreas[type->GetIndex()]) {
+              for (const auto& ring : area->rings) {
+                if (!(ring.IsMaster() &&
+                      ring.nodes.empty())) {
+                  topology->AddLine(ring.nodes,
+                                    true);
+                }
+              }
+            }
+          }
+
+          topology->Build();
+
+          MercatorProjection projection;
+
+          projection.Set(GeoCoord(0.0,0.0),
+                         Magnification(MagnificationLevel(0)),
+                         dpi,
+                         800,480);
+
+          topology->CalculateEffectiveAreas(projection,
+                                            parameter.GetProcessingThreadCount());
+
+          progress.Info("Split "+std::to_string(topology->GetLineCount())+" rings into "+std::to_string(topology->GetArcCount())+" arcs");
+        }
+
         for (const auto& type : loadedTypes) {
           progress.SetAction("Optimizing type "+ type->GetName());
 
@@ -545,7 +628,9 @@ namespace osmscout
                           dpi,
                           pixel,
                           magnification,
-                          parameter.GetOptimizationWayMethod());
+                          parameter.GetOptimizationWayMethod(),
+                          topology.get(),
+                          firstLines[type->GetIndex()]);
 
             if (optimizedAreas.empty()) {
               progress.Debug("Empty optimization result for level "+level+", no index generated");
@@ -646,6 +731,7 @@ namespace osmscout
     try {
       writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                   OptimizeAreasLowZoom::FILE_AREASOPT_DAT));
+      writer.SetBlockCoordEncoding(parameter.GetBlockCoordEncoding());
 
       //
       // Write header
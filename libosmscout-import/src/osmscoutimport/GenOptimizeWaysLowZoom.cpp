@@ -19,6 +19,9 @@
 
 #include <osmscoutimport/GenOptimizeWaysLowZoom.h>
 
+#include <cmath>
+#include <memory>
+
 #include <osmscout/Pixel.h>
 
 #include <osmscout/feature/RefFeature.h>
@@ -434,9 +437,15 @@ namespace osmscout
                                                   double dpi,
                                                   double pixel,
                                                   const Magnification& magnification,
-                                                  TransPolygon::OptimizeMethod optimizeWayMethod)
+                                                  TransPolygon::OptimizeMethod optimizeWayMethod,
+                                                  const ArcTopology* topology,
+                                                  size_t firstLine)
   {
     MercatorProjection projection;
+    // The effective areas of the topology are calculated for magnification level 0
+    double             minArea=std::pow(pixel/8.0/magnification.GetMagnification(),2.0);
+    size_t             line=firstLine;
+    std::vector<bool>  keep;
 
     projection.Set(GeoCoord(0.0,0.0),magnification,dpi,width,height);
 
@@ -448,11 +457,36 @@ namespace osmscout
       double             ymin;
       double             ymax;
 
-      TransformWay(way->nodes,
-                   transBuffer,
-                   projection,
-                   optimizeWayMethod,
-                   pixel/8);
+      if (topology!=nullptr) {
+        TransformWay(way->nodes,
+                     transBuffer,
+                     projection,
+                     TransPolygon::none,
+                     pixel/8);
+
+        if (transBuffer.GetLength()==way->nodes.size()) {
+          topology->GetNodesToKeep(line,
+                                   minArea,
+                                   keep);
+
+          for (size_t i=0; i<keep.size(); i++) {
+            transBuffer.points[i].draw=keep[i];
+          }
+
+          FinishOptimization(transBuffer,
+                             false,
+                             TransPolygon::noConstraint);
+        }
+
+        line++;
+      }
+      else {
+        TransformWay(way->nodes,
+                     transBuffer,
+                     projection,
+                     optimizeWayMethod,
+                     pixel/8);
+      }
 
       transBuffer.GetBoundingBox(xmin,ymin,xmax,ymax);
 
@@ -644,29 +678,72 @@ namespace osmscout
           return false;
         }
 
+        //
+        // Join ways
+        //
+
+        std::vector<std::list<WayRef>> mergedWays(allWays.size());
+
         for (size_t type=0; type<allWays.size(); type++) {
           if (allWays[type].empty()) {
             continue;
           }
 
-          progress.SetAction("Optimizing type "+ typeConfig.GetTypeInfo(type)->GetName());
-
-          //
-          // Join ways
-          //
-
-          std::list<WayRef> newWays;
+          progress.SetAction("Merging type "+ typeConfig.GetTypeInfo(type)->GetName());
 
           MergeWays(progress,
                     allWays[type],
-                    newWays);
+                    mergedWays[type]);
 
           allWays[type].clear();
+        }
+
+        //
+        // Build the shared topology of all merged ways
+        //
+
+        std::unique_ptr<ArcTopology> topology;
+        std::vector<size_t>          firstLines(mergedWays.size(),0);
+
+        if (parameter.GetOptimizationPreserveTopology() &&
+            parameter.GetOptimizationWayMethod()!=TransPolygon::none) {
+          progress.SetAction("Building topology");
+
+          topology=std::make_unique<ArcTopology>();
+
+          for (size_t type=0; type<mergedWays.size(); type++) {
+            firstLines[type]=topology->GetLineCount();
+
+            for (const auto& way : mergedWays[type]) {
+              topology->AddLine(way->nodes,
+                                way->IsCircular());
+            }
+          }
+
+          topology->Build();
+
+          MercatorProjection projection;
+
+          projection.Set(GeoCoord(0.0,0.0),
+                         Magnification(MagnificationLevel(0)),
+                         dpi,
+                         800,480);
+
+          topology->CalculateEffectiveAreas(projection,
+                                            parameter.GetProcessingThreadCount());
+
+          progress.Info("Split "+std::to_string(topology->GetLineCount())+" ways into "+std::to_string(topology->GetArcCount())+" arcs");
+        }
+
+        for (size_t type=0; type<mergedWays.size(); type++) {
+          std::list<WayRef>& newWays=mergedWays[type];
 
           if (newWays.empty()) {
             continue;
           }
 
+          progress.SetAction("Optimizing type "+ typeConfig.GetTypeInfo(type)->GetName());
+
           //
           // Transform/Optimize the way and store it
           //
@@ -685,7 +762,9 @@ namespace osmscout
                          dpi,
                          pixel,
                          magnification,
-                         parameter.GetOptimizationWayMethod());
+                         parameter.GetOptimizationWayMethod(),
+                         topology.get(),
+                         firstLines[type]);
 
             if (optimizedWays.empty()) {
               progress.Debug("Empty optimization result for level "+level+", no index bitmap generated");
@@ -762,6 +841,7 @@ namespace osmscout
     try {
       writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                   OptimizeWaysLowZoom::FILE_WAYSOPT_DAT));
+      writer.SetBlockCoordEncoding(parameter.GetBlockCoordEncoding());
 
       //
       // Write header
@@ -20,9 +20,14 @@
 #include <osmscoutimport/GenRelAreaDat.h>
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
 
 #include <osmscout/TypeInfoSet.h>
 
+#include <osmscout/async/ProcessingQueue.h>
+#include <osmscout/async/Worker.h>
+
 #include <osmscout/feature/NameFeature.h>
 #include <osmscout/feature/RefFeature.h>
 
@@ -34,12 +39,69 @@
 #include <osmscoutimport/GenRawNodeIndex.h>
 #include <osmscoutimport/GenRawWayIndex.h>
 #include <osmscoutimport/GenRawRelIndex.h>
+#include <osmscoutimport/ParallelProcessing.h>
 
 namespace osmscout {
 
   const char* const RelAreaDataGenerator::RELAREA_TMP="relarea.tmp";
   const char* const RelAreaDataGenerator::WAYAREABLACK_DAT="wayareablack.dat";
 
+  //! Number of relations per thread, that may be loaded but not yet written
+  static const size_t RELATIONS_IN_FLIGHT_PER_THREAD=16;
+
+  void RelAreaDataGenerator::RelationProgress::Debug(const std::string& text)
+  {
+    messages.push_back(Message{MessageType::debug,text,0,nullptr});
+  }
+
+  void RelAreaDataGenerator::RelationProgress::Info(const std::string& text)
+  {
+    messages.push_back(Message{MessageType::info,text,0,nullptr});
+  }
+
+  void RelAreaDataGenerator::RelationProgress::Warning(const std::string& text)
+  {
+    messages.push_back(Message{MessageType::warning,text,0,nullptr});
+  }
+
+  void RelAreaDataGenerator::RelationProgress::Error(const std::string& text)
+  {
+    messages.push_back(Message{MessageType::error,text,0,nullptr});
+  }
+
+  void RelAreaDataGenerator::RelationProgress::ReportRelation(OSMId id,
+                                                              const TypeInfoRef& type,
+                                                              const std::string& error)
+  {
+    messages.push_back(Message{MessageType::relationReport,error,id,type});
+  }
+
+  void RelAreaDataGenerator::RelationProgress::Replay(Progress& progress,
+                                                      ImportErrorReporter& errorReporter) const
+  {
+    for (const auto& message : messages) {
+      switch (message.type) {
+      case MessageType::debug:
+        progress.Debug(message.text);
+        break;
+      case MessageType::info:
+        progress.Info(message.text);
+        break;
+      case MessageType::warning:
+        progress.Warning(message.text);
+        break;
+      case MessageType::error:
+        progress.Error(message.text);
+        break;
+      case MessageType::relationReport:
+        errorReporter.ReportRelation(message.id,
+                                     message.objectType,
+                                     message.text);
+        break;
+      }
+    }
+  }
+
   /**
     Find a top level role.
 
@@ -155,7 +217,7 @@ namespace osmscout {
 
   bool RelAreaDataGenerator::BuildRings(const TypeConfig& typeConfig,
                                         const ImportParameter& parameter,
-                                        Progress& progress,
+                                        RelationProgress& progress,
                                         OSMId id,
                                         const std::string& name,
                                         const TypeInfoRef& type,
@@ -198,10 +260,10 @@ namespace osmscout {
                        " cannot be joined with any other way of the relation "+
                        std::to_string(id)+" "+name);
 
-        parameter.GetErrorReporter()->ReportRelation(id,
-                                                     type,
-                                                     "Incomplete or broken relation - cannot join path "+
-                                                     std::to_string(entry.second.front()->ways.front()->GetId()));
+        progress.ReportRelation(id,
+                                type,
+                                "Incomplete or broken relation - cannot join path "+
+                                std::to_string(entry.second.front()->ways.front()->GetId()));
         return false;
       }
 
@@ -340,7 +402,7 @@ namespace osmscout {
    */
   bool RelAreaDataGenerator::ResolveMultipolygon(const TypeConfig& typeConfig,
                                                  const ImportParameter& parameter,
-                                                 Progress& progress,
+                                                 RelationProgress& progress,
                                                  OSMId id,
                                                  const std::string& name,
                                                  const TypeInfoRef& type,
@@ -871,6 +933,8 @@ namespace osmscout {
    *
    * @param parameter
    *    Parameter object
+   * @param progress
+   *    Progress of the relation, also collects error reports
    * @param typeConfig
    *    Type configuration
    * @param rawRelation
@@ -881,7 +945,8 @@ namespace osmscout {
    *    Optional reference of the part tat defines the outer ring
    * @return
    */
-  TypeInfoRef RelAreaDataGenerator::AutodetectRelationType(const ImportParameter& parameter,
+  TypeInfoRef RelAreaDataGenerator::AutodetectRelationType(const ImportParameter& /*parameter*/,
+                                                           RelationProgress& progress,
                                                            const TypeConfig& typeConfig,
                                                            const RawRelation& rawRelation,
                                                            std::list<MultipolygonPart>& parts,
@@ -921,10 +986,10 @@ namespace osmscout {
 
     if (countTypes>1 &&
         masterType!=typeConfig.typeInfoIgnore) {
-      parameter.GetErrorReporter()->ReportRelation(rawRelation.GetId(),
-                                                   rawRelation.GetType(),
-                                                   "Conflicting types for outer ring (choosen type "+
-                                                   masterType->GetName()+")");
+      progress.ReportRelation(rawRelation.GetId(),
+                              rawRelation.GetType(),
+                              "Conflicting types for outer ring (choosen type "+
+                              masterType->GetName()+")");
     }
 
     if (countTypes==1) {
@@ -938,34 +1003,14 @@ namespace osmscout {
   }
 
   bool RelAreaDataGenerator::HandleMultipolygonRelation(const ImportParameter& parameter,
-                                                        Progress& progress,
+                                                        RelationProgress& progress,
                                                         const TypeConfig& typeConfig,
-                                                        IdSet& wayAreaIndexBlacklist,
-                                                        CoordDataFile& coordDataFile,
-                                                        RawWayIndexedDataFile& wayDataFile,
-                                                        RawRelationIndexedDataFile& relDataFile,
-                                                        RawRelation& rawRelation,
+                                                        const RawRelation& rawRelation,
                                                         const std::string& name,
+                                                        std::list<MultipolygonPart>& parts,
+                                                        std::vector<OSMId>& areaWayIds,
                                                         Area& relation)
   {
-    IdSet resolvedRelations;
-
-    std::list<MultipolygonPart> parts;
-
-    if (!ResolveMultipolygonMembers(progress,
-                                    parameter,
-                                    typeConfig,
-                                    coordDataFile,
-                                    wayDataFile,
-                                    relDataFile,
-                                    resolvedRelations,
-                                    relation,
-                                    name,
-                                    rawRelation,
-                                    parts)) {
-      return false;
-    }
-
     // Reconstruct multipolygon relation by applying the multipolygon resolving
     // algorithm as described at
     // http://wiki.openstreetmap.org/wiki/Relation:multipolygon/Algorithm
@@ -992,11 +1037,11 @@ namespace osmscout {
     for (auto& ring : parts) {
       if (ring.role.GetType()!=typeConfig.typeInfoIgnore &&
           !ring.role.GetType()->CanBeArea()) {
-        parameter.GetErrorReporter()->ReportRelation(rawRelation.GetId(),
-                                                     rawRelation.GetType(),
-                                                     "Has ring of type "+
-                                                     ring.role.GetType()->GetName()+
-                                                     " which is not an area type");
+        progress.ReportRelation(rawRelation.GetId(),
+                                rawRelation.GetType(),
+                                "Has ring of type "+
+                                ring.role.GetType()->GetName()+
+                                " which is not an area type");
 
         ring.role.SetType(typeConfig.typeInfoIgnore);
       }
@@ -1015,6 +1060,7 @@ namespace osmscout {
       auto copyPart=parts.end();
 
       TypeInfoRef masterType=AutodetectRelationType(parameter,
+                                                    progress,
                                                     typeConfig,
                                                     rawRelation,
                                                     parts,
@@ -1036,9 +1082,9 @@ namespace osmscout {
     }
 
     if (masterRing.GetType()==typeConfig.typeInfoIgnore) {
-      parameter.GetErrorReporter()->ReportRelation(rawRelation.GetId(),
-                                                   rawRelation.GetType(),
-                                                   "No type");
+      progress.ReportRelation(rawRelation.GetId(),
+                              rawRelation.GetType(),
+                              "No type");
       return false;
     }
 
@@ -1055,7 +1101,7 @@ namespace osmscout {
         // However because we change the type of area rings to typeIgnore above we need some bookkeeping for this
         // to work here.
         // On the other hand do not fill the blacklist until you are sure that the relation will not be rejected.
-        wayAreaIndexBlacklist.insert(ring.ways.front()->GetId());
+        areaWayIds.push_back(ring.ways.front()->GetId());
       }
     }
 
@@ -1162,6 +1208,251 @@ namespace osmscout {
     return "";
   }
 
+  /**
+   * Checks if the rings of the resolved relation can be written to disk
+   */
+  bool RelAreaDataGenerator::IsWritable(RelationProgress& progress,
+                                        const RawRelation& rawRelation,
+                                        const std::string& name,
+                                        const Area& relation) const
+  {
+    bool valid=true;
+    bool dense=true;
+    bool big=false;
+
+    for (const auto& ring : relation.rings) {
+      if (!ring.IsMaster()) {
+        if (ring.nodes.size()<3) {
+          valid=false;
+          break;
+        }
+
+        if (!IsValidToWrite(ring.nodes)) {
+          dense=false;
+          break;
+        }
+
+        if (ring.nodes.size()>FileWriter::MAX_NODES) {
+          big=true;
+          break;
+        }
+      }
+    }
+
+    if (!valid) {
+      progress.Warning("Relation "+
+                       std::to_string(rawRelation.GetId())+" "+
+                       relation.GetType()->GetName()+" "+
+                       name+" has ring with less than three nodes, skipping");
+      progress.ReportRelation(rawRelation.GetId(),
+                              relation.GetType(),
+                              "Ring with less than three nodes (no area)");
+      return false;
+    }
+
+    if (!dense) {
+      progress.Warning("Relation "+
+                       std::to_string(rawRelation.GetId())+" "+
+                       relation.GetType()->GetName()+" "+
+                       name+" has ring(s) which nodes are not dense enough to be written, skipping");
+      return false;
+    }
+
+    if (big) {
+      progress.Warning("Relation "+
+                       std::to_string(rawRelation.GetId())+" "+
+                       relation.GetType()->GetName()+" "+
+                       name+" has ring(s) with too many nodes, skipping");
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Builds the area of a relation, whose members have already been resolved. Does not
+   * access any files, so that it can run in parallel for multiple relations.
+   */
+  void RelAreaDataGenerator::AssembleRelation(const ImportParameter& parameter,
+                                              const TypeConfig& typeConfig,
+                                              RelationJob& job)
+  {
+    job.write=job.membersResolved &&
+              HandleMultipolygonRelation(parameter,
+                                         job.progress,
+                                         typeConfig,
+                                         job.rawRelation,
+                                         job.name,
+                                         job.parts,
+                                         job.areaWayIds,
+                                         job.relation) &&
+              IsWritable(job.progress,
+                         job.rawRelation,
+                         job.name,
+                         job.relation);
+
+    job.parts.clear();
+  }
+
+  /**
+   * Reads the raw relations and loads their members (ways, coordinates and child relations).
+   *
+   * Loading stays in one thread, since the data files are not thread safe. The number of
+   * relations that are loaded but not yet written is limited by the ticket queue.
+   */
+  class RelAreaDataGenerator::MemberReader CLASS_FINAL : public Producer<RelationJobRef>
+  {
+  private:
+    RelAreaDataGenerator&       generator;
+    const TypeConfig&           typeConfig;
+    const ImportParameter&      parameter;
+    bool                        outputDebug;
+    FileScanner&                scanner;
+    uint32_t                    rawRelationCount;
+    CoordDataFile&              coordDataFile;
+    RawWayIndexedDataFile&      wayDataFile;
+    RawRelationIndexedDataFile& relDataFile;
+    ProcessingQueue<bool>&      tickets;
+    std::string                 errorMessage;
+
+  private:
+    void ProcessingLoop() override
+    {
+      FeatureRef featureName(typeConfig.GetFeature(RefFeature::NAME));
+
+      try {
+        for (uint32_t r=0; r<rawRelationCount; r++) {
+          tickets.PushTask(true);
+
+          auto job=std::make_shared<RelationJob>();
+
+          job->index=r;
+          job->progress.SetOutputDebug(outputDebug);
+
+          job->rawRelation.Read(typeConfig,
+                                scanner);
+
+          // Normally we now also skip an object because of its missing type, but
+          // in case of relations things are a little bit more difficult,
+          // type might be placed at the outer ring and not on the relation
+          // itself, we thus still need to parse the complete relation for
+          // type analysis before we can skip it.
+
+          job->name=generator.ResolveRelationName(featureName,
+                                                  job->rawRelation);
+
+          IdSet resolvedRelations;
+
+          job->membersResolved=generator.ResolveMultipolygonMembers(job->progress,
+                                                                    parameter,
+                                                                    typeConfig,
+                                                                    coordDataFile,
+                                                                    wayDataFile,
+                                                                    relDataFile,
+                                                                    resolvedRelations,
+                                                                    job->relation,
+                                                                    job->name,
+                                                                    job->rawRelation,
+                                                                    job->parts);
+
+          outQueue.PushTask(std::move(job));
+        }
+      }
+      catch (const IOException& e) {
+        errorMessage=e.GetDescription();
+        MarkWorkerAsFailed();
+      }
+
+      outQueue.Stop();
+    }
+
+  public:
+    MemberReader(RelAreaDataGenerator& generator,
+                 const TypeConfig& typeConfig,
+                 const ImportParameter& parameter,
+                 bool outputDebug,
+                 FileScanner& scanner,
+                 uint32_t rawRelationCount,
+                 CoordDataFile& coordDataFile,
+                 RawWayIndexedDataFile& wayDataFile,
+                 RawRelationIndexedDataFile& relDataFile,
+                 ProcessingQueue<bool>& tickets,
+                 ProcessingQueue<RelationJobRef>& outQueue)
+    : Producer(outQueue),
+      generator(generator),
+      typeConfig(typeConfig),
+      parameter(parameter),
+      outputDebug(outputDebug),
+      scanner(scanner),
+      rawRelationCount(rawRelationCount),
+      coordDataFile(coordDataFile),
+      wayDataFile(wayDataFile),
+      relDataFile(relDataFile),
+      tickets(tickets)
+    {
+      Start();
+    }
+
+    std::string GetErrorMessage() const
+    {
+      return errorMessage;
+    }
+  };
+
+  /**
+   * Assembles the rings of relations with already resolved members. The last worker
+   * finishing stops the outgoing queue.
+   */
+  class RelAreaDataGenerator::RingAssembler CLASS_FINAL : public Pipe<RelationJobRef,RelationJobRef>
+  {
+  private:
+    RelAreaDataGenerator&  generator;
+    const TypeConfig&      typeConfig;
+    const ImportParameter& parameter;
+    std::atomic<size_t>&   runningWorkers;
+
+  private:
+    void ProcessingLoop() override
+    {
+      while (true) {
+        std::optional<RelationJobRef> value=inQueue.PopTask();
+
+        if (!value) {
+          break;
+        }
+
+        RelationJobRef job=std::move(value.value());
+
+        generator.AssembleRelation(parameter,
+                                   typeConfig,
+                                   *job);
+
+        outQueue.PushTask(std::move(job));
+      }
+
+      if (--runningWorkers==0) {
+        outQueue.Stop();
+      }
+    }
+
+  public:
+    RingAssembler(RelAreaDataGenerator& generator,
+                  const TypeConfig& typeConfig,
+                  const ImportParameter& parameter,
+                  std::atomic<size_t>& runningWorkers,
+                  ProcessingQueue<RelationJobRef>& inQueue,
+                  ProcessingQueue<RelationJobRef>& outQueue)
+    : Pipe(inQueue,
+           outQueue),
+      generator(generator),
+      typeConfig(typeConfig),
+      parameter(parameter),
+      runningWorkers(runningWorkers)
+    {
+      Start();
+    }
+  };
+
   void RelAreaDataGenerator::GetDescription(const ImportParameter& /*parameter*/,
                                                  ImportModuleDescription& description) const
   {
@@ -1189,7 +1480,6 @@ namespace osmscout {
     RawWayIndexedDataFile      wayDataFile(parameter.GetRawWayIndexCacheSize(),/*dataCache*/0);
 
     RawRelationIndexedDataFile relDataFile(parameter.GetRawWayIndexCacheSize(),/*dataCache*/0);
-    FeatureRef                 featureName(typeConfig->GetFeature(RefFeature::NAME));
 
     if (!coordDataFile.Open(parameter.GetDestinationDirectory(),
                             parameter.GetCoordDataMemoryMaped())) {
@@ -1217,7 +1507,9 @@ namespace osmscout {
     // Analysing distribution of nodes in the given interval size
     //
 
-    progress.SetAction("Generate relarea.tmp");
+    size_t threadCount=GetProcessingThreadCount(parameter.GetProcessingThreadCount());
+
+    progress.SetAction("Generate relarea.tmp with "+std::to_string(threadCount)+" thread(s)");
 
     FileScanner         scanner;
     FileWriter          writer;
@@ -1241,101 +1533,109 @@ namespace osmscout {
 
       writer.Write(writtenRelationCount);
 
-      for (uint32_t r=1; r<=rawRelationCount; r++) {
-        progress.SetProgress(r,rawRelationCount);
-
-        RawRelation rawRel;
-
-        rawRel.Read(*typeConfig,
-                    scanner);
-
-        // Normally we now also skip an object because of its missing type, but
-        // in case of relations things are a little bit more difficult,
-        // type might be placed at the outer ring and not on the relation
-        // itself, we thus still need to parse the complete relation for
-        // type analysis before we can skip it.
-
-        std::string name=ResolveRelationName(featureName,
-                                             rawRel);
-        Area        rel;
-
-        if (!HandleMultipolygonRelation(parameter,
-                                        progress,
-                                        *typeConfig,
-                                        wayAreaIndexBlacklist,
-                                        coordDataFile,
-                                        wayDataFile,
-                                        relDataFile,
-                                        rawRel,
-                                        name,
-                                        rel)) {
-          continue;
+      // Relations are loaded by one thread, assembled by a pool of workers and
+      // written in their original order by this thread
+      ProcessingQueue<bool>                       tickets(threadCount*RELATIONS_IN_FLIGHT_PER_THREAD);
+      ProcessingQueue<RelationJobRef>             loadedQueue(threadCount*RELATIONS_IN_FLIGHT_PER_THREAD);
+      ProcessingQueue<RelationJobRef>             assembledQueue(threadCount*RELATIONS_IN_FLIGHT_PER_THREAD);
+      std::atomic<size_t>                         runningWorkers(threadCount);
+      std::vector<std::shared_ptr<RingAssembler>> assemblerPool;
+      std::map<size_t,RelationJobRef>             assembledJobs;
+      size_t                                      nextIndex=0;
+      std::string                                 writeError;
+
+      MemberReader reader(*this,
+                          *typeConfig,
+                          parameter,
+                          progress.OutputDebug(),
+                          scanner,
+                          rawRelationCount,
+                          coordDataFile,
+                          wayDataFile,
+                          relDataFile,
+                          tickets,
+                          loadedQueue);
+
+      for (size_t t=1; t<=threadCount; t++) {
+        assemblerPool.push_back(std::make_shared<RingAssembler>(*this,
+                                                                *typeConfig,
+                                                                parameter,
+                                                                runningWorkers,
+                                                                loadedQueue,
+                                                                assembledQueue));
+      }
+
+      while (true) {
+        std::optional<RelationJobRef> value=assembledQueue.PopTask();
+
+        if (!value) {
+          break;
         }
 
-        bool valid=true;
-        bool dense=true;
-        bool big=false;
+        assembledJobs[value.value()->index]=std::move(value.value());
 
-        for (const auto& ring : rel.rings) {
-          if (!ring.IsMaster()) {
-            if (ring.nodes.size()<3) {
-              valid=false;
-              break;
-            }
+        while (!assembledJobs.empty() &&
+               assembledJobs.begin()->first==nextIndex) {
+          RelationJobRef job=std::move(assembledJobs.begin()->second);
 
-            if (!IsValidToWrite(ring.nodes)) {
-              dense=false;
-              break;
-            }
+          assembledJobs.erase(assembledJobs.begin());
+          nextIndex++;
 
-            if (ring.nodes.size()>FileWriter::MAX_NODES) {
-              big=true;
-              break;
+          progress.SetProgress(nextIndex,size_t(rawRelationCount));
+
+          job->progress.Replay(progress,
+                               *parameter.GetErrorReporter());
+
+          // Area ways are blacklisted even if the relation itself is skipped later on
+          wayAreaIndexBlacklist.insert(job->areaWayIds.begin(),
+                                       job->areaWayIds.end());
+
+          // On write errors we still consume the remaining jobs, so that all threads can finish
+          if (job->write &&
+              writeError.empty()) {
+            try {
+              const Area& rel=job->relation;
+
+              areaTypeCount[rel.GetType()->GetIndex()]++;
+              for (const auto& ring: rel.rings) {
+                if (ring.IsTopOuter()) {
+                  areaNodeTypeCount[rel.GetType()->GetIndex()]+=ring.nodes.size();
+                }
+              }
+
+              writer.Write((uint8_t)osmRefRelation);
+              writer.Write(job->rawRelation.GetId());
+
+              rel.WriteImport(*typeConfig,
+                              writer);
+
+              writtenRelationCount++;
+            }
+            catch (const IOException& e) {
+              writeError=e.GetDescription();
             }
           }
-        }
 
-        if (!valid) {
-          progress.Warning("Relation "+
-                           std::to_string(rawRel.GetId())+" "+
-                           rel.GetType()->GetName()+" "+
-                           name+" has ring with less than three nodes, skipping");
-          parameter.GetErrorReporter()->ReportRelation(rawRel.GetId(),
-                                                       rel.GetType(),
-                                                       "Ring with less than three nodes (no area)");
-          continue;
+          tickets.PopTask();
         }
+      }
 
-        if (!dense) {
-          progress.Warning("Relation "+
-                           std::to_string(rawRel.GetId())+" "+
-                           rel.GetType()->GetName()+" "+
-                           name+" has ring(s) which nodes are not dense enough to be written, skipping");
-          continue;
-        }
+      reader.Wait();
 
-        if (big) {
-          progress.Warning("Relation "+
-                           std::to_string(rawRel.GetId())+" "+
-                           rel.GetType()->GetName()+" "+
-                           name+" has ring(s) with too many nodes, skipping");
-          continue;
-        }
+      for (auto& assembler : assemblerPool) {
+        assembler->Wait();
+      }
 
-        areaTypeCount[rel.GetType()->GetIndex()]++;
-        for (const auto& ring: rel.rings) {
-          if (ring.IsTopOuter()) {
-            areaNodeTypeCount[rel.GetType()->GetIndex()]+=ring.nodes.size();
-          }
-        }
+      assemblerPool.clear();
 
-        writer.Write((uint8_t)osmRefRelation);
-        writer.Write(rawRel.GetId());
+      if (!reader.WasSuccessful() ||
+          !writeError.empty()) {
+        progress.Error(!reader.WasSuccessful() ? reader.GetErrorMessage() : writeError);
 
-        rel.WriteImport(*typeConfig,
-                        writer);
+        scanner.CloseFailsafe();
+        writer.CloseFailsafe();
 
-        writtenRelationCount++;
+        return false;
       }
 
       progress.Info(std::to_string(rawRelationCount)+" relations read"+
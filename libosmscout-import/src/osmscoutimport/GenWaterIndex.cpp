@@ -313,7 +313,7 @@ namespace osmscout {
 
     std::vector<WaterIndexProcessor::Level>  levels;
 
-    WaterIndexProcessor                      processor;
+    WaterIndexProcessor                      processor(parameter.GetProcessingThreadCount());
 
     //
     // Read bounding box
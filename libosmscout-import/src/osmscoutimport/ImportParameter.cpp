@@ -62,6 +62,7 @@ ImportParameter::ImportParameter()
       sortBlockSize(40000000),
       sortTileMag(14),
       processingQueueSize(std::max((unsigned int)1,std::thread::hardware_concurrency())),
+      processingThreadCount(0),
       numericIndexPageSize(1024),
       rawCoordBlockSize(60000000),
       rawNodeDataMemoryMaped(false),
@@ -97,6 +98,7 @@ ImportParameter::ImportParameter()
       optimizationCellSizeAverage(64),
       optimizationCellSizeMax(255),
       optimizationWayMethod(TransPolygon::quality),
+      optimizationPreserveTopology(true),
       routeNodeBlockSize(500000),
       routeNodeTileMag(13),
       assumeLand(AssumeLandStrategy::automatic),
@@ -104,7 +106,8 @@ ImportParameter::ImportParameter()
       maxAdminLevel(10),
       firstFreeOSMId(((OSMId)1) << ((sizeof(OSMId)*8)-2)),
       fillWaterArea(20),
-      textIndexVariant(TextIndexVariant::transliterate)
+      textIndexVariant(TextIndexVariant::transliterate),
+      blockCoordEncoding(false)
 {
   // no code
 }
@@ -184,6 +187,11 @@ size_t ImportParameter::GetProcessingQueueSize() const
   return processingQueueSize;
 }
 
+size_t ImportParameter::GetProcessingThreadCount() const
+{
+  return processingThreadCount;
+}
+
 size_t ImportParameter::GetNumericIndexPageSize() const
 {
   return numericIndexPageSize;
@@ -359,6 +367,11 @@ TransPolygon::OptimizeMethod ImportParameter::GetOptimizationWayMethod() const
   return optimizationWayMethod;
 }
 
+bool ImportParameter::GetOptimizationPreserveTopology() const
+{
+  return optimizationPreserveTopology;
+}
+
 size_t ImportParameter::GetRouteNodeBlockSize() const
 {
   return routeNodeBlockSize;
@@ -471,6 +484,11 @@ void ImportParameter::SetProcessingQueueSize(size_t processingQueueSize)
   this->processingQueueSize=processingQueueSize;
 }
 
+void ImportParameter::SetProcessingThreadCount(size_t processingThreadCount)
+{
+  this->processingThreadCount=processingThreadCount;
+}
+
 void ImportParameter::SetNumericIndexPageSize(size_t numericIndexPageSize)
 {
   this->numericIndexPageSize=numericIndexPageSize;
@@ -596,6 +614,16 @@ ImportParameter::TextIndexVariant ImportParameter::GetTextIndexVariant() const
   return textIndexVariant;
 }
 
+void ImportParameter::SetBlockCoordEncoding(bool blockCoordEncoding)
+{
+  this->blockCoordEncoding=blockCoordEncoding;
+}
+
+bool ImportParameter::GetBlockCoordEncoding() const
+{
+  return blockCoordEncoding;
+}
+
 void ImportParameter::SetAreaWayIndexMinMag(MagnificationLevel areaWayMinMag)
 {
   this->areaWayIndexMinMag=areaWayMinMag;
@@ -658,6 +686,11 @@ void ImportParameter::SetOptimizationWayMethod(TransPolygon::OptimizeMethod opti
   this->optimizationWayMethod=optimizationWayMethod;
 }
 
+void ImportParameter::SetOptimizationPreserveTopology(bool optimizationPreserveTopology)
+{
+  this->optimizationPreserveTopology=optimizationPreserveTopology;
+}
+
 void ImportParameter::SetRouteNodeBlockSize(size_t blockSize)
 {
   this->routeNodeBlockSize=blockSize;
@@ -177,7 +177,8 @@ namespace osmscout {
         TagId id=typeConfig.GetTagRegistry().GetTagId((const char*)keyValue);
 
         if (id!=tagIgnore) {
-          tags[id]=(const char*)valueValue;
+          tags.SetView(id,
+                       blockData->tagValues.Intern((const char*)valueValue));
         }
       }
       else if (strcmp((const char*)name,"nd")==0) {
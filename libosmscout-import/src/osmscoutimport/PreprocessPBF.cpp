@@ -296,7 +296,7 @@ namespace osmscout {
     data.nodeData.reserve(data.nodeData.size()+group.nodes_size());
 
     for (int n=0; n<group.nodes_size(); n++) {
-      PreprocessorCallback::RawNodeData nodeData;
+      PreprocessorCallback::RawNodeData nodeData(data.tagValues.GetResource());
 
       const OSMPBF::Node &inputNode=group.nodes(n);
 
@@ -310,7 +310,8 @@ namespace osmscout {
         TagId id=typeConfig.GetTagId(block.stringtable().s(inputNode.keys(t)));
 
         if (id!=tagIgnore) {
-          nodeData.tags[id]=block.stringtable().s(inputNode.vals(t));
+          nodeData.tags.SetView(id,
+                                data.tagValues.Intern(block.stringtable().s(inputNode.vals(t))));
         }
       }
 
@@ -332,7 +333,7 @@ namespace osmscout {
     data.nodeData.reserve(data.nodeData.size()+dense.id_size());
 
     for (int d=0; d<dense.id_size();d++) {
-      PreprocessorCallback::RawNodeData nodeData;
+      PreprocessorCallback::RawNodeData nodeData(data.tagValues.GetResource());
 
       dId+=dense.id(d);
       dLat+=dense.lat(d);
@@ -355,7 +356,8 @@ namespace osmscout {
         TagId id=typeConfig.GetTagId(block.stringtable().s(dense.keys_vals(t)));
 
         if (id!=tagIgnore) {
-          nodeData.tags[id]=block.stringtable().s(dense.keys_vals(t+1));
+          nodeData.tags.SetView(id,
+                                data.tagValues.Intern(block.stringtable().s(dense.keys_vals(t+1))));
         }
 
         t+=2;
@@ -373,7 +375,7 @@ namespace osmscout {
     data.wayData.reserve(data.wayData.size()+group.ways_size());
 
     for (int w=0; w<group.ways_size(); w++) {
-      PreprocessorCallback::RawWayData wayData;
+      PreprocessorCallback::RawWayData wayData(data.tagValues.GetResource());
 
       const OSMPBF::Way &inputWay=group.ways(w);
 
@@ -383,7 +385,8 @@ namespace osmscout {
         TagId id=typeConfig.GetTagId(block.stringtable().s(inputWay.keys(t)));
 
         if (id!=tagIgnore) {
-          wayData.tags[id]=block.stringtable().s(inputWay.vals(t));
+          wayData.tags.SetView(id,
+                               data.tagValues.Intern(block.stringtable().s(inputWay.vals(t))));
         }
       }
 
@@ -408,7 +411,7 @@ namespace osmscout {
     data.relationData.reserve(data.relationData.size()+group.relations_size());
 
     for (int r=0; r<group.relations_size(); r++) {
-      PreprocessorCallback::RawRelationData relationData;
+      PreprocessorCallback::RawRelationData relationData(data.tagValues.GetResource());
 
       const OSMPBF::Relation &inputRelation=group.relations(r);
 
@@ -420,7 +423,8 @@ namespace osmscout {
         TagId id=typeConfig.GetTagId(block.stringtable().s(inputRelation.keys(t)));
 
         if (id!=tagIgnore) {
-          relationData.tags[id]=block.stringtable().s(inputRelation.vals(t));
+          relationData.tags.SetView(id,
+                                    data.tagValues.Intern(block.stringtable().s(inputRelation.vals(t))));
         }
       }
 
@@ -69,7 +69,8 @@ namespace osmscout {
     PreprocessorCallback::RawBlockDataRef block=std::make_shared<PreprocessorCallback::RawBlockData>();
     PreprocessorCallback::RawWayData      way;
 
-    way.tags[polygonTagId]=context==IncludedPolygon ? "include" : "exclude";
+    way.tags.SetView(polygonTagId,
+                     context==IncludedPolygon ? "include" : "exclude");
     way.id=availableId++;
 
     for (const auto& p : polygonNodes) {
@@ -22,12 +22,38 @@
 #include <osmscout/util/Exception.h>
 
 #include <cstring>
-#include <array>
 #include <cstdint>
 #include <limits>
 
 namespace osmscout {
 
+  static int32_t DecodeIntegerBE(const uint8_t* bytes)
+  {
+    return (int32_t)((((uint32_t)bytes[0]) << 24) | (((uint32_t)bytes[1]) << 16) | (((uint32_t)bytes[2]) << 8) | bytes[3]);
+  }
+
+  static int32_t DecodeIntegerLE(const uint8_t* bytes)
+  {
+    return (int32_t)((((uint32_t)bytes[3]) << 24) | (((uint32_t)bytes[2]) << 16) | (((uint32_t)bytes[1]) << 8) | bytes[0]);
+  }
+
+  static double DecodeDoubleLE(const uint8_t* bytes)
+  {
+    static_assert(sizeof(double)==8, "Only 64 bit IEEE doubles are supported");
+    static_assert(std::numeric_limits<double>::is_iec559, "Only 64 bit IEEE doubles are supported");
+
+    double value;
+
+    // we need to do this:
+    //   value=*(reinterpret_cast<const double*>(bytes));
+    // but type punning is undefined behavior in C++17 (and older)
+    // memcpy is the only way howto do it safely, luckily compilers
+    // are smart enough to generate the same assembly
+    std::memcpy(&value,bytes,8);
+
+    return value;
+  }
+
   void ShapeFileVisitor::OnFileBoundingBox(const GeoBox& /*boundingBox*/)
   {
     // no code
@@ -80,63 +106,19 @@ namespace osmscout {
     }
   }
 
-  uint8_t ShapeFileScanner::ReadByte()
+  /**
+   * Reads the next `size` bytes of the file into the internal buffer
+   */
+  const uint8_t* ShapeFileScanner::ReadBlock(size_t size)
   {
-    uint8_t value;
+    data.resize(size);
 
-    if (fread(&value,1,1,file)!=1) {
-      throw IOException(filename,"Cannot read byte");
+    if (size>0 &&
+        fread(data.data(),1,size,file)!=size) {
+      throw IOException(filename,"Cannot read "+std::to_string(size)+" bytes");
     }
 
-    return value;
-  }
-
-  int32_t ShapeFileScanner::ReadIntegerBE()
-  {
-    uint8_t v1=ReadByte();
-    uint8_t v2=ReadByte();
-    uint8_t v3=ReadByte();
-    uint8_t v4=ReadByte();
-
-    return (int32_t)((((uint32_t)v1) << 24) | (((uint32_t)v2) << 16) | (((uint32_t)v3) << 8) | v4);
-  }
-
-  int32_t ShapeFileScanner::ReadIntegerLE()
-  {
-    uint8_t v1=ReadByte();
-    uint8_t v2=ReadByte();
-    uint8_t v3=ReadByte();
-    uint8_t v4=ReadByte();
-
-    return (int32_t)((((uint32_t)v4) << 24) | (((uint32_t)v3) << 16) | (((uint32_t)v2) << 8) | v1);
-  }
-
-  double ShapeFileScanner::ReadDoubleLE()
-  {
-    double         value;
-
-    std::array<uint8_t, 8> valueBytes;
-
-    valueBytes[0]=ReadByte();
-    valueBytes[1]=ReadByte();
-    valueBytes[2]=ReadByte();
-    valueBytes[3]=ReadByte();
-    valueBytes[4]=ReadByte();
-    valueBytes[5]=ReadByte();
-    valueBytes[6]=ReadByte();
-    valueBytes[7]=ReadByte();
-
-    static_assert(sizeof(double)==8, "Only 64 bit IEEE doubles are supported");
-    static_assert(std::numeric_limits<double>::is_iec559, "Only 64 bit IEEE doubles are supported");
-
-    // we need to do this:
-    //   value=*(reinterpret_cast<double*>(valueBytes.data()));
-    // but type punning is undefined behavior in C++17 (and older)
-    // memcpy is the only way howto do it safely, luckily compilers
-    // are smart enough to generate the same assembly
-    std::memcpy(&value, valueBytes.data(), 8);
-
-    return value;
+    return data.data();
   }
 
   void ShapeFileScanner::Visit(ShapeFileVisitor& visitor)
@@ -152,55 +134,61 @@ namespace osmscout {
       throw IOException(filename,"Cannot go to start of file");
     }
 
-    int32_t fileCode=ReadIntegerBE();
+    // Main file header
+    const size_t   headerSize=100;
+    const uint8_t* header=ReadBlock(headerSize);
+
+    int32_t fileCode=DecodeIntegerBE(header);
 
     if (fileCode!=9994) {
       throw IOException(filename,"Format error","Expected file code 9994, got "+std::to_string(fileCode));
     }
 
-    // Skip reserved space
-    for (size_t i=1; i<=5; i++) {
-      /* ignore */ReadIntegerBE();
-    }
+    // Bytes 4 to 23 are reserved
 
-    int32_t fileLength=ReadIntegerBE()*2; // fileLength is in 2 byte units
-    int32_t version   =ReadIntegerLE();
+    int32_t fileLength=DecodeIntegerBE(header+24)*2; // fileLength is in 2 byte units
+    int32_t version   =DecodeIntegerLE(header+28);
 
     if (version!=1000) {
       throw IOException(filename,"Format error","Expected shape file version 1000, got "+std::to_string(version));
     }
 
-    int32_t shapeType=ReadIntegerLE();
+    int32_t shapeType=DecodeIntegerLE(header+32);
 
     if (shapeType!=3) {
       throw IOException(filename,"Not implemented","Shapes of type "+std::to_string(shapeType)+" are not supported");
     }
 
-    double xMin=ReadDoubleLE();
-    double yMin=ReadDoubleLE();
-    double xMax=ReadDoubleLE();
-    double yMax=ReadDoubleLE();
+    double xMin=DecodeDoubleLE(header+36);
+    double yMin=DecodeDoubleLE(header+44);
+    double xMax=DecodeDoubleLE(header+52);
+    double yMax=DecodeDoubleLE(header+60);
 
     visitor.OnFileBoundingBox(GeoBox(GeoCoord(yMin,xMin),
                                      GeoCoord(yMax,xMax)));
 
-    [[maybe_unused]] double zMin=ReadDoubleLE();
-    [[maybe_unused]] double zMax=ReadDoubleLE();
-    [[maybe_unused]] double mMin=ReadDoubleLE();
-    [[maybe_unused]] double mMax=ReadDoubleLE();
-
-    long filePos=ftell(file);
+    // z and m ranges are not evaluated
 
-    if (filePos==-1) {
-      throw IOException(filename,"Error while retrieving current file position");
-    }
+    // Records are read sequentially, so we calculate the file position instead of asking for it
+    long filePos=headerSize;
 
     while (filePos+1<fileLength) {
       visitor.OnProgress(filePos,fileLength);
 
-      int32_t recordNumber           =ReadIntegerBE();
-      [[maybe_unused]] int32_t length=ReadIntegerBE();
-      int32_t recordShapeType        =ReadIntegerLE();
+      const uint8_t* recordHeader=ReadBlock(8);
+
+      int32_t recordNumber=DecodeIntegerBE(recordHeader);
+      int32_t length      =DecodeIntegerBE(recordHeader+4)*2; // length is in 2 byte units
+
+      if (length<4) {
+        throw IOException(filename,
+                          "Error while reading shape file record",
+                          "Invalid length "+std::to_string(length)+" of record "+std::to_string(recordNumber));
+      }
+
+      const uint8_t* record=ReadBlock((size_t)length);
+
+      int32_t recordShapeType=DecodeIntegerLE(record);
 
       if (recordShapeType==3) {
         if (recordShapeType!=shapeType) {
@@ -210,30 +198,43 @@ namespace osmscout {
                             ", but shape type of record is "+std::to_string(recordShapeType));
         }
 
-        double recordXMin=ReadDoubleLE();
-        double recordXMax=ReadDoubleLE();
-        double recordYMin=ReadDoubleLE();
-        double recordYMax=ReadDoubleLE();
+        if (length<44) {
+          throw IOException(filename,
+                            "Error while reading shape file record",
+                            "Record "+std::to_string(recordNumber)+" is too short");
+        }
+
+        double recordXMin=DecodeDoubleLE(record+4);
+        double recordXMax=DecodeDoubleLE(record+12);
+        double recordYMin=DecodeDoubleLE(record+20);
+        double recordYMax=DecodeDoubleLE(record+28);
 
         GeoBox recordBoundingBox(GeoCoord(recordYMin,recordXMin),
                                  GeoCoord(recordYMax,recordXMax));
 
-        int32_t numParts =ReadIntegerLE();
-        int32_t numPoints=ReadIntegerLE();
+        int32_t numParts =DecodeIntegerLE(record+36);
+        int32_t numPoints=DecodeIntegerLE(record+40);
 
-        for (int32_t i=1; i<=numParts; i++) {
-          [[maybe_unused]] int32_t startIndex=ReadIntegerLE();
-          // We current do not evaluate start index
+        if (numParts<0 ||
+            numPoints<0 ||
+            44+4*(int64_t)numParts+16*(int64_t)numPoints>length) {
+          throw IOException(filename,
+                            "Error while reading shape file record",
+                            "Record "+std::to_string(recordNumber)+" has invalid part or point count");
         }
 
+        // We current do not evaluate the start index of the parts
+        const uint8_t* points=record+44+4*(size_t)numParts;
+
         buffer.clear();
         buffer.reserve((size_t)numPoints);
 
-        for (int32_t i=1; i<=numPoints; i++) {
-          double x=ReadDoubleLE();
-          double y=ReadDoubleLE();
+        for (int32_t i=0; i<numPoints; i++) {
+          double x=DecodeDoubleLE(points);
+          double y=DecodeDoubleLE(points+8);
 
           buffer.emplace_back(y,x);
+          points+=16;
         }
 
         visitor.OnPolyline(recordNumber,
@@ -244,11 +245,7 @@ namespace osmscout {
         throw IOException(filename,"Not implemented","Shapes of type "+std::to_string(shapeType)+" not supported");
       }
 
-      filePos=ftell(file);
-
-      if (filePos==-1) {
-        throw IOException(filename,"Error while retrieving current file position");
-      }
+      filePos+=8+length;
     }
   }
 }
@@ -31,6 +31,8 @@
 #include <osmscout/util/StopClock.h>
 #include <osmscout/util/Geometry.h>
 
+#include <osmscoutimport/ParallelProcessing.h>
+
 namespace osmscout {
 #ifdef OSMSCOUT_DEBUG_COASTLINE
 constexpr bool debugCoastline = true;
@@ -229,8 +231,10 @@ constexpr bool debugTiling = false;
   {
     double aSize = a->boundingBox.GetSize();
     double bSize = b->boundingBox.GetSize();
+    // Tie on the id instead of the address, so that the order does not depend on
+    // the allocation order
     if (aSize==bSize)
-      return a < b;
+      return a->id < b->id;
     // descending
     return aSize > bSize;
   }
@@ -1118,108 +1122,132 @@ constexpr bool debugTiling = false;
     }
   }
 
-  void WaterIndexProcessor::TransformCoastlines(Progress& progress,
-                                                TransPolygon::OptimizeMethod optimizationMethod,
-                                                double tolerance,
-                                                double minObjectDimension,
-                                                const Projection& projection,
-                                                const std::list<CoastRef>& coastlines,
-                                                std::vector<CoastlineDataRef> &transformedCoastlines)
+  /**
+   * Transforms the given coast for the current magnification. Returns an empty reference
+   * if the coast is too small to be visible.
+   */
+  WaterIndexProcessor::CoastlineDataRef WaterIndexProcessor::TransformCoastline(TransPolygon::OptimizeMethod optimizationMethod,
+                                                                                double tolerance,
+                                                                                double minObjectDimension,
+                                                                                const Projection& projection,
+                                                                                const Coast& coast)
   {
-    int index=-1;
-
-    transformedCoastlines.reserve(coastlines.size());
-
-    for (const auto& coast : coastlines) {
-      index++;
-      progress.SetProgress(index,coastlines.size());
-
-      TransBuffer transBuffer;
-
-      // For areas we first transform the bounding box to make sure, that
-      // the area coastline will be big enough to be actually visible
-      if (coast->isArea) {
-
-        GeoBox boundingBox;
-        GetBoundingBox(coast->coast, boundingBox);
-        TransformBoundingBox(boundingBox,
-                             transBuffer,
-                             projection,
-                             optimizationMethod,
-                             1.0,
-                             TransPolygon::simple);
-
-        double minX=transBuffer.points[transBuffer.GetStart()].x;
-        double minY=transBuffer.points[transBuffer.GetStart()].y;
-        double maxX=minX;
-        double maxY=minY;
-
-        for (size_t p=transBuffer.GetStart()+1; p<=transBuffer.GetEnd(); p++) {
-          if (transBuffer.points[p].draw) {
-            minX=std::min(minX,transBuffer.points[p].x);
-            maxX=std::max(maxX,transBuffer.points[p].x);
-            minY=std::min(minY,transBuffer.points[p].y);
-            maxY=std::max(maxY,transBuffer.points[p].y);
-          }
+    TransBuffer transBuffer;
+
+    // For areas we first transform the bounding box to make sure, that
+    // the area coastline will be big enough to be actually visible
+    if (coast.isArea) {
+
+      GeoBox boundingBox;
+      GetBoundingBox(coast.coast, boundingBox);
+      TransformBoundingBox(boundingBox,
+                           transBuffer,
+                           projection,
+                           optimizationMethod,
+                           1.0,
+                           TransPolygon::simple);
+
+      double minX=transBuffer.points[transBuffer.GetStart()].x;
+      double minY=transBuffer.points[transBuffer.GetStart()].y;
+      double maxX=minX;
+      double maxY=minY;
+
+      for (size_t p=transBuffer.GetStart()+1; p<=transBuffer.GetEnd(); p++) {
+        if (transBuffer.points[p].draw) {
+          minX=std::min(minX,transBuffer.points[p].x);
+          maxX=std::max(maxX,transBuffer.points[p].x);
+          minY=std::min(minY,transBuffer.points[p].y);
+          maxY=std::max(maxY,transBuffer.points[p].y);
         }
+      }
 
-        double pixelWidth=maxX-minX;
-        double pixelHeight=maxY-minY;
+      double pixelWidth=maxX-minX;
+      double pixelHeight=maxY-minY;
 
-        // Artificial values but for drawing an area a box of at least 4x4 might make sense
-        if (pixelWidth<=minObjectDimension ||
-            pixelHeight<=minObjectDimension) {
-          continue;
-        }
+      // Artificial values but for drawing an area a box of at least 4x4 might make sense
+      if (pixelWidth<=minObjectDimension ||
+          pixelHeight<=minObjectDimension) {
+        return nullptr;
       }
+    }
 
-      if (coast->isArea) {
-        TransformArea(coast->coast,
-                      transBuffer,
-                      projection,
-                      optimizationMethod,
-                      tolerance,
-                      TransPolygon::simple);
-      }
-      else {
-        TransformWay(coast->coast,
-                     transBuffer,
-                     projection,
-                     optimizationMethod,
-                     tolerance,
-                     TransPolygon::simple);
-      }
+    if (coast.isArea) {
+      TransformArea(coast.coast,
+                    transBuffer,
+                    projection,
+                    optimizationMethod,
+                    tolerance,
+                    TransPolygon::simple);
+    }
+    else {
+      TransformWay(coast.coast,
+                   transBuffer,
+                   projection,
+                   optimizationMethod,
+                   tolerance,
+                   TransPolygon::simple);
+    }
 
-      CoastlineDataRef coastline=std::make_shared<CoastlineData>();
+    CoastlineDataRef coastline=std::make_shared<CoastlineData>();
 
-      coastline->id=coast->id;
-      coastline->isArea=coast->isArea;
-      coastline->right=coast->right;
-      coastline->left=coast->left;
-      coastline->points.reserve(transBuffer.GetLength());
+    coastline->id=coast.id;
+    coastline->isArea=coast.isArea;
+    coastline->right=coast.right;
+    coastline->left=coast.left;
+    coastline->points.reserve(transBuffer.GetLength());
 
-      for (size_t p=transBuffer.GetStart(); p<=transBuffer.GetEnd(); p++) {
-        if (transBuffer.points[p].draw) {
-          coastline->points.push_back(coast->coast[p].GetCoord());
-        }
+    for (size_t p=transBuffer.GetStart(); p<=transBuffer.GetEnd(); p++) {
+      if (transBuffer.points[p].draw) {
+        coastline->points.push_back(coast.coast[p].GetCoord());
       }
+    }
 
-      // Currently transformation optimization code sometimes does not correctly handle the closing point for areas
-      if (coast->isArea) {
-        if (coastline->points.front()!=coastline->points.back()) {
-          coastline->points.push_back(coastline->points.front());
-        }
+    // Currently transformation optimization code sometimes does not correctly handle the closing point for areas
+    if (coast.isArea) {
+      if (coastline->points.front()!=coastline->points.back()) {
+        coastline->points.push_back(coastline->points.front());
+      }
 
-        if (coastline->points.size()<=3) {
-          // ignore island reduced just to line
-          continue;
-        }
+      if (coastline->points.size()<=3) {
+        // ignore island reduced just to line
+        return nullptr;
       }
+    }
 
-      // compute bounding box after transformation
-      GetBoundingBox(coastline->points, coastline->boundingBox);
+    // compute bounding box after transformation
+    GetBoundingBox(coastline->points, coastline->boundingBox);
 
-      transformedCoastlines.push_back(coastline);
+    return coastline;
+  }
+
+  void WaterIndexProcessor::TransformCoastlines(Progress& progress,
+                                                TransPolygon::OptimizeMethod optimizationMethod,
+                                                double tolerance,
+                                                double minObjectDimension,
+                                                const Projection& projection,
+                                                const std::list<CoastRef>& coastlines,
+                                                std::vector<CoastlineDataRef> &transformedCoastlines)
+  {
+    std::vector<CoastRef>         coasts(coastlines.begin(),coastlines.end());
+    std::vector<CoastlineDataRef> results(coasts.size());
+
+    ProcessInStrips(progress,
+                    threadCount,
+                    coasts.size(),
+                    [&](size_t index, Progress& /*stripProgress*/) {
+                      results[index]=TransformCoastline(optimizationMethod,
+                                                        tolerance,
+                                                        minObjectDimension,
+                                                        projection,
+                                                        *coasts[index]);
+                    });
+
+    transformedCoastlines.reserve(results.size());
+
+    for (auto& coastline : results) {
+      if (coastline) {
+        transformedCoastlines.push_back(std::move(coastline));
+      }
     }
   }
 
@@ -1229,19 +1257,24 @@ constexpr bool debugTiling = false;
     progress.Info("Filter intersecting coastlines");
 
     // sort by the size (GeoBox::GetSize, descending)
-    std::sort(transformedCoastlines.begin(),
-              transformedCoastlines.end(),
-              CoastlineGeoSizeSorter);
+    std::stable_sort(transformedCoastlines.begin(),
+                     transformedCoastlines.end(),
+                     CoastlineGeoSizeSorter);
 
-    for (size_t i=0; i<transformedCoastlines.size(); i++) {
-      progress.SetProgress(i,transformedCoastlines.size());
+    // Detect all intersecting pairs in parallel...
+    std::vector<std::vector<size_t>> intersectingCoastlines(transformedCoastlines.size());
+
+    ProcessInStrips(progress,
+                    threadCount,
+                    transformedCoastlines.size(),
+                    [&transformedCoastlines,&intersectingCoastlines](size_t i, Progress& /*stripProgress*/) {
+      const CoastlineDataRef& a=transformedCoastlines[i];
 
       for (size_t j=i+1; j<transformedCoastlines.size(); j++) {
         assert(i!=j);
-        CoastlineDataRef a=transformedCoastlines[i];
-        CoastlineDataRef b=transformedCoastlines[j];
+        const CoastlineDataRef& b=transformedCoastlines[j];
 
-        if (!a || !b || (!a->isArea && !b->isArea)) {
+        if (!a->isArea && !b->isArea) {
           // ignore possible intersections between two coastline ways (it may be touching)
           continue;
         }
@@ -1259,27 +1292,41 @@ constexpr bool debugTiling = false;
                               b->isArea,
                               intersections);
 
-        // TODO: merge coastlines, not remove them
         if (!intersections.empty()) {
-          progress.Warning("Detected intersection "+std::to_string(a->id)+" <> "+std::to_string(b->id));
+          intersectingCoastlines[i].push_back(j);
+        }
+      }
+    });
 
-          if (a->isArea && !b->isArea) {
-            transformedCoastlines[i]=nullptr;
-          }
-          else if (b->isArea && !a->isArea) {
-            transformedCoastlines[j]=nullptr;
-          }
-          else {
-            assert(a->boundingBox.GetSize() > b->boundingBox.GetSize()); // should be descending
-
-            // in case of base map import, even continents are closed areas (islands in our terminology)
-            // and there may be intersections between them (Africa and Euro-Asia for example)
-            // in that case give up removing and hope that both continents will be handled properly
-            if (b->boundingBox.GetSize() > 100){
-              progress.Warning("Cannot remove such huge island/continent: "+std::to_string(b->id)+"");
-            }else {
-              transformedCoastlines[j] = nullptr;
-            }
+    // ...and decide about removal in the original order, since it depends on previous removals
+    for (size_t i=0; i<transformedCoastlines.size(); i++) {
+      for (size_t j : intersectingCoastlines[i]) {
+        CoastlineDataRef a=transformedCoastlines[i];
+        CoastlineDataRef b=transformedCoastlines[j];
+
+        if (!a || !b) {
+          continue;
+        }
+
+        // TODO: merge coastlines, not remove them
+        progress.Warning("Detected intersection "+std::to_string(a->id)+" <> "+std::to_string(b->id));
+
+        if (a->isArea && !b->isArea) {
+          transformedCoastlines[i]=nullptr;
+        }
+        else if (b->isArea && !a->isArea) {
+          transformedCoastlines[j]=nullptr;
+        }
+        else {
+          assert(a->boundingBox.GetSize() > b->boundingBox.GetSize()); // should be descending
+
+          // in case of base map import, even continents are closed areas (islands in our terminology)
+          // and there may be intersections between them (Africa and Euro-Asia for example)
+          // in that case give up removing and hope that both continents will be handled properly
+          if (b->boundingBox.GetSize() > 100){
+            progress.Warning("Cannot remove such huge island/continent: "+std::to_string(b->id)+"");
+          }else {
+            transformedCoastlines[j] = nullptr;
           }
         }
       }
@@ -1358,25 +1405,45 @@ constexpr bool debugTiling = false;
 
     // filter island encapsulated by some bigger islands
     // note: coastlines should be sorted already by its size, descending
-    for (size_t ai=0; ai<transformedCoastlines.size(); ai++) {
-      progress.SetProgress(ai, transformedCoastlines.size());
-      CoastlineDataRef a = transformedCoastlines[ai];
+    std::vector<std::vector<size_t>> encapsulatedCoastlines(transformedCoastlines.size());
+
+    ProcessInStrips(progress,
+                    threadCount,
+                    transformedCoastlines.size(),
+                    [&transformedCoastlines,&encapsulatedCoastlines](size_t ai, Progress& /*stripProgress*/) {
+      const CoastlineDataRef& a = transformedCoastlines[ai];
       if (!a || a->left != CoastState::land){
-        continue;
+        return;
       }
 
       for (size_t bi=ai+1; bi<transformedCoastlines.size(); bi++) {
-        CoastlineDataRef b = transformedCoastlines[bi];
+        const CoastlineDataRef& b = transformedCoastlines[bi];
         assert(ai!=bi);
 
-        if (a && b && a->isArea && b->isArea && b->left == CoastState::land) {
+        if (a->isArea && b && b->isArea && b->left == CoastState::land) {
           if (a->boundingBox.Intersects(b->boundingBox, false) &&
               IsAreaCompletelyInArea(b->points, a->points)){
-            progress.Warning("Island " + std::to_string(b->id) + " is encapsulated in island " + std::to_string(a->id));
-            transformedCoastlines[bi] = nullptr;
+            encapsulatedCoastlines[ai].push_back(bi);
           }
         }
       }
+    });
+
+    // Islands already removed do not remove other islands
+    for (size_t ai=0; ai<transformedCoastlines.size(); ai++) {
+      const CoastlineDataRef a = transformedCoastlines[ai];
+      if (!a) {
+        continue;
+      }
+
+      for (size_t bi : encapsulatedCoastlines[ai]) {
+        const CoastlineDataRef& b = transformedCoastlines[bi];
+
+        if (b) {
+          progress.Warning("Island " + std::to_string(b->id) + " is encapsulated in island " + std::to_string(a->id));
+          transformedCoastlines[bi] = nullptr;
+        }
+      }
     }
 
     // erase removed coastlines
@@ -1392,21 +1459,30 @@ constexpr bool debugTiling = false;
                                                 std::vector<CoastlineDataRef> &transformedCoastlines){
 
     progress.Info("Calculate covered tiles");
-    size_t curCoast=0;
 
-    data.coastlines.resize(transformedCoastlines.size());
+    // Index of each coastline in data.coastlines
+    std::vector<size_t> coastIndexes(transformedCoastlines.size());
+    size_t              curCoast=0;
 
     for (size_t index=0; index<transformedCoastlines.size(); index++) {
-      progress.SetProgress(index,transformedCoastlines.size());
+      coastIndexes[index]=curCoast;
+
+      if (transformedCoastlines[index]) {
+        curCoast++;
+      }
+    }
 
-      CoastlineDataRef coastline=transformedCoastlines[index];
+    // Calculating the cell intersections is the expensive part, it only touches the coastline itself
+    ProcessInStrips(progress,
+                    threadCount,
+                    transformedCoastlines.size(),
+                    [&](size_t index, Progress& /*stripProgress*/) {
+      const CoastlineDataRef& coastline=transformedCoastlines[index];
 
       if (!coastline) {
-        continue;
+        return;
       }
 
-      data.coastlines[curCoast]=coastline;
-
       uint32_t cxMin,cxMax,cyMin,cyMax;
 
       cxMin=(uint32_t)((coastline->boundingBox.GetMinLon()+180.0)/stateMap.GetCellWidth());
@@ -1419,12 +1495,6 @@ constexpr bool debugTiling = false;
         coastline->cell.x=cxMin;
         coastline->cell.y=cyMin;
         coastline->isCompletelyInCell=true;
-
-        if (stateMap.IsInAbsolute(coastline->cell.x,coastline->cell.y)) {
-          Pixel coord(coastline->cell.x-stateMap.GetXStart(),
-                      coastline->cell.y-stateMap.GetYStart());
-          data.cellCoveredCoastlines[coord].push_back(curCoast);
-        }
       }
       else {
         coastline->isCompletelyInCell=false;
@@ -1432,9 +1502,29 @@ constexpr bool debugTiling = false;
         // Calculate all intersections for all path steps for all cells covered
         GetCellIntersections(stateMap,
                              coastline->points,
-                             curCoast,
+                             coastIndexes[index],
                              coastline->cellIntersections);
+      }
+    });
+
+    data.coastlines.resize(transformedCoastlines.size());
+    curCoast=0;
+
+    for (const auto& coastline : transformedCoastlines) {
+      if (!coastline) {
+        continue;
+      }
+
+      data.coastlines[curCoast]=coastline;
 
+      if (coastline->isCompletelyInCell) {
+        if (stateMap.IsInAbsolute(coastline->cell.x,coastline->cell.y)) {
+          Pixel coord(coastline->cell.x-stateMap.GetXStart(),
+                      coastline->cell.y-stateMap.GetYStart());
+          data.cellCoveredCoastlines[coord].push_back(curCoast);
+        }
+      }
+      else {
         for (const auto& intersectionEntry : coastline->cellIntersections) {
           data.cellCoastlines[intersectionEntry.first].push_back(curCoast);
         }
@@ -2043,7 +2133,7 @@ constexpr bool debugTiling = false;
                                                 const Pixel &cell,
                                                 const std::list<size_t>& intersectCoastlines,
                                                 const StateMap& stateMap,
-                                                std::map<Pixel,std::list<GroundTile> >& cellGroundTileMap,
+                                                std::list<GroundTile>& groundTiles,
                                                 Data& data)
   {
       std::list<IntersectionRef> intersectionsCW;        // Intersections in clock wise order over all coastlines
@@ -2153,7 +2243,7 @@ constexpr bool debugTiling = false;
             continue;
         }
 
-        cellGroundTileMap[cell].push_back(groundTile);
+        groundTiles.push_back(groundTile);
       }
   }
 
@@ -2167,22 +2257,41 @@ constexpr bool debugTiling = false;
   {
     progress.Info("Handle coastlines partially in a cell");
 
-    // For every cell with intersections
-    size_t currentCell=0;
-    for (const auto& cellEntry : data.cellCoastlines) {
-      progress.SetProgress(currentCell,data.cellCoastlines.size());
-      currentCell++;
+    using CellEntry = std::map<Pixel,std::list<size_t>>::const_iterator;
+
+    std::vector<CellEntry>             cells;
+    std::vector<std::list<GroundTile>> cellGroundTiles(data.cellCoastlines.size());
+
+    cells.reserve(data.cellCoastlines.size());
+
+    for (auto cellEntry=data.cellCoastlines.cbegin(); cellEntry!=data.cellCoastlines.cend(); ++cellEntry) {
+      cells.push_back(cellEntry);
+    }
+
+    // For every cell with intersections, cells are independent of each other
+    ProcessInStrips(progress,
+                    threadCount,
+                    cells.size(),
+                    [&](size_t index, Progress& stripProgress) {
+      const auto& cellEntry=*cells[index];
 
       if constexpr (debugCoastline) {
         std::cout << " - cell " << cellEntry.first.GetDisplayText() << "" << std::endl;
       }
 
-      HandleCoastlineCell(progress,
+      HandleCoastlineCell(stripProgress,
                           cellEntry.first,
                           cellEntry.second,
                           stateMap,
-                          cellGroundTileMap,
+                          cellGroundTiles[index],
                           data);
+    });
+
+    for (size_t index=0; index<cells.size(); index++) {
+      if (!cellGroundTiles[index].empty()) {
+        cellGroundTileMap[cells[index]->first].splice(cellGroundTileMap[cells[index]->first].end(),
+                                                      cellGroundTiles[index]);
+      }
     }
   }
 
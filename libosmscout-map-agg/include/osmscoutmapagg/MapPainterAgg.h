@@ -72,6 +72,23 @@ namespace osmscout {
     typedef agg::conv_curve<AggFontManager::path_adaptor_type> AggTextCurveConverter;
     typedef agg::conv_contour<AggTextCurveConverter>           AggTextContourConverter;
 
+    /**
+     * Glyph codes and positions of a shaped text. Labels reference glyphs
+     * in the font cache, which may drop fonts at any time, so the glyphs
+     * itself are looked up again for each use.
+     */
+    struct ShapedGlyph {
+      wchar_t character;
+      double  x;
+      double  y;
+    };
+    struct ShapedText {
+      std::wstring             text;
+      std::vector<ShapedGlyph> glyphs;
+      double                   width=0.0;
+      double                   height=0.0;
+    };
+
     AggLabelLayouter labelLayouter;
 
   private:
@@ -81,10 +98,12 @@ namespace osmscout {
     AggScanline               *scanlineP8;
     AggScanlineRendererAA     *renderer_aa;
     AggScanlineRendererBin    *renderer_bin;
-    AggFontEngine             *fontEngine;
-    AggFontManager            *fontCacheManager;
-    AggTextCurveConverter     *convTextCurves;
-    AggTextContourConverter   *convTextContours;
+    AggFontEngine             *fontEngine=nullptr;       //! Font engine, kept between frames
+    AggFontManager            *fontCacheManager=nullptr; //! Cache of rasterized glyphs, kept between frames
+    AggTextCurveConverter     *convTextCurves=nullptr;
+    AggTextContourConverter   *convTextContours=nullptr;
+
+    TextLayoutCache<ShapedText> textLayoutCache;  //! Cached glyph positions of labels, reused between frames
 
     std::mutex                mutex;              //! Mutex for locking concurrent calls
 
@@ -94,6 +113,8 @@ namespace osmscout {
                  double size,
                  agg::glyph_rendering ren_type = agg::glyph_ren_native_gray8);
 
+    std::shared_ptr<ShapedText> Shape(const std::string& text);
+
     void GetTextDimension(const std::wstring& text,
                           double& width,
                           double& height);
@@ -215,6 +236,8 @@ namespace osmscout {
                  AggPixelFormat* pf,
                  RenderSteps startStep=RenderSteps::FirstStep,
                  RenderSteps endStep=RenderSteps::LastStep);
+
+    std::optional<TextLayoutCacheStatistics> GetTextLayoutCacheStatistics() const override;
   };
 }
 
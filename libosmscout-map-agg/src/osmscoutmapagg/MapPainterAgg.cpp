@@ -47,8 +47,10 @@ namespace osmscout {
 
   MapPainterAgg::~MapPainterAgg()
   {
-    // no code
-    // TODO: Clean up fonts
+    delete convTextContours;
+    delete convTextCurves;
+    delete fontCacheManager;
+    delete fontEngine;
   }
 
   void MapPainterAgg::SetFont(const Projection& projection,
@@ -359,51 +361,85 @@ namespace osmscout {
     return result;
   }
 
-  std::shared_ptr<MapPainterAgg::AggLabel> MapPainterAgg::Layout(const Projection& projection,
-                                                                 const MapParameter& parameter,
-                                                                 const std::string& text,
-                                                                 double fontSize,
-                                                                 double /*objectWidth*/,
-                                                                 bool /*enableWrapping*/,
-                                                                 bool contourLabel)
+  std::shared_ptr<MapPainterAgg::ShapedText> MapPainterAgg::Shape(const std::string& text)
   {
-    MapPainterAgg::NativeLabel label{};
-    label.text = UTF8StringToWString(text);
+    auto result=std::make_shared<ShapedText>();
 
-    SetFont(projection,
-            parameter,
-            fontSize,
-            contourLabel ? agg::glyph_ren_outline : agg::glyph_ren_native_gray8);
+    result->text=UTF8StringToWString(text);
+    result->height=fontEngine->height();
 
     fontCacheManager->reset_last_glyph();
     double x = 0;
     double y = 0;
-    double w = 0;
-    double h=fontEngine->height();
-    for (wchar_t i : label.text) {
+    for (wchar_t i : result->text) {
       const agg::glyph_cache *glyph = fontCacheManager->glyph(i);
       if (glyph==nullptr) {
         continue; // silently skip glyph
       }
       fontCacheManager->add_kerning(&x, &y);
-      label.glyphs.emplace_back(MapPainterAgg::NativeGlyph{x, y, glyph});
+      result->glyphs.push_back(ShapedGlyph{i, x, y});
 
-      w += glyph->advance_x;
+      result->width += glyph->advance_x;
 
       // increment pen position
       x += glyph->advance_x;
       y += glyph->advance_y;
     }
 
+    return result;
+  }
+
+  std::shared_ptr<MapPainterAgg::AggLabel> MapPainterAgg::Layout(const Projection& projection,
+                                                                 const MapParameter& parameter,
+                                                                 const std::string& text,
+                                                                 double fontSize,
+                                                                 double /*objectWidth*/,
+                                                                 bool /*enableWrapping*/,
+                                                                 bool contourLabel)
+  {
+    SetFont(projection,
+            parameter,
+            fontSize,
+            contourLabel ? agg::glyph_ren_outline : agg::glyph_ren_native_gray8);
+
+    TextLayoutKey key;
+
+    key.text=text;
+    key.fontName=parameter.GetFontName();
+    key.fontSize=fontSize;
+    key.pixelSize=fontEngine->height();
+    key.contourLabel=contourLabel;
+
+    std::shared_ptr<ShapedText> shapedText=textLayoutCache.GetOrCreate(key,[this,&text]() {
+      return Shape(text);
+    });
+
+    MapPainterAgg::NativeLabel label{};
+    label.text = shapedText->text;
+    label.glyphs.reserve(shapedText->glyphs.size());
+
+    for (const auto& shapedGlyph : shapedText->glyphs) {
+      // Rasterized glyphs are cached by the font cache manager
+      const agg::glyph_cache *glyph = fontCacheManager->glyph(shapedGlyph.character);
+      if (glyph==nullptr) {
+        continue;
+      }
+      label.glyphs.emplace_back(MapPainterAgg::NativeGlyph{shapedGlyph.x, shapedGlyph.y, glyph});
+    }
+
     std::shared_ptr<MapPainterAgg::AggLabel> result = std::make_shared<MapPainterAgg::AggLabel>();
-    result->label = label;
-    result->height = h;
-    result->width = w;
+    result->label = std::move(label);
+    result->height = shapedText->height;
+    result->width = shapedText->width;
     result->fontSize = fontSize;
     result->text = text;
     return result;
   }
 
+  std::optional<TextLayoutCacheStatistics> MapPainterAgg::GetTextLayoutCacheStatistics() const
+  {
+    return textLayoutCache.GetStatistics();
+  }
 
   void MapPainterAgg::RegisterRegularLabel(const Projection &projection,
                                            const MapParameter &parameter,
@@ -731,13 +767,19 @@ namespace osmscout {
       scanlineP8=new AggScanline();
       renderer_aa=new AggScanlineRendererAA(*renderer_base);
       renderer_bin=new AggScanlineRendererBin(*renderer_base);
-      fontEngine=new AggFontEngine();
-      fontCacheManager=new AggFontManager(*fontEngine);
 
-      convTextCurves=new AggTextCurveConverter(fontCacheManager->path_adaptor());
-      convTextCurves->approximation_scale(2.0);
+      // Fonts and rasterized glyphs are kept for the next frames
+      if (fontEngine==nullptr) {
+        fontEngine=new AggFontEngine();
+        fontCacheManager=new AggFontManager(*fontEngine);
+
+        convTextCurves=new AggTextCurveConverter(fontCacheManager->path_adaptor());
+        convTextCurves->approximation_scale(2.0);
+
+        convTextContours= new AggTextContourConverter(*convTextCurves);
+      }
 
-      convTextContours= new AggTextContourConverter(*convTextCurves);
+      textLayoutCache.SetCapacity(parameter.GetTextLayoutCacheSize());
     }
 
     result=Draw(projection,
@@ -747,10 +789,6 @@ namespace osmscout {
                 endStep);
 
     if (endStep==RenderSteps::Postrender) {
-      delete convTextCurves;
-      delete convTextContours;
-      delete fontEngine;
-      delete fontCacheManager;
       delete renderer_bin;
       delete renderer_aa;
       delete scanlineP8;
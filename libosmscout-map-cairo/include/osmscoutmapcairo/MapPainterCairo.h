@@ -90,6 +90,7 @@ namespace osmscout {
     std::vector<cairo_surface_t*>          patternImages;    //! vector of cairo surfaces for patterns
     std::vector<cairo_pattern_t*>          patterns;         //! cairo pattern structure for patterns
     FontMap                                fonts;            //! Cached scaled font
+    TextLayoutCache<CairoLabel>            textLayoutCache;  //! Cached label layouts, reused between frames
     double                                 minimumLineWidth; //! Minimum width a line must have to be visible
 
     std::mutex                             mutex;            //! Mutex for locking concurrent calls
@@ -99,6 +100,13 @@ namespace osmscout {
                  const MapParameter& parameter,
                  double fontSize);
 
+    std::shared_ptr<CairoLabel> CreateLayout(const Projection& projection,
+                                             const MapParameter& parameter,
+                                             const std::string& text,
+                                             double fontSize,
+                                             double objectWidth,
+                                             bool enableWrapping);
+
     void SetLineAttributes(const Color& color,
                            double width,
                            const std::vector<double>& dash);
@@ -214,6 +222,8 @@ namespace osmscout {
                  cairo_t *draw,
                  RenderSteps startStep=RenderSteps::FirstStep,
                  RenderSteps endStep=RenderSteps::LastStep);
+
+    std::optional<TextLayoutCacheStatistics> GetTextLayoutCacheStatistics() const override;
   };
 }
 
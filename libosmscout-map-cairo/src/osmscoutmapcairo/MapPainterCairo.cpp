@@ -269,6 +269,9 @@ namespace osmscout {
 
   MapPainterCairo::~MapPainterCairo()
   {
+    // Cached layouts may reference the fonts released below
+    textLayoutCache.Clear();
+
     for (const auto &image : images) {
       if (image != nullptr) {
         cairo_surface_destroy(image);
@@ -739,13 +742,12 @@ namespace osmscout {
     return result;
   }
 
-  std::shared_ptr<MapPainterCairo::CairoLabel> MapPainterCairo::Layout(const Projection& projection,
-                                                                       const MapParameter& parameter,
-                                                                       const std::string& text,
-                                                                       double fontSize,
-                                                                       double objectWidth,
-                                                                       bool enableWrapping,
-                                                                       bool /*contourLabel*/)
+  std::shared_ptr<MapPainterCairo::CairoLabel> MapPainterCairo::CreateLayout(const Projection& projection,
+                                                                             const MapParameter& parameter,
+                                                                             const std::string& text,
+                                                                             double fontSize,
+                                                                             double objectWidth,
+                                                                             bool enableWrapping)
   {
     auto label = std::make_shared<MapPainterCairo::CairoLabel>(
         std::shared_ptr<PangoLayout>(pango_cairo_create_layout(draw), g_object_unref));
@@ -911,13 +913,12 @@ namespace osmscout {
     cairo_set_matrix(draw, &matrix);
   }
 
-  std::shared_ptr<MapPainterCairo::CairoLabel> MapPainterCairo::Layout(const Projection& projection,
-                                                                       const MapParameter& parameter,
-                                                                       const std::string& text,
-                                                                       double fontSize,
-                                                                       double /*objectWidth*/,
-                                                                       bool /*enableWrapping*/,
-                                                                       bool /*contourLabel*/)
+  std::shared_ptr<MapPainterCairo::CairoLabel> MapPainterCairo::CreateLayout(const Projection& projection,
+                                                                             const MapParameter& parameter,
+                                                                             const std::string& text,
+                                                                             double fontSize,
+                                                                             double /*objectWidth*/,
+                                                                             bool /*enableWrapping*/)
   {
     auto label = std::make_shared<MapPainterCairo::CairoLabel>();
 
@@ -941,6 +942,39 @@ namespace osmscout {
 
 #endif
 
+  std::shared_ptr<MapPainterCairo::CairoLabel> MapPainterCairo::Layout(const Projection& projection,
+                                                                       const MapParameter& parameter,
+                                                                       const std::string& text,
+                                                                       double fontSize,
+                                                                       double objectWidth,
+                                                                       bool enableWrapping,
+                                                                       bool contourLabel)
+  {
+    TextLayoutKey key;
+
+    key.text=text;
+    key.fontName=parameter.GetFontName();
+    key.fontSize=fontSize;
+    key.pixelSize=fontSize*projection.ConvertWidthToPixel(parameter.GetFontSize());
+    key.wrapWidth=(int)std::ceil(objectWidth);
+    key.enableWrapping=enableWrapping;
+    key.contourLabel=contourLabel;
+
+    return textLayoutCache.GetOrCreate(key,[&]() {
+      return CreateLayout(projection,
+                          parameter,
+                          text,
+                          fontSize,
+                          objectWidth,
+                          enableWrapping);
+    });
+  }
+
+  std::optional<TextLayoutCacheStatistics> MapPainterCairo::GetTextLayoutCacheStatistics() const
+  {
+    return textLayoutCache.GetStatistics();
+  }
+
   void MapPainterCairo::DrawLabel(const Projection &/*projection*/,
                                   const MapParameter &/*parameter*/,
                                   const ScreenVectorRectangle &labelRectangle,
@@ -1308,6 +1342,8 @@ namespace osmscout {
 
     this->draw=draw;
 
+    textLayoutCache.SetCapacity(parameter.GetTextLayoutCacheSize());
+
     minimumLineWidth=parameter.GetLineMinWidthPixel()*25.4/projection.GetDPI();
 
     return Draw(projection,
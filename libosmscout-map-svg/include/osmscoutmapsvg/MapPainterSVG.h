@@ -81,6 +81,10 @@ namespace osmscout {
 
     SvgLabelLayouter                  labelLayouter;
 
+#if defined(OSMSCOUT_MAP_SVG_HAVE_LIB_PANGO)
+    TextLayoutCache<SvgLabel>         textLayoutCache; //! Cached label layouts, reused between frames
+#endif
+
     std::map<FillStyle,std::string>   fillStyleNameMap;
     std::map<BorderStyle,std::string> borderStyleNameMap;
     std::map<LineStyle,std::string>   lineStyleNameMap;
@@ -120,6 +124,13 @@ namespace osmscout {
                                   const MapParameter& parameter,
                                   double fontSize);
 
+    std::shared_ptr<SvgLabel> CreateLayout(const Projection& projection,
+                                           const MapParameter& parameter,
+                                           const std::string& text,
+                                           double fontSize,
+                                           double objectWidth,
+                                           bool enableWrapping);
+
 #endif
 
     void SetupFillAndStroke(const FillStyleRef &fillStyle,
@@ -248,6 +259,10 @@ namespace osmscout {
                  const MapParameter& parameter,
                  const MapData& data,
                  std::ostream& stream);
+
+#if defined(OSMSCOUT_MAP_SVG_HAVE_LIB_PANGO)
+    std::optional<TextLayoutCacheStatistics> GetTextLayoutCacheStatistics() const override;
+#endif
   };
 }
 
@@ -58,6 +58,8 @@ namespace osmscout {
   MapPainterSVG::~MapPainterSVG()
   {
 #if defined(OSMSCOUT_MAP_SVG_HAVE_LIB_PANGO)
+    textLayoutCache.Clear();
+
     for (FontMap::const_iterator entry=fonts.begin();
          entry!=fonts.end();
          ++entry) {
@@ -97,7 +99,39 @@ namespace osmscout {
                                                                  double fontSize,
                                                                  double objectWidth,
                                                                  bool enableWrapping,
-                                                                 bool /*contourLabel*/)
+                                                                 bool contourLabel)
+  {
+    TextLayoutKey key;
+
+    key.text=text;
+    key.fontName=parameter.GetFontName();
+    key.fontSize=fontSize;
+    key.pixelSize=fontSize*projection.ConvertWidthToPixel(parameter.GetFontSize());
+    key.wrapWidth=(int)std::ceil(objectWidth);
+    key.enableWrapping=enableWrapping;
+    key.contourLabel=contourLabel;
+
+    return textLayoutCache.GetOrCreate(key,[&]() {
+      return CreateLayout(projection,
+                          parameter,
+                          text,
+                          fontSize,
+                          objectWidth,
+                          enableWrapping);
+    });
+  }
+
+  std::optional<TextLayoutCacheStatistics> MapPainterSVG::GetTextLayoutCacheStatistics() const
+  {
+    return textLayoutCache.GetStatistics();
+  }
+
+  std::shared_ptr<MapPainterSVG::SvgLabel> MapPainterSVG::CreateLayout(const Projection& projection,
+                                                                       const MapParameter& parameter,
+                                                                       const std::string& text,
+                                                                       double fontSize,
+                                                                       double objectWidth,
+                                                                       bool enableWrapping)
   {
     auto label = std::make_shared<MapPainterSVG::SvgLabel>(
         std::shared_ptr<PangoLayout>(pango_layout_new(pangoContext), g_object_unref));
@@ -1045,6 +1079,10 @@ namespace osmscout {
     this->stream.rdbuf(stream.rdbuf());
     typeConfig=styleConfig->GetTypeConfig();
 
+#if defined(OSMSCOUT_MAP_SVG_HAVE_LIB_PANGO)
+    textLayoutCache.SetCapacity(parameter.GetTextLayoutCacheSize());
+#endif
+
     WriteHeader(projection.GetWidth(),projection.GetHeight());
 
     result=Draw(projection,
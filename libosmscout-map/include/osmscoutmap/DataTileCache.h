@@ -20,7 +20,10 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -35,6 +38,8 @@
 
 #include <osmscout/TypeInfoSet.h>
 
+#include <osmscout/async/AtomicSharedPtr.h>
+
 #include <osmscout/util/GeoBox.h>
 #include <osmscout/util/Magnification.h>
 #include <osmscout/util/TileId.h>
@@ -43,35 +48,165 @@
 
 namespace osmscout {
 
+  /**
+   * \ingroup tiledcache
+   *
+   * Estimated number of bytes of heap memory held by the given object (the object
+   * itself and its node and segment arrays). Used to limit the memory of the
+   * DataTileCache.
+   */
+  extern OSMSCOUT_MAP_API size_t GetObjectMemorySize(const NodeRef& node);
+  extern OSMSCOUT_MAP_API size_t GetObjectMemorySize(const WayRef& way);
+  extern OSMSCOUT_MAP_API size_t GetObjectMemorySize(const AreaRef& area);
+  extern OSMSCOUT_MAP_API size_t GetObjectMemorySize(const RouteRef& route);
+
   /**
    * \ingroup tiledcache
    *
    * Template for storing sets of data of the same type in a tile. Normally data will either be NodeRef, WayRef or AreaRef.
+   *
+   * The data is held in an immutable snapshot, that is replaced atomically on every change.
+   * Readers work on the current snapshot without any locking, so they never block loaders
+   * (and vice versa). Writers are serialized, each write copies the snapshot, but not the
+   * object lists, which are shared between snapshots.
    */
   template<typename O>
   class OSMSCOUT_MAP_API TileData
   {
   private:
-    mutable std::mutex mutex;
+    using ObjectList    = std::vector<O>;
+    using ObjectListRef = std::shared_ptr<const ObjectList>;
+
+    /**
+     * Immutable state of the tile data
+     */
+    struct State
+    {
+      TypeInfoSet                types;
+
+      std::vector<ObjectListRef> prefillData;
+      std::vector<ObjectListRef> data;
+
+      bool                       complete=false;
+      size_t                     generation=0;        //!< Incremented on every change of the data
+      size_t                     dataSize=0;          //!< Number of objects in prefill data and data
+      size_t                     prefillMemorySize=0; //!< Estimated memory of the prefill lists, without the shared objects
+      size_t                     memorySize=0;        //!< Estimated memory of the data
+    };
+
+    using StateRef = std::shared_ptr<const State>;
+
+  private:
+    std::mutex                   writeMutex; //!< Serializes writers
+    AtomicSharedPtr<const State> state;      //!< Current snapshot
+
+  private:
+    static size_t GetMemorySize(const ObjectList& objects)
+    {
+      size_t size=sizeof(O)*objects.capacity();
 
-    TypeInfoSet        types;
+      for (const auto& object : objects) {
+        size+=GetObjectMemorySize(object);
+      }
 
-    std::vector<O>     prefillData;
-    std::vector<O>     data;
+      return size;
+    }
 
-    bool               complete=false;
+    /**
+     * Prefilled objects are shared with the tile they were taken from, which already
+     * accounts for them. Only the list itself is owned by this tile.
+     */
+    static size_t GetPrefillMemorySize(const ObjectList& objects)
+    {
+      return sizeof(O)*objects.capacity();
+    }
+
+    static size_t GetDataSize(const std::vector<ObjectListRef>& lists)
+    {
+      size_t size=0;
+
+      for (const auto& list : lists) {
+        size+=list->size();
+      }
+
+      return size;
+    }
+
+    /**
+     * Calls the given function for a copy of the current state and publishes the
+     * modified copy afterwards
+     */
+    template<typename Function>
+    void Update(Function function)
+    {
+      std::scoped_lock<std::mutex> guard(writeMutex);
+
+      auto newState=std::make_shared<State>(*state.Load());
+
+      function(*newState);
+
+      state.Store(std::move(newState));
+    }
+
+    void AddPrefillList(const TypeInfoSet& types,
+                        ObjectListRef&& list)
+    {
+      size_t memory=GetPrefillMemorySize(*list);
+
+      Update([&types,&list,memory](State& newState) {
+        if (newState.types.Empty()) {
+          newState.types=types;
+        }
+        else {
+          newState.types.Add(types);
+        }
+
+        newState.dataSize+=list->size();
+        newState.prefillMemorySize+=memory;
+
+        if (!list->empty()) {
+          newState.prefillData.push_back(std::move(list));
+        }
+
+        newState.generation++;
+        newState.complete=false;
+      });
+    }
+
+    void SetList(const TypeInfoSet& types,
+                 ObjectListRef&& list)
+    {
+      size_t memory=GetMemorySize(*list);
+
+      Update([&types,&list,memory](State& newState) {
+        newState.data.clear();
+        newState.types=types;
+        newState.memorySize=memory;
+
+        if (!list->empty()) {
+          newState.data.push_back(std::move(list));
+        }
+
+        newState.dataSize=GetDataSize(newState.prefillData)+
+                          GetDataSize(newState.data);
+        newState.generation++;
+        newState.complete=true;
+      });
+    }
 
   public:
     /**
      * Create an empty and unassigned TileData
      */
-    TileData() = default;
+    TileData()
+    : state(std::make_shared<const State>())
+    {
+      // no code
+    }
 
     bool IsEmpty() const
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      return types.Empty();
+      return state.Load()->types.Empty();
     }
 
     /**
@@ -79,9 +214,9 @@ namespace osmscout {
      */
     void Invalidate()
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      complete=false;
+      Update([](State& newState) {
+        newState.complete=false;
+      });
     }
 
     /**
@@ -91,24 +226,8 @@ namespace osmscout {
     void AddPrefillData(const TypeInfoSet& types,
                         const std::vector<O>& data)
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      if (this->types.Empty()) {
-        this->types=types;
-      }
-      else {
-        this->types.Add(types);
-      }
-
-      if (this->prefillData.empty()) {
-        this->prefillData=data;
-      }
-      else {
-        this->prefillData.reserve(this->prefillData.size()+data.size());
-        this->prefillData.insert(this->prefillData.end(),data.begin(),data.end());
-      }
-
-      complete=false;
+      AddPrefillList(types,
+                     std::make_shared<const ObjectList>(data));
     }
 
     /**
@@ -118,24 +237,8 @@ namespace osmscout {
     void AddPrefillData(const TypeInfoSet& types,
                         std::vector<O>&& data)
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      if (this->types.Empty()) {
-        this->types=types;
-      }
-      else {
-        this->types.Add(types);
-      }
-
-      if (this->prefillData.empty()) {
-        this->prefillData=std::move(data);
-      }
-      else {
-        this->prefillData.reserve(this->prefillData.size()+data.size());
-        this->prefillData.insert(this->prefillData.end(),data.begin(),data.end());
-      }
-
-      complete=false;
+      AddPrefillList(types,
+                     std::make_shared<const ObjectList>(std::move(data)));
     }
 
     /**
@@ -144,12 +247,21 @@ namespace osmscout {
     void AddData(const TypeInfoSet& types,
                  const std::vector<O>& data)
     {
-      std::scoped_lock<std::mutex> guard(mutex);
+      ObjectListRef list=std::make_shared<const ObjectList>(data);
+      size_t        memory=GetMemorySize(*list);
 
-      this->data.insert(this->data.end(), data.begin(), data.end());
-      this->types.Add(types);
+      Update([&types,&list,memory](State& newState) {
+        newState.types.Add(types);
+        newState.dataSize+=list->size();
+        newState.memorySize+=memory;
 
-      complete=true;
+        if (!list->empty()) {
+          newState.data.push_back(std::move(list));
+        }
+
+        newState.generation++;
+        newState.complete=true;
+      });
     }
 
     /**
@@ -158,12 +270,8 @@ namespace osmscout {
     void SetData(const TypeInfoSet& types,
                  const std::vector<O>& data)
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      this->data=data;
-      this->types=types;
-
-      complete=true;
+      SetList(types,
+              std::make_shared<const ObjectList>(data));
     }
 
     /**
@@ -172,12 +280,8 @@ namespace osmscout {
     void SetData(const TypeInfoSet& types,
                  std::vector<O>&& data)
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      this->data=std::move(data);
-      this->types=types;
-
-      complete=true;
+      SetList(types,
+              std::make_shared<const ObjectList>(std::move(data)));
     }
 
     /**
@@ -186,9 +290,9 @@ namespace osmscout {
      */
     void SetComplete()
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      complete=true;
+      Update([](State& newState) {
+        newState.complete=true;
+      });
     }
 
     /**
@@ -196,9 +300,7 @@ namespace osmscout {
      */
     bool IsComplete() const
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      return complete;
+      return state.Load()->complete;
     }
 
     /**
@@ -209,24 +311,49 @@ namespace osmscout {
      */
     TypeInfoSet GetTypes() const
     {
-      std::scoped_lock<std::mutex> guard(mutex);
-
-      return types;
+      return state.Load()->types;
     }
 
     size_t GetDataSize() const
     {
-      std::scoped_lock<std::mutex> guard(mutex);
+      return state.Load()->dataSize;
+    }
 
-      return prefillData.size()+data.size();
+    /**
+     * Return the estimated number of bytes held by the data of the tile
+     */
+    size_t GetMemorySize() const
+    {
+      StateRef current=state.Load();
+
+      return sizeof(ObjectListRef)*(current->prefillData.capacity()+current->data.capacity())+
+             current->prefillMemorySize+
+             current->memorySize;
+    }
+
+    /**
+     * Return a counter, that changes every time data is assigned to the tile
+     */
+    size_t GetGeneration() const
+    {
+      return state.Load()->generation;
     }
 
+    /**
+     * Call the given function for all objects of the tile. The objects are taken
+     * from a consistent snapshot of the data, concurrent changes are not visible.
+     */
     void CopyData(std::function<void(const O&)> function) const
     {
-      std::scoped_lock<std::mutex> guard(mutex);
+      StateRef current=state.Load();
+
+      for (const auto& list : current->prefillData) {
+        std::for_each(list->begin(),list->end(),function);
+      }
 
-      std::for_each(prefillData.begin(),prefillData.end(),function);
-      std::for_each(data.begin(),data.end(),function);
+      for (const auto& list : current->data) {
+        std::for_each(list->begin(),list->end(),function);
+      }
     }
   };
 
@@ -421,6 +548,34 @@ namespace osmscout {
              optimizedAreaData.IsComplete();
     }
 
+    /**
+     * Return a counter, that changes every time data is assigned to any of the data
+     * sets of the tile
+     */
+    size_t GetDataGeneration() const
+    {
+      return nodeData.GetGeneration()+
+             wayData.GetGeneration()+
+             areaData.GetGeneration()+
+             routeData.GetGeneration()+
+             optimizedWayData.GetGeneration()+
+             optimizedAreaData.GetGeneration();
+    }
+
+    /**
+     * Return the estimated number of bytes held by the data of the tile
+     */
+    size_t GetMemorySize() const
+    {
+      return sizeof(Tile)+
+             nodeData.GetMemorySize()+
+             wayData.GetMemorySize()+
+             areaData.GetMemorySize()+
+             routeData.GetMemorySize()+
+             optimizedWayData.GetMemorySize()+
+             optimizedAreaData.GetMemorySize();
+    }
+
     /**
      * Return 'true' if no data for any type has been assigned
      */
@@ -446,12 +601,21 @@ namespace osmscout {
    * \ingroup tiledcache
    *
    * Data cache using tile based cache pages. The cache holds a number of of tiles. The
-   * maximum number of tiles hold can be configured. Tiles however will only be freed
-   * if a cleanup is explicitely triggered. So temporary overbooking can happen. This should
-   * assure that prefilling of tiles is possible even with a very low limit.
+   * maximum number of tiles hold and the maximum (estimated) memory used by them can be
+   * configured. Tiles however will only be freed if a cleanup is explicitely triggered.
+   * So temporary overbooking can happen. This should assure that prefilling of tiles is
+   * possible even with a very low limit.
    *
    * The cache will free least recently used tiles first,
    *
+   * Tiles of all levels form a quadtree. New tiles get prefilled with data of the nearest
+   * cached ancestor (filtered by the bounding box of the tile) or - if all four children
+   * are cached - with the merged data of the children. This way zooming in and out can
+   * often be served without loading data from disk.
+   *
+   * If pan prefetch is enabled, the cache remembers the last requested tile box per
+   * level and offers the tiles next to the box in the direction of the last movement
+   * via GetPrefetchTiles().
    */
   class OSMSCOUT_MAP_API DataTileCache
   {
@@ -484,10 +648,15 @@ namespace osmscout {
     using CacheIndex = std::map<TileKey, CacheRef>;
 
   private:
-    size_t             cacheSize;
+    size_t                           cacheSize;
+    size_t                           memoryLimit=0;     //!< Maximum estimated memory in bytes, 0 for no limit
+    bool                             panPrefetch=true;  //!< Calculate prefetch tiles in pan direction
+
+    mutable CacheIndex               tileIndex;
+    mutable Cache                    tileCache;
 
-    mutable CacheIndex tileIndex;
-    mutable Cache      tileCache;
+    mutable std::map<uint32_t,TileIdBox> lastRequestBoxes; //!< Tile box of the last request per magnification level
+    mutable std::list<TileKey>           prefetchKeys;     //!< Tiles to prefetch in pan direction
 
     void ResolveNodesFromParent(Tile& tile,
                                 const Tile& parentTile,
@@ -506,6 +675,15 @@ namespace osmscout {
                                  const GeoBox& boundingBox,
                                  const TypeInfoSet& routeTypes);
 
+    void ResolveFromChildren(Tile& tile,
+                             const std::array<TileRef,4>& childTiles,
+                             const TypeInfoSet& nodeTypes,
+                             const TypeInfoSet& wayTypes,
+                             const TypeInfoSet& routeTypes);
+
+    void UpdatePrefetchKeys(const Magnification& magnification,
+                            const TileIdBox& box) const;
+
   public:
     explicit DataTileCache(size_t cacheSize);
 
@@ -521,6 +699,25 @@ namespace osmscout {
       return tileCache.size();
     }
 
+    void SetMemoryLimit(size_t memoryLimit);
+
+    /**
+     * Return the maximum estimated memory in bytes, 0 if there is no limit
+     */
+    size_t GetMemoryLimit() const
+    {
+      return memoryLimit;
+    }
+
+    size_t GetCurrentMemory() const;
+
+    void SetPanPrefetch(bool panPrefetch);
+
+    bool IsPanPrefetch() const
+    {
+      return panPrefetch;
+    }
+
     void CleanupCache();
 
     void InvalidateCache();
@@ -528,6 +725,8 @@ namespace osmscout {
     TileRef GetCachedTile(const TileKey& id) const;
     TileRef GetTile(const TileKey& id) const;
 
+    void GetPrefetchTiles(std::list<TileRef>& tiles) const;
+
     void GetTilesForBoundingBox(const Magnification& magnification,
                                 const GeoBox& boundingBox,
                                 std::list<TileRef>& tiles) const;
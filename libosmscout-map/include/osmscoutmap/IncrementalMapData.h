@@ -0,0 +1,179 @@
+#ifndef OSMSCOUT_MAP_INCREMENTALMAPDATA_H
+#define OSMSCOUT_MAP_INCREMENTALMAPDATA_H
+
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <array>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <osmscoutmap/MapImportExport.h>
+
+#include <osmscout/TypeInfoSet.h>
+
+#include <osmscoutmap/DataTileCache.h>
+#include <osmscoutmap/MapData.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Renderer
+   *
+   * Keeps the state required to assemble MapData from a list of tiles incrementally.
+   *
+   * Instead of rebuilding the deduplicated object lists from all tiles on every frame,
+   * the tiles passed to the previous call are remembered. Only objects of tiles that were
+   * added, removed or changed since then are processed. Objects are reference counted, so an
+   * object contained in multiple tiles stays part of the MapData until the last tile holding
+   * it is gone. While panning or zooming the cost is thus proportional to the number of
+   * changed tiles and not to the number of visible tiles.
+   *
+   * The object vectors of the MapData instance are updated in place, so the same MapData
+   * instance must be passed on every call. If a different instance is passed or the
+   * object vectors have been changed by someone else, the MapData is rebuilt completely.
+   * The order of the objects in the vectors is not stable.
+   *
+   * Instances are not thread safe.
+   */
+  class OSMSCOUT_MAP_API IncrementalMapData CLASS_FINAL
+  {
+  public:
+    /**
+     * Optional type filter for the individual object sets. An object set
+     * without a filter takes over all objects of the tiles.
+     */
+    struct OSMSCOUT_MAP_API TypeFilter
+    {
+      std::optional<TypeInfoSet> nodeTypes;
+      std::optional<TypeInfoSet> wayTypes;
+      std::optional<TypeInfoSet> areaTypes;
+      std::optional<TypeInfoSet> routeTypes;
+      std::optional<TypeInfoSet> optimizedWayTypes;
+      std::optional<TypeInfoSet> optimizedAreaTypes;
+
+      bool operator==(const TypeFilter& other) const;
+    };
+
+    /**
+     * Statistics of the last call to Update()
+     */
+    struct OSMSCOUT_MAP_API Statistics
+    {
+      size_t addedTiles=0;     //!< Number of tiles that were not part of the previous call
+      size_t removedTiles=0;   //!< Number of tiles of the previous call, that are gone
+      size_t changedTiles=0;   //!< Number of tiles, whose data changed since the previous call
+      size_t keptTiles=0;      //!< Number of tiles, that did not change
+      size_t addedObjects=0;   //!< Number of objects added to the MapData
+      size_t removedObjects=0; //!< Number of objects removed from the MapData
+      bool   rebuild=false;    //!< The MapData was assembled from scratch
+    };
+
+  private:
+    /**
+     * The deduplicated, reference counted objects of one object vector of MapData.
+     * Ways and areas are fed from two sources (normal and optimized data), with
+     * separate offset spaces.
+     */
+    template<class O>
+    class ObjectSet
+    {
+    private:
+      struct Entry
+      {
+        size_t refCount=0; //!< Number of tiles holding the object
+        size_t index=0;    //!< Index of the object in the MapData vector
+      };
+
+    public:
+      static constexpr size_t SourceCount=2;
+
+    private:
+      std::array<std::unordered_map<FileOffset,Entry>,SourceCount> entries;
+      std::vector<std::pair<size_t,FileOffset>>                    owners; //!< Source and offset for each object in the vector
+
+    public:
+      bool Add(size_t source,
+               const O& object,
+               std::vector<O>& objects);
+      bool Remove(size_t source,
+                  FileOffset offset,
+                  std::vector<O>& objects);
+      void Clear();
+
+      size_t GetSize() const
+      {
+        return owners.size();
+      }
+    };
+
+    /**
+     * Objects contributed to the MapData by one tile
+     */
+    struct TileContribution
+    {
+      TileRef                 tile;
+      size_t                  generation=0;
+      std::vector<FileOffset> nodes;
+      std::vector<FileOffset> ways;
+      std::vector<FileOffset> optimizedWays;
+      std::vector<FileOffset> areas;
+      std::vector<FileOffset> optimizedAreas;
+      std::vector<FileOffset> routes;
+    };
+
+  private:
+    const MapData*                                   mapData=nullptr; //!< The MapData instance updated by the last call
+    std::optional<TypeFilter>                        filter;          //!< The filter used by the last call
+    std::unordered_map<const Tile*,TileContribution> contributions;
+    ObjectSet<NodeRef>                               nodes;
+    ObjectSet<WayRef>                                ways;
+    ObjectSet<AreaRef>                               areas;
+    ObjectSet<RouteRef>                              routes;
+    Statistics                                       statistics;
+
+  private:
+    void AddTile(const TileRef& tile,
+                 const TypeFilter& filter,
+                 MapData& data,
+                 TileContribution& contribution);
+    void RemoveTile(const TileContribution& contribution,
+                    MapData& data);
+    bool IsInSync(const MapData& data) const;
+
+  public:
+    void Update(const std::list<TileRef>& tiles,
+                const TypeFilter& filter,
+                MapData& data);
+
+    void Clear();
+
+    const Statistics& GetStatistics() const
+    {
+      return statistics;
+    }
+  };
+}
+
+#endif
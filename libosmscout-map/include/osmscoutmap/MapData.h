@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <osmscoutmap/MapImportExport.h>
+#include <osmscoutmap/MapDataColumns.h>
 
 #include <osmscout/Node.h>
 #include <osmscout/Area.h>
@@ -55,6 +56,10 @@ namespace osmscout {
     std::list<GroundTile> groundTiles;  //!< List of ground tiles (optional)
     std::list<GroundTile> baseMapTiles; //!< List of ground tiles of base map (optional)
     SRTMDataRef           srtmTile;     //!< Optional data with height information
+    MapDataColumns        columns;      //!< Optional column oriented copy of nodes, ways and areas (see MapService::SetColumnarMapData())
+
+  public:
+    bool HasColumns() const;
 
   public:
     void ClearDBData();
@@ -0,0 +1,203 @@
+#ifndef OSMSCOUT_MAP_MAPDATACOLUMNS_H
+#define OSMSCOUT_MAP_MAPDATACOLUMNS_H
+
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <osmscoutmap/MapImportExport.h>
+
+#include <osmscout/Node.h>
+#include <osmscout/Area.h>
+#include <osmscout/Way.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Renderer
+   *
+   * Read only view of a contiguous range of points within MapDataColumns.
+   * It offers the same interface as a std::vector<Point> as far as required
+   * by TransformWay() and TransformArea().
+   */
+  class PointRange CLASS_FINAL
+  {
+  private:
+    const Point* first=nullptr;
+    size_t       count=0;
+
+  public:
+    PointRange() = default;
+
+    PointRange(const Point* first,
+               size_t count)
+    : first(first),
+      count(count)
+    {
+      // no code
+    }
+
+    const Point* begin() const
+    {
+      return first;
+    }
+
+    const Point* end() const
+    {
+      return first+count;
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    bool empty() const
+    {
+      return count==0;
+    }
+
+    const Point& operator[](size_t index) const
+    {
+      return first[index];
+    }
+  };
+
+  /**
+   * \ingroup Renderer
+   *
+   * Optional column oriented (struct of arrays) copy of the nodes, ways and areas
+   * of a MapData instance.
+   *
+   * Entry i of each node, way and area column belongs to the object at index i of
+   * MapData::nodes, MapData::ways and MapData::areas. Coordinates of all ways and of
+   * all area rings are stored in one contiguous array each, bounding boxes and type ids
+   * in parallel arrays. Code that only needs geometry or bounding boxes (like culling
+   * in the MapPainter) can thus walk the data sequentially instead of following
+   * the shared pointers of the individual objects.
+   *
+   * Feature values are not copied, the columns reference the FeatureValueBuffer of
+   * the original objects. The columns are thus only valid as long as the MapData
+   * they were filled from is not changed. The columns hold a reference to the objects
+   * they were created from, so IsAssigned() detects if objects were added, removed,
+   * replaced or reordered. The objects themselves are shared with the tile cache and
+   * must not be modified.
+   *
+   * Clear() keeps the allocated capacity, so refilling the columns for the next frame
+   * normally does not allocate.
+   */
+  class OSMSCOUT_MAP_API MapDataColumns CLASS_FINAL
+  {
+  public:
+    struct NodeColumns
+    {
+      std::vector<GeoCoord>                  coords;        //!< Coordinate of each node
+      std::vector<TypeId>                    types;         //!< Node type id of each node
+      std::vector<const FeatureValueBuffer*> features;      //!< Feature values of each node
+      std::vector<NodeRef>                   objects;       //!< The node each entry was created from
+    };
+
+    struct WayColumns
+    {
+      std::vector<Point>                     points;        //!< Points of all ways
+      std::vector<size_t>                    pointOffsets;  //!< Index of the first point of each way in points, plus end marker
+      std::vector<TypeId>                    types;         //!< Way type id of each way
+      std::vector<GeoBox>                    boundingBoxes; //!< Bounding box of each way
+      std::vector<const FeatureValueBuffer*> features;      //!< Feature values of each way
+      std::vector<WayRef>                    objects;       //!< The way each entry was created from
+    };
+
+    struct AreaColumns
+    {
+      std::vector<Point>                     points;        //!< Points of all rings of all areas
+      std::vector<size_t>                    ringOffsets;   //!< Index of the first ring of each area, plus end marker
+      std::vector<size_t>                    pointOffsets;  //!< Index of the first point of each ring in points, plus end marker
+      std::vector<TypeId>                    ringTypes;     //!< Area type id of each ring
+      std::vector<uint8_t>                   ringLevels;    //!< Ring hierarchy number of each ring
+      std::vector<const FeatureValueBuffer*> ringFeatures;  //!< Feature values of each ring
+      std::vector<GeoBox>                    boundingBoxes; //!< Bounding box of each area (see Area::GetBoundingBox())
+      std::vector<AreaRef>                   objects;       //!< The area each entry was created from
+    };
+
+  public:
+    NodeColumns nodes;
+    WayColumns  ways;
+    AreaColumns areas;
+
+  public:
+    MapDataColumns();
+
+    void Clear();
+
+    void AddNode(const NodeRef& node);
+    void AddWay(const WayRef& way);
+    void AddArea(const AreaRef& area);
+
+    void Assign(const std::vector<NodeRef>& nodes,
+                const std::vector<WayRef>& ways,
+                const std::vector<AreaRef>& areas);
+
+    bool IsAssigned(const std::vector<NodeRef>& nodes,
+                    const std::vector<WayRef>& ways,
+                    const std::vector<AreaRef>& areas) const;
+
+    size_t GetNodeCount() const
+    {
+      return nodes.coords.size();
+    }
+
+    size_t GetWayCount() const
+    {
+      return ways.types.size();
+    }
+
+    size_t GetAreaCount() const
+    {
+      return areas.boundingBoxes.size();
+    }
+
+    bool IsEmpty() const
+    {
+      return GetNodeCount()==0 &&
+             GetWayCount()==0 &&
+             GetAreaCount()==0;
+    }
+
+    PointRange GetWayPoints(size_t way) const
+    {
+      return {ways.points.data()+ways.pointOffsets[way],
+              ways.pointOffsets[way+1]-ways.pointOffsets[way]};
+    }
+
+    PointRange GetRingPoints(size_t ring) const
+    {
+      return {areas.points.data()+areas.pointOffsets[ring],
+              areas.pointOffsets[ring+1]-areas.pointOffsets[ring]};
+    }
+
+    size_t GetMemorySize() const;
+  };
+}
+
+#endif
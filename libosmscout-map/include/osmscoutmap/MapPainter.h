@@ -21,6 +21,7 @@
 */
 
 #include <list>
+#include <memory_resource>
 #include <string>
 #include <optional>
 
@@ -51,12 +52,14 @@
 
 #include <osmscout/async/Breaker.h>
 #include <osmscout/util/Geometry.h>
+#include <osmscout/util/MemoryArena.h>
 #include <osmscout/util/Transformation.h>
 
 #include <osmscout/system/Compiler.h>
 
 #include <osmscoutmap/LabelLayouter.h>
 #include <osmscoutmap/MapParameter.h>
+#include <osmscoutmap/TextLayoutCache.h>
 
 namespace osmscout {
 
@@ -172,6 +175,8 @@ namespace osmscout {
      */
     struct OSMSCOUT_MAP_API AreaData
     {
+      using allocator_type = std::pmr::polymorphic_allocator<CoordBufferRange>;
+
       ObjectFileRef               ref;
       TypeInfoRef                 type;
       const FeatureValueBuffer    *buffer;         //!< Features of the line segment, can be NULL in case of border
@@ -182,10 +187,27 @@ namespace osmscout {
       std::optional<GeoCoord>     center;          //!< "visual" polygon center (pole of inaccessibility)
       bool                        isOuter;         //!< flag if this area is outer ring of some relation
       CoordBufferRange            coordRange;      //!< Range of coordinates in transformation buffer
-      std::list<CoordBufferRange> clippings;       //!< Clipping polygons to be used during drawing of this area
+      std::pmr::list<CoordBufferRange> clippings;  //!< Clipping polygons to be used during drawing of this area
+
+      AreaData() = default;
+      AreaData(const AreaData& other) = default;
+      AreaData& operator=(const AreaData& other) = default;
+
+      explicit AreaData(const allocator_type& allocator)
+      : clippings(allocator)
+      {
+        // no code
+      }
+
+      AreaData(const AreaData& other,
+               const allocator_type& allocator)
+      : AreaData(allocator)
+      {
+        *this=other;
+      }
     };
 
-    using WayPathDataIt=std::list<WayPathData>::iterator;
+    using WayPathDataIt=std::pmr::list<WayPathData>::iterator;
 
     /**
      * Data structure for holding temporary data route labels
@@ -229,10 +251,12 @@ namespace osmscout {
     std::vector<StepMethod>      stepMethods;        //!< Jump table render step methods
     double                       errorTolerancePixel;
 
-    std::list<AreaData>          areaData;           //!< Internal processing list for area rendering
-    std::list<WayData>           wayData;            //!< Internal processing list for way rendering
-    std::list<WayPathData>       wayPathData;
-    std::list<RouteLabelData>    routeLabelData;
+    MemoryArena                  renderArena;        //!< Memory of the processing lists, reset on every render call,
+                                                     //!< keeps at most its maximum capacity between render calls
+    std::pmr::list<AreaData>     areaData;           //!< Internal processing list for area rendering
+    std::pmr::list<WayData>      wayData;            //!< Internal processing list for way rendering
+    std::pmr::list<WayPathData>  wayPathData;
+    std::pmr::list<RouteLabelData> routeLabelData;
 
     std::vector<TextStyleRef>    textStyles;         //!< Temporary storage for StyleConfig return value
     std::vector<LineStyleRef>    lineStyles;         //!< Temporary storage for StyleConfig return value
@@ -244,6 +268,10 @@ namespace osmscout {
     //@{
     double                       standardFontSize;
     double                       areaMinDimension;
+    double                       clipGuardBand;      //!< Guard band around the visible area in pixel, that is not clipped
+    GeoBox                       clipBox;            //!< Visible area plus guard band, invalid if clipping is disabled
+    bool                         clipWays;           //!< Ways may be clipped, false if routes are rendered on top of them
+    GeoBox                       cullBox;            //!< Visible area plus guard band, invalid if MapData::columns are not available
     //@}
 
   protected:
@@ -295,6 +323,7 @@ namespace osmscout {
     void TransformPathData(const Projection& projection,
                            const MapParameter& parameter,
                            const Way& way,
+                           const GeoBox& clipBox,
                            WayPathData &pathData);
 
     double CalculateLineWith(const Projection& projection,
@@ -310,11 +339,20 @@ namespace osmscout {
 
     int8_t CalculateLineLayer(const FeatureValueBuffer& buffer) const;
 
+    GeoBox GetWayClipBox(const StyleConfig& styleConfig,
+                         const Projection& projection,
+                         const Way& way,
+                         double mainSlotWidth);
+
     void CalculateWayPaths(const StyleConfig& styleConfig,
                            const Projection& projection,
                            const MapParameter& parameter,
                            const Way& way);
 
+    GeoBox GetAreaClipBox(const StyleConfig& styleConfig,
+                          const Projection& projection,
+                          const Area& area) const;
+
     bool PrepareAreaRing(const StyleConfig& styleConfig,
                          const Projection& projection,
                          const MapParameter& parameter,
@@ -504,12 +542,12 @@ namespace osmscout {
     }
     //@}
 
-    const std::list<WayData>& GetWayData() const
+    const std::pmr::list<WayData>& GetWayData() const
     {
       return wayData;
     }
 
-    const std::list<AreaData>& GetAreaData() const
+    const std::pmr::list<AreaData>& GetAreaData() const
     {
       return areaData;
     }
@@ -675,6 +713,12 @@ namespace osmscout {
     bool Draw(const Projection& projection,
               const MapParameter& parameter,
               const MapData& data);
+
+    /**
+      Return the statistics of the text layout cache of the backend, if
+      the backend caches text layouts between frames.
+     */
+    virtual std::optional<TextLayoutCacheStatistics> GetTextLayoutCacheStatistics() const;
   };
 
   /**
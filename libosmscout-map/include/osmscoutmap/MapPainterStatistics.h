@@ -29,6 +29,7 @@
 #include <osmscoutmap/MapParameter.h>
 #include <osmscoutmap/MapData.h>
 #include <osmscoutmap/StyleConfig.h>
+#include <osmscoutmap/TextLayoutCache.h>
 
 namespace osmscout {
 
@@ -90,6 +91,8 @@ namespace osmscout {
                                   const Projection& projection,
                                   const MapParameter& parameter,
                                   const MapData& data);
+
+    void DumpTextLayoutCacheStatistics(const TextLayoutCacheStatistics& statistics);
   };
 }
 #endif
@@ -72,6 +72,7 @@ namespace osmscout {
     TransPolygon::OptimizeMethod        optimizeWayNodes;          //!< Try to reduce the number of nodes for
     TransPolygon::OptimizeMethod        optimizeAreaNodes;         //!< Try to reduce the number of nodes for
     double                              optimizeErrorToleranceMm;  //!< The maximum error to allow when optimizing lines, in mm
+    bool                                clipGeometry;              //!< Drop nodes of areas and ways outside of the visible area (plus guard band) before rendering (default: true)
     bool                                drawFadings;               //!< Draw label fadings (default: true)
     bool                                drawWaysWithFixedWidth;    //!< Draw ways using the size of the style sheet, if if the way has a width explicitly given
 
@@ -80,6 +81,7 @@ namespace osmscout {
     size_t                              labelLineMaxCharCount;     //!< Labels will be word wrapped if they are longer then the given characters
     bool                                labelLineFitToArea;        //!< Labels will be word wrapped to fit object area
     double                              labelLineFitToWidth;       //!< Labels will be word wrapped to fit given width in pixels
+    size_t                              textLayoutCacheSize;       //!< Maximum number of text layouts cached by the painter between frames, 0 disables the cache (default 10000)
 
     double                              labelPadding;              //!< Space around point labels in mm (default 1).
     double                              plateLabelPadding;         //!< Space around plates in mm (default 5).
@@ -142,6 +144,7 @@ namespace osmscout {
     void SetOptimizeWayNodes(TransPolygon::OptimizeMethod optimize);
     void SetOptimizeAreaNodes(TransPolygon::OptimizeMethod optimize);
     void SetOptimizeErrorToleranceMm(double errorToleranceMm);
+    void SetClipGeometry(bool clipGeometry);
 
     void SetDrawFadings(bool drawFadings);
     void SetDrawWaysWithFixedWidth(bool drawWaysWithFixedWidth);
@@ -150,6 +153,7 @@ namespace osmscout {
     void SetLabelLineMaxCharCount(size_t labelLineMaxCharCount);
     void SetLabelLineFitToArea(bool labelLineFitToArea);
     void SetLabelLineFitToWidth(double labelLineFitToWidth);
+    void SetTextLayoutCacheSize(size_t textLayoutCacheSize);
 
     void SetLabelPadding(double labelPadding);
     void SetPlateLabelPadding(double plateLabelPadding);
@@ -256,6 +260,11 @@ namespace osmscout {
       return optimizeErrorToleranceMm;
     }
 
+    bool GetClipGeometry() const
+    {
+      return clipGeometry;
+    }
+
     bool GetDrawFadings() const
     {
       return drawFadings;
@@ -286,6 +295,11 @@ namespace osmscout {
       return labelLineFitToWidth;
     }
 
+    size_t GetTextLayoutCacheSize() const
+    {
+      return textLayoutCacheSize;
+    }
+
     double GetLabelPadding() const
     {
       return labelPadding;
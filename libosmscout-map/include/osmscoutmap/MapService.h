@@ -20,7 +20,9 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -34,12 +36,15 @@
 
 #include <osmscout/db/Database.h>
 
+#include <osmscout/async/AtomicSharedPtr.h>
 #include <osmscout/async/Breaker.h>
+#include <osmscout/async/MPSCQueue.h>
 #include <osmscout/util/GeoBox.h>
 #include <osmscout/util/StopClock.h>
 #include <osmscout/async/WorkQueue.h>
 
 #include <osmscoutmap/DataTileCache.h>
+#include <osmscoutmap/IncrementalMapData.h>
 
 namespace osmscout {
 
@@ -115,11 +120,15 @@ namespace osmscout {
     using CallbackId = size_t;
     using TileStateCallback = std::function<void (const TileRef &)>;
 
+  private:
+    using TileStateCallbackMap = std::map<CallbackId,TileStateCallback>;
+
   private:
     mutable std::mutex           stateMutex;           //!< Mutex to protect internal state
 
     DatabaseRef                  database;             //!< The reference to the db
     mutable DataTileCache        cache;                //!< Data cache
+    std::atomic<bool>            columnarMapData;      //!< Fill MapData::columns in AddTileDataToMapData()
 
     mutable WorkQueue<bool>      nodeWorkerQueue;
     std::thread                  nodeWorkerThread;
@@ -140,15 +149,22 @@ namespace osmscout {
     std::thread                  routeWorkerThread;
 
     CallbackId                   nextCallbackId;
-    std::map<CallbackId,TileStateCallback> tileStateCallbacks;
-    mutable std::mutex           callbackMutex;        //<! Mutex to protect callback (de)registering
+    std::mutex                   callbackMutex;        //!< Mutex to serialize callback (de)registering
+    AtomicSharedPtr<const TileStateCallbackMap> tileStateCallbacks; //!< Snapshot of the registered callbacks
 
+    mutable MPSCQueue<TileRef>   tileStateQueue;       //!< Tiles with changed state, consumed by the callback thread
+    mutable std::atomic<uint32_t> tileStateSignal;     //!< Changed after pushing to the tileStateQueue
+    std::atomic<size_t>          callbackEpoch;        //!< Odd while the callback thread calls callbacks
+    std::atomic<bool>            callbackThreadStopped;
+    std::thread                  callbackThread;       //!< Calls the callbacks for the tiles in the tileStateQueue
 
   private:
     TypeDefinitionRef GetTypeDefinition(const AreaSearchParameter& parameter,
                                         const StyleConfig& styleConfig,
                                         const Magnification& magnification) const;
 
+    void FillColumns(MapData& data) const;
+
     bool GetNodes(const AreaSearchParameter& parameter,
                   const TypeInfoSet& nodeTypes,
                   const GeoBox& boundingBox,
@@ -281,6 +297,7 @@ namespace osmscout {
     void AreaWorkerLoop();
     void AreaLowZoomWorkerLoop();
     void RouteWorkerLoop();
+    void TileStateCallbackLoop();
 
     std::future<bool> PushNodeTask(const AreaSearchParameter& parameter,
                                    const TypeInfoSet& nodeTypes,
@@ -323,6 +340,11 @@ namespace osmscout {
 
     void NotifyTileStateCallbacks(const TileRef& tile) const;
 
+    void PushTileTasks(const AreaSearchParameter& parameter,
+                       const TypeDefinition& typeDefinition,
+                       const TileRef& tile,
+                       std::list<std::future<bool>>& results) const;
+
     bool LoadMissingTileDataStyleSheet(const AreaSearchParameter& parameter,
                                        const StyleConfig& styleConfig,
                                        std::list<TileRef>& tiles,
@@ -342,6 +364,16 @@ namespace osmscout {
     size_t GetCacheSize() const;
     size_t GetCurrentCacheSize() const;
 
+    void SetCacheMemoryLimit(size_t memoryLimit);
+    size_t GetCacheMemoryLimit() const;
+    size_t GetCurrentCacheMemory() const;
+
+    void SetPanPrefetch(bool panPrefetch);
+    bool IsPanPrefetch() const;
+
+    void SetColumnarMapData(bool columnarMapData);
+    bool IsColumnarMapData() const;
+
     void CleanupTileCache();
     void FlushTileCache();
     void InvalidateTileCache();
@@ -380,6 +412,15 @@ namespace osmscout {
                               const TypeDefinition& typeDefinition,
                               MapData& data) const;
 
+    void AddTileDataToMapData(std::list<TileRef>& tiles,
+                              IncrementalMapData& incrementalData,
+                              MapData& data) const;
+
+    void AddTileDataToMapData(std::list<TileRef>& tiles,
+                              const TypeDefinition& typeDefinition,
+                              IncrementalMapData& incrementalData,
+                              MapData& data) const;
+
     bool GetGroundTiles(const Projection& projection,
                         std::list<GroundTile>& tiles) const;
 
@@ -0,0 +1,230 @@
+#ifndef OSMSCOUT_MAP_TEXTLAYOUTCACHE_H
+#define OSMSCOUT_MAP_TEXTLAYOUTCACHE_H
+
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Renderer
+   *
+   * Everything that influences the layout of a label text
+   */
+  struct TextLayoutKey
+  {
+    std::string text;           //!< The label text
+    std::string fontName;       //!< Name of the font
+    double      fontSize=1.0;   //!< Font size relative to the standard font size
+    double      pixelSize=0.0;  //!< Resulting font size in pixels
+    int         wrapWidth=0;    //!< Width in pixels used for wrapping, 0 if not limited
+    bool        enableWrapping=false;
+    bool        contourLabel=false;
+
+    bool operator==(const TextLayoutKey& other) const
+    {
+      return text==other.text &&
+             fontName==other.fontName &&
+             fontSize==other.fontSize &&
+             pixelSize==other.pixelSize &&
+             wrapWidth==other.wrapWidth &&
+             enableWrapping==other.enableWrapping &&
+             contourLabel==other.contourLabel;
+    }
+  };
+
+  struct TextLayoutKeyHasher
+  {
+    size_t operator()(const TextLayoutKey& key) const
+    {
+      size_t hash=std::hash<std::string>{}(key.text);
+
+      hash=hash*31+std::hash<std::string>{}(key.fontName);
+      hash=hash*31+std::hash<double>{}(key.fontSize);
+      hash=hash*31+std::hash<double>{}(key.pixelSize);
+      hash=hash*31+std::hash<int>{}(key.wrapWidth);
+      hash=hash*31+(key.enableWrapping ? 1 : 0);
+      hash=hash*31+(key.contourLabel ? 1 : 0);
+
+      return hash;
+    }
+  };
+
+  /**
+   * \ingroup Renderer
+   *
+   * Cumulative statistics of a TextLayoutCache
+   */
+  struct TextLayoutCacheStatistics
+  {
+    size_t hits=0;      //!< Number of layouts taken from the cache
+    size_t misses=0;    //!< Number of layouts that had to be calculated
+    size_t evictions=0; //!< Number of layouts dropped because the cache was full
+    size_t entries=0;   //!< Current number of cached layouts
+    size_t capacity=0;  //!< Maximum number of cached layouts
+
+    double GetHitRate() const
+    {
+      size_t lookups=hits+misses;
+
+      return lookups>0 ? static_cast<double>(hits)/static_cast<double>(lookups) : 0.0;
+    }
+  };
+
+  /**
+   * \ingroup Renderer
+   *
+   * Bounded, thread safe least recently used cache of text layouts.
+   *
+   * Backends shaping label texts (Pango, Agg,...) store the result of their
+   * TextLayouter::Layout() callback here, so that the same label (for example
+   * the name of a long street visible in multiple tiles) is only shaped once
+   * and reused in following frames. The cached layouts are shared and must not
+   * be modified after they were stored.
+   *
+   * A capacity of 0 disables caching.
+   */
+  template<class Layout>
+  class TextLayoutCache
+  {
+  private:
+    using LayoutRef = std::shared_ptr<Layout>;
+    using Entry = std::pair<TextLayoutKey,LayoutRef>;
+    using EntryList = std::list<Entry>;
+    using EntryIndex = std::unordered_map<TextLayoutKey,typename EntryList::iterator,TextLayoutKeyHasher>;
+
+    mutable std::mutex        mutex;
+    size_t                    capacity;
+    EntryList                 entries;    //!< Entries, most recently used first
+    EntryIndex                index;
+    TextLayoutCacheStatistics statistics;
+
+  private:
+    void Trim()
+    {
+      while (entries.size()>capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+        statistics.evictions++;
+      }
+    }
+
+  public:
+    explicit TextLayoutCache(size_t capacity=10000)
+    : capacity(capacity)
+    {
+      // no code
+    }
+
+    /**
+     * Change the maximum number of cached layouts, dropping the least recently
+     * used entries if required.
+     */
+    void SetCapacity(size_t capacity)
+    {
+      std::scoped_lock lock(mutex);
+
+      if (this->capacity==capacity) {
+        return;
+      }
+
+      this->capacity=capacity;
+      Trim();
+    }
+
+    /**
+     * Return the cached layout for the given key or - if there is none -
+     * calculate it using the given function and store it.
+     */
+    template<typename Function>
+    LayoutRef GetOrCreate(const TextLayoutKey& key,
+                          Function&& createLayout)
+    {
+      {
+        std::scoped_lock lock(mutex);
+
+        if (auto entry=index.find(key);
+            entry!=index.end()) {
+          statistics.hits++;
+          entries.splice(entries.begin(),entries,entry->second);
+
+          return entry->second->second;
+        }
+
+        statistics.misses++;
+      }
+
+      // Layouting happens without holding the lock
+      LayoutRef layout=createLayout();
+
+      if (!layout) {
+        return layout;
+      }
+
+      std::scoped_lock lock(mutex);
+
+      if (capacity==0) {
+        return layout;
+      }
+
+      if (auto entry=index.find(key);
+          entry!=index.end()) {
+        // Calculated concurrently by another thread, keep the existing one
+        entries.splice(entries.begin(),entries,entry->second);
+
+        return entry->second->second;
+      }
+
+      entries.emplace_front(key,layout);
+      index.emplace(key,entries.begin());
+      Trim();
+
+      return layout;
+    }
+
+    void Clear()
+    {
+      std::scoped_lock lock(mutex);
+
+      entries.clear();
+      index.clear();
+    }
+
+    TextLayoutCacheStatistics GetStatistics() const
+    {
+      std::scoped_lock lock(mutex);
+
+      TextLayoutCacheStatistics result=statistics;
+
+      result.entries=entries.size();
+      result.capacity=capacity;
+
+      return result;
+    }
+  };
+}
+
+#endif
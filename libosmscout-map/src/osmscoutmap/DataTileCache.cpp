@@ -19,12 +19,53 @@
 
 #include <osmscoutmap/DataTileCache.h>
 
+#include <limits>
+#include <set>
+#include <unordered_set>
+
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/String.h>
 #include <osmscout/util/Tiling.h>
 
 namespace osmscout {
 
+  size_t GetObjectMemorySize(const NodeRef& /*node*/)
+  {
+    return sizeof(Node);
+  }
+
+  size_t GetObjectMemorySize(const WayRef& way)
+  {
+    return sizeof(Way)+
+           way->nodes.capacity()*sizeof(Point)+
+           way->segments.capacity()*sizeof(SegmentGeoBox);
+  }
+
+  size_t GetObjectMemorySize(const AreaRef& area)
+  {
+    size_t size=sizeof(Area)+
+                area->rings.capacity()*sizeof(Area::Ring);
+
+    for (const auto& ring : area->rings) {
+      size+=ring.nodes.capacity()*sizeof(Point)+
+            ring.segments.capacity()*sizeof(SegmentGeoBox);
+    }
+
+    return size;
+  }
+
+  size_t GetObjectMemorySize(const RouteRef& route)
+  {
+    size_t size=sizeof(Route)+
+                route->segments.capacity()*sizeof(Route::Segment);
+
+    for (const auto& segment : route->segments) {
+      size+=segment.members.capacity()*sizeof(Route::SegmentMember);
+    }
+
+    return size;
+  }
+
   /**
    * Create a new tile with the given id.
    */
@@ -58,28 +99,81 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Change the maximum estimated memory of all cached tiles in bytes. A value of 0
+   * disables the limit. Cache will be cleaned immediately.
+   */
+  void DataTileCache::SetMemoryLimit(size_t memoryLimit)
+  {
+    bool cleanupCache=memoryLimit!=0 &&
+                      (this->memoryLimit==0 || memoryLimit<this->memoryLimit);
+
+    this->memoryLimit=memoryLimit;
+
+    if (cleanupCache) {
+      CleanupCache();
+    }
+  }
+
+  /**
+   * Return the estimated memory in bytes used by all cached tiles
+   */
+  size_t DataTileCache::GetCurrentMemory() const
+  {
+    size_t memory=0;
+
+    for (const CacheEntry& entry : tileCache) {
+      memory+=entry.tile->GetMemorySize();
+    }
+
+    return memory;
+  }
+
+  /**
+   * Enable or disable calculation of prefetch tiles in pan direction
+   */
+  void DataTileCache::SetPanPrefetch(bool panPrefetch)
+  {
+    this->panPrefetch=panPrefetch;
+
+    if (!panPrefetch) {
+      lastRequestBoxes.clear();
+      prefetchKeys.clear();
+    }
+  }
+
   /**
    * Cleanup the cache. Free least recently used tiles until the given maximum cache
-   * size is reached again.
+   * size and the maximum memory are reached again. Tiles still referenced
+   * outside the cache are never freed.
    */
   void DataTileCache::CleanupCache()
   {
-    if (tileCache.size()>cacheSize) {
-      auto currentEntry=tileCache.rbegin();
-
-      while (currentEntry!=tileCache.rend() &&
-              tileCache.size()>cacheSize) {
-        //if (currentEntry->tile.expired()) {
-        if (currentEntry->tile.use_count()==1) {
-          //std::cout << "Dropping tile " << (std::string)currentEntry->id << " from cache " << cache.size() << "/" << cacheSize << std::endl;
-          tileIndex.erase(currentEntry->key);
-
-          ++currentEntry;
-          currentEntry=std::reverse_iterator<Cache::iterator>(tileCache.erase(currentEntry.base()));
-        }
-        else {
-          ++currentEntry;
+    bool   checkMemory=memoryLimit>0;
+    size_t memory=checkMemory ? GetCurrentMemory() : 0;
+
+    if (tileCache.size()<=cacheSize &&
+        (!checkMemory || memory<=memoryLimit)) {
+      return;
+    }
+
+    auto currentEntry=tileCache.rbegin();
+
+    while (currentEntry!=tileCache.rend() &&
+           (tileCache.size()>cacheSize ||
+            (checkMemory && memory>memoryLimit))) {
+      if (currentEntry->tile.use_count()==1) {
+        if (checkMemory) {
+          memory-=currentEntry->tile->GetMemorySize();
         }
+
+        tileIndex.erase(currentEntry->key);
+
+        ++currentEntry;
+        currentEntry=std::reverse_iterator<Cache::iterator>(tileCache.erase(currentEntry.base()));
+      }
+      else {
+        ++currentEntry;
       }
     }
   }
@@ -146,6 +240,102 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Return the tiles that should be loaded in the background, because the last
+   * requests moved in their direction. Tiles not yet cached are added at the end
+   * of the cache, so that they are the first ones to be freed again. The list of
+   * prefetch tiles is reset by this call.
+   */
+  void DataTileCache::GetPrefetchTiles(std::list<TileRef>& tiles) const
+  {
+    tiles.clear();
+
+    for (const auto& key : prefetchKeys) {
+      auto existingEntry=tileIndex.find(key);
+
+      if (existingEntry!=tileIndex.end()) {
+        tiles.push_back(existingEntry->second->tile);
+        continue;
+      }
+
+      TileRef tile(new Tile(key));
+
+      tileCache.emplace_back(key,
+                             tile);
+      tileIndex[key]=std::prev(tileCache.end());
+
+      tiles.push_back(tile);
+    }
+
+    prefetchKeys.clear();
+  }
+
+  /**
+   * Compare the given box with the box of the last request on the same level and - if
+   * it was moved - calculate the row and/or column of tiles next to the box in the
+   * direction of the movement.
+   */
+  void DataTileCache::UpdatePrefetchKeys(const Magnification& magnification,
+                                         const TileIdBox& box) const
+  {
+    prefetchKeys.clear();
+
+    auto lastRequest=lastRequestBoxes.find(magnification.GetLevel());
+
+    if (lastRequest!=lastRequestBoxes.end()) {
+      const TileIdBox& lastRequestBox=lastRequest->second;
+      uint32_t         maxTile=magnification.GetLevel()>=32 ? std::numeric_limits<uint32_t>::max() : (uint32_t(1) << magnification.GetLevel())-1;
+      int              deltaX=0;
+      int              deltaY=0;
+
+      if (box.GetMinX()>lastRequestBox.GetMinX()) {
+        deltaX=1;
+      }
+      else if (box.GetMinX()<lastRequestBox.GetMinX()) {
+        deltaX=-1;
+      }
+
+      if (box.GetMinY()>lastRequestBox.GetMinY()) {
+        deltaY=1;
+      }
+      else if (box.GetMinY()<lastRequestBox.GetMinY()) {
+        deltaY=-1;
+      }
+
+      bool     hasColumn=(deltaX>0 && box.GetMaxX()<maxTile) ||
+                         (deltaX<0 && box.GetMinX()>0);
+      bool     hasRow=(deltaY>0 && box.GetMaxY()<maxTile) ||
+                      (deltaY<0 && box.GetMinY()>0);
+      uint32_t columnX=deltaX>0 ? box.GetMaxX()+1 : box.GetMinX()-1;
+      uint32_t rowY=deltaY>0 ? box.GetMaxY()+1 : box.GetMinY()-1;
+
+      std::set<TileId> ids;
+
+      if (hasColumn) {
+        for (uint32_t y=box.GetMinY(); y<=box.GetMaxY(); y++) {
+          ids.insert(TileId(columnX,y));
+        }
+      }
+
+      if (hasRow) {
+        for (uint32_t x=box.GetMinX(); x<=box.GetMaxX(); x++) {
+          ids.insert(TileId(x,rowY));
+        }
+      }
+
+      if (hasColumn && hasRow) {
+        ids.insert(TileId(columnX,rowY));
+      }
+
+      for (const auto& id : ids) {
+        prefetchKeys.emplace_back(magnification,id);
+      }
+    }
+
+    lastRequestBoxes.insert_or_assign(magnification.GetLevel(),
+                                      box);
+  }
+
   /**
    * Return all tile necessary for covering the given boundingbox using the given magnification.
    */
@@ -163,6 +353,10 @@ namespace osmscout {
     for (const auto& tileId : box) {
       tiles.push_back(GetTile(TileKey(magnification,tileId)));
     }
+
+    if (panPrefetch) {
+      UpdatePrefetchKeys(magnification,box);
+    }
   }
 
   void DataTileCache::ResolveNodesFromParent(Tile& tile,
@@ -289,11 +483,88 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Merge the data of types that all four children have in common. Objects
+   * crossing tile borders are contained in multiple children and are thus
+   * deduplicated by their file offset. Areas are not merged, because the area
+   * index returns different areas depending on the magnification.
+   */
+  template<typename O>
+  static void MergeChildData(TileData<O>& data,
+                             const std::array<const TileData<O>*,4>& childData,
+                             const TypeInfoSet& types)
+  {
+    TypeInfoSet subset(types);
+
+    // We remove all types that are already loaded
+    subset.Remove(data.GetTypes());
+
+    for (const auto& child : childData) {
+      if (subset.Empty()) {
+        return;
+      }
+
+      // We only retrieve types that all tiles have in common
+      subset.Intersection(child->GetTypes());
+    }
+
+    if (subset.Empty()) {
+      return;
+    }
+
+    std::unordered_set<FileOffset> offsets;
+    std::vector<O>                 objects;
+
+    for (const auto& child : childData) {
+      child->CopyData([&](const O& object) {
+        if (subset.IsSet(object->GetType()) &&
+            offsets.insert(object->GetFileOffset()).second) {
+          objects.push_back(object);
+        }
+      });
+    }
+
+    data.AddPrefillData(subset,
+                        std::move(objects));
+  }
+
+  void DataTileCache::ResolveFromChildren(Tile& tile,
+                                          const std::array<TileRef,4>& childTiles,
+                                          const TypeInfoSet& nodeTypes,
+                                          const TypeInfoSet& wayTypes,
+                                          const TypeInfoSet& routeTypes)
+  {
+    MergeChildData<NodeRef>(tile.GetNodeData(),
+                            {&childTiles[0]->GetNodeData(),
+                             &childTiles[1]->GetNodeData(),
+                             &childTiles[2]->GetNodeData(),
+                             &childTiles[3]->GetNodeData()},
+                            nodeTypes);
+    MergeChildData<WayRef>(tile.GetWayData(),
+                           {&childTiles[0]->GetWayData(),
+                            &childTiles[1]->GetWayData(),
+                            &childTiles[2]->GetWayData(),
+                            &childTiles[3]->GetWayData()},
+                           wayTypes);
+    MergeChildData<RouteRef>(tile.GetRouteData(),
+                             {&childTiles[0]->GetRouteData(),
+                              &childTiles[1]->GetRouteData(),
+                              &childTiles[2]->GetRouteData(),
+                              &childTiles[3]->GetRouteData()},
+                             routeTypes);
+  }
+
   /**
    * (Partially) prefill the given tiles with data already cached with data of the given types.
    *
-   * Currently prefill is done by looking for the parent tile in the cache
-   * and copying data that intersects the bounding box of the given tile.
+   * Nodes, ways and routes are taken from the nearest cached ancestor tile that
+   * holds the requested types, walking up the tile pyramid, and are filtered by
+   * the bounding box of the given tile. Since the area index returns different
+   * areas depending on the magnification, areas are only taken from the direct
+   * parent (as before).
+   *
+   * Types still missing are then merged from the four child tiles, if all of
+   * them are cached.
    */
   void DataTileCache::PrefillDataFromCache(Tile& tile,
                                            const TypeInfoSet& nodeTypes,
@@ -303,39 +574,41 @@ namespace osmscout {
                                            const TypeInfoSet& /*optimizedWayTypes*/,
                                            const TypeInfoSet& /*optimizedAreaTypes*/)
   {
-    if (tile.GetLevel()>0) {
-      TileKey parentTileKey=tile.GetKey().GetParent();
-      TileRef parentTile=GetCachedTile(parentTileKey);
+    GeoBox  boundingBox=tile.GetBoundingBox();
+    TileKey ancestorKey=tile.GetKey();
 
-      if (parentTile) {
-        GeoBox boundingBox = tile.GetBoundingBox();
-        ResolveNodesFromParent(tile,*parentTile,boundingBox,nodeTypes);
-        ResolveWaysFromParent(tile,*parentTile,boundingBox,wayTypes);
-        ResolveAreasFromParent(tile,*parentTile,boundingBox,areaTypes);
-        ResolveRoutesFromParent(tile,*parentTile,boundingBox,routeTypes);
+    while (ancestorKey.GetLevel()>0) {
+      ancestorKey=ancestorKey.GetParent();
 
-        return;
+      TileRef ancestorTile=GetCachedTile(ancestorKey);
+
+      if (!ancestorTile) {
+        continue;
       }
-    }
 
-    /*
-    Magnification zoomedInMagnification;
+      ResolveNodesFromParent(tile,*ancestorTile,boundingBox,nodeTypes);
+      ResolveWaysFromParent(tile,*ancestorTile,boundingBox,wayTypes);
+      ResolveRoutesFromParent(tile,*ancestorTile,boundingBox,routeTypes);
 
-    zoomedInMagnification.SetLevel(tile.GetId().GetLevel()+1);
+      if (ancestorKey.GetLevel()+1==tile.GetLevel()) {
+        ResolveAreasFromParent(tile,*ancestorTile,boundingBox,areaTypes);
+      }
+    }
 
-    TileId childIds[4]={TileId(zoomedInMagnification,tile.GetId().GetX()*2,tile.GetId().GetY()*2),
-                        TileId(zoomedInMagnification,tile.GetId().GetX()*2+1,tile.GetId().GetY()*2),
-                        TileId(zoomedInMagnification,tile.GetId().GetX()*2,tile.GetId().GetY()*2+1),
-                        TileId(zoomedInMagnification,tile.GetId().GetX()*2+1,tile.GetId().GetY()*2+1)};
+    Magnification          childMagnification{MagnificationLevel(tile.GetLevel()+1)};
+    TileId                 id=tile.GetKey().GetId();
+    std::array<TileRef,4>  childTiles;
 
-    TileRef childTiles[4];
+    for (size_t i=0; i<childTiles.size(); i++) {
+      childTiles[i]=GetCachedTile(TileKey(childMagnification,
+                                          TileId(id.GetX()*2+uint32_t(i%2),
+                                                 id.GetY()*2+uint32_t(i/2))));
 
-    for (size_t i=0; i<4; i++) {
-      childTiles[i]=GetCachedTile(childIds[i]);
+      if (!childTiles[i]) {
+        return;
+      }
     }
 
-    if (childTiles[0] && childTiles[1] && childTiles[2] && childTiles[3]) {
-      std::cout << "Prefilling from children..." << std::endl;
-    }*/
+    ResolveFromChildren(tile,childTiles,nodeTypes,wayTypes,routeTypes);
   }
 }
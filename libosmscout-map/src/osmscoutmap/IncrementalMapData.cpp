@@ -0,0 +1,307 @@
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutmap/IncrementalMapData.h>
+
+#include <unordered_set>
+
+#include <osmscout/system/Assert.h>
+
+namespace osmscout {
+
+  static constexpr size_t NormalSource=0;
+  static constexpr size_t OptimizedSource=1;
+
+  bool IncrementalMapData::TypeFilter::operator==(const TypeFilter& other) const
+  {
+    return nodeTypes==other.nodeTypes &&
+           wayTypes==other.wayTypes &&
+           areaTypes==other.areaTypes &&
+           routeTypes==other.routeTypes &&
+           optimizedWayTypes==other.optimizedWayTypes &&
+           optimizedAreaTypes==other.optimizedAreaTypes;
+  }
+
+  /**
+   * Add the object to the set. If it is not yet part of the set it is appended
+   * to the given vector.
+   *
+   * @return
+   *    true, if the object was added to the vector
+   */
+  template<class O>
+  bool IncrementalMapData::ObjectSet<O>::Add(size_t source,
+                                             const O& object,
+                                             std::vector<O>& objects)
+  {
+    auto [entry,inserted]=entries[source].try_emplace(object->GetFileOffset());
+
+    entry->second.refCount++;
+
+    if (!inserted) {
+      return false;
+    }
+
+    entry->second.index=objects.size();
+    objects.push_back(object);
+    owners.emplace_back(source,object->GetFileOffset());
+
+    return true;
+  }
+
+  /**
+   * Release one reference to the object. If this was the last reference, the object is
+   * removed from the vector by moving the last object of the vector to its position.
+   *
+   * @return
+   *    true, if the object was removed from the vector
+   */
+  template<class O>
+  bool IncrementalMapData::ObjectSet<O>::Remove(size_t source,
+                                                FileOffset offset,
+                                                std::vector<O>& objects)
+  {
+    auto entry=entries[source].find(offset);
+
+    assert(entry!=entries[source].end());
+
+    if (--entry->second.refCount>0) {
+      return false;
+    }
+
+    size_t index=entry->second.index;
+    size_t last=objects.size()-1;
+
+    if (index!=last) {
+      objects[index]=std::move(objects[last]);
+      owners[index]=owners[last];
+      entries[owners[index].first][owners[index].second].index=index;
+    }
+
+    objects.pop_back();
+    owners.pop_back();
+    entries[source].erase(entry);
+
+    return true;
+  }
+
+  template<class O>
+  void IncrementalMapData::ObjectSet<O>::Clear()
+  {
+    for (auto& sourceEntries : entries) {
+      sourceEntries.clear();
+    }
+
+    owners.clear();
+  }
+
+  void IncrementalMapData::AddTile(const TileRef& tile,
+                                   const TypeFilter& filter,
+                                   MapData& data,
+                                   TileContribution& contribution)
+  {
+    contribution.tile=tile;
+    // Read the generation before the data, so that concurrent changes are picked up next time
+    contribution.generation=tile->GetDataGeneration();
+
+    auto isSet=[](const std::optional<TypeInfoSet>& types,
+                  const TypeInfoRef& type) {
+      return !types || types->IsSet(type);
+    };
+
+    tile->GetNodeData().CopyData([&](const NodeRef& node) {
+      if (isSet(filter.nodeTypes,node->GetType())) {
+        contribution.nodes.push_back(node->GetFileOffset());
+        statistics.addedObjects+=nodes.Add(NormalSource,node,data.nodes) ? 1 : 0;
+      }
+    });
+
+    tile->GetWayData().CopyData([&](const WayRef& way) {
+      if (isSet(filter.wayTypes,way->GetType())) {
+        contribution.ways.push_back(way->GetFileOffset());
+        statistics.addedObjects+=ways.Add(NormalSource,way,data.ways) ? 1 : 0;
+      }
+    });
+
+    tile->GetOptimizedWayData().CopyData([&](const WayRef& way) {
+      if (isSet(filter.optimizedWayTypes,way->GetType())) {
+        contribution.optimizedWays.push_back(way->GetFileOffset());
+        statistics.addedObjects+=ways.Add(OptimizedSource,way,data.ways) ? 1 : 0;
+      }
+    });
+
+    tile->GetAreaData().CopyData([&](const AreaRef& area) {
+      if (isSet(filter.areaTypes,area->GetType())) {
+        contribution.areas.push_back(area->GetFileOffset());
+        statistics.addedObjects+=areas.Add(NormalSource,area,data.areas) ? 1 : 0;
+      }
+    });
+
+    tile->GetOptimizedAreaData().CopyData([&](const AreaRef& area) {
+      if (isSet(filter.optimizedAreaTypes,area->GetType())) {
+        contribution.optimizedAreas.push_back(area->GetFileOffset());
+        statistics.addedObjects+=areas.Add(OptimizedSource,area,data.areas) ? 1 : 0;
+      }
+    });
+
+    tile->GetRouteData().CopyData([&](const RouteRef& route) {
+      if (isSet(filter.routeTypes,route->GetType())) {
+        contribution.routes.push_back(route->GetFileOffset());
+        statistics.addedObjects+=routes.Add(NormalSource,route,data.routes) ? 1 : 0;
+      }
+    });
+  }
+
+  void IncrementalMapData::RemoveTile(const TileContribution& contribution,
+                                      MapData& data)
+  {
+    for (const auto& offset : contribution.nodes) {
+      statistics.removedObjects+=nodes.Remove(NormalSource,offset,data.nodes) ? 1 : 0;
+    }
+
+    for (const auto& offset : contribution.ways) {
+      statistics.removedObjects+=ways.Remove(NormalSource,offset,data.ways) ? 1 : 0;
+    }
+
+    for (const auto& offset : contribution.optimizedWays) {
+      statistics.removedObjects+=ways.Remove(OptimizedSource,offset,data.ways) ? 1 : 0;
+    }
+
+    for (const auto& offset : contribution.areas) {
+      statistics.removedObjects+=areas.Remove(NormalSource,offset,data.areas) ? 1 : 0;
+    }
+
+    for (const auto& offset : contribution.optimizedAreas) {
+      statistics.removedObjects+=areas.Remove(OptimizedSource,offset,data.areas) ? 1 : 0;
+    }
+
+    for (const auto& offset : contribution.routes) {
+      statistics.removedObjects+=routes.Remove(NormalSource,offset,data.routes) ? 1 : 0;
+    }
+  }
+
+  /**
+   * Check, if the object vectors of the given MapData are still the ones
+   * built by the previous call.
+   */
+  bool IncrementalMapData::IsInSync(const MapData& data) const
+  {
+    return mapData==&data &&
+           data.nodes.size()==nodes.GetSize() &&
+           data.ways.size()==ways.GetSize() &&
+           data.areas.size()==areas.GetSize() &&
+           data.routes.size()==routes.GetSize();
+  }
+
+  /**
+   * Update the object vectors (nodes, ways, areas and routes) of the given MapData
+   * to hold the deduplicated objects of the given tiles.
+   *
+   * @param tiles
+   *    The tiles currently visible
+   * @param filter
+   *    Filter for the types of the objects to take over
+   * @param data
+   *    The MapData to update, should be the same instance on each call
+   */
+  void IncrementalMapData::Update(const std::list<TileRef>& tiles,
+                                  const TypeFilter& filter,
+                                  MapData& data)
+  {
+    statistics=Statistics();
+
+    if (!IsInSync(data) ||
+        !this->filter ||
+        !(*this->filter==filter)) {
+      Clear();
+
+      data.nodes.clear();
+      data.ways.clear();
+      data.areas.clear();
+      data.routes.clear();
+
+      mapData=&data;
+      this->filter=filter;
+      statistics.rebuild=true;
+    }
+
+    std::unordered_set<const Tile*> currentTiles;
+
+    currentTiles.reserve(tiles.size());
+
+    for (const auto& tile : tiles) {
+      currentTiles.insert(tile.get());
+    }
+
+    // Remove contributions of tiles that are gone
+    for (auto entry=contributions.begin(); entry!=contributions.end();) {
+      if (!currentTiles.contains(entry->first)) {
+        RemoveTile(entry->second,
+                   data);
+        statistics.removedTiles++;
+        entry=contributions.erase(entry);
+      }
+      else {
+        ++entry;
+      }
+    }
+
+    for (const auto& tile : tiles) {
+      auto entry=contributions.find(tile.get());
+
+      if (entry!=contributions.end()) {
+        if (entry->second.generation==tile->GetDataGeneration()) {
+          statistics.keptTiles++;
+          continue;
+        }
+
+        // Data of the tile changed, replace its contribution
+        RemoveTile(entry->second,
+                   data);
+        contributions.erase(entry);
+        statistics.changedTiles++;
+      }
+      else {
+        statistics.addedTiles++;
+      }
+
+      TileContribution& contribution=contributions[tile.get()];
+
+      AddTile(tile,
+              filter,
+              data,
+              contribution);
+    }
+  }
+
+  /**
+   * Forget about all tiles and objects. The next call to Update() will rebuild
+   * the MapData from scratch.
+   */
+  void IncrementalMapData::Clear()
+  {
+    mapData=nullptr;
+    filter.reset();
+    contributions.clear();
+    nodes.Clear();
+    ways.Clear();
+    areas.Clear();
+    routes.Clear();
+  }
+}
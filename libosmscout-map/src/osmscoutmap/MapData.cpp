@@ -29,5 +29,20 @@ namespace osmscout {
     nodes.clear();
     areas.clear();
     ways.clear();
+    columns.Clear();
+  }
+
+  /**
+   * Returns true, if columns holds the current nodes, ways and areas. Since the
+   * object lists are public, changes cannot be tracked. Instead the objects the
+   * columns were created from are compared with the current ones, which detects
+   * added, removed, replaced and reordered objects.
+   */
+  bool MapData::HasColumns() const
+  {
+    return !columns.IsEmpty() &&
+           columns.IsAssigned(nodes,
+                              ways,
+                              areas);
   }
 }
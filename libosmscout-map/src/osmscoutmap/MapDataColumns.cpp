@@ -0,0 +1,206 @@
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutmap/MapDataColumns.h>
+
+namespace osmscout {
+
+  template<typename T>
+  static size_t GetCapacitySize(const std::vector<T>& values)
+  {
+    return values.capacity()*sizeof(T);
+  }
+
+  MapDataColumns::MapDataColumns()
+  {
+    Clear();
+  }
+
+  /**
+   * Remove all entries but keep the allocated memory
+   */
+  void MapDataColumns::Clear()
+  {
+    nodes.coords.clear();
+    nodes.types.clear();
+    nodes.features.clear();
+    nodes.objects.clear();
+
+    ways.points.clear();
+    ways.pointOffsets.clear();
+    ways.types.clear();
+    ways.boundingBoxes.clear();
+    ways.features.clear();
+    ways.objects.clear();
+
+    areas.points.clear();
+    areas.ringOffsets.clear();
+    areas.pointOffsets.clear();
+    areas.ringTypes.clear();
+    areas.ringLevels.clear();
+    areas.ringFeatures.clear();
+    areas.boundingBoxes.clear();
+    areas.objects.clear();
+
+    ways.pointOffsets.push_back(0);
+    areas.ringOffsets.push_back(0);
+    areas.pointOffsets.push_back(0);
+  }
+
+  void MapDataColumns::AddNode(const NodeRef& node)
+  {
+    nodes.coords.push_back(node->GetCoords());
+    nodes.types.push_back(node->GetType()->GetNodeId());
+    nodes.features.push_back(&node->GetFeatureValueBuffer());
+    nodes.objects.push_back(node);
+  }
+
+  void MapDataColumns::AddWay(const WayRef& way)
+  {
+    ways.points.insert(ways.points.end(),
+                       way->nodes.begin(),
+                       way->nodes.end());
+    ways.pointOffsets.push_back(ways.points.size());
+    ways.types.push_back(way->GetType()->GetWayId());
+    ways.boundingBoxes.push_back(way->GetBoundingBox());
+    ways.features.push_back(&way->GetFeatureValueBuffer());
+    ways.objects.push_back(way);
+  }
+
+  void MapDataColumns::AddArea(const AreaRef& area)
+  {
+    GeoBox boundingBox;
+
+    for (const auto& ring : area->rings) {
+      areas.points.insert(areas.points.end(),
+                          ring.nodes.begin(),
+                          ring.nodes.end());
+      areas.pointOffsets.push_back(areas.points.size());
+      areas.ringTypes.push_back(ring.GetType()->GetAreaId());
+      areas.ringLevels.push_back(ring.GetRing());
+      areas.ringFeatures.push_back(&ring.GetFeatureValueBuffer());
+
+      if (ring.IsTopOuter()) {
+        boundingBox.Include(ring.GetBoundingBox());
+      }
+    }
+
+    areas.ringOffsets.push_back(areas.ringTypes.size());
+    areas.boundingBoxes.push_back(boundingBox);
+    areas.objects.push_back(area);
+  }
+
+  /**
+   * Replace the current content with the given objects. Capacity is reserved
+   * in advance, so that filling does not reallocate multiple times.
+   */
+  void MapDataColumns::Assign(const std::vector<NodeRef>& nodeRefs,
+                              const std::vector<WayRef>& wayRefs,
+                              const std::vector<AreaRef>& areaRefs)
+  {
+    Clear();
+
+    size_t wayPointCount=0;
+    size_t ringCount=0;
+    size_t ringPointCount=0;
+
+    for (const auto& way : wayRefs) {
+      wayPointCount+=way->nodes.size();
+    }
+
+    for (const auto& area : areaRefs) {
+      ringCount+=area->rings.size();
+
+      for (const auto& ring : area->rings) {
+        ringPointCount+=ring.nodes.size();
+      }
+    }
+
+    nodes.coords.reserve(nodeRefs.size());
+    nodes.types.reserve(nodeRefs.size());
+    nodes.features.reserve(nodeRefs.size());
+    nodes.objects.reserve(nodeRefs.size());
+
+    ways.points.reserve(wayPointCount);
+    ways.pointOffsets.reserve(wayRefs.size()+1);
+    ways.types.reserve(wayRefs.size());
+    ways.boundingBoxes.reserve(wayRefs.size());
+    ways.features.reserve(wayRefs.size());
+    ways.objects.reserve(wayRefs.size());
+
+    areas.points.reserve(ringPointCount);
+    areas.ringOffsets.reserve(areaRefs.size()+1);
+    areas.pointOffsets.reserve(ringCount+1);
+    areas.ringTypes.reserve(ringCount);
+    areas.ringLevels.reserve(ringCount);
+    areas.ringFeatures.reserve(ringCount);
+    areas.boundingBoxes.reserve(areaRefs.size());
+    areas.objects.reserve(areaRefs.size());
+
+    for (const auto& node : nodeRefs) {
+      AddNode(node);
+    }
+
+    for (const auto& way : wayRefs) {
+      AddWay(way);
+    }
+
+    for (const auto& area : areaRefs) {
+      AddArea(area);
+    }
+  }
+
+  /**
+   * Returns true, if the columns were filled from exactly the given objects in the
+   * given order
+   */
+  bool MapDataColumns::IsAssigned(const std::vector<NodeRef>& nodeRefs,
+                                  const std::vector<WayRef>& wayRefs,
+                                  const std::vector<AreaRef>& areaRefs) const
+  {
+    return nodes.objects==nodeRefs &&
+           ways.objects==wayRefs &&
+           areas.objects==areaRefs;
+  }
+
+  /**
+   * Return the number of bytes allocated by the columns
+   */
+  size_t MapDataColumns::GetMemorySize() const
+  {
+    return GetCapacitySize(nodes.coords)+
+           GetCapacitySize(nodes.types)+
+           GetCapacitySize(nodes.features)+
+           GetCapacitySize(nodes.objects)+
+           GetCapacitySize(ways.points)+
+           GetCapacitySize(ways.pointOffsets)+
+           GetCapacitySize(ways.types)+
+           GetCapacitySize(ways.boundingBoxes)+
+           GetCapacitySize(ways.features)+
+           GetCapacitySize(ways.objects)+
+           GetCapacitySize(areas.points)+
+           GetCapacitySize(areas.ringOffsets)+
+           GetCapacitySize(areas.pointOffsets)+
+           GetCapacitySize(areas.ringTypes)+
+           GetCapacitySize(areas.ringLevels)+
+           GetCapacitySize(areas.ringFeatures)+
+           GetCapacitySize(areas.boundingBoxes)+
+           GetCapacitySize(areas.objects);
+  }
+}
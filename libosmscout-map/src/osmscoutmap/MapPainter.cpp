@@ -20,12 +20,14 @@
 #include <osmscoutmap/MapPainter.h>
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <sstream>
 
 #include <osmscout/system/Math.h>
 
 #include <osmscout/log/Logger.h>
+#include <osmscout/util/Metrics.h>
 #include <osmscout/util/StopClock.h>
 #include <osmscout/util/String.h>
 #include <osmscout/util/Tiling.h>
@@ -153,7 +155,11 @@ constexpr bool debugGroundTiles = false;
   }
 
   MapPainter::MapPainter(const StyleConfigRef& styleConfig)
-  : styleConfig(styleConfig),
+  : areaData(&renderArena),
+    wayData(&renderArena),
+    wayPathData(&renderArena),
+    routeLabelData(&renderArena),
+    styleConfig(styleConfig),
     nameReader(*styleConfig->GetTypeConfig()),
     nameAltReader(*styleConfig->GetTypeConfig()),
     refReader(*styleConfig->GetTypeConfig()),
@@ -501,11 +507,25 @@ constexpr bool debugGroundTiles = false;
                                 const MapParameter& parameter,
                                 const MapData& data)
   {
-    for (const auto& node : data.nodes) {
-      PrepareNode(styleConfig,
-                  projection,
-                  parameter,
-                  node);
+    if (cullBox.IsValid()) {
+      const std::vector<GeoCoord>& coords=data.columns.nodes.coords;
+
+      for (size_t i=0; i<coords.size(); i++) {
+        if (cullBox.Includes(coords[i],false)) {
+          PrepareNode(styleConfig,
+                      projection,
+                      parameter,
+                      data.nodes[i]);
+        }
+      }
+    }
+    else {
+      for (const auto& node : data.nodes) {
+        PrepareNode(styleConfig,
+                    projection,
+                    parameter,
+                    node);
+      }
     }
 
     for (const auto& node : data.poiNodes) {
@@ -1089,7 +1109,7 @@ constexpr bool debugGroundTiles = false;
       ++borderStyleIndex;
     }
 
-    AreaData a;
+    AreaData a(areaData.get_allocator());
     double   borderWidth=borderStyle ? borderStyle->GetWidth() : 0.0;
 
     a.boundingBox=ring.GetBoundingBox();
@@ -1161,12 +1181,103 @@ constexpr bool debugGroundTiles = false;
     return true;
   }
 
+  /**
+   * Returns true, if the given bounding box is completely within the clip box, so that
+   * clipping would not drop any nodes.
+   */
+  static bool IsInsideClipBox(const GeoBox& clipBox,
+                              const GeoBox& boundingBox)
+  {
+    return boundingBox.IsValid() &&
+           clipBox.Includes(boundingBox.GetMinCoord(),false) &&
+           clipBox.Includes(boundingBox.GetMaxCoord(),false);
+  }
+
+  /**
+   * Return the clip box to use for transforming the rings of the given area or an invalid GeoBox,
+   * if the area must not be clipped.
+   *
+   * Like for ways (see GetWayClipBox()) clipping does not change the filled region within the clip box,
+   * but the length of the border. Areas with dashed borders, border labels or border symbols are thus not
+   * clipped. Since clipping rings are drawn as part of their outer ring, the decision is taken for the
+   * area as a whole.
+   */
+  GeoBox MapPainter::GetAreaClipBox(const StyleConfig& styleConfig,
+                                    const Projection& projection,
+                                    const Area& area) const
+  {
+    if (!clipBox.IsValid()) {
+      return {};
+    }
+
+    bool inside=true;
+
+    for (const auto& ring : area.rings) {
+      if (!ring.IsMaster() &&
+          !IsInsideClipBox(clipBox,ring.GetBoundingBox())) {
+        inside=false;
+        break;
+      }
+    }
+
+    if (inside) {
+      return {};
+    }
+
+    std::vector<BorderStyleRef> borderStyles;
+
+    for (const auto& ring : area.rings) {
+      if (ring.IsMaster()) {
+        continue;
+      }
+
+      TypeInfoRef type=area.GetRingType(ring);
+
+      if (type->GetIgnore()) {
+        continue;
+      }
+
+      styleConfig.GetAreaBorderStyles(type,
+                                      ring.GetFeatureValueBuffer(),
+                                      projection,
+                                      borderStyles);
+
+      for (const auto& borderStyle : borderStyles) {
+        if (borderStyle->HasDashes()) {
+          return {};
+        }
+
+        double borderExtent=projection.ConvertWidthToPixel(borderStyle->GetWidth())/2.0+
+                            std::abs(GetProjectedWidth(projection,borderStyle->GetOffset()))+
+                            std::abs(projection.ConvertWidthToPixel(borderStyle->GetDisplayOffset()));
+
+        if (borderExtent>=clipGuardBand) {
+          return {};
+        }
+      }
+
+      if (styleConfig.GetAreaBorderTextStyle(type,
+                                             ring.GetFeatureValueBuffer(),
+                                             projection) ||
+          styleConfig.GetAreaBorderSymbolStyle(type,
+                                               ring.GetFeatureValueBuffer(),
+                                               projection)) {
+        return {};
+      }
+    }
+
+    return clipBox;
+  }
+
   void MapPainter::PrepareArea(const StyleConfig& styleConfig,
                                const Projection& projection,
                                const MapParameter& parameter,
                                const AreaRef &area)
   {
     std::vector<CoordBufferRange> td(area->rings.size()); // Polygon information for each ring
+    GeoBox                        areaClipBox=GetAreaClipBox(styleConfig,
+                                                             projection,
+                                                             *area);
 
     for (size_t i=0; i<area->rings.size(); i++) {
       const Area::Ring &ring = area->rings[i];
@@ -1177,35 +1288,14 @@ constexpr bool debugGroundTiles = false;
         continue;
       }
 
-      if (ring.segments.size() <= 1){
-        td[i]=TransformArea(ring.nodes,
-                            transBuffer,
-                            coordBuffer,
-                            projection,
-                            parameter.GetOptimizeAreaNodes(),
-                            errorTolerancePixel);
-      }
-      else {
-        std::vector<Point> nodes;
-
-        for (const auto &segment:ring.segments){
-          if (projection.GetDimensions().Intersects(segment.bbox, false)){
-            // TODO: add TransBuffer::Transform* methods with vector subrange (begin/end)
-            nodes.insert(nodes.end(), ring.nodes.data() + segment.from, ring.nodes.data() + segment.to);
-          }
-          else {
-            nodes.push_back(ring.nodes[segment.from]);
-            nodes.push_back(ring.nodes[segment.to-1]);
-          }
-        }
-
-        td[i]=TransformArea(nodes,
-                            transBuffer,
-                            coordBuffer,
-                            projection,
-                            parameter.GetOptimizeAreaNodes(),
-                            errorTolerancePixel);
-      }
+      td[i]=TransformArea(ring.nodes,
+                          ring.segments,
+                          areaClipBox,
+                          transBuffer,
+                          coordBuffer,
+                          projection,
+                          parameter.GetOptimizeAreaNodes(),
+                          errorTolerancePixel);
     }
 
     area->VisitRings([this,&styleConfig,&projection,&parameter,&td,&area](size_t i,
@@ -1229,11 +1319,25 @@ constexpr bool debugGroundTiles = false;
     areaData.clear();
 
     //Areas
-    for (const auto& area : data.areas) {
-      PrepareArea(*styleConfig,
-                  projection,
-                  parameter,
-                  area);
+    if (cullBox.IsValid()) {
+      const std::vector<GeoBox>& boundingBoxes=data.columns.areas.boundingBoxes;
+
+      for (size_t i=0; i<boundingBoxes.size(); i++) {
+        if (boundingBoxes[i].Intersects(cullBox,false)) {
+          PrepareArea(*styleConfig,
+                      projection,
+                      parameter,
+                      data.areas[i]);
+        }
+      }
+    }
+    else {
+      for (const auto& area : data.areas) {
+        PrepareArea(*styleConfig,
+                    projection,
+                    parameter,
+                    area);
+      }
     }
 
     // POI Areas
@@ -1293,36 +1397,17 @@ constexpr bool debugGroundTiles = false;
   void MapPainter::TransformPathData(const Projection& projection,
                                      const MapParameter& parameter,
                                      const Way& way,
+                                     const GeoBox& clipBox,
                                      WayPathData &pathData)
   {
-    if (way.segments.size() <= 1) {
-      pathData.coordRange=TransformWay(way.nodes,
-                                       transBuffer,
-                                       coordBuffer,
-                                       projection,
-                                       parameter.GetOptimizeWayNodes(),
-                                       errorTolerancePixel);
-    }
-    else {
-      std::vector<Point> nodes;
-      for (const auto &segment : way.segments){
-        if (projection.GetDimensions().Intersects(segment.bbox, false)){
-          // TODO: add TransBuffer::Transform* methods with vector subrange (begin/end)
-          nodes.insert(nodes.end(), way.nodes.data() + segment.from, way.nodes.data() + segment.to);
-        }
-        else {
-          nodes.push_back(way.nodes[segment.from]);
-          nodes.push_back(way.nodes[segment.to-1]);
-        }
-      }
-
-      pathData.coordRange=TransformWay(nodes,
-                                       transBuffer,
-                                       coordBuffer,
-                                       projection,
-                                       parameter.GetOptimizeWayNodes(),
-                                       errorTolerancePixel);
-    }
+    pathData.coordRange=TransformWay(way.nodes,
+                                     way.segments,
+                                     clipBox,
+                                     transBuffer,
+                                     coordBuffer,
+                                     projection,
+                                     parameter.GetOptimizeWayNodes(),
+                                     errorTolerancePixel);
   }
 
   double MapPainter::CalculateLineWith(const Projection& projection,
@@ -1422,6 +1507,65 @@ constexpr bool debugGroundTiles = false;
     return 0;
   }
 
+  /**
+   * Return the clip box to use for transforming the given way or an invalid GeoBox,
+   * if the way must not be clipped.
+   *
+   * Clipping replaces parts of the way outside of the visible area by shorter lines.
+   * This is not visible as long as the line (plus offset) is narrower than the guard band,
+   * but it changes the length of the path. Dashes, path symbols and contour labels
+   * are positioned relative to the start and length of the path and thus would move (and
+   * would not match anymore at the border of neighbouring tiles).
+   * Ways with such styles are thus not clipped.
+   *
+   * @note styleConfig.GetWayLineStyles() must have been called for the way
+   */
+  GeoBox MapPainter::GetWayClipBox(const StyleConfig& styleConfig,
+                                   const Projection& projection,
+                                   const Way& way,
+                                   double mainSlotWidth)
+  {
+    if (!clipBox.IsValid() ||
+        !clipWays ||
+        IsInsideClipBox(clipBox,way.GetBoundingBox())) {
+      return {};
+    }
+
+    const FeatureValueBuffer& buffer=way.GetFeatureValueBuffer();
+
+    for (const auto& lineStyle : lineStyles) {
+      if (lineStyle->HasDashes()) {
+        return {};
+      }
+
+      double lineExtent=std::abs(CalculateLineOffset(projection,
+                                                     *lineStyle,
+                                                     mainSlotWidth))+
+                        CalculateLineWith(projection,
+                                          buffer,
+                                          *lineStyle)/2.0;
+
+      if (lineExtent>=clipGuardBand) {
+        return {};
+      }
+    }
+
+    if (styleConfig.GetWayPathTextStyle(buffer,
+                                        projection)) {
+      return {};
+    }
+
+    styleConfig.GetWayPathSymbolStyle(buffer,
+                                      projection,
+                                      symbolStyles);
+
+    if (!symbolStyles.empty()) {
+      return {};
+    }
+
+    return clipBox;
+  }
+
   void MapPainter::CalculateWayPaths(const StyleConfig& styleConfig,
                                      const Projection& projection,
                                      const MapParameter& parameter,
@@ -1464,6 +1608,11 @@ constexpr bool debugGroundTiles = false;
                  << " results in empty mainSlotWidth";
     }
 
+    GeoBox wayClipBox=GetWayClipBox(styleConfig,
+                                    projection,
+                                    way,
+                                    pathData.mainSlotWidth);
+
     for (const auto& lineStyle : lineStyles) {
       double lineWidth;
 
@@ -1508,7 +1657,7 @@ constexpr bool debugGroundTiles = false;
       data.lineWidth=lineWidth;
 
       if (!transformed) {
-        TransformPathData(projection, parameter, way, pathData);
+        TransformPathData(projection, parameter, way, wayClipBox, pathData);
         transformed=true;
         wayPathData.push_back(pathData);
       }
@@ -1592,12 +1741,19 @@ constexpr bool debugGroundTiles = false;
     wayPathData.clear();
     routeLabelData.clear();
 
-    for (const auto& way : data.ways) {
-      if (way->IsValid()) {
+    // Route labels need the paths of ways outside of the visible area, too
+    const GeoBox* wayCullBox=cullBox.IsValid() && clipWays ? &cullBox : nullptr;
+
+    for (size_t i=0; i<data.ways.size(); i++) {
+      const Way& way=*data.ways[i];
+
+      if (way.IsValid() &&
+          (wayCullBox==nullptr ||
+           data.columns.ways.boundingBoxes[i].Intersects(*wayCullBox,false))) {
         CalculateWayPaths(*styleConfig,
                           projection,
                           parameter,
-                          *way);
+                          way);
       }
     }
 
@@ -1619,12 +1775,16 @@ constexpr bool debugGroundTiles = false;
       return;
     }
 
-    for (const auto& way : data.ways) {
-      if (way->IsValid()) {
+    for (size_t i=0; i<data.ways.size(); i++) {
+      const Way& way=*data.ways[i];
+
+      if (way.IsValid() &&
+          (!cullBox.IsValid() ||
+           data.columns.ways.boundingBoxes[i].Intersects(cullBox,false))) {
         CalculateWayShieldLabels(*styleConfig,
                                  projection,
                                  parameter,
-                                 *way);
+                                 way);
       }
     }
 
@@ -1766,7 +1926,7 @@ constexpr bool debugGroundTiles = false;
 
               pathData.ref=member.way;
               pathData.buffer=&(it->second->GetFeatureValueBuffer());
-              TransformPathData(projection, parameter, *(it->second), pathData);
+              TransformPathData(projection, parameter, *(it->second), GeoBox(), pathData);
               pathData.mainSlotWidth=0.0;
 
               wayPathData.push_back(pathData);
@@ -1888,6 +2048,54 @@ constexpr bool debugGroundTiles = false;
     }
   }
 
+  /**
+   * Returns the histogram measuring the duration of the given render step
+   */
+  static MetricHistogram& GetRenderStepHistogram(size_t step)
+  {
+    static const std::array<const char*,RenderSteps::LastStep+1> stepNames={
+      "initialize",
+      "dump_statistics",
+      "calculate_paths",
+      "calculate_way_shields",
+      "process_areas",
+      "process_routes",
+      "after_preprocessing",
+      "prerender",
+      "draw_base_map_tiles",
+      "draw_ground_tiles",
+      "draw_osm_tile_grids",
+      "draw_areas",
+      "draw_ways",
+      "draw_way_decorations",
+      "draw_way_contour_labels",
+      "prepare_area_labels",
+      "draw_area_border_labels",
+      "draw_area_border_symbols",
+      "prepare_node_labels",
+      "prepare_route_labels",
+      "draw_contour_lines",
+      "draw_hill_shading",
+      "draw_labels",
+      "postrender"
+    };
+
+    static const std::array<MetricHistogram*,RenderSteps::LastStep+1> histograms=[]() {
+      std::array<MetricHistogram*,RenderSteps::LastStep+1> result;
+
+      for (size_t i=0; i<result.size(); i++) {
+        std::string name=stepNames[i];
+
+        result[i]=&MetricsRegistry::Instance().GetHistogram("osmscout_mappainter_"+name+"_microseconds",
+                                                             "Duration of the map painter render step '"+name+"'");
+      }
+
+      return result;
+    }();
+
+    return *histograms[step];
+  }
+
   bool MapPainter::Draw(const Projection& projection,
                         const MapParameter& parameter,
                         const MapData& data,
@@ -1899,12 +2107,15 @@ constexpr bool debugGroundTiles = false;
     assert(startStep<=endStep);
 
     for (size_t step=startStep; step<=endStep; step++) {
-      StepMethod stepMethod=stepMethods[step];
+      StepMethod  stepMethod=stepMethods[step];
+      MetricTimer timer(GetRenderStepHistogram(step));
 
       assert(stepMethod!=nullptr);
 
       (this->*stepMethod)(projection,parameter,data);
 
+      timer.Stop();
+
       if (parameter.IsAborted()) {
         return false;
       }
@@ -1930,10 +2141,40 @@ constexpr bool debugGroundTiles = false;
    */
   void MapPainter::InitializeRender(const Projection& projection,
                                     const MapParameter& parameter,
-                                    const MapData& /*data*/)
+                                    const MapData& data)
   {
+    // All processing lists of the previous render call are dropped at once
+    areaData.clear();
+    wayData.clear();
+    wayPathData.clear();
+    routeLabelData.clear();
+    renderArena.Reset();
+
     errorTolerancePixel=projection.ConvertWidthToPixel(parameter.GetOptimizeErrorToleranceMm());
     areaMinDimension   =projection.ConvertWidthToPixel(parameter.GetAreaMinDimensionMM());
+    clipGuardBand      =projection.ConvertWidthToPixel(parameter.GetLabelLayouterOverlap());
+
+    if (parameter.GetClipGeometry()) {
+      clipBox=CalculateClipBox(projection,
+                               clipGuardBand);
+    }
+    else {
+      clipBox.Invalidate();
+    }
+
+    // Route labels are positioned along the paths of the ways
+    clipWays=data.routes.empty();
+
+    // Objects completely outside of the guard band are skipped up front, if the
+    // bounding boxes are available in column oriented form
+    if (data.HasColumns()) {
+      cullBox=clipBox.IsValid() ? clipBox : CalculateClipBox(projection,
+                                                             clipGuardBand);
+    }
+    else {
+      cullBox.Invalidate();
+    }
+
     contourLabelOffset =projection.ConvertWidthToPixel(parameter.GetContourLabelOffset());
     contourLabelSpace  =projection.ConvertWidthToPixel(parameter.GetContourLabelSpace());
 
@@ -3025,5 +3266,19 @@ constexpr bool debugGroundTiles = false;
                  projection,
                  parameter,
                  data);
+
+    if (parameter.IsDebugPerformance()) {
+      if (auto textLayoutStatistics=GetTextLayoutCacheStatistics();
+          textLayoutStatistics) {
+        MapPainterStatistics statistics;
+
+        statistics.DumpTextLayoutCacheStatistics(*textLayoutStatistics);
+      }
+    }
+  }
+
+  std::optional<TextLayoutCacheStatistics> MapPainter::GetTextLayoutCacheStatistics() const
+  {
+    return std::nullopt;
   }
 }
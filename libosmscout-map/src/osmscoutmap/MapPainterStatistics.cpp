@@ -19,6 +19,8 @@
 
 #include <osmscoutmap/MapPainterStatistics.h>
 
+#include <cmath>
+
 #include <osmscout/TypeInfoSet.h>
 
 #include <osmscout/log/Logger.h>
@@ -66,6 +68,17 @@ namespace osmscout {
                        data);
   }
 
+  void MapPainterStatistics::DumpTextLayoutCacheStatistics(const TextLayoutCacheStatistics& statistics)
+  {
+    log.Info()
+      << "Text layouts: "
+      << statistics.hits << " hits "
+      << statistics.misses << " misses "
+      << std::lround(statistics.GetHitRate()*100.0) << "% hit rate "
+      << statistics.entries << "/" << statistics.capacity << " cached "
+      << statistics.evictions << " evicted";
+  }
+
   void MapPainterStatistics::DumpDataStatistics(const std::list<DataStatistic>& statistics)
   {
     log.Info() << "Type|ObjectCount|NodeCount|WayCount|AreaCount|Nodes|Labels|Icons";
@@ -32,12 +32,14 @@ namespace osmscout {
     optimizeWayNodes(TransPolygon::none),
     optimizeAreaNodes(TransPolygon::none),
     optimizeErrorToleranceMm(0.5),
+    clipGeometry(true),
     drawFadings(true),
     drawWaysWithFixedWidth(false),
     labelLineMinCharCount(5),
     labelLineMaxCharCount(15),
     labelLineFitToArea(true),
     labelLineFitToWidth(8000),
+    textLayoutCacheSize(10000),
     labelPadding(1.0),
     plateLabelPadding(5.0),
     overlayLabelPadding(6.0),
@@ -112,6 +114,11 @@ namespace osmscout {
     optimizeErrorToleranceMm=errorToleranceMm;
   }
 
+  void MapParameter::SetClipGeometry(bool clipGeometry)
+  {
+    this->clipGeometry=clipGeometry;
+  }
+
   void MapParameter::SetDrawFadings(bool drawFadings)
   {
     this->drawFadings=drawFadings;
@@ -141,6 +148,11 @@ namespace osmscout {
     this->labelLineFitToWidth=labelLineFitToWidth;
   }
 
+  void MapParameter::SetTextLayoutCacheSize(size_t textLayoutCacheSize)
+  {
+    this->textLayoutCacheSize=textLayoutCacheSize;
+  }
+
   void MapParameter::SetLabelPadding(double labelSpace)
   {
     this->labelPadding=labelSpace;
@@ -89,13 +89,19 @@ namespace osmscout {
   MapService::MapService(const DatabaseRef& database)
    : database(database),
      cache(25),
+     columnarMapData(false),
      nodeWorkerThread(&MapService::NodeWorkerLoop,this),
      wayWorkerThread(&MapService::WayWorkerLoop,this),
      wayLowZoomWorkerThread(&MapService::WayLowZoomWorkerLoop,this),
      areaWorkerThread(&MapService::AreaWorkerLoop,this),
      areaLowZoomWorkerThread(&MapService::AreaLowZoomWorkerLoop,this),
      routeWorkerThread(&MapService::RouteWorkerLoop,this),
-     nextCallbackId(0)
+     nextCallbackId(0),
+     tileStateCallbacks(std::make_shared<const TileStateCallbackMap>()),
+     tileStateSignal(0),
+     callbackEpoch(0),
+     callbackThreadStopped(false),
+     callbackThread(&MapService::TileStateCallbackLoop,this)
   {
     // no code
   }
@@ -115,6 +121,12 @@ namespace osmscout {
     areaWorkerThread.join();
     routeWorkerThread.join();
     areaLowZoomWorkerThread.join();
+
+    callbackThreadStopped=true;
+    tileStateSignal.fetch_add(1);
+    tileStateSignal.notify_one();
+
+    callbackThread.join();
   }
 
   /**
@@ -141,6 +153,68 @@ namespace osmscout {
     return cache.GetCurrentSize();
   }
 
+  /**
+   * Set the maximum estimated memory in bytes of all cached tiles. A value of 0
+   * (the default) disables the limit and only the number of tiles is limited.
+   */
+  void MapService::SetCacheMemoryLimit(size_t memoryLimit)
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    cache.SetMemoryLimit(memoryLimit);
+  }
+
+  size_t MapService::GetCacheMemoryLimit() const
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    return cache.GetMemoryLimit();
+  }
+
+  /**
+   * Return the estimated memory in bytes of all cached tiles
+   */
+  size_t MapService::GetCurrentCacheMemory() const
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    return cache.GetCurrentMemory();
+  }
+
+  /**
+   * Enable or disable background loading of the tiles next to the visible ones
+   * in the direction the map was last moved. Enabled by default. Only used by
+   * the asynchronous loading methods.
+   */
+  void MapService::SetPanPrefetch(bool panPrefetch)
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    cache.SetPanPrefetch(panPrefetch);
+  }
+
+  bool MapService::IsPanPrefetch() const
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    return cache.IsPanPrefetch();
+  }
+
+  /**
+   * If enabled, AddTileDataToMapData() also fills MapData::columns, a column oriented
+   * copy of the nodes, ways and areas, which the MapPainter uses for fast culling of
+   * invisible objects. Disabled by default.
+   */
+  void MapService::SetColumnarMapData(bool columnarMapData)
+  {
+    this->columnarMapData=columnarMapData;
+  }
+
+  bool MapService::IsColumnarMapData() const
+  {
+    return columnarMapData;
+  }
+
   /**
    * Evict tiles from cache until tile count <= cacheSize
    */
@@ -804,12 +878,47 @@ namespace osmscout {
     return future;
   }
 
+  /**
+   * Queue the tile for the callback thread. Never blocks, so loaders are not
+   * slowed down by (the registering of) callbacks.
+   */
   void MapService::NotifyTileStateCallbacks(const TileRef& tile) const
   {
-    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (tileStateCallbacks.Load()->empty()) {
+      return;
+    }
+
+    tileStateQueue.Push(tile);
 
-    for (auto& callbackEntry : tileStateCallbacks) {
-      callbackEntry.second(tile);
+    tileStateSignal.fetch_add(1);
+    tileStateSignal.notify_one();
+  }
+
+  void MapService::TileStateCallbackLoop()
+  {
+    SetThreadName("TileCallbacks");
+
+    while (true) {
+      uint32_t signal=tileStateSignal.load();
+
+      while (std::optional<TileRef> tile=tileStateQueue.TryPop()) {
+        // The epoch is odd while we use the current callbacks, see DeregisterTileStateCallback()
+        callbackEpoch.fetch_add(1);
+
+        std::shared_ptr<const TileStateCallbackMap> callbacks=tileStateCallbacks.Load();
+
+        for (const auto& callbackEntry : *callbacks) {
+          callbackEntry.second(tile.value());
+        }
+
+        callbackEpoch.fetch_add(1);
+      }
+
+      if (callbackThreadStopped) {
+        return;
+      }
+
+      tileStateSignal.wait(signal);
     }
   }
 
@@ -882,15 +991,91 @@ namespace osmscout {
     return tile;
   }
 
+  /**
+   * Prefill the given tile from the cache and push the tasks for loading all
+   * missing data of the given type definition.
+   */
+  void MapService::PushTileTasks(const AreaSearchParameter& parameter,
+                                 const TypeDefinition& typeDefinition,
+                                 const TileRef& tile,
+                                 std::list<std::future<bool>>& results) const
+  {
+    GeoBox        tileBoundingBox(tile->GetBoundingBox());
+    Magnification magnification(MagnificationLevel(tile->GetKey().GetLevel()));
+
+    cache.PrefillDataFromCache(*tile,
+                               typeDefinition.nodeTypes,
+                               typeDefinition.wayTypes,
+                               typeDefinition.areaTypes,
+                               typeDefinition.routeTypes,
+                               typeDefinition.optimizedWayTypes,
+                               typeDefinition.optimizedAreaTypes);
+
+    NotifyTileStateCallbacks(tile);
+
+    results.push_back(PushNodeTask(parameter,
+                                   typeDefinition.nodeTypes,
+                                   tileBoundingBox,
+                                   false,
+                                   tile));
+
+    if (parameter.GetUseLowZoomOptimization()) {
+      results.push_back(PushAreaLowZoomTask(parameter,
+                                            typeDefinition.optimizedAreaTypes,
+                                            magnification,
+                                            tileBoundingBox,
+                                            false,
+                                            tile));
+    } else {
+      tile->GetOptimizedAreaData().SetComplete();
+    }
+
+    results.push_back(PushAreaTask(parameter,
+                                   typeDefinition.areaTypes,
+                                   magnification,
+                                   tileBoundingBox,
+                                   false,
+                                   tile));
+
+    if (parameter.GetUseLowZoomOptimization()) {
+      results.push_back(PushWayLowZoomTask(parameter,
+                                           typeDefinition.optimizedWayTypes,
+                                           magnification,
+                                           tileBoundingBox,
+                                           false,
+                                           tile));
+    } else {
+      tile->GetOptimizedWayData().SetComplete();
+    }
+
+    results.push_back(PushWayTask(parameter,
+                                  typeDefinition.wayTypes,
+                                  tileBoundingBox,
+                                  false,
+                                  tile));
+
+    results.push_back(PushRouteTask(parameter,
+                                    typeDefinition.routeTypes,
+                                    tileBoundingBox,
+                                    false,
+                                    tile));
+  }
+
   /**
    * Load all missing data for the given tiles based on the given style config.
+   *
+   * If pan prefetch is enabled and loading is asynchronous, the tiles next to
+   * the requested ones in the direction of the last movement are loaded in the
+   * background, too. Their tasks are queued after the tasks of the requested tiles.
+   * Synchronous callers do not prefetch, since they rely on no loading being in
+   * progress after the call returns (e.g. before closing the database).
    */
   bool MapService::LoadMissingTileDataStyleSheet(const AreaSearchParameter& parameter,
                                                  const StyleConfig& styleConfig,
                                                  std::list<TileRef>& tiles,
                                                  bool async) const
   {
-    std::lock_guard<std::mutex>  lock(stateMutex);
+    std::unique_lock<std::mutex> lock(stateMutex);
 
     StopClock                    overallTime;
 
@@ -901,7 +1086,6 @@ namespace osmscout {
 
     for (auto& tile : tiles) {
       if (!tile->IsComplete()) {
-        GeoBox        tileBoundingBox(tile->GetBoundingBox());
         StopClock     tileLoadingTime;
         Magnification magnification(MagnificationLevel(tile->GetKey().GetLevel()));
 
@@ -917,62 +1101,10 @@ namespace osmscout {
           typeDefinitionMagnification=magnification;
         }
 
-        cache.PrefillDataFromCache(*tile,
-                                   typeDefinition->nodeTypes,
-                                   typeDefinition->wayTypes,
-                                   typeDefinition->areaTypes,
-                                   typeDefinition->routeTypes,
-                                   typeDefinition->optimizedWayTypes,
-                                   typeDefinition->optimizedAreaTypes);
-
-        NotifyTileStateCallbacks(tile);
-
-        results.push_back(PushNodeTask(parameter,
-                                       typeDefinition->nodeTypes,
-                                       tileBoundingBox,
-                                       false,
-                                       tile));
-
-        if (parameter.GetUseLowZoomOptimization()) {
-          results.push_back(PushAreaLowZoomTask(parameter,
-                                                typeDefinition->optimizedAreaTypes,
-                                                magnification,
-                                                tileBoundingBox,
-                                                false,
-                                                tile));
-        } else {
-          tile->GetOptimizedAreaData().SetComplete();
-        }
-
-        results.push_back(PushAreaTask(parameter,
-                                       typeDefinition->areaTypes,
-                                       magnification,
-                                       tileBoundingBox,
-                                       false,
-                                       tile));
-
-        if (parameter.GetUseLowZoomOptimization()) {
-          results.push_back(PushWayLowZoomTask(parameter,
-                                               typeDefinition->optimizedWayTypes,
-                                               magnification,
-                                               tileBoundingBox,
-                                               false,
-                                               tile));
-        } else {
-          tile->GetOptimizedWayData().SetComplete();
-        }
-
-        results.push_back(PushWayTask(parameter,
-                                      typeDefinition->wayTypes,
-                                      tileBoundingBox,
-                                      false,
-                                      tile));
-
-        results.push_back(PushRouteTask(parameter,
-                                        typeDefinition->routeTypes,
-                                        tileBoundingBox,
-                                        false,
-                                        tile));
+        PushTileTasks(parameter,
+                      *typeDefinition,
+                      tile,
+                      results);
 
         tileLoadingTime.Stop();
 
@@ -988,6 +1120,35 @@ namespace osmscout {
       }
     }
 
+    if (async && cache.IsPanPrefetch()) {
+      std::list<TileRef>           prefetchTiles;
+      std::list<std::future<bool>> prefetchResults;
+
+      cache.GetPrefetchTiles(prefetchTiles);
+
+      for (auto& tile : prefetchTiles) {
+        if (!tile->IsComplete()) {
+          Magnification magnification(MagnificationLevel(tile->GetKey().GetLevel()));
+
+          if (!typeDefinition ||
+              typeDefinitionMagnification!=magnification) {
+            typeDefinition=GetTypeDefinition(parameter,
+                                             styleConfig,
+                                             magnification);
+            typeDefinitionMagnification=magnification;
+          }
+
+          PushTileTasks(parameter,
+                        *typeDefinition,
+                        tile,
+                        prefetchResults);
+        }
+      }
+    }
+
+    // Do not block other callers while waiting for the loaders
+    lock.unlock();
+
     bool success=true;
 
     if (async) {
@@ -1007,6 +1168,8 @@ namespace osmscout {
       log.Warn() << "Retrieving all tile data took " << overallTime.ResultString();
     }
 
+    lock.lock();
+
     cache.CleanupCache();
 
     return success;
@@ -1018,7 +1181,7 @@ namespace osmscout {
                                                      std::list<TileRef>& tiles,
                                                      bool async) const
   {
-    std::lock_guard<std::mutex>  lock(stateMutex);
+    std::unique_lock<std::mutex> lock(stateMutex);
 
     StopClock                    overallTime;
 
@@ -1098,6 +1261,9 @@ namespace osmscout {
       }
     }
 
+    // Do not block other callers while waiting for the loaders
+    lock.unlock();
+
     bool success=true;
 
     if (async) {
@@ -1117,6 +1283,8 @@ namespace osmscout {
       log.Warn() << "Retrieving all tile data took " << overallTime.ResultString();
     }
 
+    lock.lock();
+
     cache.CleanupCache();
 
     return success;
@@ -1184,6 +1352,21 @@ namespace osmscout {
     return result.get();
   }
 
+  /**
+   * Fill MapData::columns from the current nodes, ways and areas if
+   * columnar map data is enabled.
+   */
+  void MapService::FillColumns(MapData& data) const
+  {
+    if (!columnarMapData) {
+      return;
+    }
+
+    data.columns.Assign(data.nodes,
+                        data.ways,
+                        data.areas);
+  }
+
   /**
    * Convert the data hold by the given tiles to the given MapData class instance.
    */
@@ -1266,6 +1449,8 @@ namespace osmscout {
       data.routes.push_back(routeEntry.second);
     }
 
+    FillColumns(data);
+
     copyTime.Stop();
 
     if (copyTime.GetMilliseconds()>20) {
@@ -1355,6 +1540,8 @@ namespace osmscout {
       data.areas.push_back(areaEntry.second);
     }
 
+    FillColumns(data);
+
     copyTime.Stop();
 
     if (copyTime.GetMilliseconds()>20) {
@@ -1362,6 +1549,69 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Convert the data hold by the given tiles to the given MapData class instance.
+   *
+   * In contrast to the non-incremental version only the data of tiles that were added,
+   * removed or changed since the last call with the same IncrementalMapData instance
+   * is processed. The same MapData instance must be passed on every call, the data
+   * vectors are updated in place.
+   */
+  void MapService::AddTileDataToMapData(std::list<TileRef>& tiles,
+                                        IncrementalMapData& incrementalData,
+                                        MapData& data) const
+  {
+    StopClock updateTime;
+
+    incrementalData.Update(tiles,
+                           IncrementalMapData::TypeFilter(),
+                           data);
+
+    FillColumns(data);
+
+    updateTime.Stop();
+
+    if (updateTime.GetMilliseconds()>20) {
+      log.Warn() << "Updating MapData from tiles took " << updateTime.ResultString();
+    }
+  }
+
+  /**
+   * Convert the data hold by the given tiles to the given MapData class instance,
+   * taking over only objects of the types given in the type definition.
+   *
+   * See the incremental version without type definition for details.
+   */
+  void MapService::AddTileDataToMapData(std::list<TileRef>& tiles,
+                                        const TypeDefinition& typeDefinition,
+                                        IncrementalMapData& incrementalData,
+                                        MapData& data) const
+  {
+    IncrementalMapData::TypeFilter filter;
+
+    filter.nodeTypes=typeDefinition.nodeTypes;
+    filter.wayTypes=typeDefinition.wayTypes;
+    filter.areaTypes=typeDefinition.areaTypes;
+    // Routes are not part of the MapData for a type definition
+    filter.routeTypes=TypeInfoSet();
+    filter.optimizedWayTypes=typeDefinition.optimizedWayTypes;
+    filter.optimizedAreaTypes=typeDefinition.optimizedAreaTypes;
+
+    StopClock updateTime;
+
+    incrementalData.Update(tiles,
+                           filter,
+                           data);
+
+    FillColumns(data);
+
+    updateTime.Stop();
+
+    if (updateTime.GetMilliseconds()>20) {
+      log.Warn() << "Updating MapData from tiles took " << updateTime.ResultString();
+    }
+  }
+
   /**
    * Return all ground tiles for the given projection data
    * (bounding box and magnification).
@@ -1459,16 +1709,43 @@ namespace osmscout {
     std::lock_guard<std::mutex> lock(callbackMutex);
 
     CallbackId id=nextCallbackId++;
+    auto       callbacks=std::make_shared<TileStateCallbackMap>(*tileStateCallbacks.Load());
 
-    tileStateCallbacks.insert(std::make_pair(id,callback));
+    callbacks->insert(std::make_pair(id,std::move(callback)));
+
+    tileStateCallbacks.Store(std::move(callbacks));
 
     return id;
   }
 
+  /**
+   * Deregister the given callback. After the method returns, the callback is not called
+   * anymore (except if called from within a callback).
+   */
   void MapService::DeregisterTileStateCallback(CallbackId callbackId)
   {
-    std::lock_guard<std::mutex> lock(callbackMutex);
+    {
+      std::lock_guard<std::mutex> lock(callbackMutex);
+
+      auto callbacks=std::make_shared<TileStateCallbackMap>(*tileStateCallbacks.Load());
+
+      callbacks->erase(callbackId);
+
+      tileStateCallbacks.Store(std::move(callbacks));
+    }
 
-    tileStateCallbacks.erase(callbackId);
+    if (std::this_thread::get_id()==callbackThread.get_id()) {
+      return;
+    }
+
+    // The callback thread may still be calling the callbacks of an older snapshot,
+    // wait for it to finish the current tile
+    size_t epoch=callbackEpoch.load();
+
+    if (epoch%2==1) {
+      while (callbackEpoch.load()==epoch) {
+        std::this_thread::yield();
+      }
+    }
   }
 }
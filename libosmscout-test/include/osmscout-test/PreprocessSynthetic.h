@@ -0,0 +1,133 @@
+#ifndef OSMSCOUT_IMPORT_PREPROCESS_SYNTHETIC_H
+#define OSMSCOUT_IMPORT_PREPROCESS_SYNTHETIC_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <osmscoutimport/Preprocessor.h>
+
+#include <osmscout/system/Compiler.h>
+
+#include <osmscout/util/GeoBox.h>
+
+#include <osmscout-test/TestImportExport.h>
+
+namespace osmscout {
+  namespace test {
+
+    /**
+     * Parameter of the generated synthetic map
+     */
+    struct OSMSCOUT_TEST_API SyntheticMapParameter
+    {
+      uint64_t    seed=1;                     //!< Seed of the pseudo random number generator
+      size_t      gridSize=16;                //!< Number of blocks in each direction
+      double      blockSize=0.002;            //!< Height of a block in degrees, the width is 1.5 times the height
+      GeoCoord    origin=GeoCoord(50.0,10.0); //!< South west corner of the street grid
+      std::string cityName="Synthetic City";  //!< Name of the administrative region
+      std::string postalCode="12345";         //!< Postal code of all streets and buildings
+      bool        routingRestrictions=false;  //!< Add oneway streets and turn restrictions
+      bool        multipolygons=false;        //!< Add multipolygon relations, some of them broken
+
+      GeoBox GetBoundingBox() const;
+      GeoCoord GetCrossing(size_t row,
+                           size_t column) const;
+      std::string GetStreetName(size_t row) const;
+      std::string GetAvenueName(size_t column) const;
+    };
+
+    /**
+     * Preprocessor generating a deterministic synthetic city instead of parsing a file.
+     *
+     * The city consists of a grid of primary and residential streets with shared nodes at
+     * all crossings, blocks filled with addressed buildings, woods or parks, POIs,
+     * a river and an administrative boundary. Optionally some streets are oneway and
+     * some crossings have turn restrictions, and a row of multipolygon relations south
+     * of the city is added, some of which cannot be assembled. For the same parameter
+     * (especially the same seed) exactly the same raw data is generated on all platforms,
+     * so the result can be used for reproducible tests and benchmarks.
+     */
+    class OSMSCOUT_TEST_API PreprocessSynthetic CLASS_FINAL : public Preprocessor
+    {
+    private:
+      PreprocessorCallback& callback;
+      SyntheticMapParameter mapParameter;
+      uint64_t              randomState;
+      TagId                 tagAdminLevel;
+      TagId                 tagAmenity;
+      TagId                 tagBoundary;
+      TagId                 tagBuilding;
+      TagId                 tagHighway;
+      TagId                 tagLanduse;
+      TagId                 tagLeisure;
+      TagId                 tagName;
+      TagId                 tagOneway;
+      TagId                 tagPlace;
+      TagId                 tagPostalCode;
+      TagId                 tagRestriction;
+      TagId                 tagType;
+      TagId                 tagWaterway;
+      TagId                 tagAddrCity;
+      TagId                 tagAddrPostcode;
+      TagId                 tagAddrStreet;
+      TagId                 tagAddrHousenumber;
+      OSMId                 nodeId;
+      OSMId                 wayId;
+      OSMId                 relationId;
+      std::vector<OSMId>    crossingIds; //!< Node ids of the street crossings, row by row
+
+    private:
+      uint64_t NextRandom();
+      size_t NextRandom(size_t limit);
+      double NextRandomDouble();
+
+      OSMId AddNode(PreprocessorCallback::RawBlockData& data,
+                    const GeoCoord& coord);
+      void AddArea(PreprocessorCallback::RawBlockData& data,
+                   const GeoBox& box,
+                   TagMap&& tags);
+
+      void GenerateStreets(PreprocessorCallback::RawBlockData& data);
+      void GenerateTurnRestrictions(PreprocessorCallback::RawBlockData& data,
+                                    const std::vector<OSMId>& streetIds,
+                                    const std::vector<OSMId>& avenueIds);
+      void GenerateBlock(PreprocessorCallback::RawBlockData& data,
+                         size_t row,
+                         size_t column);
+      void GenerateRiver(PreprocessorCallback::RawBlockData& data);
+      void GenerateMultipolygons(PreprocessorCallback::RawBlockData& data);
+      void GenerateCity(PreprocessorCallback::RawBlockData& data);
+
+    public:
+      PreprocessSynthetic(PreprocessorCallback& callback,
+                          const SyntheticMapParameter& mapParameter);
+
+      bool Import(const TypeConfigRef& typeConfig,
+                  const ImportParameter& parameter,
+                  Progress& progress,
+                  const std::string& filename) override;
+    };
+  }
+}
+
+#endif
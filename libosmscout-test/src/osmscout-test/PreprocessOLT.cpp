@@ -73,23 +73,28 @@ namespace osmscout {
 
         switch (region.GetPlaceType()) {
         case PlaceType::county:
-          nodeData.tags[tagPlace]="county";
+          nodeData.tags.Set(tagPlace,
+                            "county");
           break;
         case PlaceType::region:
-          nodeData.tags[tagPlace]="region";
+          nodeData.tags.Set(tagPlace,
+                            "region");
           break;
         case PlaceType::city:
-          nodeData.tags[tagPlace]="city";
+          nodeData.tags.Set(tagPlace,
+                            "city");
           break;
         case PlaceType::suburb:
-          nodeData.tags[tagPlace]="suburb";
+          nodeData.tags.Set(tagPlace,
+                            "suburb");
           break;
         case PlaceType::unknown:
           break;
         }
 
         if (!region.GetName().empty()) {
-          nodeData.tags[tagName]=region.GetName();
+          nodeData.tags.Set(tagName,
+                            region.GetName());
         }
 
         if (region.IsBoundary()) {
@@ -108,28 +113,35 @@ namespace osmscout {
 
         switch (region.GetPlaceType()) {
         case PlaceType::county:
-          wayData.tags[tagPlace]="county";
+          wayData.tags.Set(tagPlace,
+                           "county");
           break;
         case PlaceType::region:
-          wayData.tags[tagPlace]="region";
+          wayData.tags.Set(tagPlace,
+                           "region");
           break;
         case PlaceType::city:
-          wayData.tags[tagPlace]="city";
+          wayData.tags.Set(tagPlace,
+                           "city");
           break;
         case PlaceType::suburb:
-          wayData.tags[tagPlace]="suburb";
+          wayData.tags.Set(tagPlace,
+                           "suburb");
           break;
         case PlaceType::unknown:
           break;
         }
 
         if (!region.GetName().empty()) {
-          wayData.tags[tagName]=region.GetName();
+          wayData.tags.Set(tagName,
+                           region.GetName());
         }
 
         if (region.IsBoundary()) {
-          wayData.tags[tagBoundary]="administrative";
-          wayData.tags[tagAdminLevel]=std::to_string(region.GetAdminLevel());
+          wayData.tags.Set(tagBoundary,
+                           "administrative");
+          wayData.tags.Set(tagAdminLevel,
+                           std::to_string(region.GetAdminLevel()));
         }
 
         wayData.nodes.push_back(RegisterAndGetRawNodeId(data,box.GetTopLeft()));
@@ -172,11 +184,14 @@ namespace osmscout {
           locationData.nodes.push_back(RegisterAndGetRawNodeId(data,wayLeftCoord));
           locationData.nodes.push_back(RegisterAndGetRawNodeId(data,wayRightCoord));
 
-          locationData.tags[tagHighway]="residential";
-          locationData.tags[tagName]=location->GetName();
+          locationData.tags.Set(tagHighway,
+                                "residential");
+          locationData.tags.Set(tagName,
+                                location->GetName());
 
           if (!postalArea->GetName().empty()) {
-            locationData.tags[tagPostalCode]=postalArea->GetName();
+            locationData.tags.Set(tagPostalCode,
+                                  postalArea->GetName());
           }
 
           data->wayData.push_back(std::move(locationData));
@@ -189,18 +204,24 @@ namespace osmscout {
 
             progress.Info("Generating building '"+address->GetName()+"' "+std::to_string(buildingData.id)+"...");
 
-            buildingData.tags[tagBuilding]="yes";
-            buildingData.tags[tagAddrCity]=region.GetName();
+            buildingData.tags.Set(tagBuilding,
+                                  "yes");
+            buildingData.tags.Set(tagAddrCity,
+                                  region.GetName());
 
             if (!postalArea->GetName().empty()) {
-              buildingData.tags[tagAddrPostcode]=postalArea->GetName();
+              buildingData.tags.Set(tagAddrPostcode,
+                                    postalArea->GetName());
             }
 
-            buildingData.tags[tagAddrStreet]=location->GetName();
-            buildingData.tags[tagAddrHousenumber]=address->GetName();
+            buildingData.tags.Set(tagAddrStreet,
+                                  location->GetName());
+            buildingData.tags.Set(tagAddrHousenumber,
+                                  address->GetName());
 
             for (const auto& tag : address->GetTags()) {
-              buildingData.tags[typeConfig->GetTagId(tag.GetKey())]=tag.GetValue();
+              buildingData.tags.Set(typeConfig->GetTagId(tag.GetKey()),
+                                    tag.GetValue());
             }
 
             GeoBox buildingBox(GeoCoord(wayLeftCoord.GetLat()+0.0001,
@@ -0,0 +1,542 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout-test/PreprocessSynthetic.h>
+
+#include <array>
+
+namespace osmscout {
+  namespace test {
+
+    static const std::array<const char*,16> streetNames={
+      "Oak", "Elm", "Pine", "Maple", "Cedar", "Birch", "Willow", "Ash",
+      "Beech", "Alder", "Hazel", "Linden", "Poplar", "Rowan", "Spruce", "Walnut"
+    };
+
+    static const std::array<const char*,4> amenities={
+      "restaurant", "cafe", "school", "pharmacy"
+    };
+
+    static std::string GetName(size_t index,
+                               const std::string& suffix)
+    {
+      std::string name=streetNames[index%streetNames.size()];
+
+      if (index>=streetNames.size()) {
+        name+=" "+std::to_string(index/streetNames.size()+1);
+      }
+
+      return name+" "+suffix;
+    }
+
+    GeoBox SyntheticMapParameter::GetBoundingBox() const
+    {
+      return GeoBox(origin,
+                    GeoCoord(origin.GetLat()+gridSize*blockSize,
+                             origin.GetLon()+gridSize*blockSize*1.5));
+    }
+
+    GeoCoord SyntheticMapParameter::GetCrossing(size_t row,
+                                                size_t column) const
+    {
+      return GeoCoord(origin.GetLat()+row*blockSize,
+                      origin.GetLon()+column*blockSize*1.5);
+    }
+
+    std::string SyntheticMapParameter::GetStreetName(size_t row) const
+    {
+      return GetName(row,"Street");
+    }
+
+    std::string SyntheticMapParameter::GetAvenueName(size_t column) const
+    {
+      return GetName(column,"Avenue");
+    }
+
+    PreprocessSynthetic::PreprocessSynthetic(PreprocessorCallback& callback,
+                                             const SyntheticMapParameter& mapParameter)
+      : callback(callback),
+        mapParameter(mapParameter),
+        randomState(mapParameter.seed)
+    {
+      // no code
+    }
+
+    /**
+     * SplitMix64, we do not use the std random distributions, because their
+     * results are implementation specific.
+     */
+    uint64_t PreprocessSynthetic::NextRandom()
+    {
+      randomState+=0x9e3779b97f4a7c15ULL;
+
+      uint64_t z=randomState;
+
+      z=(z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+      z=(z ^ (z >> 27))*0x94d049bb133111ebULL;
+
+      return z ^ (z >> 31);
+    }
+
+    size_t PreprocessSynthetic::NextRandom(size_t limit)
+    {
+      return static_cast<size_t>(NextRandom()%limit);
+    }
+
+    double PreprocessSynthetic::NextRandomDouble()
+    {
+      return static_cast<double>(NextRandom() >> 11)/9007199254740992.0;
+    }
+
+    OSMId PreprocessSynthetic::AddNode(PreprocessorCallback::RawBlockData& data,
+                                       const GeoCoord& coord)
+    {
+      OSMId id=nodeId++;
+
+      data.nodeData.emplace_back(id,coord);
+
+      return id;
+    }
+
+    void PreprocessSynthetic::AddArea(PreprocessorCallback::RawBlockData& data,
+                                      const GeoBox& box,
+                                      TagMap&& tags)
+    {
+      PreprocessorCallback::RawWayData wayData;
+
+      wayData.id=wayId++;
+      wayData.tags=std::move(tags);
+
+      wayData.nodes.push_back(AddNode(data,box.GetBottomLeft()));
+      wayData.nodes.push_back(AddNode(data,box.GetBottomRight()));
+      wayData.nodes.push_back(AddNode(data,box.GetTopRight()));
+      wayData.nodes.push_back(AddNode(data,box.GetTopLeft()));
+      wayData.nodes.push_back(wayData.nodes.front());
+
+      data.wayData.push_back(std::move(wayData));
+    }
+
+    /**
+     * Streets run west to east, avenues south to north. Every fourth of them is
+     * a primary road. All crossings share their node, so the result is routable.
+     *
+     * If routing restrictions are requested, the residential streets and avenues following
+     * a primary road are oneway (streets eastwards, avenues northwards), the ones before a
+     * primary road are oneway in the opposite direction.
+     */
+    void PreprocessSynthetic::GenerateStreets(PreprocessorCallback::RawBlockData& data)
+    {
+      size_t crossingCount=mapParameter.gridSize+1;
+
+      crossingIds.clear();
+      crossingIds.reserve(crossingCount*crossingCount);
+
+      for (size_t row=0; row<crossingCount; row++) {
+        for (size_t column=0; column<crossingCount; column++) {
+          crossingIds.push_back(AddNode(data,mapParameter.GetCrossing(row,column)));
+        }
+      }
+
+      std::vector<OSMId> streetIds;
+      std::vector<OSMId> avenueIds;
+
+      auto setOneway=[this](TagMap& tags,
+                            size_t index) {
+        if (!mapParameter.routingRestrictions) {
+          return;
+        }
+
+        if (index%4==1) {
+          tags.Set(tagOneway,
+                   "yes");
+        }
+        else if (index%4==3) {
+          tags.Set(tagOneway,
+                   "-1");
+        }
+      };
+
+      for (size_t row=0; row<crossingCount; row++) {
+        PreprocessorCallback::RawWayData wayData;
+
+        wayData.id=wayId++;
+        wayData.tags.Set(tagHighway,
+                         row%4==0 ? "primary" : "residential");
+        wayData.tags.Set(tagName,
+                         mapParameter.GetStreetName(row));
+        wayData.tags.Set(tagPostalCode,
+                         mapParameter.postalCode);
+        setOneway(wayData.tags,
+                  row);
+
+        streetIds.push_back(wayData.id);
+
+        for (size_t column=0; column<crossingCount; column++) {
+          wayData.nodes.push_back(crossingIds[row*crossingCount+column]);
+        }
+
+        data.wayData.push_back(std::move(wayData));
+      }
+
+      for (size_t column=0; column<crossingCount; column++) {
+        PreprocessorCallback::RawWayData wayData;
+
+        wayData.id=wayId++;
+        wayData.tags.Set(tagHighway,
+                         column%4==0 ? "primary" : "residential");
+        wayData.tags.Set(tagName,
+                         mapParameter.GetAvenueName(column));
+        wayData.tags.Set(tagPostalCode,
+                         mapParameter.postalCode);
+        setOneway(wayData.tags,
+                  column);
+
+        avenueIds.push_back(wayData.id);
+
+        for (size_t row=0; row<crossingCount; row++) {
+          wayData.nodes.push_back(crossingIds[row*crossingCount+column]);
+        }
+
+        data.wayData.push_back(std::move(wayData));
+      }
+
+      if (mapParameter.routingRestrictions) {
+        GenerateTurnRestrictions(data,
+                                 streetIds,
+                                 avenueIds);
+      }
+    }
+
+    /**
+     * At every crossing of two primary roads, turning left from the street into the
+     * avenue is forbidden.
+     */
+    void PreprocessSynthetic::GenerateTurnRestrictions(PreprocessorCallback::RawBlockData& data,
+                                                       const std::vector<OSMId>& streetIds,
+                                                       const std::vector<OSMId>& avenueIds)
+    {
+      size_t crossingCount=mapParameter.gridSize+1;
+
+      for (size_t row=0; row<crossingCount; row+=4) {
+        for (size_t column=0; column<crossingCount; column+=4) {
+          PreprocessorCallback::RawRelationData relationData;
+
+          relationData.id=relationId++;
+          relationData.tags.Set(tagType,
+                                "restriction");
+          relationData.tags.Set(tagRestriction,
+                                "no_left_turn");
+
+          relationData.members.push_back(RawRelation::Member{RawRelation::memberWay,
+                                                             streetIds[row],
+                                                             "from"});
+          relationData.members.push_back(RawRelation::Member{RawRelation::memberNode,
+                                                             crossingIds[row*crossingCount+column],
+                                                             "via"});
+          relationData.members.push_back(RawRelation::Member{RawRelation::memberWay,
+                                                             avenueIds[column],
+                                                             "to"});
+
+          data.relationData.push_back(std::move(relationData));
+        }
+      }
+    }
+
+    /**
+     * A block is either a wood, a park or two rows of buildings, addressed to the
+     * street south respectively north of the block. Some blocks get a POI in addition.
+     */
+    void PreprocessSynthetic::GenerateBlock(PreprocessorCallback::RawBlockData& data,
+                                            size_t row,
+                                            size_t column)
+    {
+      GeoCoord southWest=mapParameter.GetCrossing(row,column);
+      GeoCoord northEast=mapParameter.GetCrossing(row+1,column+1);
+      double   height=northEast.GetLat()-southWest.GetLat();
+      double   width=northEast.GetLon()-southWest.GetLon();
+      GeoBox   inner(GeoCoord(southWest.GetLat()+0.1*height,
+                              southWest.GetLon()+0.1*width),
+                     GeoCoord(northEast.GetLat()-0.1*height,
+                              northEast.GetLon()-0.1*width));
+      size_t   kind=NextRandom(10);
+
+      if (kind==0) {
+        TagMap tags;
+
+        tags.Set(tagLanduse,
+                 "forest");
+
+        AddArea(data,inner,std::move(tags));
+      }
+      else if (kind==1) {
+        TagMap tags;
+
+        tags.Set(tagLeisure,
+                 "park");
+        tags.Set(tagName,
+                 mapParameter.GetAvenueName(column)+" Park");
+
+        AddArea(data,inner,std::move(tags));
+      }
+      else {
+        for (size_t side=0; side<2; side++) {
+          size_t buildingCount=2+NextRandom(4);
+          double slotWidth=inner.GetWidth()/buildingCount;
+          size_t streetRow=side==0 ? row : row+1;
+
+          for (size_t building=0; building<buildingCount; building++) {
+            double depth=(0.25+0.15*NextRandomDouble())*inner.GetHeight();
+            double minLon=inner.GetMinLon()+building*slotWidth+0.1*slotWidth;
+            double maxLon=inner.GetMinLon()+(building+1)*slotWidth-0.1*slotWidth;
+            GeoBox box=side==0 ? GeoBox(GeoCoord(inner.GetMinLat(),minLon),
+                                        GeoCoord(inner.GetMinLat()+depth,maxLon))
+                               : GeoBox(GeoCoord(inner.GetMaxLat()-depth,minLon),
+                                        GeoCoord(inner.GetMaxLat(),maxLon));
+            TagMap tags;
+
+            tags.Set(tagBuilding,
+                     "yes");
+            tags.Set(tagAddrCity,
+                     mapParameter.cityName);
+            tags.Set(tagAddrPostcode,
+                     mapParameter.postalCode);
+            tags.Set(tagAddrStreet,
+                     mapParameter.GetStreetName(streetRow));
+            // Even numbers north of the street, odd numbers south of it
+            tags.Set(tagAddrHousenumber,
+                     std::to_string(2*(column*8+building)+(side==0 ? 2 : 1)));
+
+            AddArea(data,box,std::move(tags));
+          }
+        }
+      }
+
+      if (NextRandom(3)==0) {
+        PreprocessorCallback::RawNodeData nodeData;
+        std::string                       amenity=amenities[NextRandom(amenities.size())];
+
+        nodeData.id=nodeId++;
+        nodeData.coord=GeoCoord(inner.GetMinLat()+(0.4+0.2*NextRandomDouble())*inner.GetHeight(),
+                                inner.GetMinLon()+(0.2+0.6*NextRandomDouble())*inner.GetWidth());
+        nodeData.tags.Set(tagAmenity,
+                          amenity);
+        nodeData.tags.Set(tagName,
+                          mapParameter.GetAvenueName(column)+" "+amenity+" "+std::to_string(row+1));
+
+        data.nodeData.push_back(std::move(nodeData));
+      }
+    }
+
+    /**
+     * A river meandering from west to east through the middle of the city
+     */
+    void PreprocessSynthetic::GenerateRiver(PreprocessorCallback::RawBlockData& data)
+    {
+      PreprocessorCallback::RawWayData wayData;
+      GeoBox                           box=mapParameter.GetBoundingBox();
+      size_t                           segmentCount=2*mapParameter.gridSize+2;
+      double                           lat=box.GetCenter().GetLat()+0.5*mapParameter.blockSize;
+
+      wayData.id=wayId++;
+      wayData.tags.Set(tagWaterway,
+                       "river");
+      wayData.tags.Set(tagName,
+                       mapParameter.cityName+" River");
+
+      for (size_t segment=0; segment<=segmentCount; segment++) {
+        double lon=box.GetMinLon()+(segment-1.0)*box.GetWidth()/(segmentCount-2);
+        double offset=(NextRandomDouble()-0.5)*0.6*mapParameter.blockSize;
+
+        wayData.nodes.push_back(AddNode(data,GeoCoord(lat+offset,lon)));
+      }
+
+      data.wayData.push_back(std::move(wayData));
+    }
+
+    /**
+     * A row of forests south of the city, each a multipolygon relation with an outer ring
+     * split into two ways and an inner ring. The outer ring of every fourth relation has a
+     * gap and every fourth relation references a way that does not exist, so these cannot
+     * be assembled. No random numbers are drawn, so the rest of the map is unchanged.
+     */
+    void PreprocessSynthetic::GenerateMultipolygons(PreprocessorCallback::RawBlockData& data)
+    {
+      double size=mapParameter.blockSize;
+      double lat=mapParameter.origin.GetLat()-2*size;
+
+      for (size_t index=0; index<mapParameter.gridSize; index++) {
+        double                                lon=mapParameter.origin.GetLon()+index*1.5*size;
+        OSMId                                 northWest=AddNode(data,GeoCoord(lat+size,lon));
+        OSMId                                 southEast=AddNode(data,GeoCoord(lat,lon+size));
+        PreprocessorCallback::RawWayData      southWay;
+        PreprocessorCallback::RawWayData      northWay;
+        PreprocessorCallback::RawRelationData relationData;
+
+        southWay.id=wayId++;
+        southWay.nodes.push_back(northWest);
+        southWay.nodes.push_back(AddNode(data,GeoCoord(lat,lon)));
+        southWay.nodes.push_back(southEast);
+
+        northWay.id=wayId++;
+        northWay.nodes.push_back(southEast);
+        northWay.nodes.push_back(AddNode(data,GeoCoord(lat+size,lon+size)));
+
+        if (index%4==1) {
+          // Ends next to the first node of the south way
+          northWay.nodes.push_back(AddNode(data,GeoCoord(lat+size,lon+0.1*size)));
+        }
+        else {
+          northWay.nodes.push_back(northWest);
+        }
+
+        relationData.id=relationId++;
+        relationData.tags.Set(tagType,
+                              "multipolygon");
+        relationData.tags.Set(tagLanduse,
+                              "forest");
+        relationData.tags.Set(tagName,
+                              mapParameter.cityName+" Forest "+std::to_string(index+1));
+
+        relationData.members.push_back(RawRelation::Member{RawRelation::memberWay,
+                                                           southWay.id,
+                                                           "outer"});
+        relationData.members.push_back(RawRelation::Member{RawRelation::memberWay,
+                                                           northWay.id,
+                                                           "outer"});
+
+        data.wayData.push_back(std::move(southWay));
+        data.wayData.push_back(std::move(northWay));
+
+        if (index%4==3) {
+          relationData.members.push_back(RawRelation::Member{RawRelation::memberWay,
+                                                             wayId+1000000,
+                                                             "inner"});
+        }
+        else {
+          PreprocessorCallback::RawWayData innerWay;
+
+          innerWay.id=wayId++;
+          innerWay.nodes.push_back(AddNode(data,GeoCoord(lat+0.3*size,lon+0.3*size)));
+          innerWay.nodes.push_back(AddNode(data,GeoCoord(lat+0.3*size,lon+0.7*size)));
+          innerWay.nodes.push_back(AddNode(data,GeoCoord(lat+0.7*size,lon+0.7*size)));
+          innerWay.nodes.push_back(AddNode(data,GeoCoord(lat+0.7*size,lon+0.3*size)));
+          innerWay.nodes.push_back(innerWay.nodes.front());
+
+          relationData.members.push_back(RawRelation::Member{RawRelation::memberWay,
+                                                             innerWay.id,
+                                                             "inner"});
+
+          data.wayData.push_back(std::move(innerWay));
+        }
+
+        data.relationData.push_back(std::move(relationData));
+      }
+    }
+
+    void PreprocessSynthetic::GenerateCity(PreprocessorCallback::RawBlockData& data)
+    {
+      GeoBox box=mapParameter.GetBoundingBox();
+      double margin=0.5*mapParameter.blockSize;
+      TagMap tags;
+
+      tags.Set(tagBoundary,
+               "administrative");
+      tags.Set(tagAdminLevel,
+               "8");
+      tags.Set(tagName,
+               mapParameter.cityName);
+
+      AddArea(data,
+              GeoBox(GeoCoord(box.GetMinLat()-margin,box.GetMinLon()-margin),
+                     GeoCoord(box.GetMaxLat()+margin,box.GetMaxLon()+margin)),
+              std::move(tags));
+
+      PreprocessorCallback::RawNodeData nodeData;
+
+      nodeData.id=nodeId++;
+      nodeData.coord=box.GetCenter();
+      nodeData.tags.Set(tagPlace,
+                        "city");
+      nodeData.tags.Set(tagName,
+                        mapParameter.cityName);
+
+      data.nodeData.push_back(std::move(nodeData));
+    }
+
+    bool PreprocessSynthetic::Import(const TypeConfigRef& typeConfig,
+                                     const ImportParameter& /*parameter*/,
+                                     Progress& progress,
+                                     const std::string& /*filename*/)
+    {
+      progress.SetAction("Generating synthetic map with seed "+std::to_string(mapParameter.seed));
+
+      if (mapParameter.gridSize==0) {
+        progress.Error("Grid size of synthetic map must not be 0");
+        return false;
+      }
+
+      tagAdminLevel=typeConfig->GetTagId("admin_level");
+      tagAmenity=typeConfig->GetTagId("amenity");
+      tagBoundary=typeConfig->GetTagId("boundary");
+      tagBuilding=typeConfig->GetTagId("building");
+      tagHighway=typeConfig->GetTagId("highway");
+      tagLanduse=typeConfig->GetTagId("landuse");
+      tagLeisure=typeConfig->GetTagId("leisure");
+      tagName=typeConfig->GetTagId("name");
+      tagOneway=typeConfig->GetTagId("oneway");
+      tagPlace=typeConfig->GetTagId("place");
+      tagPostalCode=typeConfig->GetTagId("postal_code");
+      tagRestriction=typeConfig->GetTagId("restriction");
+      tagType=typeConfig->GetTagId("type");
+      tagWaterway=typeConfig->GetTagId("waterway");
+      tagAddrCity=typeConfig->GetTagId("addr:city");
+      tagAddrPostcode=typeConfig->GetTagId("addr:postcode");
+      tagAddrStreet=typeConfig->GetTagId("addr:street");
+      tagAddrHousenumber=typeConfig->GetTagId("addr:housenumber");
+
+      randomState=mapParameter.seed;
+      nodeId=1;
+      wayId=1;
+      relationId=1;
+
+      PreprocessorCallback::RawBlockDataRef data=std::make_shared<PreprocessorCallback::RawBlockData>();
+
+      GenerateCity(*data);
+      GenerateStreets(*data);
+
+      for (size_t row=0; row<mapParameter.gridSize; row++) {
+        for (size_t column=0; column<mapParameter.gridSize; column++) {
+          GenerateBlock(*data,row,column);
+        }
+      }
+
+      GenerateRiver(*data);
+
+      if (mapParameter.multipolygons) {
+        GenerateMultipolygons(*data);
+      }
+
+      progress.Info("Generated "+std::to_string(data->nodeData.size())+" nodes, "+std::to_string(data->wayData.size())+" ways and "+std::to_string(data->relationData.size())+" relations");
+
+      callback.ProcessBlock(std::move(data));
+
+      return true;
+    }
+  }
+}
@@ -20,15 +20,22 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
+#include <deque>
+#include <initializer_list>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <osmscout/lib/CoreImportExport.h>
 
+#include <osmscout/util/MemoryArena.h>
 #include <osmscout/util/Parsing.h>
 
 #include <osmscout/system/Compiler.h>
@@ -38,7 +45,130 @@ namespace osmscout {
 
   using TagId = uint16_t;
 
-  using TagMap = std::unordered_map<TagId, std::string>;
+  /**
+   * \ingroup type
+   *
+   * Hash for string keyed containers, that allows lookup by std::string_view
+   * without constructing a std::string
+   */
+  struct TagValueHash
+  {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view value) const
+    {
+      return std::hash<std::string_view>{}(value);
+    }
+  };
+
+  /**
+   * \ingroup type
+   *
+   * The tags of an object as a flat list of tag ids and values. Objects only have a few
+   * tags, so a linear search is faster than hashing (and does not allocate per tag).
+   *
+   * Values are std::string_views. Set() copies the value into storage owned by the map.
+   * SetView() only stores the view, the caller has to make sure that the value outlives
+   * the map, e.g. by storing it in a TagValuePool. Using the pool as memory resource for
+   * the map, too, tags can be collected without any heap allocation per object.
+   */
+  class OSMSCOUT_API TagMap CLASS_FINAL
+  {
+  public:
+    using value_type     = std::pair<TagId,std::string_view>;
+    using const_iterator = std::pmr::vector<value_type>::const_iterator;
+    using iterator       = const_iterator;
+
+  private:
+    std::pmr::vector<value_type>             entries;
+    std::unique_ptr<std::deque<std::string>> ownedValues; //!< Values copied by Set(), a deque keeps them in place
+
+  public:
+    TagMap() = default;
+    explicit TagMap(std::pmr::memory_resource* resource);
+    TagMap(std::initializer_list<std::pair<TagId,std::string_view>> tags);
+    TagMap(const TagMap& other);
+    TagMap(TagMap&& other) noexcept = default;
+    ~TagMap() = default;
+
+    TagMap& operator=(const TagMap& other);
+    TagMap& operator=(TagMap&& other) = default;
+
+    const_iterator begin() const
+    {
+      return entries.begin();
+    }
+
+    const_iterator end() const
+    {
+      return entries.end();
+    }
+
+    size_t size() const
+    {
+      return entries.size();
+    }
+
+    bool empty() const
+    {
+      return entries.empty();
+    }
+
+    const_iterator find(TagId tag) const
+    {
+      return std::find_if(entries.begin(),
+                          entries.end(),
+                          [tag](const value_type& entry) {
+                            return entry.first==tag;
+                          });
+    }
+
+    bool contains(TagId tag) const
+    {
+      return find(tag)!=end();
+    }
+
+    void reserve(size_t size)
+    {
+      entries.reserve(size);
+    }
+
+    size_t erase(TagId tag);
+    void clear();
+
+    void Set(TagId tag,
+             std::string_view value);
+    void SetView(TagId tag,
+                 std::string_view value);
+  };
+
+  /**
+   * \ingroup type
+   *
+   * Storage for the tag values of a number of objects, like the objects of one block
+   * of a *.osm.pbf file. Values are interned, so frequent values like "yes" are stored
+   * once. The pool also is the memory resource for the TagMaps referencing its values
+   * and must outlive them. The pool is not thread safe.
+   */
+  class OSMSCOUT_API TagValuePool CLASS_FINAL
+  {
+  private:
+    MemoryArena                                                           arena;
+    std::pmr::unordered_set<std::string_view,TagValueHash,std::equal_to<>> values;
+
+  public:
+    TagValuePool();
+
+    TagValuePool(const TagValuePool&) = delete;
+    TagValuePool& operator=(const TagValuePool&) = delete;
+
+    std::string_view Intern(std::string_view value);
+
+    std::pmr::memory_resource* GetResource()
+    {
+      return &arena;
+    }
+  };
 
   /**
    * \ingroup type
@@ -80,6 +210,11 @@ namespace osmscout {
   public:
     explicit TagNotCondition(const TagConditionRef& condition);
 
+    const TagConditionRef& GetCondition() const
+    {
+      return condition;
+    }
+
     bool Evaluate(const TagMap& tagMap) const override
     {
       return !condition->Evaluate(tagMap);
@@ -109,6 +244,16 @@ namespace osmscout {
 
     void AddCondition(const TagConditionRef& condition);
 
+    Type GetType() const
+    {
+      return type;
+    }
+
+    const std::list<TagConditionRef>& GetConditions() const
+    {
+      return conditions;
+    }
+
     bool Evaluate(const TagMap& tagMap) const override;
   };
 
@@ -132,6 +277,11 @@ namespace osmscout {
   public:
     explicit TagExistsCondition(TagId tag);
 
+    TagId GetTag() const
+    {
+      return tag;
+    }
+
     bool Evaluate(const TagMap& tagMap) const override
     {
       return tagMap.find(tag)!=tagMap.end();
@@ -167,6 +317,29 @@ namespace osmscout {
                        BinaryOperator binaryOperator,
                        const size_t& tagValue);
 
+    TagId GetTag() const
+    {
+      return tag;
+    }
+
+    BinaryOperator GetOperator() const
+    {
+      return binaryOperator;
+    }
+
+    /**
+     * Returns true, if the tag value is compared as string (and not as number)
+     */
+    bool IsStringComparison() const
+    {
+      return valueType==string;
+    }
+
+    const std::string& GetStringValue() const
+    {
+      return tagStringValue;
+    }
+
     bool Evaluate(const TagMap& tagMap) const override;
   };
 
@@ -179,14 +352,24 @@ namespace osmscout {
   class OSMSCOUT_API TagIsInCondition : public TagCondition
   {
   private:
-    TagId                           tag;
-    std::unordered_set<std::string> tagValues;
+    TagId                                                        tag;
+    std::unordered_set<std::string,TagValueHash,std::equal_to<>> tagValues;
 
   public:
     explicit TagIsInCondition(TagId tag);
 
     void AddTagValue(const std::string& tagValue);
 
+    TagId GetTag() const
+    {
+      return tag;
+    }
+
+    const std::unordered_set<std::string,TagValueHash,std::equal_to<>>& GetTagValues() const
+    {
+      return tagValues;
+    }
+
     bool Evaluate(const TagMap& tagMap) const override;
   };
 
@@ -0,0 +1,111 @@
+#ifndef OSMSCOUT_TYPECONDITIONINDEX_H
+#define OSMSCOUT_TYPECONDITIONINDEX_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/Tag.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  class TypeInfo;
+
+  /**
+   * \ingroup type
+   *
+   * Index over the conditions of all types for one kind of object (nodes, ways/areas,...).
+   * It returns the same first matching condition as evaluating the conditions of all
+   * types in order, but only touches conditions that can match the given tags.
+   *
+   * For every condition the index derives the tags (or tag values) of which at least one
+   * must be present for the condition to be fulfilled. Conditions are registered under
+   * these tag ids and values. A lookup then only visits the conditions registered for
+   * the tags of the object. If the condition is fully described by the tags (a plain
+   * value equality or existence check, or an "or" of them), a hit already proves the
+   * condition, else the condition itself is evaluated. Conditions that cannot be
+   * indexed (like negations) are evaluated for every object.
+   *
+   * The index does not track later changes of the types or their conditions and has to
+   * be rebuilt in this case.
+   */
+  class OSMSCOUT_API TypeConditionIndex CLASS_FINAL
+  {
+  public:
+    struct Rule
+    {
+      std::shared_ptr<TypeInfo> type;      //!< The type the condition belongs to
+      unsigned char             types;     //!< Bitset of object types the condition applies to
+      TagConditionRef           condition; //!< The root condition
+      bool                      exact;     //!< A hit in the index proves the condition
+    };
+
+  private:
+    using RuleList = std::vector<uint32_t>; //!< Rule indexes in ascending order
+
+    struct TagEntry
+    {
+      RuleList                                                             rules;      //!< Rules hit by the existence of the tag
+      std::unordered_map<std::string,RuleList,TagValueHash,std::equal_to<>> valueRules; //!< Rules hit by a certain value of the tag
+    };
+
+    std::vector<Rule>     rules;
+    std::vector<TagEntry> tagEntries;     //!< Index is the TagId
+    RuleList              unindexedRules; //!< Rules to evaluate for every object
+    bool                  built=false;
+
+  private:
+    void AddRule(const std::shared_ptr<TypeInfo>& type,
+                 unsigned char types,
+                 const TagConditionRef& condition);
+
+  public:
+    void Build(const std::vector<std::shared_ptr<TypeInfo>>& types,
+               unsigned char objectTypes);
+    void Clear();
+
+    bool IsBuilt() const
+    {
+      return built;
+    }
+
+    size_t GetRuleCount() const
+    {
+      return rules.size();
+    }
+
+    size_t GetUnindexedRuleCount() const
+    {
+      return unindexedRules.size();
+    }
+
+    const Rule* Match(const TagMap& tagMap) const;
+  };
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include <osmscout/ObjectRef.h>
 #include <osmscout/OSMScoutTypes.h>
 #include <osmscout/Tag.h>
+#include <osmscout/TypeConditionIndex.h>
 #include <osmscout/TypeFeature.h>
 
 #include <osmscout/util/TagErrorReporter.h>
@@ -1041,7 +1042,7 @@ namespace osmscout {
   // Forward declaration
   class TypeConfig;
 
-  static const uint32_t FILE_FORMAT_VERSION=25;
+  static const uint32_t FILE_FORMAT_VERSION=26;
 
   /**
    * \ingroup type
@@ -1053,7 +1054,7 @@ namespace osmscout {
   {
   public:
     static const char* FILE_TYPES_DAT;
-    static const uint32_t MIN_FORMAT_VERSION = FILE_FORMAT_VERSION;
+    static const uint32_t MIN_FORMAT_VERSION = 25; //!< Version 26 only added the block coordinate encoding
     static const uint32_t MAX_FORMAT_VERSION = FILE_FORMAT_VERSION;
 
   private:
@@ -1076,6 +1077,11 @@ namespace osmscout {
 
     std::unordered_map<std::string,TypeInfoRef> nameToTypeMap;
 
+    TypeConditionIndex                          nodeConditionIndex;
+    TypeConditionIndex                          wayAreaConditionIndex;
+    TypeConditionIndex                          multipolygonConditionIndex;
+    TypeConditionIndex                          relationConditionIndex;
+
     // Features
 
     std::vector<FeatureRef>                     features;
@@ -1331,6 +1337,14 @@ namespace osmscout {
      */
     TypeInfoRef GetTypeInfo(const std::string& name) const;
 
+    /**
+     * Builds an index over the conditions of all types, that speeds up GetNodeType(),
+     * GetWayAreaType() and GetRelationType(). It is automatically built after loading
+     * the types from an OST file. If types or their conditions get changed afterwards,
+     * the index must be rebuilt (registering a type drops it).
+     */
+    void BuildConditionIndex();
+
     /**
      * Return a node type (or an invalid reference if no type got detected)
      * based on the given map of tag and tag values. The method iterates over all
@@ -0,0 +1,93 @@
+#ifndef OSMSCOUT_UTIL_ATOMICSHAREDPTR_H
+#define OSMSCOUT_UTIL_ATOMICSHAREDPTR_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <atomic>
+#include <memory>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Concurrency
+   *
+   * A std::shared_ptr, that can be loaded and replaced concurrently by multiple threads.
+   *
+   * Used to publish immutable snapshots of some state: writers build a new snapshot
+   * and store it, readers load the current snapshot and can work with it for as long
+   * as they like without blocking writers or other readers.
+   *
+   * Uses std::atomic<std::shared_ptr<T>> if the standard library supports it and the
+   * atomic access functions for std::shared_ptr otherwise.
+   *
+   * @tparam T type of the referenced object
+   */
+  template<typename T>
+  class AtomicSharedPtr
+  {
+  private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<T>> pointer;
+#else
+    std::shared_ptr<T>              pointer;
+#endif
+
+  public:
+    AtomicSharedPtr() = default;
+
+    explicit AtomicSharedPtr(std::shared_ptr<T> pointer)
+    : pointer(std::move(pointer))
+    {
+      // no code
+    }
+
+    AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    std::shared_ptr<T> Load() const
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+      return pointer.load();
+#else
+      return std::atomic_load(&pointer);
+#endif
+    }
+
+    void Store(std::shared_ptr<T> value)
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+      pointer.store(std::move(value));
+#else
+      std::atomic_store(&pointer,std::move(value));
+#endif
+    }
+
+    std::shared_ptr<T> Exchange(std::shared_ptr<T> value)
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+      return pointer.exchange(std::move(value));
+#else
+      return std::atomic_exchange(&pointer,std::move(value));
+#endif
+    }
+  };
+}
+
+#endif
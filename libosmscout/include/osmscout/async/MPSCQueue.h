@@ -0,0 +1,114 @@
+#ifndef OSMSCOUT_UTIL_MPSCQUEUE_H
+#define OSMSCOUT_UTIL_MPSCQUEUE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <atomic>
+#include <optional>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Concurrency
+   *
+   * An unbounded, lock-free queue with FIFO semantics for multiple producers and
+   * exactly one consumer (the node based algorithm of Dmitry Vyukov).
+   *
+   * Pushing never blocks and costs one allocation and one atomic exchange. In contrast
+   * to the ProcessingQueue, TryPop() does not wait for data, the consumer has to be
+   * woken up by other means. An element, whose Push() has not finished yet, may not
+   * be visible to TryPop() even if elements pushed later by other threads are.
+   *
+   * @tparam T Type of the queue content
+   */
+  template<typename T>
+  class MPSCQueue
+  {
+  private:
+    struct Node
+    {
+      std::atomic<Node*> next{nullptr};
+      std::optional<T>   value;
+    };
+
+  private:
+    std::atomic<Node*> head; //!< Last pushed node, producers append here
+    Node*              tail; //!< Dummy node before the next node to pop, only used by the consumer
+
+  public:
+    MPSCQueue()
+    : head(new Node()),
+      tail(head.load())
+    {
+      // no code
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    ~MPSCQueue()
+    {
+      while (tail!=nullptr) {
+        Node* next=tail->next.load(std::memory_order_relaxed);
+
+        delete tail;
+        tail=next;
+      }
+    }
+
+    /**
+     * Append the given value to the queue. Can be called by any thread.
+     */
+    void Push(T value)
+    {
+      Node* node=new Node();
+
+      node->value=std::move(value);
+
+      Node* previous=head.exchange(node,std::memory_order_acq_rel);
+
+      previous->next.store(node,std::memory_order_release);
+    }
+
+    /**
+     * Return and remove the first element of the queue or an empty value, if there is
+     * no (completely pushed) element. Must only be called by the consumer thread.
+     */
+    std::optional<T> TryPop()
+    {
+      Node* next=tail->next.load(std::memory_order_acquire);
+
+      if (next==nullptr) {
+        return std::nullopt;
+      }
+
+      std::optional<T> value=std::move(next->value);
+
+      next->value.reset();
+
+      delete tail;
+      tail=next;
+
+      return value;
+    }
+  };
+}
+
+#endif
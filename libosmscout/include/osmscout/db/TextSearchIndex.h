@@ -21,6 +21,7 @@
  */
 
 #include <unordered_map>
+#include <vector>
 
 #include <osmscout/ObjectRef.h>
 
@@ -33,7 +34,12 @@ namespace osmscout
   /**
    \ingroup Database
    A class that allows prefix-based searching
-   of text data indexed during import
+   of text data indexed during import.
+
+   Besides the exact prefix search, a typo-tolerant search
+   is offered, that traverses the indexed texts bounded by the
+   Levenshtein distance to the query. For the typo-tolerant search
+   all tries are searched in parallel.
    */
   class OSMSCOUT_API TextSearchIndex final
   {
@@ -54,6 +60,16 @@ namespace osmscout
   public:
     using ResultsMap = std::unordered_map<std::string, std::vector<ObjectFileRef> >;
 
+    /**
+     * A ranked result of a fuzzy search
+     */
+    struct FuzzyResult
+    {
+      std::string                text;       //!< The indexed text
+      size_t                     distance=0; //!< Edit distance between the query and the best matching prefix of text
+      std::vector<ObjectFileRef> refs;       //!< All objects indexed with the given text
+    };
+
     TextSearchIndex() = default;
 
     ~TextSearchIndex();
@@ -68,11 +84,37 @@ namespace osmscout
                 bool transliterate,
                 ResultsMap& results) const;
 
+    static size_t GetDefaultMaxDistance(const std::string& query);
+
+    bool SearchFuzzy(const std::string& query,
+                     bool searchPOIs,
+                     bool searchLocations,
+                     bool searchRegions,
+                     bool searchOther,
+                     bool transliterate,
+                     size_t maxDistance,
+                     size_t limit,
+                     std::vector<FuzzyResult>& results) const;
+
   private:
     void splitSearchResult(const std::string& result,
                            std::string& text,
                            ObjectFileRef& ref) const;
 
+    std::vector<size_t> GetSearchTries(bool searchPOIs,
+                                       bool searchLocations,
+                                       bool searchRegions,
+                                       bool searchOther) const;
+
+    bool SearchTrie(const TrieInfo& trie,
+                    const std::string& lookupStr,
+                    ResultsMap& results) const;
+
+    bool SearchTrieFuzzy(size_t trieIndex,
+                         const std::string& lookupStr,
+                         size_t maxDistance,
+                         size_t limit,
+                         std::vector<FuzzyResult>& results) const;
 
     uint8_t               offsetSizeBytes;  //! size in bytes of FileOffsets stored in the tries
     std::vector<TrieInfo> tries;
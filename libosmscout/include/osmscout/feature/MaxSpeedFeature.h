@@ -74,7 +74,7 @@ namespace osmscout {
                      const TagRegistry& tagRegistry,
                      const ObjectOSMRef& object,
                      const TagMap& tags,
-                     const std::string& input,
+                     std::string_view input,
                      uint8_t& speed) const;
 
   public:
@@ -0,0 +1,122 @@
+#ifndef OSMSCOUT_BLOCKCOORDENCODING_H
+#define OSMSCOUT_BLOCKCOORDENCODING_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/Point.h>
+
+namespace osmscout {
+
+  /**
+   * \defgroup BlockCoordEncoding Block coordinate encoding
+   *
+   * Encoding of the coordinate deltas of a std::vector<Point>, that is used by the
+   * FileWriter, if it is enabled (see FileWriter::SetBlockCoordEncoding()) and smaller
+   * than the encoding with a fixed delta size for all coordinates.
+   *
+   * The deltas are grouped into blocks of blockCoordDeltaCount (lat,lon) pairs. The lat and the
+   * lon deltas of each block are zigzag encoded and stored with the number of bits
+   * needed for the biggest of them. The encoded data consists of the two bit widths of
+   * each block (one byte each) followed by the bit stream of all blocks (for each block first
+   * all lat then all lon values, least significant bit first).
+   *
+   * Since the values are not byte aligned, decoding takes about twice the time per
+   * coordinate of the fixed delta size encoding. The encoding trades this for
+   * smaller files (about a third less coordinate data), that is less data to read from disk.
+   * The importer thus only uses it on request (ImportParameter::SetBlockCoordEncoding()).
+   */
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Number of (lat,lon) deltas in one block
+   */
+  constexpr size_t blockCoordDeltaCount=16;
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Number of readable bytes after the bit stream, that allows DecodeBlockCoords() to
+   * use fast unaligned loads for all values. The content of these bytes does not matter.
+   */
+  constexpr size_t blockCoordDataPadding=sizeof(uint64_t);
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Return the number of blocks for the given number of (lat,lon) deltas
+   */
+  inline size_t GetBlockCoordBlockCount(size_t deltaCount)
+  {
+    return (deltaCount+blockCoordDeltaCount-1)/blockCoordDeltaCount;
+  }
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Return the number of bytes of the bit stream for the given number of (lat,lon) deltas
+   * and bit widths
+   */
+  extern OSMSCOUT_API size_t GetBlockCoordDataSize(size_t deltaCount,
+                                                   const uint8_t* widths);
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Return the overall number of bytes (bit widths and bit stream) needed to encode the
+   * given deltas (lat and lon delta interleaved)
+   */
+  extern OSMSCOUT_API size_t GetBlockCoordEncodedSize(const std::vector<int32_t>& deltas);
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Encode the given deltas (lat and lon delta interleaved) into the buffer
+   */
+  extern OSMSCOUT_API void EncodeBlockCoords(const std::vector<int32_t>& deltas,
+                                             std::vector<uint8_t>& buffer);
+
+  /**
+   * \ingroup BlockCoordEncoding
+   *
+   * Decode the given bit stream and assign the resulting coordinates to points[1..deltaCount].
+   * lat and lon are the raw values of the coordinate of points[0].
+   *
+   * dataSize is the number of readable bytes at data. Decoding is faster, if it includes
+   * blockCoordDataPadding bytes after the bit stream.
+   *
+   * @return false, if any of the resulting coordinates is not normalised
+   */
+  extern OSMSCOUT_API bool DecodeBlockCoords(const uint8_t* widths,
+                                             const uint8_t* data,
+                                             size_t dataSize,
+                                             size_t deltaCount,
+                                             uint32_t lat,
+                                             uint32_t lon,
+                                             Point* points);
+}
+
+#endif
@@ -28,10 +28,13 @@
 
 #include <osmscout/TypeConfig.h>
 
+#include <osmscout/io/DataReadPlan.h>
+#include <osmscout/io/FileBatchReader.h>
 #include <osmscout/io/FileScanner.h>
 #include <osmscout/io/NumericIndex.h>
 
 #include <osmscout/util/Cache.h>
+#include <osmscout/util/Metrics.h>
 #include <osmscout/log/Logger.h>
 
 //#include <map>
@@ -87,6 +90,7 @@ namespace osmscout {
     mutable ValueCache  cache;
 
     mutable FileScanner scanner;         //!< File stream to the data file
+    mutable FileBatchReader batchReader; //!< Batched reads via io_uring, only open if available and mmap is not used
 
     mutable std::mutex  accessMutex;     //!< Mutex to secure multi-thread access
 
@@ -94,10 +98,37 @@ namespace osmscout {
     TypeConfigRef       typeConfig;
 
   private:
+    static MetricCounter& GetCacheHitCounter()
+    {
+      static MetricCounter& counter=MetricsRegistry::Instance().GetCounter("osmscout_datafile_cache_hits_total",
+                                                                           "Number of data file objects served from the cache");
+
+      return counter;
+    }
+
+    static MetricCounter& GetReadCounter()
+    {
+      static MetricCounter& counter=MetricsRegistry::Instance().GetCounter("osmscout_datafile_reads_total",
+                                                                           "Number of data file objects read from disk");
+
+      return counter;
+    }
+
     bool ReadData(N& data) const;
     bool ReadData(FileOffset offset,
                   N& data) const;
 
+    void Prefetch(const DataReadPlan& plan,
+                  size_t range) const;
+
+    bool ReadPlanned(const std::vector<FileOffset>& offsets,
+                     std::vector<ValueType>& data) const;
+
+    bool ReadBatched(const DataReadPlan& plan,
+                     const std::vector<FileOffset>& offsets,
+                     std::vector<ValueType>& data,
+                     size_t dataStart) const;
+
   public:
     DataFile(const std::string& datafile,
              size_t cacheSize);
@@ -171,6 +202,8 @@ namespace osmscout {
   bool DataFile<N>::ReadData(FileOffset offset,
                              N& data) const
   {
+    GetReadCounter().Increment();
+
     try {
       scanner.SetPos(offset);
 
@@ -193,6 +226,8 @@ namespace osmscout {
   template <class N>
   bool DataFile<N>::ReadData(N& data) const
   {
+    GetReadCounter().Increment();
+
     try {
       data.Read(*typeConfig,
                 scanner);
@@ -205,6 +240,200 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Announces the given range of the plan to the operating system. Plans with a
+   * single entry are not worth the additional system call.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  void DataFile<N>::Prefetch(const DataReadPlan& plan,
+                             size_t range) const
+  {
+    if (range>=plan.GetRanges().size() ||
+        plan.GetOrder().size()<2) {
+      return;
+    }
+
+    const DataReadPlan::Range& entry=plan.GetRanges()[range];
+
+    scanner.Prefetch(entry.start,
+                     entry.end-entry.start);
+  }
+
+  /**
+   * Reads the data values for the given file offsets in file order, prefetching
+   * one range of the read plan ahead. The values are appended to data in the order
+   * of the offsets. On error, data is left unchanged.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::ReadPlanned(const std::vector<FileOffset>& offsets,
+                                std::vector<ValueType>& data) const
+  {
+    DataReadPlan plan(offsets);
+    size_t       dataStart=data.size();
+
+    data.resize(dataStart+offsets.size());
+
+    if (batchReader.IsOpen()) {
+      if (!ReadBatched(plan,
+                       offsets,
+                       data,
+                       dataStart)) {
+        data.resize(dataStart);
+        return false;
+      }
+
+      return true;
+    }
+
+    Prefetch(plan,0);
+
+    for (size_t range=0; range<plan.GetRanges().size(); range++) {
+      const DataReadPlan::Range& entry=plan.GetRanges()[range];
+
+      Prefetch(plan,range+1);
+
+      for (size_t i=entry.first; i<entry.last; i++) {
+        size_t        index=plan.GetOrder()[i];
+        FileOffset    offset=offsets[index];
+        ValueCacheRef entryRef;
+
+        if (cache.GetEntry(offset,entryRef)) {
+          GetCacheHitCounter().Increment();
+          data[dataStart+index]=entryRef->value;
+          continue;
+        }
+
+        ValueType value=std::make_shared<N>();
+
+        if (!ReadData(offset,
+                      *value)) {
+          log.Error() << "Error while reading data from offset " << offset << " of file " << datafilename << "!";
+          data.resize(dataStart);
+          return false;
+        }
+
+        cache.SetEntry(ValueCacheEntry(offset,value));
+        data[dataStart+index]=value;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Reads the data values for the given file offsets, that are not cached, using
+   * the batch reader. Objects near to each other are read by the same request,
+   * decoding happens in the order the requests complete. Objects not completely
+   * contained in the data of their request are read again using the scanner.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::ReadBatched(const DataReadPlan& plan,
+                                const std::vector<FileOffset>& offsets,
+                                std::vector<ValueType>& data,
+                                size_t dataStart) const
+  {
+    std::vector<size_t> pending;
+
+    for (size_t index : plan.GetOrder()) {
+      ValueCacheRef entryRef;
+
+      if (cache.GetEntry(offsets[index],entryRef)) {
+        GetCacheHitCounter().Increment();
+        data[dataStart+index]=entryRef->value;
+      }
+      else {
+        pending.push_back(index);
+      }
+    }
+
+    std::vector<FileBatchReader::Request> requests;
+    std::vector<size_t>                   requestStarts;
+    size_t                                bufferSize=batchReader.GetBufferSize();
+
+    for (size_t p=0; p<pending.size();) {
+      FileOffset start=offsets[pending[p]];
+      size_t     last=p+1;
+
+      while (last<pending.size() &&
+             offsets[pending[last]]+DataReadPlan::defaultTailSize-start<=bufferSize) {
+        last++;
+      }
+
+      requests.push_back(FileBatchReader::Request{start,
+                                                  size_t(std::min<FileOffset>(bufferSize,
+                                                                              offsets[pending[last-1]]+DataReadPlan::defaultTailSize-start))});
+      requestStarts.push_back(p);
+
+      p=last;
+    }
+
+    requestStarts.push_back(pending.size());
+
+    std::vector<size_t> fallback;
+
+    try {
+      batchReader.Read(requests,
+                       [this,&offsets,&data,dataStart,&pending,&requests,&requestStarts,&fallback](size_t request,
+                                                                                                    const char* buffer,
+                                                                                                    size_t size) {
+                         FileScanner memoryScanner;
+
+                         for (size_t p=requestStarts[request]; p<requestStarts[request+1]; p++) {
+                           size_t    index=pending[p];
+                           ValueType value=std::make_shared<N>();
+
+                           try {
+                             memoryScanner.OpenMemory(datafilename,
+                                                      requests[request].offset,
+                                                      buffer,
+                                                      size);
+                             memoryScanner.SetPos(offsets[index]);
+
+                             value->Read(*typeConfig,
+                                         memoryScanner);
+
+                             memoryScanner.Close();
+
+                             GetReadCounter().Increment();
+                             data[dataStart+index]=value;
+                           }
+                           catch (const IOException&) {
+                             memoryScanner.CloseFailsafe();
+                             fallback.push_back(index);
+                           }
+                         }
+                       });
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    for (size_t index : fallback) {
+      ValueType value=std::make_shared<N>();
+
+      if (!ReadData(offsets[index],
+                    *value)) {
+        log.Error() << "Error while reading data from offset " << offsets[index] << " of file " << datafilename << "!";
+        return false;
+      }
+
+      data[dataStart+index]=value;
+    }
+
+    for (size_t index : pending) {
+      cache.SetEntry(ValueCacheEntry(offsets[index],data[dataStart+index]));
+    }
+
+    return true;
+  }
+
   /**
    * Open the index file.
    *
@@ -230,6 +459,20 @@ namespace osmscout {
       return false;
     }
 
+    if (!memoryMappedData) {
+      try {
+        batchReader.Open(datafilename);
+
+        if (batchReader.GetBackend()!=FileBatchReader::Backend::IoUring) {
+          batchReader.Close();
+        }
+      }
+      catch (const IOException& e) {
+        log.Warn() << e.GetDescription();
+        batchReader.Close();
+      }
+    }
+
     return true;
   }
 
@@ -255,6 +498,10 @@ namespace osmscout {
     typeConfig=nullptr;
     cache.Flush();
 
+    if (batchReader.IsOpen()) {
+      batchReader.Close();
+    }
+
     try  {
       if (scanner.IsOpen()) {
         scanner.Close();
@@ -309,7 +556,11 @@ namespace osmscout {
       return true;
     }
 
-    data.reserve(data.size()+size);
+    std::vector<FileOffset> offsets;
+
+    offsets.reserve(size);
+    offsets.insert(offsets.end(),begin,end);
+
     std::scoped_lock<std::mutex> lock(accessMutex);
 
     if (cache.GetMaxSize()>0 &&
@@ -317,27 +568,8 @@ namespace osmscout {
       log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
     }
 
-    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
-      ValueCacheRef entryRef;
-
-      if (cache.GetEntry(*offsetIter,entryRef)) {
-        data.push_back(entryRef->value);
-      }
-      else {
-        ValueType value=std::make_shared<N>();
-
-        if (!ReadData(*offsetIter,
-                      *value)) {
-          log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
-          return false;
-        }
-
-        cache.SetEntry(ValueCacheEntry(*offsetIter,value));
-        data.push_back(value);
-      }
-    }
-
-    return true;
+    return ReadPlanned(offsets,
+                       data);
   }
 
   /**
@@ -356,33 +588,32 @@ namespace osmscout {
       return true;
     }
 
-    data.reserve(data.size()+size);
-    std::scoped_lock<std::mutex> lock(accessMutex);
+    std::vector<FileOffset> offsets;
+    std::vector<ValueType>  values;
 
-    if (cache.GetMaxSize()>0 &&
-        size>cache.GetMaxSize()){
-      log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
-    }
+    offsets.reserve(size);
+    offsets.insert(offsets.end(),begin,end);
 
-    //std::map<std::string,size_t> hitRateTypes;
-    //std::map<std::string,size_t> missRateTypes;
-    size_t inBoxCount=0;
-    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
-      ValueType value=std::make_shared<N>();
+    {
+      std::scoped_lock<std::mutex> lock(accessMutex);
 
-      ValueCacheRef entryRef;
-      if (cache.GetEntry(*offsetIter,entryRef)){
-        value=entryRef->value;
-      }else{
-        if (!ReadData(*offsetIter,
-                      *value)) {
-          log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
-          return false;
-        }
+      if (cache.GetMaxSize()>0 &&
+          size>cache.GetMaxSize()){
+        log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
+      }
 
-        cache.SetEntry(ValueCacheEntry(*offsetIter,value));
+      if (!ReadPlanned(offsets,
+                       values)) {
+        return false;
       }
+    }
+
+    data.reserve(data.size()+size);
 
+    //std::map<std::string,size_t> hitRateTypes;
+    //std::map<std::string,size_t> missRateTypes;
+    size_t inBoxCount=0;
+    for (const auto& value : values) {
       if (!value->Intersects(boundingBox)) {
         //missRateTypes[value->GetType()->GetName()]++;
         continue;
@@ -455,6 +686,7 @@ namespace osmscout {
 
     ValueCacheRef entryRef;
     if (cache.GetEntry(offset,entryRef)){
+      GetCacheHitCounter().Increment();
       entry=entryRef->value;
     }else{
       ValueType value=std::make_shared<N>();
@@ -497,6 +729,7 @@ namespace osmscout {
       for (uint32_t i=1; i<=span.count; i++) {
         ValueCacheRef entryRef;
         if (cache.GetEntry(offset,entryRef)){
+          GetCacheHitCounter().Increment();
           data.push_back(entryRef->value);
           offset=entryRef->value->GetNextFileOffset();
           offsetSetup=false;
@@ -530,6 +763,9 @@ namespace osmscout {
   /**
    * Read data values from the given DataBlockSpans.
    *
+   * The spans are read in file order, prefetching one range of nearby spans ahead,
+   * the values are appended to data in the order of the spans.
+   *
    * Method is thread-safe.
    */
   template <class N>
@@ -537,53 +773,74 @@ namespace osmscout {
   bool DataFile<N>::GetByBlockSpans(IteratorIn begin, IteratorIn end,
                                     std::vector<ValueType>& data) const
   {
-    uint32_t overallCount=0;
-
-    for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
-      overallCount+=spanIter->count;
+    std::vector<DataBlockSpan> spans(begin,end);
+    std::vector<FileOffset>    startOffsets;
+    std::vector<size_t>        dataOffsets;
+    size_t                     dataStart=data.size();
+    size_t                     overallCount=0;
+
+    startOffsets.reserve(spans.size());
+    dataOffsets.reserve(spans.size());
+
+    for (const auto& span : spans) {
+      startOffsets.push_back(span.startOffset);
+      dataOffsets.push_back(dataStart+overallCount);
+      overallCount+=span.count;
     }
 
-    data.reserve(data.size()+overallCount);
+    DataReadPlan plan(startOffsets);
+
+    data.resize(dataStart+overallCount);
 
     try {
       std::scoped_lock<std::mutex> lock(accessMutex);
-      for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
-        if (spanIter->count==0) {
-          continue;
-        }
 
-        bool offsetSetup=false;
-        FileOffset offset=spanIter->startOffset;
-
-        for (uint32_t i=1; i<=spanIter->count; i++) {
-          ValueCacheRef entryRef;
-          if (cache.GetEntry(offset,entryRef)){
-            data.push_back(entryRef->value);
-            offset=entryRef->value->GetNextFileOffset();
-            offsetSetup=false;
-          }else{
-            if (!offsetSetup){
-              scanner.SetPos(offset);
+      Prefetch(plan,0);
+
+      for (size_t range=0; range<plan.GetRanges().size(); range++) {
+        const DataReadPlan::Range& rangeEntry=plan.GetRanges()[range];
+
+        Prefetch(plan,range+1);
+
+        for (size_t spanIndex=rangeEntry.first; spanIndex<rangeEntry.last; spanIndex++) {
+          const DataBlockSpan& span=spans[plan.GetOrder()[spanIndex]];
+          size_t               dataOffset=dataOffsets[plan.GetOrder()[spanIndex]];
+          bool                 offsetSetup=false;
+          FileOffset           offset=span.startOffset;
+
+          for (uint32_t i=1; i<=span.count; i++) {
+            ValueCacheRef entryRef;
+            if (cache.GetEntry(offset,entryRef)){
+              GetCacheHitCounter().Increment();
+              data[dataOffset++]=entryRef->value;
+              offset=entryRef->value->GetNextFileOffset();
+              offsetSetup=false;
+            }else{
+              if (!offsetSetup){
+                scanner.SetPos(offset);
+              }
+
+              ValueType value=std::make_shared<N>();
+
+              if (!ReadData(*value)) {
+                log.Error() << "Error while reading data #" << i << " starting from offset " << span.startOffset <<
+                " of file " << datafilename << "!";
+                data.resize(dataStart);
+                return false;
+              }
+
+              cache.SetEntry(ValueCacheEntry(offset,value));
+              offset=value->GetNextFileOffset();
+              offsetSetup=true;
+              data[dataOffset++]=value;
             }
-
-            ValueType value=std::make_shared<N>();
-
-            if (!ReadData(*value)) {
-              log.Error() << "Error while reading data #" << i << " starting from offset " << spanIter->startOffset <<
-              " of file " << datafilename << "!";
-              return false;
-            }
-
-            cache.SetEntry(ValueCacheEntry(offset,value));
-            offset=value->GetNextFileOffset();
-            offsetSetup=true;
-            data.push_back(value);
           }
         }
       }
     }
     catch (const IOException& e) {
       log.Error() << e.GetDescription();
+      data.resize(dataStart);
       return false;
     }
 
@@ -0,0 +1,93 @@
+#ifndef OSMSCOUT_DATAREADPLAN_H
+#define OSMSCOUT_DATAREADPLAN_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Plans reading a number of data objects given by their file offsets.
+   *
+   * The objects are read in file order instead of the order of the request, and objects
+   * near to each other are grouped into ranges. Before reading a range, the next range
+   * is announced to the operating system (see FileScanner::Prefetch()), so that it is
+   * loaded in the background while the current range gets decoded.
+   *
+   * Since the size of the objects is not known in advance, a range ends at the offset
+   * of its last object plus some tail size.
+   */
+  class OSMSCOUT_API DataReadPlan CLASS_FINAL
+  {
+  public:
+    static constexpr FileOffset defaultMaxGap=64*1024;   //!< Maximum distance of neighbouring offsets within one range
+    static constexpr FileOffset defaultTailSize=16*1024; //!< Number of bytes prefetched behind the last offset of a range
+
+    struct Range
+    {
+      size_t     first; //!< Index of the first entry of the range in read order
+      size_t     last;  //!< Index behind the last entry of the range in read order
+      FileOffset start; //!< First byte of the range
+      FileOffset end;   //!< Byte behind the range
+
+      size_t GetEntryCount() const
+      {
+        return last-first;
+      }
+    };
+
+  private:
+    std::vector<size_t> order;  //!< Indexes of the offsets in read order
+    std::vector<Range>  ranges; //!< Ranges in read order
+
+  public:
+    explicit DataReadPlan(const std::vector<FileOffset>& offsets,
+                          FileOffset maxGap=defaultMaxGap,
+                          FileOffset tailSize=defaultTailSize);
+
+    /**
+     * Returns the indexes of the passed offsets in the order they should be read
+     */
+    const std::vector<size_t>& GetOrder() const
+    {
+      return order;
+    }
+
+    /**
+     * Returns the ranges to prefetch, in read order
+     */
+    const std::vector<Range>& GetRanges() const
+    {
+      return ranges;
+    }
+  };
+}
+
+#endif
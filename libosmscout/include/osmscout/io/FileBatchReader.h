@@ -0,0 +1,142 @@
+#ifndef OSMSCOUT_FILEBATCHREADER_H
+#define OSMSCOUT_FILEBATCHREADER_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Reads a batch of byte ranges of a file.
+   *
+   * With the io_uring backend (Linux only) all reads of a batch are submitted at once into
+   * buffers registered with the kernel and are handed to the caller in the order they
+   * complete. If io_uring is not available at compile time or is rejected by the kernel,
+   * the reader falls back to reading the ranges one after the other using pread().
+   *
+   * The data passed to the completion handler is only valid during the call, the buffer
+   * gets reused for another request afterwards.
+   *
+   * Methods are NOT thread-safe.
+   */
+  class OSMSCOUT_API FileBatchReader CLASS_FINAL
+  {
+  public:
+    enum class Backend
+    {
+      PRead,
+      IoUring
+    };
+
+    struct Request
+    {
+      FileOffset offset; //!< Offset of the first byte to read
+      size_t     size;   //!< Number of bytes to read, at most the buffer size
+    };
+
+    /**
+     * Called with the index of the request and its data. Ranges reaching beyond the end of
+     * the file get truncated.
+     */
+    using CompletionHandler = std::function<void(size_t request, const char* data, size_t size)>;
+
+    static constexpr size_t defaultBufferSize=32*1024; //!< Default size of a single read buffer
+    static constexpr size_t defaultQueueDepth=16;      //!< Default number of reads in flight
+
+  private:
+    struct IoUring;
+
+  private:
+    std::string              filename;        //!< Name of the file
+    int                      fd=-1;           //!< Low level file handle
+    FileOffset               fileSize=0;      //!< Size of the file
+    Backend                  backend=Backend::PRead;
+    size_t                   bufferSize=defaultBufferSize;
+    size_t                   queueDepth=defaultQueueDepth;
+    std::vector<char>        buffers;         //!< One buffer for each read in flight
+    std::unique_ptr<IoUring> ring;            //!< io_uring state, if the backend is used
+
+  private:
+    void ReadSync(const Request& request,
+                  char* buffer,
+                  size_t offset,
+                  size_t size) const;
+    void ReadPRead(const std::vector<Request>& requests,
+                   const CompletionHandler& handler);
+    void ReadIoUring(const std::vector<Request>& requests,
+                     const CompletionHandler& handler);
+
+  public:
+    FileBatchReader();
+    ~FileBatchReader();
+
+    // disable copy and move
+    FileBatchReader(const FileBatchReader&) = delete;
+    FileBatchReader(FileBatchReader&&) = delete;
+    FileBatchReader& operator=(const FileBatchReader&) = delete;
+    FileBatchReader& operator=(FileBatchReader&&) = delete;
+
+    void Open(const std::string& filename,
+              Backend preferredBackend=Backend::IoUring,
+              size_t bufferSize=defaultBufferSize,
+              size_t queueDepth=defaultQueueDepth);
+    void Close();
+
+    bool IsOpen() const
+    {
+      return fd>=0;
+    }
+
+    Backend GetBackend() const
+    {
+      return backend;
+    }
+
+    size_t GetBufferSize() const
+    {
+      return bufferSize;
+    }
+
+    FileOffset GetFileSize() const
+    {
+      return fileSize;
+    }
+
+    void Read(const std::vector<Request>& requests,
+              const CompletionHandler& handler);
+
+    static bool IsIoUringAvailable();
+  };
+}
+
+#endif
@@ -78,10 +78,13 @@ namespace osmscout {
     char         *mmap=nullptr;       //!< Pointer to the file memory
     FileOffset   size=0;              //!< Size of the memory/file
     FileOffset   offset=0;            //!< Current offset into the file memory
+    FileOffset   mmapOffset=0;        //!< File offset of the first byte of the file memory
+    bool         borrowedMemory=false;//!< The file memory is owned by the caller, see OpenMemory()
 
     // For std::vector<GeoCoord> loading
     uint8_t      *byteBuffer=nullptr; //!< Temporary buffer for loading of std::vector<GeoCoord>
     size_t       byteBufferSize=0;    //!< Size of the temporary byte buffer
+    std::vector<uint8_t> blockCoordBuffer; //!< Bit widths and padded bit stream of a block encoded std::vector<GeoCoord>
 
     // For Windows mmap usage
 #if defined(__WIN32__) || defined(WIN32)
@@ -187,19 +190,23 @@ namespace osmscout {
     void Open(const std::string& filename,
               Mode mode,
               bool useMmap);
+    void OpenMemory(const std::string& filename,
+                    FileOffset offset,
+                    const char* data,
+                    size_t size);
     void Close();
     void CloseFailsafe();
 
     bool IsOpen() const
     {
-      return file!=nullptr;
+      return file!=nullptr || borrowedMemory;
     }
 
     bool IsEOF() const;
 
      bool HasError() const
     {
-      return file==nullptr || hasError;
+      return !IsOpen() || hasError;
     }
 
     std::string GetFilename() const;
@@ -208,6 +215,9 @@ namespace osmscout {
     void SetPos(FileOffset pos);
     FileOffset GetPos() const;
 
+    void Prefetch(FileOffset pos,
+                  FileOffset bytes) const;
+
     void Read(char* buffer, size_t bytes);
 
     std::string ReadString();
@@ -53,6 +53,7 @@ namespace osmscout {
     bool                 hasError=true; //!< Flag for signaling that the stream has errors
     std::vector<int32_t> deltaBuffer;   //!< Temporary storage for deltas for storing of std::vector<GeoCoord>
     std::vector<uint8_t> byteBuffer;    //!< Temporary data buffer for storing of std::vector<GeoCoord>
+    bool                 blockCoordEncoding=false; //!< Use the block encoding for std::vector<Point>, if it is smaller
 
   public:
     static const uint64_t MAX_NODES;
@@ -76,6 +77,18 @@ namespace osmscout {
 
     std::string GetFilename() const;
 
+    /**
+     * Allow the block coordinate encoding for std::vector<Point>, if it is smaller
+     * than the encoding with a fixed delta size. It results in smaller files, but
+     * decoding is slower. Disabled by default.
+     *
+     * @see BlockCoordEncoding
+     */
+    void SetBlockCoordEncoding(bool blockCoordEncoding)
+    {
+      this->blockCoordEncoding=blockCoordEncoding;
+    }
+
     FileOffset GetPos();
     void SetPos(FileOffset pos);
     void GotoBegin();
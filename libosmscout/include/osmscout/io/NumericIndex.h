@@ -21,14 +21,17 @@
 */
 
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <osmscout/util/Cache.h>
 #include <osmscout/log/Logger.h>
+#include <osmscout/util/Metrics.h>
 #include <osmscout/util/Number.h>
 #include <osmscout/util/String.h>
 
 #include <osmscout/io/File.h>
+#include <osmscout/io/FileBatchReader.h>
 #include <osmscout/io/FileScanner.h>
 
 namespace osmscout {
@@ -81,6 +84,7 @@ namespace osmscout {
     std::string                         filename;             //!< Complete file name including directory
 
     mutable FileScanner                  scanner;             //!< FileScanner instance for file access
+    mutable FileBatchReader              batchReader;         //!< Batched page reads via io_uring, only open if available and mmap is not used
 
     size_t                               cacheSize;           //!< Maximum umber of index pages cached
     uint32_t                             pageSize=0;          //!< Size of one page as stated by the actual index file
@@ -97,9 +101,16 @@ namespace osmscout {
 
   private:
     size_t GetPageIndex(const Page& page, N id) const;
+    void DecodePage(const char* data, Page& page) const;
     void ReadPage(FileOffset offset, PageRef& page) const;
     void InitializeCache();
 
+    PageRef GetCachedPage(size_t level, N startId) const;
+    void CachePage(size_t level, N startId, const PageRef& page) const;
+
+    bool GetOffsetsBatched(const std::vector<N>& ids,
+                           std::vector<FileOffset>& offsets) const;
+
   public:
     NumericIndex(const std::string& filename,
                  size_t cacheSize);
@@ -178,42 +189,34 @@ namespace osmscout {
   }
 
   template <class N>
-  inline void NumericIndex<N>::ReadPage(FileOffset offset, PageRef& page) const
+  inline void NumericIndex<N>::DecodePage(const char* data, Page& page) const
   {
-    if (!page) {
-      page=std::make_shared<Page>();
-    }
-    else {
-      page->entries.clear();
-    }
+    static MetricCounter& pageReads=MetricsRegistry::Instance().GetCounter("osmscout_numericindex_page_reads_total",
+                                                                           "Number of index pages read from disk because of a page cache miss");
 
-    page->entries.reserve(pageSize/4);
+    pageReads.Increment();
 
-    scanner.SetPos(offset);
-
-    scanner.Read(buffer,
-                 pageSize);
+    page.entries.clear();
+    page.entries.reserve(pageSize/4);
 
     size_t     currentPos=0;
     N          prevId=0;
     FileOffset prefFileOffset=0;
 
-    //std::cout << "Page: " << offset << std::endl;
-
     while (currentPos<pageSize &&
-           buffer[currentPos]!=0) {
+           data[currentPos]!=0) {
       unsigned int idBytes;
       unsigned int fileOffsetBytes;
       N            curId;
       FileOffset   curFileOffset;
       Entry        entry;
 
-      idBytes=DecodeNumber(&buffer[currentPos],
+      idBytes=DecodeNumber(&data[currentPos],
                            curId);
 
       currentPos+=idBytes;
 
-      fileOffsetBytes=DecodeNumber(&buffer[currentPos],
+      fileOffsetBytes=DecodeNumber(&data[currentPos],
                                    curFileOffset);
 
       currentPos+=fileOffsetBytes;
@@ -226,8 +229,26 @@ namespace osmscout {
       prevId=entry.startId;
       prefFileOffset=entry.fileOffset;
 
-      page->entries.push_back(entry);
+      page.entries.push_back(entry);
+    }
+  }
+
+  template <class N>
+  inline void NumericIndex<N>::ReadPage(FileOffset offset, PageRef& page) const
+  {
+    if (!page) {
+      page=std::make_shared<Page>();
     }
+
+    //std::cout << "Page: " << offset << std::endl;
+
+    scanner.SetPos(offset);
+
+    scanner.Read(buffer,
+                 pageSize);
+
+    DecodePage(buffer,
+               *page);
   }
 
   template <class N>
@@ -307,12 +328,32 @@ namespace osmscout {
       return false;
     }
 
+    if (!memoryMapped) {
+      try {
+        batchReader.Open(filename,
+                         FileBatchReader::Backend::IoUring,
+                         pageSize);
+
+        if (batchReader.GetBackend()!=FileBatchReader::Backend::IoUring) {
+          batchReader.Close();
+        }
+      }
+      catch (IOException& e) {
+        log.Warn() << e.GetDescription();
+        batchReader.Close();
+      }
+    }
+
     return !scanner.HasError();
   }
 
   template <class N>
   bool NumericIndex<N>::Close()
   {
+    if (batchReader.IsOpen()) {
+      batchReader.Close();
+    }
+
     try {
       if (scanner.IsOpen()) {
         scanner.Close();
@@ -342,6 +383,11 @@ namespace osmscout {
   bool NumericIndex<N>::GetOffset(const N& id,
                                   FileOffset& offset) const
   {
+    static MetricCounter& lookups=MetricsRegistry::Instance().GetCounter("osmscout_numericindex_lookups_total",
+                                                                         "Number of id lookups in numeric indexes");
+
+    lookups.Increment();
+
     try
     {
       std::lock_guard<std::mutex> lock(accessMutex);
@@ -434,6 +480,16 @@ namespace osmscout {
                                    size_t size,
                                    std::vector<FileOffset>& offsets) const
   {
+    if (batchReader.IsOpen()) {
+      std::vector<N> ids;
+
+      ids.reserve(size);
+      ids.insert(ids.end(),begin,end);
+
+      return GetOffsetsBatched(ids,
+                               offsets);
+    }
+
     offsets.clear();
     offsets.reserve(size);
 
@@ -449,6 +505,168 @@ namespace osmscout {
     return true;
   }
 
+  template <class N>
+  typename NumericIndex<N>::PageRef NumericIndex<N>::GetCachedPage(size_t level,
+                                                                   N startId) const
+  {
+    if (level<=simpleCacheMaxLevel) {
+      auto cacheRef=simplePageCache[level].find(startId);
+
+      return cacheRef!=simplePageCache[level].end() ? cacheRef->second : nullptr;
+    }
+
+    typename PageCache::CacheRef cacheRef;
+
+    if (pageCaches[level].GetEntry(startId,cacheRef)) {
+      return cacheRef->value;
+    }
+
+    return nullptr;
+  }
+
+  template <class N>
+  void NumericIndex<N>::CachePage(size_t level,
+                                  N startId,
+                                  const PageRef& page) const
+  {
+    if (level<=simpleCacheMaxLevel) {
+      simplePageCache[level].emplace(startId,page);
+    }
+    else {
+      pageCaches[level].SetEntry(typename PageCache::CacheEntry(startId,page));
+    }
+  }
+
+  /**
+   * Looks up all ids level by level. The pages missing in the cache for the current
+   * level are read as one batch, so that the reads are in flight at the same time.
+   *
+   * This method is thread-safe.
+   */
+  template <class N>
+  bool NumericIndex<N>::GetOffsetsBatched(const std::vector<N>& ids,
+                                          std::vector<FileOffset>& offsets) const
+  {
+    struct Lookup
+    {
+      N          startId=0;
+      FileOffset offset=0;
+      bool       valid=false;
+    };
+
+    static MetricCounter& lookupCounter=MetricsRegistry::Instance().GetCounter("osmscout_numericindex_lookups_total",
+                                                                               "Number of id lookups in numeric indexes");
+
+    lookupCounter.Increment(ids.size());
+
+    std::vector<Lookup> lookups(ids.size());
+
+    try {
+      std::lock_guard<std::mutex> lock(accessMutex);
+
+      for (size_t i=0; i<ids.size(); i++) {
+        size_t r=GetPageIndex(*root,ids[i]);
+
+        if (root->IndexIsValid(r)) {
+          lookups[i].startId=root->entries[r].startId;
+          lookups[i].offset=root->entries[r].fileOffset;
+          lookups[i].valid=true;
+        }
+      }
+
+      for (size_t level=0; level+2<=levels; level++) {
+        std::vector<PageRef>                  pages(ids.size());
+        std::unordered_map<N,size_t>          requestIndexes;
+        std::vector<FileBatchReader::Request> requests;
+        std::vector<N>                        requestIds;
+
+        for (size_t i=0; i<ids.size(); i++) {
+          if (!lookups[i].valid) {
+            continue;
+          }
+
+          pages[i]=GetCachedPage(level,lookups[i].startId);
+
+          if (!pages[i] &&
+              requestIndexes.emplace(lookups[i].startId,requests.size()).second) {
+            requests.push_back(FileBatchReader::Request{lookups[i].offset,pageSize});
+            requestIds.push_back(lookups[i].startId);
+          }
+        }
+
+        std::vector<PageRef> loadedPages(requests.size());
+
+        batchReader.Read(requests,
+                         [this,&loadedPages](size_t request,
+                                             const char* data,
+                                             size_t size) {
+                           if (size<pageSize) {
+                             throw IOException(filename,"Cannot read index page","Unexpected end of file");
+                           }
+
+                           loadedPages[request]=std::make_shared<Page>();
+
+                           DecodePage(data,
+                                      *loadedPages[request]);
+                         });
+
+        for (size_t r=0; r<requests.size(); r++) {
+          CachePage(level,
+                    requestIds[r],
+                    loadedPages[r]);
+        }
+
+        for (size_t i=0; i<ids.size(); i++) {
+          if (!lookups[i].valid) {
+            continue;
+          }
+
+          const Page& page=pages[i] ? *pages[i] : *loadedPages[requestIndexes[lookups[i].startId]];
+          size_t      e=GetPageIndex(page,ids[i]);
+
+          if (!page.IndexIsValid(e)) {
+            lookups[i].valid=false;
+            continue;
+          }
+
+          lookups[i].startId=page.entries[e].startId;
+          lookups[i].offset=page.entries[e].fileOffset;
+        }
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+
+      // Look up the ids one by one, so that like in the unbatched case only
+      // the ids that cannot be resolved are skipped
+      offsets.clear();
+      offsets.reserve(ids.size());
+
+      for (const auto& id : ids) {
+        FileOffset offset;
+
+        if (GetOffset(id,
+                      offset)) {
+          offsets.push_back(offset);
+        }
+      }
+
+      return true;
+    }
+
+    offsets.clear();
+    offsets.reserve(ids.size());
+
+    for (size_t i=0; i<ids.size(); i++) {
+      if (lookups[i].valid &&
+          lookups[i].startId==ids[i]) {
+        offsets.push_back(lookups[i].offset);
+      }
+    }
+
+    return true;
+  }
+
   template <class N>
   void NumericIndex<N>::DumpStatistics() const
   {
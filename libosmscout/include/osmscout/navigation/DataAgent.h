@@ -23,7 +23,10 @@
 #include <osmscout/navigation/Engine.h>
 #include <osmscout/navigation/Agents.h>
 
+#include <limits>
 #include <list>
+#include <map>
+#include <vector>
 
 namespace osmscout {
 
@@ -34,16 +37,91 @@ namespace osmscout {
     std::map<FileOffset,AreaRef> areas;
   };
 
+  /**
+   * Uniform grid index over the segments of routable ways and area rings.
+   * It allows to look up the nearest routable object for a coordinate
+   * without iterating all loaded objects. Area rings are additionally stored in
+   * all cells covered by their bounding box, so the contains test only has to check
+   * the rings of the cell containing the coordinate.
+   */
+  class OSMSCOUT_API RoutableSegmentIndex CLASS_FINAL
+  {
+  public:
+    struct OSMSCOUT_API NearestObject
+    {
+      DatabaseId databaseId=0;
+      WayRef     way;
+      AreaRef    area;
+      GeoCoord   coord;      //!< nearest point on the object
+      double     distance=std::numeric_limits<double>::max(); //!< distance in degrees, 0 if inside area
+    };
+
+  private:
+    struct Object
+    {
+      DatabaseId                databaseId;
+      WayRef                    way;
+      AreaRef                   area;
+      const std::vector<Point>* nodes;
+      GeoBox                    boundingBox;
+    };
+
+    struct Segment
+    {
+      uint32_t object;
+      uint32_t node;    //!< index of the first node of the segment
+    };
+
+    GeoBox                bbox;
+    size_t                columns=0;
+    size_t                rows=0;
+    double                cellWidth=0.0;
+    double                cellHeight=0.0;
+    std::vector<Object>   objects;
+    std::vector<uint32_t> cellStart;   //!< offset of the first segment of each cell in segments, size cells+1
+    std::vector<Segment>  segments;    //!< segments ordered by cell, segments spanning cells are repeated
+    std::vector<uint32_t> cellRingStart; //!< offset of the first ring of each cell in rings, size cells+1
+    std::vector<uint32_t> rings;         //!< indexes of the area ring objects ordered by cell, rings covering multiple cells are repeated
+
+  private:
+    size_t GetColumn(double lon) const;
+    size_t GetRow(double lat) const;
+    bool AddObject(DatabaseId databaseId,
+                   const WayRef& way,
+                   const AreaRef& area,
+                   const std::vector<Point>& nodes);
+
+  public:
+    void Build(const std::map<DatabaseId, RoutableDBObjects>& dbMap);
+
+    bool IsBuilt() const
+    {
+      return !cellStart.empty();
+    }
+
+    size_t GetSegmentCount() const
+    {
+      return segments.size();
+    }
+
+    bool FindNearest(const GeoCoord& coord,
+                     const Distance& maxDistance,
+                     NearestObject& result) const;
+  };
+
   struct OSMSCOUT_API RoutableObjects
   {
     std::map<DatabaseId, RoutableDBObjects> dbMap;
     GeoBox bbox;
+    RoutableSegmentIndex segmentIndex; //!< Index over dbMap objects, has to be rebuild when dbMap is modified
 
     TypeConfigRef GetTypeConfig(const DatabaseId &dbId) const;
 
     WayRef GetWay(const DatabaseId &dbId, const ObjectFileRef &objRef) const;
 
     AreaRef GetArea(const DatabaseId &dbId, const ObjectFileRef &areaRef) const;
+
+    void BuildIndex();
   };
 
   using RoutableObjectsRef=std::shared_ptr<RoutableObjects>;
@@ -114,6 +192,8 @@ namespace osmscout {
             databaseMapping,
             msg->data);
 
+        msg->data->BuildIndex();
+
         // TODO: load all route objects too
 
         result.push_back(msg);
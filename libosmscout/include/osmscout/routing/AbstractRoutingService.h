@@ -24,9 +24,13 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <osmscout/lib/CoreFeatures.h>
 
@@ -34,6 +38,9 @@
 #include <osmscout/Point.h>
 #include <osmscout/Pixel.h>
 
+#include <osmscout/util/Cache.h>
+#include <osmscout/util/MemoryArena.h>
+
 #include <osmscout/routing/RouteDescription.h>
 #include <osmscout/routing/RouteData.h>
 #include <osmscout/routing/RouteNode.h>
@@ -56,6 +63,9 @@ namespace osmscout {
     Distance  currentMaxDistance;
     Distance  overallDistance;
     std::vector<int> sectionLengths;
+    size_t    forwardExpandedNodes=0;  //!< Number of route nodes expanded by the forward search
+    size_t    backwardExpandedNodes=0; //!< Number of route nodes expanded by the backward search
+    double    cost=0.0;                //!< Costs of the route up to the target route node
 
   public:
     RoutingResult();
@@ -109,6 +119,50 @@ namespace osmscout {
     {
       this->sectionLengths.clear();
     }
+
+    void SetExpandedNodes(size_t forwardExpandedNodes,
+                          size_t backwardExpandedNodes)
+    {
+      this->forwardExpandedNodes=forwardExpandedNodes;
+      this->backwardExpandedNodes=backwardExpandedNodes;
+    }
+
+    /**
+     * Number of route nodes expanded by the search starting at the start
+     * position
+     */
+    size_t GetForwardExpandedNodes() const
+    {
+      return forwardExpandedNodes;
+    }
+
+    /**
+     * Number of route nodes expanded by the search starting at the target
+     * position. Always 0 for the unidirectional search.
+     */
+    size_t GetBackwardExpandedNodes() const
+    {
+      return backwardExpandedNodes;
+    }
+
+    size_t GetExpandedNodes() const
+    {
+      return forwardExpandedNodes+backwardExpandedNodes;
+    }
+
+    void SetCost(double cost)
+    {
+      this->cost=cost;
+    }
+
+    /**
+     * Costs of the route as calculated by the routing profile, up to the route
+     * node next to the target position
+     */
+    double GetCost() const
+    {
+      return cost;
+    }
   };
 
   struct OSMSCOUT_API RoutePoints
@@ -187,6 +241,9 @@ namespace osmscout {
    * \ingroup Routing
    *
    * Abstract algorithms for routing
+   *
+   * The routing nodes and lists of a calculation are allocated in a memory arena owned
+   * by the calculation. The predecessor cache is shared by all calculations and synchronized.
    */
   template <class RoutingState>
   class OSMSCOUT_API AbstractRoutingService: public RoutingService
@@ -194,7 +251,37 @@ namespace osmscout {
   protected:
     bool debugPerformance;
 
+  private:
+    using Predecessors     = std::vector<std::pair<Id,ObjectFileRef>>;
+    using PredecessorCache = Cache<DBId,Predecessors>;
+
+    std::mutex       predecessorCacheMutex; //!< Mutex for accessing the predecessor cache
+    PredecessorCache predecessorCache;      //!< Route nodes from which a given route node can be reached directly
+
   protected:
+    /**
+     * Create a new routing node in the memory arena of the given route calculation.
+     * The node must not outlive the calculation.
+     */
+    template<typename... Args>
+    static RNodeRef CreateRNode(MemoryArena& arena,
+                                Args&&... args)
+    {
+      return std::allocate_shared<RNode>(std::pmr::polymorphic_allocator<RNode>(&arena),
+                                         std::forward<Args>(args)...);
+    }
+
+    /**
+     * Drop all cached predecessors. Must be called, if the underlying routing databases
+     * are closed.
+     */
+    void FlushPredecessorCache()
+    {
+      std::scoped_lock<std::mutex> lock(predecessorCacheMutex);
+
+      predecessorCache.Flush();
+    }
+
     virtual Vehicle GetVehicle(const RoutingState& state) = 0;
 
     virtual bool CanUse(const RoutingState& state,
@@ -296,6 +383,7 @@ namespace osmscout {
                                     RouteNodeRef& routeNode);
 
     bool GetStartNodes(const RoutingState& state,
+                       MemoryArena& arena,
                        const RoutePosition& position,
                        GeoCoord& startCoord,
                        const GeoCoord& targetCoord,
@@ -317,6 +405,7 @@ namespace osmscout {
                         RouteNodeRef& backwardNode);
 
     bool GetRNode(const RoutingState& state,
+                  MemoryArena& arena,
                   const RoutePosition& position,
                   const WayRef& way,
                   size_t routeNodeIndex,
@@ -335,6 +424,7 @@ namespace osmscout {
                   size_t targetNodeIndex);
 
     bool GetWayStartNodes(const RoutingState& state,
+                          MemoryArena& arena,
                           const RoutePosition& position,
                           GeoCoord& startCoord,
                           const GeoCoord& targetCoord,
@@ -350,6 +440,7 @@ namespace osmscout {
                                   RouteData& route);
 
     virtual bool WalkToOtherDatabases(const RoutingState& state,
+                                      MemoryArena& arena,
                                       RNodeRef &current,
                                       RouteNodeRef &currentRouteNode,
                                       OpenList &openList,
@@ -357,6 +448,7 @@ namespace osmscout {
                                       const ClosedSet &closedSet);
 
     virtual bool WalkPaths(const RoutingState& state,
+                           MemoryArena& arena,
                            RNodeRef &current,
                            RouteNodeRef &currentRouteNode,
                            OpenList &openList,
@@ -377,6 +469,32 @@ namespace osmscout {
                               RNodeRef startForwardNode,
                               RNodeRef startBackwardNode);
 
+    bool GetPredecessors(DatabaseId database,
+                         const RouteNode& routeNode,
+                         Predecessors& predecessors);
+
+    virtual bool WalkPathsBackward(const RoutingState& state,
+                                   MemoryArena& arena,
+                                   RNodeRef &current,
+                                   OpenList &openList,
+                                   OpenMap &openMap,
+                                   const ClosedSet &closedSet,
+                                   const GeoCoord &startCoord,
+                                   const Vehicle &vehicle,
+                                   size_t &nodesIgnoredCount,
+                                   const double &costLimit);
+
+    std::optional<double> GetMeetingCosts(const RoutingState& state,
+                                          const RNode& forwardNode,
+                                          const RNode& backwardNode,
+                                          const Vehicle &vehicle);
+
+    RoutingResult CalculateRouteBidirectional(RoutingState& state,
+                                              const RoutePosition& start,
+                                              const RoutePosition& target,
+                                              const std::optional<osmscout::Bearing> &bearing,
+                                              const RoutingParameter& parameter);
+
   public:
     explicit AbstractRoutingService(const RouterParameter& parameter);
     ~AbstractRoutingService() override;
@@ -0,0 +1,260 @@
+#ifndef OSMSCOUT_MAPMATCHINGSERVICE_H
+#define OSMSCOUT_MAPMATCHINGSERVICE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <osmscout/lib/CoreFeatures.h>
+
+#include <osmscout/GeoCoord.h>
+#include <osmscout/ObjectRef.h>
+#include <osmscout/Way.h>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/async/Breaker.h>
+
+#include <osmscout/util/Distance.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Parameter object for map matching. Defines the parameters of the hidden markov
+   * model and the limits of the candidate and transition searches.
+   */
+  class OSMSCOUT_API MapMatchingParameter CLASS_FINAL
+  {
+  private:
+    Distance candidateRadius=Meters(40);   //!< Search radius around each fix for candidate ways
+    size_t   maxCandidates=8;              //!< Maximum number of candidates per fix
+    Distance gpsSigma=Meters(5);           //!< Standard deviation of GPS noise, if the fix does not provide one
+    Distance transitionBeta=Meters(5);     //!< Scale of the exponential transition distribution
+    double   routeDistanceFactor=4.0;      //!< Local search bound relative to the great circle distance of two fixes
+    Distance minRouteDistanceLimit=Meters(200); //!< Minimum local search bound
+    Distance maxTransitionDistance=Kilometers(2); //!< Fixes farther apart are not connected by a transition search
+    Distance minFixDistance=Meters(10);    //!< Fixes closer to the last used fix are not part of the model
+    size_t   threads=0;                    //!< Number of worker threads for batch matching, 0 for auto
+    BreakerRef breaker;
+
+  public:
+    void SetCandidateRadius(const Distance& radius);
+    void SetMaxCandidates(size_t maxCandidates);
+    void SetGpsSigma(const Distance& sigma);
+    void SetTransitionBeta(const Distance& beta);
+    void SetRouteDistanceFactor(double factor);
+    void SetMinRouteDistanceLimit(const Distance& limit);
+    void SetMaxTransitionDistance(const Distance& distance);
+    void SetMinFixDistance(const Distance& distance);
+    void SetThreads(size_t threads);
+    void SetBreaker(const BreakerRef& breaker);
+
+    Distance GetCandidateRadius() const
+    {
+      return candidateRadius;
+    }
+
+    size_t GetMaxCandidates() const
+    {
+      return maxCandidates;
+    }
+
+    Distance GetGpsSigma() const
+    {
+      return gpsSigma;
+    }
+
+    Distance GetTransitionBeta() const
+    {
+      return transitionBeta;
+    }
+
+    double GetRouteDistanceFactor() const
+    {
+      return routeDistanceFactor;
+    }
+
+    Distance GetMinRouteDistanceLimit() const
+    {
+      return minRouteDistanceLimit;
+    }
+
+    Distance GetMaxTransitionDistance() const
+    {
+      return maxTransitionDistance;
+    }
+
+    Distance GetMinFixDistance() const
+    {
+      return minFixDistance;
+    }
+
+    size_t GetThreads() const
+    {
+      return threads;
+    }
+
+    BreakerRef GetBreaker() const
+    {
+      return breaker;
+    }
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * A single position sample of a trace that should get matched.
+   */
+  struct OSMSCOUT_API MapMatchingFix
+  {
+    GeoCoord                coord;
+    std::optional<Distance> accuracy;   //!< Horizontal accuracy of the fix, if known
+
+    MapMatchingFix() = default;
+
+    explicit MapMatchingFix(const GeoCoord& coord)
+    : coord(coord)
+    {
+      // no code
+    }
+
+    MapMatchingFix(const GeoCoord& coord,
+                   const std::optional<Distance>& accuracy)
+    : coord(coord),
+      accuracy(accuracy)
+    {
+      // no code
+    }
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of map matching for one fix of the trace.
+   */
+  struct OSMSCOUT_API MatchedFix
+  {
+    bool          matched=false; //!< false, if no candidate way was found for the fix
+    ObjectFileRef object;        //!< The way, the fix is matched to
+    WayRef        way;           //!< The way, the fix is matched to
+    size_t        segment=0;     //!< Index of the first node of the matched way segment
+    GeoCoord      coord;         //!< Snapped position on the way
+    Distance      distance;      //!< Distance between fix and snapped position
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of map matching of one trace.
+   */
+  class OSMSCOUT_API MapMatchingResult CLASS_FINAL
+  {
+  private:
+    std::vector<MatchedFix>    fixes;
+    std::vector<ObjectFileRef> path;
+    size_t                     breaks=0;
+
+  public:
+    friend class MapMatchingService;
+
+    /**
+     * Matched position for each fix of the input, in input order
+     */
+    const std::vector<MatchedFix>& GetFixes() const
+    {
+      return fixes;
+    }
+
+    /**
+     * The sequence of ways passed by the trace, including ways between matched fixes
+     * that were resolved by the transition search. Consecutive duplicates are removed.
+     */
+    const std::vector<ObjectFileRef>& GetPath() const
+    {
+      return path;
+    }
+
+    /**
+     * Number of times the model had to be restarted because no transition
+     * between consecutive fixes could be found or the fixes were farther apart
+     * than the maximum transition distance
+     */
+    size_t GetBreakCount() const
+    {
+      return breaks;
+    }
+
+    size_t GetMatchedCount() const;
+  };
+
+  /**
+   * \ingroup Service
+   * \ingroup Routing
+   *
+   * Snaps traces (for example imported GPX tracks) to the routable ways
+   * of a database using a hidden markov model solved by the Viterbi algorithm.
+   *
+   * Candidates for each fix are collected from the AreaWayIndex. Transition
+   * probabilities are based on the difference of the great circle distance
+   * and the on-road distance between candidates, which is computed by a bounded
+   * Dijkstra search on a local graph built from the loaded ways. Loaded ways
+   * and their graph are cached per trace, so consecutive fixes reuse the
+   * neighbourhood loaded before.
+   *
+   * Multiple traces can be matched in parallel, the service itself
+   * does not have any mutable state.
+   */
+  class OSMSCOUT_API MapMatchingService CLASS_FINAL
+  {
+  private:
+    DatabaseRef          database;
+    RoutingProfileRef    profile;
+    MapMatchingParameter parameter;
+    TypeInfoSet          routableTypes;
+
+  public:
+    MapMatchingService(const DatabaseRef& database,
+                       const RoutingProfileRef& profile,
+                       const MapMatchingParameter& parameter);
+
+    const MapMatchingParameter& GetParameter() const
+    {
+      return parameter;
+    }
+
+    MapMatchingResult Match(const std::vector<MapMatchingFix>& trace) const;
+
+    std::vector<MapMatchingResult> Match(const std::vector<std::vector<MapMatchingFix>>& traces) const;
+  };
+
+  //! \ingroup Service
+  //! Reference counted reference to a MapMatchingService instance
+  using MapMatchingServiceRef = std::shared_ptr<MapMatchingService>;
+}
+
+#endif
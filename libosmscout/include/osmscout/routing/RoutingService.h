@@ -24,6 +24,7 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -188,10 +189,12 @@ namespace osmscout {
   private:
     BreakerRef         breaker;
     RoutingProgressRef progress;
+    bool               bidirectional=false; //!< Search from start and target simultaneously
 
   public:
     void SetBreaker(const BreakerRef& breaker);
     void SetProgress(const RoutingProgressRef& progress);
+    void SetBidirectional(bool bidirectional);
 
     BreakerRef GetBreaker() const
     {
@@ -202,6 +205,11 @@ namespace osmscout {
     {
       return progress;
     }
+
+    bool IsBidirectional() const
+    {
+      return bidirectional;
+    }
   };
 
   /**
@@ -382,11 +390,12 @@ namespace osmscout {
       }
     };
 
-    using OpenList    = std::set<RNodeRef, RNodeCostCompare>;
-    using OpenListRef = std::set<RNodeRef, RNodeCostCompare>::iterator;
+    using OpenList    = std::pmr::set<RNodeRef, RNodeCostCompare>;
+    using OpenListRef = OpenList::iterator;
 
-    using OpenMap     = std::unordered_map<DBId, OpenListRef>;
-    using ClosedSet   = std::unordered_set<VNode, ClosedNodeHasher>;
+    using OpenMap     = std::pmr::unordered_map<DBId, OpenListRef>;
+    using ClosedSet   = std::pmr::unordered_set<VNode, ClosedNodeHasher>;
+    using ClosedMap   = std::pmr::unordered_map<DBId, RNodeRef>;
 
   public:
     //! Relative filename of the intersection data file
@@ -0,0 +1,132 @@
+#ifndef OSMSCOUT_UTIL_MEMORYARENA_H
+#define OSMSCOUT_UTIL_MEMORYARENA_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * Memory resource for the short living objects of one operation (one render call,
+   * one routing query,...), that are all dropped together at the end of the operation.
+   *
+   * Allocations are served from a pool on top of a monotonic buffer, so freeing
+   * individual objects is cheap and their memory is reused within the operation.
+   * Reset() drops all allocations at once. The arena then keeps one buffer of the size
+   * required by the previous operations, so a long living owner (like a worker thread
+   * or a painter) does not allocate from the heap at all in the steady state. A buffer
+   * larger than the maximum capacity is not kept, so a single big operation does not
+   * bind its memory for the lifetime of the owner.
+   *
+   * Containers using the arena via std::pmr::polymorphic_allocator must be empty
+   * or destroyed before Reset() is called. The arena is not thread safe.
+   */
+  class OSMSCOUT_API MemoryArena CLASS_FINAL : public std::pmr::memory_resource
+  {
+  private:
+    /**
+     * Upstream of the monotonic buffer, counting the memory requested after the
+     * initial buffer was exhausted
+     */
+    class OverflowResource CLASS_FINAL : public std::pmr::memory_resource
+    {
+    private:
+      size_t allocated=0;
+
+    private:
+      void* do_allocate(size_t bytes,
+                        size_t alignment) override;
+      void do_deallocate(void* pointer,
+                         size_t bytes,
+                         size_t alignment) override;
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+      size_t GetAllocated() const
+      {
+        return allocated;
+      }
+
+      void ResetAllocated()
+      {
+        allocated=0;
+      }
+    };
+
+  private:
+    OverflowResource                                     overflow;
+    std::unique_ptr<std::byte[]>                         buffer;
+    size_t                                               initialSize;
+    size_t                                               maxCapacity;
+    size_t                                               bufferSize;
+    std::optional<std::pmr::monotonic_buffer_resource>   monotonic;
+    std::optional<std::pmr::unsynchronized_pool_resource> pool;
+
+  private:
+    void* do_allocate(size_t bytes,
+                      size_t alignment) override;
+    void do_deallocate(void* pointer,
+                       size_t bytes,
+                       size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  public:
+    explicit MemoryArena(size_t initialSize=64*1024,
+                         size_t maxCapacity=16*1024*1024);
+    ~MemoryArena() override;
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena(MemoryArena&&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+    MemoryArena& operator=(MemoryArena&&) = delete;
+
+    void Reset();
+
+    /**
+     * Size of the buffer, that is reused after Reset(). It does not exceed the
+     * maximum capacity given on construction (unless the initial size does).
+     */
+    size_t GetCapacity() const
+    {
+      return bufferSize;
+    }
+
+    /**
+     * Memory allocated from the heap since the last Reset(), because the
+     * buffer was too small
+     */
+    size_t GetOverflow() const
+    {
+      return overflow.GetAllocated();
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,435 @@
+#ifndef OSMSCOUT_UTIL_METRICS_H
+#define OSMSCOUT_UTIL_METRICS_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * Returns a small, per thread slot number, that is used to distribute
+   * updates of metrics over multiple cache lines, so that threads
+   * do not fight for the same atomic.
+   */
+  extern OSMSCOUT_API size_t AllocateMetricsThreadSlot();
+
+  inline size_t GetMetricsThreadSlot()
+  {
+    thread_local size_t slot=AllocateMetricsThreadSlot();
+
+    return slot;
+  }
+
+  /**
+   * \ingroup Util
+   *
+   * Monotonic counter. Updates are lock-free and go to a per thread shard,
+   * the shards are summed up on read.
+   */
+  class OSMSCOUT_API MetricCounter CLASS_FINAL
+  {
+  public:
+    static constexpr size_t ShardCount=16;
+
+  private:
+    struct alignas(64) Shard
+    {
+      std::atomic<uint64_t> value{0};
+    };
+
+  private:
+    const std::atomic<bool>&   enabled;
+    std::string                name;
+    std::string                help;
+    std::array<Shard,ShardCount> shards;
+
+  public:
+    MetricCounter(const std::atomic<bool>& enabled,
+                  const std::string& name,
+                  const std::string& help);
+
+    MetricCounter(const MetricCounter&) = delete;
+    MetricCounter& operator=(const MetricCounter&) = delete;
+
+    void Increment(uint64_t delta=1)
+    {
+      if (!enabled.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      shards[GetMetricsThreadSlot()%ShardCount].value.fetch_add(delta,
+                                                                std::memory_order_relaxed);
+    }
+
+    const std::string& GetName() const
+    {
+      return name;
+    }
+
+    const std::string& GetHelp() const
+    {
+      return help;
+    }
+
+    uint64_t GetValue() const;
+
+    void Reset();
+  };
+
+  /**
+   * \ingroup Util
+   *
+   * Gauge holding a current value, which can go up and down.
+   *
+   * Note that updates are ignored while metrics are disabled, so
+   * gauges updated by Add()/Sub() are only reliable if metrics stay enabled.
+   */
+  class OSMSCOUT_API MetricGauge CLASS_FINAL
+  {
+  private:
+    const std::atomic<bool>& enabled;
+    std::string              name;
+    std::string              help;
+    std::atomic<int64_t>     value{0};
+
+  public:
+    MetricGauge(const std::atomic<bool>& enabled,
+                const std::string& name,
+                const std::string& help);
+
+    MetricGauge(const MetricGauge&) = delete;
+    MetricGauge& operator=(const MetricGauge&) = delete;
+
+    void Set(int64_t newValue)
+    {
+      if (enabled.load(std::memory_order_relaxed)) {
+        value.store(newValue,
+                    std::memory_order_relaxed);
+      }
+    }
+
+    void Add(int64_t delta)
+    {
+      if (enabled.load(std::memory_order_relaxed)) {
+        value.fetch_add(delta,
+                        std::memory_order_relaxed);
+      }
+    }
+
+    void Sub(int64_t delta)
+    {
+      Add(-delta);
+    }
+
+    const std::string& GetName() const
+    {
+      return name;
+    }
+
+    const std::string& GetHelp() const
+    {
+      return help;
+    }
+
+    int64_t GetValue() const
+    {
+      return value.load(std::memory_order_relaxed);
+    }
+
+    void Reset()
+    {
+      value.store(0,
+                  std::memory_order_relaxed);
+    }
+  };
+
+  /**
+   * \ingroup Util
+   *
+   * Histogram of unsigned integer values (typically durations in microseconds)
+   * with HDR-style log-linear buckets: values below 8 are counted exactly,
+   * every power of two above is split into 8 linear sub buckets. This results
+   * in a fixed number of buckets over the complete uint64_t range with a
+   * relative error of at most 12.5%.
+   *
+   * Like MetricCounter updates are lock-free and go to per thread shards.
+   */
+  class OSMSCOUT_API MetricHistogram CLASS_FINAL
+  {
+  public:
+    static constexpr size_t   SubBucketBits=3;
+    static constexpr size_t   SubBucketCount=1 << SubBucketBits;
+    static constexpr size_t   BucketCount=(64-SubBucketBits+1)*SubBucketCount;
+    static constexpr size_t   ShardCount=8;
+
+  private:
+    struct alignas(64) Shard
+    {
+      std::atomic<uint64_t>                     count{0};
+      std::atomic<uint64_t>                     sum{0};
+      std::atomic<uint64_t>                     min{UINT64_MAX};
+      std::atomic<uint64_t>                     max{0};
+      std::array<std::atomic<uint64_t>,BucketCount> buckets{};
+    };
+
+  private:
+    const std::atomic<bool>& enabled;
+    std::string              name;
+    std::string              help;
+    std::unique_ptr<Shard[]> shards;
+
+  public:
+    MetricHistogram(const std::atomic<bool>& enabled,
+                    const std::string& name,
+                    const std::string& help);
+
+    MetricHistogram(const MetricHistogram&) = delete;
+    MetricHistogram& operator=(const MetricHistogram&) = delete;
+
+    static size_t GetBucketIndex(uint64_t value)
+    {
+      if (value<SubBucketCount) {
+        return static_cast<size_t>(value);
+      }
+
+      size_t msb=static_cast<size_t>(std::bit_width(value))-1;
+      size_t shift=msb-SubBucketBits;
+
+      return (msb-SubBucketBits+1)*SubBucketCount+static_cast<size_t>((value >> shift) & (SubBucketCount-1));
+    }
+
+    static uint64_t GetBucketLowerBound(size_t index);
+    static uint64_t GetBucketUpperBound(size_t index);
+
+    bool IsEnabled() const
+    {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    void Record(uint64_t value)
+    {
+      if (!enabled.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      Shard& shard=shards[GetMetricsThreadSlot()%ShardCount];
+
+      shard.buckets[GetBucketIndex(value)].fetch_add(1,std::memory_order_relaxed);
+      shard.count.fetch_add(1,std::memory_order_relaxed);
+      shard.sum.fetch_add(value,std::memory_order_relaxed);
+
+      uint64_t current=shard.min.load(std::memory_order_relaxed);
+      while (value<current &&
+             !shard.min.compare_exchange_weak(current,value,std::memory_order_relaxed)) {
+        // retry
+      }
+
+      current=shard.max.load(std::memory_order_relaxed);
+      while (value>current &&
+             !shard.max.compare_exchange_weak(current,value,std::memory_order_relaxed)) {
+        // retry
+      }
+    }
+
+    template<class Rep, class Period>
+    void Record(const std::chrono::duration<Rep,Period>& duration)
+    {
+      auto microseconds=std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+      Record(static_cast<uint64_t>(std::max<decltype(microseconds)>(microseconds,0)));
+    }
+
+    const std::string& GetName() const
+    {
+      return name;
+    }
+
+    const std::string& GetHelp() const
+    {
+      return help;
+    }
+
+    void Reset();
+
+    friend class MetricsRegistry;
+  };
+
+  /**
+   * \ingroup Util
+   *
+   * Measures the time between construction and destruction (or Stop())
+   * and records it in microseconds to the given histogram. If metrics are disabled
+   * at construction time, the clock is not even read.
+   */
+  class OSMSCOUT_API MetricTimer CLASS_FINAL
+  {
+  private:
+    MetricHistogram*                      histogram;
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    explicit MetricTimer(MetricHistogram& histogram)
+    : histogram(histogram.IsEnabled() ? &histogram : nullptr)
+    {
+      if (this->histogram!=nullptr) {
+        start=std::chrono::steady_clock::now();
+      }
+    }
+
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+
+    ~MetricTimer()
+    {
+      Stop();
+    }
+
+    void Stop()
+    {
+      if (histogram!=nullptr) {
+        histogram->Record(std::chrono::steady_clock::now()-start);
+        histogram=nullptr;
+      }
+    }
+  };
+
+  /**
+   * \ingroup Util
+   *
+   * Point in time copy of all registered metrics.
+   */
+  struct OSMSCOUT_API MetricsSnapshot
+  {
+    struct CounterValue
+    {
+      std::string name;
+      std::string help;
+      uint64_t    value=0;
+    };
+
+    struct GaugeValue
+    {
+      std::string name;
+      std::string help;
+      int64_t     value=0;
+    };
+
+    struct HistogramBucket
+    {
+      uint64_t upperBound=0; //!< Inclusive upper bound of the bucket
+      uint64_t count=0;      //!< Number of values in this bucket (not cumulative)
+    };
+
+    struct HistogramValue
+    {
+      std::string                  name;
+      std::string                  help;
+      uint64_t                     count=0;
+      uint64_t                     sum=0;
+      uint64_t                     min=0;
+      uint64_t                     max=0;
+      std::vector<HistogramBucket> buckets; //!< Non-empty buckets only, in ascending order
+
+      double GetMean() const;
+      uint64_t GetPercentile(double percentile) const;
+    };
+
+    std::vector<CounterValue>   counters;
+    std::vector<GaugeValue>     gauges;
+    std::vector<HistogramValue> histograms;
+
+    const CounterValue* GetCounter(const std::string& name) const;
+    const GaugeValue* GetGauge(const std::string& name) const;
+    const HistogramValue* GetHistogram(const std::string& name) const;
+
+    std::string ToPrometheus() const;
+    std::string ToJson() const;
+  };
+
+  /**
+   * \ingroup Util
+   *
+   * Global registry of named metrics. Metrics are created on first access
+   * and live as long as the process. Callers on hot paths are expected to look
+   * up a metric once (for example by using a function local static reference)
+   * and then only update it.
+   *
+   * Metrics are disabled by default. While disabled, updates are reduced to a
+   * single relaxed atomic load.
+   *
+   * Names should follow the Prometheus naming conventions
+   * (for example "osmscout_datafile_cache_hits_total").
+   */
+  class OSMSCOUT_API MetricsRegistry CLASS_FINAL
+  {
+  private:
+    std::atomic<bool>                                       enabled{false};
+    mutable std::mutex                                      mutex;
+    std::map<std::string,std::unique_ptr<MetricCounter>>    counters;
+    std::map<std::string,std::unique_ptr<MetricGauge>>      gauges;
+    std::map<std::string,std::unique_ptr<MetricHistogram>>  histograms;
+
+  private:
+    MetricsRegistry() = default;
+
+  public:
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    static MetricsRegistry& Instance();
+
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const
+    {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    MetricCounter& GetCounter(const std::string& name,
+                              const std::string& help);
+    MetricGauge& GetGauge(const std::string& name,
+                          const std::string& help);
+    MetricHistogram& GetHistogram(const std::string& name,
+                                  const std::string& help);
+
+    MetricsSnapshot GetSnapshot() const;
+
+    void Reset();
+  };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef OSMSCOUT_UTIL_PACKEDRTREE_H
+#define OSMSCOUT_UTIL_PACKEDRTREE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/util/GeoBox.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Geometry
+   *
+   * Static R-tree over a list of bounding boxes, bulk loaded using the
+   * Sort-Tile-Recursive (STR) algorithm. The tree cannot be changed after
+   * it has been built.
+   *
+   * Queries return the indexes of the boxes (in the list passed to Build())
+   * that include the given coordinate or intersect the given box. Borders count
+   * as part of the boxes. The order of the returned indexes is undefined.
+   */
+  class OSMSCOUT_API PackedRTree CLASS_FINAL
+  {
+  private:
+    struct Node
+    {
+      GeoBox   boundingBox;
+      uint32_t first; //!< Index of the first child in the next lower level (or of the first item for leaves)
+      uint32_t count; //!< Number of children
+    };
+
+    size_t                         nodeCapacity;
+    std::vector<GeoBox>            itemBoxes; //!< Boxes of the items in tree order
+    std::vector<uint32_t>          itemIds;   //!< Index of the items in the list passed to Build(), in tree order
+    std::vector<std::vector<Node>> levels;    //!< Levels of the tree, the leaves first and the root last
+
+  public:
+    explicit PackedRTree(size_t nodeCapacity=16);
+
+    void Build(const std::vector<GeoBox>& boxes);
+
+    size_t GetSize() const
+    {
+      return itemIds.size();
+    }
+
+    void Query(const GeoCoord& coord,
+               std::vector<size_t>& items) const;
+    void Query(const GeoBox& boundingBox,
+               std::vector<size_t>& items) const;
+  };
+}
+
+#endif
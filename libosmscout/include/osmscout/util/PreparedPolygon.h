@@ -0,0 +1,123 @@
+#ifndef OSMSCOUT_UTIL_PREPAREDPOLYGON_H
+#define OSMSCOUT_UTIL_PREPAREDPOLYGON_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/util/GeoBox.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Geometry
+   *
+   * A polygon (a single ring) prepared for a large number of point in polygon tests.
+   *
+   * The latitude range of the polygon is split into rows of equal height. Every row
+   * holds the edges that lie (at least partly) within the row. A test only visits the
+   * edges of the row of the point instead of all edges of the polygon, which makes
+   * tests against large polygons (like the boundaries of countries) cheap.
+   *
+   * The results are identical to GetRelationOfPointToArea(), IsCoordInArea(),
+   * IsAreaCompletelyInArea() and IsAreaAtLeastPartlyInArea() for the same polygon.
+   */
+  class OSMSCOUT_API PreparedPolygon CLASS_FINAL
+  {
+  private:
+    std::vector<GeoCoord> nodes;
+    GeoBox                boundingBox;
+    double                rowHeight=0.0;
+    std::vector<uint32_t> rowOffsets; //!< Offset of the edges of each row in rowEdges, plus the end of the last row
+    std::vector<uint32_t> rowEdges;   //!< Edges per row, an edge is identified by the index of its end node
+
+  private:
+    size_t GetRow(double lat) const;
+
+  public:
+    PreparedPolygon() = default;
+    explicit PreparedPolygon(const std::vector<GeoCoord>& nodes);
+
+    const std::vector<GeoCoord>& GetNodes() const
+    {
+      return nodes;
+    }
+
+    const GeoBox& GetBoundingBox() const
+    {
+      return boundingBox;
+    }
+
+    int GetRelationOfPoint(const GeoCoord& point) const;
+
+    /**
+     * Returns true, if the point is on the border or within the polygon
+     */
+    bool Contains(const GeoCoord& point) const
+    {
+      return GetRelationOfPoint(point)>=0;
+    }
+
+    /**
+     * Returns true, if all points of the given area are on the border or within the polygon
+     */
+    template<typename N>
+    bool ContainsCompletely(const std::vector<N>& area) const
+    {
+      for (const auto& node : area) {
+        if (GetRelationOfPoint(GeoCoord(node.GetLat(),node.GetLon()))<0) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    /**
+     * Returns true, if at least one point of the given area is on the border or within the polygon
+     */
+    template<typename N>
+    bool ContainsAtLeastPartly(const std::vector<N>& area,
+                               const GeoBox& areaBoundingBox) const
+    {
+      if (!areaBoundingBox.Intersects(boundingBox)) {
+        return false;
+      }
+
+      for (const auto& node : area) {
+        if (boundingBox.Includes(node,/*openInterval*/ false) &&
+            GetRelationOfPoint(GeoCoord(node.GetLat(),node.GetLon()))>=0) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+  };
+}
+
+#endif
@@ -24,6 +24,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <optional>
 #include <utility>
@@ -120,13 +121,13 @@ namespace osmscout {
   }
 
   template<typename N>
-  bool StringToNumberSigned(const std::string& string,
+  bool StringToNumberSigned(std::string_view string,
                             N& number,
                             size_t base=10)
   {
     assert(base<=16);
 
-    std::string::size_type pos=0;
+    size_t                 pos=0;
     bool                   minus=false;
 
     number=0;
@@ -197,13 +198,13 @@ namespace osmscout {
   }
 
   template<typename N>
-  bool StringToNumberUnsigned(const std::string& string,
+  bool StringToNumberUnsigned(std::string_view string,
                               N& number,
                               size_t base=10)
   {
     assert(base<=16);
 
-    std::string::size_type pos=0;
+    size_t pos=0;
 
     number=0;
 
@@ -264,7 +265,7 @@ namespace osmscout {
   template<typename N>
   struct StringToNumberTemplated<true, N>
   {
-    static inline bool f(const std::string& string,
+    static inline bool f(std::string_view string,
                                  N& number,
                                  size_t base=10)
     {
@@ -275,7 +276,7 @@ namespace osmscout {
   template<typename N>
   struct StringToNumberTemplated<false, N>
   {
-    static inline bool f(const std::string& string,
+    static inline bool f(std::string_view string,
                                  N& number,
                                  size_t base=10)
     {
@@ -292,7 +293,7 @@ namespace osmscout {
    *  "-13" => -13
    */
   template<typename N>
-  inline bool StringToNumber(const std::string& string,
+  inline bool StringToNumber(std::string_view string,
                              N& number,
                              size_t base=10)
   {
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <cstdint>
 #include <vector>
 
 #include <osmscout/lib/CoreImportExport.h>
@@ -69,6 +70,34 @@ namespace osmscout {
   private:
     void Reserve(size_t size);
 
+    /**
+     * Return the Cohen-Sutherland like region code of the given coordinate
+     * in relation to the given clip box. The code is 0 if the coordinate is
+     * inside the box, else one bit is set for each side the coordinate is outside.
+     */
+    template<typename P>
+    static uint8_t GetOutCode(const GeoBox& clipBox,
+                              const P& coord)
+    {
+      return (coord.GetLon()<clipBox.GetMinLon() ? 1 : 0) |
+             (coord.GetLon()>clipBox.GetMaxLon() ? 2 : 0) |
+             (coord.GetLat()<clipBox.GetMinLat() ? 4 : 0) |
+             (coord.GetLat()>clipBox.GetMaxLat() ? 8 : 0);
+    }
+
+    /**
+     * Return the region code bits that are set for all coordinates
+     * within the given bounding box.
+     */
+    static uint8_t GetOutCode(const GeoBox& clipBox,
+                              const GeoBox& boundingBox)
+    {
+      return (boundingBox.GetMaxLon()<clipBox.GetMinLon() ? 1 : 0) |
+             (boundingBox.GetMinLon()>clipBox.GetMaxLon() ? 2 : 0) |
+             (boundingBox.GetMaxLat()<clipBox.GetMinLat() ? 4 : 0) |
+             (boundingBox.GetMinLat()>clipBox.GetMaxLat() ? 8 : 0);
+    }
+
   public:
     TransBuffer() = default;
     ~TransBuffer();
@@ -152,6 +181,137 @@ namespace osmscout {
       }
     }
 
+    /**
+     * Transform the given source array of GeoCoords to DisplayPoints in the buffer, while
+     * dropping coordinates that do not influence the rendering result within the given clip box.
+     *
+     * Each run of consecutive coordinates that are all outside the clip box on the same
+     * side (the same half plane) is reduced to its first and last coordinate. Since the
+     * remaining straight line between these coordinates lies in the same half plane, the
+     * part of the polyline or polygon within the clip box does not change. This holds as long
+     * as the projection maps lines of constant latitude and longitude to straight lines
+     * (which is the case for the Mercator based projections). The clip box thus should be
+     * the visible area extended by a guard band that is at least half the width of
+     * the rendered line or border, else the shortcuts may become visible.
+     *
+     * If more than one segment bounding box is passed, whole segments outside the
+     * clip box are handled as one run without looking at their coordinates.
+     *
+     * @tparam C
+     *    a container object like list, vector or array
+     * @param projection
+     *    The projection to use for transformation from geo coordinates to display coordinates
+     * @param nodes
+     *    The container holding the geo coordinates
+     * @param segments
+     *    Optional bounding boxes of consecutive segments of the nodes
+     * @param clipBox
+     *    The clip box, if it is invalid, no clipping takes place
+     */
+    template<typename C>
+    void  TransformGeoToPixel(const Projection& projection,
+                              const C& nodes,
+                              const std::vector<SegmentGeoBox>& segments,
+                              const GeoBox& clipBox)
+    {
+      if (!clipBox.IsValid()) {
+        TransformGeoToPixel(projection,
+                            nodes);
+        return;
+      }
+
+      if (nodes.empty()) {
+        return;
+      }
+
+      Projection::BatchTransformer batchTransformer(projection);
+      size_t                       runStart=0;
+      size_t                       runEnd=0;
+      uint8_t                      runCode=0; // 0: there is no pending run
+
+      Reserve(nodes.size());
+
+      length=0;
+
+      auto push=[this,&batchTransformer,&nodes](size_t index) {
+        batchTransformer.GeoToPixel(nodes[index],
+                                    points[length].x,
+                                    points[length].y);
+        points[length].draw=true;
+        length++;
+      };
+
+      auto flush=[&push,&runStart,&runEnd,&runCode]() {
+        if (runCode!=0) {
+          push(runStart);
+
+          if (runEnd!=runStart) {
+            push(runEnd);
+          }
+
+          runCode=0;
+        }
+      };
+
+      auto addOutside=[&flush,&runStart,&runEnd,&runCode](size_t from,
+                                                          size_t to,
+                                                          uint8_t code) {
+        if ((runCode & code)!=0) {
+          runCode&=code;
+          runEnd=to;
+        }
+        else {
+          flush();
+          runStart=from;
+          runEnd=to;
+          runCode=code;
+        }
+      };
+
+      auto add=[&push,&flush,&addOutside,&nodes,&clipBox](size_t index) {
+        uint8_t code=GetOutCode(clipBox,
+                                nodes[index]);
+
+        if (code==0) {
+          flush();
+          push(index);
+        }
+        else {
+          addOutside(index,
+                     index,
+                     code);
+        }
+      };
+
+      if (segments.size()>1) {
+        for (const auto& segment : segments) {
+          uint8_t code=GetOutCode(clipBox,
+                                  segment.bbox);
+
+          if (code!=0) {
+            addOutside(segment.from,
+                       segment.to-1,
+                       code);
+          }
+          else {
+            for (size_t i=segment.from; i<segment.to; i++) {
+              add(i);
+            }
+          }
+        }
+      }
+      else {
+        for (size_t i=0; i<nodes.size(); i++) {
+          add(i);
+        }
+      }
+
+      flush();
+
+      start=0;
+      end=length-1;
+    }
+
     /**
      * Return the bounding box of the to be drawn display coordinates
      *
@@ -194,6 +354,15 @@ namespace osmscout {
     };
   };
 
+  /**
+   * Finish the optimization of an already transformed area or way, after the points
+   * to drop have been marked by clearing their draw flag: drops succeeding equal points,
+   * applies the given constraint and updates start, end and length of the buffer
+   */
+  extern OSMSCOUT_API void FinishOptimization(TransBuffer& buffer,
+                                              bool isArea,
+                                              TransPolygon::OutputConstraint constraint);
+
   /**
    * Optimize a already transformed area
    */
@@ -289,6 +458,76 @@ namespace osmscout {
   }
 
 
+  /**
+   * Transform form geo to screen coordinates and (optionally) optimize the passed area with the given coordinates,
+   * dropping coordinates outside the given clip box that do not influence the rendering result within the clip box.
+   *
+   * @see TransBuffer::TransformGeoToPixel() for details about clipping
+   */
+  template<typename C>
+  void TransformArea(const C& nodes,
+                     const std::vector<SegmentGeoBox>& segments,
+                     const GeoBox& clipBox,
+                     TransBuffer& buffer,
+                     const Projection& projection,
+                     TransPolygon::OptimizeMethod optimize,
+                     double optimizeErrorTolerance,
+                     TransPolygon::OutputConstraint constraint=TransPolygon::noConstraint)
+  {
+    buffer.Reset();
+
+    if (nodes.size()<2) {
+      return;
+    }
+
+    buffer.TransformGeoToPixel(projection,
+                               nodes,
+                               segments,
+                               clipBox);
+
+    if (optimize!=TransPolygon::none) {
+      OptimizeArea(buffer,
+                   optimize,
+                   optimizeErrorTolerance,
+                   constraint);
+    }
+  }
+
+  /**
+   * Transform form geo to screen coordinates and (optionally) optimize the passed way with the given coordinates,
+   * dropping coordinates outside the given clip box that do not influence the rendering result within the clip box.
+   *
+   * @see TransBuffer::TransformGeoToPixel() for details about clipping
+   */
+  template<typename C>
+  void TransformWay(const C& nodes,
+                    const std::vector<SegmentGeoBox>& segments,
+                    const GeoBox& clipBox,
+                    TransBuffer& buffer,
+                    const Projection& projection,
+                    TransPolygon::OptimizeMethod optimize,
+                    double optimizeErrorTolerance,
+                    TransPolygon::OutputConstraint constraint=TransPolygon::noConstraint)
+  {
+    buffer.Reset();
+
+    if (nodes.empty()) {
+      return;
+    }
+
+    buffer.TransformGeoToPixel(projection,
+                               nodes,
+                               segments,
+                               clipBox);
+
+    if (optimize!=TransPolygon::none) {
+      OptimizeWay(buffer,
+                  optimize,
+                  optimizeErrorTolerance,
+                  constraint);
+    }
+  }
+
   /**
    * Transform form geo to screen coordinates and (optionally) optimize the passed way with the given coordinates
    * @tparam C
@@ -311,6 +550,21 @@ namespace osmscout {
                                                 double optimizeErrorTolerance,
                                                 TransPolygon::OutputConstraint constraint=TransPolygon::noConstraint);
 
+  /**
+   * Return the geo bounding box of the visible area of the given projection, extended by
+   * the given guard band. The result can be used as clip box for the clipping variants
+   * of TransformArea() and TransformWay().
+   *
+   * @param projection
+   *    Projection to use
+   * @param guardBand
+   *    Size of the guard band in pixel
+   * @return
+   *    The clip box or an invalid GeoBox, if the clip box cannot be calculated
+   */
+  extern OSMSCOUT_API GeoBox CalculateClipBox(const Projection& projection,
+                                              double guardBand);
+
   // Forward declaration for CoordBuffer
   class CoordBufferRange;
 
@@ -573,6 +827,66 @@ namespace osmscout {
                                     coordBuffer);
   }
 
+  /**
+   * Transform the geo coordinates to display coordinates of the given area, clipped to the given clip box,
+   * and copy the resulting coordinates the the given CoordBuffer.
+   *
+   * @see TransBuffer::TransformGeoToPixel() for details about clipping
+   */
+  template<typename C>
+  CoordBufferRange TransformArea(const C& nodes,
+                                 const std::vector<SegmentGeoBox>& segments,
+                                 const GeoBox& clipBox,
+                                 TransBuffer& transBuffer,
+                                 CoordBuffer& coordBuffer,
+                                 const Projection& projection,
+                                 TransPolygon::OptimizeMethod optimize,
+                                 double optimizeErrorTolerance)
+  {
+    TransformArea(nodes,
+                  segments,
+                  clipBox,
+                  transBuffer,
+                  projection,
+                  optimize,
+                  optimizeErrorTolerance);
+
+    assert(!transBuffer.IsEmpty());
+
+    return CopyPolygonToCoordBuffer(transBuffer,
+                                    coordBuffer);
+  }
+
+  /**
+   * Transform the geo coordinates to display coordinates of the given way, clipped to the given clip box,
+   * and copy the resulting coordinates the the given CoordBuffer.
+   *
+   * @see TransBuffer::TransformGeoToPixel() for details about clipping
+   */
+  template<typename C>
+  CoordBufferRange TransformWay(const C& nodes,
+                                const std::vector<SegmentGeoBox>& segments,
+                                const GeoBox& clipBox,
+                                TransBuffer& transBuffer,
+                                CoordBuffer& coordBuffer,
+                                const Projection& projection,
+                                TransPolygon::OptimizeMethod optimize,
+                                double optimizeErrorTolerance)
+  {
+    TransformWay(nodes,
+                 segments,
+                 clipBox,
+                 transBuffer,
+                 projection,
+                 optimize,
+                 optimizeErrorTolerance);
+
+    assert(!transBuffer.IsEmpty());
+
+    return CopyPolygonToCoordBuffer(transBuffer,
+                                    coordBuffer);
+  }
+
   /**
    * Transform the geo coordinates to display coordinates of the given bounding box and copy the resulting coordinates
    * the the given CoordBuffer.
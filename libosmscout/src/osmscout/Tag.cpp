@@ -26,6 +26,118 @@
 
 namespace osmscout {
 
+  TagMap::TagMap(std::pmr::memory_resource* resource)
+  : entries(resource)
+  {
+    // no code
+  }
+
+  TagMap::TagMap(std::initializer_list<std::pair<TagId,std::string_view>> tags)
+  {
+    entries.reserve(tags.size());
+
+    for (const auto& [tag,value] : tags) {
+      Set(tag,value);
+    }
+  }
+
+  TagMap::TagMap(const TagMap& other)
+  {
+    *this=other;
+  }
+
+  /**
+   * Copies all values, since the values of the other map may not outlive this map
+   */
+  TagMap& TagMap::operator=(const TagMap& other)
+  {
+    if (this==&other) {
+      return *this;
+    }
+
+    clear();
+    entries.reserve(other.size());
+
+    for (const auto& [tag,value] : other) {
+      Set(tag,value);
+    }
+
+    return *this;
+  }
+
+  size_t TagMap::erase(TagId tag)
+  {
+    auto entry=find(tag);
+
+    if (entry==end()) {
+      return 0;
+    }
+
+    entries.erase(entry);
+
+    return 1;
+  }
+
+  void TagMap::clear()
+  {
+    entries.clear();
+    ownedValues.reset();
+  }
+
+  /**
+   * Sets the value of the given tag to a copy of the given value
+   */
+  void TagMap::Set(TagId tag,
+                   std::string_view value)
+  {
+    if (!ownedValues) {
+      ownedValues=std::make_unique<std::deque<std::string>>();
+    }
+
+    SetView(tag,
+            ownedValues->emplace_back(value));
+  }
+
+  /**
+   * Sets the value of the given tag to the given value without copying it.
+   * The value must outlive the map.
+   */
+  void TagMap::SetView(TagId tag,
+                       std::string_view value)
+  {
+    for (auto& entry : entries) {
+      if (entry.first==tag) {
+        entry.second=value;
+        return;
+      }
+    }
+
+    entries.emplace_back(tag,value);
+  }
+
+  TagValuePool::TagValuePool()
+  : values(&arena)
+  {
+    // no code
+  }
+
+  std::string_view TagValuePool::Intern(std::string_view value)
+  {
+    if (auto existing=values.find(value);
+        existing!=values.end()) {
+      return *existing;
+    }
+
+    auto* data=static_cast<char*>(arena.allocate(std::max(value.size(),size_t(1)),
+                                                  alignof(char)));
+
+    std::copy(value.begin(),
+              value.end(),
+              data);
+
+    return *values.emplace(data,value.size()).first;
+  }
+
   TagNotCondition::TagNotCondition(const TagConditionRef& condition)
   : condition(condition)
   {
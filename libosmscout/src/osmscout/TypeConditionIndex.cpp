@@ -0,0 +1,315 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/TypeConditionIndex.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <osmscout/TypeConfig.h>
+
+namespace osmscout {
+
+  namespace {
+    /**
+     * The tags and tag values of which at least one must be present for
+     * a condition to be fulfilled
+     */
+    struct Trigger
+    {
+      bool                                      indexable=true; //!< false, if the condition cannot be reduced to tags
+      bool                                      exact=true;     //!< true, if any of the tags or values fulfills the condition
+      std::vector<TagId>                        tags;
+      std::vector<std::pair<TagId,std::string>> values;
+
+      static Trigger Unindexable()
+      {
+        Trigger trigger;
+
+        trigger.indexable=false;
+        trigger.exact=false;
+
+        return trigger;
+      }
+
+      /**
+       * Rough estimation of the number of objects hit, an existing tag hits
+       * a lot more objects than a certain tag value
+       */
+      size_t GetCost() const
+      {
+        return tags.size()*16+values.size();
+      }
+    };
+
+    Trigger AnalyzeCondition(const TagCondition& condition)
+    {
+      if (const auto* existsCondition=dynamic_cast<const TagExistsCondition*>(&condition);
+          existsCondition!=nullptr) {
+        Trigger trigger;
+
+        trigger.tags.push_back(existsCondition->GetTag());
+
+        return trigger;
+      }
+
+      if (const auto* binaryCondition=dynamic_cast<const TagBinaryCondition*>(&condition);
+          binaryCondition!=nullptr) {
+        Trigger trigger;
+
+        // All binary conditions require the tag to exist
+        if (binaryCondition->IsStringComparison() &&
+            binaryCondition->GetOperator()==operatorEqual) {
+          trigger.values.emplace_back(binaryCondition->GetTag(),
+                                      binaryCondition->GetStringValue());
+        }
+        else {
+          trigger.tags.push_back(binaryCondition->GetTag());
+          trigger.exact=false;
+        }
+
+        return trigger;
+      }
+
+      if (const auto* isInCondition=dynamic_cast<const TagIsInCondition*>(&condition);
+          isInCondition!=nullptr) {
+        Trigger trigger;
+
+        for (const auto& value : isInCondition->GetTagValues()) {
+          trigger.values.emplace_back(isInCondition->GetTag(),
+                                      value);
+        }
+
+        return trigger;
+      }
+
+      if (const auto* boolCondition=dynamic_cast<const TagBoolCondition*>(&condition);
+          boolCondition!=nullptr) {
+        const auto& conditions=boolCondition->GetConditions();
+
+        if (conditions.empty()) {
+          return Trigger::Unindexable();
+        }
+
+        if (boolCondition->GetType()==TagBoolCondition::boolAnd) {
+          // Every child is a necessary condition, take the most selective one
+          Trigger best=Trigger::Unindexable();
+
+          for (const auto& child : conditions) {
+            Trigger trigger=AnalyzeCondition(*child);
+
+            if (trigger.indexable &&
+                (!best.indexable ||
+                 trigger.GetCost()<best.GetCost())) {
+              best=std::move(trigger);
+            }
+          }
+
+          best.exact=best.exact && conditions.size()==1;
+
+          return best;
+        }
+
+        // boolOr, the condition is fulfilled if one of the children is fulfilled
+        Trigger trigger;
+
+        for (const auto& child : conditions) {
+          Trigger childTrigger=AnalyzeCondition(*child);
+
+          if (!childTrigger.indexable) {
+            return Trigger::Unindexable();
+          }
+
+          trigger.exact=trigger.exact && childTrigger.exact;
+          trigger.tags.insert(trigger.tags.end(),
+                              childTrigger.tags.begin(),
+                              childTrigger.tags.end());
+          trigger.values.insert(trigger.values.end(),
+                                childTrigger.values.begin(),
+                                childTrigger.values.end());
+        }
+
+        return trigger;
+      }
+
+      // Negations (and unknown conditions) may be fulfilled by any object
+      return Trigger::Unindexable();
+    }
+
+    void AddToRuleList(std::vector<uint32_t>& ruleList,
+                       uint32_t ruleIndex)
+    {
+      // A condition may reference a tag or value more than once
+      if (ruleList.empty() ||
+          ruleList.back()!=ruleIndex) {
+        ruleList.push_back(ruleIndex);
+      }
+    }
+
+    bool CanBe(const TypeInfo& type,
+               unsigned char objectTypes)
+    {
+      return ((objectTypes & TypeInfo::typeNode)!=0 && type.CanBeNode()) ||
+             ((objectTypes & TypeInfo::typeWay)!=0 && type.CanBeWay()) ||
+             ((objectTypes & TypeInfo::typeArea)!=0 && type.CanBeArea()) ||
+             ((objectTypes & TypeInfo::typeRelation)!=0 && type.CanBeRelation());
+    }
+  }
+
+  void TypeConditionIndex::AddRule(const std::shared_ptr<TypeInfo>& type,
+                                   unsigned char types,
+                                   const TagConditionRef& condition)
+  {
+    Trigger  trigger=AnalyzeCondition(*condition);
+    uint32_t ruleIndex=(uint32_t)rules.size();
+
+    rules.push_back(Rule{type,
+                         types,
+                         condition,
+                         trigger.exact});
+
+    if (!trigger.indexable) {
+      unindexedRules.push_back(ruleIndex);
+      return;
+    }
+
+    for (TagId tag : trigger.tags) {
+      if (tag>=tagEntries.size()) {
+        tagEntries.resize(tag+1);
+      }
+
+      AddToRuleList(tagEntries[tag].rules,
+                    ruleIndex);
+    }
+
+    for (const auto& [tag,value] : trigger.values) {
+      if (tag>=tagEntries.size()) {
+        tagEntries.resize(tag+1);
+      }
+
+      AddToRuleList(tagEntries[tag].valueRules[value],
+                    ruleIndex);
+    }
+  }
+
+  /**
+   * Builds the index for all conditions of the given types (in the given order), which
+   * apply to at least one of the given object types (TypeInfo::typeNode,...).
+   */
+  void TypeConditionIndex::Build(const std::vector<std::shared_ptr<TypeInfo>>& types,
+                                 unsigned char objectTypes)
+  {
+    Clear();
+
+    for (const auto& type : types) {
+      if (!type->HasConditions() ||
+          !CanBe(*type,objectTypes)) {
+        continue;
+      }
+
+      for (const auto& cond : type->GetConditions()) {
+        if ((cond.types & objectTypes)==0) {
+          continue;
+        }
+
+        AddRule(type,
+                cond.types,
+                cond.condition);
+      }
+    }
+
+    built=true;
+  }
+
+  void TypeConditionIndex::Clear()
+  {
+    rules.clear();
+    tagEntries.clear();
+    unindexedRules.clear();
+    built=false;
+  }
+
+  /**
+   * Returns the first rule (in the order of the types and their conditions) that
+   * is fulfilled by the given tags or nullptr, if there is none.
+   */
+  const TypeConditionIndex::Rule* TypeConditionIndex::Match(const TagMap& tagMap) const
+  {
+    uint32_t              match=std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> candidates;
+
+    auto collect=[this,&match,&candidates](const RuleList& ruleList) {
+      for (uint32_t ruleIndex : ruleList) {
+        if (ruleIndex>=match) {
+          break;
+        }
+
+        if (rules[ruleIndex].exact) {
+          match=ruleIndex;
+          break;
+        }
+
+        candidates.push_back(ruleIndex);
+      }
+    };
+
+    for (const auto& [tag,value] : tagMap) {
+      if (tag>=tagEntries.size()) {
+        continue;
+      }
+
+      const TagEntry& entry=tagEntries[tag];
+
+      collect(entry.rules);
+
+      if (!entry.valueRules.empty()) {
+        if (auto valueEntry=entry.valueRules.find(value);
+            valueEntry!=entry.valueRules.end()) {
+          collect(valueEntry->second);
+        }
+      }
+    }
+
+    collect(unindexedRules);
+
+    // Only candidates before the best exact match need to be evaluated
+    std::sort(candidates.begin(),
+              candidates.end());
+    candidates.erase(std::unique(candidates.begin(),
+                                 candidates.end()),
+                     candidates.end());
+
+    for (uint32_t ruleIndex : candidates) {
+      if (ruleIndex>=match) {
+        break;
+      }
+
+      if (rules[ruleIndex].condition->Evaluate(tagMap)) {
+        match=ruleIndex;
+        break;
+      }
+    }
+
+    if (match<rules.size()) {
+      return &rules[match];
+    }
+
+    return nullptr;
+  }
+}
@@ -984,6 +984,12 @@
 
     nameToTypeMap[typeInfo->GetName()]=typeInfo;
 
+    // The conditions of the new type are not part of the index
+    nodeConditionIndex.Clear();
+    wayAreaConditionIndex.Clear();
+    multipolygonConditionIndex.Clear();
+    relationConditionIndex.Clear();
+
     return typeInfo;
   }
 
@@ -1007,12 +1013,30 @@
     return {};
   }
 
+  void TypeConfig::BuildConditionIndex()
+  {
+    nodeConditionIndex.Build(types,
+                             TypeInfo::typeNode);
+    wayAreaConditionIndex.Build(types,
+                                TypeInfo::typeWay | TypeInfo::typeArea);
+    multipolygonConditionIndex.Build(types,
+                                     TypeInfo::typeArea);
+    relationConditionIndex.Build(types,
+                                 TypeInfo::typeRelation);
+  }
+
   TypeInfoRef TypeConfig::GetNodeType(const TagMap& tagMap) const
   {
     if (tagMap.empty()) {
       return typeInfoIgnore;
     }
 
+    if (nodeConditionIndex.IsBuilt()) {
+      const TypeConditionIndex::Rule* rule=nodeConditionIndex.Match(tagMap);
+
+      return rule!=nullptr ? rule->type : typeInfoIgnore;
+    }
+
     for (const auto &type : types) {
       if (!type->HasConditions() ||
           !type->CanBeNode()) {
@@ -1044,6 +1068,24 @@
       return false;
     }
 
+    if (wayAreaConditionIndex.IsBuilt()) {
+      const TypeConditionIndex::Rule* rule=wayAreaConditionIndex.Match(tagMap);
+
+      if (rule==nullptr) {
+        return false;
+      }
+
+      if ((rule->types & TypeInfo::typeWay)!=0) {
+        wayType=rule->type;
+      }
+
+      if ((rule->types & TypeInfo::typeArea)!=0) {
+        areaType=rule->type;
+      }
+
+      return true;
+    }
+
     for (const auto& type : types) {
       if (!((type->CanBeWay() ||
              type->CanBeArea()) &&
@@ -1089,6 +1131,12 @@
 
     if (relationType!=tagMap.end() &&
         relationType->second=="multipolygon") {
+      if (multipolygonConditionIndex.IsBuilt()) {
+        const TypeConditionIndex::Rule* rule=multipolygonConditionIndex.Match(tagMap);
+
+        return rule!=nullptr ? rule->type : typeInfoIgnore;
+      }
+
       for (const auto& type : types) {
         if (!type->HasConditions() ||
             !type->CanBeArea()) {
@@ -1107,6 +1155,12 @@
       }
     }
     else {
+      if (relationConditionIndex.IsBuilt()) {
+        const TypeConditionIndex::Rule* rule=relationConditionIndex.Match(tagMap);
+
+        return rule!=nullptr ? rule->type : typeInfoIgnore;
+      }
+
       for (const auto& type : types) {
         if (!type->HasConditions() ||
             !type->CanBeRelation()) {
@@ -1176,6 +1230,10 @@
 
       success=!parser->errors->hasErrors;
 
+      if (success) {
+        BuildConditionIndex();
+      }
+
       delete parser;
       delete scanner;
     }
@@ -1212,8 +1270,9 @@
 
       uint32_t fileFormatVersion=scanner.ReadUInt32();
 
-      if (fileFormatVersion!=FILE_FORMAT_VERSION) {
-        log.Error() << "File '" << scanner.GetFilename() << "' does not have the expected format version! Actual " << fileFormatVersion << ", expected: " << FILE_FORMAT_VERSION;
+      if (fileFormatVersion<MIN_FORMAT_VERSION ||
+          fileFormatVersion>MAX_FORMAT_VERSION) {
+        log.Error() << "File '" << scanner.GetFilename() << "' does not have the expected format version! Actual " << fileFormatVersion << ", expected: " << MIN_FORMAT_VERSION << "-" << MAX_FORMAT_VERSION;
         return false;
       }
 
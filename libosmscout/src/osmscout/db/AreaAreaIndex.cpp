@@ -21,6 +21,7 @@
 
 #include <osmscout/io/File.h>
 #include <osmscout/log/Logger.h>
+#include <osmscout/util/Metrics.h>
 #include <osmscout/util/StopClock.h>
 
 //#define ANALYZE_CACHE
@@ -61,6 +62,9 @@ namespace osmscout {
                                    IndexCell &indexCell,
                                    FileOffset &dataOffset) const
   {
+    static MetricCounter& cellReads=MetricsRegistry::Instance().GetCounter("osmscout_areaareaindex_cell_reads_total",
+                                                                           "Number of area area index cells read from disk");
+
     if (level<maxLevel) {
       std::scoped_lock<std::mutex> guard(lookupMutex);
       IndexCache::CacheRef        cacheRef;
@@ -76,6 +80,8 @@ namespace osmscout {
       if (!indexCache.GetEntry(offset,cacheRef)) {
         IndexCache::CacheEntry cacheEntry(offset);
 
+        cellReads.Increment();
+
         cacheRef=indexCache.SetEntry(cacheEntry);
 
         scanner.SetPos(offset);
@@ -254,6 +260,10 @@ namespace osmscout {
                                      std::vector<DataBlockSpan>& spans,
                                      TypeInfoSet& loadedTypes) const
   {
+    static MetricHistogram& latency=MetricsRegistry::Instance().GetHistogram("osmscout_areaareaindex_lookup_microseconds",
+                                                                             "Duration of area lookups in the area area index");
+
+    MetricTimer          timer(latency);
     StopClock            time;
 
     std::vector<CellRef> cellRefs;     // cells to scan in this level
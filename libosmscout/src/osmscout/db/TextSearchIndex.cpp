@@ -1,5 +1,11 @@
 #include <osmscout/db/TextSearchIndex.h>
 
+#include <algorithm>
+#include <future>
+#include <set>
+#include <string_view>
+#include <tuple>
+
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/String.h>
 
@@ -12,6 +18,397 @@ namespace osmscout
   const char* const TextSearchIndex::TEXT_REGION_DAT="textregion.dat";
   const char* const TextSearchIndex::TEXT_OTHER_DAT="textother.dat";
 
+  namespace {
+
+    /**
+     * Returns the number of bytes of the UTF-8 character starting at the given
+     * position. Invalid sequences are treated as single byte characters.
+     */
+    size_t GetUTF8CharacterLength(std::string_view text,
+                                  size_t pos)
+    {
+      auto   lead=static_cast<unsigned char>(text[pos]);
+      size_t length=1;
+
+      if ((lead & 0xe0)==0xc0) {
+        length=2;
+      }
+      else if ((lead & 0xf0)==0xe0) {
+        length=3;
+      }
+      else if ((lead & 0xf8)==0xf0) {
+        length=4;
+      }
+
+      if (pos+length>text.length()) {
+        return 1;
+      }
+
+      for (size_t i=1; i<length; i++) {
+        if ((static_cast<unsigned char>(text[pos+i]) & 0xc0)!=0x80) {
+          return 1;
+        }
+      }
+
+      return length;
+    }
+
+    /**
+     * Split the UTF-8 text into its characters. Each character is returned
+     * as its UTF-8 byte sequence. Invalid sequences are returned byte by byte.
+     */
+    std::vector<std::string> SplitUTF8Characters(const std::string& text)
+    {
+      std::vector<std::string> characters;
+
+      characters.reserve(text.length());
+
+      size_t pos=0;
+      while (pos<text.length()) {
+        size_t length=GetUTF8CharacterLength(text,pos);
+
+        characters.push_back(text.substr(pos,length));
+        pos+=length;
+      }
+
+      return characters;
+    }
+
+    /**
+     * Collects the best results of a fuzzy search. Results are ranked by
+     * edit distance, then by text length (shorter texts are closer to a complete match)
+     * and finally by text for a stable order. If the limit is reached, the worst
+     * result is evicted.
+     */
+    class FuzzyTopK
+    {
+    private:
+      using Rank = std::tuple<size_t,size_t,std::string>;
+
+    private:
+      size_t                                                          limit;
+      std::unordered_map<std::string,TextSearchIndex::FuzzyResult>    entries;
+      std::set<Rank>                                                  ranking;
+
+    public:
+      explicit FuzzyTopK(size_t limit)
+      : limit(limit)
+      {
+        // no code
+      }
+
+      bool IsFull() const
+      {
+        return limit>0 && ranking.size()>=limit;
+      }
+
+      /**
+       * Returns the maximum distance, a new result may have, to still enter the result
+       */
+      size_t GetBound(size_t maxDistance) const
+      {
+        if (IsFull()) {
+          return std::min(maxDistance,std::get<0>(*ranking.rbegin()));
+        }
+
+        return maxDistance;
+      }
+
+      void Add(const std::string& text,
+               size_t distance,
+               const ObjectFileRef& ref)
+      {
+        auto entry=entries.find(text);
+
+        if (entry!=entries.end()) {
+          if (distance<entry->second.distance) {
+            ranking.erase(Rank(entry->second.distance,text.length(),text));
+            entry->second.distance=distance;
+            ranking.emplace(distance,text.length(),text);
+          }
+
+          if (std::find(entry->second.refs.begin(),
+                        entry->second.refs.end(),
+                        ref)==entry->second.refs.end()) {
+            entry->second.refs.push_back(ref);
+          }
+
+          return;
+        }
+
+        if (IsFull()) {
+          auto worst=std::prev(ranking.end());
+
+          if (!(Rank(distance,text.length(),text)<*worst)) {
+            return;
+          }
+
+          entries.erase(std::get<2>(*worst));
+          ranking.erase(worst);
+        }
+
+        TextSearchIndex::FuzzyResult result;
+
+        result.text=text;
+        result.distance=distance;
+        result.refs.push_back(ref);
+
+        entries.emplace(text,std::move(result));
+        ranking.emplace(distance,text.length(),text);
+      }
+
+      std::vector<TextSearchIndex::FuzzyResult> GetResults()
+      {
+        std::vector<TextSearchIndex::FuzzyResult> results;
+
+        results.reserve(ranking.size());
+
+        for (const auto& rank : ranking) {
+          results.push_back(std::move(entries[std::get<2>(rank)]));
+        }
+
+        return results;
+      }
+    };
+
+    /**
+     * Depth first traversal of a trie, that follows all prefixes, that are within the
+     * maximum (Damerau-)Levenshtein distance of a prefix of the query.
+     * The distance matrix is calculated row by row, one row per traversed character.
+     *
+     * The public marisa API does not give access to the children of a prefix, so a child
+     * is found by a predictive search for the prefix extended by the character. The
+     * characters of the query are probed first. All other characters result in the same
+     * row, so they are only probed, if this row is within the bound. Branches are cut as
+     * soon as the minimum of the current row exceeds the bound.
+     */
+    class FuzzyTraversal
+    {
+    private:
+      const marisa::Trie&             trie;
+      const std::vector<std::string>& query;
+      std::vector<std::string>        queryCharacters; //!< Distinct characters of the query
+      size_t                          maxDistance;
+      const FuzzyTopK&                topK;
+      marisa::Agent                   agent;
+
+    private:
+      bool HasPrefix(const std::string& prefix)
+      {
+        agent.set_query(prefix.c_str(),
+                        prefix.length());
+
+        return trie.predictive_search(agent);
+      }
+
+      bool IsQueryCharacter(std::string_view character) const
+      {
+        return std::find(queryCharacters.begin(),
+                         queryCharacters.end(),
+                         character)!=queryCharacters.end();
+      }
+
+      /**
+       * Calculate the next row of the distance matrix for the given character and
+       * return its minimum. An empty character stands for any character not
+       * part of the query.
+       */
+      size_t CalculateRow(const std::vector<size_t>& prevRow,
+                          const std::vector<size_t>& row,
+                          std::string_view lastCharacter,
+                          std::string_view character,
+                          std::vector<size_t>& nextRow) const
+      {
+        nextRow[0]=row[0]+1;
+
+        size_t nextMin=nextRow[0];
+
+        for (size_t j=1; j<row.size(); j++) {
+          size_t cost=query[j-1]==character ? 0 : 1;
+
+          nextRow[j]=std::min({row[j]+1,
+                               nextRow[j-1]+1,
+                               row[j-1]+cost});
+
+          // transposition of two adjacent characters
+          if (j>1 &&
+              !lastCharacter.empty() &&
+              query[j-2]==character &&
+              query[j-1]==lastCharacter) {
+            nextRow[j]=std::min(nextRow[j],
+                                prevRow[j-2]+1);
+          }
+
+          nextMin=std::min(nextMin,nextRow[j]);
+        }
+
+        return nextMin;
+      }
+
+      /**
+       * Complete the UTF-8 character at the end of the prefix, that still misses
+       * the given number of continuation bytes, and call callback for each
+       * completion found in the trie
+       */
+      template<class Callback>
+      void ForEachContinuation(std::string& prefix,
+                               size_t missingBytes,
+                               Callback& callback)
+      {
+        if (missingBytes==0) {
+          callback();
+          return;
+        }
+
+        for (unsigned int byte=0x80; byte<0xc0; byte++) {
+          prefix.push_back(static_cast<char>(byte));
+
+          if (HasPrefix(prefix)) {
+            ForEachContinuation(prefix,
+                                missingBytes-1,
+                                callback);
+          }
+
+          prefix.pop_back();
+        }
+      }
+
+      /**
+       * Call callback for each character following the prefix in the trie. The
+       * character is appended to the prefix during the call. Control characters
+       * are skipped, they separate the text from the object reference.
+       */
+      template<class Callback>
+      void ForEachCharacter(std::string& prefix,
+                            Callback& callback)
+      {
+        for (unsigned int lead=0x20; lead<0xf5; lead++) {
+          // Continuation bytes and overlong encodings cannot start a character
+          if (lead>=0x80 &&
+              lead<0xc2) {
+            continue;
+          }
+
+          prefix.push_back(static_cast<char>(lead));
+
+          if (HasPrefix(prefix)) {
+            size_t missingBytes=0;
+
+            if (lead>=0xf0) {
+              missingBytes=3;
+            }
+            else if (lead>=0xe0) {
+              missingBytes=2;
+            }
+            else if (lead>=0x80) {
+              missingBytes=1;
+            }
+
+            ForEachContinuation(prefix,
+                                missingBytes,
+                                callback);
+          }
+
+          prefix.pop_back();
+        }
+      }
+
+    public:
+      FuzzyTraversal(const marisa::Trie& trie,
+                     const std::vector<std::string>& query,
+                     size_t maxDistance,
+                     const FuzzyTopK& topK)
+      : trie(trie),
+        query(query),
+        maxDistance(maxDistance),
+        topK(topK)
+      {
+        for (const auto& character : query) {
+          if (!IsQueryCharacter(character)) {
+            queryCharacters.push_back(character);
+          }
+        }
+      }
+
+      /**
+       * Visit the prefix, that is known to exist in the trie
+       */
+      template<class Collect>
+      void Visit(std::string& prefix,
+                 const std::vector<size_t>& prevRow,
+                 const std::vector<size_t>& row,
+                 const std::string& lastCharacter,
+                 Collect& collect)
+      {
+        size_t distance=row.back();
+
+        if (distance<=topK.GetBound(maxDistance)) {
+          collect(prefix,distance);
+        }
+
+        size_t bound=topK.GetBound(maxDistance);
+        size_t rowMin=*std::min_element(row.begin(),row.end());
+
+        // Going deeper can only increase the minimum of the row, so we stop,
+        // if we cannot get a better distance than the current one
+        if (rowMin>bound ||
+            rowMin>=distance) {
+          return;
+        }
+
+        size_t              prefixLength=prefix.length();
+        std::vector<size_t> nextRow(row.size());
+
+        // The character to visit has already been appended to the prefix
+        auto visitChild=[&]() {
+          std::string character=prefix.substr(prefixLength);
+
+          if (CalculateRow(prevRow,
+                           row,
+                           lastCharacter,
+                           character,
+                           nextRow)<=bound) {
+            Visit(prefix,
+                  row,
+                  nextRow,
+                  character,
+                  collect);
+
+            bound=topK.GetBound(maxDistance);
+          }
+        };
+
+        // Matching characters first, they fill the top k early and so lower the bound
+        for (const auto& character : queryCharacters) {
+          prefix.append(character);
+
+          if (HasPrefix(prefix)) {
+            visitChild();
+          }
+
+          prefix.resize(prefixLength);
+        }
+
+        if (CalculateRow(prevRow,
+                         row,
+                         lastCharacter,
+                         std::string_view(),
+                         nextRow)>bound) {
+          return;
+        }
+
+        auto visitOtherChild=[&]() {
+          if (!IsQueryCharacter(std::string_view(prefix).substr(prefixLength))) {
+            visitChild();
+          }
+        };
+
+        ForEachCharacter(prefix,
+                         visitOtherChild);
+      }
+    };
+  }
+
   TextSearchIndex::~TextSearchIndex()
   {
     for (auto & trie : tries) {
@@ -124,6 +521,25 @@ namespace osmscout
       return true;
     }
 
+    for (size_t trieIndex : GetSearchTries(searchPOIs,
+                                           searchLocations,
+                                           searchRegions,
+                                           searchOther)) {
+      if (!SearchTrie(tries[trieIndex],
+                      lookupStr,
+                      results)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  std::vector<size_t> TextSearchIndex::GetSearchTries(bool searchPOIs,
+                                                      bool searchLocations,
+                                                      bool searchRegions,
+                                                      bool searchOther) const
+  {
     std::vector<bool> searchGroups;
 
     searchGroups.push_back(searchPOIs);
@@ -131,43 +547,292 @@ namespace osmscout
     searchGroups.push_back(searchRegions);
     searchGroups.push_back(searchOther);
 
+    std::vector<size_t> searchTries;
+
     for (size_t i=0; i<tries.size(); i++) {
       if (searchGroups[i] && tries[i].isAvail) {
-        marisa::Agent agent;
+        searchTries.push_back(i);
+      }
+    }
+
+    return searchTries;
+  }
+
+  bool TextSearchIndex::SearchTrie(const TrieInfo& trie,
+                                   const std::string& lookupStr,
+                                   ResultsMap& results) const
+  {
+    marisa::Agent agent;
+
+    try {
+      agent.set_query(lookupStr.c_str(),
+                      lookupStr.length());
+      while (trie.trie->predictive_search(agent)) {
+        std::string   result(agent.key().ptr(),
+                             agent.key().length());
+        std::string   text;
+        ObjectFileRef ref;
+
+        splitSearchResult(result,text,ref);
+
+        auto it=results.find(text);
+        if (it==results.end()) {
+          // If the text has not been added to the
+          // search results yet, insert a new entry
+          std::pair<std::string,std::vector<ObjectFileRef>> entry;
+          entry.first=text;
+          entry.second.push_back(ref);
+          results.insert(entry);
+        }
+        else {
+          // Else add the offset to the existing entry
+          it->second.push_back(ref);
+        }
+      }
+    }
+    catch (const marisa::Exception &ex) {
+      log.Error() << "Error searching for text: " << ex.what();
+
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Returns a maximum edit distance suitable for search as you type:
+   * no typos for very short queries, one typo for up to six characters,
+   * two typos for longer queries.
+   */
+  size_t TextSearchIndex::GetDefaultMaxDistance(const std::string& query)
+  {
+    size_t length=SplitUTF8Characters(query).size();
+
+    if (length<=3) {
+      return 0;
+    }
+
+    if (length<=6) {
+      return 1;
+    }
+
+    return 2;
+  }
+
+  /**
+   * Search for all texts, which have a prefix within the given maximum
+   * (Damerau-)Levenshtein distance of the query. Results are ranked
+   * by distance and text length and only the best \p limit results are returned
+   * (0 for no limit). The tries are searched in parallel.
+   *
+   * The maximum distance is capped to the number of characters of the query
+   * minus one, since otherwise every text would match.
+   */
+  bool TextSearchIndex::SearchFuzzy(const std::string& query,
+                                    bool searchPOIs,
+                                    bool searchLocations,
+                                    bool searchRegions,
+                                    bool searchOther,
+                                    bool transliterate,
+                                    size_t maxDistance,
+                                    size_t limit,
+                                    std::vector<FuzzyResult>& results) const
+  {
+    results.clear();
+
+    std::string lookupStr=UTF8NormForLookup(query);
+    if (transliterate) {
+      lookupStr=UTF8Transliterate(lookupStr);
+    }
+
+    if (lookupStr.empty()) {
+      return true;
+    }
+
+    std::vector<size_t> searchTries=GetSearchTries(searchPOIs,
+                                                   searchLocations,
+                                                   searchRegions,
+                                                   searchOther);
+
+    if (searchTries.empty()) {
+      return true;
+    }
+
+    if (searchTries.size()==1) {
+      return SearchTrieFuzzy(searchTries.front(),
+                             lookupStr,
+                             maxDistance,
+                             limit,
+                             results);
+    }
+
+    std::vector<std::vector<FuzzyResult>> trieResults(searchTries.size());
+    std::vector<std::future<bool>>        workers;
+
+    workers.reserve(searchTries.size());
+
+    for (size_t i=0; i<searchTries.size(); i++) {
+      workers.push_back(std::async(std::launch::async,
+                                   [this,&lookupStr,&trieResults,&searchTries,maxDistance,limit,i]() {
+                                     return SearchTrieFuzzy(searchTries[i],
+                                                            lookupStr,
+                                                            maxDistance,
+                                                            limit,
+                                                            trieResults[i]);
+                                   }));
+    }
 
-        try {
-          agent.set_query(lookupStr.c_str(),
-                          lookupStr.length());
-          while (tries[i].trie->predictive_search(agent)) {
-            std::string   result(agent.key().ptr(),
-                                 agent.key().length());
+    bool success=true;
+
+    for (auto& worker : workers) {
+      success=worker.get() && success;
+    }
+
+    if (!success) {
+      return false;
+    }
+
+    // Merge the per trie results, the same text may be indexed in multiple tries
+    std::unordered_map<std::string,size_t> resultIndex;
+
+    for (auto& trieResult : trieResults) {
+      for (auto& result : trieResult) {
+        auto entry=resultIndex.find(result.text);
+
+        if (entry==resultIndex.end()) {
+          resultIndex.emplace(result.text,results.size());
+          results.push_back(std::move(result));
+        }
+        else {
+          FuzzyResult& existing=results[entry->second];
+
+          existing.distance=std::min(existing.distance,result.distance);
+          existing.refs.insert(existing.refs.end(),
+                               result.refs.begin(),
+                               result.refs.end());
+        }
+      }
+    }
+
+    std::sort(results.begin(),
+              results.end(),
+              [](const FuzzyResult& a, const FuzzyResult& b) {
+                if (a.distance!=b.distance) {
+                  return a.distance<b.distance;
+                }
+
+                if (a.text.length()!=b.text.length()) {
+                  return a.text.length()<b.text.length();
+                }
+
+                return a.text<b.text;
+              });
+
+    if (limit>0 &&
+        results.size()>limit) {
+      results.resize(limit);
+    }
+
+    return true;
+  }
+
+  bool TextSearchIndex::SearchTrieFuzzy(size_t trieIndex,
+                                        const std::string& lookupStr,
+                                        size_t maxDistance,
+                                        size_t limit,
+                                        std::vector<FuzzyResult>& results) const
+  {
+    // Upper bound for the number of keys enumerated below one matching prefix,
+    // to keep latency bounded for very short prefixes in large tries
+    constexpr size_t enumerationLimitFactor=16;
+
+    std::vector<std::string> query=SplitUTF8Characters(lookupStr);
+    const marisa::Trie&      trie=*tries[trieIndex].trie;
+    FuzzyTopK                topK(limit);
+    size_t                   enumerationLimit=limit>0 ? std::max<size_t>(limit*enumerationLimitFactor,256) : 0;
+
+    maxDistance=std::min(maxDistance,query.size()-1);
+
+    auto collect=[this,&trie,&topK,enumerationLimit](const std::string& prefix,
+                                                   size_t distance) {
+      marisa::Agent agent;
+      size_t        count=0;
+
+      agent.set_query(prefix.c_str(),
+                      prefix.length());
+
+      while (trie.predictive_search(agent)) {
+        std::string   result(agent.key().ptr(),
+                             agent.key().length());
+        std::string   text;
+        ObjectFileRef ref;
+
+        splitSearchResult(result,text,ref);
+
+        topK.Add(text,distance,ref);
+
+        count++;
+
+        if (enumerationLimit>0 &&
+            count>=enumerationLimit) {
+          break;
+        }
+      }
+    };
+
+    try {
+      FuzzyTraversal      traversal(trie,
+                                    query,
+                                    maxDistance,
+                                    topK);
+      std::string         prefix;
+      std::vector<size_t> row(query.size()+1);
+
+      for (size_t j=0; j<row.size(); j++) {
+        row[j]=j;
+      }
+
+      traversal.Visit(prefix,
+                      row,
+                      row,
+                      std::string(),
+                      collect);
+
+      results=topK.GetResults();
+
+      // The enumeration below a prefix is limited, so the objects of the ranked texts
+      // are collected completely by searching for the text followed by the reference type
+      for (auto& result : results) {
+        result.refs.clear();
+
+        for (RefType type : {refNode,refArea,refWay}) {
+          std::string   key=result.text;
+          marisa::Agent agent;
+
+          key.push_back(static_cast<char>(type));
+
+          agent.set_query(key.c_str(),
+                          key.length());
+
+          while (trie.predictive_search(agent)) {
             std::string   text;
             ObjectFileRef ref;
 
-            splitSearchResult(result,text,ref);
+            splitSearchResult(std::string(agent.key().ptr(),
+                                          agent.key().length()),
+                              text,
+                              ref);
 
-            auto it=results.find(text);
-            if (it==results.end()) {
-              // If the text has not been added to the
-              // search results yet, insert a new entry
-              std::pair<std::string,std::vector<ObjectFileRef>> entry;
-              entry.first=text;
-              entry.second.push_back(ref);
-              results.insert(entry);
-            }
-            else {
-              // Else add the offset to the existing entry
-              it->second.push_back(ref);
-            }
+            result.refs.push_back(ref);
           }
         }
-        catch (const marisa::Exception &ex) {
-          log.Error() << "Error searching for text: " << ex.what();
-
-          return false;
-        }
       }
     }
+    catch (const marisa::Exception &ex) {
+      log.Error() << "Error searching for text: " << ex.what();
+
+      return false;
+    }
 
     return true;
   }
@@ -107,7 +107,7 @@ namespace osmscout {
         }
       }
       else {
-        errorReporter.ReportTag(object,tags,std::string("Admin level is not numeric '")+adminLevel->second+"'!");
+        errorReporter.ReportTag(object,tags,std::string("Admin level is not numeric '")+std::string(adminLevel->second)+"'!");
       }
     }
   }
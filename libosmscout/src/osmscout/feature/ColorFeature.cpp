@@ -103,7 +103,7 @@ namespace osmscout {
     } else if (auto symbol=tags.find(tagSymbol);
                symbol!=tags.end() && !symbol->second.empty()) {
 
-      colorString=GetFirstInStringList(symbol->second, ":"s);
+      colorString=GetFirstInStringList(std::string(symbol->second), ":"s);
     }
 
     if (!colorString.empty()){
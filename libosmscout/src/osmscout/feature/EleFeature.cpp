@@ -141,7 +141,7 @@ namespace osmscout {
       return;
     }
 
-    std::string eleString=ele->second;
+    std::string eleString(ele->second);
     double      e;
     size_t      pos=0;
     size_t      count=0;
@@ -172,10 +172,10 @@ namespace osmscout {
     }
 
     if (!StringToNumber(eleString,e)) {
-      errorReporter.ReportTag(object,tags,std::string("Ele tag value '")+ele->second+"' is no double!");
+      errorReporter.ReportTag(object,tags,std::string("Ele tag value '")+std::string(ele->second)+"' is no double!");
     }
     else if (e<std::numeric_limits<int16_t>::min() || e>std::numeric_limits<int16_t>::max()) {
-      errorReporter.ReportTag(object,tags,std::string("Ele tag value '")+ele->second+"' value is too small or too big!");
+      errorReporter.ReportTag(object,tags,std::string("Ele tag value '")+std::string(ele->second)+"' value is too small or too big!");
     }
     else {
       auto* value=static_cast<EleFeatureValue*>(buffer.AllocateValue(feature.GetIndex()));
@@ -127,7 +127,7 @@ namespace osmscout {
         return;
       }
 
-      errorReporter.ReportTag(object,tags,std::string("Unsupported tracktype value '")+tracktype->second+"'");
+      errorReporter.ReportTag(object,tags,std::string("Unsupported tracktype value '")+std::string(tracktype->second)+"'");
     }
 
     auto surface=tags.find(tagSurface);
@@ -135,14 +135,14 @@ namespace osmscout {
     if (surface!=tags.end()) {
       size_t grade;
 
-      if (tagRegistry.GetGradeForSurface(surface->second,
+      if (tagRegistry.GetGradeForSurface(std::string(surface->second),
                                          grade)) {
         auto* value=static_cast<GradeFeatureValue*>(buffer.AllocateValue(feature.GetIndex()));
 
         value->SetGrade((uint8_t)grade);
       }
       else {
-        errorReporter.ReportTag(object,tags,std::string("Unknown surface type '")+surface->second+"' !");
+        errorReporter.ReportTag(object,tags,std::string("Unknown surface type '")+std::string(surface->second)+"' !");
       }
     }
   }
@@ -187,21 +187,21 @@ namespace osmscout {
 
     if (lanesTag!=tags.end() &&
       !StringToNumber(lanesTag->second,lanes)) {
-      errorReporter.ReportTag(object,tags,std::string("lanes tag value '")+lanesTag->second+"' is not numeric!");
+      errorReporter.ReportTag(object,tags,std::string("lanes tag value '")+std::string(lanesTag->second)+"' is not numeric!");
 
       return;
     }
 
     if (lanesForwardTag!=tags.end() &&
         !StringToNumber(lanesForwardTag->second,lanesForward)) {
-      errorReporter.ReportTag(object,tags,std::string("lanes:forward tag value '")+lanesForwardTag->second+"' is not numeric!");
+      errorReporter.ReportTag(object,tags,std::string("lanes:forward tag value '")+std::string(lanesForwardTag->second)+"' is not numeric!");
 
       return;
     }
 
     if (lanesBackwardTag!=tags.end() &&
         !StringToNumber(lanesBackwardTag->second,lanesBackward)) {
-      errorReporter.ReportTag(object,tags,std::string("lanes:backward tag value '")+lanesBackwardTag->second+"' is not numeric!");
+      errorReporter.ReportTag(object,tags,std::string("lanes:backward tag value '")+std::string(lanesBackwardTag->second)+"' is not numeric!");
 
       return;
     }
@@ -255,7 +255,7 @@ namespace osmscout {
         lanesBackwardTag!=tags.end() &&
         lanesTag!=tags.end()) {
       if (lanesForward+lanesBackward!=lanes) {
-        errorReporter.ReportTag(object,tags,std::string("lanes tag value '")+lanesTag->second+"' is not equal sum of lanes:forward and lanes:backward");
+        errorReporter.ReportTag(object,tags,std::string("lanes tag value '")+std::string(lanesTag->second)+"' is not equal sum of lanes:forward and lanes:backward");
       }
     }
     else if (lanesForwardTag!=tags.end() &&
@@ -98,7 +98,7 @@ namespace osmscout {
         }
       }
       else {
-        errorReporter.ReportTag(object,tags,std::string("Layer tag value '")+layer->second+"' is not numeric!");
+        errorReporter.ReportTag(object,tags,std::string("Layer tag value '")+std::string(layer->second)+"' is not numeric!");
       }
     }
   }
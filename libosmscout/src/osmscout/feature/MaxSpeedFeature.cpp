@@ -84,7 +84,7 @@ namespace osmscout {
                                     const TagRegistry& tagRegistry,
                                     const ObjectOSMRef& object,
                                     const TagMap& tags,
-                                    const std::string& input, uint8_t& speed) const
+                                    std::string_view input, uint8_t& speed) const
   {
     std::string valueString(input);
     size_t      valueNumeric;
@@ -134,7 +134,7 @@ namespace osmscout {
         valueNumeric=maxSpeedValue;
       }
       else {
-        errorReporter.ReportTag(object,tags,std::string("Max speed tag value '")+input+"' is not numeric!");
+        errorReporter.ReportTag(object,tags,std::string("Max speed tag value '")+std::string(input)+"' is not numeric!");
         return false;
       }
     }
@@ -112,7 +112,7 @@ namespace osmscout {
         continue;
       }
 
-      std::string phoneStr=phone->second;
+      std::string phoneStr(phone->second);
       // remove invalid characters from phone number [0123456789+;,] http://wiki.openstreetmap.org/wiki/Key:phone
       // - there can be multiple phone numbers separated by semicolon (some mappers use comma)
       phoneStr.erase(
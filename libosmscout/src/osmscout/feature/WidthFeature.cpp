@@ -91,7 +91,7 @@ namespace osmscout {
       return;
     }
 
-    std::string widthString=width->second;
+    std::string widthString(width->second);
     double      w;
     size_t      pos=0;
     size_t      count=0;
@@ -126,10 +126,10 @@ namespace osmscout {
     }
 
     if (!StringToNumber(widthString,w)) {
-      errorReporter.ReportTag(object,tags,std::string("Width tag value '")+width->second+"' is no double!");
+      errorReporter.ReportTag(object,tags,std::string("Width tag value '")+std::string(width->second)+"' is no double!");
     }
     else if (w<0 || w>255.5) {
-      errorReporter.ReportTag(object,tags,std::string("Width tag value '")+width->second+"' value is too small or too big!");
+      errorReporter.ReportTag(object,tags,std::string("Width tag value '")+std::string(width->second)+"' value is too small or too big!");
     }
     else {
       auto* value=static_cast<WidthFeatureValue*>(buffer.AllocateValue(feature.GetIndex()));
@@ -0,0 +1,239 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/io/BlockCoordEncoding.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace osmscout {
+
+  static uint32_t EncodeZigZag(int32_t value)
+  {
+    return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+  }
+
+  /**
+   * Calculate the bit widths of the lat and lon deltas of the given block
+   */
+  static void GetBlockWidths(const std::vector<int32_t>& deltas,
+                             size_t block,
+                             uint8_t& latWidth,
+                             uint8_t& lonWidth)
+  {
+    size_t   start=block*blockCoordDeltaCount*2;
+    size_t   end=std::min(start+blockCoordDeltaCount*2,deltas.size());
+    uint32_t latMax=0;
+    uint32_t lonMax=0;
+
+    for (size_t i=start; i<end; i+=2) {
+      latMax=std::max(latMax,EncodeZigZag(deltas[i]));
+      lonMax=std::max(lonMax,EncodeZigZag(deltas[i+1]));
+    }
+
+    latWidth=uint8_t(std::bit_width(latMax));
+    lonWidth=uint8_t(std::bit_width(lonMax));
+  }
+
+  size_t GetBlockCoordDataSize(size_t deltaCount,
+                               const uint8_t* widths)
+  {
+    size_t blockCount=GetBlockCoordBlockCount(deltaCount);
+    size_t bits=0;
+
+    for (size_t block=0; block<blockCount; block++) {
+      size_t count=std::min(blockCoordDeltaCount,deltaCount-block*blockCoordDeltaCount);
+
+      bits+=count*(widths[block*2]+widths[block*2+1]);
+    }
+
+    return (bits+7)/8;
+  }
+
+  size_t GetBlockCoordEncodedSize(const std::vector<int32_t>& deltas)
+  {
+    size_t deltaCount=deltas.size()/2;
+    size_t blockCount=GetBlockCoordBlockCount(deltaCount);
+    size_t bits=0;
+
+    for (size_t block=0; block<blockCount; block++) {
+      size_t  count=std::min(blockCoordDeltaCount,deltaCount-block*blockCoordDeltaCount);
+      uint8_t latWidth;
+      uint8_t lonWidth;
+
+      GetBlockWidths(deltas,block,latWidth,lonWidth);
+
+      bits+=count*(latWidth+lonWidth);
+    }
+
+    return blockCount*2+(bits+7)/8;
+  }
+
+  void EncodeBlockCoords(const std::vector<int32_t>& deltas,
+                         std::vector<uint8_t>& buffer)
+  {
+    size_t deltaCount=deltas.size()/2;
+    size_t blockCount=GetBlockCoordBlockCount(deltaCount);
+
+    buffer.resize(blockCount*2);
+
+    for (size_t block=0; block<blockCount; block++) {
+      GetBlockWidths(deltas,block,buffer[block*2],buffer[block*2+1]);
+    }
+
+    buffer.resize(blockCount*2+GetBlockCoordDataSize(deltaCount,buffer.data()),0);
+
+    uint8_t* data=buffer.data()+blockCount*2;
+    uint64_t bits=0;
+    size_t   bitCount=0;
+
+    auto append=[&data,&bits,&bitCount](uint32_t value, uint8_t width) {
+      bits|=uint64_t(value) << bitCount;
+      bitCount+=width;
+
+      while (bitCount>=8) {
+        *data=uint8_t(bits);
+        data++;
+        bits>>=8;
+        bitCount-=8;
+      }
+    };
+
+    for (size_t block=0; block<blockCount; block++) {
+      size_t  start=block*blockCoordDeltaCount*2;
+      size_t  end=std::min(start+blockCoordDeltaCount*2,deltas.size());
+      uint8_t latWidth=buffer[block*2];
+      uint8_t lonWidth=buffer[block*2+1];
+
+      for (size_t i=start; i<end; i+=2) {
+        append(EncodeZigZag(deltas[i]),latWidth);
+      }
+
+      for (size_t i=start+1; i<end; i+=2) {
+        append(EncodeZigZag(deltas[i]),lonWidth);
+      }
+    }
+
+    if (bitCount>0) {
+      *data=uint8_t(bits);
+    }
+  }
+
+  static uint32_t DecodeZigZag(uint32_t value)
+  {
+    return (value >> 1) ^ (0u-(value & 1u));
+  }
+
+  /**
+   * Return the 64 bits starting at the given byte position, missing bytes after the end of
+   * the data are zero
+   */
+  static uint64_t LoadBits(const uint8_t* data,
+                           size_t dataSize,
+                           size_t bytePos)
+  {
+    uint64_t value=0;
+    size_t   end=std::min(bytePos+sizeof(value),dataSize);
+
+    for (size_t i=bytePos; i<end; i++) {
+      value|=uint64_t(data[i]) << ((i-bytePos)*8);
+    }
+
+    return value;
+  }
+
+  /**
+   * Decode the given number of (lat,lon) deltas of a block
+   */
+  template<bool checked>
+  static void DecodeBlock(const uint8_t* data,
+                          size_t dataSize,
+                          size_t latPos,
+                          uint8_t latWidth,
+                          uint8_t lonWidth,
+                          size_t count,
+                          uint32_t& lat,
+                          uint32_t& lon,
+                          uint32_t& usedBits,
+                          Point* points)
+  {
+    uint64_t latMask=(uint64_t(1) << latWidth)-1;
+    uint64_t lonMask=(uint64_t(1) << lonWidth)-1;
+    size_t   lonPos=latPos+count*latWidth;
+
+    for (size_t i=0; i<count; i++) {
+      uint64_t latBits;
+      uint64_t lonBits;
+
+      if constexpr (checked) {
+        latBits=LoadBits(data,dataSize,latPos/8);
+        lonBits=LoadBits(data,dataSize,lonPos/8);
+      }
+      else {
+        std::memcpy(&latBits,data+latPos/8,sizeof(latBits));
+        std::memcpy(&lonBits,data+lonPos/8,sizeof(lonBits));
+      }
+
+      lat+=DecodeZigZag(uint32_t((latBits >> (latPos%8)) & latMask));
+      lon+=DecodeZigZag(uint32_t((lonBits >> (lonPos%8)) & lonMask));
+
+      usedBits|=lat | lon;
+
+      points[i].SetCoord(GeoCoord(lat/latConversionFactor-90.0,
+                                  lon/lonConversionFactor-180.0));
+
+      latPos+=latWidth;
+      lonPos+=lonWidth;
+    }
+  }
+
+  bool DecodeBlockCoords(const uint8_t* widths,
+                         const uint8_t* data,
+                         size_t dataSize,
+                         size_t deltaCount,
+                         uint32_t lat,
+                         uint32_t lon,
+                         Point* points)
+  {
+    size_t   blockCount=GetBlockCoordBlockCount(deltaCount);
+    size_t   bitPos=0;
+    uint32_t usedBits=0;
+
+    for (size_t block=0; block<blockCount; block++) {
+      size_t  count=std::min(blockCoordDeltaCount,deltaCount-block*blockCoordDeltaCount);
+      uint8_t latWidth=widths[block*2];
+      uint8_t lonWidth=widths[block*2+1];
+      size_t  blockBits=count*(latWidth+lonWidth);
+
+      // Unaligned 64 bit loads, as long as they do not read beyond the end of the data
+      if (std::endian::native==std::endian::little &&
+          (bitPos+blockBits)/8+blockCoordDataPadding<=dataSize) {
+        DecodeBlock<false>(data,dataSize,bitPos,latWidth,lonWidth,count,lat,lon,usedBits,points+1+block*blockCoordDeltaCount);
+      }
+      else {
+        DecodeBlock<true>(data,dataSize,bitPos,latWidth,lonWidth,count,lat,lon,usedBits,points+1+block*blockCoordDeltaCount);
+      }
+
+      bitPos+=blockBits;
+    }
+
+    return (usedBits & ~maxRawCoordValue)==0;
+  }
+}
@@ -0,0 +1,59 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/io/DataReadPlan.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace osmscout {
+
+  DataReadPlan::DataReadPlan(const std::vector<FileOffset>& offsets,
+                             FileOffset maxGap,
+                             FileOffset tailSize)
+  : order(offsets.size())
+  {
+    std::iota(order.begin(),order.end(),0);
+
+    // Stable, so that equal offsets are read in request order
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&offsets](size_t a, size_t b) {
+                       return offsets[a]<offsets[b];
+                     });
+
+    size_t first=0;
+
+    while (first<order.size()) {
+      size_t last=first+1;
+
+      while (last<order.size() &&
+             offsets[order[last]]-offsets[order[last-1]]<=maxGap) {
+        last++;
+      }
+
+      ranges.push_back(Range{first,
+                             last,
+                             offsets[order[first]],
+                             offsets[order[last-1]]+tailSize});
+
+      first=last;
+    }
+  }
+}
@@ -0,0 +1,573 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/private/Config.h>
+
+#include <osmscout/io/FileBatchReader.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+
+#if defined(HAVE_FCNTL_H)
+  #include <fcntl.h>
+#endif
+
+#if defined(HAVE_UNISTD_H)
+  #include <unistd.h>
+#endif
+
+#if defined(HAVE_SYS_STAT_H)
+  #include <sys/stat.h>
+#endif
+
+#if defined(HAVE_LINUX_IO_URING_H)
+  #include <linux/io_uring.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <sys/uio.h>
+#endif
+
+#include <osmscout/util/Exception.h>
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+#if defined(HAVE_LINUX_IO_URING_H)
+  /**
+   * State of an io_uring instance, accessed using the raw system calls, so that
+   * no additional library is required
+   */
+  struct FileBatchReader::IoUring
+  {
+    int           ringFd=-1;
+    void          *sqRing=MAP_FAILED;
+    size_t        sqRingSize=0;
+    void          *cqRing=MAP_FAILED;
+    size_t        cqRingSize=0;
+    io_uring_sqe  *sqes=static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t        sqesSize=0;
+
+    unsigned      *sqHead=nullptr;
+    unsigned      *sqTail=nullptr;
+    unsigned      sqMask=0;
+    unsigned      *sqArray=nullptr;
+    unsigned      *cqHead=nullptr;
+    unsigned      *cqTail=nullptr;
+    unsigned      cqMask=0;
+    io_uring_cqe  *cqes=nullptr;
+
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring()
+    {
+      if (sqes!=MAP_FAILED) {
+        munmap(sqes,sqesSize);
+      }
+
+      if (cqRing!=MAP_FAILED &&
+          cqRing!=sqRing) {
+        munmap(cqRing,cqRingSize);
+      }
+
+      if (sqRing!=MAP_FAILED) {
+        munmap(sqRing,sqRingSize);
+      }
+
+      if (ringFd>=0) {
+        close(ringFd);
+      }
+    }
+
+    /**
+     * Creates the rings, returns false if io_uring is not supported or not allowed
+     */
+    bool Setup(unsigned entries)
+    {
+      io_uring_params params;
+
+      memset(&params,0,sizeof(params));
+
+      ringFd=static_cast<int>(syscall(__NR_io_uring_setup,entries,&params));
+
+      if (ringFd<0) {
+        return false;
+      }
+
+      sqRingSize=params.sq_off.array+params.sq_entries*sizeof(unsigned);
+      cqRingSize=params.cq_off.cqes+params.cq_entries*sizeof(io_uring_cqe);
+
+      if ((params.features & IORING_FEAT_SINGLE_MMAP)!=0) {
+        sqRingSize=std::max(sqRingSize,cqRingSize);
+        cqRingSize=sqRingSize;
+      }
+
+      sqRing=mmap(nullptr,sqRingSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd,IORING_OFF_SQ_RING);
+
+      if (sqRing==MAP_FAILED) {
+        return false;
+      }
+
+      if ((params.features & IORING_FEAT_SINGLE_MMAP)!=0) {
+        cqRing=sqRing;
+      }
+      else {
+        cqRing=mmap(nullptr,cqRingSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd,IORING_OFF_CQ_RING);
+
+        if (cqRing==MAP_FAILED) {
+          return false;
+        }
+      }
+
+      sqesSize=params.sq_entries*sizeof(io_uring_sqe);
+      sqes=static_cast<io_uring_sqe*>(mmap(nullptr,sqesSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd,IORING_OFF_SQES));
+
+      if (sqes==MAP_FAILED) {
+        return false;
+      }
+
+      char *sq=static_cast<char*>(sqRing);
+      char *cq=static_cast<char*>(cqRing);
+
+      sqHead=reinterpret_cast<unsigned*>(sq+params.sq_off.head);
+      sqTail=reinterpret_cast<unsigned*>(sq+params.sq_off.tail);
+      sqMask=*reinterpret_cast<unsigned*>(sq+params.sq_off.ring_mask);
+      sqArray=reinterpret_cast<unsigned*>(sq+params.sq_off.array);
+      cqHead=reinterpret_cast<unsigned*>(cq+params.cq_off.head);
+      cqTail=reinterpret_cast<unsigned*>(cq+params.cq_off.tail);
+      cqMask=*reinterpret_cast<unsigned*>(cq+params.cq_off.ring_mask);
+      cqes=reinterpret_cast<io_uring_cqe*>(cq+params.cq_off.cqes);
+
+      return true;
+    }
+
+    bool RegisterBuffers(std::vector<char>& buffers,
+                         size_t bufferSize,
+                         size_t count)
+    {
+      std::vector<iovec> iovecs(count);
+
+      for (size_t i=0; i<count; i++) {
+        iovecs[i].iov_base=buffers.data()+i*bufferSize;
+        iovecs[i].iov_len=bufferSize;
+      }
+
+      return syscall(__NR_io_uring_register,ringFd,IORING_REGISTER_BUFFERS,iovecs.data(),static_cast<unsigned>(count))==0;
+    }
+
+    void PushRead(int fd,
+                  FileOffset offset,
+                  char* buffer,
+                  size_t size,
+                  size_t bufferIndex)
+    {
+      unsigned     tail=*sqTail;
+      unsigned     index=tail & sqMask;
+      io_uring_sqe &sqe=sqes[index];
+
+      memset(&sqe,0,sizeof(sqe));
+      sqe.opcode=IORING_OP_READ_FIXED;
+      sqe.fd=fd;
+      sqe.off=offset;
+      sqe.addr=reinterpret_cast<uint64_t>(buffer);
+      sqe.len=static_cast<uint32_t>(size);
+      sqe.buf_index=static_cast<uint16_t>(bufferIndex);
+      sqe.user_data=bufferIndex;
+
+      sqArray[index]=index;
+
+      __atomic_store_n(sqTail,tail+1,__ATOMIC_RELEASE);
+    }
+
+    /**
+     * Submits the given number of queued reads and waits for at least one completion
+     */
+    int Enter(unsigned toSubmit,
+              unsigned minComplete)
+    {
+      return static_cast<int>(syscall(__NR_io_uring_enter,ringFd,toSubmit,minComplete,IORING_ENTER_GETEVENTS,nullptr,0));
+    }
+
+    bool PopCompletion(size_t& bufferIndex,
+                       int& result)
+    {
+      unsigned head=*cqHead;
+
+      if (head==__atomic_load_n(cqTail,__ATOMIC_ACQUIRE)) {
+        return false;
+      }
+
+      const io_uring_cqe& cqe=cqes[head & cqMask];
+
+      bufferIndex=static_cast<size_t>(cqe.user_data);
+      result=cqe.res;
+
+      __atomic_store_n(cqHead,head+1,__ATOMIC_RELEASE);
+
+      return true;
+    }
+
+    /**
+     * Waits for the given number of submitted reads to complete and drops their results.
+     * Returns false, if waiting failed.
+     */
+    bool DropCompletions(size_t count)
+    {
+      size_t bufferIndex;
+      int    result;
+
+      while (count>0) {
+        if (PopCompletion(bufferIndex,result)) {
+          count--;
+          continue;
+        }
+
+        if (Enter(0,1)<0 &&
+            errno!=EINTR) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+  };
+#else
+  struct FileBatchReader::IoUring
+  {
+    // no code
+  };
+#endif
+
+  FileBatchReader::FileBatchReader() = default;
+
+  FileBatchReader::~FileBatchReader()
+  {
+    if (IsOpen()) {
+      Close();
+    }
+  }
+
+  /**
+   * Opens the file. If the preferred backend is io_uring, but io_uring is not available,
+   * the pread() backend is used instead, see GetBackend().
+   *
+   * throws IOException on error
+   */
+  void FileBatchReader::Open(const std::string& filename,
+                             Backend preferredBackend,
+                             size_t bufferSize,
+                             size_t queueDepth)
+  {
+    if (IsOpen()) {
+      throw IOException(filename,"Error opening file for reading","File already opened");
+    }
+
+    this->filename=filename;
+    this->bufferSize=bufferSize;
+    this->queueDepth=std::max(queueDepth,size_t(1));
+    this->backend=Backend::PRead;
+
+#if defined(HAVE_FCNTL_H) && defined(HAVE_UNISTD_H) && defined(HAVE_SYS_STAT_H)
+    fd=open(filename.c_str(),O_RDONLY);
+
+    if (fd<0) {
+      throw IOException(filename,"Cannot open file for reading",strerror(errno));
+    }
+
+    struct stat fileStat;
+
+    if (fstat(fd,&fileStat)!=0) {
+      std::string error=strerror(errno);
+
+      Close();
+      throw IOException(filename,"Cannot get size of file",error);
+    }
+
+    fileSize=static_cast<FileOffset>(fileStat.st_size);
+
+#if defined(HAVE_LINUX_IO_URING_H)
+    if (preferredBackend==Backend::IoUring) {
+      auto newRing=std::make_unique<IoUring>();
+
+      buffers.resize(this->queueDepth*bufferSize);
+
+      if (newRing->Setup(static_cast<unsigned>(this->queueDepth)) &&
+          newRing->RegisterBuffers(buffers,bufferSize,this->queueDepth)) {
+        ring=std::move(newRing);
+        backend=Backend::IoUring;
+      }
+      else {
+        log.Debug() << "io_uring is not available for file '" << filename << "', falling back to pread";
+      }
+    }
+#else
+    (void)preferredBackend;
+#endif
+
+    buffers.resize(backend==Backend::IoUring ? this->queueDepth*bufferSize : bufferSize);
+#else
+    (void)preferredBackend;
+
+    throw IOException(filename,"Cannot open file for reading","Batched reading is not supported on this platform");
+#endif
+  }
+
+  void FileBatchReader::Close()
+  {
+    ring.reset();
+
+    buffers.clear();
+    buffers.shrink_to_fit();
+
+#if defined(HAVE_UNISTD_H)
+    if (fd>=0) {
+      close(fd);
+    }
+#endif
+
+    fd=-1;
+    fileSize=0;
+    backend=Backend::PRead;
+  }
+
+  /**
+   * Reads the given part of the request into the buffer, retrying on short reads
+   */
+  void FileBatchReader::ReadSync([[maybe_unused]] const Request& request,
+                                 [[maybe_unused]] char* buffer,
+                                 [[maybe_unused]] size_t offset,
+                                 [[maybe_unused]] size_t size) const
+  {
+#if defined(HAVE_UNISTD_H)
+    while (offset<size) {
+      ssize_t result=pread(fd,
+                           buffer+offset,
+                           size-offset,
+                           static_cast<off_t>(request.offset+offset));
+
+      if (result<0 && errno==EINTR) {
+        continue;
+      }
+
+      if (result<=0) {
+        throw IOException(filename,"Cannot read byte array",result<0 ? strerror(errno) : "Unexpected end of file");
+      }
+
+      offset+=static_cast<size_t>(result);
+    }
+#endif
+  }
+
+  void FileBatchReader::ReadPRead(const std::vector<Request>& requests,
+                                  const CompletionHandler& handler)
+  {
+    for (size_t r=0; r<requests.size(); r++) {
+      const Request& request=requests[r];
+      size_t         size=request.offset<fileSize ? static_cast<size_t>(std::min<FileOffset>(request.size,fileSize-request.offset)) : 0;
+
+      ReadSync(request,
+               buffers.data(),
+               0,
+               size);
+
+      handler(r,
+              buffers.data(),
+              size);
+    }
+  }
+
+  void FileBatchReader::ReadIoUring([[maybe_unused]] const std::vector<Request>& requests,
+                                    [[maybe_unused]] const CompletionHandler& handler)
+  {
+#if defined(HAVE_LINUX_IO_URING_H)
+    std::vector<size_t> freeBuffers;
+    std::vector<size_t> bufferRequest(queueDepth);
+    std::vector<size_t> bufferSizes(queueDepth);
+    std::exception_ptr  error;
+    size_t              next=0;
+    size_t              inFlight=0;
+    unsigned            unsubmitted=0;
+
+    freeBuffers.reserve(queueDepth);
+
+    for (size_t b=queueDepth; b>0; b--) {
+      freeBuffers.push_back(b-1);
+    }
+
+    while (inFlight>0 ||
+           (!error && next<requests.size())) {
+      while (!error &&
+             next<requests.size() &&
+             !freeBuffers.empty()) {
+        const Request& request=requests[next];
+        size_t         size=request.offset<fileSize ? static_cast<size_t>(std::min<FileOffset>(request.size,fileSize-request.offset)) : 0;
+
+        if (size==0) {
+          try {
+            handler(next,
+                    buffers.data(),
+                    0);
+          }
+          catch (...) {
+            error=std::current_exception();
+          }
+
+          next++;
+          continue;
+        }
+
+        size_t buffer=freeBuffers.back();
+
+        freeBuffers.pop_back();
+        bufferRequest[buffer]=next;
+        bufferSizes[buffer]=size;
+
+        ring->PushRead(fd,
+                       request.offset,
+                       buffers.data()+buffer*bufferSize,
+                       size,
+                       buffer);
+
+        unsubmitted++;
+        inFlight++;
+        next++;
+      }
+
+      if (inFlight==0) {
+        continue;
+      }
+
+      int submitted=ring->Enter(unsubmitted,1);
+
+      if (submitted<0) {
+        if (errno!=EINTR && errno!=EAGAIN && errno!=EBUSY) {
+          std::string errorText=strerror(errno);
+
+          // Reads submitted before may still be in flight and write into the registered
+          // buffers. Wait for them before dropping the ring. If this fails, the kernel may
+          // still write into the buffers, so they are never freed or reused.
+          if (!ring->DropCompletions(inFlight-unsubmitted)) {
+            log.Error() << "Cannot wait for pending reads of file '" << filename << "'";
+            static_cast<void>(new std::vector<char>(std::move(buffers)));
+            buffers=std::vector<char>(bufferSize);
+          }
+
+          ring.reset();
+          backend=Backend::PRead;
+
+          throw IOException(filename,"Cannot submit reads",errorText);
+        }
+
+        submitted=0;
+      }
+
+      unsubmitted-=static_cast<unsigned>(submitted);
+
+      size_t buffer;
+      int    result;
+
+      while (ring->PopCompletion(buffer,result)) {
+        inFlight--;
+
+        if (error) {
+          freeBuffers.push_back(buffer);
+          continue;
+        }
+
+        try {
+          const Request& request=requests[bufferRequest[buffer]];
+          char           *data=buffers.data()+buffer*bufferSize;
+
+          if (result<0) {
+            throw IOException(filename,"Cannot read byte array",strerror(-result));
+          }
+
+          // Regular files only return short reads at their end, which is excluded above
+          ReadSync(request,
+                   data,
+                   static_cast<size_t>(result),
+                   bufferSizes[buffer]);
+
+          handler(bufferRequest[buffer],
+                  data,
+                  bufferSizes[buffer]);
+        }
+        catch (...) {
+          error=std::current_exception();
+        }
+
+        freeBuffers.push_back(buffer);
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+#endif
+  }
+
+  /**
+   * Reads all requests and calls the handler for each of them. With the io_uring backend
+   * the handler is called in completion order, else in request order.
+   *
+   * If the handler throws, no further requests are started. Reads still in flight are
+   * waited for and the exception is rethrown.
+   *
+   * throws IOException on error
+   */
+  void FileBatchReader::Read(const std::vector<Request>& requests,
+                             const CompletionHandler& handler)
+  {
+    if (!IsOpen()) {
+      throw IOException(filename,"Cannot read byte array","File not open");
+    }
+
+    for (const auto& request : requests) {
+      if (request.size>bufferSize) {
+        throw IOException(filename,"Cannot read byte array","Request exceeds buffer size");
+      }
+    }
+
+    if (backend==Backend::IoUring) {
+      ReadIoUring(requests,
+                  handler);
+    }
+    else {
+      ReadPRead(requests,
+                handler);
+    }
+  }
+
+  /**
+   * Returns true, if io_uring is compiled in and accepted by the kernel
+   */
+  bool FileBatchReader::IsIoUringAvailable()
+  {
+#if defined(HAVE_LINUX_IO_URING_H)
+    IoUring probe;
+
+    return probe.Setup(1);
+#else
+    return false;
+#endif
+  }
+}
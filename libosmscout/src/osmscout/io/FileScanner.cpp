@@ -21,6 +21,7 @@
 
 #include <osmscout/io/FileScanner.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
@@ -46,6 +47,8 @@
 
 #include <osmscout/system/Assert.h>
 
+#include <osmscout/io/BlockCoordEncoding.h>
+
 #include <osmscout/util/Exception.h>
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/Number.h>
@@ -77,6 +80,14 @@ namespace osmscout {
 
   void FileScanner::FreeBuffer()
   {
+    if (borrowedMemory) {
+      mmap=nullptr;
+      mmapOffset=0;
+      borrowedMemory=false;
+
+      return;
+    }
+
 #if defined(HAVE_MMAP)
     if (mmap!=nullptr) {
       if (munmap(mmap,size)!=0) {
@@ -101,7 +112,7 @@ namespace osmscout {
                          [[maybe_unused]] Mode mode,
                          bool useMmap)
   {
-    if (file!=nullptr) {
+    if (IsOpen()) {
       throw IOException(filename,"Error opening file for reading","File already opened");
     }
 
@@ -254,6 +265,42 @@ namespace osmscout {
     hasError=false;
   }
 
+  /**
+   * Opens the scanner on a block of memory holding the bytes of the given file starting
+   * at the given file offset, for example data read in advance by a FileBatchReader.
+   * File positions stay relative to the start of the file.
+   *
+   * The memory is not copied and must stay valid until the scanner is closed. Reading
+   * beyond the end of the memory block fails like reading beyond the end of a file.
+   *
+   * throws IOException on error
+   */
+  void FileScanner::OpenMemory(const std::string& filename,
+                               [[maybe_unused]] FileOffset offset,
+                               [[maybe_unused]] const char* data,
+                               [[maybe_unused]] size_t size)
+  {
+    if (IsOpen()) {
+      throw IOException(filename,"Error opening file for reading","File already opened");
+    }
+
+    this->filename=filename;
+
+#if defined(HAVE_MMAP) || defined(_WIN32)
+    static const char empty='\0';
+
+    // The memory is only read, never written
+    this->mmap=const_cast<char*>(data!=nullptr ? data : &empty);
+    this->mmapOffset=offset;
+    this->size=size;
+    this->offset=0;
+    borrowedMemory=true;
+    hasError=false;
+#else
+    throw IOException(filename,"Cannot open file for reading","Reading from memory is not supported on this platform");
+#endif
+  }
+
   /**
    * Closes the file.
    *
@@ -263,12 +310,16 @@ namespace osmscout {
    */
   void FileScanner::Close()
   {
-    if (file==nullptr) {
+    if (!IsOpen()) {
       throw IOException(filename,"Cannot close file","File already closed");
     }
 
     FreeBuffer();
 
+    if (file==nullptr) {
+      return;
+    }
+
     if (fclose(file)!=0) {
       file=nullptr;
       throw IOException(filename,"Cannot close file");
@@ -286,12 +337,16 @@ namespace osmscout {
    */
   void FileScanner::CloseFailsafe()
   {
-    if (file==nullptr) {
+    if (!IsOpen()) {
       return;
     }
 
     FreeBuffer();
 
+    if (file==nullptr) {
+      return;
+    }
+
     fclose(file);
 
     file=nullptr;
@@ -348,12 +403,13 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (mmap!=nullptr) {
-      if (pos>=size) {
+      if (pos<mmapOffset ||
+          pos-mmapOffset>=size) {
         hasError=true;
         throw IOException(filename,"Cannot set position in file to "+std::to_string(pos),"Position beyond file end");
       }
 
-      offset=pos;
+      offset=pos-mmapOffset;
 
       return;
     }
@@ -388,7 +444,7 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (mmap!=nullptr) {
-      return offset;
+      return mmapOffset+offset;
     }
 #endif
 
@@ -422,6 +478,42 @@ namespace osmscout {
 #endif
   }
 
+  /**
+   * Announces that the given range of the file will be read soon, so that
+   * the operating system can load it in the background. This is only a hint,
+   * it does not move the reading cursor and errors are ignored.
+   */
+  void FileScanner::Prefetch([[maybe_unused]] FileOffset pos,
+                             [[maybe_unused]] FileOffset bytes) const
+  {
+    if (HasError() ||
+        borrowedMemory ||
+        pos>=size ||
+        bytes==0) {
+      return;
+    }
+
+    bytes=std::min(bytes,size-pos);
+
+#if defined(HAVE_MMAP) && defined(HAVE_POSIX_MADVISE)
+    if (mmap!=nullptr) {
+      static const FileOffset pageSize=(FileOffset)sysconf(_SC_PAGESIZE);
+
+      FileOffset start=pos-pos%pageSize;
+
+      posix_madvise(mmap+start,(size_t)(pos+bytes-start),POSIX_MADV_WILLNEED);
+
+      return;
+    }
+#endif
+
+#if defined(HAVE_POSIX_FADVISE)
+    if (mmap==nullptr) {
+      posix_fadvise(fileno(file),(off_t)pos,(off_t)bytes,POSIX_FADV_WILLNEED);
+    }
+#endif
+  }
+
   char* FileScanner::ReadInternal(size_t bytes)
   {
     if (HasError()) {
@@ -2320,9 +2412,12 @@ namespace osmscout {
       else if ((sizeByte & 0x03u) == 1) {
         coordBitSize=32;
       }
-      else {
+      else if ((sizeByte & 0x03u) == 2) {
         coordBitSize=48;
       }
+      else {
+        coordBitSize=0; // bit size per block of coordinates
+      }
 
       nodeCount=(sizeByte & 0x78u) >> 3;
 
@@ -2353,9 +2448,12 @@ namespace osmscout {
       else if ((sizeByte & 0x03u) == 1) {
         coordBitSize=32;
       }
-      else {
+      else if ((sizeByte & 0x03u) == 2) {
         coordBitSize=48;
       }
+      else {
+        coordBitSize=0; // bit size per block of coordinates
+      }
 
       nodeCount=(sizeByte & 0x7cu) >> 2;
 
@@ -2389,85 +2487,135 @@ namespace osmscout {
 
     nodes[0].SetCoord(firstCoord);
 
-    const uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
+    if (coordBitSize==0) {
+      size_t deltaCount=nodeCount-1;
+      size_t widthsSize=GetBlockCoordBlockCount(deltaCount)*2;
 
-    if (coordBitSize==16) {
-      size_t currentCoordPos=1;
+      const uint8_t* widths;
+      const uint8_t* data;
+      size_t         readableSize;
 
-      for (size_t i=0; i<byteBufferSize; i+=2) {
-        int32_t latDelta=(int8_t)tmpBuffer[i];
-        int32_t lonDelta=(int8_t)tmpBuffer[i+1];
+#if defined(HAVE_MMAP) || defined(_WIN32)
+      if (this->mmap!=nullptr) {
+        // Decode in place, the following bytes of the file memory serve as padding
+        widths=(const uint8_t*)ReadInternal(widthsSize);
+        size_t dataSize=GetBlockCoordDataSize(deltaCount,widths);
+        data=(const uint8_t*)ReadInternal(dataSize);
+        readableSize=size-(offset-dataSize);
+      }
+      else
+#endif
+      {
+        blockCoordBuffer.resize(widthsSize);
+        Read((char*)blockCoordBuffer.data(),widthsSize);
 
-        latValue+=latDelta;
-        lonValue+=lonDelta;
+        size_t dataSize=GetBlockCoordDataSize(deltaCount,blockCoordBuffer.data());
 
-        SetCoord(latValue,lonValue,nodes[currentCoordPos]);
+        // Copy the data instead of decoding it in place to have padding for faster decoding
+        blockCoordBuffer.resize(widthsSize+dataSize+blockCoordDataPadding);
+        Read((char*)blockCoordBuffer.data()+widthsSize,dataSize);
 
-        currentCoordPos++;
+        widths=blockCoordBuffer.data();
+        data=blockCoordBuffer.data()+widthsSize;
+        readableSize=dataSize+blockCoordDataPadding;
       }
+
+      [[maybe_unused]] bool normalised=DecodeBlockCoords(widths,
+                                                         data,
+                                                         readableSize,
+                                                         deltaCount,
+                                                         latValue,
+                                                         lonValue,
+                                                         nodes.data());
+
+#ifndef NDEBUG
+      if (!normalised) {
+        hasError=true;
+        throw IOException(filename,"Cannot read coordinate","Coordinate is not normalised");
+      }
+#endif
     }
-    else if (coordBitSize==32) {
-      size_t currentCoordPos=1;
+    else {
+      const uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
 
-      for (size_t i=0; i<byteBufferSize; i+=4) {
-        uint32_t latUDelta=tmpBuffer[i+0] | (tmpBuffer[i+1]<<8);
-        uint32_t lonUDelta=tmpBuffer[i+2] | (tmpBuffer[i+3]<<8);
-        int32_t  latDelta;
-        int32_t  lonDelta;
+      if (coordBitSize==16) {
+        size_t currentCoordPos=1;
 
-        if (latUDelta & 0x8000u) {
-          latDelta=(int32_t)(latUDelta | 0xffff0000u);
-        }
-        else {
-          latDelta=(int32_t)latUDelta;
-        }
+        for (size_t i=0; i<byteBufferSize; i+=2) {
+          int32_t latDelta=(int8_t)tmpBuffer[i];
+          int32_t lonDelta=(int8_t)tmpBuffer[i+1];
 
-        latValue+=latDelta;
+          latValue+=latDelta;
+          lonValue+=lonDelta;
 
-        if (lonUDelta & 0x8000u) {
-          lonDelta=(int32_t)(lonUDelta | 0xffff0000u);
-        }
-        else {
-          lonDelta=(int32_t)lonUDelta;
+          SetCoord(latValue,lonValue,nodes[currentCoordPos]);
+
+          currentCoordPos++;
         }
+      }
+      else if (coordBitSize==32) {
+        size_t currentCoordPos=1;
 
-        lonValue+=lonDelta;
+        for (size_t i=0; i<byteBufferSize; i+=4) {
+          uint32_t latUDelta=tmpBuffer[i+0] | (tmpBuffer[i+1]<<8);
+          uint32_t lonUDelta=tmpBuffer[i+2] | (tmpBuffer[i+3]<<8);
+          int32_t  latDelta;
+          int32_t  lonDelta;
 
-        SetCoord(latValue,lonValue,nodes[currentCoordPos]);
+          if (latUDelta & 0x8000u) {
+            latDelta=(int32_t)(latUDelta | 0xffff0000u);
+          }
+          else {
+            latDelta=(int32_t)latUDelta;
+          }
 
-        currentCoordPos++;
-      }
-    }
-    else {
-      size_t currentCoordPos=1;
+          latValue+=latDelta;
 
-      for (size_t i=0; i<byteBufferSize; i+=6) {
-        uint32_t latUDelta=(tmpBuffer[i+0]) | (tmpBuffer[i+1]<<8) | (tmpBuffer[i+2]<<16);
-        uint32_t lonUDelta=(tmpBuffer[i+3]) | (tmpBuffer[i+4]<<8) | (tmpBuffer[i+5]<<16);
-        int32_t  latDelta;
-        int32_t  lonDelta;
+          if (lonUDelta & 0x8000u) {
+            lonDelta=(int32_t)(lonUDelta | 0xffff0000u);
+          }
+          else {
+            lonDelta=(int32_t)lonUDelta;
+          }
 
-        if (latUDelta & 0x800000u) {
-          latDelta=(int32_t)(latUDelta | 0xff000000u);
-        }
-        else {
-          latDelta=(int32_t)latUDelta;
-        }
+          lonValue+=lonDelta;
 
-        latValue+=latDelta;
+          SetCoord(latValue,lonValue,nodes[currentCoordPos]);
 
-        if (lonUDelta & 0x800000u) {
-          lonDelta=(int32_t)(lonUDelta | 0xff000000u);
-        }
-        else {
-          lonDelta=(int32_t)lonUDelta;
+          currentCoordPos++;
         }
+      }
+      else {
+        size_t currentCoordPos=1;
+
+        for (size_t i=0; i<byteBufferSize; i+=6) {
+          uint32_t latUDelta=(tmpBuffer[i+0]) | (tmpBuffer[i+1]<<8) | (tmpBuffer[i+2]<<16);
+          uint32_t lonUDelta=(tmpBuffer[i+3]) | (tmpBuffer[i+4]<<8) | (tmpBuffer[i+5]<<16);
+          int32_t  latDelta;
+          int32_t  lonDelta;
+
+          if (latUDelta & 0x800000u) {
+            latDelta=(int32_t)(latUDelta | 0xff000000u);
+          }
+          else {
+            latDelta=(int32_t)latUDelta;
+          }
+
+          latValue+=latDelta;
+
+          if (lonUDelta & 0x800000u) {
+            lonDelta=(int32_t)(lonUDelta | 0xff000000u);
+          }
+          else {
+            lonDelta=(int32_t)lonUDelta;
+          }
 
-        lonValue+=lonDelta;
+          lonValue+=lonDelta;
 
-        SetCoord(latValue,lonValue,nodes[currentCoordPos]);
+          SetCoord(latValue,lonValue,nodes[currentCoordPos]);
 
-        currentCoordPos++;
+          currentCoordPos++;
+        }
       }
     }
 
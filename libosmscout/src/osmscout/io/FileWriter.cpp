@@ -28,6 +28,8 @@
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
 
+#include <osmscout/io/BlockCoordEncoding.h>
+
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/Number.h>
 
@@ -892,6 +894,8 @@ namespace osmscout {
     }
 
     size_t bytesNeeded=(nodesSize-1)*coordBitSize/8; // all coordinates in the same encoding
+    bool   blockEncoded=blockCoordEncoding &&
+                        GetBlockCoordEncodedSize(deltaBuffer)<bytesNeeded; // bit size per block of coordinates
 
     //
     // Write starting length / signal bit section
@@ -901,7 +905,10 @@ namespace osmscout {
 
     uint8_t coordSizeFlags;
 
-    if (coordBitSize==16) {
+    if (blockEncoded) {
+      coordSizeFlags=0x03;
+    }
+    else if (coordBitSize==16) {
       coordSizeFlags=0x00;
     }
     else if (coordBitSize==32) {
@@ -960,47 +967,52 @@ namespace osmscout {
 
     WriteCoord(nodes[0]);
 
-    byteBuffer.resize(bytesNeeded);
+    if (blockEncoded) {
+      EncodeBlockCoords(deltaBuffer,byteBuffer);
+    }
+    else {
+      byteBuffer.resize(bytesNeeded);
 
-    if (coordBitSize==16) {
-      size_t byteBufferPos=0;
+      if (coordBitSize==16) {
+        size_t byteBufferPos=0;
 
-      for (int i : deltaBuffer) {
-        byteBuffer[byteBufferPos]=i;
-        byteBufferPos++;
+        for (int i : deltaBuffer) {
+          byteBuffer[byteBufferPos]=i;
+          byteBufferPos++;
+        }
       }
-    }
-    else if (coordBitSize==32) {
-      size_t byteBufferPos=0;
+      else if (coordBitSize==32) {
+        size_t byteBufferPos=0;
 
-      for (int i : deltaBuffer) {
-        byteBuffer[byteBufferPos]=i & 0xff;
-        ++byteBufferPos;
+        for (int i : deltaBuffer) {
+          byteBuffer[byteBufferPos]=i & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=(i >> 8);
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=(i >> 8);
+          ++byteBufferPos;
+        }
       }
-    }
-    else {
-      size_t byteBufferPos=0;
-      for (size_t i=0; i<deltaBuffer.size(); i+=2) {
-        byteBuffer[byteBufferPos]=deltaBuffer[i] & 0xff;
-        ++byteBufferPos;
+      else {
+        size_t byteBufferPos=0;
+        for (size_t i=0; i<deltaBuffer.size(); i+=2) {
+          byteBuffer[byteBufferPos]=deltaBuffer[i] & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=(deltaBuffer[i] >> 8) & 0xff;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=(deltaBuffer[i] >> 8) & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=deltaBuffer[i] >> 16;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=deltaBuffer[i] >> 16;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=deltaBuffer[i+1] & 0xff;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=deltaBuffer[i+1] & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=(deltaBuffer[i+1] >> 8) & 0xff;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=(deltaBuffer[i+1] >> 8) & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=deltaBuffer[i+1] >> 16;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=deltaBuffer[i+1] >> 16;
+          ++byteBufferPos;
+        }
       }
     }
 
@@ -1083,6 +1095,8 @@ namespace osmscout {
     }
 
     size_t bytesNeeded=(nodesSize-1)*coordBitSize/8; // all coordinates in the same encoding
+    bool   blockEncoded=blockCoordEncoding &&
+                        GetBlockCoordEncodedSize(deltaBuffer)<bytesNeeded; // bit size per block of coordinates
 
     //
     // do we need to store node ids?
@@ -1107,7 +1121,10 @@ namespace osmscout {
 
     uint8_t coordSizeFlags;
 
-    if (coordBitSize==16) {
+    if (blockEncoded) {
+      coordSizeFlags=0x03;
+    }
+    else if (coordBitSize==16) {
       coordSizeFlags=0x00;
     }
     else if (coordBitSize==32) {
@@ -1213,47 +1230,52 @@ namespace osmscout {
 
     WriteCoord(nodes[0].GetCoord());
 
-    byteBuffer.resize(bytesNeeded);
+    if (blockEncoded) {
+      EncodeBlockCoords(deltaBuffer,byteBuffer);
+    }
+    else {
+      byteBuffer.resize(bytesNeeded);
 
-    if (coordBitSize==16) {
-      size_t byteBufferPos=0;
+      if (coordBitSize==16) {
+        size_t byteBufferPos=0;
 
-      for (int i : deltaBuffer) {
-        byteBuffer[byteBufferPos]=i;
-        byteBufferPos++;
+        for (int i : deltaBuffer) {
+          byteBuffer[byteBufferPos]=i;
+          byteBufferPos++;
+        }
       }
-    }
-    else if (coordBitSize==32) {
-      size_t byteBufferPos=0;
+      else if (coordBitSize==32) {
+        size_t byteBufferPos=0;
 
-      for (int i : deltaBuffer) {
-        byteBuffer[byteBufferPos]=i & 0xff;
-        ++byteBufferPos;
+        for (int i : deltaBuffer) {
+          byteBuffer[byteBufferPos]=i & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=(i >> 8);
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=(i >> 8);
+          ++byteBufferPos;
+        }
       }
-    }
-    else {
-      size_t byteBufferPos=0;
-      for (size_t i=0; i<deltaBuffer.size(); i+=2) {
-        byteBuffer[byteBufferPos]=deltaBuffer[i] & 0xff;
-        ++byteBufferPos;
+      else {
+        size_t byteBufferPos=0;
+        for (size_t i=0; i<deltaBuffer.size(); i+=2) {
+          byteBuffer[byteBufferPos]=deltaBuffer[i] & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=(deltaBuffer[i] >> 8) & 0xff;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=(deltaBuffer[i] >> 8) & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=deltaBuffer[i] >> 16;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=deltaBuffer[i] >> 16;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=deltaBuffer[i+1] & 0xff;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=deltaBuffer[i+1] & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=(deltaBuffer[i+1] >> 8) & 0xff;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=(deltaBuffer[i+1] >> 8) & 0xff;
+          ++byteBufferPos;
 
-        byteBuffer[byteBufferPos]=deltaBuffer[i+1] >> 16;
-        ++byteBufferPos;
+          byteBuffer[byteBufferPos]=deltaBuffer[i+1] >> 16;
+          ++byteBufferPos;
+        }
       }
     }
 
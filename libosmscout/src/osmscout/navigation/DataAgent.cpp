@@ -19,6 +19,11 @@
 
 #include <osmscout/navigation/DataAgent.h>
 
+#include <osmscout/util/Geometry.h>
+
+#include <algorithm>
+#include <cmath>
+
 namespace osmscout {
 
   TypeConfigRef RoutableObjects::GetTypeConfig(const DatabaseId &dbId) const
@@ -68,6 +73,269 @@ namespace osmscout {
     return objEntry->second;
   }
 
+  void RoutableObjects::BuildIndex()
+  {
+    segmentIndex.Build(dbMap);
+  }
+
+  size_t RoutableSegmentIndex::GetColumn(double lon) const
+  {
+    auto column=static_cast<long>(std::floor((lon-bbox.GetMinLon())/cellWidth));
+
+    return static_cast<size_t>(std::clamp(column,0l,static_cast<long>(columns)-1));
+  }
+
+  size_t RoutableSegmentIndex::GetRow(double lat) const
+  {
+    auto row=static_cast<long>(std::floor((lat-bbox.GetMinLat())/cellHeight));
+
+    return static_cast<size_t>(std::clamp(row,0l,static_cast<long>(rows)-1));
+  }
+
+  /**
+   * Adds the object, if it has nodes. Returns true, if the object was added.
+   */
+  bool RoutableSegmentIndex::AddObject(DatabaseId databaseId,
+                                       const WayRef& way,
+                                       const AreaRef& area,
+                                       const std::vector<Point>& nodes)
+  {
+    if (nodes.empty()) {
+      return false;
+    }
+
+    GeoBox boundingBox=GetBoundingBox(nodes);
+
+    objects.push_back(Object{databaseId,way,area,&nodes,boundingBox});
+    bbox.Include(boundingBox);
+
+    return true;
+  }
+
+  /**
+   * (Re)builds the index from the given objects. The index references the
+   * node vectors of the objects, so objects must not be modified afterwards.
+   */
+  void RoutableSegmentIndex::Build(const std::map<DatabaseId, RoutableDBObjects>& dbMap)
+  {
+    bbox.Invalidate();
+    objects.clear();
+    cellStart.clear();
+    segments.clear();
+    cellRingStart.clear();
+    rings.clear();
+
+    for (const auto& [dbId,objs] : dbMap) {
+      for (const auto& [offset,way] : objs.ways) {
+        AddObject(dbId,way,nullptr,way->nodes);
+      }
+
+      for (const auto& [offset,area] : objs.areas) {
+        for (const auto& ring : area->rings) {
+          if (ring.IsMaster()) {
+            continue;
+          }
+
+          AddObject(dbId,nullptr,area,ring.nodes);
+        }
+      }
+    }
+
+    size_t segmentCount=0;
+
+    for (const auto& object : objects) {
+      segmentCount+=object.area ? object.nodes->size() : object.nodes->size()-1;
+    }
+
+    if (!bbox.IsValid() || segmentCount==0) {
+      return;
+    }
+
+    // Aim for a few segments per cell, keeping cells roughly square in degrees
+    double width=std::max(bbox.GetWidth(),1e-6);
+    double height=std::max(bbox.GetHeight(),1e-6);
+    double cellSize=std::sqrt(width*height/std::max(segmentCount/4.0,1.0));
+
+    columns=std::clamp(static_cast<size_t>(std::ceil(width/cellSize)),size_t(1),size_t(4096));
+    rows=std::clamp(static_cast<size_t>(std::ceil(height/cellSize)),size_t(1),size_t(4096));
+    cellWidth=width/static_cast<double>(columns);
+    cellHeight=height/static_cast<double>(rows);
+
+    // Two passes: count segments per cell, then fill cells (compressed row storage)
+    std::vector<uint32_t> counts(columns*rows+1,0);
+
+    auto forEachSegment=[this](auto&& callback) {
+      for (size_t o=0; o<objects.size(); o++) {
+        const std::vector<Point>& nodes=*objects[o].nodes;
+        size_t                    count=objects[o].area ? nodes.size() : nodes.size()-1;
+
+        for (size_t i=0; i<count; i++) {
+          const GeoCoord& a=nodes[i].GetCoord();
+          const GeoCoord& b=nodes[(i+1)%nodes.size()].GetCoord();
+          size_t minColumn=GetColumn(std::min(a.GetLon(),b.GetLon()));
+          size_t maxColumn=GetColumn(std::max(a.GetLon(),b.GetLon()));
+          size_t minRow=GetRow(std::min(a.GetLat(),b.GetLat()));
+          size_t maxRow=GetRow(std::max(a.GetLat(),b.GetLat()));
+
+          for (size_t row=minRow; row<=maxRow; row++) {
+            for (size_t column=minColumn; column<=maxColumn; column++) {
+              callback(row*columns+column,Segment{static_cast<uint32_t>(o),static_cast<uint32_t>(i)});
+            }
+          }
+        }
+      }
+    };
+
+    forEachSegment([&counts](size_t cell, const Segment&) {
+      counts[cell+1]++;
+    });
+
+    for (size_t i=1; i<counts.size(); i++) {
+      counts[i]+=counts[i-1];
+    }
+
+    cellStart=counts;
+    segments.resize(cellStart.back());
+
+    forEachSegment([this,&counts](size_t cell, const Segment& segment) {
+      segments[counts[cell]++]=segment;
+    });
+
+    // The same for the bounding boxes of the area rings. Rings are added in object
+    // order, so the rings of an area are consecutive within each cell
+    auto forEachRing=[this](auto&& callback) {
+      for (size_t o=0; o<objects.size(); o++) {
+        if (!objects[o].area) {
+          continue;
+        }
+
+        const GeoBox& boundingBox=objects[o].boundingBox;
+        size_t        minColumn=GetColumn(boundingBox.GetMinLon());
+        size_t        maxColumn=GetColumn(boundingBox.GetMaxLon());
+        size_t        minRow=GetRow(boundingBox.GetMinLat());
+        size_t        maxRow=GetRow(boundingBox.GetMaxLat());
+
+        for (size_t row=minRow; row<=maxRow; row++) {
+          for (size_t column=minColumn; column<=maxColumn; column++) {
+            callback(row*columns+column,static_cast<uint32_t>(o));
+          }
+        }
+      }
+    };
+
+    std::fill(counts.begin(),counts.end(),0);
+
+    forEachRing([&counts](size_t cell, uint32_t) {
+      counts[cell+1]++;
+    });
+
+    for (size_t i=1; i<counts.size(); i++) {
+      counts[i]+=counts[i-1];
+    }
+
+    cellRingStart=counts;
+    rings.resize(cellRingStart.back());
+
+    forEachRing([this,&counts](size_t cell, uint32_t ring) {
+      rings[counts[cell]++]=ring;
+    });
+  }
+
+  /**
+   * Returns the nearest routable object with a segment within maxDistance around the given
+   * coordinate. Coordinates inside a routable area are matched to that area with distance 0.
+   *
+   * @return true, if some object was found
+   */
+  bool RoutableSegmentIndex::FindNearest(const GeoCoord& coord,
+                                         const Distance& maxDistance,
+                                         NearestObject& result) const
+  {
+    result=NearestObject();
+
+    if (!IsBuilt()) {
+      return false;
+    }
+
+    GeoBox lookupArea=GeoBox::BoxByCenterAndRadius(coord,maxDistance);
+
+    if (!lookupArea.Intersects(bbox)) {
+      return false;
+    }
+
+    size_t minColumn=GetColumn(lookupArea.GetMinLon());
+    size_t maxColumn=GetColumn(lookupArea.GetMaxLon());
+    size_t minRow=GetRow(lookupArea.GetMinLat());
+    size_t maxRow=GetRow(lookupArea.GetMaxLat());
+    bool   found=false;
+
+    for (size_t row=minRow; row<=maxRow; row++) {
+      for (size_t column=minColumn; column<=maxColumn; column++) {
+        size_t cell=row*columns+column;
+
+        for (uint32_t s=cellStart[cell]; s<cellStart[cell+1]; s++) {
+          const Segment&            segment=segments[s];
+          const Object&             object=objects[segment.object];
+          const std::vector<Point>& nodes=*object.nodes;
+          GeoCoord                  p;
+          double                    d=CalculateDistancePointToLineSegment(coord,
+                                                                          nodes[segment.node].GetCoord(),
+                                                                          nodes[(segment.node+1)%nodes.size()].GetCoord(),
+                                                                          p);
+
+          if (d<result.distance) {
+            found=true;
+            result.databaseId=object.databaseId;
+            result.way=object.way;
+            result.area=object.area;
+            result.coord=p;
+            result.distance=d;
+          }
+        }
+      }
+    }
+
+    if (found &&
+        GetSphericalDistance(coord,result.coord)>maxDistance) {
+      found=false;
+      result=NearestObject();
+    }
+
+    if (!bbox.Includes(coord,false)) {
+      return found;
+    }
+
+    // Inside an area we are "on" it, count rings containing the coordinate to handle holes.
+    // Only rings with a bounding box covering the cell of the coordinate can contain it.
+    size_t cell=GetRow(coord.GetLat())*columns+GetColumn(coord.GetLon());
+    size_t cellEnd=cellRingStart[cell+1];
+
+    for (size_t i=cellRingStart[cell]; i<cellEnd && result.distance>0.0;) {
+      const AreaRef& area=objects[rings[i]].area;
+      size_t         containingRings=0;
+
+      for (; i<cellEnd && objects[rings[i]].area==area; i++) {
+        const Object& ring=objects[rings[i]];
+
+        if (ring.boundingBox.Includes(coord) &&
+            IsCoordInArea(coord,*ring.nodes)) {
+          containingRings++;
+        }
+      }
+
+      if (containingRings%2==1) {
+        found=true;
+        result.databaseId=objects[rings[i-1]].databaseId;
+        result.way.reset();
+        result.area=area;
+        result.coord=coord;
+        result.distance=0.0;
+      }
+    }
+
+    return found;
+  }
+
   RoutableObjectsRequestMessage::RoutableObjectsRequestMessage(const Timestamp& timestamp, const GeoBox &bbox):
       NavigationMessage(timestamp), bbox(bbox)
   {}
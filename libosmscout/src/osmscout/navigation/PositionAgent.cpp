@@ -117,49 +117,21 @@ namespace osmscout {
     {
       assert(routableObjects);
 
-      auto lookupArea=GeoBox::BoxByCenterAndRadius(coord,Meters(30));
-      double nearest=std::numeric_limits<double>::max();
-
       PositionAgent::Position position;
       position.coord=coord;
 
-      for (const auto &e:routableObjects->dbMap){
-        DatabaseId dbId=e.first;
-        const RoutableDBObjects &objs=e.second;
-
-        for (auto &w:objs.ways){
-          assert(w.second);
-          if (w.second->GetBoundingBox().Intersects(lookupArea)){
-            double distance=std::numeric_limits<double>::max();
-            GeoCoord p{0,0};
-            GeoCoord nearestPoint{0,0};
-            for (size_t i=1; i<w.second->nodes.size(); i++){
-              double d = CalculateDistancePointToLineSegment(coord,
-                                    w.second->nodes[i-1].GetCoord(),
-                                    w.second->nodes[i].GetCoord(),
-                                    p);
-              if (d<distance){
-                distance=d;
-                nearestPoint=p;
-              }
-            }
-            if (distance<nearest){
-              nearest=distance;
-              position.coord=nearestPoint;
-              position.state=PositionAgent::OffRoute;
-              position.databaseId=dbId;
-              position.typeConfig=objs.typeConfig;
-              position.way=w.second;
-              position.area.reset();
-            }
-          }
-        }
-        for (auto &a:objs.areas){
-          assert(a.second);
-          if (a.second->GetBoundingBox().Includes(coord, false)){
-            // TODO
-          }
-        }
+      if (!routableObjects->segmentIndex.IsBuilt()){
+        routableObjects->BuildIndex();
+      }
+
+      RoutableSegmentIndex::NearestObject nearest;
+      if (routableObjects->segmentIndex.FindNearest(coord, Meters(30), nearest)){
+        position.coord=nearest.coord;
+        position.state=PositionAgent::OffRoute;
+        position.databaseId=nearest.databaseId;
+        position.typeConfig=routableObjects->GetTypeConfig(nearest.databaseId);
+        position.way=nearest.way;
+        position.area=nearest.area;
       }
       return position;
     }
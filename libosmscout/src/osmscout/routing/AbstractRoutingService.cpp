@@ -30,14 +30,53 @@
 
 #include <osmscout/util/Geometry.h>
 #include <osmscout/log/Logger.h>
+#include <osmscout/util/Metrics.h>
 #include <osmscout/util/StopClock.h>
 
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <optional>
 
 namespace osmscout {
 
+  /**
+   * Return the index of the path of the given route node, leading to the route node
+   * with the given id by using the given object.
+   */
+  static std::optional<size_t> FindPathIndex(const RouteNode& routeNode,
+                                             Id targetId,
+                                             const ObjectFileRef& object)
+  {
+    for (size_t i=0; i<routeNode.paths.size(); i++) {
+      if (routeNode.paths[i].id==targetId &&
+          routeNode.objects[routeNode.paths[i].objectIndex].object==object) {
+        return i;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  static void RecordRoutingMetrics(size_t nodesLoadedCount,
+                                   size_t nodesIgnoredCount,
+                                   const StopClock& clock)
+  {
+    static MetricCounter&   expandedNodes=MetricsRegistry::Instance().GetCounter("osmscout_routing_expanded_nodes_total",
+                                                                                 "Number of route nodes expanded by the routing search");
+    static MetricCounter&   ignoredNodes=MetricsRegistry::Instance().GetCounter("osmscout_routing_ignored_nodes_total",
+                                                                                "Number of route node followers ignored by the routing search");
+    static MetricHistogram& expandedPerRoute=MetricsRegistry::Instance().GetHistogram("osmscout_routing_expanded_nodes",
+                                                                                      "Number of route nodes expanded per route calculation");
+    static MetricHistogram& routeLatency=MetricsRegistry::Instance().GetHistogram("osmscout_routing_search_microseconds",
+                                                                                  "Duration of the routing search per route calculation");
+
+    expandedNodes.Increment(nodesLoadedCount);
+    ignoredNodes.Increment(nodesIgnoredCount);
+    expandedPerRoute.Record(nodesLoadedCount);
+    routeLatency.Record(clock.GetDuration());
+  }
+
   RoutingResult::RoutingResult() = default;
 
   RoutePoints::RoutePoints(const std::list<Point>& points)
@@ -80,7 +119,8 @@ namespace osmscout {
 
   template <class RoutingState>
   AbstractRoutingService<RoutingState>::AbstractRoutingService(const RouterParameter& parameter):
-    debugPerformance(parameter.IsDebugPerformance())
+    debugPerformance(parameter.IsDebugPerformance()),
+    predecessorCache(10000)
   {
   }
 
@@ -240,6 +280,7 @@ namespace osmscout {
 
   template <class RoutingState>
   bool AbstractRoutingService<RoutingState>::GetRNode(const RoutingState& state,
+                                                      MemoryArena& arena,
                                                       const RoutePosition& position,
                                                       const WayRef& way,
                                                       size_t routeNodeIndex,
@@ -248,9 +289,10 @@ namespace osmscout {
                                                       const GeoCoord& targetCoord,
                                                       RNodeRef& node)
   {
-    node=std::make_shared<RNode>(DBId(position.GetDatabaseId(),routeNode->GetId()),
-                                 routeNode,
-                                 position.GetObjectFileRef());
+    node=CreateRNode(arena,
+                     DBId(position.GetDatabaseId(),routeNode->GetId()),
+                     routeNode,
+                     position.GetObjectFileRef());
 
     node->currentCost=GetCosts(state,
                                position.GetDatabaseId(),
@@ -293,6 +335,7 @@ namespace osmscout {
    */
   template <class RoutingState>
   bool AbstractRoutingService<RoutingState>::GetWayStartNodes(const RoutingState& state,
+                                                              MemoryArena& arena,
                                                               const RoutePosition& position,
                                                               GeoCoord& startCoord,
                                                               const GeoCoord& targetCoord,
@@ -353,6 +396,7 @@ namespace osmscout {
 
     if (forwardRouteNode &&
         !GetRNode(state,
+                  arena,
                   position,
                   way,
                   forwardNodePos,
@@ -368,6 +412,7 @@ namespace osmscout {
 
     if (backwardRouteNode &&
         !GetRNode(state,
+                  arena,
                   position,
                   way,
                   backwardNodePos,
@@ -410,6 +455,7 @@ namespace osmscout {
    */
   template <class RoutingState>
   bool AbstractRoutingService<RoutingState>::GetStartNodes(const RoutingState& state,
+                                                           MemoryArena& arena,
                                                            const RoutePosition& position,
                                                            GeoCoord& startCoord,
                                                            const GeoCoord& targetCoord,
@@ -420,6 +466,7 @@ namespace osmscout {
   {
     if (position.GetObjectFileRef().GetType()==refWay) {
       return GetWayStartNodes(state,
+                              arena,
                               position,
                               startCoord,
                               targetCoord,
@@ -545,6 +592,7 @@ namespace osmscout {
 
   template <class RoutingState>
   bool AbstractRoutingService<RoutingState>::WalkToOtherDatabases(const RoutingState& state,
+                                                                  MemoryArena& arena,
                                                                   RNodeRef &current,
                                                                   RouteNodeRef &currentRouteNode,
                                                                   OpenList &openList,
@@ -594,12 +642,13 @@ namespace osmscout {
         if (!GetRouteNode(twin,node)){
           return false;
         }
-        RNodeRef rn=std::make_shared<RNode>(twin,
-                                            node,
-                                            //node->objects.begin()->object, /*TODO: how to find correct way from other DB?*/
-                                            ObjectFileRef(), // TODO: have to be valid Object here?
-                                            /*prev*/current->id,
-                                            current->restricted);
+        RNodeRef rn=CreateRNode(arena,
+                                twin,
+                                node,
+                                //node->objects.begin()->object, /*TODO: how to find correct way from other DB?*/
+                                ObjectFileRef(), // TODO: have to be valid Object here?
+                                /*prev*/current->id,
+                                current->restricted);
 
         rn->currentCost=current->currentCost;
         rn->estimateCost=current->estimateCost;
@@ -619,6 +668,7 @@ namespace osmscout {
 
   template <class RoutingState>
   bool AbstractRoutingService<RoutingState>::WalkPaths(const RoutingState &state,
+                                                       MemoryArena& arena,
                                                        RNodeRef &current,
                                                        RouteNodeRef &currentRouteNode,
                                                        OpenList &openList,
@@ -850,11 +900,12 @@ namespace osmscout {
         openEntry->second=insertResult.first;
       }
       else {
-        RNodeRef node=std::make_shared<RNode>(DBId(dbId,path.id),
-                                              nextNode,
-                                              currentRouteNode->objects[path.objectIndex].object,
-                                              current->id,
-                                              current->restricted);
+        RNodeRef node=CreateRNode(arena,
+                                  DBId(dbId,path.id),
+                                  nextNode,
+                                  currentRouteNode->objects[path.objectIndex].object,
+                                  current->id,
+                                  current->restricted);
 
         node->currentCost=currentCost;
         node->estimateCost=estimateCost;
@@ -995,6 +1046,18 @@ namespace osmscout {
                                                                      const std::optional<osmscout::Bearing> &bearing,
                                                                      const RoutingParameter& parameter)
   {
+    if (parameter.IsBidirectional()) {
+      return CalculateRouteBidirectional(state,
+                                         start,
+                                         target,
+                                         bearing,
+                                         parameter);
+    }
+
+    // Memory of the routing nodes and lists of this calculation, declared first
+    // so that it is released after everything allocated from it
+    MemoryArena              arena;
+
     RoutingResult            result;
     Vehicle                  vehicle=GetVehicle(state);
     RouteNodeRef             startForwardRouteNode;
@@ -1009,11 +1072,11 @@ namespace osmscout {
     RouteNodeRef             targetBackwardRouteNode;
 
     // Sorted list (smallest cost first) of ways to check (we are using a std::set)
-    OpenList                 openList;
+    OpenList                 openList(&arena);
     // Map routing nodes by id
-    OpenMap                  openMap;
+    OpenMap                  openMap(&arena);
 
-    ClosedSet                closedSet;
+    ClosedSet                closedSet(&arena);
 
     size_t                   nodesLoadedCount=0;
     size_t                   nodesIgnoredCount=0;
@@ -1032,6 +1095,7 @@ namespace osmscout {
     }
 
     if (!GetStartNodes(state,
+                       arena,
                        start,
                        startCoord,
                        targetCoord,
@@ -1132,6 +1196,7 @@ namespace osmscout {
       }
 
       if (!WalkPaths(state,
+                     arena,
                      current,
                      currentRouteNode,
                      openList,
@@ -1156,6 +1221,7 @@ namespace osmscout {
       //
 
       if (!WalkToOtherDatabases(state,
+                                arena,
                                 current,
                                 currentRouteNode,
                                 openList,
@@ -1247,6 +1313,16 @@ namespace osmscout {
 
     clock.Stop();
 
+    result.SetExpandedNodes(nodesLoadedCount,0);
+
+    if (targetFinalNode) {
+      result.SetCost(targetFinalNode->currentCost);
+    }
+
+    RecordRoutingMetrics(nodesLoadedCount,
+                         nodesIgnoredCount,
+                         clock);
+
     if (debugPerformance) {
       std::cout << "From:                ";
       if (startBackwardRouteNode) {
@@ -1343,6 +1419,768 @@ namespace osmscout {
     return result;
   }
 
+  /**
+   * Collect all route nodes, from which the given route node can be reached directly,
+   * together with the object connecting them.
+   *
+   * Since route nodes only hold paths in the direction they can be traveled,
+   * predecessors reachable via a oneway are not part of the paths of the given node
+   * and have to be searched for by walking the way. The result does not depend on
+   * the routing profile, the caller has to check if the path of the predecessor
+   * can actually be used. Results are cached, since walking the way requires loading it.
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::GetPredecessors(DatabaseId database,
+                                                             const RouteNode& routeNode,
+                                                             Predecessors& predecessors)
+  {
+    DBId                                routeNodeId(database,routeNode.GetId());
+    typename PredecessorCache::CacheRef cacheRef;
+
+    {
+      std::scoped_lock<std::mutex> lock(predecessorCacheMutex);
+
+      if (predecessorCache.GetEntry(routeNodeId,cacheRef)) {
+        predecessors=cacheRef->value;
+
+        return true;
+      }
+    }
+
+    predecessors.clear();
+
+    for (const auto& objectData : routeNode.objects) {
+      const ObjectFileRef& object=objectData.object;
+      std::set<Id>         pathTargets;
+
+      for (const auto& path : routeNode.paths) {
+        if (routeNode.objects[path.objectIndex].object==object) {
+          pathTargets.insert(path.id);
+        }
+      }
+
+      if (object.GetType()!=refWay) {
+        // Areas can be traveled in all directions
+        for (const auto& id : pathTargets) {
+          predecessors.emplace_back(id,object);
+        }
+
+        continue;
+      }
+
+      WayRef way;
+
+      if (!GetWayByOffset(DBFileOffset(database,
+                                       object.GetFileOffset()),
+                          way)) {
+        log.Error() << "Cannot load way " << object.GetName();
+        return false;
+      }
+
+      auto addPredecessor=[&](size_t index) {
+        Id id=way->GetId(index);
+
+        if (pathTargets.contains(id)) {
+          predecessors.emplace_back(id,object);
+          return true;
+        }
+
+        RouteNodeRef node;
+
+        GetRouteNode(DBId(database,
+                          id),
+                     node);
+
+        if (node) {
+          predecessors.emplace_back(id,object);
+          return true;
+        }
+
+        return false;
+      };
+
+      for (size_t index=0; index<way->nodes.size(); index++) {
+        if (way->GetId(index)!=routeNode.GetId()) {
+          continue;
+        }
+
+        // Predecessor with smaller index, reaching us in way direction
+        for (long i=(long)index-1; i>=0; i--) {
+          if (addPredecessor((size_t)i)) {
+            break;
+          }
+        }
+
+        // Predecessor with bigger index, reaching us against way direction
+        for (size_t i=index+1; i<way->nodes.size(); i++) {
+          if (addPredecessor(i)) {
+            break;
+          }
+        }
+      }
+    }
+
+    std::sort(predecessors.begin(),predecessors.end());
+    predecessors.erase(std::unique(predecessors.begin(),predecessors.end()),
+                       predecessors.end());
+
+    std::scoped_lock<std::mutex> lock(predecessorCacheMutex);
+
+    predecessorCache.SetEntry(typename PredecessorCache::CacheEntry(routeNodeId,
+                                                                    predecessors));
+
+    return true;
+  }
+
+  /**
+   * Expand the given node of the backward search (the search starting at the target).
+   *
+   * A node of the backward search holds the route node, the next route node in direction of
+   * the target as "prev" and the object used to travel to this next route node as "object".
+   * Its currentCost contains the costs from this route node to the target, including
+   * the costs of the path to the next route node, but excluding the junction
+   * penalty at this route node (which depends on the yet unknown incoming path).
+   * The flag "restricted" signals, that all paths up to the target are restricted.
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::WalkPathsBackward(const RoutingState& state,
+                                                               MemoryArena& arena,
+                                                               RNodeRef &current,
+                                                               OpenList &openList,
+                                                               OpenMap &openMap,
+                                                               const ClosedSet &closedSet,
+                                                               const GeoCoord &startCoord,
+                                                               const Vehicle &vehicle,
+                                                               size_t &nodesIgnoredCount,
+                                                               const double &costLimit)
+  {
+    assert(current);
+    const RouteNode& currentRouteNode=*current->node;
+    DatabaseId       dbId=current->id.database;
+
+    // The path used to travel to the next route node in direction of the target (if any)
+    std::optional<size_t> outPathIndex;
+
+    if (current->prev.IsValid() && dbId==current->prev.database) {
+      outPathIndex=FindPathIndex(currentRouteNode,
+                                 current->prev.id,
+                                 current->object);
+    }
+
+    Predecessors predecessors;
+
+    if (!GetPredecessors(dbId,
+                         currentRouteNode,
+                         predecessors)) {
+      return false;
+    }
+
+    for (const auto& [predecessorId,object] : predecessors) {
+      if (predecessorId==current->prev.id) {
+        if constexpr (debugRouting) {
+          std::cout << "  Skipping route from " << predecessorId << " => back to the last node visited" << std::endl;
+        }
+        nodesIgnoredCount++;
+
+        continue;
+      }
+
+      if (outPathIndex &&
+          !currentRouteNode.excludes.empty()) {
+        const ObjectFileRef& outObject=currentRouteNode.objects[currentRouteNode.paths[*outPathIndex].objectIndex].object;
+        bool                 canTurnedInto=true;
+
+        for (const auto& exclude : currentRouteNode.excludes) {
+          if (exclude.source==object &&
+              currentRouteNode.objects[currentRouteNode.paths[exclude.targetIndex].objectIndex].object==outObject) {
+            canTurnedInto=false;
+            break;
+          }
+        }
+
+        if (!canTurnedInto) {
+          if constexpr (debugRouting) {
+            std::cout << "  Skipping route from " << predecessorId << " => turn not allowed" << std::endl;
+          }
+          nodesIgnoredCount++;
+
+          continue;
+        }
+      }
+
+      DBId         id(dbId,predecessorId);
+      auto         openEntry=openMap.find(id);
+      RouteNodeRef predecessor;
+
+      if (openEntry!=openMap.end()) {
+        predecessor=(*openEntry->second)->node;
+      }
+      else if (!GetRouteNode(id,
+                             predecessor) ||
+               !predecessor) {
+        log.Error() << "Cannot load route node with id " << predecessorId;
+        return false;
+      }
+
+      std::optional<size_t> pathIndex=FindPathIndex(*predecessor,
+                                                    currentRouteNode.GetId(),
+                                                    object);
+
+      if (!pathIndex) {
+        if constexpr (debugRouting) {
+          std::cout << "  Skipping route from " << predecessorId << " => no path in this direction" << std::endl;
+        }
+        nodesIgnoredCount++;
+
+        continue;
+      }
+
+      const RouteNode::Path& path=predecessor->paths[*pathIndex];
+      bool                   pathRestricted=path.IsRestricted(vehicle);
+
+      if (pathRestricted &&
+          !current->restricted) {
+        // Restricted paths may only be used at the beginning (handled by the forward search)
+        // or at the end of the route
+        if constexpr (debugRouting) {
+          std::cout << "  Skipping route from " << predecessorId << " => moving from non-accessible way back to accessible way" << std::endl;
+        }
+        nodesIgnoredCount++;
+
+        continue;
+      }
+
+      if (!CanUse(state,
+                  dbId,
+                  *predecessor,
+                  *pathIndex)) {
+        if constexpr (debugRouting) {
+          std::cout << "  Skipping route from " << predecessorId << " => Cannot be used" << std::endl;
+        }
+        nodesIgnoredCount++;
+
+        continue;
+      }
+
+      bool restricted=pathRestricted && current->restricted;
+
+      if (closedSet.contains(VNode(id,restricted))) {
+        continue;
+      }
+
+      double junctionCost=0.0;
+
+      if (outPathIndex) {
+        // the path back to the predecessor, as used by the forward search for finding the incoming path
+        std::optional<size_t> inPathIndex=FindPathIndex(currentRouteNode,
+                                                        predecessorId,
+                                                        object);
+
+        junctionCost=GetCosts(state,
+                              dbId,
+                              currentRouteNode,
+                              inPathIndex ? *inPathIndex : *outPathIndex,
+                              *outPathIndex)-
+                     GetCosts(state,
+                              dbId,
+                              currentRouteNode,
+                              *outPathIndex,
+                              *outPathIndex);
+      }
+
+      double currentCost=current->currentCost+
+                         junctionCost+
+                         GetCosts(state,
+                                  dbId,
+                                  *predecessor,
+                                  *pathIndex,
+                                  *pathIndex);
+
+      if (openEntry!=openMap.end() &&
+          (*openEntry->second)->currentCost<=currentCost) {
+        continue;
+      }
+
+      double estimateCost=GetEstimateCosts(state,
+                                           dbId,
+                                           GetSphericalDistance(predecessor->GetCoord(),
+                                                                startCoord));
+      double overallCost=currentCost+estimateCost;
+
+      if (overallCost>costLimit) {
+        nodesIgnoredCount++;
+
+        continue;
+      }
+
+      RNodeRef node;
+
+      if (openEntry!=openMap.end()) {
+        node=*openEntry->second;
+        openList.erase(openEntry->second);
+
+        node->prev=current->id;
+        node->prevRestricted=current->restricted;
+        node->object=object;
+      }
+      else {
+        node=CreateRNode(arena,
+                         id,
+                         predecessor,
+                         object,
+                         current->id,
+                         current->restricted);
+      }
+
+      node->currentCost=currentCost;
+      node->estimateCost=estimateCost;
+      node->overallCost=overallCost;
+      node->restricted=restricted;
+
+      if constexpr (debugRouting) {
+        std::cout << "  Inserting route from " << predecessorId;
+        std::cout << " (" << object.GetTypeName() << " " << object.GetFileOffset() << ")";
+        std::cout << " " << currentCost << " " << estimateCost << " " << overallCost << std::endl;
+      }
+
+      std::pair<OpenListRef,bool> insertResult=openList.insert(node);
+      openMap[node->id]=insertResult.first;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return the costs of the route consisting of the route from the start to the given
+   * node of the forward search and the route from the given node of the backward search
+   * (for the same route node) to the target. If both cannot be combined, because of turn
+   * or access restrictions, no value is returned.
+   */
+  template <class RoutingState>
+  std::optional<double> AbstractRoutingService<RoutingState>::GetMeetingCosts(const RoutingState& state,
+                                                                              const RNode& forwardNode,
+                                                                              const RNode& backwardNode,
+                                                                              const Vehicle &vehicle)
+  {
+    assert(forwardNode.id==backwardNode.id);
+    assert(backwardNode.node);
+
+    const RouteNode&      routeNode=*backwardNode.node;
+    DatabaseId            dbId=backwardNode.id.database;
+    std::optional<size_t> outPathIndex;
+
+    if (backwardNode.prev.IsValid() && dbId==backwardNode.prev.database) {
+      outPathIndex=FindPathIndex(routeNode,
+                                 backwardNode.prev.id,
+                                 backwardNode.object);
+    }
+
+    if (!outPathIndex) {
+      // target route node or transition to another database
+      return forwardNode.currentCost+backwardNode.currentCost;
+    }
+
+    const RouteNode::Path& path=routeNode.paths[*outPathIndex];
+
+    if (path.id==forwardNode.prev.id ||
+        path.id==forwardNode.exclude) {
+      return std::nullopt;
+    }
+
+    if (forwardNode.restricted &&
+        !path.IsRestricted(vehicle) &&
+        !forwardNode.leaveRestricted) {
+      return std::nullopt;
+    }
+
+    for (const auto& exclude : routeNode.excludes) {
+      if (exclude.source==forwardNode.object &&
+          routeNode.objects[routeNode.paths[exclude.targetIndex].objectIndex].object==routeNode.objects[path.objectIndex].object) {
+        return std::nullopt;
+      }
+    }
+
+    std::optional<size_t> inPathIndex;
+
+    if (forwardNode.prev.IsValid() && dbId==forwardNode.prev.database) {
+      inPathIndex=FindPathIndex(routeNode,
+                                forwardNode.prev.id,
+                                forwardNode.object);
+    }
+
+    double junctionCost=0.0;
+
+    if (inPathIndex) {
+      junctionCost=GetCosts(state,
+                            dbId,
+                            routeNode,
+                            *inPathIndex,
+                            *outPathIndex)-
+                   GetCosts(state,
+                            dbId,
+                            routeNode,
+                            *outPathIndex,
+                            *outPathIndex);
+    }
+
+    return forwardNode.currentCost+junctionCost+backwardNode.currentCost;
+  }
+
+  /**
+   * Calculate a route using a bidirectional A* search. The forward search works
+   * exactly as the unidirectional search (estimating the costs to the target), the backward
+   * search starts at the target route nodes and estimates the costs to the start. Since both
+   * estimates are consistent, the search can stop as soon as the lowest estimate of one of
+   * the searches is not better than the best route found by joining both searches.
+   *
+   * Expansion alternates between both searches, always continuing the search with the
+   * smaller open list.
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of the route
+   * @param bearing
+   *    Initial vehicle bearing, route will start by the way in specified direction. When possible.
+   * @param parameter
+   *    Optional breaker and progress
+   * @return
+   *    The result, containing the route, if the engine was able to find one
+   */
+  template <class RoutingState>
+  RoutingResult AbstractRoutingService<RoutingState>::CalculateRouteBidirectional(RoutingState& state,
+                                                                                  const RoutePosition& start,
+                                                                                  const RoutePosition& target,
+                                                                                  const std::optional<osmscout::Bearing> &bearing,
+                                                                                  const RoutingParameter& parameter)
+  {
+    // Memory of the routing nodes and lists of this calculation, declared first
+    // so that it is released after everything allocated from it
+    MemoryArena              arena;
+
+    RoutingResult            result;
+    Vehicle                  vehicle=GetVehicle(state);
+    RouteNodeRef             startForwardRouteNode;
+    RouteNodeRef             startBackwardRouteNode;
+    RNodeRef                 startForwardNode;
+    RNodeRef                 startBackwardNode;
+
+    GeoCoord                 startCoord;
+    GeoCoord                 targetCoord;
+
+    RouteNodeRef             targetForwardRouteNode;
+    RouteNodeRef             targetBackwardRouteNode;
+
+    OpenList                 forwardOpenList(&arena);
+    OpenMap                  forwardOpenMap(&arena);
+    ClosedSet                forwardClosedSet(&arena);
+    ClosedMap                forwardClosedMap(&arena);
+
+    OpenList                 backwardOpenList(&arena);
+    OpenMap                  backwardOpenMap(&arena);
+    ClosedSet                backwardClosedSet(&arena);
+    ClosedMap                backwardClosedMap(&arena);
+
+    size_t                   forwardNodesLoadedCount=0;
+    size_t                   backwardNodesLoadedCount=0;
+    size_t                   nodesIgnoredCount=0;
+
+    if (!GetTargetNodes(state,
+                        target,
+                        targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return result;
+    }
+
+    if (!GetStartNodes(state,
+                       arena,
+                       start,
+                       startCoord,
+                       targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return result;
+    }
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    if (bearing) {
+      if (!RestrictInitialUTurn(state, *bearing, start, startForwardNode, startBackwardNode)) {
+        return result;
+      }
+    }
+
+    for (const auto& node : {startForwardNode, startBackwardNode}) {
+      if (node) {
+        std::pair<OpenListRef,bool> insertResult=forwardOpenList.insert(node);
+
+        forwardOpenMap[node->id]=insertResult.first;
+      }
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode, targetBackwardRouteNode}) {
+      if (routeNode) {
+        RNodeRef node=CreateRNode(arena,
+                                  DBId(target.GetDatabaseId(),routeNode->GetId()),
+                                  routeNode,
+                                  target.GetObjectFileRef());
+
+        node->estimateCost=GetEstimateCosts(state,
+                                            target.GetDatabaseId(),
+                                            GetSphericalDistance(routeNode->GetCoord(),
+                                                                 startCoord));
+        node->overallCost=node->estimateCost;
+
+        std::pair<OpenListRef,bool> insertResult=backwardOpenList.insert(node);
+
+        backwardOpenMap[node->id]=insertResult.first;
+      }
+    }
+
+    Distance currentMaxDistance;
+    Distance overallDistance=GetSphericalDistance(startCoord,
+                                                  targetCoord);
+    double   costLimit=GetCostLimit(state,start.GetDatabaseId(),overallDistance);
+
+    result.SetOverallDistance(overallDistance);
+    result.SetCurrentMaxDistance(currentMaxDistance);
+
+    StopClock clock;
+    double    bestCost=std::numeric_limits<double>::infinity();
+    RNodeRef  meetingForwardNode;
+    RNodeRef  meetingBackwardNode;
+
+    auto checkMeeting=[&](const RNodeRef& forwardNode,
+                          const RNodeRef& backwardNode) {
+      std::optional<double> cost=GetMeetingCosts(state,
+                                                 *forwardNode,
+                                                 *backwardNode,
+                                                 vehicle);
+
+      if (cost && *cost<bestCost) {
+        bestCost=*cost;
+        meetingForwardNode=forwardNode;
+        meetingBackwardNode=backwardNode;
+      }
+    };
+
+    // If one open list runs empty, all route nodes reachable in this direction have been
+    // checked against the other search, so there cannot be a better route
+    while (!forwardOpenList.empty() &&
+           !backwardOpenList.empty()) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return result;
+      }
+
+      if ((*forwardOpenList.begin())->overallCost>=bestCost ||
+          (*backwardOpenList.begin())->overallCost>=bestCost) {
+        break;
+      }
+
+      if (forwardOpenList.size()<=backwardOpenList.size()) {
+        RNodeRef     current=*forwardOpenList.begin();
+        RouteNodeRef currentRouteNode=current->node;
+
+        forwardOpenMap.erase(current->id);
+        forwardOpenList.erase(forwardOpenList.begin());
+
+        forwardNodesLoadedCount++;
+
+        if (!WalkPaths(state,
+                       arena,
+                       current,
+                       currentRouteNode,
+                       forwardOpenList,
+                       forwardOpenMap,
+                       forwardClosedSet,
+                       result,
+                       parameter,
+                       targetCoord,
+                       vehicle,
+                       nodesIgnoredCount,
+                       currentMaxDistance,
+                       overallDistance,
+                       costLimit)) {
+          log.Error() << "Failed to walk paths from " << current->id.database << " / " << current->id.id;
+          return result;
+        }
+
+        if (!WalkToOtherDatabases(state,
+                                  arena,
+                                  current,
+                                  currentRouteNode,
+                                  forwardOpenList,
+                                  forwardOpenMap,
+                                  forwardClosedSet)) {
+          log.Error() << "Failed to walk to other databases from " << current->id.database << " / " << current->id.id;
+          return result;
+        }
+
+        forwardClosedSet.insert(VNode(current->id,
+                                      current->restricted,
+                                      current->object,
+                                      current->prev,
+                                      current->prevRestricted));
+        forwardClosedMap.emplace(current->id,current);
+
+        if (auto entry=backwardClosedMap.find(current->id); entry!=backwardClosedMap.end()) {
+          checkMeeting(current,entry->second);
+        }
+        else if (auto openEntry=backwardOpenMap.find(current->id); openEntry!=backwardOpenMap.end()) {
+          checkMeeting(current,*openEntry->second);
+        }
+      }
+      else {
+        RNodeRef     current=*backwardOpenList.begin();
+        RouteNodeRef currentRouteNode=current->node;
+
+        backwardOpenMap.erase(current->id);
+        backwardOpenList.erase(backwardOpenList.begin());
+
+        backwardNodesLoadedCount++;
+
+        if (!WalkPathsBackward(state,
+                               arena,
+                               current,
+                               backwardOpenList,
+                               backwardOpenMap,
+                               backwardClosedSet,
+                               startCoord,
+                               vehicle,
+                               nodesIgnoredCount,
+                               costLimit)) {
+          log.Error() << "Failed to walk paths backward from " << current->id.database << " / " << current->id.id;
+          return result;
+        }
+
+        if (!WalkToOtherDatabases(state,
+                                  arena,
+                                  current,
+                                  currentRouteNode,
+                                  backwardOpenList,
+                                  backwardOpenMap,
+                                  backwardClosedSet)) {
+          log.Error() << "Failed to walk to other databases from " << current->id.database << " / " << current->id.id;
+          return result;
+        }
+
+        backwardClosedSet.insert(VNode(current->id,
+                                       current->restricted,
+                                       current->object,
+                                       current->prev,
+                                       current->prevRestricted));
+        backwardClosedMap.emplace(current->id,current);
+
+        if (auto entry=forwardClosedMap.find(current->id); entry!=forwardClosedMap.end()) {
+          checkMeeting(entry->second,current);
+        }
+        else if (auto openEntry=forwardOpenMap.find(current->id); openEntry!=forwardOpenMap.end()) {
+          checkMeeting(*openEntry->second,current);
+        }
+      }
+    }
+
+    clock.Stop();
+
+    result.SetExpandedNodes(forwardNodesLoadedCount,
+                            backwardNodesLoadedCount);
+
+    if (meetingForwardNode) {
+      result.SetCost(bestCost);
+    }
+
+    RecordRoutingMetrics(forwardNodesLoadedCount+backwardNodesLoadedCount,
+                         nodesIgnoredCount,
+                         clock);
+
+    if (debugPerformance) {
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Air-line distance:   " << std::fixed << std::setprecision(1) << overallDistance.As<Kilometer>() << " km" << std::endl;
+      if (meetingForwardNode) {
+        std::cout << "Actual cost:         " << GetCostString(state, start.GetDatabaseId(), bestCost) << std::endl;
+      }
+      std::cout << "Cost limit:          " << GetCostString(state, start.GetDatabaseId(), costLimit) << std::endl;
+      std::cout << "Route nodes loaded:  " << forwardNodesLoadedCount << " forward, " << backwardNodesLoadedCount << " backward" << std::endl;
+      std::cout << "Route nodes ignored: " << nodesIgnoredCount << std::endl;
+    }
+
+    if (!meetingForwardNode) {
+      log.Warn() << "No route found!";
+
+      return result;
+    }
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    // The meeting node may still be part of the forward open list
+    if (!forwardClosedSet.contains(VNode(meetingForwardNode->id, meetingForwardNode->restricted))) {
+      forwardClosedSet.insert(VNode(meetingForwardNode->id,
+                                    meetingForwardNode->restricted,
+                                    meetingForwardNode->object,
+                                    meetingForwardNode->prev,
+                                    meetingForwardNode->prevRestricted));
+    }
+
+    std::list<VNode> nodes;
+
+    ResolveRNodeChainToList(*meetingForwardNode,
+                            forwardClosedSet,
+                            nodes);
+
+    // Append the chain of the backward search up to the target
+    DBId          previous=meetingBackwardNode->id;
+    DBId          next=meetingBackwardNode->prev;
+    bool          nextRestricted=meetingBackwardNode->prevRestricted;
+    ObjectFileRef object=meetingBackwardNode->object;
+
+    while (next.IsValid()) {
+      auto entry=backwardClosedSet.find(VNode(next,nextRestricted));
+      assert(entry!=backwardClosedSet.end());
+
+      nodes.emplace_back(next,
+                         nextRestricted,
+                         object,
+                         previous,
+                         false);
+
+      previous=next;
+      object=entry->object;
+      next=entry->previousNode;
+      nextRestricted=entry->previousRestricted;
+    }
+
+    if constexpr (debugRouting) {
+      std::cout << "VNode List:" << std::endl;
+      for (const auto& node : nodes) {
+        std::cout << node.object.GetName() << " " << node.currentNode.database << "/" << node.currentNode.id << std::endl;
+      }
+    }
+
+    if (!ResolveRNodesToRouteData(state,
+                                  nodes,
+                                  start,
+                                  target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    return result;
+  }
+
   template <class RoutingState>
   void AbstractRoutingService<RoutingState>::AddNodes(RouteData& route,
                                                       DatabaseId database,
@@ -0,0 +1,816 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/MapMatchingService.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <osmscout/db/AreaWayIndex.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/TileId.h>
+
+namespace osmscout {
+
+  void MapMatchingParameter::SetCandidateRadius(const Distance& radius)
+  {
+    this->candidateRadius=radius;
+  }
+
+  void MapMatchingParameter::SetMaxCandidates(size_t maxCandidates)
+  {
+    this->maxCandidates=maxCandidates;
+  }
+
+  void MapMatchingParameter::SetGpsSigma(const Distance& sigma)
+  {
+    this->gpsSigma=sigma;
+  }
+
+  void MapMatchingParameter::SetTransitionBeta(const Distance& beta)
+  {
+    this->transitionBeta=beta;
+  }
+
+  void MapMatchingParameter::SetRouteDistanceFactor(double factor)
+  {
+    this->routeDistanceFactor=factor;
+  }
+
+  void MapMatchingParameter::SetMinRouteDistanceLimit(const Distance& limit)
+  {
+    this->minRouteDistanceLimit=limit;
+  }
+
+  void MapMatchingParameter::SetMaxTransitionDistance(const Distance& distance)
+  {
+    this->maxTransitionDistance=distance;
+  }
+
+  void MapMatchingParameter::SetMinFixDistance(const Distance& distance)
+  {
+    this->minFixDistance=distance;
+  }
+
+  void MapMatchingParameter::SetThreads(size_t threads)
+  {
+    this->threads=threads;
+  }
+
+  void MapMatchingParameter::SetBreaker(const BreakerRef& breaker)
+  {
+    this->breaker=breaker;
+  }
+
+  size_t MapMatchingResult::GetMatchedCount() const
+  {
+    return std::count_if(fixes.begin(),
+                         fixes.end(),
+                         [](const MatchedFix& fix) {
+                           return fix.matched;
+                         });
+  }
+
+  namespace {
+
+    constexpr double NoScore=-std::numeric_limits<double>::infinity();
+    constexpr double NoDistance=std::numeric_limits<double>::infinity();
+
+    //! Magnification of the cells used for loading and caching ways (~600m at the equator)
+    const Magnification cellMagnification{MagnificationLevel(16)};
+
+    //! Number of cached cells after which the per trace cache is flushed
+    constexpr size_t maxCachedCells=1024;
+
+    struct Candidate
+    {
+      WayRef   way;
+      size_t   segment=0;
+      GeoCoord coord;
+      double   fraction=0.0;
+      double   distance=0.0;   //!< distance to the fix in meter
+      double   emission=0.0;   //!< log probability of the fix being observed on this candidate
+    };
+
+    struct CachedWay
+    {
+      WayRef way;
+      GeoBox boundingBox;
+    };
+
+    struct Edge
+    {
+      Id         target;
+      FileOffset way;
+      double     length;
+    };
+
+    /**
+     * Projects the coordinate onto the nearest segment of the given way
+     */
+    Candidate Project(const WayRef& way,
+                      const GeoCoord& coord)
+    {
+      Candidate candidate;
+      double    minDistance=std::numeric_limits<double>::max();
+
+      candidate.way=way;
+
+      for (size_t i=1; i<way->nodes.size(); i++) {
+        double   r;
+        GeoCoord intersection;
+        double   d=DistanceToSegment(coord,
+                                     way->nodes[i-1].GetCoord(),
+                                     way->nodes[i].GetCoord(),
+                                     r,
+                                     intersection);
+
+        if (d<minDistance) {
+          minDistance=d;
+          candidate.segment=i-1;
+          candidate.fraction=r;
+          candidate.coord=intersection;
+        }
+      }
+
+      candidate.distance=GetSphericalDistance(coord,candidate.coord).AsMeter();
+
+      return candidate;
+    }
+
+    /**
+     * Per trace state: loaded ways, the local routing graph built from them
+     * and the cells they were loaded for.
+     */
+    class MatchingContext
+    {
+    private:
+      const Database&       database;
+      const RoutingProfile& profile;
+      const TypeInfoSet&    routableTypes;
+
+      std::unordered_map<TileId,std::vector<FileOffset>,TileIdHasher> cells;
+      std::unordered_map<FileOffset,CachedWay>                        ways;
+      std::unordered_map<Id,std::vector<Edge>>                        graph;
+
+    private:
+      void AddWay(const WayRef& way);
+
+    public:
+      MatchingContext(const Database& database,
+                      const RoutingProfile& profile,
+                      const TypeInfoSet& routableTypes)
+      : database(database),
+        profile(profile),
+        routableTypes(routableTypes)
+      {
+        // no code
+      }
+
+      void Flush();
+      bool Load(const GeoBox& boundingBox);
+
+      std::vector<Candidate> GetCandidates(const GeoCoord& coord,
+                                           const Distance& radius,
+                                           size_t maxCandidates) const;
+
+      void Route(const Candidate& from,
+                 const std::vector<Candidate>& to,
+                 double directTolerance,
+                 double limit,
+                 std::vector<double>& distances,
+                 std::vector<std::vector<FileOffset>>& paths) const;
+    };
+
+    void MatchingContext::Flush()
+    {
+      if (cells.size()<=maxCachedCells) {
+        return;
+      }
+
+      cells.clear();
+      ways.clear();
+      graph.clear();
+    }
+
+    void MatchingContext::AddWay(const WayRef& way)
+    {
+      bool forward=profile.CanUseForward(*way);
+      bool backward=profile.CanUseBackward(*way);
+
+      ways[way->GetFileOffset()]=CachedWay{way,way->GetBoundingBox()};
+
+      for (size_t i=1; i<way->nodes.size(); i++) {
+        Id     a=way->nodes[i-1].GetId();
+        Id     b=way->nodes[i].GetId();
+        double length=GetSphericalDistance(way->nodes[i-1].GetCoord(),
+                                           way->nodes[i].GetCoord()).AsMeter();
+
+        if (forward) {
+          graph[a].push_back(Edge{b,way->GetFileOffset(),length});
+        }
+
+        if (backward) {
+          graph[b].push_back(Edge{a,way->GetFileOffset(),length});
+        }
+      }
+    }
+
+    /**
+     * Makes sure, that all routable ways in cells covering the given bounding box
+     * are loaded and part of the local graph.
+     */
+    bool MatchingContext::Load(const GeoBox& boundingBox)
+    {
+      AreaWayIndexRef areaWayIndex=database.GetAreaWayIndex();
+
+      if (!areaWayIndex) {
+        return false;
+      }
+
+      std::vector<FileOffset> newOffsets;
+
+      for (const auto& tile : TileIdBox(cellMagnification,boundingBox)) {
+        if (cells.find(tile)!=cells.end()) {
+          continue;
+        }
+
+        std::vector<FileOffset> offsets;
+        TypeInfoSet             loadedTypes;
+
+        if (!areaWayIndex->GetOffsets(tile.GetBoundingBox(cellMagnification),
+                                      routableTypes,
+                                      offsets,
+                                      loadedTypes)) {
+          return false;
+        }
+
+        for (const auto& offset : offsets) {
+          if (ways.find(offset)==ways.end()) {
+            newOffsets.push_back(offset);
+          }
+        }
+
+        cells[tile]=std::move(offsets);
+      }
+
+      if (newOffsets.empty()) {
+        return true;
+      }
+
+      std::sort(newOffsets.begin(),newOffsets.end());
+      newOffsets.erase(std::unique(newOffsets.begin(),newOffsets.end()),newOffsets.end());
+
+      std::vector<WayRef> newWays;
+
+      if (!database.GetWaysByOffset(newOffsets,newWays)) {
+        return false;
+      }
+
+      for (const auto& way : newWays) {
+        if (way->nodes.size()>=2 &&
+            profile.CanUse(*way)) {
+          AddWay(way);
+        }
+      }
+
+      return true;
+    }
+
+    std::vector<Candidate> MatchingContext::GetCandidates(const GeoCoord& coord,
+                                                          const Distance& radius,
+                                                          size_t maxCandidates) const
+    {
+      GeoBox                         lookupBox=GeoBox::BoxByCenterAndRadius(coord,radius);
+      std::unordered_set<FileOffset> visited;
+      std::vector<Candidate>         candidates;
+
+      for (const auto& tile : TileIdBox(cellMagnification,lookupBox)) {
+        auto cell=cells.find(tile);
+
+        if (cell==cells.end()) {
+          continue;
+        }
+
+        for (const auto& offset : cell->second) {
+          if (!visited.insert(offset).second) {
+            continue;
+          }
+
+          auto entry=ways.find(offset);
+
+          if (entry==ways.end() ||
+              !entry->second.boundingBox.Intersects(lookupBox)) {
+            continue;
+          }
+
+          Candidate candidate=Project(entry->second.way,coord);
+
+          if (candidate.distance<=radius.AsMeter()) {
+            candidates.push_back(candidate);
+          }
+        }
+      }
+
+      std::sort(candidates.begin(),
+                candidates.end(),
+                [](const Candidate& a, const Candidate& b) {
+                  return a.distance<b.distance;
+                });
+
+      if (candidates.size()>maxCandidates) {
+        candidates.resize(maxCandidates);
+      }
+
+      return candidates;
+    }
+
+    /**
+     * Bounded Dijkstra search on the local graph from one candidate to all candidates of
+     * the next fix. Returns the on-road distance for each target (or infinity) and the
+     * ways passed.
+     */
+    void MatchingContext::Route(const Candidate& from,
+                                const std::vector<Candidate>& to,
+                                double directTolerance,
+                                double limit,
+                                std::vector<double>& distances,
+                                std::vector<std::vector<FileOffset>>& paths) const
+    {
+      struct Visit
+      {
+        double     distance;
+        Id         prev;
+        FileOffset way;
+        bool       source;
+      };
+
+      struct Target
+      {
+        size_t index;
+        double extra;
+      };
+
+      using QueueEntry = std::pair<double,Id>;
+
+      distances.assign(to.size(),NoDistance);
+      paths.assign(to.size(),std::vector<FileOffset>());
+
+      std::unordered_map<Id,std::vector<Target>> targets;
+      std::vector<Id>                            reachedNode(to.size(),0);
+      size_t                                     openTargets=0;
+
+      for (size_t t=0; t<to.size(); t++) {
+        const Candidate& target=to[t];
+
+        // Movement on the same segment does not require a graph search
+        if (target.way->GetFileOffset()==from.way->GetFileOffset() &&
+            target.segment==from.segment) {
+          double direct=GetSphericalDistance(from.coord,target.coord).AsMeter();
+          bool   allowed=direct<=directTolerance ||
+                         (target.fraction>=from.fraction && profile.CanUseForward(*target.way)) ||
+                         (target.fraction<=from.fraction && profile.CanUseBackward(*target.way));
+
+          if (allowed) {
+            distances[t]=direct;
+            paths[t]={target.way->GetFileOffset()};
+            continue;
+          }
+        }
+
+        const Point& start=target.way->nodes[target.segment];
+        const Point& end=target.way->nodes[target.segment+1];
+
+        if (profile.CanUseForward(*target.way)) {
+          targets[start.GetId()].push_back(Target{t,GetSphericalDistance(start.GetCoord(),target.coord).AsMeter()});
+        }
+
+        if (profile.CanUseBackward(*target.way)) {
+          targets[end.GetId()].push_back(Target{t,GetSphericalDistance(end.GetCoord(),target.coord).AsMeter()});
+        }
+
+        openTargets++;
+      }
+
+      if (openTargets==0) {
+        return;
+      }
+
+      std::unordered_map<Id,Visit>                                             visits;
+      std::priority_queue<QueueEntry,std::vector<QueueEntry>,std::greater<>> queue;
+
+      auto addSource=[&](const Point& node) {
+        double distance=GetSphericalDistance(from.coord,node.GetCoord()).AsMeter();
+        auto   entry=visits.find(node.GetId());
+
+        if (entry==visits.end() ||
+            distance<entry->second.distance) {
+          visits[node.GetId()]=Visit{distance,0,from.way->GetFileOffset(),true};
+          queue.emplace(distance,node.GetId());
+        }
+      };
+
+      if (profile.CanUseForward(*from.way)) {
+        addSource(from.way->nodes[from.segment+1]);
+      }
+
+      if (profile.CanUseBackward(*from.way)) {
+        addSource(from.way->nodes[from.segment]);
+      }
+
+      while (!queue.empty()) {
+        auto [distance,current]=queue.top();
+        queue.pop();
+
+        if (distance>visits[current].distance) {
+          continue;
+        }
+
+        if (distance>limit) {
+          break;
+        }
+
+        // All targets already have a distance not worse than anything we could still find
+        bool done=true;
+
+        for (double targetDistance : distances) {
+          if (targetDistance>distance) {
+            done=false;
+            break;
+          }
+        }
+
+        if (done) {
+          break;
+        }
+
+        if (auto targetEntry=targets.find(current);
+            targetEntry!=targets.end()) {
+          for (const auto& target : targetEntry->second) {
+            if (distance+target.extra<distances[target.index]) {
+              distances[target.index]=distance+target.extra;
+              reachedNode[target.index]=current;
+            }
+          }
+        }
+
+        auto edges=graph.find(current);
+
+        if (edges==graph.end()) {
+          continue;
+        }
+
+        for (const auto& edge : edges->second) {
+          double newDistance=distance+edge.length;
+          auto   visit=visits.find(edge.target);
+
+          if (visit==visits.end() ||
+              newDistance<visit->second.distance) {
+            visits[edge.target]=Visit{newDistance,current,edge.way,false};
+            queue.emplace(newDistance,edge.target);
+          }
+        }
+      }
+
+      for (size_t t=0; t<to.size(); t++) {
+        if (!paths[t].empty()) {
+          continue;
+        }
+
+        if (distances[t]>limit) {
+          distances[t]=NoDistance;
+          continue;
+        }
+
+        std::vector<FileOffset> path;
+        Id                      node=reachedNode[t];
+
+        while (true) {
+          const Visit& visit=visits[node];
+
+          if (path.empty() || path.back()!=visit.way) {
+            path.push_back(visit.way);
+          }
+
+          if (visit.source) {
+            break;
+          }
+
+          node=visit.prev;
+        }
+
+        std::reverse(path.begin(),path.end());
+
+        if (path.back()!=to[t].way->GetFileOffset()) {
+          path.push_back(to[t].way->GetFileOffset());
+        }
+
+        paths[t]=std::move(path);
+      }
+    }
+
+    struct Step
+    {
+      size_t                               fixIndex;
+      std::vector<size_t>                  followers;  //!< fixes skipped because they are too close to this one
+      std::vector<Candidate>               candidates;
+      std::vector<double>                  scores;
+      std::vector<size_t>                  back;
+      std::vector<std::vector<FileOffset>> paths;      //!< ways passed from the previous step to each candidate
+    };
+
+    void ResolveChain(const std::vector<MapMatchingFix>& trace,
+                      std::vector<Step>& chain,
+                      std::vector<MatchedFix>& fixes,
+                      std::vector<ObjectFileRef>& path)
+    {
+      if (chain.empty()) {
+        return;
+      }
+
+      const Step& last=chain.back();
+      size_t      best=std::distance(last.scores.begin(),
+                                     std::max_element(last.scores.begin(),last.scores.end()));
+      std::vector<size_t> chosen(chain.size());
+
+      for (size_t s=chain.size(); s>0; s--) {
+        chosen[s-1]=best;
+        best=chain[s-1].back[best];
+      }
+
+      for (size_t s=0; s<chain.size(); s++) {
+        const Step&      step=chain[s];
+        const Candidate& candidate=step.candidates[chosen[s]];
+        MatchedFix&      fix=fixes[step.fixIndex];
+
+        fix.matched=true;
+        fix.way=candidate.way;
+        fix.object=candidate.way->GetObjectFileRef();
+        fix.segment=candidate.segment;
+        fix.coord=candidate.coord;
+        fix.distance=Meters(candidate.distance);
+
+        for (size_t follower : step.followers) {
+          Candidate   projection=Project(candidate.way,trace[follower].coord);
+          MatchedFix& followerFix=fixes[follower];
+
+          followerFix.matched=true;
+          followerFix.way=candidate.way;
+          followerFix.object=fix.object;
+          followerFix.segment=projection.segment;
+          followerFix.coord=projection.coord;
+          followerFix.distance=Meters(projection.distance);
+        }
+
+        std::vector<FileOffset> stepPath;
+
+        if (s==0) {
+          stepPath.push_back(candidate.way->GetFileOffset());
+        }
+        else {
+          stepPath=step.paths[chosen[s]];
+        }
+
+        for (const auto& offset : stepPath) {
+          ObjectFileRef ref(offset,refWay);
+
+          if (path.empty() || path.back()!=ref) {
+            path.push_back(ref);
+          }
+        }
+      }
+
+      chain.clear();
+    }
+  }
+
+  MapMatchingService::MapMatchingService(const DatabaseRef& database,
+                                         const RoutingProfileRef& profile,
+                                         const MapMatchingParameter& parameter)
+  : database(database),
+    profile(profile),
+    parameter(parameter)
+  {
+    assert(database);
+    assert(profile);
+
+    Vehicle vehicle=profile->GetVehicle();
+
+    for (const auto& type : database->GetTypeConfig()->GetTypes()) {
+      if (!type->GetIgnore() &&
+          type->CanBeWay() &&
+          type->CanRoute(vehicle)) {
+        routableTypes.Set(type);
+      }
+    }
+  }
+
+  /**
+   * Matches a single trace.
+   *
+   * @param trace
+   *    The fixes of the trace in chronological order
+   * @return
+   *    The result, containing a matched position for each fix of the trace
+   */
+  MapMatchingResult MapMatchingService::Match(const std::vector<MapMatchingFix>& trace) const
+  {
+    MapMatchingResult result;
+    MatchingContext   context(*database,*profile,routableTypes);
+    std::vector<Step> chain;
+    double            beta=std::max(parameter.GetTransitionBeta().AsMeter(),0.1);
+    double            radius=parameter.GetCandidateRadius().AsMeter();
+    BreakerRef        breaker=parameter.GetBreaker();
+
+    result.fixes.resize(trace.size());
+
+    for (size_t i=0; i<trace.size(); i++) {
+      if (breaker && breaker->IsAborted()) {
+        break;
+      }
+
+      const MapMatchingFix& fix=trace[i];
+
+      if (!chain.empty() &&
+          GetSphericalDistance(trace[chain.back().fixIndex].coord,fix.coord)<parameter.GetMinFixDistance()) {
+        chain.back().followers.push_back(i);
+        continue;
+      }
+
+      context.Flush();
+
+      if (!context.Load(GeoBox::BoxByCenterAndRadius(fix.coord,parameter.GetCandidateRadius()))) {
+        log.Error() << "Cannot load ways around " << fix.coord.GetDisplayText();
+        continue;
+      }
+
+      Step step;
+
+      step.fixIndex=i;
+      step.candidates=context.GetCandidates(fix.coord,
+                                            parameter.GetCandidateRadius(),
+                                            parameter.GetMaxCandidates());
+
+      if (step.candidates.empty()) {
+        continue;
+      }
+
+      double sigma=std::max(fix.accuracy.value_or(parameter.GetGpsSigma()).AsMeter(),0.1);
+
+      for (auto& candidate : step.candidates) {
+        candidate.emission=-0.5*(candidate.distance/sigma)*(candidate.distance/sigma);
+      }
+
+      step.scores.assign(step.candidates.size(),NoScore);
+      step.back.assign(step.candidates.size(),0);
+      step.paths.resize(step.candidates.size());
+
+      if (!chain.empty() &&
+          GetSphericalDistance(trace[chain.back().fixIndex].coord,fix.coord)>parameter.GetMaxTransitionDistance()) {
+        // Gap in the trace (tunnel, receiver switched off,...), the search area for a
+        // transition would be huge, so start a new model instead
+        ResolveChain(trace,chain,result.fixes,result.path);
+        result.breaks++;
+      }
+
+      if (!chain.empty()) {
+        const Step&          prev=chain.back();
+        const MapMatchingFix& prevFix=trace[prev.fixIndex];
+        double               greatCircle=GetSphericalDistance(prevFix.coord,fix.coord).AsMeter();
+        double               limit=std::max(greatCircle*parameter.GetRouteDistanceFactor(),
+                                            parameter.GetMinRouteDistanceLimit().AsMeter());
+        GeoBox               searchBox(prevFix.coord,fix.coord);
+
+        // A path of length 'limit' between both fixes cannot leave this box
+        searchBox=GeoBox::BoxByCenterAndRadius(searchBox.GetCenter(),
+                                               Meters(limit/2+radius));
+
+        if (!context.Load(searchBox)) {
+          log.Error() << "Cannot load ways in " << searchBox.GetDisplayText();
+        }
+
+        std::vector<double>                  distances;
+        std::vector<std::vector<FileOffset>> paths;
+
+        for (size_t j=0; j<prev.candidates.size(); j++) {
+          if (prev.scores[j]==NoScore) {
+            continue;
+          }
+
+          context.Route(prev.candidates[j],
+                        step.candidates,
+                        parameter.GetMinFixDistance().AsMeter(),
+                        limit,
+                        distances,
+                        paths);
+
+          for (size_t k=0; k<step.candidates.size(); k++) {
+            if (distances[k]==NoDistance) {
+              continue;
+            }
+
+            double score=prev.scores[j]-
+                         std::abs(distances[k]-greatCircle)/beta+
+                         step.candidates[k].emission;
+
+            if (score>step.scores[k]) {
+              step.scores[k]=score;
+              step.back[k]=j;
+              step.paths[k]=paths[k];
+            }
+          }
+        }
+
+        if (std::all_of(step.scores.begin(),
+                        step.scores.end(),
+                        [](double score) {
+                          return score==NoScore;
+                        })) {
+          // No connection between the candidates of both fixes, start a new model
+          ResolveChain(trace,chain,result.fixes,result.path);
+          result.breaks++;
+        }
+      }
+
+      if (chain.empty()) {
+        for (size_t k=0; k<step.candidates.size(); k++) {
+          step.scores[k]=step.candidates[k].emission;
+          step.paths[k].clear();
+        }
+      }
+
+      chain.push_back(std::move(step));
+    }
+
+    ResolveChain(trace,chain,result.fixes,result.path);
+
+    return result;
+  }
+
+  /**
+   * Matches all given traces. Traces are distributed to a number of worker threads
+   * as defined by the parameter.
+   *
+   * @param traces
+   *    List of traces
+   * @return
+   *    Results in the same order as the traces
+   */
+  std::vector<MapMatchingResult> MapMatchingService::Match(const std::vector<std::vector<MapMatchingFix>>& traces) const
+  {
+    std::vector<MapMatchingResult> results(traces.size());
+    std::atomic<size_t>            next(0);
+    size_t                         threadCount=parameter.GetThreads();
+
+    if (threadCount==0) {
+      threadCount=std::max(1u,std::thread::hardware_concurrency());
+    }
+
+    threadCount=std::min(threadCount,traces.size());
+
+    std::vector<std::future<void>> workers;
+
+    workers.reserve(threadCount);
+
+    for (size_t t=0; t<threadCount; t++) {
+      workers.push_back(std::async(std::launch::async,
+                                   [this,&traces,&results,&next]() {
+                                     for (size_t i=next++; i<traces.size(); i=next++) {
+                                       results[i]=Match(traces[i]);
+                                     }
+                                   }));
+    }
+
+    for (auto& worker : workers) {
+      worker.get();
+    }
+
+    return results;
+  }
+}
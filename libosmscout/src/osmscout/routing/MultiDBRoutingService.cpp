@@ -112,6 +112,8 @@ namespace osmscout {
       handle.profile.reset();
     }
 
+    FlushPredecessorCache();
+
     isOpen=false;
   }
 
@@ -483,6 +485,8 @@ namespace osmscout {
 
         result.GetRoute().Append(partialResult.GetRoute());
         result.AppendSectionLength(partialResult.GetRoute().Entries().size());
+        result.SetExpandedNodes(result.GetForwardExpandedNodes()+partialResult.GetForwardExpandedNodes(),
+                                result.GetBackwardExpandedNodes()+partialResult.GetBackwardExpandedNodes());
       }
 
       return result;
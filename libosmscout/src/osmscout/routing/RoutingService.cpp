@@ -70,6 +70,16 @@ namespace osmscout {
     this->progress=progress;
   }
 
+  /**
+   * Calculate the route by a bidirectional A* search, expanding route nodes
+   * from the start and from the target alternately. This usually expands
+   * considerably less route nodes for longer routes.
+   */
+  void RoutingParameter::SetBidirectional(bool bidirectional)
+  {
+    this->bidirectional=bidirectional;
+  }
+
   std::string RoutingService::GetDataFilename(const std::string& filenamebase)
   {
     return filenamebase+".dat";
@@ -360,6 +360,7 @@ namespace osmscout {
   void SimpleRoutingService::Close()
   {
     routingDatabase.Close();
+    FlushPredecessorCache();
 
     isOpen=false;
   }
@@ -444,6 +445,8 @@ namespace osmscout {
 
       result.GetRoute().Append(partialResult.GetRoute());
       result.AppendSectionLength(partialResult.GetRoute().Entries().size());
+      result.SetExpandedNodes(result.GetForwardExpandedNodes()+partialResult.GetForwardExpandedNodes(),
+                              result.GetBackwardExpandedNodes()+partialResult.GetBackwardExpandedNodes());
     }
 
     return result;
@@ -0,0 +1,120 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/MemoryArena.h>
+
+namespace osmscout {
+
+  void* MemoryArena::OverflowResource::do_allocate(size_t bytes,
+                                                   size_t alignment)
+  {
+    void* pointer=std::pmr::new_delete_resource()->allocate(bytes,
+                                                            alignment);
+
+    allocated+=bytes;
+
+    return pointer;
+  }
+
+  void MemoryArena::OverflowResource::do_deallocate(void* pointer,
+                                                    size_t bytes,
+                                                    size_t alignment)
+  {
+    std::pmr::new_delete_resource()->deallocate(pointer,
+                                                bytes,
+                                                alignment);
+  }
+
+  bool MemoryArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    return this==&other;
+  }
+
+  MemoryArena::MemoryArena(size_t initialSize,
+                           size_t maxCapacity)
+  : buffer(new std::byte[initialSize]),
+    initialSize(initialSize),
+    maxCapacity(maxCapacity),
+    bufferSize(initialSize)
+  {
+    monotonic.emplace(buffer.get(),
+                      bufferSize,
+                      &overflow);
+    pool.emplace(&*monotonic);
+  }
+
+  MemoryArena::~MemoryArena()
+  {
+    pool.reset();
+    monotonic.reset();
+  }
+
+  void* MemoryArena::do_allocate(size_t bytes,
+                                 size_t alignment)
+  {
+    return pool->allocate(bytes,
+                          alignment);
+  }
+
+  void MemoryArena::do_deallocate(void* pointer,
+                                  size_t bytes,
+                                  size_t alignment)
+  {
+    pool->deallocate(pointer,
+                     bytes,
+                     alignment);
+  }
+
+  bool MemoryArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    return this==&other;
+  }
+
+  /**
+   * Drop all allocations. If the buffer was too small since the last reset, it is
+   * replaced by a buffer large enough to hold everything allocated in the meantime.
+   * If that would exceed the maximum capacity, the buffer is released and replaced by
+   * one of the initial size instead.
+   */
+  void MemoryArena::Reset()
+  {
+    size_t requiredSize=bufferSize+overflow.GetAllocated();
+
+    pool.reset();
+    monotonic.reset();
+
+    if (requiredSize>maxCapacity) {
+      if (bufferSize!=initialSize) {
+        buffer.reset(new std::byte[initialSize]);
+        bufferSize=initialSize;
+      }
+    }
+    else if (requiredSize>bufferSize) {
+      buffer.reset(new std::byte[requiredSize]);
+      bufferSize=requiredSize;
+    }
+
+    overflow.ResetAllocated();
+
+    monotonic.emplace(buffer.get(),
+                      bufferSize,
+                      &overflow);
+    pool.emplace(&*monotonic);
+  }
+}
@@ -0,0 +1,488 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/Metrics.h>
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace osmscout {
+
+  size_t AllocateMetricsThreadSlot()
+  {
+    static std::atomic<size_t> nextSlot{0};
+
+    return nextSlot.fetch_add(1,std::memory_order_relaxed);
+  }
+
+  MetricCounter::MetricCounter(const std::atomic<bool>& enabled,
+                               const std::string& name,
+                               const std::string& help)
+  : enabled(enabled),
+    name(name),
+    help(help)
+  {
+    // no code
+  }
+
+  uint64_t MetricCounter::GetValue() const
+  {
+    uint64_t value=0;
+
+    for (const auto& shard : shards) {
+      value+=shard.value.load(std::memory_order_relaxed);
+    }
+
+    return value;
+  }
+
+  void MetricCounter::Reset()
+  {
+    for (auto& shard : shards) {
+      shard.value.store(0,std::memory_order_relaxed);
+    }
+  }
+
+  MetricGauge::MetricGauge(const std::atomic<bool>& enabled,
+                           const std::string& name,
+                           const std::string& help)
+  : enabled(enabled),
+    name(name),
+    help(help)
+  {
+    // no code
+  }
+
+  MetricHistogram::MetricHistogram(const std::atomic<bool>& enabled,
+                                   const std::string& name,
+                                   const std::string& help)
+  : enabled(enabled),
+    name(name),
+    help(help),
+    shards(std::make_unique<Shard[]>(ShardCount))
+  {
+    // no code
+  }
+
+  uint64_t MetricHistogram::GetBucketLowerBound(size_t index)
+  {
+    if (index<SubBucketCount) {
+      return index;
+    }
+
+    size_t group=index/SubBucketCount;
+    size_t sub=index%SubBucketCount;
+
+    return static_cast<uint64_t>(SubBucketCount+sub) << (group-1);
+  }
+
+  uint64_t MetricHistogram::GetBucketUpperBound(size_t index)
+  {
+    if (index<SubBucketCount) {
+      return index;
+    }
+
+    size_t group=index/SubBucketCount;
+
+    return GetBucketLowerBound(index)+((uint64_t(1) << (group-1))-1);
+  }
+
+  void MetricHistogram::Reset()
+  {
+    for (size_t s=0; s<ShardCount; s++) {
+      Shard& shard=shards[s];
+
+      shard.count.store(0,std::memory_order_relaxed);
+      shard.sum.store(0,std::memory_order_relaxed);
+      shard.min.store(UINT64_MAX,std::memory_order_relaxed);
+      shard.max.store(0,std::memory_order_relaxed);
+
+      for (auto& bucket : shard.buckets) {
+        bucket.store(0,std::memory_order_relaxed);
+      }
+    }
+  }
+
+  double MetricsSnapshot::HistogramValue::GetMean() const
+  {
+    if (count==0) {
+      return 0.0;
+    }
+
+    return static_cast<double>(sum)/static_cast<double>(count);
+  }
+
+  /**
+   * Returns the (inclusive) upper bound of the bucket that contains the value at the given
+   * percentile (0.0-100.0), capped by the observed maximum.
+   */
+  uint64_t MetricsSnapshot::HistogramValue::GetPercentile(double percentile) const
+  {
+    if (count==0) {
+      return 0;
+    }
+
+    percentile=std::clamp(percentile,0.0,100.0);
+
+    auto     rank=static_cast<uint64_t>(std::ceil(percentile/100.0*static_cast<double>(count)));
+    uint64_t seen=0;
+
+    rank=std::max<uint64_t>(rank,1);
+
+    for (const auto& bucket : buckets) {
+      seen+=bucket.count;
+
+      if (seen>=rank) {
+        return std::clamp(bucket.upperBound,min,max);
+      }
+    }
+
+    return max;
+  }
+
+  const MetricsSnapshot::CounterValue* MetricsSnapshot::GetCounter(const std::string& name) const
+  {
+    for (const auto& counter : counters) {
+      if (counter.name==name) {
+        return &counter;
+      }
+    }
+
+    return nullptr;
+  }
+
+  const MetricsSnapshot::GaugeValue* MetricsSnapshot::GetGauge(const std::string& name) const
+  {
+    for (const auto& gauge : gauges) {
+      if (gauge.name==name) {
+        return &gauge;
+      }
+    }
+
+    return nullptr;
+  }
+
+  const MetricsSnapshot::HistogramValue* MetricsSnapshot::GetHistogram(const std::string& name) const
+  {
+    for (const auto& histogram : histograms) {
+      if (histogram.name==name) {
+        return &histogram;
+      }
+    }
+
+    return nullptr;
+  }
+
+  static std::string EscapePrometheusHelp(const std::string& text)
+  {
+    std::string result;
+
+    result.reserve(text.length());
+
+    for (char c : text) {
+      if (c=='\\') {
+        result+="\\\\";
+      }
+      else if (c=='\n') {
+        result+="\\n";
+      }
+      else {
+        result+=c;
+      }
+    }
+
+    return result;
+  }
+
+  static std::string EscapeJson(const std::string& text)
+  {
+    std::ostringstream stream;
+
+    for (char c : text) {
+      switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\r':
+        stream << "\\r";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c)<0x20) {
+          stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        }
+        else {
+          stream << c;
+        }
+      }
+    }
+
+    return stream.str();
+  }
+
+  /**
+   * Export the snapshot in the Prometheus text exposition format (version 0.0.4).
+   * Histograms only export the boundaries of non-empty buckets, which is valid
+   * since bucket counts are cumulative.
+   */
+  std::string MetricsSnapshot::ToPrometheus() const
+  {
+    std::ostringstream stream;
+
+    stream.imbue(std::locale::classic());
+
+    for (const auto& counter : counters) {
+      stream << "# HELP " << counter.name << " " << EscapePrometheusHelp(counter.help) << "\n";
+      stream << "# TYPE " << counter.name << " counter\n";
+      stream << counter.name << " " << counter.value << "\n";
+    }
+
+    for (const auto& gauge : gauges) {
+      stream << "# HELP " << gauge.name << " " << EscapePrometheusHelp(gauge.help) << "\n";
+      stream << "# TYPE " << gauge.name << " gauge\n";
+      stream << gauge.name << " " << gauge.value << "\n";
+    }
+
+    for (const auto& histogram : histograms) {
+      uint64_t cumulative=0;
+
+      stream << "# HELP " << histogram.name << " " << EscapePrometheusHelp(histogram.help) << "\n";
+      stream << "# TYPE " << histogram.name << " histogram\n";
+
+      for (const auto& bucket : histogram.buckets) {
+        cumulative+=bucket.count;
+        stream << histogram.name << "_bucket{le=\"" << bucket.upperBound << "\"} " << cumulative << "\n";
+      }
+
+      stream << histogram.name << "_bucket{le=\"+Inf\"} " << histogram.count << "\n";
+      stream << histogram.name << "_sum " << histogram.sum << "\n";
+      stream << histogram.name << "_count " << histogram.count << "\n";
+    }
+
+    return stream.str();
+  }
+
+  std::string MetricsSnapshot::ToJson() const
+  {
+    std::ostringstream stream;
+
+    stream.imbue(std::locale::classic());
+
+    stream << "{\"counters\":[";
+    for (size_t i=0; i<counters.size(); i++) {
+      if (i>0) {
+        stream << ",";
+      }
+
+      stream << "{\"name\":\"" << EscapeJson(counters[i].name) << "\",";
+      stream << "\"help\":\"" << EscapeJson(counters[i].help) << "\",";
+      stream << "\"value\":" << counters[i].value << "}";
+    }
+
+    stream << "],\"gauges\":[";
+    for (size_t i=0; i<gauges.size(); i++) {
+      if (i>0) {
+        stream << ",";
+      }
+
+      stream << "{\"name\":\"" << EscapeJson(gauges[i].name) << "\",";
+      stream << "\"help\":\"" << EscapeJson(gauges[i].help) << "\",";
+      stream << "\"value\":" << gauges[i].value << "}";
+    }
+
+    stream << "],\"histograms\":[";
+    for (size_t i=0; i<histograms.size(); i++) {
+      const HistogramValue& histogram=histograms[i];
+
+      if (i>0) {
+        stream << ",";
+      }
+
+      stream << "{\"name\":\"" << EscapeJson(histogram.name) << "\",";
+      stream << "\"help\":\"" << EscapeJson(histogram.help) << "\",";
+      stream << "\"count\":" << histogram.count << ",";
+      stream << "\"sum\":" << histogram.sum << ",";
+      stream << "\"min\":" << histogram.min << ",";
+      stream << "\"max\":" << histogram.max << ",";
+      stream << "\"mean\":" << std::fixed << std::setprecision(3) << histogram.GetMean() << ",";
+      stream << "\"p50\":" << histogram.GetPercentile(50.0) << ",";
+      stream << "\"p90\":" << histogram.GetPercentile(90.0) << ",";
+      stream << "\"p99\":" << histogram.GetPercentile(99.0) << ",";
+      stream << "\"buckets\":[";
+
+      for (size_t b=0; b<histogram.buckets.size(); b++) {
+        if (b>0) {
+          stream << ",";
+        }
+
+        stream << "{\"le\":" << histogram.buckets[b].upperBound << ",\"count\":" << histogram.buckets[b].count << "}";
+      }
+
+      stream << "]}";
+    }
+
+    stream << "]}";
+
+    return stream.str();
+  }
+
+  MetricsRegistry& MetricsRegistry::Instance()
+  {
+    static MetricsRegistry instance;
+
+    return instance;
+  }
+
+  void MetricsRegistry::SetEnabled(bool enabled)
+  {
+    this->enabled.store(enabled,std::memory_order_relaxed);
+  }
+
+  MetricCounter& MetricsRegistry::GetCounter(const std::string& name,
+                                             const std::string& help)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    auto& entry=counters[name];
+
+    if (!entry) {
+      entry=std::make_unique<MetricCounter>(enabled,name,help);
+    }
+
+    return *entry;
+  }
+
+  MetricGauge& MetricsRegistry::GetGauge(const std::string& name,
+                                         const std::string& help)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    auto& entry=gauges[name];
+
+    if (!entry) {
+      entry=std::make_unique<MetricGauge>(enabled,name,help);
+    }
+
+    return *entry;
+  }
+
+  MetricHistogram& MetricsRegistry::GetHistogram(const std::string& name,
+                                                 const std::string& help)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    auto& entry=histograms[name];
+
+    if (!entry) {
+      entry=std::make_unique<MetricHistogram>(enabled,name,help);
+    }
+
+    return *entry;
+  }
+
+  /**
+   * Collect the current values of all metrics. Updates running in parallel
+   * may or may not be part of the snapshot, values of one histogram
+   * are thus not guaranteed to be exactly consistent with each other.
+   */
+  MetricsSnapshot MetricsRegistry::GetSnapshot() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    MetricsSnapshot              snapshot;
+
+    snapshot.counters.reserve(counters.size());
+    for (const auto& [name,counter] : counters) {
+      snapshot.counters.push_back(MetricsSnapshot::CounterValue{name,
+                                                                counter->GetHelp(),
+                                                                counter->GetValue()});
+    }
+
+    snapshot.gauges.reserve(gauges.size());
+    for (const auto& [name,gauge] : gauges) {
+      snapshot.gauges.push_back(MetricsSnapshot::GaugeValue{name,
+                                                            gauge->GetHelp(),
+                                                            gauge->GetValue()});
+    }
+
+    snapshot.histograms.reserve(histograms.size());
+    for (const auto& [name,histogram] : histograms) {
+      MetricsSnapshot::HistogramValue value;
+      std::vector<uint64_t>           buckets(MetricHistogram::BucketCount,0);
+      uint64_t                        min=UINT64_MAX;
+
+      value.name=name;
+      value.help=histogram->GetHelp();
+
+      for (size_t s=0; s<MetricHistogram::ShardCount; s++) {
+        const MetricHistogram::Shard& shard=histogram->shards[s];
+
+        value.count+=shard.count.load(std::memory_order_relaxed);
+        value.sum+=shard.sum.load(std::memory_order_relaxed);
+        min=std::min(min,shard.min.load(std::memory_order_relaxed));
+        value.max=std::max(value.max,shard.max.load(std::memory_order_relaxed));
+
+        for (size_t b=0; b<MetricHistogram::BucketCount; b++) {
+          buckets[b]+=shard.buckets[b].load(std::memory_order_relaxed);
+        }
+      }
+
+      value.min=value.count>0 ? min : 0;
+
+      for (size_t b=0; b<MetricHistogram::BucketCount; b++) {
+        if (buckets[b]>0) {
+          value.buckets.push_back(MetricsSnapshot::HistogramBucket{MetricHistogram::GetBucketUpperBound(b),
+                                                                   buckets[b]});
+        }
+      }
+
+      snapshot.histograms.push_back(std::move(value));
+    }
+
+    return snapshot;
+  }
+
+  /**
+   * Reset the values of all registered metrics. Metrics stay registered.
+   */
+  void MetricsRegistry::Reset()
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    for (auto& [name,counter] : counters) {
+      counter->Reset();
+    }
+
+    for (auto& [name,gauge] : gauges) {
+      gauge->Reset();
+    }
+
+    for (auto& [name,histogram] : histograms) {
+      histogram->Reset();
+    }
+  }
+}
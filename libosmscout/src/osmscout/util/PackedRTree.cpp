@@ -0,0 +1,187 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/PackedRTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace osmscout {
+
+  namespace {
+    /**
+     * Sorts the given entries into slices of boxes with similar longitude and each slice
+     * by latitude, so that groups of nodeCapacity consecutive entries are close to each other
+     */
+    template<typename Entry, typename GetBox>
+    void SortTileRecursive(std::vector<Entry>& entries,
+                           size_t nodeCapacity,
+                           GetBox getBox)
+    {
+      size_t nodeCount=(entries.size()+nodeCapacity-1)/nodeCapacity;
+      size_t sliceCount=(size_t)std::ceil(std::sqrt((double)nodeCount));
+      size_t sliceSize=sliceCount*nodeCapacity;
+
+      std::sort(entries.begin(),
+                entries.end(),
+                [&getBox](const Entry& a, const Entry& b) {
+                  return getBox(a).GetCenter().GetLon()<getBox(b).GetCenter().GetLon();
+                });
+
+      for (size_t start=0; start<entries.size(); start+=sliceSize) {
+        auto sliceEnd=entries.begin()+std::min(entries.size(),start+sliceSize);
+
+        std::sort(entries.begin()+start,
+                  sliceEnd,
+                  [&getBox](const Entry& a, const Entry& b) {
+                    return getBox(a).GetCenter().GetLat()<getBox(b).GetCenter().GetLat();
+                  });
+      }
+    }
+  }
+
+  PackedRTree::PackedRTree(size_t nodeCapacity)
+  : nodeCapacity(std::max(nodeCapacity,size_t(2)))
+  {
+    // no code
+  }
+
+  /**
+   * Builds the tree for the given boxes, replacing the current content
+   */
+  void PackedRTree::Build(const std::vector<GeoBox>& boxes)
+  {
+    itemBoxes.clear();
+    itemIds.clear();
+    levels.clear();
+
+    if (boxes.empty()) {
+      return;
+    }
+
+    itemIds.resize(boxes.size());
+    std::iota(itemIds.begin(),
+              itemIds.end(),
+              0);
+
+    SortTileRecursive(itemIds,
+                      nodeCapacity,
+                      [&boxes](uint32_t id) -> const GeoBox& {
+                        return boxes[id];
+                      });
+
+    itemBoxes.reserve(itemIds.size());
+    for (uint32_t id : itemIds) {
+      itemBoxes.push_back(boxes[id]);
+    }
+
+    // Leaves
+    std::vector<Node> level;
+
+    for (size_t first=0; first<itemBoxes.size(); first+=nodeCapacity) {
+      Node node{GeoBox(),(uint32_t)first,(uint32_t)std::min(nodeCapacity,itemBoxes.size()-first)};
+
+      for (size_t i=first; i<first+node.count; i++) {
+        node.boundingBox.Include(itemBoxes[i]);
+      }
+
+      level.push_back(node);
+    }
+
+    // Inner nodes up to a single root. The nodes of a level are sorted before the
+    // next level is created, so the child indexes refer to the sorted order.
+    while (true) {
+      if (level.size()>1) {
+        SortTileRecursive(level,
+                          nodeCapacity,
+                          [](const Node& node) -> const GeoBox& {
+                            return node.boundingBox;
+                          });
+      }
+
+      levels.push_back(std::move(level));
+
+      const std::vector<Node>& children=levels.back();
+
+      if (children.size()==1) {
+        break;
+      }
+
+      level=std::vector<Node>();
+
+      for (size_t first=0; first<children.size(); first+=nodeCapacity) {
+        Node node{GeoBox(),(uint32_t)first,(uint32_t)std::min(nodeCapacity,children.size()-first)};
+
+        for (size_t i=first; i<first+node.count; i++) {
+          node.boundingBox.Include(children[i].boundingBox);
+        }
+
+        level.push_back(node);
+      }
+    }
+  }
+
+  void PackedRTree::Query(const GeoCoord& coord,
+                          std::vector<size_t>& items) const
+  {
+    Query(GeoBox(coord,coord),
+          items);
+  }
+
+  /**
+   * Appends the indexes of all boxes intersecting the given box to items
+   */
+  void PackedRTree::Query(const GeoBox& boundingBox,
+                          std::vector<size_t>& items) const
+  {
+    if (levels.empty()) {
+      return;
+    }
+
+    std::vector<std::pair<size_t,uint32_t>> stack; // level, node index
+
+    stack.emplace_back(levels.size()-1,0);
+
+    while (!stack.empty()) {
+      auto [levelIndex,nodeIndex]=stack.back();
+
+      stack.pop_back();
+
+      const Node& node=levels[levelIndex][nodeIndex];
+
+      if (!node.boundingBox.Intersects(boundingBox,/*openInterval*/ false)) {
+        continue;
+      }
+
+      if (levelIndex==0) {
+        for (uint32_t i=node.first; i<node.first+node.count; i++) {
+          if (itemBoxes[i].Intersects(boundingBox,/*openInterval*/ false)) {
+            items.push_back(itemIds[i]);
+          }
+        }
+      }
+      else {
+        for (uint32_t i=node.first; i<node.first+node.count; i++) {
+          stack.emplace_back(levelIndex-1,i);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  libosmscout contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/PreparedPolygon.h>
+
+#include <algorithm>
+
+#include <osmscout/util/Geometry.h>
+
+namespace osmscout {
+
+  PreparedPolygon::PreparedPolygon(const std::vector<GeoCoord>& nodes)
+  : nodes(nodes),
+    boundingBox(osmscout::GetBoundingBox(nodes))
+  {
+    if (nodes.empty()) {
+      return;
+    }
+
+    // A few edges per row, but limit the number of rows for huge polygons
+    size_t rowCount=std::clamp(nodes.size()/4,size_t(1),size_t(1) << 16);
+
+    rowHeight=(boundingBox.GetMaxLat()-boundingBox.GetMinLat())/double(rowCount);
+
+    if (rowHeight<=0.0) {
+      rowCount=1;
+    }
+
+    std::vector<uint32_t> rowSizes(rowCount,0);
+
+    auto forEachRowOfEdge=[this,&nodes](size_t i, auto function) {
+      size_t j=i==0 ? nodes.size()-1 : i-1;
+      size_t firstRow=GetRow(std::min(nodes[i].GetLat(),nodes[j].GetLat()));
+      size_t lastRow=GetRow(std::max(nodes[i].GetLat(),nodes[j].GetLat()));
+
+      for (size_t row=firstRow; row<=lastRow; row++) {
+        function(row);
+      }
+    };
+
+    rowOffsets.resize(rowCount+1);
+
+    for (size_t i=0; i<nodes.size(); i++) {
+      forEachRowOfEdge(i,[&rowSizes](size_t row) {
+        rowSizes[row]++;
+      });
+    }
+
+    rowOffsets[0]=0;
+    for (size_t row=0; row<rowCount; row++) {
+      rowOffsets[row+1]=rowOffsets[row]+rowSizes[row];
+    }
+
+    rowEdges.resize(rowOffsets[rowCount]);
+
+    std::vector<uint32_t> rowFill(rowOffsets.begin(),rowOffsets.end()-1);
+
+    for (size_t i=0; i<nodes.size(); i++) {
+      forEachRowOfEdge(i,[this,&rowFill,i](size_t row) {
+        rowEdges[rowFill[row]++]=(uint32_t)i;
+      });
+    }
+  }
+
+  size_t PreparedPolygon::GetRow(double lat) const
+  {
+    if (rowHeight<=0.0) {
+      return 0;
+    }
+
+    size_t lastRow=rowOffsets.size()-2;
+    double row=(lat-boundingBox.GetMinLat())/rowHeight;
+
+    if (row<=0.0) {
+      return 0;
+    }
+
+    return std::min((size_t)row,lastRow);
+  }
+
+  /**
+   * Gives information about the position of the point in relation to the polygon.
+   *
+   * If -1 returned, the point is outside the polygon, if 0, the point is on the polygon
+   * boundary (it is one of the nodes), 1 the point is within the polygon.
+   */
+  int PreparedPolygon::GetRelationOfPoint(const GeoCoord& point) const
+  {
+    // Only edges crossing the latitude of the point change the result
+    if (nodes.empty() ||
+        point.GetLat()<boundingBox.GetMinLat() ||
+        point.GetLat()>boundingBox.GetMaxLat()) {
+      return -1;
+    }
+
+    size_t row=GetRow(point.GetLat());
+    bool   c=false;
+
+    // Same test as GetRelationOfPointToArea(), restricted to the edges of the row.
+    // Every node with the latitude of the point is the end node of an edge in the row.
+    for (uint32_t e=rowOffsets[row]; e<rowOffsets[row+1]; e++) {
+      size_t i=rowEdges[e];
+      size_t j=i==0 ? nodes.size()-1 : i-1;
+
+      if (point.GetLat()==nodes[i].GetLat() &&
+          point.GetLon()==nodes[i].GetLon()) {
+        return 0;
+      }
+
+      if ((((nodes[i].GetLat()<=point.GetLat()) && (point.GetLat()<nodes[j].GetLat())) ||
+           ((nodes[j].GetLat()<=point.GetLat()) && (point.GetLat()<nodes[i].GetLat()))) &&
+          (point.GetLon()<(nodes[j].GetLon()-nodes[i].GetLon())*(point.GetLat()-nodes[i].GetLat())/(nodes[j].GetLat()-nodes[i].GetLat())+
+           nodes[i].GetLon())) {
+        c=!c;
+      }
+    }
+
+    return c ? 1 : -1;
+  }
+}
@@ -19,6 +19,7 @@
 
 #include <osmscout/util/Transformation.h>
 
+#include <array>
 #include <cstring>
 
 #include <limits>
@@ -621,6 +622,19 @@ namespace osmscout {
     }
   }
 
+  void FinishOptimization(TransBuffer& buffer,
+                          bool isArea,
+                          TransPolygon::OutputConstraint constraint)
+  {
+    DropEqualPoints(buffer);
+
+    if (constraint==TransPolygon::simple) {
+      EnsureSimple(buffer,isArea);
+    }
+
+    buffer.CalcSize();
+  }
+
   void OptimizeArea(TransBuffer& buffer,
                     TransPolygon::OptimizeMethod optimize,
                     double optimizeErrorTolerance,
@@ -634,13 +648,9 @@ namespace osmscout {
       DropRedundantPointsDouglasPeuckerArea(buffer,optimizeErrorTolerance);
     }
 
-    DropEqualPoints(buffer);
-
-    if (constraint==TransPolygon::simple) {
-      EnsureSimple(buffer,true);
-    }
-
-    buffer.CalcSize();
+    FinishOptimization(buffer,
+                       true,
+                       constraint);
   }
 
   void OptimizeWay(TransBuffer& buffer,
@@ -657,13 +667,9 @@ namespace osmscout {
       DropRedundantPointsDouglasPeuckerWay(buffer,optimizeErrorTolerance);
     }
 
-    DropEqualPoints(buffer);
-
-    if (constraint==TransPolygon::simple) {
-      EnsureSimple(buffer,false);
-    }
-
-    buffer.CalcSize();
+    FinishOptimization(buffer,
+                       false,
+                       constraint);
   }
 
   void TransformBoundingBox(const GeoBox& boundingBox,
@@ -696,6 +702,31 @@ namespace osmscout {
                   constraint);
   }
 
+  GeoBox CalculateClipBox(const Projection& projection,
+                          double guardBand)
+  {
+    ScreenBox screenBox=projection.GetScreenBox().Resize(guardBand);
+    std::array<Vertex2D,4> corners{Vertex2D(screenBox.GetMinX(),screenBox.GetMinY()),
+                                   Vertex2D(screenBox.GetMaxX(),screenBox.GetMinY()),
+                                   Vertex2D(screenBox.GetMaxX(),screenBox.GetMaxY()),
+                                   Vertex2D(screenBox.GetMinX(),screenBox.GetMaxY())};
+    GeoBox clipBox;
+
+    for (const auto& corner : corners) {
+      GeoCoord coord;
+
+      if (!projection.PixelToGeo(corner.GetX(),
+                                 corner.GetY(),
+                                 coord)) {
+        return {};
+      }
+
+      clipBox.Include(coord);
+    }
+
+    return clipBox;
+  }
+
   CoordBufferRange CopyPolygonToCoordBuffer(const TransBuffer& transBuffer, CoordBuffer& coordBuffer)
   {
     assert(!transBuffer.IsEmpty());